@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/Palette.h"
+#include "Assets/TextureBuffer.h"
+#include "BenchmarkUtils.h"
+#include "Color.h"
+#include "IO/Reader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+constexpr auto TextureSize = size_t(512);
+constexpr auto TextureCount = size_t(256);
+
+/**
+ * The per pixel implementation that Palette::indexedToRgba replaced, for comparison.
+ */
+bool referenceIndexedToRgba(
+  const std::vector<unsigned char>& paletteData,
+  IO::Reader& reader,
+  const size_t pixelCount,
+  TextureBuffer& rgbaImage,
+  Color& averageColor)
+{
+  auto* const rgbaData = rgbaImage.data();
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    const int index = reader.readInt<unsigned char>();
+    std::memcpy(rgbaData + (i * 4), &paletteData[size_t(index) * 4], 4);
+  }
+
+  uint32_t colorSum[3] = {0, 0, 0};
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
+    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
+    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+  }
+  averageColor = Color{
+    float(colorSum[0]) / (255.0f * float(pixelCount)),
+    float(colorSum[1]) / (255.0f * float(pixelCount)),
+    float(colorSum[2]) / (255.0f * float(pixelCount)),
+    1.0f};
+
+  unsigned char andAlpha = 0xFF;
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
+  }
+  return andAlpha != 0xFF;
+}
+} // namespace
+
+TEST_CASE("PaletteBenchmark.indexedToRgba")
+{
+  auto paletteData = std::vector<unsigned char>(256 * 3);
+  auto rgbaPaletteData = std::vector<unsigned char>(256 * 4);
+  for (size_t i = 0; i < 256; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      paletteData[i * 3 + j] = static_cast<unsigned char>((i * 3 + j) * 7);
+      rgbaPaletteData[i * 4 + j] = paletteData[i * 3 + j];
+    }
+    rgbaPaletteData[i * 4 + 3] = i == 255 ? 0x00 : 0xFF;
+  }
+  const auto palette = makePalette(paletteData, PaletteColorFormat::Rgb).value();
+
+  const auto pixelCount = TextureSize * TextureSize;
+  auto indices = std::vector<char>(pixelCount);
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    indices[i] = static_cast<char>((i * 31) % 256);
+  }
+
+  auto rgbaImage = TextureBuffer{pixelCount * 4};
+  auto averageColor = Color{};
+  const auto message = std::to_string(TextureCount) + " textures of "
+                       + std::to_string(TextureSize) + "x" + std::to_string(TextureSize)
+                       + " pixels";
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < TextureCount; ++i)
+      {
+        auto reader = IO::Reader::from(indices.data(), indices.data() + indices.size());
+        referenceIndexedToRgba(
+          rgbaPaletteData, reader, pixelCount, rgbaImage, averageColor);
+      }
+    },
+    "expand " + message + " per pixel");
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < TextureCount; ++i)
+      {
+        auto reader = IO::Reader::from(indices.data(), indices.data() + indices.size());
+        palette.indexedToRgba(
+          reader,
+          pixelCount,
+          rgbaImage,
+          PaletteTransparency::Index255Transparent,
+          averageColor);
+      }
+    },
+    "expand " + message + " with Palette::indexedToRgba");
+}
+
+} // namespace TrenchBroom::Assets
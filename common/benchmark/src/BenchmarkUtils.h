@@ -20,6 +20,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <string>
 
 #ifdef __GNUC__
@@ -41,3 +42,34 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message)
     message.c_str(),
     std::chrono::duration<double>(end - start).count() * 1000.0);
 }
+
+/**
+ * Returns the number of allocations made with operator new by the benchmark executable
+ * so far.
+ */
+std::size_t allocationCount();
+
+/**
+ * Like timeLambda, but the given lambda performs the given number of operations, and the
+ * throughput and the number of allocations per operation are printed in addition to the
+ * elapsed time.
+ */
+template <class L>
+TB_NOINLINE static void timeOperations(
+  L&& lambda, const std::size_t operationCount, const std::string& message)
+{
+  const auto allocationsBefore = allocationCount();
+  const auto start = std::chrono::high_resolution_clock::now();
+  lambda();
+  const auto end = std::chrono::high_resolution_clock::now();
+  const auto allocations = allocationCount() - allocationsBefore;
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  printf(
+    "Time elapsed for '%s': %fms (%.0f operations per second, %.2f allocations per "
+    "operation)\n",
+    message.c_str(),
+    seconds * 1000.0,
+    double(operationCount) / seconds,
+    double(allocations) / double(operationCount));
+}
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "EL/CompiledExpression.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+
+#include <cstdio>
+#include <string>
+#include <tuple>
+
+namespace TrenchBroom::EL
+{
+namespace
+{
+constexpr auto EvaluationCount = size_t(100000);
+
+template <typename Evaluate>
+void measure(const Evaluate& evaluate, const std::string& message)
+{
+  const auto allocationsBefore = allocationCount();
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < EvaluationCount; ++i)
+      {
+        evaluate();
+      }
+    },
+    message);
+  const auto allocations = allocationCount() - allocationsBefore;
+
+  printf(
+    "Allocations per evaluation for '%s': %.2f\n",
+    message.c_str(),
+    double(allocations) / double(EvaluationCount));
+}
+} // namespace
+
+TEST_CASE("ELBenchmark.evaluate")
+{
+  using T = std::tuple<std::string, std::string>;
+
+  // clang-format off
+  const auto [name, source] = GENERATE(values<T>({
+    {"arithmetic",         "(x + 1) * 2 - y / 4"},
+    {"comparison",         "x > 2 && y <= 8 || !b"},
+    {"numeric properties", "{{ spawnflags & 1 -> 'a.mdl', "
+                           "spawnflags & 2 -> 'b.mdl', 'c.mdl' }}"},
+    {"model map",          "{ path: 'progs/player.mdl', skin: skin, frame: frame }"},
+  }));
+  // clang-format on
+
+  const auto variables = VariableTable{{
+    {"x", Value{3}},
+    {"y", Value{16.0}},
+    {"b", Value{false}},
+    {"spawnflags", Value{"2"}},
+    {"skin", Value{1}},
+    {"frame", Value{"4"}},
+  }};
+  const auto context = EvaluationContext{variables};
+
+  const auto expression = IO::ELParser::parseStrict(source);
+  const auto compiledExpression = CompiledExpression{expression};
+
+  measure(
+    [&]() { return expression.evaluate(context); },
+    "evaluate " + name + " " + std::to_string(EvaluationCount) + " times");
+  measure(
+    [&]() { return compiledExpression.evaluate(context); },
+    "evaluate compiled " + name + " " + std::to_string(EvaluationCount) + " times");
+}
+
+} // namespace TrenchBroom::EL
@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/Reader.h"
+#include "IO/StandardMapParser.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "octree.h"
+
+#include <kdl/overload.h>
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+const auto WorldBounds = vm::bbox3{8192.0};
+
+/**
+ * Parses a map without creating any nodes, so that the parser can be timed on its own.
+ */
+class NullMapParser : public StandardMapParser
+{
+public:
+  using StandardMapParser::StandardMapParser;
+
+  void parse(ParserStatus& status) { parseEntities(status); }
+
+private:
+  void onBeginEntity(
+    size_t, std::vector<Model::EntityProperty>, ParserStatus&) override
+  {
+  }
+  void onEndEntity(size_t, size_t, ParserStatus&) override {}
+  void onBeginBrush(size_t, ParserStatus&) override {}
+  void onEndBrush(size_t, size_t, ParserStatus&) override {}
+  void onStandardBrushFace(
+    size_t,
+    Model::MapFormat,
+    const vm::vec3&,
+    const vm::vec3&,
+    const vm::vec3&,
+    const Model::BrushFaceAttributes&,
+    ParserStatus&) override
+  {
+  }
+  void onValveBrushFace(
+    size_t,
+    Model::MapFormat,
+    const vm::vec3&,
+    const vm::vec3&,
+    const vm::vec3&,
+    const Model::BrushFaceAttributes&,
+    const vm::vec3&,
+    const vm::vec3&,
+    ParserStatus&) override
+  {
+  }
+  void onPatch(
+    size_t,
+    size_t,
+    Model::MapFormat,
+    size_t,
+    size_t,
+    std::vector<vm::vec<FloatType, 5>>,
+    std::string,
+    ParserStatus&) override
+  {
+  }
+};
+
+std::vector<Model::Node*> collectNodes(Model::WorldNode& world)
+{
+  auto nodes = std::vector<Model::Node*>{};
+  world.accept(kdl::overload(
+    [](auto&& thisLambda, Model::WorldNode* worldNode) {
+      worldNode->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, Model::LayerNode* layerNode) {
+      layerNode->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::GroupNode* groupNode) {
+      nodes.push_back(groupNode);
+      groupNode->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::EntityNode* entityNode) {
+      nodes.push_back(entityNode);
+      entityNode->visitChildren(thisLambda);
+    },
+    [&](Model::BrushNode* brushNode) { nodes.push_back(brushNode); },
+    [&](Model::PatchNode* patchNode) { nodes.push_back(patchNode); }));
+  return nodes;
+}
+
+void benchmarkMap(const std::filesystem::path& path, const Model::MapFormat mapFormat)
+{
+  const auto name = path.filename().string();
+  const auto entityPropertyConfig = Model::EntityPropertyConfig{};
+
+  auto file = std::shared_ptr<File>{};
+  timeLambda([&]() { file = Disk::openFileForReading(path).value(); }, "open " + name);
+
+  auto reader = file->reader().buffer();
+  const auto str = reader.stringView();
+
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto parser = NullMapParser{str, mapFormat, mapFormat};
+      parser.parse(status);
+    },
+    "parse " + name + " without creating nodes");
+
+  auto world = std::unique_ptr<Model::WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto worldReader = WorldReader{str, mapFormat, entityPropertyConfig};
+      world = worldReader.read(WorldBounds, status);
+    },
+    "read world from " + name);
+  REQUIRE(world != nullptr);
+
+  const auto nodes = collectNodes(*world);
+  timeLambda([&]() { world->rebuildNodeTree(); }, "rebuild node tree of " + name);
+
+  timeLambda(
+    [&]() {
+      auto nodeTree = octree<FloatType, Model::Node*>{256.0};
+      for (auto* node : nodes)
+      {
+        nodeTree.insert(node->physicalBounds(), node);
+      }
+    },
+    "insert " + std::to_string(nodes.size()) + " nodes of " + name
+      + " into node tree one by one");
+
+  auto mapCache = std::optional<MapCache>{};
+  timeLambda(
+    [&]() { mapCache = MapCache::create(*world); }, "create map cache of " + name);
+
+  timeLambda(
+    [&]() {
+      auto status = TestParserStatus{};
+      auto worldReader = WorldReader{str, mapFormat, entityPropertyConfig};
+      CHECK(worldReader.read(WorldBounds, status, &*mapCache) != nullptr);
+    },
+    "read world from " + name + " using map cache");
+
+  timeLambda(
+    [&]() {
+      auto stream = std::ostringstream{};
+      auto writer = NodeWriter{*world, stream};
+      writer.writeMap();
+      CHECK(!stream.str().empty());
+    },
+    "write world of " + name);
+}
+} // namespace
+
+TEST_CASE("MapLoadingBenchmark.neRuins")
+{
+  benchmarkMap(
+    std::filesystem::current_path() / "fixture/benchmark/AABBTree/ne_ruins.map",
+    Model::MapFormat::Standard);
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/PathInfo.h"
+#include "IO/PathMatcher.h"
+
+#include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr auto PackageEntryCount = size_t(50000);
+constexpr auto TextureNameCount = size_t(20000);
+constexpr auto Repetitions = size_t(20);
+
+std::vector<std::string> makeNames(const size_t count)
+{
+  const auto prefixes = std::vector<std::string>{
+    "base", "city", "metal", "sky", "water", "lava", "trigger", "clip", "door", "wall"};
+  const auto suffixes = std::vector<std::string>{"", "_1", "_2a", "_floor", "_trim"};
+
+  auto result = std::vector<std::string>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.push_back(
+      prefixes[i % prefixes.size()] + std::to_string(i) + suffixes[i % suffixes.size()]);
+  }
+  return result;
+}
+
+std::vector<std::filesystem::path> makePackageEntries()
+{
+  const auto directories = std::vector<std::filesystem::path>{
+    "textures/base", "textures/city", "models/items", "sound/world", "maps"};
+  const auto extensions =
+    std::vector<std::string>{".tga", ".jpg", ".md3", ".wav", ".bsp", ".shader"};
+
+  const auto names = makeNames(PackageEntryCount);
+
+  auto result = std::vector<std::filesystem::path>{};
+  result.reserve(names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    const auto& directory = directories[i % directories.size()];
+    const auto& extension = extensions[i % extensions.size()];
+    result.push_back(directory / (names[i] + extension));
+  }
+  return result;
+}
+
+template <typename T, typename Predicate>
+size_t countMatches(const std::vector<T>& values, const Predicate& predicate)
+{
+  auto count = size_t(0);
+  for (size_t i = 0; i < Repetitions; ++i)
+  {
+    count += size_t(std::count_if(values.begin(), values.end(), predicate));
+  }
+  return count;
+}
+
+template <typename T, typename Predicate>
+bool anyOf(const std::vector<T>& values, const Predicate& predicate)
+{
+  return std::any_of(values.begin(), values.end(), predicate);
+}
+} // namespace
+
+TEST_CASE("PathMatcherBenchmark.filenamePatterns")
+{
+  const auto entries = makePackageEntries();
+  const auto patterns = std::vector<std::string>{"*.shader", "*_floor.tga", "sky*.jpg"};
+  const auto getPathInfo = [](const auto&) { return PathInfo::File; };
+
+  auto expected = size_t(0);
+  timeLambda(
+    [&]() {
+      expected = countMatches(entries, [&](const auto& path) {
+        return anyOf(patterns, [&](const auto& pattern) {
+          return kdl::ci::str_matches_glob(path.filename().string(), pattern);
+        });
+      });
+    },
+    "filter package entries with str_matches_glob");
+
+  const auto matchers = kdl::vec_transform(
+    patterns, [](const auto& pattern) { return makeFilenamePathMatcher(pattern); });
+
+  auto actual = size_t(0);
+  timeLambda(
+    [&]() {
+      actual = countMatches(entries, [&](const auto& path) {
+        return anyOf(
+          matchers, [&](const auto& matcher) { return matcher(path, getPathInfo); });
+      });
+    },
+    "filter package entries with makeFilenamePathMatcher");
+
+  CHECK(actual == expected);
+}
+
+TEST_CASE("PathMatcherBenchmark.textureNamePatterns")
+{
+  const auto names = makeNames(TextureNameCount);
+  const auto patterns =
+    std::vector<std::string>{"*clip*", "trigger*", "sky*", "*water*", "lava*_trim"};
+
+  auto expected = size_t(0);
+  timeLambda(
+    [&]() {
+      expected = countMatches(names, [&](const auto& name) {
+        return anyOf(patterns, [&](const auto& pattern) {
+          return kdl::ci::str_matches_glob(name, pattern);
+        });
+      });
+    },
+    "match texture names with str_matches_glob");
+
+  const auto matchers = kdl::vec_transform(
+    patterns, [](const auto& pattern) { return kdl::ci::glob_matcher{pattern}; });
+
+  auto actual = size_t(0);
+  timeLambda(
+    [&]() {
+      actual = countMatches(names, [&](const auto& name) {
+        return anyOf(
+          matchers, [&](const auto& matcher) { return matcher.matches(name); });
+      });
+    },
+    "match texture names with glob_matcher");
+
+  CHECK(actual == expected);
+}
+} // namespace TrenchBroom::IO
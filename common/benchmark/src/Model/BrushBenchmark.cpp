@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PatchNode.h"
+#include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+static constexpr size_t NumBrushes = 1'000;
+
+namespace
+{
+const auto WorldBounds = vm::bbox3{8192.0};
+
+std::vector<std::vector<BrushFace>> readBrushFaces(const std::filesystem::path& path)
+{
+  auto file = IO::Disk::openFileForReading(path).value();
+  auto reader = file->reader().buffer();
+
+  auto status = IO::TestParserStatus{};
+  auto worldReader =
+    IO::WorldReader{reader.stringView(), MapFormat::Standard, EntityPropertyConfig{}};
+  auto world = worldReader.read(WorldBounds, status);
+
+  auto result = std::vector<std::vector<BrushFace>>{};
+  world->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* worldNode) { worldNode->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layerNode) { layerNode->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* groupNode) { groupNode->visitChildren(thisLambda); },
+    [](auto&& thisLambda, EntityNode* entityNode) {
+      entityNode->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brushNode) { result.push_back(brushNode->brush().faces()); },
+    [](PatchNode*) {}));
+  return result;
+}
+
+std::vector<vm::vec3> makeCylinderPoints(const size_t sideCount)
+{
+  auto points = std::vector<vm::vec3>{};
+  for (size_t i = 0; i < sideCount; ++i)
+  {
+    const auto angle = vm::C::two_pi() * FloatType(i) / FloatType(sideCount);
+    const auto x = std::round(std::cos(angle) * 128.0);
+    const auto y = std::round(std::sin(angle) * 128.0);
+    points.emplace_back(x, y, 0.0);
+    points.emplace_back(x, y, 64.0);
+  }
+  return points;
+}
+} // namespace
+
+TEST_CASE("BrushBenchmark.createBrushes")
+{
+  const auto brushFaces = readBrushFaces(
+    std::filesystem::current_path() / "fixture/benchmark/AABBTree/ne_ruins.map");
+  REQUIRE(!brushFaces.empty());
+
+  const auto count = std::to_string(brushFaces.size());
+
+  // clips the world bounds with every face like Brush::create did before it computed the
+  // bounds of axis aligned faces directly
+  auto clippedCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (auto faces : brushFaces)
+      {
+        BrushFace::sortFaces(faces);
+        auto geometry = BrushGeometry{WorldBounds};
+        for (const auto& face : faces)
+        {
+          geometry.clip(face.boundary());
+        }
+        clippedCount += geometry.empty() ? 0u : 1u;
+      }
+    },
+    "clip world bounds with faces of " + count + " brushes");
+  CHECK(clippedCount == brushFaces.size());
+
+  auto createdCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& faces : brushFaces)
+      {
+        createdCount += Brush::create(WorldBounds, faces).is_success() ? 1u : 0u;
+      }
+    },
+    "create " + count + " brushes");
+  CHECK(createdCount == brushFaces.size());
+}
+
+TEST_CASE("BrushBenchmark.createBrushGeometry")
+{
+  using T = std::tuple<std::string, std::vector<vm::vec3>>;
+
+  // clang-format off
+  const auto [name, points] = GENERATE(values<T>({
+    {"cuboid",            {{0, 0, 0}, {64, 0, 0}, {0, 64, 0}, {64, 64, 0},
+                           {0, 0, 64}, {64, 0, 64}, {0, 64, 64}, {64, 64, 64}}},
+    // a triangular terrain prism whose top face is almost horizontal
+    {"terrain",           {{0, 0, 0}, {64, 0, 0}, {0, 64, 0},
+                           {0, 0, 32}, {64, 0, 33}, {0, 64, 31}}},
+    {"16 sided cylinder", makeCylinderPoints(16)},
+    {"64 sided cylinder", makeCylinderPoints(64)},
+  }));
+  // clang-format on
+
+  const auto builder = BrushBuilder{MapFormat::Standard, WorldBounds};
+  const auto faces = builder.createBrush(points, "texture").value().faces();
+
+  // Brush::create takes the faces by value, so they are copied up front to keep the
+  // copies out of the measurement
+  auto faceCopies = std::vector<std::vector<BrushFace>>(NumBrushes, faces);
+  auto createdCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (auto& copy : faceCopies)
+      {
+        const auto brush = Brush::create(WorldBounds, std::move(copy));
+        createdCount += brush.is_success() ? 1u : 0u;
+      }
+    },
+    NumBrushes,
+    "create geometry of " + std::to_string(NumBrushes) + " " + name + " brushes");
+  CHECK(createdCount == NumBrushes);
+}
+} // namespace Model
+} // namespace TrenchBroom
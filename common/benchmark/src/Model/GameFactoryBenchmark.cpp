@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/GameConfig.h"
+#include "Model/GameFactory.h"
+
+#include <kdl/result.h>
+
+#include <filesystem>
+#include <string>
+
+namespace TrenchBroom::Model
+{
+
+TEST_CASE("GameFactoryBenchmark.initialize")
+{
+  const auto gamesPath = std::filesystem::current_path() / "fixture/games";
+  const auto userPath =
+    std::filesystem::temp_directory_path() / "TrenchBroomGameFactoryBenchmark";
+
+  auto& gameFactory = GameFactory::instance();
+  gameFactory.reset();
+
+  timeLambda(
+    [&]() { REQUIRE(gameFactory.initialize({{gamesPath}, userPath}).is_success()); },
+    "initialize game factory");
+
+  timeLambda(
+    [&]() {
+      for (const auto& gameName : gameFactory.gameList())
+      {
+        gameFactory.gameConfig(gameName);
+      }
+    },
+    "load profiles of " + std::to_string(gameFactory.gameCount()) + " games");
+
+  gameFactory.reset();
+  std::filesystem::remove_all(userPath);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+static constexpr size_t NumLinkedGroups = 500;
+static constexpr size_t NumBrushesPerGroup = 64;
+
+TEST_CASE("LinkedGroupsBenchmark.updateLinkedGroups")
+{
+  const auto worldBounds = vm::bbox3{65536.0};
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto makeGroupNode = [](const vm::vec3& offset) {
+    auto group = Group{"group"};
+    group.setLinkedGroupId("linked_group_id");
+    group.setTransformation(vm::translation_matrix(offset));
+    return std::make_unique<GroupNode>(std::move(group));
+  };
+
+  auto sourceGroupNode = makeGroupNode(vm::vec3::zero());
+  auto* entityNode = new EntityNode{Entity{}};
+  sourceGroupNode->addChild(entityNode);
+  for (size_t i = 0; i < NumBrushesPerGroup; ++i)
+  {
+    const auto offset = 64.0 * vm::vec3{double(i % 8), double(i / 8), 0.0};
+    auto brush = builder.createCube(32.0, "texture").value();
+    REQUIRE(
+      brush.transform(worldBounds, vm::translation_matrix(offset), false).is_success());
+    entityNode->addChild(new BrushNode{std::move(brush)});
+  }
+
+  auto targetGroupNodes = std::vector<std::unique_ptr<GroupNode>>{};
+  for (size_t i = 0; i < NumLinkedGroups; ++i)
+  {
+    targetGroupNodes.push_back(
+      makeGroupNode(1024.0 * vm::vec3{double(i % 32), double(i / 32), 1.0}));
+  }
+
+  const auto targetGroupNodePtrs = kdl::vec_transform(
+    targetGroupNodes, [](const auto& groupNode) { return groupNode.get(); });
+
+  timeLambda(
+    [&]() {
+      auto result =
+        updateLinkedGroups(*sourceGroupNode, targetGroupNodePtrs, worldBounds);
+      REQUIRE(result.is_success());
+      CHECK(result.value().size() == NumLinkedGroups);
+    },
+    "update " + std::to_string(NumLinkedGroups) + " linked groups with "
+      + std::to_string(NumBrushesPerGroup) + " brushes each");
+}
+} // namespace Model
+} // namespace TrenchBroom
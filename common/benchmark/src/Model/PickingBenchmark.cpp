@@ -0,0 +1,382 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/EntityProperties.h"
+#include "Model/HitFilter.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelUtils.h"
+#include "Model/PickResult.h"
+#include "Model/WorldNode.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Lasso.h"
+#include "View/VertexHandleManager.h"
+#include "octree.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+static constexpr size_t NumSyntheticBrushes = 500'000;
+static constexpr size_t NumPicks = 10'000;
+static constexpr size_t NumBoxQueries = 10'000;
+static constexpr size_t NumDraggedBrushes = 256;
+static constexpr size_t NumDragSteps = 64;
+
+namespace
+{
+const auto WorldBounds = vm::bbox3{8192.0};
+
+std::unique_ptr<WorldNode> readWorld(const std::filesystem::path& path)
+{
+  auto file = IO::Disk::openFileForReading(path).value();
+  auto reader = file->reader().buffer();
+
+  auto status = IO::TestParserStatus{};
+  auto worldReader =
+    IO::WorldReader{reader.stringView(), MapFormat::Standard, EntityPropertyConfig{}};
+  return worldReader.read(WorldBounds, status);
+}
+
+/**
+ * Creates a world with the given number of cubes of varying sizes that are arranged in a
+ * grid with a spacing of 64 units.
+ */
+std::unique_ptr<WorldNode> makeSyntheticWorld(const size_t brushCount)
+{
+  auto world =
+    std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, MapFormat::Standard);
+  const auto builder = BrushBuilder{MapFormat::Standard, WorldBounds};
+
+  constexpr auto GridSize = size_t(100);
+  auto brushNodes = std::vector<Node*>{};
+  brushNodes.reserve(brushCount);
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    const auto min = vm::vec3{
+      FloatType(i % GridSize) * 64.0 - 3200.0,
+      FloatType((i / GridSize) % GridSize) * 64.0 - 3200.0,
+      FloatType(i / (GridSize * GridSize)) * 64.0 - 3200.0};
+    const auto size = FloatType(16 + (i * 7) % 3 * 16);
+    brushNodes.push_back(new BrushNode{
+      builder.createCuboid(vm::bbox3{min, min + vm::vec3::fill(size)}, "texture")
+        .value()});
+  }
+  world->defaultLayer()->addChildren(brushNodes);
+
+  return world;
+}
+
+std::vector<vm::ray3> makeRandomRays(const vm::bbox3& bounds, const size_t count)
+{
+  auto rng = std::mt19937{0};
+  auto coord = std::uniform_real_distribution<FloatType>{0.0, 1.0};
+  auto dir = std::uniform_real_distribution<FloatType>{-1.0, 1.0};
+
+  auto rays = std::vector<vm::ray3>{};
+  rays.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto origin =
+      bounds.min + bounds.size() * vm::vec3{coord(rng), coord(rng), coord(rng)};
+    auto direction = vm::vec3{dir(rng), dir(rng), dir(rng)};
+    if (vm::is_zero(direction, vm::C::almost_zero()))
+    {
+      direction = vm::vec3::pos_x();
+    }
+    rays.emplace_back(origin, vm::normalize(direction));
+  }
+  return rays;
+}
+
+std::vector<vm::bbox3> makeRandomBoxes(
+  const vm::bbox3& bounds, const FloatType size, const size_t count)
+{
+  auto rng = std::mt19937{0};
+  auto coord = std::uniform_real_distribution<FloatType>{0.0, 1.0};
+
+  auto boxes = std::vector<vm::bbox3>{};
+  boxes.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min =
+      bounds.min + bounds.size() * vm::vec3{coord(rng), coord(rng), coord(rng)};
+    boxes.emplace_back(min, min + vm::vec3::fill(size));
+  }
+  return boxes;
+}
+
+void benchmarkPicks(WorldNode& world, const std::string& name)
+{
+  const auto editorContext = EditorContext{};
+  const auto rays = makeRandomRays(world.defaultLayer()->logicalBounds(), NumPicks);
+
+  auto hitCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult::byDistance();
+        world.pick(editorContext, ray, pickResult);
+        hitCount += pickResult.all().size();
+      }
+    },
+    rays.size(),
+    "pick " + std::to_string(rays.size()) + " random rays in " + name);
+  printf("Hits found in %s: %zu\n", name.c_str(), hitCount);
+
+  timeOperations(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult::byDistance();
+        world.pickNearest(
+          editorContext, ray, HitFilters::type(BrushNode::BrushHitType), pickResult);
+      }
+    },
+    rays.size(),
+    "pick the nearest brush for " + std::to_string(rays.size()) + " random rays in "
+      + name);
+}
+
+void benchmarkQueries(WorldNode& world, const std::string& name)
+{
+  const auto& bounds = world.defaultLayer()->logicalBounds();
+  const auto boxes = makeRandomBoxes(bounds, 256.0, NumBoxQueries);
+
+  auto nodeCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (const auto& box : boxes)
+      {
+        nodeCount += world.nodeTree().find_intersectors(box).size();
+      }
+    },
+    boxes.size(),
+    "find nodes intersecting " + std::to_string(boxes.size()) + " random boxes in "
+      + name);
+  printf("Nodes found in %s: %zu\n", name.c_str(), nodeCount);
+
+  timeOperations(
+    [&]() {
+      for (const auto& box : boxes)
+      {
+        auto nodes = std::vector<Node*>{};
+        world.findNodesContaining(box.center(), nodes);
+      }
+    },
+    boxes.size(),
+    "find nodes containing " + std::to_string(boxes.size()) + " random points in "
+      + name);
+}
+
+void benchmarkNodeTree(WorldNode& world, const std::string& name)
+{
+  auto items = std::vector<std::tuple<vm::bbox3, Node*>>{};
+  for (auto* node : collectNodes({&world}))
+  {
+    if (node->shouldAddToSpacialIndex())
+    {
+      items.emplace_back(node->physicalBounds(), node);
+    }
+  }
+
+  auto nodeTree = octree<FloatType, Node*>{256.0};
+  timeOperations(
+    [&]() { nodeTree.insert(items); },
+    items.size(),
+    "insert " + std::to_string(items.size()) + " nodes of " + name
+      + " into node tree at once");
+
+  timeOperations(
+    [&]() {
+      for (const auto& [bounds, node] : items)
+      {
+        nodeTree.remove(node);
+      }
+    },
+    items.size(),
+    "remove " + std::to_string(items.size()) + " nodes of " + name
+      + " from node tree one by one");
+  CHECK(nodeTree.empty());
+}
+
+void benchmarkLasso(WorldNode& world, const std::string& name)
+{
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (auto* node : collectNodes({&world}))
+  {
+    if (auto* brushNode = dynamic_cast<BrushNode*>(node))
+    {
+      brushNodes.push_back(brushNode);
+    }
+  }
+
+  auto handleManager = View::VertexHandleManager{};
+  timeLambda(
+    [&]() { handleManager.addHandles(std::begin(brushNodes), std::end(brushNodes)); },
+    "add vertex handles of " + std::to_string(brushNodes.size()) + " brushes of "
+      + name);
+
+  const auto& bounds = world.defaultLayer()->logicalBounds();
+  const auto viewport = Renderer::Camera::Viewport{0, 0, 1024, 768};
+  const auto camera = Renderer::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    65536.0f,
+    viewport,
+    vm::vec3f{bounds.center() - vm::vec3::pos_x() * bounds.size().x()},
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+
+  // the lasso covers the center quarter of the viewport
+  const auto lassoPoint = [&](const float x, const float y) {
+    const auto distance = FloatType(64.0);
+    const auto plane = vm::orthogonal_plane(
+      vm::vec3{camera.defaultPoint(float(distance))}, vm::vec3{camera.direction()});
+    const auto ray = vm::ray3{camera.pickRay(x, y)};
+    return vm::point_at_distance(ray, vm::intersect_ray_plane(ray, plane));
+  };
+  auto lasso = View::Lasso{camera, 64.0, lassoPoint(256.0f, 192.0f)};
+  lasso.update(lassoPoint(768.0f, 576.0f));
+
+  auto selectedHandles = std::vector<vm::vec3>{};
+  timeLambda(
+    [&]() {
+      const auto candidateHandles = handleManager.findHandles(
+        [&](const vm::bbox3& cellBounds) { return lasso.mayIntersect(cellBounds); });
+      lasso.selected(
+        std::begin(candidateHandles),
+        std::end(candidateHandles),
+        std::back_inserter(selectedHandles));
+    },
+    "lasso select vertex handles of " + name);
+  printf(
+    "Vertex handles selected in %s: %zu of %zu\n",
+    name.c_str(),
+    selectedHandles.size(),
+    handleManager.allHandles().size());
+}
+
+/**
+ * Simulates dragging a number of brushes, where every drag step moves the brushes and
+ * then picks the world as the mouse move that causes the next drag step would.
+ */
+void benchmarkDrag(WorldNode& world, const std::string& name)
+{
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (auto* node : collectNodes({&world}))
+  {
+    if (auto* brushNode = dynamic_cast<BrushNode*>(node))
+    {
+      brushNodes.push_back(brushNode);
+    }
+  }
+
+  auto draggedBrushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < NumDraggedBrushes && i < brushNodes.size(); ++i)
+  {
+    draggedBrushNodes.push_back(brushNodes[i * brushNodes.size() / NumDraggedBrushes]);
+  }
+
+  const auto editorContext = EditorContext{};
+  const auto rays = makeRandomRays(world.defaultLayer()->logicalBounds(), NumDragSteps);
+  const auto transform = vm::translation_matrix(vm::vec3{3.0, 2.0, 1.0});
+
+  timeOperations(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        for (auto* brushNode : draggedBrushNodes)
+        {
+          auto brush = brushNode->brush();
+          brush.transform(WorldBounds, transform, false)
+            .transform([&]() { brushNode->setBrush(std::move(brush)); })
+            .transform_error([](const auto& e) { FAIL(e.msg); });
+        }
+
+        auto pickResult = PickResult::byDistance();
+        world.pick(editorContext, ray, pickResult);
+      }
+    },
+    NumDragSteps,
+    "drag " + std::to_string(draggedBrushNodes.size()) + " brushes of " + name + " by "
+      + std::to_string(NumDragSteps) + " steps, picking after each step");
+}
+
+void benchmarkWorld(WorldNode& world, const std::string& name)
+{
+  benchmarkPicks(world, name);
+  benchmarkQueries(world, name);
+  benchmarkNodeTree(world, name);
+  benchmarkLasso(world, name);
+  benchmarkDrag(world, name);
+}
+} // namespace
+
+TEST_CASE("PickingBenchmark.neRuins")
+{
+  const auto world = readWorld(
+    std::filesystem::current_path() / "fixture/benchmark/AABBTree/ne_ruins.map");
+  REQUIRE(world != nullptr);
+
+  benchmarkWorld(*world, "ne_ruins.map");
+}
+
+TEST_CASE("PickingBenchmark.synthetic")
+{
+  auto world = std::unique_ptr<WorldNode>{};
+  timeLambda(
+    [&]() { world = makeSyntheticWorld(NumSyntheticBrushes); },
+    "create synthetic world with " + std::to_string(NumSyntheticBrushes) + " brushes");
+
+  benchmarkWorld(*world, "synthetic world");
+}
+
+} // namespace Model
+} // namespace TrenchBroom
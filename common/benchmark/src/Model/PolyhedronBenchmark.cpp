@@ -0,0 +1,340 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron3.h"
+#include "Model/Polyhedron_Matcher.h"
+
+#include <kdl/memory_pool.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/plane.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+static constexpr size_t NumPolyhedra = 64'000;
+static constexpr size_t NumOperations = 1'000;
+static constexpr size_t NumConvexHulls = 100;
+
+TEST_CASE("PolyhedronBenchmark.buildPolyhedra")
+{
+  auto polyhedra = std::vector<std::unique_ptr<Polyhedron3>>{};
+  polyhedra.reserve(NumPolyhedra);
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumPolyhedra; ++i)
+      {
+        const auto offset = 64.0 * vm::vec3{double(i % 64), double(i / 64), 0.0};
+        polyhedra.push_back(std::make_unique<Polyhedron3>(std::vector<vm::vec3>{
+          offset + vm::vec3{0, 0, 0},
+          offset + vm::vec3{64, 0, 0},
+          offset + vm::vec3{0, 64, 0},
+          offset + vm::vec3{64, 64, 0},
+          offset + vm::vec3{0, 0, 64},
+          offset + vm::vec3{64, 0, 64},
+          offset + vm::vec3{0, 64, 64},
+          offset + vm::vec3{64, 64, 64},
+          offset + vm::vec3{32, 32, 96},
+        }));
+      }
+    },
+    "build " + std::to_string(NumPolyhedra) + " polyhedra");
+
+  timeLambda(
+    [&]() { polyhedra.clear(); },
+    "destroy " + std::to_string(NumPolyhedra) + " polyhedra");
+}
+
+namespace
+{
+template <typename T>
+struct PoolAllocator
+{
+  using Pool = kdl::memory_pool<sizeof(T), alignof(T)>;
+
+  static void* allocate() { return Pool::allocate(); }
+  static void deallocate(void* ptr) { Pool::deallocate(ptr); }
+};
+
+template <typename T>
+struct HeapAllocator
+{
+  static void* allocate() { return ::operator new(sizeof(T)); }
+  static void deallocate(void* ptr) { ::operator delete(ptr); }
+};
+
+/**
+ * Allocates and frees memory for the elements of NumPolyhedra cuboids, one cuboid after
+ * another, using the given allocator template.
+ */
+template <template <typename> typename Allocator>
+void allocateCuboidElements()
+{
+  using Vertex = Allocator<Polyhedron3::Vertex>;
+  using Edge = Allocator<Polyhedron3::Edge>;
+  using HalfEdge = Allocator<Polyhedron3::HalfEdge>;
+  using Face = Allocator<Polyhedron3::Face>;
+
+  struct Elements
+  {
+    std::vector<void*> vertices;
+    std::vector<void*> edges;
+    std::vector<void*> halfEdges;
+    std::vector<void*> faces;
+  };
+
+  auto elements = std::vector<Elements>(NumPolyhedra);
+  for (auto& e : elements)
+  {
+    for (size_t i = 0; i < 8; ++i)
+    {
+      e.vertices.push_back(Vertex::allocate());
+    }
+    for (size_t i = 0; i < 12; ++i)
+    {
+      e.edges.push_back(Edge::allocate());
+    }
+    for (size_t i = 0; i < 24; ++i)
+    {
+      e.halfEdges.push_back(HalfEdge::allocate());
+    }
+    for (size_t i = 0; i < 6; ++i)
+    {
+      e.faces.push_back(Face::allocate());
+    }
+  }
+
+  for (auto& e : elements)
+  {
+    for (auto* ptr : e.vertices)
+    {
+      Vertex::deallocate(ptr);
+    }
+    for (auto* ptr : e.edges)
+    {
+      Edge::deallocate(ptr);
+    }
+    for (auto* ptr : e.halfEdges)
+    {
+      HalfEdge::deallocate(ptr);
+    }
+    for (auto* ptr : e.faces)
+    {
+      Face::deallocate(ptr);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.allocateElements")
+{
+  // warm up the pools so that both variants start with free memory available
+  allocateCuboidElements<PoolAllocator>();
+
+  timeLambda(
+    [&]() { allocateCuboidElements<HeapAllocator>(); },
+    "allocate elements of " + std::to_string(NumPolyhedra)
+      + " cuboids individually on the heap");
+  timeLambda(
+    [&]() { allocateCuboidElements<PoolAllocator>(); },
+    "allocate elements of " + std::to_string(NumPolyhedra)
+      + " cuboids from memory pools");
+}
+
+namespace
+{
+std::vector<vm::vec3> makeSpherePoints(const size_t count, std::mt19937& rng)
+{
+  auto coord = std::normal_distribution<FloatType>{};
+
+  auto points = std::vector<vm::vec3>{};
+  points.reserve(count);
+  while (points.size() < count)
+  {
+    const auto point = vm::vec3{coord(rng), coord(rng), coord(rng)};
+    if (!vm::is_zero(point, vm::C::almost_zero()))
+    {
+      points.push_back(vm::round(vm::normalize(point) * 256.0));
+    }
+  }
+  return points;
+}
+
+std::vector<vm::vec3> makeCylinderPoints(const size_t sideCount)
+{
+  auto points = std::vector<vm::vec3>{};
+  points.reserve(2 * sideCount);
+  for (size_t i = 0; i < sideCount; ++i)
+  {
+    const auto angle = vm::C::two_pi() * FloatType(i) / FloatType(sideCount);
+    const auto x = std::round(std::cos(angle) * 64.0);
+    const auto y = std::round(std::sin(angle) * 64.0);
+    points.emplace_back(x, y, -64.0);
+    points.emplace_back(x, y, 64.0);
+  }
+  return points;
+}
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.convexHull")
+{
+  const auto pointCount = GENERATE(size_t(8), size_t(16), size_t(32), size_t(64));
+
+  auto rng = std::mt19937{0};
+  auto pointClouds = std::vector<std::vector<vm::vec3>>{};
+  for (size_t i = 0; i < NumConvexHulls; ++i)
+  {
+    pointClouds.push_back(makeSpherePoints(pointCount, rng));
+  }
+
+  auto vertexCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (auto& points : pointClouds)
+      {
+        vertexCount += Polyhedron3{std::move(points)}.vertexCount();
+      }
+    },
+    NumConvexHulls,
+    "build " + std::to_string(NumConvexHulls) + " convex hulls of "
+      + std::to_string(pointCount) + " points");
+  CHECK(vertexCount > 0u);
+}
+
+TEST_CASE("PolyhedronBenchmark.clip")
+{
+  using T = std::tuple<std::string, Polyhedron3>;
+
+  const auto [name, polyhedron] = GENERATE(values<T>({
+    {"cube", Polyhedron3{vm::bbox3{64.0}}},
+    {"64 sided cylinder", Polyhedron3{makeCylinderPoints(64)}},
+  }));
+
+  auto rng = std::mt19937{0};
+  auto coord = std::uniform_real_distribution<FloatType>{-1.0, 1.0};
+
+  auto planes = std::vector<vm::plane3>{};
+  for (size_t i = 0; i < NumOperations; ++i)
+  {
+    auto normal = vm::vec3{coord(rng), coord(rng), coord(rng)};
+    if (vm::is_zero(normal, vm::C::almost_zero()))
+    {
+      normal = vm::vec3::pos_z();
+    }
+    const auto anchor = vm::vec3{coord(rng), coord(rng), coord(rng)} * 32.0;
+    planes.emplace_back(anchor, vm::normalize(normal));
+  }
+
+  auto copies = std::vector<Polyhedron3>(NumOperations, polyhedron);
+  auto clippedCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (size_t i = 0; i < NumOperations; ++i)
+      {
+        clippedCount += copies[i].clip(planes[i]).success() ? 1u : 0u;
+      }
+    },
+    NumOperations,
+    "clip " + std::to_string(NumOperations) + " " + name + " polyhedra");
+  CHECK(clippedCount > 0u);
+}
+
+TEST_CASE("PolyhedronBenchmark.csg")
+{
+  const auto minuend = Polyhedron3{vm::bbox3{64.0}};
+
+  auto rng = std::mt19937{0};
+  auto angle = std::uniform_real_distribution<FloatType>{0.0, vm::C::two_pi()};
+
+  // rotated cylinders that cut through the minuend
+  const auto cylinder = makeCylinderPoints(16);
+  auto subtrahends = std::vector<Polyhedron3>{};
+  for (size_t i = 0; i < NumOperations; ++i)
+  {
+    const auto transform = vm::rotation_matrix(angle(rng), angle(rng), angle(rng))
+                           * vm::scaling_matrix(vm::vec3{0.5, 0.5, 2.0});
+    subtrahends.emplace_back(
+      kdl::vec_transform(cylinder, [&](const auto& point) { return transform * point; }));
+  }
+
+  auto fragmentCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (const auto& subtrahend : subtrahends)
+      {
+        fragmentCount += minuend.subtract(subtrahend).size();
+      }
+    },
+    NumOperations,
+    "subtract " + std::to_string(NumOperations) + " cylinders from a cube");
+  CHECK(fragmentCount > 0u);
+
+  auto intersectionCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (const auto& subtrahend : subtrahends)
+      {
+        intersectionCount += minuend.intersect(subtrahend).empty() ? 0u : 1u;
+      }
+    },
+    NumOperations,
+    "intersect " + std::to_string(NumOperations) + " cylinders with a cube");
+  CHECK(intersectionCount > 0u);
+}
+
+TEST_CASE("PolyhedronBenchmark.matchPolyhedra")
+{
+  // the same as moving a vertex of a cylinder brush with the vertex tool
+  const auto left = Polyhedron3{makeCylinderPoints(64)};
+  auto positions = left.vertexPositions();
+  positions.front() = positions.front() + vm::vec3{0.0, 0.0, 16.0};
+  const auto right = Polyhedron3{positions};
+
+  auto matchCount = size_t(0);
+  timeOperations(
+    [&]() {
+      for (size_t i = 0; i < NumOperations; ++i)
+      {
+        const auto matcher = PolyhedronMatcher<Polyhedron3>{left, right};
+        matcher.processRightFaces([&](const auto*, const auto*) { ++matchCount; });
+      }
+    },
+    NumOperations,
+    "match " + std::to_string(NumOperations) + " 64 sided cylinders");
+  CHECK(matchCount == NumOperations * right.faceCount());
+}
+} // namespace Model
+} // namespace TrenchBroom
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "octree.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+static constexpr size_t NumItems = 32'000;
+static constexpr size_t NumDraggedItems = 1'000;
+static constexpr size_t NumDragSteps = 512;
+
+namespace
+{
+std::vector<std::tuple<vm::bbox3d, size_t>> makeItems()
+{
+  auto items = std::vector<std::tuple<vm::bbox3d, size_t>>{};
+  items.reserve(NumItems);
+  for (size_t i = 0; i < NumItems; ++i)
+  {
+    const auto min = vm::vec3d{
+      double(i % 32) * 96.0 - 1536.0,
+      double((i / 32) % 32) * 96.0 - 1536.0,
+      double(i / 1024) * 96.0 - 1536.0};
+    const auto size = double(16 + (i * 7) % 5 * 16);
+    items.emplace_back(vm::bbox3d{min, min + vm::vec3d::fill(size)}, i);
+  }
+  return items;
+}
+
+/**
+ * Drags some of the items by a few units per step, like a mouse drag does, and updates
+ * the tree after every step. Returns the total number of items that were moved to a
+ * different node of the tree.
+ */
+size_t dragItems(
+  octree<double, size_t>& tree, std::vector<std::tuple<vm::bbox3d, size_t>> items)
+{
+  auto movedCount = size_t(0);
+  for (size_t step = 0; step < NumDragSteps; ++step)
+  {
+    const auto delta = vm::vec3d{3.0, 2.0, 1.0};
+    for (auto& [bounds, data] : items)
+    {
+      bounds = vm::bbox3d{bounds.min + delta, bounds.max + delta};
+    }
+    movedCount += tree.update(items);
+  }
+  return movedCount;
+}
+
+void benchmarkDrag(const bool loose)
+{
+  const auto mode = std::string{loose ? "loose" : "tight"};
+
+  auto items = makeItems();
+  auto tree = octree<double, size_t>{256.0, loose};
+  tree.insert(items);
+
+  auto draggedItems = std::vector<std::tuple<vm::bbox3d, size_t>>{};
+  for (size_t i = 0; i < NumDraggedItems; ++i)
+  {
+    draggedItems.push_back(items[i * NumItems / NumDraggedItems]);
+  }
+
+  auto movedCount = size_t(0);
+  timeLambda(
+    [&]() { movedCount = dragItems(tree, std::move(draggedItems)); },
+    "drag " + std::to_string(NumDraggedItems) + " items in " + mode + " octree by "
+      + std::to_string(NumDragSteps) + " steps");
+
+  printf(
+    "Items moved to a different node in %s octree: %zu of %zu updates\n",
+    mode.c_str(),
+    movedCount,
+    NumDraggedItems * NumDragSteps);
+}
+} // namespace
+
+TEST_CASE("OctreeBenchmark.drag")
+{
+  benchmarkDrag(false);
+  benchmarkDrag(true);
+}
+} // namespace TrenchBroom
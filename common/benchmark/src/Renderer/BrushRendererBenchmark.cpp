@@ -31,6 +31,7 @@
 #include "Renderer/BrushRenderer.h"
 
 #include <kdl/result.h>
+#include <kdl/vector_utils.h>
 
 #include <algorithm>
 #include <chrono>
@@ -44,6 +45,7 @@ namespace Renderer
 {
 static constexpr size_t NumBrushes = 64'000;
 static constexpr size_t NumTextures = 256;
+static constexpr size_t NumSelectedBrushes = 50'000;
 
 /**
  * Both returned vectors need to be freed with VecUtils::clearAndDelete
@@ -151,6 +153,98 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
     },
     "validate remaining brushes");
 
+  // Large change: invalidate the remaining brushes one by one, like changing the
+  // selection does
+  timeLambda(
+    [&]() {
+      for (auto* brush : brushes)
+      {
+        r.invalidateBrush(brush);
+      }
+    },
+    "invalidate remaining brushes individually");
+
+  timeLambda(
+    [&]() {
+      if (!r.valid())
+      {
+        r.validate();
+      }
+    },
+    "validate individually invalidated brushes");
+
+  // Large change with vertex generation: invalidate the vertex caches of all brushes,
+  // like a transformation of a large selection does
+  timeLambda(
+    [&]() {
+      for (auto* brush : brushes)
+      {
+        brush->invalidateVertexCache();
+      }
+      r.invalidate();
+    },
+    "invalidate vertex caches of all brushes");
+
+  timeLambda(
+    [&]() {
+      if (!r.valid())
+      {
+        r.validate();
+      }
+    },
+    "validate remaining brushes with vertex generation");
+
+  kdl::vec_clear_and_delete(brushes);
+  kdl::vec_clear_and_delete(textures);
+}
+
+/**
+ * Selecting and deselecting brushes moves them between the renderer of their layer and
+ * the selection renderer. Only the moved brushes should be uploaded again.
+ */
+TEST_CASE("BrushRendererBenchmark.selectAndDeselectBrushes")
+{
+  auto [brushes, textures] = makeBrushes();
+  const auto selectedBrushes = kdl::vec_slice_prefix(brushes, NumSelectedBrushes);
+
+  BrushRenderer defaultRenderer;
+  BrushRenderer selectionRenderer;
+
+  for (auto* brush : brushes)
+  {
+    defaultRenderer.addBrush(brush);
+  }
+  defaultRenderer.validate();
+
+  const auto moveBrushes = [&](BrushRenderer& from, BrushRenderer& to) {
+    for (auto* brush : selectedBrushes)
+    {
+      from.removeBrush(brush);
+      to.addBrush(brush);
+    }
+  };
+
+  const auto validate = [&]() {
+    if (!defaultRenderer.valid())
+    {
+      defaultRenderer.validate();
+    }
+    if (!selectionRenderer.valid())
+    {
+      selectionRenderer.validate();
+    }
+  };
+
+  timeLambda(
+    [&]() { moveBrushes(defaultRenderer, selectionRenderer); },
+    "select " + std::to_string(selectedBrushes.size()) + " brushes");
+  timeLambda(validate, "validate after selecting brushes");
+
+  timeLambda(
+    [&]() { moveBrushes(selectionRenderer, defaultRenderer); },
+    "deselect " + std::to_string(selectedBrushes.size()) + " brushes");
+  timeLambda(validate, "validate after deselecting brushes");
+
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(textures);
 }
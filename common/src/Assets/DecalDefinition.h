@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "EL/CompiledExpression.h"
 #include "EL/Expression.h"
 
 #include <kdl/reflection_decl.h>
@@ -26,6 +27,8 @@
 #include <vecmath/vec.h>
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom::Assets
 {
@@ -46,6 +49,7 @@ class DecalDefinition
 {
 private:
   EL::Expression m_expression;
+  EL::CompiledExpression m_compiledExpression;
 
 public:
   DecalDefinition();
@@ -54,6 +58,12 @@ public:
 
   void append(const DecalDefinition& other);
 
+  /**
+   * Returns the names of the variables that the decal expression may read. The decal
+   * specification does not depend on any other variables.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   /**
    * Evaluates the decal expresion, using the given variable store to interpolate
    * variables.
@@ -115,24 +115,26 @@ const PropertyDefinition* EntityDefinition::safeGetPropertyDefinition(
     return nullptr;
   }
 
-  const auto& propertyDefinitions = entityDefinition->propertyDefinitions();
-  const auto it = std::find_if(
-    propertyDefinitions.begin(),
-    propertyDefinitions.end(),
-    [&](const auto& propertyDefinition) {
-      return propertyDefinition->key() == propertyKey;
-    });
-  return it != propertyDefinitions.end() ? it->get() : nullptr;
+  const auto& propertyDefinitionsByKey = entityDefinition->m_propertyDefinitionsByKey;
+  const auto it = propertyDefinitionsByKey.find(propertyKey);
+  return it != propertyDefinitionsByKey.end() ? it->second : nullptr;
 }
 
 const FlagsPropertyDefinition* EntityDefinition::safeGetFlagsPropertyDefinition(
   const EntityDefinition* entityDefinition, const std::string& propertyKey)
 {
-  if (entityDefinition == nullptr)
+  const auto* propertyDefinition =
+    safeGetPropertyDefinition(entityDefinition, propertyKey);
+  if (propertyDefinition == nullptr)
   {
     return nullptr;
   }
+  if (propertyDefinition->type() == PropertyDefinitionType::FlagsProperty)
+  {
+    return static_cast<const FlagsPropertyDefinition*>(propertyDefinition);
+  }
 
+  // the first definition with this key is not a flags property, so look for a later one
   const auto& propertyDefinitions = entityDefinition->propertyDefinitions();
   const auto it = std::find_if(
     propertyDefinitions.begin(),
@@ -183,6 +185,12 @@ EntityDefinition::EntityDefinition(
   , m_usageCount{0}
   , m_propertyDefinitions{std::move(propertyDefinitions)}
 {
+  m_propertyDefinitionsByKey.reserve(m_propertyDefinitions.size());
+  for (const auto& propertyDefinition : m_propertyDefinitions)
+  {
+    m_propertyDefinitionsByKey.emplace(
+      propertyDefinition->key(), propertyDefinition.get());
+  }
 }
 
 PointEntityDefinition::PointEntityDefinition(
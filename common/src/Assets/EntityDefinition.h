@@ -29,6 +29,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -60,6 +61,8 @@ private:
   std::string m_description;
   std::atomic<size_t> m_usageCount;
   std::vector<std::shared_ptr<PropertyDefinition>> m_propertyDefinitions;
+  // the first property definition for each key, for lookups by key
+  std::unordered_map<std::string, const PropertyDefinition*> m_propertyDefinitionsByKey;
 
 public:
   virtual ~EntityDefinition();
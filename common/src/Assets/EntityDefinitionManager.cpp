@@ -27,6 +27,7 @@
 #include "Model/Entity.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
+#include "Trace.h"
 
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
@@ -46,6 +47,8 @@ Result<void> EntityDefinitionManager::loadDefinitions(
   const IO::EntityDefinitionLoader& loader,
   IO::ParserStatus& status)
 {
+  traceZone("EntityDefinitionManager::loadDefinitions");
+
   return loader.loadEntityDefinitions(status, path)
     .transform(
       [&](auto entityDefinitions) { setDefinitions(std::move(entityDefinitions)); });
@@ -135,6 +138,7 @@ void EntityDefinitionManager::updateGroups()
 void EntityDefinitionManager::updateCache()
 {
   clearCache();
+  m_cache.reserve(m_definitions.size());
   for (EntityDefinition* definition : m_definitions)
   {
     m_cache[definition->name()] = definition;
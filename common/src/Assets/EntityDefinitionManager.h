@@ -22,8 +22,8 @@
 #include "Result.h"
 
 #include <filesystem>
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -48,7 +48,7 @@ enum class EntityDefinitionType;
 class EntityDefinitionManager
 {
 private:
-  using Cache = std::map<std::string, EntityDefinition*>;
+  using Cache = std::unordered_map<std::string, EntityDefinition*>;
   std::vector<EntityDefinition*> m_definitions;
   std::vector<EntityDefinitionGroup> m_groups;
   Cache m_cache;
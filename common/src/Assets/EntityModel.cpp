@@ -20,11 +20,16 @@
 #include "EntityModel.h"
 
 #include "Assets/TextureCollection.h"
+#include "Exceptions.h"
+#include "Renderer/GL.h"
+#include "Renderer/IndexArray.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/PrimType.h"
+#include "Renderer/TexturedIndexArrayMap.h"
+#include "Renderer/TexturedIndexArrayRenderer.h"
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
-#include "octree.h"
+#include "triangle_bvh.h"
 
 #include <kdl/vector_utils.h>
 
@@ -32,6 +37,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/intersection.h>
 
+#include <limits>
 #include <string>
 
 namespace TrenchBroom
@@ -76,7 +82,6 @@ EntityModelLoadedFrame::EntityModelLoadedFrame(
   , m_bounds{bounds}
   , m_pitchType{pitchType}
   , m_orientation{orientation}
-  , m_spacialTree{std::make_unique<SpacialTree>(16.0f)}
 {
 }
 
@@ -109,19 +114,14 @@ Orientation EntityModelLoadedFrame::orientation() const
 
 float EntityModelLoadedFrame::intersect(const vm::ray3f& ray) const
 {
-  auto closestDistance = vm::nan<float>();
-
-  const auto candidates = m_spacialTree->find_intersectors(ray);
-  for (const TriNum triNum : candidates)
+  if (!m_spacialTree)
   {
-    const vm::vec3f& p1 = m_tris[triNum * 3 + 0];
-    const vm::vec3f& p2 = m_tris[triNum * 3 + 1];
-    const vm::vec3f& p3 = m_tris[triNum * 3 + 2];
-    closestDistance =
-      vm::safe_min(closestDistance, vm::intersect_ray_triangle(ray, p1, p2, p3));
+    // most frames are never picked, so the hierarchy is only built when needed
+    m_spacialTree = std::make_unique<triangle_bvh<float>>(m_tris);
+    m_tris = std::vector<vm::vec3f>{};
   }
 
-  return closestDistance;
+  return m_spacialTree->intersect(ray);
 }
 
 void EntityModelLoadedFrame::addToSpacialTree(
@@ -142,19 +142,10 @@ void EntityModelLoadedFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + count);
     for (size_t i = 0; i < count; i += 3)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const size_t triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree->insert(bounds.bounds(), triIndex);
+      addToSpacialTree(p1, p2, p3);
     }
     break;
   }
@@ -166,18 +157,9 @@ void EntityModelLoadedFrame::addToSpacialTree(
     const auto& p1 = Renderer::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i]);
       const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const size_t triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree->insert(bounds.bounds(), triIndex);
+      addToSpacialTree(p1, p2, p3);
     }
     break;
   }
@@ -188,28 +170,17 @@ void EntityModelLoadedFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + (count - 2) * 3);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const size_t triIndex = m_tris.size() / 3u;
       if (i % 2 == 0)
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p2);
-        m_tris.push_back(p3);
+        addToSpacialTree(p1, p2, p3);
       }
       else
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p3);
-        m_tris.push_back(p2);
+        addToSpacialTree(p1, p3, p2);
       }
-      m_spacialTree->insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -217,6 +188,16 @@ void EntityModelLoadedFrame::addToSpacialTree(
   }
 }
 
+void EntityModelLoadedFrame::addToSpacialTree(
+  const vm::vec3f& p1, const vm::vec3f& p2, const vm::vec3f& p3)
+{
+  assert(!m_spacialTree);
+
+  m_tris.push_back(p1);
+  m_tris.push_back(p2);
+  m_tris.push_back(p3);
+}
+
 // EntityModel::UnloadedFrame
 
 /**
@@ -286,9 +267,18 @@ public:
    * @param skin the texture to use when rendering the mesh
    * @return the renderer
    */
-  std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(const Texture* skin)
+  /**
+   * Returns the number of bytes occupied by the vertices of this mesh.
+   */
+  virtual size_t memoryUsage() const
   {
-    const auto vertexArray = Renderer::VertexArray::ref(m_vertices);
+    return m_vertices.capacity() * sizeof(EntityModelVertex);
+  }
+
+  std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(
+    const Texture* skin, Renderer::VertexBufferPool& vertexBufferPool)
+  {
+    const auto vertexArray = Renderer::VertexArray::pooled(vertexBufferPool, m_vertices);
     return doBuildRenderer(skin, vertexArray);
   }
 
@@ -300,7 +290,7 @@ private:
    * @param vertices the vertices associated with this mesh
    * @return the renderer
    */
-  virtual std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(
+  virtual std::unique_ptr<Renderer::TexturedRenderer> doBuildRenderer(
     const Texture* skin, const Renderer::VertexArray& vertices) = 0;
 };
 
@@ -336,7 +326,7 @@ public:
   }
 
 private:
-  std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(
+  std::unique_ptr<Renderer::TexturedRenderer> doBuildRenderer(
     const Texture* skin, const Renderer::VertexArray& vertices) override
   {
     const Renderer::TexturedIndexRangeMap texturedIndices(skin, m_indices);
@@ -381,13 +371,81 @@ public:
   }
 
 private:
-  std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(
+  std::unique_ptr<Renderer::TexturedRenderer> doBuildRenderer(
     const Texture* /* skin */, const Renderer::VertexArray& vertices) override
   {
     return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, m_indices);
   }
 };
 
+// EntityModel::ElementMesh
+
+/**
+ * A model frame mesh for rendering triangles whose vertices are shared. Stores vertices
+ * and three vertex indices per triangle, using 16 bit indices if possible.
+ */
+class EntityModelElementMesh : public EntityModelMesh
+{
+private:
+  Renderer::IndexArray m_indices;
+
+public:
+  /**
+   * Creates a new frame mesh with the given vertices and indices.
+   *
+   * @param frame the frame to which this mesh belongs
+   * @param vertices the vertices
+   * @param indices the vertex indices, three per triangle
+   */
+  EntityModelElementMesh(
+    EntityModelLoadedFrame& frame,
+    std::vector<EntityModelVertex> vertices,
+    std::vector<uint32_t> indices)
+    : EntityModelMesh{std::move(vertices)}
+  {
+    assert(indices.size() % 3 == 0);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+      frame.addToSpacialTree(
+        Renderer::getVertexComponent<0>(m_vertices[indices[i + 0]]),
+        Renderer::getVertexComponent<0>(m_vertices[indices[i + 1]]),
+        Renderer::getVertexComponent<0>(m_vertices[indices[i + 2]]));
+    }
+
+    if (m_vertices.size() <= size_t(std::numeric_limits<GLushort>::max()) + 1u)
+    {
+      auto shortIndices = kdl::vec_transform(
+        indices, [](const auto index) { return static_cast<GLushort>(index); });
+      m_indices = Renderer::IndexArray::move(std::move(shortIndices));
+    }
+    else
+    {
+      m_indices = Renderer::IndexArray::move(std::move(indices));
+    }
+  }
+
+  size_t memoryUsage() const override
+  {
+    return EntityModelMesh::memoryUsage() + m_indices.sizeInBytes();
+  }
+
+private:
+  std::unique_ptr<Renderer::TexturedRenderer> doBuildRenderer(
+    const Texture* skin, const Renderer::VertexArray& vertices) override
+  {
+    const auto indexCount = m_indices.indexCount();
+
+    auto size = Renderer::TexturedIndexArrayMap::Size{};
+    size.inc(skin, Renderer::PrimType::Triangles, indexCount);
+
+    auto ranges = Renderer::TexturedIndexArrayMap{size};
+    ranges.add(skin, Renderer::PrimType::Triangles, indexCount);
+
+    return std::make_unique<Renderer::TexturedIndexArrayRenderer>(
+      vertices, m_indices, std::move(ranges));
+  }
+};
+
 // EntityModel::Surface
 
 EntityModelSurface::EntityModelSurface(std::string name, const size_t frameCount)
@@ -434,6 +492,16 @@ void EntityModelSurface::addTexturedMesh(
     frame, std::move(vertices), std::move(indices));
 }
 
+void EntityModelSurface::addElementMesh(
+  EntityModelLoadedFrame& frame,
+  std::vector<EntityModelVertex> vertices,
+  std::vector<uint32_t> indices)
+{
+  assert(frame.index() < frameCount());
+  m_meshes[frame.index()] = std::make_unique<EntityModelElementMesh>(
+    frame, std::move(vertices), std::move(indices));
+}
+
 void EntityModelSurface::setSkins(std::vector<Texture> skins)
 {
   m_skins = std::make_unique<TextureCollection>(std::move(skins));
@@ -459,8 +527,28 @@ const Texture* EntityModelSurface::skin(const size_t index) const
   return m_skins->textureByIndex(index);
 }
 
-std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(
-  const size_t skinIndex, const size_t frameIndex)
+size_t EntityModelSurface::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& mesh : m_meshes)
+  {
+    if (mesh)
+    {
+      result += mesh->memoryUsage();
+    }
+  }
+  for (const auto& skin : m_skins->textures())
+  {
+    // assume four bytes per texel, the size of the mipmaps is ignored
+    result += skin.width() * skin.height() * 4u;
+  }
+  return result;
+}
+
+std::unique_ptr<Renderer::TexturedRenderer> EntityModelSurface::buildRenderer(
+  const size_t skinIndex,
+  const size_t frameIndex,
+  Renderer::VertexBufferPool& vertexBufferPool)
 {
   assert(frameIndex < frameCount());
   assert(skinIndex < skinCount());
@@ -472,7 +560,7 @@ std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildR
   else
   {
     const auto* skin = this->skin(skinIndex);
-    return m_meshes[frameIndex]->buildRenderer(skin);
+    return m_meshes[frameIndex]->buildRenderer(skin, vertexBufferPool);
   }
 }
 
@@ -488,9 +576,11 @@ EntityModel::EntityModel(
 }
 
 std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(
-  const size_t skinIndex, const size_t frameIndex) const
+  const size_t skinIndex,
+  const size_t frameIndex,
+  Renderer::VertexBufferPool& vertexBufferPool) const
 {
-  std::vector<std::unique_ptr<Renderer::TexturedIndexRangeRenderer>> renderers;
+  std::vector<std::unique_ptr<Renderer::TexturedRenderer>> renderers;
   if (frameIndex >= frameCount())
   {
     return nullptr;
@@ -503,7 +593,8 @@ std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(
     // If an out of range skin is requested, use the first skin as a fallback
     const auto correctedSkinIndex =
       actualSkinIndex < surface->skinCount() ? actualSkinIndex : 0;
-    if (auto renderer = surface->buildRenderer(correctedSkinIndex, frameIndex))
+    if (auto renderer = surface->buildRenderer(
+          correctedSkinIndex, frameIndex, vertexBufferPool))
     {
       renderers.push_back(std::move(renderer));
     }
@@ -598,6 +689,16 @@ size_t EntityModel::surfaceCount() const
   return m_surfaces.size();
 }
 
+size_t EntityModel::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& surface : m_surfaces)
+  {
+    result += surface->memoryUsage();
+  }
+  return result;
+}
+
 std::vector<const EntityModelFrame*> EntityModel::frames() const
 {
   return kdl::vec_transform(m_frames, [](const auto& frame) {
@@ -24,20 +24,21 @@
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom
 {
-template <typename T, typename U>
-class octree;
+template <typename T>
+class triangle_bvh;
 
 namespace Renderer
 {
 enum class PrimType;
-class TexturedIndexRangeRenderer;
 class TexturedRenderer;
+class VertexBufferPool;
 } // namespace Renderer
 
 namespace Assets
@@ -162,11 +163,10 @@ private:
   PitchType m_pitchType;
   Orientation m_orientation;
 
-  // For hit testing
-  std::vector<vm::vec3f> m_tris;
-  using TriNum = size_t;
-  using SpacialTree = octree<float, TriNum>;
-  std::unique_ptr<SpacialTree> m_spacialTree;
+  // For hit testing, the triangles are collected when the frame is loaded, and the
+  // hierarchy is built from them when the frame is first intersected
+  mutable std::vector<vm::vec3f> m_tris;
+  mutable std::unique_ptr<triangle_bvh<float>> m_spacialTree;
 
 public:
   /**
@@ -195,7 +195,8 @@ public:
   float intersect(const vm::ray3f& ray) const override;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Adds the given primitives to the spacial tree for this frame. Must not be called
+   * after the frame has been intersected.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -208,6 +209,11 @@ public:
     Renderer::PrimType primType,
     size_t index,
     size_t count);
+
+  /**
+   * Adds the given triangle to the spacial tree for this frame.
+   */
+  void addToSpacialTree(const vm::vec3f& p1, const vm::vec3f& p2, const vm::vec3f& p3);
 };
 
 class EntityModelMesh;
@@ -288,6 +294,19 @@ public:
     std::vector<EntityModelVertex> vertices,
     EntityModelTexturedIndices indices);
 
+  /**
+   * Adds a new mesh that renders the given triangles with shared vertices to this
+   * surface. The indices are stored with 16 bits if there are few enough vertices.
+   *
+   * @param frame the frame which the mesh belongs to
+   * @param vertices the mesh vertices
+   * @param indices the vertex indices, three per triangle
+   */
+  void addElementMesh(
+    EntityModelLoadedFrame& frame,
+    std::vector<EntityModelVertex> vertices,
+    std::vector<uint32_t> indices);
+
   /**
    * Sets the given textures as skins to this surface.
    *
@@ -326,8 +345,14 @@ public:
    */
   const Texture* skin(size_t index) const;
 
-  std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(
-    size_t skinIndex, size_t frameIndex);
+  /**
+   * Returns an estimate of the number of bytes occupied by the meshes and skins of this
+   * surface.
+   */
+  size_t memoryUsage() const;
+
+  std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(
+    size_t skinIndex, size_t frameIndex, Renderer::VertexBufferPool& vertexBufferPool);
 };
 
 /**
@@ -362,10 +387,13 @@ public:
    *
    * @param skinIndex the index of the skin to use
    * @param frameIndex the index of the frame to render
+   * @param vertexBufferPool the pool to allocate the vertices of the renderer from
    * @return the renderer
    */
   std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(
-    size_t skinIndex, size_t frameIndex) const;
+    size_t skinIndex,
+    size_t frameIndex,
+    Renderer::VertexBufferPool& vertexBufferPool) const;
 
   /**
    * Returns the bounds of the given frame of this model.
@@ -438,6 +466,14 @@ public:
    */
   size_t surfaceCount() const;
 
+  /**
+   * Returns an estimate of the number of bytes occupied by the loaded meshes and the skins
+   * of this model.
+   *
+   * @return the estimated memory usage in bytes
+   */
+  size_t memoryUsage() const;
+
   /**
    * Returns all frames of this model.
    *
@@ -27,11 +27,83 @@
 #include "Macros.h"
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/VertexBufferPool.h"
+
+#include <QString>
+
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 namespace TrenchBroom
 {
 namespace Assets
 {
+namespace
+{
+/**
+ * Models that were accessed more recently than this are never evicted. This keeps models
+ * that are only used by the entity browser from being evicted and reloaded repeatedly.
+ */
+constexpr auto MinimumIdleTime = std::chrono::seconds{30};
+
+/**
+ * The minimum time between two attempts to evict models.
+ */
+constexpr auto EvictionInterval = std::chrono::seconds{5};
+
+/**
+ * Collects the messages logged on the background thread so that they can be forwarded to
+ * the actual logger on the main thread.
+ */
+class BufferingLogger : public Logger
+{
+public:
+  std::vector<std::pair<LogLevel, std::string>> messages;
+
+private:
+  void doLog(const LogLevel level, const std::string& message) override
+  {
+    messages.emplace_back(level, message);
+  }
+
+  void doLog(const LogLevel level, const QString& message) override
+  {
+    messages.emplace_back(level, message.toStdString());
+  }
+};
+
+/**
+ * Loads the given frames of a model that was just initialized. Invalid frame indices are
+ * ignored because the frame count of the model is not known when the frames are
+ * requested.
+ */
+void loadFrames(
+  const IO::EntityModelLoader& loader,
+  const std::filesystem::path& path,
+  const std::vector<size_t>& frameIndices,
+  EntityModel& model,
+  Logger& logger)
+{
+  const auto validFrameIndices = kdl::vec_filter(
+    frameIndices, [&](const auto frameIndex) { return frameIndex < model.frameCount(); });
+  if (!validFrameIndices.empty())
+  {
+    try
+    {
+      loader.loadFrames(path, validFrameIndices, model, logger);
+    }
+    catch (const Exception& e)
+    {
+      logger.error() << "Could not load entity model frames of " << path << ": "
+                     << e.what();
+    }
+  }
+}
+} // namespace
+
 EntityModelManager::EntityModelManager(
   const int magFilter, const int minFilter, Logger& logger)
   : m_logger(logger)
@@ -39,6 +111,11 @@ EntityModelManager::EntityModelManager(
   , m_minFilter(minFilter)
   , m_magFilter(magFilter)
   , m_resetTextureMode(false)
+  , m_vertexBufferPool(std::make_unique<Renderer::VertexBufferPool>())
+  , m_asyncLoading(false)
+  , m_memoryBudget(std::numeric_limits<size_t>::max())
+  , m_memoryUsage(0)
+  , m_lastEviction(Clock::now())
 {
 }
 
@@ -49,6 +126,17 @@ EntityModelManager::~EntityModelManager()
 
 void EntityModelManager::clear()
 {
+  if (m_loadTask.valid())
+  {
+    // the loaded models are discarded, but the loader must not be used after this
+    m_loadTask.wait();
+    m_loadTask = {};
+  }
+  m_requestedModels.clear();
+  m_pendingModels.clear();
+  m_requestedFrames.clear();
+  m_memoryUsage = 0;
+
   m_renderers.clear();
   m_models.clear();
   m_rendererMismatches.clear();
@@ -73,6 +161,21 @@ void EntityModelManager::setLoader(const IO::EntityModelLoader* loader)
   m_loader = loader;
 }
 
+void EntityModelManager::setAsyncLoading(const bool asyncLoading)
+{
+  m_asyncLoading = asyncLoading;
+}
+
+void EntityModelManager::setMemoryBudget(const size_t memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+}
+
+size_t EntityModelManager::memoryUsage() const
+{
+  return m_memoryUsage;
+}
+
 Renderer::TexturedRenderer* EntityModelManager::renderer(
   const Assets::ModelSpecification& spec) const
 {
@@ -94,7 +197,8 @@ Renderer::TexturedRenderer* EntityModelManager::renderer(
     return nullptr;
   }
 
-  auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex);
+  auto renderer =
+    entityModel->buildRenderer(spec.skinIndex, spec.frameIndex, *m_vertexBufferPool);
   if (renderer != nullptr)
   {
     const auto [pos, success] = m_renderers.emplace(spec, std::move(renderer));
@@ -121,6 +225,10 @@ const EntityModelFrame* EntityModelManager::frame(
   auto* model = this->safeGetModel(spec.path);
   if (model == nullptr)
   {
+    if (m_pendingModels.count(spec.path) > 0)
+    {
+      m_requestedFrames[spec.path].insert(spec.frameIndex);
+    }
     return nullptr;
   }
   else if (spec.frameIndex >= model->frameCount())
@@ -132,6 +240,7 @@ const EntityModelFrame* EntityModelManager::frame(
     if (!model->frame(spec.frameIndex)->loaded())
     {
       loadFrame(spec, *model);
+      updateMemoryUsage(m_models.at(spec.path));
     }
     return model->frame(spec.frameIndex);
   }
@@ -147,7 +256,8 @@ EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
   auto it = m_models.find(path);
   if (it != std::end(m_models))
   {
-    return it->second.get();
+    it->second.lastAccess = Clock::now();
+    return it->second.model.get();
   }
 
   if (m_modelMismatches.count(path) > 0)
@@ -155,17 +265,16 @@ EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
     return nullptr;
   }
 
-  try
+  if (m_asyncLoading)
   {
-    const auto [pos, success] = m_models.emplace(path, loadModel(path));
-    assert(success);
-    unused(success);
-
-    auto* model = pos->second.get();
-    m_unpreparedModels.push_back(model);
+    requestModel(path);
+    return nullptr;
+  }
 
+  try
+  {
+    auto* model = addModel(path, loadModel(path));
     m_logger.debug() << "Loaded entity model " << path;
-
     return model;
   }
   catch (const GameException& e)
@@ -188,6 +297,20 @@ EntityModel* EntityModelManager::safeGetModel(const std::filesystem::path& path)
   }
 }
 
+EntityModel* EntityModelManager::addModel(
+  const std::filesystem::path& path, std::unique_ptr<EntityModel> model) const
+{
+  const auto [pos, success] =
+    m_models.emplace(path, CachedModel{std::move(model), 0, Clock::now()});
+  assert(success);
+  unused(success);
+
+  auto& cachedModel = pos->second;
+  updateMemoryUsage(cachedModel);
+  m_unpreparedModels.push_back(cachedModel.model.get());
+  return cachedModel.model.get();
+}
+
 std::unique_ptr<EntityModel> EntityModelManager::loadModel(
   const std::filesystem::path& path) const
 {
@@ -195,6 +318,14 @@ std::unique_ptr<EntityModel> EntityModelManager::loadModel(
   return m_loader->initializeModel(path, m_logger);
 }
 
+void EntityModelManager::requestModel(const std::filesystem::path& path) const
+{
+  if (m_pendingModels.insert(path).second)
+  {
+    m_requestedModels.push_back(path);
+  }
+}
+
 void EntityModelManager::loadFrame(
   const Assets::ModelSpecification& spec, Assets::EntityModel& model) const
 {
@@ -210,6 +341,167 @@ void EntityModelManager::loadFrame(
   }
 }
 
+void EntityModelManager::updateMemoryUsage(CachedModel& cachedModel) const
+{
+  const auto memoryUsage = cachedModel.model->memoryUsage();
+  m_memoryUsage = m_memoryUsage - cachedModel.memoryUsage + memoryUsage;
+  cachedModel.memoryUsage = memoryUsage;
+}
+
+bool EntityModelManager::hasPendingModels() const
+{
+  return !m_pendingModels.empty();
+}
+
+std::vector<std::filesystem::path> EntityModelManager::commitLoadedModels()
+{
+  auto result = std::vector<std::filesystem::path>{};
+
+  using namespace std::chrono_literals;
+  if (m_loadTask.valid() && m_loadTask.wait_for(0s) == std::future_status::ready)
+  {
+    for (auto& loadedModel : m_loadTask.get())
+    {
+      for (const auto& [level, message] : loadedModel.messages)
+      {
+        m_logger.log(level, message);
+      }
+
+      m_pendingModels.erase(loadedModel.path);
+      m_requestedFrames.erase(loadedModel.path);
+      if (loadedModel.model)
+      {
+        addModel(loadedModel.path, std::move(loadedModel.model));
+        m_logger.debug() << "Loaded entity model " << loadedModel.path;
+        result.push_back(std::move(loadedModel.path));
+      }
+      else
+      {
+        m_logger.error() << loadedModel.error;
+        m_modelMismatches.insert(std::move(loadedModel.path));
+      }
+    }
+  }
+
+  if (!m_loadTask.valid() && !m_requestedModels.empty())
+  {
+    ensure(m_loader != nullptr, "loader is null");
+
+    auto requests = std::vector<std::pair<std::filesystem::path, std::vector<size_t>>>{};
+    for (auto& path : std::exchange(m_requestedModels, {}))
+    {
+      auto frameIndices = std::vector<size_t>{};
+      if (const auto it = m_requestedFrames.find(path); it != m_requestedFrames.end())
+      {
+        frameIndices = it->second.release_data();
+        m_requestedFrames.erase(it);
+      }
+      requests.emplace_back(std::move(path), std::move(frameIndices));
+    }
+
+    // the models are loaded one after another so that the file system is only accessed by
+    // one background thread, but the requested frames of each model are decoded in
+    // parallel before the model is handed over
+    m_loadTask = std::async(
+      std::launch::async, [loader = m_loader, requests = std::move(requests)]() {
+        auto loadedModels = std::vector<LoadedModel>{};
+        loadedModels.reserve(requests.size());
+
+        for (const auto& [path, frameIndices] : requests)
+        {
+          auto logger = BufferingLogger{};
+          auto loadedModel = LoadedModel{path, nullptr, "", {}};
+          try
+          {
+            loadedModel.model = loader->initializeModel(path, logger);
+          }
+          catch (const Exception& e)
+          {
+            loadedModel.error = e.what();
+          }
+
+          if (loadedModel.model)
+          {
+            loadFrames(*loader, path, frameIndices, *loadedModel.model, logger);
+          }
+
+          loadedModel.messages = std::move(logger.messages);
+          loadedModels.push_back(std::move(loadedModel));
+        }
+
+        return loadedModels;
+      });
+  }
+
+  return result;
+}
+
+bool EntityModelManager::shouldEvictModels() const
+{
+  return m_memoryUsage > m_memoryBudget && Clock::now() - m_lastEviction >= EvictionInterval;
+}
+
+std::vector<std::filesystem::path> EntityModelManager::evictUnusedModels(
+  const std::vector<std::filesystem::path>& usedModels)
+{
+  const auto now = Clock::now();
+  m_lastEviction = now;
+
+  const auto used = kdl::vector_set<std::filesystem::path>(usedModels);
+
+  auto candidates = std::vector<std::pair<Clock::time_point, std::filesystem::path>>{};
+  for (const auto& [path, cachedModel] : m_models)
+  {
+    if (used.count(path) == 0 && now - cachedModel.lastAccess >= MinimumIdleTime)
+    {
+      candidates.emplace_back(cachedModel.lastAccess, path);
+    }
+  }
+
+  // least recently used first
+  std::sort(candidates.begin(), candidates.end());
+
+  auto result = std::vector<std::filesystem::path>{};
+  for (auto& [lastAccess, path] : candidates)
+  {
+    if (m_memoryUsage <= m_memoryBudget)
+    {
+      break;
+    }
+
+    evictModel(path);
+    m_logger.debug() << "Evicted entity model " << path;
+    result.push_back(std::move(path));
+  }
+
+  return result;
+}
+
+void EntityModelManager::evictModel(const std::filesystem::path& path)
+{
+  for (auto it = m_renderers.begin(); it != m_renderers.end();)
+  {
+    if (it->first.path == path)
+    {
+      m_unpreparedRenderers =
+        kdl::vec_erase(std::move(m_unpreparedRenderers), it->second.get());
+      it = m_renderers.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  auto it = m_models.find(path);
+  assert(it != m_models.end());
+
+  m_unpreparedModels =
+    kdl::vec_erase(std::move(m_unpreparedModels), it->second.model.get());
+  m_memoryUsage -= it->second.memoryUsage;
+  m_models.erase(it);
+}
+
 void EntityModelManager::prepare(Renderer::VboManager& vboManager)
 {
   resetTextureMode();
@@ -221,9 +513,9 @@ void EntityModelManager::resetTextureMode()
 {
   if (m_resetTextureMode)
   {
-    for (const auto& [path, model] : m_models)
+    for (const auto& [path, cachedModel] : m_models)
     {
-      model->setTextureMode(m_minFilter, m_magFilter);
+      cachedModel.model->setTextureMode(m_minFilter, m_magFilter);
     }
     m_resetTextureMode = false;
   }
@@ -21,14 +21,19 @@
 
 #include <kdl/vector_set.h>
 
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
 {
 class Logger;
+enum class LogLevel;
 
 namespace IO
 {
@@ -44,6 +49,7 @@ namespace Renderer
 {
 class TexturedRenderer;
 class VboManager;
+class VertexBufferPool;
 } // namespace Renderer
 
 namespace Assets
@@ -53,10 +59,43 @@ class EntityModelFrame;
 struct ModelSpecification;
 enum class Orientation;
 
+/**
+ * Loads entity models on demand and caches them along with their renderers.
+ *
+ * If asynchronous loading is enabled, models are loaded on a background thread. Until a
+ * model is loaded, its frames and renderers are reported as unavailable, so entities fall
+ * back to their definition bounds. The frames that are requested in the meantime are
+ * decoded on the background thread too, so they are ready to use when the model is handed
+ * over by commitLoadedModels().
+ *
+ * The vertices of all renderers are allocated from a shared vertex buffer pool, so that
+ * all models can be rendered without switching vertex buffers.
+ *
+ * The cached models are subject to a memory budget. If the budget is exceeded, models
+ * that are not in use and have not been accessed recently are evicted in least recently
+ * used order by evictUnusedModels().
+ */
 class EntityModelManager
 {
 private:
-  using ModelCache = std::map<std::filesystem::path, std::unique_ptr<EntityModel>>;
+  using Clock = std::chrono::steady_clock;
+
+  struct CachedModel
+  {
+    std::unique_ptr<EntityModel> model;
+    size_t memoryUsage;
+    Clock::time_point lastAccess;
+  };
+
+  struct LoadedModel
+  {
+    std::filesystem::path path;
+    std::unique_ptr<EntityModel> model;
+    std::string error;
+    std::vector<std::pair<LogLevel, std::string>> messages;
+  };
+
+  using ModelCache = std::map<std::filesystem::path, CachedModel>;
   using ModelMismatches = kdl::vector_set<std::filesystem::path>;
   using ModelList = std::vector<EntityModel*>;
 
@@ -72,6 +111,8 @@ private:
   int m_magFilter;
   bool m_resetTextureMode;
 
+  std::unique_ptr<Renderer::VertexBufferPool> m_vertexBufferPool;
+
   mutable ModelCache m_models;
   mutable ModelMismatches m_modelMismatches;
   mutable RendererCache m_renderers;
@@ -80,6 +121,27 @@ private:
   mutable ModelList m_unpreparedModels;
   mutable RendererList m_unpreparedRenderers;
 
+  bool m_asyncLoading;
+  mutable std::vector<std::filesystem::path> m_requestedModels;
+  mutable kdl::vector_set<std::filesystem::path> m_pendingModels;
+
+  /**
+   * The frames that were requested for models that are not loaded yet. They are loaded on
+   * the background thread along with their models.
+   */
+  mutable std::map<std::filesystem::path, kdl::vector_set<size_t>> m_requestedFrames;
+
+  size_t m_memoryBudget;
+  mutable size_t m_memoryUsage;
+  Clock::time_point m_lastEviction;
+
+  /**
+   * The models that are currently being loaded on a background thread. Destroying the
+   * future waits for the thread to finish, and the thread uses the loader, so this must be
+   * cleared before the loader changes.
+   */
+  std::future<std::vector<LoadedModel>> m_loadTask;
+
 public:
   EntityModelManager(int magFilter, int minFilter, Logger& logger);
   ~EntityModelManager();
@@ -88,15 +150,70 @@ public:
 
   void setTextureMode(int minFilter, int magFilter);
   void setLoader(const IO::EntityModelLoader* loader);
+
+  /**
+   * Enables or disables loading models on a background thread. Disabled by default.
+   */
+  void setAsyncLoading(bool asyncLoading);
+
+  /**
+   * Sets the number of bytes that the cached models may occupy before unused models are
+   * evicted.
+   */
+  void setMemoryBudget(size_t memoryBudget);
+
+  /**
+   * Returns an estimate of the number of bytes occupied by the cached models.
+   */
+  size_t memoryUsage() const;
+
   Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
   const EntityModelFrame* frame(const ModelSpecification& spec) const;
 
+  /**
+   * Indicates whether any models are waiting to be loaded or are being loaded.
+   */
+  bool hasPendingModels() const;
+
+  /**
+   * Adds the models that have finished loading on the background thread to the cache and
+   * starts loading the models that were requested since the last call.
+   *
+   * @return the paths of the models that were added to the cache
+   */
+  std::vector<std::filesystem::path> commitLoadedModels();
+
+  /**
+   * Indicates whether the memory budget is exceeded and enough time has passed since the
+   * last eviction to attempt another one.
+   */
+  bool shouldEvictModels() const;
+
+  /**
+   * Evicts cached models and their renderers in least recently used order until the
+   * memory budget is met. Models whose paths are contained in the given list and models
+   * that were accessed recently are never evicted.
+   *
+   * Any renderers or frames of evicted models that were obtained from this manager become
+   * invalid.
+   *
+   * @param usedModels the paths of the models that are in use
+   * @return the paths of the evicted models
+   */
+  std::vector<std::filesystem::path> evictUnusedModels(
+    const std::vector<std::filesystem::path>& usedModels);
+
 private:
   EntityModel* model(const std::filesystem::path& path) const;
   EntityModel* safeGetModel(const std::filesystem::path& path) const;
+  EntityModel* addModel(
+    const std::filesystem::path& path, std::unique_ptr<EntityModel> model) const;
   std::unique_ptr<EntityModel> loadModel(const std::filesystem::path& path) const;
+  void requestModel(const std::filesystem::path& path) const;
   void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+  void updateMemoryUsage(CachedModel& cachedModel) const;
+  void evictModel(const std::filesystem::path& path);
 
 public:
   void prepare(Renderer::VboManager& vboManager);
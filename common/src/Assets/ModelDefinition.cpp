@@ -60,16 +60,19 @@ kdl_reflect_impl(ModelSpecification);
 
 ModelDefinition::ModelDefinition()
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, 0, 0}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(const size_t line, const size_t column)
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, line, column}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(const EL::Expression& expression)
   : m_expression{expression}
+  , m_compiledExpression{m_expression}
 {
 }
 
@@ -81,6 +84,12 @@ void ModelDefinition::append(const ModelDefinition& other)
   auto cases = std::vector<EL::Expression>{std::move(m_expression), other.m_expression};
 
   m_expression = EL::Expression{EL::SwitchExpression{std::move(cases)}, line, column};
+  m_compiledExpression = EL::CompiledExpression{m_expression};
+}
+
+const std::vector<std::string>& ModelDefinition::variableNames() const
+{
+  return m_compiledExpression.variableNames();
 }
 
 static std::filesystem::path path(const EL::Value& value)
@@ -130,7 +139,7 @@ ModelSpecification ModelDefinition::modelSpecification(
   const EL::VariableStore& variableStore) const
 {
   const auto context = EL::EvaluationContext{variableStore};
-  return convertToModel(m_expression.evaluate(context));
+  return convertToModel(m_compiledExpression.evaluate(context));
 }
 
 ModelSpecification ModelDefinition::defaultModelSpecification() const
@@ -194,7 +203,7 @@ vm::vec3 ModelDefinition::scale(
   const std::optional<EL::Expression>& defaultScaleExpression) const
 {
   const auto context = EL::EvaluationContext{variableStore};
-  const auto value = m_expression.evaluate(context);
+  const auto value = m_compiledExpression.evaluate(context);
 
   switch (value.type())
   {
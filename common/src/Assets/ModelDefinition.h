@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "EL/CompiledExpression.h"
 #include "EL/Expression.h"
 #include "FloatType.h"
 
@@ -29,6 +30,8 @@
 #include <filesystem>
 #include <iosfwd>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -60,6 +63,7 @@ class ModelDefinition
 {
 private:
   EL::Expression m_expression;
+  EL::CompiledExpression m_compiledExpression;
 
 public:
   ModelDefinition();
@@ -68,6 +72,12 @@ public:
 
   void append(const ModelDefinition& other);
 
+  /**
+   * Returns the names of the variables that the model expression may read. The model
+   * specification does not depend on any other variables.
+   */
+  const std::vector<std::string>& variableNames() const;
+
   /**
    * Evaluates the model expresion, using the given variable store to interpolate
    * variables.
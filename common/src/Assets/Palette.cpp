@@ -32,6 +32,9 @@
 #include <kdl/result.h>
 #include <kdl/string_format.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -71,26 +74,45 @@ bool Palette::indexedToRgba(
 {
   ensure(rgbaImage.size() == 4 * pixelCount, "incorrect destination buffer size");
 
-  const unsigned char* paletteData = (transparency == PaletteTransparency::Opaque)
-                                       ? m_data->opaqueData.data()
-                                       : m_data->index255TransparentData.data();
+  const auto& paletteData = (transparency == PaletteTransparency::Opaque)
+                              ? m_data->opaqueData
+                              : m_data->index255TransparentData;
 
-  // Write rgba pixels
+  // pad the palette to 256 colors so that any index can be looked up
+  auto colors = std::array<unsigned char, 256 * 4>{};
+  std::memcpy(
+    colors.data(), paletteData.data(), std::min(paletteData.size(), colors.size()));
+
+  // Read all indices at once into the last quarter of the destination buffer and expand
+  // them front to back. Pixel i is written to bytes [4i, 4i + 4), which never overlap the
+  // indices of the pixels after it, so no temporary buffer is needed.
   auto* const rgbaData = rgbaImage.data();
+  auto* const indices = rgbaData + 3 * pixelCount;
+  reader.read(indices, pixelCount);
+
+  // Write rgba pixels and count how often each color is used, which is enough to compute
+  // the average color and check for transparency without another pass over the pixels
+  auto counts = std::array<size_t, 256>{};
   for (size_t i = 0; i < pixelCount; ++i)
   {
-    const int index = reader.readInt<unsigned char>();
-
-    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+    const auto index = indices[i];
+    std::memcpy(rgbaData + (i * 4), &colors[size_t(index) * 4], 4);
+    ++counts[index];
   }
 
-  // Check average color
-  uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
+  // Check average color and transparency
+  uint64_t colorSum[3] = {0, 0, 0};
+  auto hasTransparency = false;
+  for (size_t index = 0; index < counts.size(); ++index)
   {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+    if (counts[index] > 0)
+    {
+      const auto* color = &colors[index * 4];
+      colorSum[0] += uint64_t(color[0]) * counts[index];
+      colorSum[1] += uint64_t(color[1]) * counts[index];
+      colorSum[2] += uint64_t(color[2]) * counts[index];
+      hasTransparency = hasTransparency || color[3] != 0xFF;
+    }
   }
   averageColor = Color{
     float(colorSum[0]) / (255.0f * float(pixelCount)),
@@ -98,18 +120,9 @@ bool Palette::indexedToRgba(
     float(colorSum[2]) / (255.0f * float(pixelCount)),
     1.0f};
 
-  // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
+  // only images with a transparent index can contain transparency
+  hasTransparency =
+    hasTransparency && transparency == PaletteTransparency::Index255Transparent;
 
   return hasTransparency;
 }
@@ -21,6 +21,7 @@
 
 #include "Assets/TextureBuffer.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureCompression.h"
 #include "Macros.h"
 #include "Renderer/GL.h"
 
@@ -31,6 +32,7 @@
 
 #include <algorithm> // for std::max
 #include <cassert>
+#include <iterator>
 #include <ostream>
 
 namespace TrenchBroom::Assets
@@ -129,6 +131,9 @@ Texture::Texture(
   , m_culling{TextureCulling::Default}
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId{0}
+  , m_compressionSavings{0}
+  , m_uploadRequested{false}
+  , m_uploadPending{false}
   , m_gameData{std::move(gameData)}
 {
   assert(m_width > 0);
@@ -158,6 +163,9 @@ Texture::Texture(
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId(0)
   , m_buffers{std::move(buffers)}
+  , m_compressionSavings{0}
+  , m_uploadRequested{false}
+  , m_uploadPending{false}
   , m_gameData{std::move(gameData)}
 {
   assert(m_width > 0);
@@ -198,6 +206,9 @@ Texture::Texture(
   , m_culling{TextureCulling::Default}
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId{0}
+  , m_compressionSavings{0}
+  , m_uploadRequested{false}
+  , m_uploadPending{false}
   , m_gameData{std::move(gameData)}
 {
 }
@@ -219,7 +230,12 @@ Texture::Texture(Texture&& other)
   , m_culling{std::move(other.m_culling)}
   , m_blendFunc{std::move(other.m_blendFunc)}
   , m_textureId{std::move(other.m_textureId)}
+  , m_textureArrayLayer{std::move(other.m_textureArrayLayer)}
   , m_buffers{std::move(other.m_buffers)}
+  , m_compressionSavings{other.m_compressionSavings}
+  , m_uploadRequested{other.m_uploadRequested}
+  , m_uploadPending{other.m_uploadPending}
+  , m_lastActivated{other.m_lastActivated}
   , m_gameData{std::move(other.m_gameData)}
 {
 }
@@ -240,7 +256,12 @@ Texture& Texture::operator=(Texture&& other)
   m_culling = std::move(other.m_culling);
   m_blendFunc = std::move(other.m_blendFunc);
   m_textureId = std::move(other.m_textureId);
+  m_textureArrayLayer = std::move(other.m_textureArrayLayer);
   m_buffers = std::move(other.m_buffers);
+  m_compressionSavings = other.m_compressionSavings;
+  m_uploadRequested = other.m_uploadRequested;
+  m_uploadPending = other.m_uploadPending;
+  m_lastActivated = other.m_lastActivated;
   m_gameData = std::move(other.m_gameData);
   return *this;
 }
@@ -364,26 +385,95 @@ void Texture::setOverridden(const bool overridden)
   m_overridden = overridden;
 }
 
+bool Texture::compress()
+{
+  assert(m_textureId == 0);
+
+  if (m_buffers.empty() || !canCompressTexture(m_format, m_width, m_height))
+  {
+    return false;
+  }
+
+  auto compressed = compressTextureBuffers(
+    m_buffers, m_width, m_height, m_format, m_type == TextureType::Masked);
+
+  auto compressedSize = size_t(0);
+  for (const auto& buffer : compressed.buffers)
+  {
+    compressedSize += buffer.size();
+  }
+
+  m_buffers = std::move(compressed.buffers);
+  m_format = compressed.format;
+  m_compressionSavings = compressed.uncompressedSize - compressedSize;
+  return true;
+}
+
+bool Texture::compressed() const
+{
+  return isCompressedFormat(m_format);
+}
+
+size_t Texture::compressionSavings() const
+{
+  return m_compressionSavings;
+}
+
+size_t Texture::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& buffer : m_buffers)
+  {
+    result += buffer.size();
+  }
+  return result;
+}
+
+bool Texture::discardMipmaps()
+{
+  assert(m_textureId == 0);
+
+  if (m_buffers.size() <= 1 || isCompressedFormat(m_format))
+  {
+    return false;
+  }
+
+  m_buffers.erase(std::next(m_buffers.begin()), m_buffers.end());
+  return true;
+}
+
 bool Texture::isPrepared() const
 {
   return m_textureId != 0;
 }
 
+static void setUnpackState()
+{
+  glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+  glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+  glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+}
+
 void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter)
 {
   assert(textureId > 0);
   assert(m_textureId == 0);
 
+  upload(textureId, minFilter, magFilter);
+  finishUpload(textureId);
+}
+
+void Texture::upload(
+  const GLuint textureId, const int minFilter, const int magFilter) const
+{
   if (!m_buffers.empty())
   {
     const auto compressed = isCompressedFormat(m_format);
 
-    glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-    glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-    glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-    glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-    glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-    glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    setUnpackState();
 
     glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
@@ -446,10 +536,90 @@ void Texture::prepare(const GLuint textureId, const int minFilter, const int mag
           data));
       }
     }
+  }
+}
 
-    m_buffers.clear();
+void Texture::beginUpload()
+{
+  assert(m_textureId == 0);
+  m_uploadPending = true;
+  m_uploadRequested = false;
+}
+
+void Texture::finishUpload(const GLuint textureId)
+{
+  if (!m_buffers.empty())
+  {
     m_textureId = textureId;
   }
+  m_uploadPending = false;
+  m_uploadRequested = false;
+}
+
+bool Texture::uploadPending() const
+{
+  return m_uploadPending;
+}
+
+void Texture::unprepare()
+{
+  m_textureId = 0;
+  m_textureArrayLayer = std::nullopt;
+}
+
+bool Texture::uploadRequested() const
+{
+  return m_uploadRequested;
+}
+
+std::chrono::steady_clock::time_point Texture::lastActivated() const
+{
+  return m_lastActivated;
+}
+
+void Texture::prepareLayer(const GLuint textureArrayId, const size_t layer)
+{
+  assert(textureArrayId > 0);
+  assert(m_textureId == 0);
+  assert(!isCompressedFormat(m_format));
+
+  if (!m_buffers.empty())
+  {
+    setUnpackState();
+
+    glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrayId));
+
+    // Upload only the first mipmap for masked textures.
+    const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+
+    for (size_t j = 0; j < mipmapsToUpload; ++j)
+    {
+      const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+
+      const auto* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+      glAssert(glTexSubImage3D(
+        GL_TEXTURE_2D_ARRAY,
+        static_cast<GLint>(j),
+        0,
+        0,
+        static_cast<GLint>(layer),
+        static_cast<GLsizei>(mipSize.x()),
+        static_cast<GLsizei>(mipSize.y()),
+        1,
+        m_format,
+        GL_UNSIGNED_BYTE,
+        data));
+    }
+
+    m_textureId = textureArrayId;
+    m_textureArrayLayer = layer;
+  }
+  m_uploadRequested = false;
+}
+
+std::optional<size_t> Texture::textureArrayLayer() const
+{
+  return m_textureArrayLayer;
 }
 
 void Texture::setMode(const int minFilter, const int magFilter)
@@ -460,13 +630,13 @@ void Texture::setMode(const int minFilter, const int magFilter)
     if (m_type == TextureType::Masked)
     {
       // Force GL_NEAREST filtering for masked textures.
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+      glAssert(glTexParameteri(textureTarget(), GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+      glAssert(glTexParameteri(textureTarget(), GL_TEXTURE_MAG_FILTER, GL_NEAREST));
     }
     else
     {
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+      glAssert(glTexParameteri(textureTarget(), GL_TEXTURE_MIN_FILTER, minFilter));
+      glAssert(glTexParameteri(textureTarget(), GL_TEXTURE_MAG_FILTER, magFilter));
     }
     deactivate();
   }
@@ -474,9 +644,15 @@ void Texture::setMode(const int minFilter, const int magFilter)
 
 void Texture::activate() const
 {
-  if (isPrepared())
+  m_lastActivated = std::chrono::steady_clock::now();
+  if (!isPrepared())
   {
-    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    // the texture manager uploads the texture on its next commit
+    m_uploadRequested = !m_buffers.empty() && !m_uploadPending;
+  }
+  else
+  {
+    glAssert(glBindTexture(textureTarget(), m_textureId));
 
     switch (m_culling)
     {
@@ -535,7 +711,7 @@ void Texture::deactivate() const
       break;
     }
 
-    glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+    glAssert(glBindTexture(textureTarget(), 0));
   }
 }
 
@@ -554,4 +730,9 @@ TextureType Texture::type() const
   return m_type;
 }
 
+GLenum Texture::textureTarget() const
+{
+  return m_textureArrayLayer ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+}
+
 } // namespace TrenchBroom::Assets
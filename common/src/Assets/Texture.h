@@ -28,7 +28,9 @@
 #include <vecmath/forward.h>
 
 #include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <string>
 #include <variant>
@@ -132,7 +134,13 @@ private:
   TextureBlendFunc m_blendFunc;
 
   mutable GLuint m_textureId;
+  mutable std::optional<size_t> m_textureArrayLayer;
   mutable BufferList m_buffers;
+  size_t m_compressionSavings;
+
+  mutable bool m_uploadRequested;
+  bool m_uploadPending;
+  mutable std::chrono::steady_clock::time_point m_lastActivated;
 
   GameData m_gameData;
 
@@ -228,8 +236,98 @@ public:
   bool overridden() const;
   void setOverridden(bool overridden);
 
+  /**
+   * Transcodes this texture to an S3TC compressed format if it is large enough and has an
+   * uncompressed RGBA or BGRA format. Must be called before the texture is prepared.
+   *
+   * @return true if the texture was compressed
+   */
+  bool compress();
+
+  bool compressed() const;
+
+  /**
+   * Returns the number of bytes of GPU memory saved by compressing this texture, or 0 if
+   * it was not compressed by compress().
+   */
+  size_t compressionSavings() const;
+
+  /**
+   * Returns the number of bytes of main memory occupied by the data of this texture. The
+   * data is kept after the texture is prepared so that it can be uploaded again.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Discards every mip level but the first of an uncompressed texture, so that the
+   * remaining levels are generated by the driver when the texture is prepared. Must be
+   * called before the texture is prepared.
+   *
+   * @return true if any mip levels were discarded
+   */
+  bool discardMipmaps();
+
   bool isPrepared() const;
   void prepare(GLuint textureId, int minFilter, int magFilter);
+
+  /**
+   * Uploads the data of this texture to the given GL texture without marking this
+   * texture as prepared. This only reads data that does not change while an upload is
+   * pending, so it can be called on a background thread whose GL context shares its
+   * objects with the render contexts.
+   *
+   * @see beginUpload()
+   * @see finishUpload()
+   */
+  void upload(GLuint textureId, int minFilter, int magFilter) const;
+
+  /**
+   * Marks this texture as being uploaded by upload() on a background thread. Activating
+   * the texture does not request another upload until finishUpload() is called.
+   */
+  void beginUpload();
+
+  /**
+   * Marks this texture as prepared with the given GL texture, which must have been
+   * defined by upload().
+   */
+  void finishUpload(GLuint textureId);
+
+  /**
+   * Indicates whether beginUpload() was called, but finishUpload() was not called yet.
+   */
+  bool uploadPending() const;
+
+  /**
+   * Forgets the GL texture that this texture was uploaded to, so that it can be uploaded
+   * again by prepare(). The caller is responsible for deleting the GL texture.
+   */
+  void unprepare();
+
+  /**
+   * Indicates whether this texture was activated while it was not uploaded. Such
+   * textures are rendered using their average color until they are prepared.
+   */
+  bool uploadRequested() const;
+
+  /**
+   * Returns the time at which this texture was last activated.
+   */
+  std::chrono::steady_clock::time_point lastActivated() const;
+
+  /**
+   * Uploads this texture into the given layer of the given 2D texture array, whose
+   * storage must already be allocated to match this texture's size, format and mipmap
+   * levels. Afterwards, activate() binds the texture array, and shaders must sample the
+   * layer returned by textureArrayLayer().
+   */
+  void prepareLayer(GLuint textureArrayId, size_t layer);
+
+  /**
+   * Returns the layer of the texture array that this texture was uploaded to, if any.
+   */
+  std::optional<size_t> textureArrayLayer() const;
+
   void setMode(int minFilter, int magFilter);
 
   void activate() const;
@@ -238,7 +336,8 @@ public:
 public: // exposed for tests only
   /**
    * Returns the texture data in the format returned by format().
-   * Once prepare() is called, this will be an empty vector.
+   * The data is kept after prepare() is called so that the texture can be uploaded
+   * again after it was unprepared.
    */
   const BufferList& buffersIfUnprepared() const;
   /**
@@ -246,6 +345,9 @@ public: // exposed for tests only
    */
   GLenum format() const;
   TextureType type() const;
+
+private:
+  GLenum textureTarget() const;
 };
 
 } // namespace TrenchBroom::Assets
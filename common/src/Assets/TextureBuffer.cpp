@@ -25,11 +25,97 @@
 
 #include <FreeImage.h>
 #include <algorithm> // for std::max
+#include <mutex>
+#include <unordered_map>
 
 namespace TrenchBroom
 {
 namespace Assets
 {
+namespace
+{
+constexpr auto MaxPooledMemory = size_t(64) * 1024 * 1024;
+
+/**
+ * Rounds the given size up to a multiple of a quarter of the next smaller power of two,
+ * so that blocks can be reused for buffers of similar size while wasting less than a
+ * quarter of their capacity. Power of two sizes are not rounded.
+ */
+size_t blockCapacity(const size_t size)
+{
+  if (size <= 16)
+  {
+    return 16;
+  }
+
+  auto power = size_t(1);
+  while (power * 2 < size)
+  {
+    power *= 2;
+  }
+  const auto step = power / 4;
+  return (size + step - 1) / step * step;
+}
+
+class BlockPool
+{
+private:
+  using Block = std::unique_ptr<unsigned char[]>;
+
+  std::mutex m_mutex;
+  std::unordered_map<size_t, std::vector<Block>> m_blocks;
+  size_t m_memory{0};
+
+public:
+  Block acquire(const size_t capacity)
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (auto it = m_blocks.find(capacity); it != m_blocks.end() && !it->second.empty())
+      {
+        auto block = std::move(it->second.back());
+        it->second.pop_back();
+        m_memory -= capacity;
+        return block;
+      }
+    }
+
+    // allocated default-initialized (i.e., uninitialized) on purpose
+    return Block{new unsigned char[capacity]};
+  }
+
+  void release(Block block, const size_t capacity)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    if (m_memory + capacity <= MaxPooledMemory)
+    {
+      m_blocks[capacity].push_back(std::move(block));
+      m_memory += capacity;
+    }
+  }
+
+  size_t memory()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_memory;
+  }
+
+  void clear()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_blocks.clear();
+    m_memory = 0;
+  }
+};
+
+BlockPool& blockPool()
+{
+  // never destroyed so that buffers in static objects can be released at exit
+  static auto* pool = new BlockPool{};
+  return *pool;
+}
+} // namespace
+
 TextureBuffer::TextureBuffer()
   : m_buffer()
   , m_size(0)
@@ -40,11 +126,41 @@ TextureBuffer::TextureBuffer()
  * Note, buffer is created defult-initialized (i.e., uninitialized) on purpose.
  */
 TextureBuffer::TextureBuffer(const size_t size)
-  : m_buffer(new unsigned char[size])
+  : m_buffer(size > 0 ? blockPool().acquire(blockCapacity(size)) : nullptr)
   , m_size(size)
 {
 }
 
+TextureBuffer::TextureBuffer(TextureBuffer&& other) noexcept
+  : m_buffer(std::move(other.m_buffer))
+  , m_size(other.m_size)
+{
+  other.m_size = 0;
+}
+
+TextureBuffer& TextureBuffer::operator=(TextureBuffer&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (m_buffer)
+    {
+      blockPool().release(std::move(m_buffer), blockCapacity(m_size));
+    }
+    m_buffer = std::move(other.m_buffer);
+    m_size = other.m_size;
+    other.m_size = 0;
+  }
+  return *this;
+}
+
+TextureBuffer::~TextureBuffer()
+{
+  if (m_buffer)
+  {
+    blockPool().release(std::move(m_buffer), blockCapacity(m_size));
+  }
+}
+
 const unsigned char* TextureBuffer::data() const
 {
   return m_buffer.get();
@@ -129,6 +245,16 @@ void setMipBufferSize(
   }
 }
 
+size_t pooledTextureBufferMemory()
+{
+  return blockPool().memory();
+}
+
+void clearTextureBufferPool()
+{
+  blockPool().clear();
+}
+
 void resizeMips(
   TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize)
 {
@@ -30,6 +30,12 @@ namespace TrenchBroom
 {
 namespace Assets
 {
+/**
+ * Texture buffers draw their memory from a process wide pool, and return it to the pool
+ * when they are destroyed. Loading textures allocates and discards many buffers of the
+ * same few sizes, e.g. when textures are compressed or collections are reloaded, so this
+ * avoids most allocations. The pool only retains a bounded amount of memory.
+ */
 class TextureBuffer
 {
 private:
@@ -40,6 +46,14 @@ public:
   explicit TextureBuffer();
   explicit TextureBuffer(size_t size);
 
+  TextureBuffer(const TextureBuffer&) = delete;
+  TextureBuffer& operator=(const TextureBuffer&) = delete;
+
+  TextureBuffer(TextureBuffer&& other) noexcept;
+  TextureBuffer& operator=(TextureBuffer&& other) noexcept;
+
+  ~TextureBuffer();
+
   const unsigned char* data() const;
   unsigned char* data();
 
@@ -47,6 +61,16 @@ public:
 };
 using TextureBufferList = std::vector<TextureBuffer>;
 
+/**
+ * Returns the number of bytes currently held by the texture buffer pool.
+ */
+size_t pooledTextureBufferMemory();
+
+/**
+ * Frees all memory held by the texture buffer pool.
+ */
+void clearTextureBufferPool();
+
 vm::vec2s sizeAtMipLevel(size_t width, size_t height, size_t level);
 bool isCompressedFormat(GLenum format);
 size_t blockSizeForFormat(GLenum format);
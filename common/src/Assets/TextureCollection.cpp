@@ -19,17 +19,100 @@
 
 #include "TextureCollection.h"
 
+#include "Assets/TextureBuffer.h"
 #include "Ensure.h"
+#include "Renderer/BackgroundUploader.h"
 
 #include <kdl/reflection_impl.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <cassert>
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom::Assets
 {
 
+namespace
+{
+
+size_t textureArrayMipmapCount(const Texture& texture)
+{
+  // masked textures only upload their first mipmap
+  return texture.type() == TextureType::Masked ? 1u
+                                               : texture.buffersIfUnprepared().size();
+}
+
+// textures with less data are uploaded quickly enough on the render thread
+constexpr size_t MinBackgroundUploadSize = 1024u * 1024u;
+
+bool needsUpload(const Texture& texture)
+{
+  return !texture.isPrepared() && !texture.uploadPending()
+         && !texture.buffersIfUnprepared().empty();
+}
+
+size_t dataSize(const Texture& texture)
+{
+  auto size = size_t(0);
+  for (const auto& buffer : texture.buffersIfUnprepared())
+  {
+    size += buffer.size();
+  }
+  return size;
+}
+
+bool canUseTextureArray(const Texture& texture)
+{
+  const auto& buffers = texture.buffersIfUnprepared();
+  // single buffer textures rely on GL_GENERATE_MIPMAP, which only applies to 2D textures
+  return !buffers.empty() && !isCompressedFormat(texture.format())
+         && (buffers.size() > 1u || texture.type() == TextureType::Masked);
+}
+
+} // namespace
+
+std::vector<std::vector<size_t>> findTextureArrayGroups(
+  const std::vector<Texture>& textures)
+{
+  using Key = std::tuple<size_t, size_t, GLenum, TextureType, size_t>;
+
+  auto groupsByKey = std::map<Key, std::vector<size_t>>{};
+  for (size_t i = 0; i < textures.size(); ++i)
+  {
+    const auto& texture = textures[i];
+    if (canUseTextureArray(texture))
+    {
+      const auto key = Key{
+        texture.width(),
+        texture.height(),
+        texture.format(),
+        texture.type(),
+        textureArrayMipmapCount(texture)};
+      groupsByKey[key].push_back(i);
+    }
+  }
+
+  auto result = std::vector<std::vector<size_t>>{};
+  for (const auto& [key, indices] : groupsByKey)
+  {
+    for (size_t first = 0; first < indices.size(); first += MaxTextureArrayLayers)
+    {
+      const auto last = std::min(indices.size(), first + MaxTextureArrayLayers);
+      if (last - first > 1u)
+      {
+        result.emplace_back(
+          indices.begin() + static_cast<std::ptrdiff_t>(first),
+          indices.begin() + static_cast<std::ptrdiff_t>(last));
+      }
+    }
+  }
+  return result;
+}
+
 kdl_reflect_impl(TextureCollection);
 
 TextureCollection::TextureCollection() = default;
@@ -61,6 +144,13 @@ TextureCollection::~TextureCollection()
       static_cast<GLuint*>(&m_textureIds.front())));
     m_textureIds.clear();
   }
+  if (!m_textureArrayIds.empty())
+  {
+    glAssert(glDeleteTextures(
+      static_cast<GLsizei>(m_textureArrayIds.size()),
+      static_cast<GLuint*>(&m_textureArrayIds.front())));
+    m_textureArrayIds.clear();
+  }
 }
 
 bool TextureCollection::loaded() const
@@ -83,6 +173,16 @@ size_t TextureCollection::textureCount() const
   return m_textures.size();
 }
 
+size_t TextureCollection::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& texture : m_textures)
+  {
+    result += texture.memoryUsage();
+  }
+  return result;
+}
+
 const std::vector<Texture>& TextureCollection::textures() const
 {
   return m_textures;
@@ -119,27 +219,221 @@ Texture* TextureCollection::textureByName(const std::string& name)
     const_cast<const TextureCollection*>(this)->textureByName(name));
 }
 
+bool TextureCollection::useTextureArrays() const
+{
+  return m_useTextureArrays;
+}
+
+void TextureCollection::setUseTextureArrays(const bool useTextureArrays)
+{
+  assert(m_textureIds.empty());
+  m_useTextureArrays = useTextureArrays;
+}
+
 bool TextureCollection::prepared() const
 {
-  return !m_textureIds.empty();
+  return std::none_of(m_textures.begin(), m_textures.end(), needsUpload);
+}
+
+bool TextureCollection::hasRequestedTextures() const
+{
+  return std::any_of(m_textures.begin(), m_textures.end(), [](const auto& texture) {
+    return texture.uploadRequested();
+  });
 }
 
 void TextureCollection::prepare(const int minFilter, const int magFilter)
 {
-  assert(!prepared());
+  prepare(minFilter, magFilter, textureCount());
+}
 
-  m_textureIds.resize(textureCount());
-  if (textureCount() != 0u)
+size_t TextureCollection::prepare(
+  const int minFilter, const int magFilter, const size_t maxTextureCount)
+{
+  auto count = size_t(0);
+  for (size_t i = 0; i < textureCount() && count < maxTextureCount; ++i)
   {
-    glAssert(glGenTextures(
-      static_cast<GLsizei>(textureCount()), static_cast<GLuint*>(&m_textureIds.front())));
+    if (needsUpload(m_textures[i]))
+    {
+      prepareTexture(i, minFilter, magFilter);
+      ++count;
+    }
+  }
+  return count;
+}
+
+size_t TextureCollection::prepareRequested(
+  const int minFilter,
+  const int magFilter,
+  const size_t maxTextureCount,
+  Renderer::BackgroundUploader* backgroundUploader)
+{
+  auto count = size_t(0);
+  for (size_t i = 0; i < textureCount() && count < maxTextureCount; ++i)
+  {
+    if (m_textures[i].uploadRequested())
+    {
+      createTextureIds(minFilter, magFilter);
+      if (
+        backgroundUploader && !isTextureArrayLayer(i)
+        && dataSize(m_textures[i]) >= MinBackgroundUploadSize)
+      {
+        prepareTextureInBackground(i, minFilter, magFilter, *backgroundUploader);
+      }
+      else
+      {
+        prepareTexture(i, minFilter, magFilter);
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+size_t TextureCollection::releaseUnused(
+  const std::chrono::steady_clock::time_point activatedBefore)
+{
+  auto count = size_t(0);
+  for (size_t i = 0; i < m_textureIds.size(); ++i)
+  {
+    auto& texture = m_textures[i];
+    if (
+      m_textureIds[i] != 0 && texture.isPrepared() && texture.usageCount() == 0u
+      && texture.lastActivated() < activatedBefore)
+    {
+      glAssert(glDeleteTextures(1, &m_textureIds[i]));
+      m_textureIds[i] = 0;
+      texture.unprepare();
+      ++count;
+    }
+  }
+  return count;
+}
+
+void TextureCollection::createTextureIds(const int minFilter, const int magFilter)
+{
+  if (m_textureIds.empty())
+  {
+    // texture names are generated when a texture is uploaded so that the storage of
+    // unused textures can be released individually
+    m_textureIds.resize(textureCount(), 0);
+
+    if (m_useTextureArrays)
+    {
+      createTextureArrays(minFilter, magFilter);
+    }
+  }
+}
+
+bool TextureCollection::isTextureArrayLayer(const size_t index) const
+{
+  return index < m_textureArrayLayers.size() && m_textureArrayLayers[index];
+}
+
+void TextureCollection::prepareTexture(
+  const size_t index, const int minFilter, const int magFilter)
+{
+  createTextureIds(minFilter, magFilter);
+
+  auto& texture = m_textures[index];
+  if (isTextureArrayLayer(index))
+  {
+    const auto& [arrayIndex, layer] = *m_textureArrayLayers[index];
+    texture.prepareLayer(m_textureArrayIds[arrayIndex], layer);
+  }
+  else
+  {
+    if (m_textureIds[index] == 0)
+    {
+      glAssert(glGenTextures(1, &m_textureIds[index]));
+    }
+    texture.prepare(m_textureIds[index], minFilter, magFilter);
+  }
+}
+
+void TextureCollection::prepareTextureInBackground(
+  const size_t index,
+  const int minFilter,
+  const int magFilter,
+  Renderer::BackgroundUploader& backgroundUploader)
+{
+  assert(!isTextureArrayLayer(index));
+
+  if (m_textureIds[index] == 0)
+  {
+    glAssert(glGenTextures(1, &m_textureIds[index]));
+  }
+
+  // moving this collection does not move its textures, and the texture manager waits for
+  // pending uploads before it destroys a collection
+  auto& texture = m_textures[index];
+  const auto textureId = m_textureIds[index];
+  texture.beginUpload();
+  backgroundUploader.enqueue(
+    [&texture, textureId, minFilter, magFilter]() {
+      texture.upload(textureId, minFilter, magFilter);
+    },
+    [&texture, textureId]() { texture.finishUpload(textureId); });
+}
+
+void TextureCollection::createTextureArrays(const int minFilter, const int magFilter)
+{
+  const auto groups = findTextureArrayGroups(m_textures);
+  if (groups.empty())
+  {
+    return;
+  }
+
+  m_textureArrayIds.resize(groups.size());
+  glAssert(glGenTextures(
+    static_cast<GLsizei>(groups.size()),
+    static_cast<GLuint*>(&m_textureArrayIds.front())));
+  m_textureArrayLayers.resize(textureCount());
+
+  for (size_t i = 0; i < groups.size(); ++i)
+  {
+    const auto& indices = groups[i];
+    const auto& prototype = m_textures[indices.front()];
+    const auto mipmapCount = textureArrayMipmapCount(prototype);
+
+    glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureArrayIds[i]));
+    if (prototype.type() == TextureType::Masked)
+    {
+      glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+      glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    }
+    else
+    {
+      glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+      glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter));
+    }
+    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT));
+    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT));
+    glAssert(glTexParameteri(
+      GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipmapCount - 1u)));
+
+    for (size_t j = 0; j < mipmapCount; ++j)
+    {
+      const auto mipSize = sizeAtMipLevel(prototype.width(), prototype.height(), j);
+      glAssert(glTexImage3D(
+        GL_TEXTURE_2D_ARRAY,
+        static_cast<GLint>(j),
+        GL_RGBA,
+        static_cast<GLsizei>(mipSize.x()),
+        static_cast<GLsizei>(mipSize.y()),
+        static_cast<GLsizei>(indices.size()),
+        0,
+        prototype.format(),
+        GL_UNSIGNED_BYTE,
+        nullptr));
+    }
 
-    for (size_t i = 0; i < textureCount(); ++i)
+    for (size_t layer = 0; layer < indices.size(); ++layer)
     {
-      auto& texture = m_textures[i];
-      texture.prepare(m_textureIds[i], minFilter, magFilter);
+      m_textureArrayLayers[indices[layer]] = TextureArrayLayer{i, layer};
     }
   }
+  glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
 }
 
 void TextureCollection::setTextureMode(const int minFilter, const int magFilter)
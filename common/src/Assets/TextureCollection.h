@@ -24,24 +24,58 @@
 
 #include <kdl/reflection_decl.h>
 
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
+namespace TrenchBroom::Renderer
+{
+class BackgroundUploader;
+}
+
 namespace TrenchBroom::Assets
 {
 
+/**
+ * The maximum number of textures that are packed into a single texture array. OpenGL 3
+ * guarantees support for at least 256 layers.
+ */
+constexpr size_t MaxTextureArrayLayers = 256;
+
+/**
+ * Groups the given textures into sets that can share a 2D texture array. Textures in the
+ * same group have identical size, format, type and number of mipmap levels. Compressed
+ * textures and textures that rely on mipmap generation are never grouped, and neither
+ * are groups of less than two textures. No group exceeds MaxTextureArrayLayers.
+ *
+ * @return the groups as lists of indices into the given vector
+ */
+std::vector<std::vector<size_t>> findTextureArrayGroups(
+  const std::vector<Texture>& textures);
+
 class TextureCollection
 {
 private:
   using TextureIdList = std::vector<GLuint>;
 
+  struct TextureArrayLayer
+  {
+    size_t arrayIndex;
+    size_t layer;
+  };
+
   std::filesystem::path m_path;
   std::vector<Texture> m_textures;
 
   bool m_loaded{false};
   TextureIdList m_textureIds;
 
+  bool m_useTextureArrays{false};
+  TextureIdList m_textureArrayIds;
+  std::vector<std::optional<TextureArrayLayer>> m_textureArrayLayers;
+
   friend class Texture;
 
   kdl_reflect_decl(TextureCollection, m_loaded, m_path, m_textures);
@@ -65,6 +99,12 @@ public:
   std::string name() const;
   size_t textureCount() const;
 
+  /**
+   * Returns the number of bytes of main memory occupied by the data of the textures in
+   * this collection, see Texture::memoryUsage().
+   */
+  size_t memoryUsage() const;
+
   const std::vector<Texture>& textures() const;
   std::vector<Texture>& textures();
 
@@ -74,9 +114,84 @@ public:
   const Texture* textureByName(const std::string& name) const;
   Texture* textureByName(const std::string& name);
 
+  /**
+   * Indicates whether textures are packed into 2D texture arrays when they are uploaded.
+   */
+  bool useTextureArrays() const;
+
+  /**
+   * Sets whether textures of equal size and format are packed into 2D texture arrays
+   * when they are uploaded. Packed textures are bound as GL_TEXTURE_2D_ARRAY and must be
+   * sampled with the layer returned by Texture::textureArrayLayer(). This must be set
+   * before the first texture is uploaded.
+   */
+  void setUseTextureArrays(bool useTextureArrays);
+
+  /**
+   * Indicates whether all textures of this collection have been uploaded.
+   */
   bool prepared() const;
+
+  /**
+   * Indicates whether any texture of this collection was activated while it was not
+   * uploaded.
+   *
+   * @see Texture::uploadRequested()
+   */
+  bool hasRequestedTextures() const;
+
+  /**
+   * Uploads all textures of this collection that have not been uploaded yet.
+   */
   void prepare(int minFilter, int magFilter);
+
+  /**
+   * Uploads at most the given number of textures of this collection that have not been
+   * uploaded yet. Textures that are not uploaded yet can still be used, but they are not
+   * bound when activated.
+   *
+   * @return the number of textures that were uploaded
+   */
+  size_t prepare(int minFilter, int magFilter, size_t maxTextureCount);
+
+  /**
+   * Uploads at most the given number of textures of this collection that were activated
+   * while they were not uploaded.
+   *
+   * If a background uploader is given, large textures that are not packed into a texture
+   * array are handed to it instead. These textures are not counted, and they remain
+   * unprepared until the uploader has completed their upload.
+   *
+   * @return the number of textures that were uploaded
+   */
+  size_t prepareRequested(
+    int minFilter,
+    int magFilter,
+    size_t maxTextureCount,
+    Renderer::BackgroundUploader* backgroundUploader = nullptr);
+
+  /**
+   * Releases the GL storage of the textures that are not used by any face and that were
+   * last activated before the given time. Released textures are uploaded again when they
+   * are requested. Textures packed into a texture array are never released because they
+   * share their storage with the other layers.
+   *
+   * @return the number of textures that were released
+   */
+  size_t releaseUnused(std::chrono::steady_clock::time_point activatedBefore);
+
   void setTextureMode(int minFilter, int magFilter);
+
+private:
+  void createTextureIds(int minFilter, int magFilter);
+  void createTextureArrays(int minFilter, int magFilter);
+  bool isTextureArrayLayer(size_t index) const;
+  void prepareTexture(size_t index, int minFilter, int magFilter);
+  void prepareTextureInBackground(
+    size_t index,
+    int minFilter,
+    int magFilter,
+    Renderer::BackgroundUploader& backgroundUploader);
 };
 
 } // namespace TrenchBroom::Assets
@@ -0,0 +1,398 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCompression.h"
+
+#include "Ensure.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+namespace TrenchBroom::Assets
+{
+
+namespace
+{
+constexpr auto BlockDim = size_t(4);
+constexpr auto PixelsPerBlock = BlockDim * BlockDim;
+
+struct Pixel
+{
+  int r, g, b, a;
+};
+
+using Block = std::array<Pixel, PixelsPerBlock>;
+
+struct ChannelOffsets
+{
+  size_t r, g, b, a;
+};
+
+ChannelOffsets channelOffsets(const GLenum format)
+{
+  return format == GL_BGRA ? ChannelOffsets{2, 1, 0, 3} : ChannelOffsets{0, 1, 2, 3};
+}
+
+size_t blockCount(const size_t size)
+{
+  return (size + BlockDim - 1) / BlockDim;
+}
+
+/**
+ * Reads the 4x4 block at the given block coordinates. Pixels outside of the image are
+ * clamped to its border.
+ */
+Block readBlock(
+  const unsigned char* data,
+  const vm::vec2s& size,
+  const ChannelOffsets& offsets,
+  const size_t blockX,
+  const size_t blockY)
+{
+  auto block = Block{};
+  for (size_t y = 0; y < BlockDim; ++y)
+  {
+    const auto srcY = std::min(blockY * BlockDim + y, size.y() - 1);
+    for (size_t x = 0; x < BlockDim; ++x)
+    {
+      const auto srcX = std::min(blockX * BlockDim + x, size.x() - 1);
+      const auto* pixel = data + (srcY * size.x() + srcX) * 4;
+      block[y * BlockDim + x] =
+        Pixel{pixel[offsets.r], pixel[offsets.g], pixel[offsets.b], pixel[offsets.a]};
+    }
+  }
+  return block;
+}
+
+std::uint16_t toRgb565(const Pixel& pixel)
+{
+  return static_cast<std::uint16_t>(
+    ((pixel.r >> 3) << 11) | ((pixel.g >> 2) << 5) | (pixel.b >> 3));
+}
+
+Pixel fromRgb565(const std::uint16_t color)
+{
+  const auto r = (color >> 11) & 0x1F;
+  const auto g = (color >> 5) & 0x3F;
+  const auto b = color & 0x1F;
+  return Pixel{(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255};
+}
+
+int squaredDistance(const Pixel& lhs, const Pixel& rhs)
+{
+  const auto dr = lhs.r - rhs.r;
+  const auto dg = lhs.g - rhs.g;
+  const auto db = lhs.b - rhs.b;
+  return dr * dr + dg * dg + db * db;
+}
+
+void writeUInt16(unsigned char*& out, const std::uint16_t value)
+{
+  *out++ = static_cast<unsigned char>(value & 0xFF);
+  *out++ = static_cast<unsigned char>(value >> 8);
+}
+
+/**
+ * Selects the color endpoints from the bounding box of the block's colors, inset slightly
+ * to reduce the error of the interpolated colors. If the red or blue channel is
+ * anti-correlated with the green channel, the corresponding endpoint components are
+ * swapped so that the endpoints lie on the other diagonal of the bounding box.
+ */
+std::pair<Pixel, Pixel> selectColorEndpoints(const Block& block)
+{
+  auto min = Pixel{255, 255, 255, 255};
+  auto max = Pixel{0, 0, 0, 0};
+  auto sum = Pixel{0, 0, 0, 0};
+  for (const auto& pixel : block)
+  {
+    min = Pixel{
+      std::min(min.r, pixel.r), std::min(min.g, pixel.g), std::min(min.b, pixel.b), 255};
+    max = Pixel{
+      std::max(max.r, pixel.r), std::max(max.g, pixel.g), std::max(max.b, pixel.b), 255};
+    sum = Pixel{sum.r + pixel.r, sum.g + pixel.g, sum.b + pixel.b, 0};
+  }
+
+  const auto inset = [](int& lo, int& hi) {
+    const auto delta = (hi - lo) / 16;
+    lo += delta;
+    hi -= delta;
+  };
+  inset(min.r, max.r);
+  inset(min.g, max.g);
+  inset(min.b, max.b);
+
+  const auto n = static_cast<int>(PixelsPerBlock);
+  auto covRG = 0;
+  auto covBG = 0;
+  for (const auto& pixel : block)
+  {
+    const auto dg = pixel.g * n - sum.g;
+    covRG += (pixel.r * n - sum.r) * dg;
+    covBG += (pixel.b * n - sum.b) * dg;
+  }
+
+  if (covRG < 0)
+  {
+    std::swap(min.r, max.r);
+  }
+  if (covBG < 0)
+  {
+    std::swap(min.b, max.b);
+  }
+
+  return {max, min};
+}
+
+/**
+ * Encodes the colors of the given block as a DXT1 color block in four color mode.
+ */
+void encodeColorBlock(const Block& block, unsigned char* out)
+{
+  const auto [endpoint0, endpoint1] = selectColorEndpoints(block);
+  auto color0 = toRgb565(endpoint0);
+  auto color1 = toRgb565(endpoint1);
+
+  if (color0 < color1)
+  {
+    std::swap(color0, color1);
+  }
+
+  writeUInt16(out, color0);
+  writeUInt16(out, color1);
+
+  auto indices = std::uint32_t(0);
+  if (color0 != color1)
+  {
+    const auto p0 = fromRgb565(color0);
+    const auto p1 = fromRgb565(color1);
+    const auto palette = std::array<Pixel, 4>{
+      p0,
+      p1,
+      Pixel{(2 * p0.r + p1.r) / 3, (2 * p0.g + p1.g) / 3, (2 * p0.b + p1.b) / 3, 255},
+      Pixel{(p0.r + 2 * p1.r) / 3, (p0.g + 2 * p1.g) / 3, (p0.b + 2 * p1.b) / 3, 255},
+    };
+
+    for (size_t i = 0; i < PixelsPerBlock; ++i)
+    {
+      auto bestIndex = std::uint32_t(0);
+      auto bestDistance = squaredDistance(block[i], palette[0]);
+      for (std::uint32_t j = 1; j < palette.size(); ++j)
+      {
+        const auto distance = squaredDistance(block[i], palette[j]);
+        if (distance < bestDistance)
+        {
+          bestIndex = j;
+          bestDistance = distance;
+        }
+      }
+      indices |= bestIndex << (2 * i);
+    }
+  }
+
+  writeUInt16(out, static_cast<std::uint16_t>(indices & 0xFFFF));
+  writeUInt16(out, static_cast<std::uint16_t>(indices >> 16));
+}
+
+/**
+ * Encodes the alpha values of the given block as a DXT5 alpha block in eight alpha mode.
+ */
+void encodeAlphaBlock(const Block& block, unsigned char* out)
+{
+  auto alpha0 = 0;
+  auto alpha1 = 255;
+  for (const auto& pixel : block)
+  {
+    alpha0 = std::max(alpha0, pixel.a);
+    alpha1 = std::min(alpha1, pixel.a);
+  }
+
+  *out++ = static_cast<unsigned char>(alpha0);
+  *out++ = static_cast<unsigned char>(alpha1);
+
+  auto indices = std::uint64_t(0);
+  if (alpha0 != alpha1)
+  {
+    auto palette = std::array<int, 8>{alpha0, alpha1};
+    for (int i = 1; i < 7; ++i)
+    {
+      palette[size_t(i + 1)] = ((7 - i) * alpha0 + i * alpha1) / 7;
+    }
+
+    for (size_t i = 0; i < PixelsPerBlock; ++i)
+    {
+      auto bestIndex = std::uint64_t(0);
+      auto bestDistance = std::abs(block[i].a - palette[0]);
+      for (std::uint64_t j = 1; j < palette.size(); ++j)
+      {
+        const auto distance = std::abs(block[i].a - palette[j]);
+        if (distance < bestDistance)
+        {
+          bestIndex = j;
+          bestDistance = distance;
+        }
+      }
+      indices |= bestIndex << (3 * i);
+    }
+  }
+
+  for (size_t i = 0; i < 6; ++i)
+  {
+    *out++ = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+  }
+}
+
+TextureBuffer compressMipLevel(
+  const TextureBuffer& buffer,
+  const vm::vec2s& size,
+  const ChannelOffsets& offsets,
+  const bool withAlpha)
+{
+  const auto blockSize = withAlpha ? size_t(16) : size_t(8);
+  const auto blocksX = blockCount(size.x());
+  const auto blocksY = blockCount(size.y());
+
+  auto result = TextureBuffer{blocksX * blocksY * blockSize};
+  auto* out = result.data();
+  for (size_t blockY = 0; blockY < blocksY; ++blockY)
+  {
+    for (size_t blockX = 0; blockX < blocksX; ++blockX)
+    {
+      const auto block = readBlock(buffer.data(), size, offsets, blockX, blockY);
+      if (withAlpha)
+      {
+        encodeAlphaBlock(block, out);
+        out += 8;
+      }
+      encodeColorBlock(block, out);
+      out += 8;
+    }
+  }
+  return result;
+}
+
+/**
+ * Halves the given 4 bytes per pixel mip level using a box filter.
+ */
+TextureBuffer downsampleMipLevel(const TextureBuffer& buffer, const vm::vec2s& size)
+{
+  const auto newWidth = std::max(size_t(1), size.x() / 2);
+  const auto newHeight = std::max(size_t(1), size.y() / 2);
+
+  auto result = TextureBuffer{newWidth * newHeight * 4};
+  const auto* src = buffer.data();
+  auto* dst = result.data();
+  for (size_t y = 0; y < newHeight; ++y)
+  {
+    const auto y0 = std::min(2 * y, size.y() - 1);
+    const auto y1 = std::min(2 * y + 1, size.y() - 1);
+    for (size_t x = 0; x < newWidth; ++x)
+    {
+      const auto x0 = std::min(2 * x, size.x() - 1);
+      const auto x1 = std::min(2 * x + 1, size.x() - 1);
+      for (size_t c = 0; c < 4; ++c)
+      {
+        const auto sum = src[(y0 * size.x() + x0) * 4 + c] + src[(y0 * size.x() + x1) * 4 + c]
+                         + src[(y1 * size.x() + x0) * 4 + c]
+                         + src[(y1 * size.x() + x1) * 4 + c];
+        dst[(y * newWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+      }
+    }
+  }
+  return result;
+}
+
+size_t fullMipLevelCount(const size_t width, const size_t height)
+{
+  auto count = size_t(1);
+  for (auto size = std::max(width, height); size > 1; size /= 2)
+  {
+    ++count;
+  }
+  return count;
+}
+
+bool hasTranslucentPixels(const TextureBuffer& buffer, const size_t alphaOffset)
+{
+  for (size_t i = alphaOffset; i < buffer.size(); i += 4)
+  {
+    if (buffer.data()[i] < 255)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool canCompressTexture(const GLenum format, const size_t width, const size_t height)
+{
+  return (format == GL_RGBA || format == GL_BGRA) && width >= MinCompressedTextureSize
+         && height >= MinCompressedTextureSize;
+}
+
+CompressedTextureBuffers compressTextureBuffers(
+  const TextureBufferList& buffers,
+  const size_t width,
+  const size_t height,
+  const GLenum format,
+  const bool masked)
+{
+  ensure(canCompressTexture(format, width, height), "texture can be compressed");
+  assert(!buffers.empty());
+
+  const auto offsets = channelOffsets(format);
+  const auto withAlpha = masked || hasTranslucentPixels(buffers.front(), offsets.a);
+
+  const auto generateMips = !masked && buffers.size() == 1;
+  const auto mipLevelCount = masked         ? size_t(1)
+                             : generateMips ? fullMipLevelCount(width, height)
+                                            : buffers.size();
+
+  auto result = CompressedTextureBuffers{
+    {},
+    withAlpha ? GLenum(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+              : GLenum(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT),
+    0};
+  result.buffers.reserve(mipLevelCount);
+
+  auto generatedMip = TextureBuffer{};
+  for (size_t level = 0; level < mipLevelCount; ++level)
+  {
+    const auto mipSize = sizeAtMipLevel(width, height, level);
+    if (generateMips && level > 0)
+    {
+      const auto& previous = level == 1 ? buffers.front() : generatedMip;
+      generatedMip = downsampleMipLevel(previous, sizeAtMipLevel(width, height, level - 1));
+    }
+
+    const auto& source = generateMips && level > 0 ? generatedMip : buffers[level];
+    result.buffers.push_back(compressMipLevel(source, mipSize, offsets, withAlpha));
+    result.uncompressedSize += mipSize.x() * mipSize.y() * 4;
+  }
+
+  return result;
+}
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/TextureBuffer.h"
+#include "Renderer/GL.h"
+
+namespace TrenchBroom::Assets
+{
+
+/**
+ * Textures smaller than this in either dimension are not worth compressing.
+ */
+constexpr auto MinCompressedTextureSize = size_t(128);
+
+struct CompressedTextureBuffers
+{
+  TextureBufferList buffers;
+  GLenum format;
+
+  /**
+   * The number of bytes the texture would have occupied in GPU memory if it had been
+   * uploaded without compression, including any mipmaps generated by the driver.
+   */
+  size_t uncompressedSize;
+};
+
+/**
+ * Indicates whether a texture with the given format and size can be transcoded by
+ * compressTextureBuffers. Only large RGBA and BGRA textures are compressed.
+ */
+bool canCompressTexture(GLenum format, size_t width, size_t height);
+
+/**
+ * Transcodes the given mip buffers to S3TC. Textures with an alpha channel are
+ * compressed to DXT5 (BC3), opaque textures to DXT1 (BC1).
+ *
+ * If only one mip level is given, the remaining levels are generated by box filtering,
+ * since drivers cannot generate mipmaps for compressed textures. Masked textures only
+ * use their first mip level, so only that level is compressed.
+ */
+CompressedTextureBuffers compressTextureBuffers(
+  const TextureBufferList& buffers,
+  size_t width,
+  size_t height,
+  GLenum format,
+  bool masked);
+
+} // namespace TrenchBroom::Assets
@@ -24,11 +24,12 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "IO/LoadTextureCollection.h"
+#include "IO/TextureCache.h"
 #include "Logger.h"
+#include "Renderer/BackgroundUploader.h"
+#include "Trace.h"
 
-#include <kdl/map_utils.h>
 #include <kdl/result.h>
-#include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
@@ -41,19 +42,31 @@ namespace TrenchBroom
 {
 namespace Assets
 {
+namespace
+{
+constexpr auto MaxTexturesPreparedPerCommit = size_t(64);
+constexpr auto ReleaseInterval = std::chrono::seconds{5};
+constexpr auto UnusedTextureLifetime = std::chrono::seconds{60};
+} // namespace
 
 TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger)
   : m_logger{logger}
   , m_minFilter{minFilter}
   , m_magFilter{magFilter}
+  , m_lastRelease{std::chrono::steady_clock::now()}
 {
 }
 
-TextureManager::~TextureManager() = default;
+TextureManager::~TextureManager()
+{
+  waitForBackgroundUploads();
+}
 
 void TextureManager::reload(
   const IO::FileSystem& fs, const Model::TextureConfig& textureConfig)
 {
+  traceZone("TextureManager::reload");
+
   findTextureCollections(fs, textureConfig)
     .transform([&](auto textureCollections) {
       setTextureCollections(std::move(textureCollections), fs, textureConfig);
@@ -64,6 +77,29 @@ void TextureManager::reload(
     });
 }
 
+void TextureManager::setCacheDirectory(const std::filesystem::path& cacheDirectory)
+{
+  m_textureCache =
+    !cacheDirectory.empty() ? std::make_unique<IO::TextureCache>(cacheDirectory) : nullptr;
+}
+
+void TextureManager::setCompressTextures(const bool compressTextures)
+{
+  m_compressTextures = compressTextures;
+}
+
+void TextureManager::setGenerateMipmaps(const bool generateMipmaps)
+{
+  m_generateMipmaps = generateMipmaps;
+}
+
+void TextureManager::setBackgroundUploader(
+  Renderer::BackgroundUploader* backgroundUploader)
+{
+  waitForBackgroundUploads();
+  m_backgroundUploader = backgroundUploader;
+}
+
 void TextureManager::setTextureCollections(std::vector<TextureCollection> collections)
 {
   for (auto& collection : collections)
@@ -90,7 +126,15 @@ void TextureManager::setTextureCollections(
 
     if (it == collections.end() || !it->loaded())
     {
-      IO::loadTextureCollection(path, fs, textureConfig, m_logger)
+      traceZone("Load texture collection " + path.string());
+      IO::loadTextureCollection(
+        path,
+        fs,
+        textureConfig,
+        m_logger,
+        m_textureCache.get(),
+        m_compressTextures,
+        m_generateMipmaps)
         .transform_error([&](const auto& error) {
           if (it == collections.end())
           {
@@ -104,6 +148,7 @@ void TextureManager::setTextureCollections(
           {
             m_logger.info() << "Loaded texture collection '" << path << "'";
           }
+          logCompressionSavings(collection);
           addTextureCollection(std::move(collection));
         });
     }
@@ -122,24 +167,37 @@ void TextureManager::setTextureCollections(
   m_toRemove = kdl::vec_concat(std::move(m_toRemove), std::move(collections));
 }
 
-void TextureManager::addTextureCollection(Assets::TextureCollection collection)
+void TextureManager::logCompressionSavings(const TextureCollection& collection)
 {
-  const auto index = m_collections.size();
-  m_collections.push_back(std::move(collection));
+  auto compressedCount = size_t(0);
+  auto savings = size_t(0);
+  for (const auto& texture : collection.textures())
+  {
+    if (texture.compressionSavings() > 0)
+    {
+      ++compressedCount;
+      savings += texture.compressionSavings();
+    }
+  }
 
-  if (m_collections[index].loaded() && !m_collections[index].prepared())
+  if (compressedCount > 0)
   {
-    m_toPrepare.push_back(index);
+    m_logger.debug() << "Compressed " << compressedCount << " textures in collection '"
+                     << collection.path() << "', saving " << savings / 1024 << " KiB";
   }
+}
 
-  m_logger.debug() << "Added texture collection " << m_collections[index].path();
+void TextureManager::addTextureCollection(Assets::TextureCollection collection)
+{
+  m_collections.push_back(std::move(collection));
+  m_logger.debug() << "Added texture collection " << m_collections.back().path();
 }
 
 void TextureManager::clear()
 {
+  waitForBackgroundUploads();
   m_collections.clear();
 
-  m_toPrepare.clear();
   m_texturesByName.clear();
   m_textures.clear();
 
@@ -155,14 +213,34 @@ void TextureManager::setTextureMode(const int minFilter, const int magFilter)
 
 void TextureManager::commitChanges()
 {
+  if (m_backgroundUploader)
+  {
+    m_backgroundUploader->processCompletedUploads();
+  }
+
   resetTextureMode();
   prepare();
-  m_toRemove.clear();
+  releaseUnusedTextures();
+
+  if (!m_toRemove.empty())
+  {
+    waitForBackgroundUploads();
+    m_toRemove.clear();
+  }
+}
+
+bool TextureManager::hasPendingChanges() const
+{
+  return std::any_of(
+           m_collections.begin(),
+           m_collections.end(),
+           [](const auto& c) { return c.hasRequestedTextures(); })
+         || (m_backgroundUploader && m_backgroundUploader->pendingUploadCount() > 0);
 }
 
 const Texture* TextureManager::texture(const std::string& name) const
 {
-  auto it = m_texturesByName.find(kdl::str_to_lower(name));
+  auto it = m_texturesByName.find(name);
   return it != m_texturesByName.end() ? it->second : nullptr;
 }
 
@@ -181,10 +259,22 @@ const std::vector<TextureCollection>& TextureManager::collections() const
   return m_collections;
 }
 
+size_t TextureManager::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& collection : m_collections)
+  {
+    result += collection.memoryUsage();
+  }
+  return result;
+}
+
 void TextureManager::resetTextureMode()
 {
   if (m_resetTextureMode)
   {
+    // textures that are still being uploaded would miss the new mode
+    waitForBackgroundUploads();
     for (auto& collection : m_collections)
     {
       collection.setTextureMode(m_minFilter, m_magFilter);
@@ -195,12 +285,49 @@ void TextureManager::resetTextureMode()
 
 void TextureManager::prepare()
 {
-  for (const auto index : m_toPrepare)
+  auto* backgroundUploader = m_backgroundUploader && m_backgroundUploader->available()
+                               ? m_backgroundUploader
+                               : nullptr;
+
+  auto remaining = MaxTexturesPreparedPerCommit;
+  for (auto& collection : m_collections)
   {
-    auto& collection = m_collections[index];
-    collection.prepare(m_minFilter, m_magFilter);
+    if (remaining == 0)
+    {
+      break;
+    }
+    remaining -= collection.prepareRequested(
+      m_minFilter, m_magFilter, remaining, backgroundUploader);
+  }
+}
+
+void TextureManager::releaseUnusedTextures()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastRelease < ReleaseInterval)
+  {
+    return;
+  }
+  m_lastRelease = now;
+
+  auto count = size_t(0);
+  for (auto& collection : m_collections)
+  {
+    count += collection.releaseUnused(now - UnusedTextureLifetime);
+  }
+
+  if (count > 0)
+  {
+    m_logger.debug() << "Released " << count << " unused textures";
+  }
+}
+
+void TextureManager::waitForBackgroundUploads()
+{
+  if (m_backgroundUploader)
+  {
+    m_backgroundUploader->waitForUploads();
   }
-  m_toPrepare.clear();
 }
 
 void TextureManager::updateTextures()
@@ -212,10 +339,9 @@ void TextureManager::updateTextures()
   {
     for (auto& texture : collection.textures())
     {
-      const auto key = kdl::str_to_lower(texture.name());
       texture.setOverridden(false);
 
-      auto mIt = m_texturesByName.find(key);
+      auto mIt = m_texturesByName.find(texture.name());
       if (mIt != m_texturesByName.end())
       {
         mIt->second->setOverridden(true);
@@ -223,13 +349,18 @@ void TextureManager::updateTextures()
       }
       else
       {
-        m_texturesByName.insert(std::make_pair(key, &texture));
+        m_texturesByName.emplace(texture.name(), &texture);
       }
     }
   }
 
-  m_textures = kdl::vec_transform(kdl::map_values(m_texturesByName), [](auto* t) {
-    return const_cast<const Texture*>(t);
+  m_textures.reserve(m_texturesByName.size());
+  for (const auto& [name, texture] : m_texturesByName)
+  {
+    m_textures.push_back(texture);
+  }
+  std::sort(m_textures.begin(), m_textures.end(), [](const auto* lhs, const auto* rhs) {
+    return kdl::ci::string_less{}(lhs->name(), rhs->name());
   });
 }
 } // namespace Assets
@@ -21,9 +21,13 @@
 
 #include "Assets/TextureCollection.h"
 
+#include <kdl/string_compare.h>
+
+#include <chrono>
 #include <filesystem>
-#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -33,6 +37,7 @@ class Logger;
 namespace IO
 {
 class FileSystem;
+class TextureCache;
 } // namespace IO
 
 namespace Model
@@ -40,6 +45,11 @@ namespace Model
 struct TextureConfig;
 }
 
+namespace Renderer
+{
+class BackgroundUploader;
+}
+
 namespace Assets
 {
 class Texture;
@@ -52,15 +62,22 @@ private:
 
   std::vector<TextureCollection> m_collections;
 
-  std::vector<size_t> m_toPrepare;
   std::vector<TextureCollection> m_toRemove;
 
-  std::map<std::string, Texture*> m_texturesByName;
+  std::unordered_map<std::string, Texture*, kdl::ci::string_hash, kdl::ci::string_equal>
+    m_texturesByName;
   std::vector<const Texture*> m_textures;
 
   int m_minFilter;
   int m_magFilter;
   bool m_resetTextureMode{false};
+  bool m_compressTextures{false};
+  bool m_generateMipmaps{false};
+  Renderer::BackgroundUploader* m_backgroundUploader{nullptr};
+
+  std::chrono::steady_clock::time_point m_lastRelease;
+
+  std::unique_ptr<IO::TextureCache> m_textureCache;
 
 public:
   TextureManager(int magFilter, int minFilter, Logger& logger);
@@ -68,6 +85,32 @@ public:
 
   void reload(const IO::FileSystem& fs, const Model::TextureConfig& textureConfig);
 
+  /**
+   * Sets the directory in which decoded textures are cached. If the given path is empty,
+   * no cache is used. Takes effect when the texture collections are reloaded.
+   */
+  void setCacheDirectory(const std::filesystem::path& cacheDirectory);
+
+  /**
+   * Sets whether large RGBA textures are transcoded to an S3TC compressed format when
+   * they are loaded. Takes effect when the texture collections are reloaded.
+   */
+  void setCompressTextures(bool compressTextures);
+
+  /**
+   * Sets whether only the first mip level of uncompressed textures is kept when they are
+   * loaded, leaving the remaining levels to be generated by the driver. Takes effect when
+   * the texture collections are reloaded.
+   */
+  void setGenerateMipmaps(bool generateMipmaps);
+
+  /**
+   * Sets the uploader that large textures are uploaded by so that they don't stall
+   * rendering. If nullptr is given, all textures are uploaded by commitChanges(). Waits
+   * for the pending uploads of the previous uploader, if any.
+   */
+  void setBackgroundUploader(Renderer::BackgroundUploader* backgroundUploader);
+
   // for testing
   void setTextureCollections(std::vector<TextureCollection> collections);
 
@@ -78,22 +121,52 @@ private:
     const Model::TextureConfig& textureConfig);
 
   void addTextureCollection(Assets::TextureCollection collection);
+  void logCompressionSavings(const TextureCollection& collection);
 
 public:
   void clear();
 
   void setTextureMode(int minFilter, int magFilter);
+
+  /**
+   * Uploads the textures that were activated while they were not uploaded, and releases
+   * the textures of removed collections. Textures are only uploaded once they are
+   * rendered, and the GL storage of textures that have not been rendered for a while and
+   * are not used by any face is released periodically.
+   *
+   * To keep the application responsive, only a limited number of textures is uploaded
+   * per call. Textures that are not uploaded yet are rendered using their average color.
+   * If a background uploader is set, large textures are uploaded by it instead, and they
+   * become available in the first call after their upload has completed.
+   *
+   * @see hasPendingChanges()
+   */
   void commitChanges();
 
+  /**
+   * Indicates whether there are requested textures that have not been uploaded by
+   * commitChanges() yet. Since textures are requested when they are rendered, this should
+   * be checked after rendering.
+   */
+  bool hasPendingChanges() const;
+
   const Texture* texture(const std::string& name) const;
   Texture* texture(const std::string& name);
 
   const std::vector<const Texture*>& textures() const;
   const std::vector<TextureCollection>& collections() const;
 
+  /**
+   * Returns the number of bytes of main memory occupied by the data of the textures in
+   * all collections, see Texture::memoryUsage().
+   */
+  size_t memoryUsage() const;
+
 private:
   void resetTextureMode();
   void prepare();
+  void releaseUnusedTextures();
+  void waitForBackgroundUploads();
 
   void updateTextures();
 };
@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnail.h"
+
+#include "Assets/Texture.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+TextureThumbnail halveImage(const TextureThumbnail& image)
+{
+  const auto bytesPerPixel = bytesPerPixelForFormat(image.format);
+  const auto width = std::max(size_t(1), image.width / 2);
+  const auto height = std::max(size_t(1), image.height / 2);
+
+  auto result = TextureThumbnail{
+    width, height, image.format, TextureBuffer{width * height * bytesPerPixel}};
+
+  const auto* source = image.buffer.data();
+  auto* target = result.buffer.data();
+
+  for (size_t y = 0; y < height; ++y)
+  {
+    const auto y0 = std::min(2 * y, image.height - 1);
+    const auto y1 = std::min(2 * y + 1, image.height - 1);
+    for (size_t x = 0; x < width; ++x)
+    {
+      const auto x0 = std::min(2 * x, image.width - 1);
+      const auto x1 = std::min(2 * x + 1, image.width - 1);
+      for (size_t c = 0; c < bytesPerPixel; ++c)
+      {
+        const auto sum = size_t(source[(y0 * image.width + x0) * bytesPerPixel + c])
+                         + size_t(source[(y0 * image.width + x1) * bytesPerPixel + c])
+                         + size_t(source[(y1 * image.width + x0) * bytesPerPixel + c])
+                         + size_t(source[(y1 * image.width + x1) * bytesPerPixel + c]);
+        target[(y * width + x) * bytesPerPixel + c] = static_cast<unsigned char>(sum / 4);
+      }
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+size_t selectThumbnailMipLevel(
+  const size_t width,
+  const size_t height,
+  const size_t mipLevels,
+  const size_t thumbnailSize)
+{
+  auto level = size_t(0);
+  while (level + 1 < mipLevels)
+  {
+    const auto mipSize = sizeAtMipLevel(width, height, level + 1);
+    if (std::max(mipSize.x(), mipSize.y()) < thumbnailSize)
+    {
+      break;
+    }
+    ++level;
+  }
+  return level;
+}
+
+TextureThumbnail copyThumbnailMipLevel(const Texture& texture, const size_t thumbnailSize)
+{
+  const auto& buffers = texture.buffersIfUnprepared();
+  assert(!buffers.empty());
+
+  const auto level = selectThumbnailMipLevel(
+    texture.width(), texture.height(), buffers.size(), thumbnailSize);
+  const auto mipSize = sizeAtMipLevel(texture.width(), texture.height(), level);
+  const auto& mip = buffers[level];
+
+  auto result = TextureThumbnail{
+    mipSize.x(), mipSize.y(), texture.format(), TextureBuffer{mip.size()}};
+  std::memcpy(result.buffer.data(), mip.data(), mip.size());
+  return result;
+}
+
+TextureThumbnail makeTextureThumbnail(TextureThumbnail image, const size_t thumbnailSize)
+{
+  if (isCompressedFormat(image.format))
+  {
+    return image;
+  }
+
+  while (std::max(image.width, image.height) / 2 >= thumbnailSize)
+  {
+    image = halveImage(image);
+  }
+  return image;
+}
+
+} // namespace TrenchBroom::Assets
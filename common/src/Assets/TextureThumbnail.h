@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/TextureBuffer.h"
+#include "Renderer/GL.h"
+
+#include <cstddef>
+
+namespace TrenchBroom::Assets
+{
+class Texture;
+
+/**
+ * A downsampled copy of a texture that is used to display the texture in a browser.
+ */
+struct TextureThumbnail
+{
+  size_t width;
+  size_t height;
+  GLenum format;
+  TextureBuffer buffer;
+};
+
+/**
+ * Returns the smallest mipmap level of a texture of the given size with the given number
+ * of mipmap levels whose larger dimension is not smaller than the given thumbnail size.
+ * Returns 0 if the texture itself is not larger than the thumbnail size.
+ */
+size_t selectThumbnailMipLevel(
+  size_t width, size_t height, size_t mipLevels, size_t thumbnailSize);
+
+/**
+ * Copies the smallest mipmap level of the given texture that is suitable for a thumbnail
+ * of the given size. The copy can be passed to makeTextureThumbnail on another thread.
+ */
+TextureThumbnail copyThumbnailMipLevel(const Texture& texture, size_t thumbnailSize);
+
+/**
+ * Halves the size of the given image using a box filter until halving it again would
+ * make its larger dimension smaller than the given thumbnail size. Compressed images are
+ * returned unchanged.
+ */
+TextureThumbnail makeTextureThumbnail(TextureThumbnail image, size_t thumbnailSize);
+
+} // namespace TrenchBroom::Assets
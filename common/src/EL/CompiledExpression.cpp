@@ -0,0 +1,978 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledExpression.h"
+
+#include "EL/EvaluationContext.h"
+#include "EL/Expressions.h"
+#include "Ensure.h"
+#include "Macros.h"
+
+#include <kdl/overload.h>
+#include <kdl/string_format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <variant>
+
+namespace TrenchBroom
+{
+namespace EL
+{
+/**
+ * Translates an expression tree into the instructions of a compiled expression.
+ *
+ * Every subexpression is compiled such that its value is stored in a given target
+ * register. Registers are allocated in a stack-like fashion: The registers allocated for
+ * the operands of an expression are released once the instruction that consumes them has
+ * been emitted.
+ *
+ * Subexpressions that do not refer to any variables are evaluated while compiling and
+ * replaced by their values. Unlike Expression::optimize, this never evaluates a
+ * subexpression that depends on a variable, so it does not change the result.
+ */
+class ExpressionCompiler
+{
+private:
+  using Opcode = CompiledExpression::Opcode;
+
+  struct AutoRangeScope
+  {
+    size_t registerIndex;
+    bool used;
+  };
+
+  CompiledExpression& m_compiledExpression;
+  size_t m_nextRegister = 0u;
+  std::vector<AutoRangeScope> m_autoRangeScopes;
+  size_t m_variableReferences = 0u;
+
+public:
+  explicit ExpressionCompiler(CompiledExpression& compiledExpression)
+    : m_compiledExpression{compiledExpression}
+  {
+  }
+
+  void compile()
+  {
+    const auto target = allocateRegisters(1u);
+    compile(m_compiledExpression.m_expression, target);
+  }
+
+private:
+  void compile(const Expression& expression, const size_t target)
+  {
+    auto& instructions = m_compiledExpression.m_instructions;
+    auto& constants = m_compiledExpression.m_constants;
+    auto& keys = m_compiledExpression.m_keys;
+
+    const auto firstInstruction = instructions.size();
+    const auto firstConstant = constants.size();
+    const auto firstKeys = keys.size();
+    const auto variableReferences = m_variableReferences;
+
+    compileExpression(expression, target);
+
+    if (
+      m_variableReferences == variableReferences
+      && instructions.size() - firstInstruction > 1u)
+    {
+      try
+      {
+        auto value = expression.evaluate(EvaluationContext{});
+
+        instructions.erase(
+          std::next(instructions.begin(), static_cast<std::ptrdiff_t>(firstInstruction)),
+          instructions.end());
+        constants.erase(
+          std::next(constants.begin(), static_cast<std::ptrdiff_t>(firstConstant)),
+          constants.end());
+        keys.erase(
+          std::next(keys.begin(), static_cast<std::ptrdiff_t>(firstKeys)), keys.end());
+
+        emit(Opcode::LoadConstant, target, addConstant(std::move(value)));
+      }
+      catch (const std::exception&)
+      {
+        // leave the error to be reported when the expression is evaluated
+      }
+    }
+  }
+
+  void compileExpression(const Expression& expression, const size_t target)
+  {
+    const auto* impl = expression.m_expression.get();
+    if (const auto* literal = dynamic_cast<const LiteralExpression*>(impl))
+    {
+      compileLiteral(*literal, target);
+    }
+    else if (const auto* variable = dynamic_cast<const VariableExpression*>(impl))
+    {
+      compileVariable(*variable, target);
+    }
+    else if (const auto* array = dynamic_cast<const ArrayExpression*>(impl))
+    {
+      compileArray(*array, target);
+    }
+    else if (const auto* map = dynamic_cast<const MapExpression*>(impl))
+    {
+      compileMap(*map, target);
+    }
+    else if (const auto* unary = dynamic_cast<const UnaryExpression*>(impl))
+    {
+      compileUnary(*unary, target);
+    }
+    else if (const auto* binary = dynamic_cast<const BinaryExpression*>(impl))
+    {
+      compileBinary(*binary, target);
+    }
+    else if (const auto* subscript = dynamic_cast<const SubscriptExpression*>(impl))
+    {
+      compileSubscript(*subscript, target);
+    }
+    else if (const auto* switch_ = dynamic_cast<const SwitchExpression*>(impl))
+    {
+      compileSwitch(*switch_, target);
+    }
+    else
+    {
+      ensure(false, "unknown expression type");
+    }
+  }
+
+  void compileLiteral(const LiteralExpression& expression, const size_t target)
+  {
+    emit(Opcode::LoadConstant, target, addConstant(expression.m_value));
+  }
+
+  void compileVariable(const VariableExpression& expression, const size_t target)
+  {
+    if (
+      !m_autoRangeScopes.empty()
+      && expression.m_variableName == SubscriptExpression::AutoRangeParameterName())
+    {
+      auto& scope = m_autoRangeScopes.back();
+      scope.used = true;
+      emit(Opcode::Move, target, scope.registerIndex);
+      ++m_variableReferences;
+    }
+    else
+    {
+      emit(Opcode::LoadVariable, target, addName(expression.m_variableName));
+      ++m_variableReferences;
+    }
+  }
+
+  void compileArray(const ArrayExpression& expression, const size_t target)
+  {
+    const auto count = expression.m_elements.size();
+    const auto first = allocateRegisters(count);
+    for (size_t i = 0u; i < count; ++i)
+    {
+      compile(expression.m_elements[i], first + i);
+    }
+    emit(Opcode::MakeArray, target, first, count);
+    releaseRegisters(first);
+  }
+
+  void compileMap(const MapExpression& expression, const size_t target)
+  {
+    auto keys = std::vector<std::string>{};
+    keys.reserve(expression.m_elements.size());
+
+    const auto first = allocateRegisters(expression.m_elements.size());
+    for (const auto& [key, element] : expression.m_elements)
+    {
+      compile(element, first + keys.size());
+      keys.push_back(key);
+    }
+
+    auto& allKeys = m_compiledExpression.m_keys;
+    allKeys.push_back(std::move(keys));
+    emit(Opcode::MakeMap, target, first, allKeys.size() - 1u);
+    releaseRegisters(first);
+  }
+
+  void compileUnary(const UnaryExpression& expression, const size_t target)
+  {
+    compile(expression.m_operand, target);
+    if (expression.m_operator != UnaryOperator::Group)
+    {
+      emit(Opcode::Unary, target, target, 0u, expression.m_operator);
+    }
+  }
+
+  void compileBinary(const BinaryExpression& expression, const size_t target)
+  {
+    compile(expression.m_leftOperand, target);
+
+    switch (expression.m_operator)
+    {
+    case BinaryOperator::LogicalAnd:
+    case BinaryOperator::LogicalOr: {
+      const auto opcode = expression.m_operator == BinaryOperator::LogicalAnd
+                            ? Opcode::ShortCircuitAnd
+                            : Opcode::ShortCircuitOr;
+      const auto jump = emit(opcode, target, target);
+      compileBinaryOperator(expression, target);
+      patchJump(jump);
+      break;
+    }
+    case BinaryOperator::Case: {
+      const auto jump = emit(Opcode::ShortCircuitCase, target, target);
+      compile(expression.m_rightOperand, target);
+      patchJump(jump);
+      break;
+    }
+    case BinaryOperator::Addition:
+    case BinaryOperator::Subtraction:
+    case BinaryOperator::Multiplication:
+    case BinaryOperator::Division:
+    case BinaryOperator::Modulus:
+    case BinaryOperator::BitwiseAnd:
+    case BinaryOperator::BitwiseXOr:
+    case BinaryOperator::BitwiseOr:
+    case BinaryOperator::BitwiseShiftLeft:
+    case BinaryOperator::BitwiseShiftRight:
+    case BinaryOperator::Less:
+    case BinaryOperator::LessOrEqual:
+    case BinaryOperator::Greater:
+    case BinaryOperator::GreaterOrEqual:
+    case BinaryOperator::Equal:
+    case BinaryOperator::NotEqual:
+    case BinaryOperator::Range:
+      compileBinaryOperator(expression, target);
+      break;
+      switchDefault();
+    }
+  }
+
+  void compileBinaryOperator(const BinaryExpression& expression, const size_t target)
+  {
+    const auto rhs = allocateRegisters(1u);
+    compile(expression.m_rightOperand, rhs);
+    emit(Opcode::Binary, target, target, rhs, expression.m_operator);
+    releaseRegisters(rhs);
+  }
+
+  void compileSubscript(const SubscriptExpression& expression, const size_t target)
+  {
+    compile(expression.m_leftOperand, target);
+
+    const auto autoRange = allocateRegisters(1u);
+    const auto autoRangeInstruction = emit(Opcode::AutoRange, autoRange, target);
+    m_autoRangeScopes.push_back({autoRange, false});
+
+    const auto index = allocateRegisters(1u);
+    compile(expression.m_rightOperand, index);
+
+    if (!m_autoRangeScopes.back().used)
+    {
+      // the index does not refer to the auto range parameter, so don't compute it
+      m_compiledExpression.m_instructions[autoRangeInstruction].opcode = Opcode::Nop;
+    }
+    m_autoRangeScopes.pop_back();
+
+    emit(Opcode::Subscript, target, target, index);
+    releaseRegisters(autoRange);
+  }
+
+  void compileSwitch(const SwitchExpression& expression, const size_t target)
+  {
+    if (expression.m_cases.empty())
+    {
+      emit(Opcode::LoadConstant, target, addConstant(Value::Undefined));
+      return;
+    }
+
+    auto jumps = std::vector<size_t>{};
+    for (size_t i = 0u; i < expression.m_cases.size(); ++i)
+    {
+      compile(expression.m_cases[i], target);
+      if (i < expression.m_cases.size() - 1u)
+      {
+        jumps.push_back(emit(Opcode::JumpIfDefined, 0u, target));
+      }
+    }
+
+    for (const auto jump : jumps)
+    {
+      patchJump(jump);
+    }
+  }
+
+  size_t allocateRegisters(const size_t count)
+  {
+    const auto first = m_nextRegister;
+    m_nextRegister += count;
+    m_compiledExpression.m_registerCount =
+      std::max(m_compiledExpression.m_registerCount, m_nextRegister);
+    return first;
+  }
+
+  void releaseRegisters(const size_t first) { m_nextRegister = first; }
+
+  size_t addConstant(Value value)
+  {
+    auto& constants = m_compiledExpression.m_constants;
+    constants.push_back(std::move(value));
+    return constants.size() - 1u;
+  }
+
+  size_t addName(const std::string& name)
+  {
+    auto& names = m_compiledExpression.m_names;
+    const auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end())
+    {
+      return static_cast<size_t>(std::distance(names.begin(), it));
+    }
+
+    names.push_back(name);
+    return names.size() - 1u;
+  }
+
+  template <typename Operator = std::uint8_t>
+  size_t emit(
+    const Opcode opcode,
+    const size_t target,
+    const size_t operand1 = 0u,
+    const size_t operand2 = 0u,
+    const Operator operator_ = Operator{})
+  {
+    auto& instructions = m_compiledExpression.m_instructions;
+    instructions.push_back(CompiledExpression::Instruction{
+      opcode,
+      static_cast<std::uint8_t>(operator_),
+      static_cast<std::uint32_t>(target),
+      static_cast<std::uint32_t>(operand1),
+      static_cast<std::uint32_t>(operand2)});
+    return instructions.size() - 1u;
+  }
+
+  /**
+   * Sets the jump target of the given instruction to the next instruction to be emitted.
+   */
+  void patchJump(const size_t jump)
+  {
+    auto& instructions = m_compiledExpression.m_instructions;
+    instructions[jump].operand2 = static_cast<std::uint32_t>(instructions.size());
+  }
+};
+
+namespace
+{
+/**
+ * A register of the virtual machine. Numbers and booleans are stored unboxed, all other
+ * values are stored as values.
+ */
+class Register
+{
+public:
+  enum class Type
+  {
+    Number,
+    Boolean,
+    Boxed
+  };
+
+private:
+  std::variant<NumberType, BooleanType, Value> m_value;
+
+public:
+  void setNumber(const NumberType number) { m_value.emplace<NumberType>(number); }
+
+  void setBoolean(const BooleanType boolean) { m_value.emplace<BooleanType>(boolean); }
+
+  void setValue(Value value) { m_value.emplace<Value>(std::move(value)); }
+
+  /**
+   * Boxes the value of this register if necessary and returns it.
+   */
+  const Value& boxed()
+  {
+    if (const auto* number = std::get_if<NumberType>(&m_value))
+    {
+      setValue(Value{*number});
+    }
+    else if (const auto* boolean = std::get_if<BooleanType>(&m_value))
+    {
+      setValue(Value{*boolean});
+    }
+    return std::get<Value>(m_value);
+  }
+
+  /**
+   * Boxes the value of this register if necessary and moves it out of this register.
+   */
+  Value take()
+  {
+    boxed();
+    return std::move(std::get<Value>(m_value));
+  }
+
+  /**
+   * Returns the type of this register's value if it is a number or a boolean, and
+   * Boxed otherwise.
+   */
+  Type primitiveType() const
+  {
+    if (const auto* value = std::get_if<Value>(&m_value))
+    {
+      switch (value->type())
+      {
+      case ValueType::Number:
+        return Type::Number;
+      case ValueType::Boolean:
+        return Type::Boolean;
+      case ValueType::String:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        return Type::Boxed;
+      }
+    }
+    return std::holds_alternative<NumberType>(m_value) ? Type::Number : Type::Boolean;
+  }
+
+  /**
+   * Returns this register's value as a number. Must only be called if this register
+   * holds a number or a boolean.
+   */
+  NumberType asNumber() const
+  {
+    return std::visit(
+      kdl::overload(
+        [](const NumberType number) { return number; },
+        [](const BooleanType boolean) { return boolean ? 1.0 : 0.0; },
+        [](const Value& value) {
+          return value.hasType(ValueType::Boolean) ? (value.booleanValue() ? 1.0 : 0.0)
+                                                   : value.numberValue();
+        }),
+      m_value);
+  }
+
+  /**
+   * Returns this register's value as a boolean. Must only be called if this register
+   * holds a number or a boolean.
+   */
+  BooleanType asBoolean() const
+  {
+    return std::visit(
+      kdl::overload(
+        [](const NumberType number) { return number != 0.0; },
+        [](const BooleanType boolean) { return boolean; },
+        [](const Value& value) {
+          return value.hasType(ValueType::Boolean) ? value.booleanValue()
+                                                   : value.numberValue() != 0.0;
+        }),
+      m_value);
+  }
+
+  /**
+   * Returns the number represented by this register's value if it is a string that can
+   * be converted to a number, using the same conversion as Value::convertTo.
+   */
+  std::optional<NumberType> numericString() const
+  {
+    const auto* value = std::get_if<Value>(&m_value);
+    if (!value || !value->hasType(ValueType::String))
+    {
+      return std::nullopt;
+    }
+
+    const auto& string = value->stringValue();
+    if (kdl::str_is_blank(string))
+    {
+      return 0.0;
+    }
+
+    const char* begin = string.c_str();
+    char* end;
+    const auto number = std::strtod(begin, &end);
+    if (number == 0.0 && end == begin)
+    {
+      return std::nullopt;
+    }
+    return number;
+  }
+
+  bool isUndefined() const
+  {
+    const auto* value = std::get_if<Value>(&m_value);
+    return value && value->hasType(ValueType::Undefined);
+  }
+};
+
+int compareNumbers(const NumberType lhs, const NumberType rhs)
+{
+  const auto diff = lhs - rhs;
+  return diff < 0.0 ? -1 : diff > 0.0 ? 1 : 0;
+}
+
+int compareBooleans(const BooleanType lhs, const BooleanType rhs)
+{
+  return lhs == rhs ? 0 : lhs ? 1 : -1;
+}
+
+IntegerType asInteger(const Register& reg)
+{
+  return static_cast<IntegerType>(reg.asNumber());
+}
+
+/**
+ * Applies the given unary operator if the operand is a number or a boolean and the
+ * result can be computed without boxing them. Returns false otherwise.
+ */
+bool tryEvaluatePrimitiveUnaryOperator(
+  const UnaryOperator operator_, const Register& operand, Register& result)
+{
+  const auto type = operand.primitiveType();
+  if (type == Register::Type::Boxed)
+  {
+    return false;
+  }
+
+  switch (operator_)
+  {
+  case UnaryOperator::Plus:
+    result.setNumber(operand.asNumber());
+    return true;
+  case UnaryOperator::Minus:
+    result.setNumber(-operand.asNumber());
+    return true;
+  case UnaryOperator::LogicalNegation:
+    if (type == Register::Type::Boolean)
+    {
+      result.setBoolean(!operand.asBoolean());
+      return true;
+    }
+    return false;
+  case UnaryOperator::BitwiseNegation:
+    if (type == Register::Type::Number)
+    {
+      result.setNumber(static_cast<NumberType>(~asInteger(operand)));
+      return true;
+    }
+    return false;
+  case UnaryOperator::Group:
+    return false;
+    switchDefault();
+  }
+}
+
+std::optional<NumberType> evaluateAlgebraicOperator(
+  const BinaryOperator operator_, const NumberType lhs, const NumberType rhs)
+{
+  switch (operator_)
+  {
+  case BinaryOperator::Addition:
+    return lhs + rhs;
+  case BinaryOperator::Subtraction:
+    return lhs - rhs;
+  case BinaryOperator::Multiplication:
+    return lhs * rhs;
+  case BinaryOperator::Division:
+    return lhs / rhs;
+  case BinaryOperator::Modulus:
+    return std::fmod(lhs, rhs);
+  case BinaryOperator::LogicalAnd:
+  case BinaryOperator::LogicalOr:
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+  case BinaryOperator::Case:
+    return std::nullopt;
+    switchDefault();
+  }
+}
+
+std::optional<NumberType> evaluateBitwiseOperator(
+  const BinaryOperator operator_, const NumberType lhs, const NumberType rhs)
+{
+  const auto lhsInteger = static_cast<IntegerType>(lhs);
+  const auto rhsInteger = static_cast<IntegerType>(rhs);
+
+  switch (operator_)
+  {
+  case BinaryOperator::BitwiseAnd:
+    return static_cast<NumberType>(lhsInteger & rhsInteger);
+  case BinaryOperator::BitwiseXOr:
+    return static_cast<NumberType>(lhsInteger ^ rhsInteger);
+  case BinaryOperator::BitwiseOr:
+    return static_cast<NumberType>(lhsInteger | rhsInteger);
+  case BinaryOperator::BitwiseShiftLeft:
+    return static_cast<NumberType>(lhsInteger << rhsInteger);
+  case BinaryOperator::BitwiseShiftRight:
+    return static_cast<NumberType>(lhsInteger >> rhsInteger);
+  case BinaryOperator::Addition:
+  case BinaryOperator::Subtraction:
+  case BinaryOperator::Multiplication:
+  case BinaryOperator::Division:
+  case BinaryOperator::Modulus:
+  case BinaryOperator::LogicalAnd:
+  case BinaryOperator::LogicalOr:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+  case BinaryOperator::Case:
+    return std::nullopt;
+    switchDefault();
+  }
+}
+
+std::optional<BooleanType> evaluateComparisonOperator(
+  const BinaryOperator operator_, const int comparison)
+{
+  switch (operator_)
+  {
+  case BinaryOperator::Less:
+    return comparison < 0;
+  case BinaryOperator::LessOrEqual:
+    return comparison <= 0;
+  case BinaryOperator::Greater:
+    return comparison > 0;
+  case BinaryOperator::GreaterOrEqual:
+    return comparison >= 0;
+  case BinaryOperator::Equal:
+    return comparison == 0;
+  case BinaryOperator::NotEqual:
+    return comparison != 0;
+  case BinaryOperator::Addition:
+  case BinaryOperator::Subtraction:
+  case BinaryOperator::Multiplication:
+  case BinaryOperator::Division:
+  case BinaryOperator::Modulus:
+  case BinaryOperator::LogicalAnd:
+  case BinaryOperator::LogicalOr:
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Range:
+  case BinaryOperator::Case:
+    return std::nullopt;
+    switchDefault();
+  }
+}
+
+/**
+ * Applies the given binary operator if both operands are numbers or booleans and the
+ * result can be computed without boxing them. Returns false otherwise.
+ */
+bool tryEvaluatePrimitiveBinaryOperator(
+  const BinaryOperator operator_,
+  const Register& lhs,
+  const Register& rhs,
+  Register& result)
+{
+  const auto lhsType = lhs.primitiveType();
+  const auto rhsType = rhs.primitiveType();
+  if (lhsType == Register::Type::Boxed || rhsType == Register::Type::Boxed)
+  {
+    return false;
+  }
+
+  if (operator_ == BinaryOperator::LogicalAnd || operator_ == BinaryOperator::LogicalOr)
+  {
+    // the left operand did not short circuit, so the right operand decides the result
+    if (lhsType == Register::Type::Boolean && rhsType == Register::Type::Boolean)
+    {
+      result.setBoolean(rhs.asBoolean());
+      return true;
+    }
+    return false;
+  }
+
+  const auto lhsNumber = lhs.asNumber();
+  const auto rhsNumber = rhs.asNumber();
+  if (const auto number = evaluateAlgebraicOperator(operator_, lhsNumber, rhsNumber))
+  {
+    result.setNumber(*number);
+    return true;
+  }
+
+  if (const auto number = evaluateBitwiseOperator(operator_, lhsNumber, rhsNumber))
+  {
+    result.setNumber(*number);
+    return true;
+  }
+
+  const auto comparison =
+    lhsType == Register::Type::Boolean || rhsType == Register::Type::Boolean
+      ? compareBooleans(lhs.asBoolean(), rhs.asBoolean())
+      : compareNumbers(lhsNumber, rhsNumber);
+  if (const auto boolean = evaluateComparisonOperator(operator_, comparison))
+  {
+    result.setBoolean(*boolean);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Applies the given binary operator if one operand is a string that represents a number
+ * and the other operand is a number, or a boolean for the algebraic and bitwise
+ * operators. Entity property values are strings, so this covers expressions such as
+ * `spawnflags & 1`. Returns false otherwise.
+ */
+bool tryEvaluateNumericStringBinaryOperator(
+  const BinaryOperator operator_,
+  const Register& lhs,
+  const Register& rhs,
+  Register& result)
+{
+  const auto lhsType = lhs.primitiveType();
+  const auto rhsType = rhs.primitiveType();
+
+  const auto toNumber = [](const Register& reg, const Register::Type type) {
+    return type != Register::Type::Boxed ? std::optional{reg.asNumber()}
+                                         : reg.numericString();
+  };
+
+  const auto lhsNumber = toNumber(lhs, lhsType);
+  const auto rhsNumber = toNumber(rhs, rhsType);
+  if (!lhsNumber || !rhsNumber)
+  {
+    return false;
+  }
+
+  // two numeric strings are concatenated by the addition operator and compared as
+  // strings by the comparison operators
+  const auto bothStrings =
+    lhsType == Register::Type::Boxed && rhsType == Register::Type::Boxed;
+  if (!bothStrings)
+  {
+    if (const auto number = evaluateAlgebraicOperator(operator_, *lhsNumber, *rhsNumber))
+    {
+      result.setNumber(*number);
+      return true;
+    }
+  }
+
+  if (const auto number = evaluateBitwiseOperator(operator_, *lhsNumber, *rhsNumber))
+  {
+    result.setNumber(*number);
+    return true;
+  }
+
+  // strings are compared to booleans as booleans
+  if (
+    lhsType != Register::Type::Boolean && rhsType != Register::Type::Boolean
+    && !bothStrings)
+  {
+    if (
+      const auto boolean = evaluateComparisonOperator(
+        operator_, compareNumbers(*lhsNumber, *rhsNumber)))
+    {
+      result.setBoolean(*boolean);
+      return true;
+    }
+  }
+
+  return false;
+}
+} // namespace
+
+CompiledExpression::CompiledExpression(Expression expression)
+  : m_expression{std::move(expression)}
+  , m_registerCount{0u}
+{
+  ExpressionCompiler{*this}.compile();
+}
+
+const Expression& CompiledExpression::expression() const
+{
+  return m_expression;
+}
+
+const std::vector<CompiledExpression::Instruction>& CompiledExpression::instructions()
+  const
+{
+  return m_instructions;
+}
+
+const std::vector<std::string>& CompiledExpression::variableNames() const
+{
+  return m_names;
+}
+
+Value CompiledExpression::evaluate(const EvaluationContext& context) const
+{
+  auto registers = std::vector<Register>(m_registerCount);
+
+  size_t pc = 0u;
+  while (pc < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[pc++];
+    auto& target = registers[instruction.target];
+
+    switch (instruction.opcode)
+    {
+    case Opcode::Nop:
+      break;
+    case Opcode::LoadConstant:
+      target.setValue(m_constants[instruction.operand1]);
+      break;
+    case Opcode::LoadVariable:
+      target.setValue(context.variableValue(m_names[instruction.operand1]));
+      break;
+    case Opcode::Move:
+      target = registers[instruction.operand1];
+      break;
+    case Opcode::MakeArray: {
+      auto array = ArrayType{};
+      array.reserve(instruction.operand2);
+      for (size_t i = 0u; i < instruction.operand2; ++i)
+      {
+        auto value = registers[instruction.operand1 + i].take();
+        if (value.hasType(ValueType::Range))
+        {
+          const auto& range = value.rangeValue();
+          array.reserve(array.size() + range.size());
+          for (const auto index : range)
+          {
+            array.emplace_back(index);
+          }
+        }
+        else
+        {
+          array.push_back(std::move(value));
+        }
+      }
+      target.setValue(Value{std::move(array)});
+      break;
+    }
+    case Opcode::MakeMap: {
+      const auto& keys = m_keys[instruction.operand2];
+      auto map = MapType{};
+      for (size_t i = 0u; i < keys.size(); ++i)
+      {
+        map.emplace(keys[i], registers[instruction.operand1 + i].take());
+      }
+      target.setValue(Value{std::move(map)});
+      break;
+    }
+    case Opcode::Unary: {
+      const auto operator_ = static_cast<UnaryOperator>(instruction.operator_);
+      auto& operand = registers[instruction.operand1];
+      if (!tryEvaluatePrimitiveUnaryOperator(operator_, operand, target))
+      {
+        target.setValue(evaluateUnaryOperator(operator_, operand.boxed()));
+      }
+      break;
+    }
+    case Opcode::Binary: {
+      const auto operator_ = static_cast<BinaryOperator>(instruction.operator_);
+      auto& lhs = registers[instruction.operand1];
+      auto& rhs = registers[instruction.operand2];
+      if (
+        !tryEvaluatePrimitiveBinaryOperator(operator_, lhs, rhs, target)
+        && !tryEvaluateNumericStringBinaryOperator(operator_, lhs, rhs, target))
+      {
+        target.setValue(evaluateBinaryOperator(operator_, lhs.boxed(), rhs.boxed()));
+      }
+      break;
+    }
+    case Opcode::AutoRange:
+      target.setValue(Value{registers[instruction.operand1].boxed().length() - 1u});
+      break;
+    case Opcode::Subscript: {
+      auto& indexable = registers[instruction.operand1];
+      auto& index = registers[instruction.operand2];
+      target.setValue(indexable.boxed()[index.boxed()]);
+      break;
+    }
+    case Opcode::ShortCircuitAnd:
+    case Opcode::ShortCircuitOr: {
+      // the operator short circuits if its left operand is undefined, or if it is a
+      // boolean or null that decides the result
+      const auto shortCircuitValue = instruction.opcode == Opcode::ShortCircuitOr;
+      auto& operand = registers[instruction.operand1];
+      if (operand.isUndefined())
+      {
+        target.setValue(Value::Undefined);
+        pc = instruction.operand2;
+      }
+      else if (operand.primitiveType() == Register::Type::Boolean)
+      {
+        if (const auto value = operand.asBoolean(); value == shortCircuitValue)
+        {
+          target.setBoolean(value);
+          pc = instruction.operand2;
+        }
+      }
+      else if (
+        !shortCircuitValue && operand.primitiveType() == Register::Type::Boxed
+        && operand.boxed().hasType(ValueType::Null))
+      {
+        target.setBoolean(false);
+        pc = instruction.operand2;
+      }
+      break;
+    }
+    case Opcode::ShortCircuitCase: {
+      auto& operand = registers[instruction.operand1];
+      if (
+        operand.isUndefined()
+        || !(
+          operand.primitiveType() != Register::Type::Boxed
+            ? operand.asBoolean()
+            : operand.boxed().convertTo(ValueType::Boolean).booleanValue()))
+      {
+        target.setValue(Value::Undefined);
+        pc = instruction.operand2;
+      }
+      break;
+    }
+    case Opcode::JumpIfDefined:
+      if (!registers[instruction.operand1].isUndefined())
+      {
+        pc = instruction.operand2;
+      }
+      break;
+      switchDefault();
+    }
+  }
+
+  return Value{registers.front().take(), m_expression};
+}
+} // namespace EL
+} // namespace TrenchBroom
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EL/EL_Forward.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace EL
+{
+/**
+ * An expression that has been compiled into a flat sequence of instructions for a
+ * register machine.
+ *
+ * Evaluating a compiled expression yields the same values and throws the same errors as
+ * evaluating the expression it was compiled from, but it does not walk the expression
+ * tree. Intermediate numbers and booleans are kept unboxed in registers, so arithmetic,
+ * comparisons and logical operators on them do not allocate any values.
+ *
+ * Subexpressions that do not reference any variables are evaluated once when compiling
+ * and replaced by their values. Unlike Expression::optimize, this never changes the
+ * result of expressions that depend on variables. Only the result of the evaluation is
+ * annotated with the compiled expression, intermediate values do not carry their source
+ * expressions.
+ */
+class CompiledExpression
+{
+public:
+  friend class ExpressionCompiler;
+
+  enum class Opcode : std::uint8_t
+  {
+    /** Does nothing. */
+    Nop,
+    /** target = constants[operand1] */
+    LoadConstant,
+    /** target = context.variableValue(names[operand1]) */
+    LoadVariable,
+    /** target = operand1 */
+    Move,
+    /** target = [operand1, ..., operand1 + operand2 - 1], ranges are expanded */
+    MakeArray,
+    /** target = { keys[operand2][i]: operand1 + i } */
+    MakeMap,
+    /** target = op operand1 */
+    Unary,
+    /** target = operand1 op operand2 */
+    Binary,
+    /** target = operand1.length() - 1 */
+    AutoRange,
+    /** target = operand1[operand2] */
+    Subscript,
+    /** If operand1 decides the value of operand1 && ..., stores that value in target
+        and jumps to operand2. */
+    ShortCircuitAnd,
+    /** If operand1 decides the value of operand1 || ..., stores that value in target
+        and jumps to operand2. */
+    ShortCircuitOr,
+    /** If operand1 is undefined or false, stores undefined in target and jumps to
+        operand2. */
+    ShortCircuitCase,
+    /** Jumps to operand2 if operand1 is not undefined. */
+    JumpIfDefined,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    /** The unary or binary operator of Unary and Binary instructions. */
+    std::uint8_t operator_;
+    std::uint32_t target;
+    std::uint32_t operand1;
+    std::uint32_t operand2;
+  };
+
+private:
+  Expression m_expression;
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<std::string> m_names;
+  std::vector<std::vector<std::string>> m_keys;
+  size_t m_registerCount;
+
+public:
+  explicit CompiledExpression(Expression expression);
+
+  const Expression& expression() const;
+  const std::vector<Instruction>& instructions() const;
+
+  /**
+   * Returns the names of the variables that this expression may read when it is
+   * evaluated. The result of evaluating this expression does not depend on any other
+   * variables.
+   */
+  const std::vector<std::string>& variableNames() const;
+
+  /**
+   * Evaluates this expression in the given context.
+   *
+   * @throws EL::Exception if the expression could not be evaluated
+   */
+  Value evaluate(const EvaluationContext& context) const;
+};
+} // namespace EL
+} // namespace TrenchBroom
@@ -43,8 +43,13 @@ class BinaryExpression;
 class SubscriptExpression;
 class SwitchExpression;
 
+class ExpressionCompiler;
+
 class Expression
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   std::shared_ptr<ExpressionImpl> m_expression;
   size_t m_line;
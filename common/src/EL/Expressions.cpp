@@ -425,6 +425,11 @@ static Value evaluateUnaryExpression(const UnaryOperator& operator_, const Value
   }
 }
 
+Value evaluateUnaryOperator(const UnaryOperator operator_, const Value& operand)
+{
+  return evaluateUnaryExpression(operator_, operand);
+}
+
 Value UnaryExpression::evaluate(const EvaluationContext& context) const
 {
   return evaluateUnaryExpression(m_operator, m_operand.evaluate(context));
@@ -1109,6 +1114,12 @@ static Value evaluateBinaryExpression(
   };
 }
 
+Value evaluateBinaryOperator(
+  const BinaryOperator operator_, const Value& lhs, const Value& rhs)
+{
+  return evaluateBinaryExpression(operator_, [&] { return lhs; }, [&] { return rhs; });
+}
+
 Value BinaryExpression::evaluate(const EvaluationContext& context) const
 {
   return evaluateBinaryExpression(
@@ -32,6 +32,8 @@ namespace TrenchBroom
 {
 namespace EL
 {
+class ExpressionCompiler;
+
 class ExpressionImpl
 {
 public:
@@ -62,6 +64,9 @@ private:
 
 class LiteralExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   Value m_value;
 
@@ -80,6 +85,9 @@ private:
 
 class VariableExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   std::string m_variableName;
 
@@ -98,6 +106,9 @@ private:
 
 class ArrayExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   std::vector<Expression> m_elements;
 
@@ -116,6 +127,9 @@ private:
 
 class MapExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   std::map<std::string, Expression> m_elements;
 
@@ -141,8 +155,18 @@ enum class UnaryOperator
   Group
 };
 
+/**
+ * Applies the given unary operator to the given operand.
+ *
+ * @throws EvaluationError if the operator cannot be applied to the operand
+ */
+Value evaluateUnaryOperator(UnaryOperator operator_, const Value& operand);
+
 class UnaryExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   UnaryOperator m_operator;
   Expression m_operand;
@@ -184,10 +208,21 @@ enum class BinaryOperator
   Case,
 };
 
+/**
+ * Applies the given binary operator to the given operands. Both operands must already
+ * have been evaluated, so the logical operators and the case operator do not short
+ * circuit.
+ *
+ * @throws EvaluationError if the operator cannot be applied to the operands
+ */
+Value evaluateBinaryOperator(
+  BinaryOperator operator_, const Value& lhs, const Value& rhs);
+
 class BinaryExpression : public ExpressionImpl
 {
 public:
   friend class Expression;
+  friend class ExpressionCompiler;
 
 private:
   BinaryOperator m_operator;
@@ -217,6 +252,8 @@ private:
 class SubscriptExpression : public ExpressionImpl
 {
 public:
+  friend class ExpressionCompiler;
+
   static const std::string& AutoRangeParameterName();
 
 private:
@@ -238,6 +275,9 @@ private:
 
 class SwitchExpression : public ExpressionImpl
 {
+public:
+  friend class ExpressionCompiler;
+
 private:
   std::vector<Expression> m_cases;
 
@@ -55,18 +55,24 @@ public:
 class Value
 {
 private:
+  /**
+   * Strings, arrays, maps and ranges are allocated on the heap and shared between copies
+   * of a value. Booleans, numbers, null and undefined are stored inline so that creating
+   * and copying them does not allocate.
+   */
+  using BoxedType = std::variant<StringType, ArrayType, MapType, RangeType>;
   using VariantType = std::variant<
     BooleanType,
-    StringType,
     NumberType,
-    ArrayType,
-    MapType,
-    RangeType,
     NullType,
-    UndefinedType>;
-  std::shared_ptr<VariantType> m_value;
+    UndefinedType,
+    std::shared_ptr<const BoxedType>>;
+  VariantType m_value;
   std::optional<Expression> m_expression;
 
+  template <typename Visitor>
+  decltype(auto) visit(const Visitor& visitor) const;
+
 public:
   static const Value Null;
   static const Value Undefined;
@@ -512,7 +512,7 @@ void AseParser::parseGeomObjectMeshTFace(
 }
 
 void AseParser::parseBlock(
-  const std::map<std::string, std::function<void(void)>>& handlers)
+  const std::map<std::string, std::function<void(void)>, std::less<>>& handlers)
 {
   expect(AseToken::OBrace, m_tokenizer.nextToken());
   auto token = m_tokenizer.peekToken();
@@ -590,13 +590,14 @@ void AseParser::skipDirective()
 void AseParser::expectArgumentName(const std::string& expected)
 {
   const auto token = expect(AseToken::ArgumentName, m_tokenizer.nextToken());
-  const auto& actual = token.data();
+  const auto actual = token.data();
   if (actual != expected)
   {
     throw ParserException{
       token.line(),
       token.column(),
-      "Expected argument name '" + expected + "', but got '" + actual + "'"};
+      "Expected argument name '" + expected + "', but got '" + std::string{actual}
+        + "'"};
   }
 }
 
@@ -623,7 +624,7 @@ size_t AseParser::parseSizeArgument()
     throw ParserException{
       token.line(),
       token.column(),
-      "Expected positive integer, but got '" + token.data() + "'"};
+      "Expected positive integer, but got '" + std::string{token.data()} + "'"};
   }
   else
   {
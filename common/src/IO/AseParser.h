@@ -167,7 +167,8 @@ private: // parsing
   void parseGeomObjectMeshTFaceList(Logger& logger, std::vector<MeshFace>& faces);
   void parseGeomObjectMeshTFace(Logger& logger, std::vector<MeshFace>& faces);
 
-  void parseBlock(const std::map<std::string, std::function<void(void)>>& handlers);
+  void parseBlock(
+    const std::map<std::string, std::function<void(void)>, std::less<>>& handlers);
 
   void expectDirective(const std::string& name);
   void skipDirective(const std::string& name);
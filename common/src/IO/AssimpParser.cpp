@@ -31,8 +31,6 @@
 #include "Logger.h"
 #include "Model/BrushFaceAttributes.h"
 #include "ReaderException.h"
-#include "Renderer/IndexRangeMapBuilder.h"
-#include "Renderer/PrimType.h"
 
 #include "kdl/result_fold.h"
 #include <kdl/path_utils.h>
@@ -47,6 +45,7 @@
 #include <assimp/scene.h>
 #include <fmt/format.h>
 
+#include <cstdint>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -307,7 +306,7 @@ struct AssimpComputedMeshData
 {
   size_t m_meshIndex;
   std::vector<Assets::EntityModelVertex> m_vertices;
-  Assets::EntityModelIndices m_indices;
+  std::vector<uint32_t> m_indices;
 };
 
 /**
@@ -469,22 +468,24 @@ Result<void> loadSceneFrame(
   {
     if (const auto meshIndex = getMeshIndex(scene, *mesh.m_mesh))
     {
-      const auto vertices =
+      auto vertices =
         computeMeshVertices(*mesh.m_mesh, mesh.m_transform, mesh.m_axisTransform);
+      if (vertices.empty())
+      {
+        continue;
+      }
 
       for (const auto& v : vertices)
       {
         bounds.add(v.attr);
       }
 
-      // build the mesh faces as triangles
+      // build the mesh faces as triangles that index the shared vertices, which assimp
+      // has deduplicated and ordered for the vertex cache
       const auto numTriangles = mesh.m_mesh->mNumFaces;
-      const auto numIndices = numTriangles * 3;
 
-      auto size = Renderer::IndexRangeMap::Size{};
-      size.inc(Renderer::PrimType::Triangles, numTriangles);
-      auto builder =
-        Renderer::IndexRangeMapBuilder<Assets::EntityModelVertex::Type>{numIndices, size};
+      auto indices = std::vector<uint32_t>{};
+      indices.reserve(numTriangles * 3);
 
       for (unsigned int i = 0; i < numTriangles; ++i)
       {
@@ -496,13 +497,12 @@ Result<void> loadSceneFrame(
           continue;
         }
 
-        builder.addTriangle(
-          vertices[face.mIndices[0]],
-          vertices[face.mIndices[1]],
-          vertices[face.mIndices[2]]);
+        indices.push_back(face.mIndices[0]);
+        indices.push_back(face.mIndices[1]);
+        indices.push_back(face.mIndices[2]);
       }
 
-      meshData.push_back({*meshIndex, builder.vertices(), builder.indices()});
+      meshData.push_back({*meshIndex, std::move(vertices), std::move(indices)});
     }
   }
 
@@ -516,10 +516,10 @@ Result<void> loadSceneFrame(
   const auto frameBounds = bounds.bounds();
   auto& frame = model.loadFrame(0, name, frameBounds);
 
-  for (const auto& data : meshData)
+  for (auto& data : meshData)
   {
     auto& surface = model.surface(data.m_meshIndex);
-    surface.addIndexedMesh(frame, data.m_vertices, data.m_indices);
+    surface.addElementMesh(frame, std::move(data.m_vertices), std::move(data.m_indices));
   }
 
   return Result<void>{};
@@ -559,6 +559,7 @@ std::unique_ptr<Assets::EntityModel> AssimpParser::doInitializeModel(
   TrenchBroom::Logger& logger)
 {
   constexpr auto assimpFlags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices
+                               | aiProcess_ImproveCacheLocality
                                | aiProcess_FlipWindingOrder | aiProcess_SortByPType
                                | aiProcess_FlipUVs;
 
@@ -64,11 +64,11 @@ static const size_t DirModelAddress = 0x74;
 
 static const size_t FaceSize = 0x14;
 static const size_t FaceEdgeIndex = 0x4;
-static const size_t FaceRest = 0x8;
 
 static const size_t TexInfoSize = 0x28;
-static const size_t TexInfoRest = 0x4;
 
+static const size_t VertexSize = 0xC;
+static const size_t EdgeSize = 0x4;
 static const size_t FaceEdgeSize = 0x4;
 static const size_t ModelSize = 0x40;
 // static const size_t ModelOrigin           = 0x18;
@@ -131,66 +131,13 @@ std::unique_ptr<Assets::EntityModel> Bsp29Parser::doInitializeModel(Logger& logg
 void Bsp29Parser::doLoadFrame(
   const size_t frameIndex, Assets::EntityModel& model, Logger& /* logger */)
 {
-  auto reader = m_reader;
-  const auto version = reader.readInt<int32_t>();
-  if (version != 29)
-  {
-    throw AssetException("Unsupported BSP model version: " + std::to_string(version));
-  }
-
-  reader.seekFromBegin(BspLayout::DirTexturesAddress);
-  /* const auto textureOffset = */ reader.readSize<int32_t>();
-  /* const auto textureLength = */ reader.readSize<int32_t>();
-
-  reader.seekFromBegin(BspLayout::DirTexInfosAddress);
-  const auto textureInfoOffset = reader.readSize<int32_t>();
-  const auto textureInfoLength = reader.readSize<int32_t>();
-  const auto textureInfoCount = textureInfoLength / BspLayout::TexInfoSize;
-
-  reader.seekFromBegin(BspLayout::DirVerticesAddress);
-  const auto vertexOffset = reader.readSize<int32_t>();
-  const auto vertexLength = reader.readSize<int32_t>();
-  const auto vertexCount = vertexLength / (3 * sizeof(float));
-
-  reader.seekFromBegin(BspLayout::DirEdgesAddress);
-  const auto edgeInfoOffset = reader.readSize<int32_t>();
-  const auto edgeInfoLength = reader.readSize<int32_t>();
-  const auto edgeInfoCount = edgeInfoLength / (2 * sizeof(uint16_t));
-
-  reader.seekFromBegin(BspLayout::DirFacesAddress);
-  const auto faceInfoOffset = reader.readSize<int32_t>();
-  const auto faceInfoLength = reader.readSize<int32_t>();
-  const auto faceInfoCount = faceInfoLength / BspLayout::FaceSize;
-
-  reader.seekFromBegin(BspLayout::DirFaceEdgesAddress);
-  const auto faceEdgesOffset = reader.readSize<int32_t>();
-  const auto faceEdgesLength = reader.readSize<int32_t>();
-  const auto faceEdgesCount = faceEdgesLength / BspLayout::FaceEdgeSize;
+  parseFrame(parseLumps(), frameIndex, model);
+}
 
-  reader.seekFromBegin(BspLayout::DirModelAddress);
-  const auto modelsOffset = reader.readSize<int32_t>();
-
-  const auto textureInfos =
-    parseTextureInfos(reader.subReaderFromBegin(textureInfoOffset), textureInfoCount);
-  const auto vertices =
-    parseVertices(reader.subReaderFromBegin(vertexOffset), vertexCount);
-  const auto edgeInfos =
-    parseEdgeInfos(reader.subReaderFromBegin(edgeInfoOffset), edgeInfoCount);
-  const auto faceInfos =
-    parseFaceInfos(reader.subReaderFromBegin(faceInfoOffset), faceInfoCount);
-  const auto faceEdges =
-    parseFaceEdges(reader.subReaderFromBegin(faceEdgesOffset), faceEdgesCount);
-
-  parseFrame(
-    reader.subReaderFromBegin(
-      modelsOffset + frameIndex * BspLayout::ModelSize, BspLayout::ModelSize),
-    frameIndex,
-    model,
-    textureInfos,
-    vertices,
-    edgeInfos,
-    faceInfos,
-    faceEdges);
+void Bsp29Parser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  loadFramesInParallel(frameIndices, model, logger);
 }
 
 std::vector<Assets::Texture> Bsp29Parser::parseTextures(Reader reader, Logger& logger)
@@ -210,7 +157,7 @@ std::vector<Assets::Texture> Bsp29Parser::parseTextures(Reader reader, Logger& l
     }
 
     const auto textureName = readMipTextureName(reader);
-    auto textureReader = reader.subReaderFromBegin(size_t(textureOffset)).buffer();
+    auto textureReader = reader.subReaderFromBegin(size_t(textureOffset));
 
     result.push_back(readIdMipTexture(textureName, textureReader, m_palette)
                        .or_else(makeReadTextureErrorHandler(m_fs, logger))
@@ -220,100 +167,106 @@ std::vector<Assets::Texture> Bsp29Parser::parseTextures(Reader reader, Logger& l
   return result;
 }
 
-Bsp29Parser::TextureInfoList Bsp29Parser::parseTextureInfos(
-  Reader reader, const size_t textureInfoCount)
-{
-  auto result = TextureInfoList(textureInfoCount);
-  for (size_t i = 0; i < textureInfoCount; ++i)
-  {
-    result[i].sAxis = reader.readVec<float, 3>();
-    result[i].sOffset = reader.readFloat<float>();
-    result[i].tAxis = reader.readVec<float, 3>();
-    result[i].tOffset = reader.readFloat<float>();
-    result[i].textureIndex = reader.readSize<uint32_t>();
-    reader.seekForward(BspLayout::TexInfoRest);
-  }
-  return result;
-}
-
-std::vector<vm::vec3f> Bsp29Parser::parseVertices(Reader reader, const size_t vertexCount)
-{
-  auto result = std::vector<vm::vec3f>(vertexCount);
-  for (size_t i = 0; i < vertexCount; ++i)
-  {
-    result[i] = reader.readVec<float, 3>();
-  }
-  return result;
-}
-
-Bsp29Parser::EdgeInfoList Bsp29Parser::parseEdgeInfos(
-  Reader reader, const size_t edgeInfoCount)
-{
-  auto result = EdgeInfoList(edgeInfoCount);
-  for (size_t i = 0; i < edgeInfoCount; ++i)
-  {
-    result[i].vertexIndex1 = reader.readSize<uint16_t>();
-    result[i].vertexIndex2 = reader.readSize<uint16_t>();
-  }
-  return result;
-}
-
-Bsp29Parser::FaceInfoList Bsp29Parser::parseFaceInfos(
-  Reader reader, const size_t faceInfoCount)
+Bsp29Parser::Lumps Bsp29Parser::parseLumps() const
 {
-  auto result = FaceInfoList(faceInfoCount);
-  for (size_t i = 0; i < faceInfoCount; ++i)
+  auto reader = m_reader;
+  const auto version = reader.readInt<int32_t>();
+  if (version != 29)
   {
-    reader.seekForward(BspLayout::FaceEdgeIndex);
-    result[i].edgeIndex = reader.readSize<int32_t>();
-    result[i].edgeCount = reader.readSize<uint16_t>();
-    result[i].textureInfoIndex = reader.readSize<uint16_t>();
-    reader.seekForward(BspLayout::FaceRest);
+    throw AssetException("Unsupported BSP model version: " + std::to_string(version));
   }
-  return result;
-}
 
-Bsp29Parser::FaceEdgeIndexList Bsp29Parser::parseFaceEdges(
-  Reader reader, const size_t faceEdgeCount)
-{
-  auto result = FaceEdgeIndexList(faceEdgeCount);
-  for (size_t i = 0; i < faceEdgeCount; ++i)
-  {
-    result[i] = reader.readInt<int32_t>();
-  }
-  return result;
+  const auto lump = [&](const size_t directoryAddress) {
+    reader.seekFromBegin(directoryAddress);
+    const auto offset = reader.readSize<int32_t>();
+    const auto length = reader.readSize<int32_t>();
+    return reader.subReaderFromBegin(offset, length);
+  };
+
+  return Lumps{
+    lump(BspLayout::DirTexInfosAddress),
+    lump(BspLayout::DirVerticesAddress),
+    lump(BspLayout::DirEdgesAddress),
+    lump(BspLayout::DirFacesAddress),
+    lump(BspLayout::DirFaceEdgesAddress),
+    lump(BspLayout::DirModelAddress),
+  };
 }
 
 void Bsp29Parser::parseFrame(
-  Reader reader,
-  const size_t frameIndex,
-  Assets::EntityModel& model,
-  const TextureInfoList& textureInfos,
-  const std::vector<vm::vec3f>& vertices,
-  const EdgeInfoList& edgeInfos,
-  const FaceInfoList& faceInfos,
-  const FaceEdgeIndexList& faceEdges)
+  Lumps lumps, const size_t frameIndex, Assets::EntityModel& model)
 {
   using Vertex = Assets::EntityModelVertex;
   using VertexList = std::vector<Vertex>;
 
   auto& surface = model.surface(0);
 
-  reader.seekForward(BspLayout::ModelFaceIndex);
-  const auto modelFaceIndex = reader.readSize<int32_t>();
-  const auto modelFaceCount = reader.readSize<int32_t>();
+  const auto readFaceInfo = [&](const size_t faceIndex) {
+    auto& reader = lumps.faces;
+    reader.seekFromBegin(faceIndex * BspLayout::FaceSize + BspLayout::FaceEdgeIndex);
+
+    auto faceInfo = FaceInfo{};
+    faceInfo.edgeIndex = reader.readSize<int32_t>();
+    faceInfo.edgeCount = reader.readSize<uint16_t>();
+    faceInfo.textureInfoIndex = reader.readSize<uint16_t>();
+    return faceInfo;
+  };
+
+  const auto readTextureInfo = [&](const size_t textureInfoIndex) {
+    auto& reader = lumps.textureInfos;
+    reader.seekFromBegin(textureInfoIndex * BspLayout::TexInfoSize);
+
+    auto textureInfo = TextureInfo{};
+    textureInfo.sAxis = reader.readVec<float, 3>();
+    textureInfo.sOffset = reader.readFloat<float>();
+    textureInfo.tAxis = reader.readVec<float, 3>();
+    textureInfo.tOffset = reader.readFloat<float>();
+    textureInfo.textureIndex = reader.readSize<uint32_t>();
+    return textureInfo;
+  };
+
+  const auto readVertex = [&](const size_t faceEdgeIndex) {
+    lumps.faceEdges.seekFromBegin(faceEdgeIndex * BspLayout::FaceEdgeSize);
+    const auto edgeIndex = lumps.faceEdges.readInt<int32_t>();
+
+    // a negative edge index means that the face uses the edge in reverse order
+    const auto vertexIndexAddress =
+      edgeIndex < 0 ? size_t(-edgeIndex) * BspLayout::EdgeSize + sizeof(uint16_t)
+                    : size_t(edgeIndex) * BspLayout::EdgeSize;
+    lumps.edges.seekFromBegin(vertexIndexAddress);
+    const auto vertexIndex = lumps.edges.readSize<uint16_t>();
+
+    lumps.vertices.seekFromBegin(vertexIndex * BspLayout::VertexSize);
+    return lumps.vertices.readVec<float, 3>();
+  };
+
+  lumps.models.seekFromBegin(
+    frameIndex * BspLayout::ModelSize + BspLayout::ModelFaceIndex);
+  const auto modelFaceIndex = lumps.models.readSize<int32_t>();
+  const auto modelFaceCount = lumps.models.readSize<int32_t>();
+
+  struct Face
+  {
+    FaceInfo faceInfo;
+    TextureInfo textureInfo;
+    const Assets::Texture* skin;
+  };
+
+  auto faces = std::vector<Face>{};
+  faces.reserve(modelFaceCount);
+
   auto totalVertexCount = size_t(0);
   auto size = Renderer::TexturedIndexRangeMap::Size{};
 
   for (size_t i = 0; i < modelFaceCount; ++i)
   {
-    const auto& faceInfo = faceInfos[modelFaceIndex + i];
-    const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
+    const auto faceInfo = readFaceInfo(modelFaceIndex + i);
+    const auto textureInfo = readTextureInfo(faceInfo.textureInfoIndex);
     if (const auto* skin = surface.skin(textureInfo.textureIndex))
     {
-      const auto faceVertexCount = faceInfo.edgeCount;
-      size.inc(skin, Renderer::PrimType::Polygon, faceVertexCount);
-      totalVertexCount += faceVertexCount;
+      size.inc(skin, Renderer::PrimType::Polygon, faceInfo.edgeCount);
+      totalVertexCount += faceInfo.edgeCount;
+      faces.push_back({faceInfo, textureInfo, skin});
     }
   }
 
@@ -321,34 +274,23 @@ void Bsp29Parser::parseFrame(
 
   auto builder =
     Renderer::TexturedIndexRangeMapBuilder<Vertex::Type>{totalVertexCount, size};
-  for (size_t i = 0; i < modelFaceCount; ++i)
+  auto faceVertices = VertexList{};
+  for (const auto& [faceInfo, textureInfo, skin] : faces)
   {
-    const auto& faceInfo = faceInfos[modelFaceIndex + i];
-    const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
-    if (const auto* skin = surface.skin(textureInfo.textureIndex))
-    {
-      const auto faceVertexCount = faceInfo.edgeCount;
-
-      auto faceVertices = VertexList{};
-      faceVertices.reserve(faceVertexCount);
-
-      for (size_t k = 0; k < faceVertexCount; ++k)
-      {
-        const auto faceEdgeIndex = faceEdges[faceInfo.edgeIndex + k];
-        const auto vertexIndex = faceEdgeIndex < 0
-                                   ? edgeInfos[size_t(-faceEdgeIndex)].vertexIndex2
-                                   : edgeInfos[size_t(faceEdgeIndex)].vertexIndex1;
+    faceVertices.clear();
+    faceVertices.reserve(faceInfo.edgeCount);
 
-        const auto& position = vertices[vertexIndex];
-        const auto texCoords = textureCoords(position, textureInfo, skin);
-
-        bounds.add(position);
+    for (size_t k = 0; k < faceInfo.edgeCount; ++k)
+    {
+      const auto position = readVertex(faceInfo.edgeIndex + k);
+      const auto texCoords = textureCoords(position, textureInfo, skin);
 
-        faceVertices.emplace_back(position, texCoords);
-      }
+      bounds.add(position);
 
-      builder.addPolygon(skin, faceVertices);
+      faceVertices.emplace_back(position, texCoords);
     }
+
+    builder.addPolygon(skin, faceVertices);
   }
 
   const auto frameName = fmt::format("{}_{}", m_name, frameIndex);
@@ -22,6 +22,7 @@
 #include "Assets/Palette.h"
 #include "Assets/TextureCollection.h"
 #include "IO/EntityModelParser.h"
+#include "IO/Reader.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
@@ -42,8 +43,14 @@ class Texture;
 namespace IO
 {
 class FileSystem;
-class Reader;
 
+/**
+ * Parses BSP 29 models. The submodels of the BSP file are the frames of the model, and
+ * they share the textures of the BSP file as their skins.
+ *
+ * Only the frames that are actually loaded are built. Their faces are read directly from
+ * the lumps of the BSP file, so the lumps are never decoded in full.
+ */
 class Bsp29Parser : public EntityModelParser
 {
 private:
@@ -55,13 +62,6 @@ private:
     float tOffset;
     size_t textureIndex;
   };
-  using TextureInfoList = std::vector<TextureInfo>;
-
-  struct EdgeInfo
-  {
-    size_t vertexIndex1, vertexIndex2;
-  };
-  using EdgeInfoList = std::vector<EdgeInfo>;
 
   struct FaceInfo
   {
@@ -69,9 +69,19 @@ private:
     size_t edgeCount;
     size_t textureInfoIndex;
   };
-  using FaceInfoList = std::vector<FaceInfo>;
 
-  using FaceEdgeIndexList = std::vector<int>;
+  /**
+   * Readers for the lumps that make up the faces of the submodels.
+   */
+  struct Lumps
+  {
+    Reader textureInfos;
+    Reader vertices;
+    Reader edges;
+    Reader faces;
+    Reader faceEdges;
+    Reader models;
+  };
 
   std::string m_name;
   const Reader& m_reader;
@@ -91,23 +101,15 @@ private:
   std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
   void doLoadFrame(
     size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+  void doLoadFrames(
+    const std::vector<size_t>& frameIndices,
+    Assets::EntityModel& model,
+    Logger& logger) override;
 
   std::vector<Assets::Texture> parseTextures(Reader reader, Logger& logger);
-  TextureInfoList parseTextureInfos(Reader reader, size_t textureInfoCount);
-  std::vector<vm::vec3f> parseVertices(Reader reader, size_t vertexCount);
-  EdgeInfoList parseEdgeInfos(Reader reader, size_t edgeInfoCount);
-  FaceInfoList parseFaceInfos(Reader reader, size_t faceInfoCount);
-  FaceEdgeIndexList parseFaceEdges(Reader reader, size_t faceEdgeCount);
-
-  void parseFrame(
-    Reader reader,
-    size_t frameIndex,
-    Assets::EntityModel& model,
-    const TextureInfoList& textureInfos,
-    const std::vector<vm::vec3f>& vertices,
-    const EdgeInfoList& edgeInfos,
-    const FaceInfoList& faceInfos,
-    const FaceEdgeIndexList& faceEdges);
+  Lumps parseLumps() const;
+
+  void parseFrame(Lumps lumps, size_t frameIndex, Assets::EntityModel& model);
   vm::vec2f textureCoords(
     const vm::vec3f& vertex,
     const TextureInfo& textureInfo,
@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+/**
+ * A parser status that records all log messages instead of passing them on immediately.
+ * The recorded messages can later be forwarded to the target status in the order in
+ * which they were logged.
+ *
+ * This is used when parsing on worker threads, where the target status must not be
+ * accessed concurrently. Progress reports are discarded. Repeated messages are limited
+ * like in the target status, but counted separately, and the summaries of suppressed
+ * messages are forwarded when flushing.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  ParserStatus& m_target;
+  std::vector<std::tuple<LogLevel, std::string>> m_messages;
+
+public:
+  explicit BufferedParserStatus(ParserStatus& target);
+
+  /**
+   * Forwards all recorded messages to the target status and clears them.
+   */
+  void flush();
+
+  /**
+   * Discards all recorded messages.
+   */
+  void clear();
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+} // namespace IO
+} // namespace TrenchBroom
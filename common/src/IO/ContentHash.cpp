@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ContentHash.h"
+
+#include <cstring>
+
+namespace TrenchBroom::IO
+{
+
+std::uint64_t hashContents(const std::string_view str)
+{
+  constexpr auto OffsetBasis = std::uint64_t(0xcbf29ce484222325);
+  constexpr auto Prime = std::uint64_t(0x100000001b3);
+
+  auto hash = OffsetBasis ^ std::uint64_t(str.size());
+  auto i = size_t(0);
+  for (; i + sizeof(std::uint64_t) <= str.size(); i += sizeof(std::uint64_t))
+  {
+    auto word = std::uint64_t(0);
+    std::memcpy(&word, str.data() + i, sizeof(std::uint64_t));
+    hash = (hash ^ word) * Prime;
+  }
+  for (; i < str.size(); ++i)
+  {
+    hash = (hash ^ std::uint64_t(static_cast<unsigned char>(str[i]))) * Prime;
+  }
+  return hash;
+}
+
+} // namespace TrenchBroom::IO
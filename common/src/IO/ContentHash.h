@@ -0,0 +1,35 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Computes a 64 bit FNV-1a style hash of the given string, processing eight bytes at a
+ * time to keep up with large files. The hash is stable across runs and platforms with the
+ * same byte order, so it can be stored in cache files.
+ */
+std::uint64_t hashContents(std::string_view str);
+
+} // namespace TrenchBroom::IO
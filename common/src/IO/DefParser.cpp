@@ -274,7 +274,8 @@ DefParser::PropertyDefinitionPtr DefParser::parseSpawnflags(ParserStatus& /* sta
   while (token.hasType(DefToken::Word | DefToken::Minus))
   {
     token = m_tokenizer.nextToken();
-    const auto name = token.hasType(DefToken::Word) ? token.data() : "";
+    const auto name =
+      token.hasType(DefToken::Word) ? std::string{token.data()} : std::string{};
     const auto value = 1 << numOptions++;
     definition->addOption(value, name, "", false);
     token = m_tokenizer.peekToken();
@@ -304,7 +305,7 @@ bool DefParser::parseProperty(ParserStatus& status, EntityDefinitionClassInfo& c
   const auto line = token.line();
   const auto column = token.column();
 
-  std::string typeName = token.data();
+  auto typeName = std::string{token.data()};
   if (typeName == "default")
   {
     // ignore these properties
@@ -339,10 +340,10 @@ void DefParser::parseDefaultProperty(ParserStatus& status)
   // Token token;
   expect(status, DefToken::OParenthesis, nextTokenIgnoringNewlines());
   expect(status, DefToken::QuotedString, nextTokenIgnoringNewlines());
-  // const std::string propertyName = token.data();
+  // const auto propertyName = std::string{token.data()};
   expect(status, DefToken::Comma, nextTokenIgnoringNewlines());
   expect(status, DefToken::QuotedString, nextTokenIgnoringNewlines());
-  // const std::string propertyValue = token.data();
+  // const auto propertyValue = std::string{token.data()};
   expect(status, DefToken::CParenthesis, nextTokenIgnoringNewlines());
 }
 
@@ -350,7 +351,7 @@ std::string DefParser::parseBaseProperty(ParserStatus& status)
 {
   expect(status, DefToken::OParenthesis, nextTokenIgnoringNewlines());
   Token token = expect(status, DefToken::QuotedString, nextTokenIgnoringNewlines());
-  const std::string basename = token.data();
+  const auto basename = std::string{token.data()};
   expect(status, DefToken::CParenthesis, nextTokenIgnoringNewlines());
 
   return basename;
@@ -360,7 +361,7 @@ DefParser::PropertyDefinitionPtr DefParser::parseChoicePropertyDefinition(
   ParserStatus& status)
 {
   Token token = expect(status, DefToken::QuotedString, m_tokenizer.nextToken());
-  const std::string propertyKey = token.data();
+  const auto propertyKey = std::string{token.data()};
 
   Assets::ChoicePropertyOption::List options;
   expect(status, DefToken::OParenthesis, nextTokenIgnoringNewlines());
@@ -368,11 +369,11 @@ DefParser::PropertyDefinitionPtr DefParser::parseChoicePropertyDefinition(
   while (token.type() == DefToken::OParenthesis)
   {
     token = expect(status, DefToken::Integer, nextTokenIgnoringNewlines());
-    const std::string name = token.data();
+    const auto name = std::string{token.data()};
 
     expect(status, DefToken::Comma, nextTokenIgnoringNewlines());
     token = expect(status, DefToken::QuotedString, nextTokenIgnoringNewlines());
-    const std::string value = token.data();
+    const auto value = std::string{token.data()};
     options.push_back(Assets::ChoicePropertyOption(name, value));
 
     expect(status, DefToken::CParenthesis, nextTokenIgnoringNewlines());
@@ -32,7 +32,9 @@
 #include <kdl/vector_utils.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
 
 namespace TrenchBroom::IO
 {
@@ -79,9 +81,175 @@ Result<std::vector<std::filesystem::path>> DiskFileSystem::doFind(
 Result<std::shared_ptr<File>> DiskFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  return makeAbsolute(path).and_then(Disk::openFile).transform([](auto cFile) {
-    return std::static_pointer_cast<File>(cFile);
-  });
+  return makeAbsolute(path).and_then(Disk::openFileForReading);
+}
+
+CachedDiskFileSystem::CachedDiskFileSystem(const std::filesystem::path& root)
+  : DiskFileSystem{root}
+{
+}
+
+PathInfo CachedDiskFileSystem::pathInfo(const std::filesystem::path& path) const
+{
+  if (path.is_absolute() || makeAbsolute(path).is_error())
+  {
+    return DiskFileSystem::pathInfo(path);
+  }
+
+  const auto lock = std::lock_guard{m_mutex};
+  const auto resolvedPath = resolve(path);
+  return resolvedPath ? resolvedPath->pathInfo : PathInfo::Unknown;
+}
+
+void CachedDiskFileSystem::refresh()
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_rootPathInfo = std::nullopt;
+  m_directories.clear();
+}
+
+Result<std::vector<std::filesystem::path>> CachedDiskFileSystem::doFind(
+  const std::filesystem::path& path, const TraversalMode traversalMode) const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  const auto resolvedPath = resolve(path);
+  if (!resolvedPath || resolvedPath->pathInfo != PathInfo::Directory)
+  {
+    return Error{"Failed to open '" + (m_root / path).string() + "'"};
+  }
+
+  auto result = std::vector<std::filesystem::path>{};
+  if (traversalMode == TraversalMode::Recursive)
+  {
+    findRecursively(resolvedPath->path, result);
+  }
+  else if (const auto* cachedDirectory = directory(resolvedPath->path))
+  {
+    for (const auto& entry : cachedDirectory->entries)
+    {
+      result.push_back(resolvedPath->path / entry.name);
+    }
+  }
+  return result;
+}
+
+Result<std::shared_ptr<File>> CachedDiskFileSystem::doOpenFile(
+  const std::filesystem::path& path) const
+{
+  auto resolvedPath = std::optional<ResolvedPath>{};
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    resolvedPath = resolve(path);
+  }
+
+  return resolvedPath && resolvedPath->pathInfo == PathInfo::File
+           ? Disk::openFileForReading(m_root / resolvedPath->path)
+           : DiskFileSystem::doOpenFile(path);
+}
+
+std::optional<CachedDiskFileSystem::ResolvedPath> CachedDiskFileSystem::resolve(
+  const std::filesystem::path& path) const
+{
+  if (!m_rootPathInfo)
+  {
+    m_rootPathInfo = Disk::pathInfo(m_root);
+  }
+
+  auto result = ResolvedPath{std::filesystem::path{}, *m_rootPathInfo};
+  if (result.pathInfo == PathInfo::Unknown)
+  {
+    return std::nullopt;
+  }
+
+  for (const auto& name : path.lexically_normal())
+  {
+    if (name.empty() || name == ".")
+    {
+      continue;
+    }
+
+    const auto* cachedDirectory =
+      result.pathInfo == PathInfo::Directory ? directory(result.path) : nullptr;
+    if (!cachedDirectory)
+    {
+      return std::nullopt;
+    }
+
+    // prefer an exact match, otherwise fix the case like Disk::fixPath does
+    const auto nameStr = name.string();
+    auto index = size_t(0);
+    if (const auto it = cachedDirectory->index.find(nameStr);
+        it != cachedDirectory->index.end())
+    {
+      index = it->second;
+    }
+    else if (const auto ciIt = cachedDirectory->caseInsensitiveIndex.find(nameStr);
+             ciIt != cachedDirectory->caseInsensitiveIndex.end())
+    {
+      index = ciIt->second;
+    }
+    else
+    {
+      return std::nullopt;
+    }
+
+    const auto& entry = cachedDirectory->entries[index];
+    result = ResolvedPath{result.path / entry.name, entry.pathInfo};
+  }
+
+  return result;
+}
+
+const CachedDiskFileSystem::CachedDirectory* CachedDiskFileSystem::directory(
+  const std::filesystem::path& path) const
+{
+  const auto key = path.generic_string();
+  auto it = m_directories.find(key);
+  if (it == m_directories.end())
+  {
+    auto cachedDirectory = std::optional<CachedDirectory>{};
+
+    auto error = std::error_code{};
+    auto iterator = std::filesystem::directory_iterator{m_root / path, error};
+    if (!error)
+    {
+      cachedDirectory = CachedDirectory{};
+      for (const auto& entry : iterator)
+      {
+        auto entryError = std::error_code{};
+        const auto pathInfo = entry.is_directory(entryError) ? PathInfo::Directory
+                              : entry.is_regular_file(entryError) ? PathInfo::File
+                                                                  : PathInfo::Unknown;
+
+        const auto index = cachedDirectory->entries.size();
+        auto name = entry.path().filename();
+        cachedDirectory->index.emplace(name.string(), index);
+        cachedDirectory->caseInsensitiveIndex.emplace(name.string(), index);
+        cachedDirectory->entries.push_back({std::move(name), pathInfo});
+      }
+    }
+
+    it = m_directories.emplace(key, std::move(cachedDirectory)).first;
+  }
+
+  return it->second ? &*it->second : nullptr;
+}
+
+void CachedDiskFileSystem::findRecursively(
+  const std::filesystem::path& path, std::vector<std::filesystem::path>& result) const
+{
+  if (const auto* cachedDirectory = directory(path))
+  {
+    for (const auto& entry : cachedDirectory->entries)
+    {
+      const auto entryPath = path / entry.name;
+      result.push_back(entryPath);
+      if (entry.pathInfo == PathInfo::Directory)
+      {
+        findRecursively(entryPath, result);
+      }
+    }
+  }
 }
 
 WritableDiskFileSystem::WritableDiskFileSystem(const std::filesystem::path& root)
@@ -22,9 +22,15 @@
 #include "IO/FileSystem.h"
 #include "Result.h"
 
+#include <kdl/string_compare.h>
+
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom::IO
 {
@@ -50,6 +56,78 @@ protected:
     const std::filesystem::path& path) const override;
 };
 
+/**
+ * A disk file system that remembers the contents of every directory it has listed, so
+ * that looking up paths, fixing their case and finding files does not go to the operating
+ * system again. This matters for slow disks such as network drives, where every query is
+ * a round trip to the server.
+ *
+ * Directories are listed on demand, so a recursive find caches the entire subtree it
+ * visits. Changes made on disk by other programs are only picked up after calling
+ * refresh(). The cache is thread safe.
+ */
+class CachedDiskFileSystem : public DiskFileSystem
+{
+private:
+  struct CachedEntry
+  {
+    std::filesystem::path name;
+    PathInfo pathInfo;
+  };
+
+  struct CachedDirectory
+  {
+    std::vector<CachedEntry> entries;
+    // maps entry names to entry indices, with and without considering case
+    std::unordered_map<std::string, size_t> index;
+    std::unordered_map<std::string, size_t, kdl::ci::string_hash, kdl::ci::string_equal>
+      caseInsensitiveIndex;
+  };
+
+  struct ResolvedPath
+  {
+    std::filesystem::path path;
+    PathInfo pathInfo;
+  };
+
+  mutable std::mutex m_mutex;
+  mutable std::optional<PathInfo> m_rootPathInfo;
+  // maps root relative directory paths with their case on disk to their contents
+  mutable std::unordered_map<std::string, std::optional<CachedDirectory>> m_directories;
+
+public:
+  explicit CachedDiskFileSystem(const std::filesystem::path& root);
+
+  PathInfo pathInfo(const std::filesystem::path& path) const override;
+
+  /**
+   * Discards all cached directory contents.
+   */
+  void refresh();
+
+protected:
+  Result<std::vector<std::filesystem::path>> doFind(
+    const std::filesystem::path& path, TraversalMode traversalMode) const override;
+  Result<std::shared_ptr<File>> doOpenFile(
+    const std::filesystem::path& path) const override;
+
+private:
+  /**
+   * Returns the given path with the case it has on disk and its path info, or
+   * std::nullopt if it does not exist. Must be called with the mutex held.
+   */
+  std::optional<ResolvedPath> resolve(const std::filesystem::path& path) const;
+
+  /**
+   * Returns the contents of the directory at the given root relative path, which must
+   * have the case it has on disk. Must be called with the mutex held.
+   */
+  const CachedDirectory* directory(const std::filesystem::path& path) const;
+
+  void findRecursively(
+    const std::filesystem::path& path, std::vector<std::filesystem::path>& result) const;
+};
+
 #ifdef _MSC_VER
 // MSVC complains about the fact that this class inherits some (pure virtual) method
 // declarations several times from different base classes, even though there is only one
@@ -151,6 +151,34 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
   return createCFile(fixedPath);
 }
 
+Result<std::shared_ptr<MappedFile>> mapFile(const std::filesystem::path& path)
+{
+  const auto fixedPath = fixPath(path);
+  if (pathInfo(fixedPath) != PathInfo::File)
+  {
+    return Error{
+      "Failed to open '" + fixedPath.string() + "': path does not denote a file"};
+  }
+
+  return createMappedFile(fixedPath);
+}
+
+Result<std::shared_ptr<File>> openFileForReading(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(fixPath(path), error);
+  if (!error && size >= MinMappedFileSize)
+  {
+    if (auto mappedFile = mapFile(path); mappedFile.is_success())
+    {
+      return std::move(mappedFile).value();
+    }
+  }
+
+  return openFile(path).transform(
+    [](auto cFile) { return std::static_pointer_cast<File>(cFile); });
+}
+
 Result<bool> createDirectory(const std::filesystem::path& path)
 {
   const auto fixedPath = fixPath(path);
@@ -26,6 +26,7 @@
 
 #include <kdl/result.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -36,10 +37,16 @@ namespace TrenchBroom::IO
 enum class TraversalMode;
 class CFile;
 class File;
+class MappedFile;
 enum class PathInfo;
 
 namespace Disk
 {
+/**
+ * The minimum size of files that openFileForReading maps into memory.
+ */
+constexpr auto MinMappedFileSize = std::uintmax_t(1024 * 1024);
+
 bool isCaseSensitive();
 
 std::filesystem::path fixPath(const std::filesystem::path& path);
@@ -53,6 +60,15 @@ Result<std::vector<std::filesystem::path>> find(
 
 Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
 
+Result<std::shared_ptr<MappedFile>> mapFile(const std::filesystem::path& path);
+
+/**
+ * Opens the file at the given path for reading. Files of at least MinMappedFileSize bytes
+ * are memory mapped so that their contents need not be copied into memory, smaller files
+ * (or files that cannot be mapped) are opened as a CFile.
+ */
+Result<std::shared_ptr<File>> openFileForReading(const std::filesystem::path& path);
+
 template <typename Stream, typename F>
 auto withStream(
   const std::filesystem::path& path, const std::ios::openmode mode, const F& function)
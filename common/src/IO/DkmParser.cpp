@@ -354,6 +354,12 @@ void DkmParser::doLoadFrame(
   buildFrame(model, surface, frameIndex, frame, meshes);
 }
 
+void DkmParser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  loadFramesInParallel(frameIndices, model, logger);
+}
+
 DkmParser::DkmSkinList DkmParser::parseSkins(Reader reader, const size_t skinCount)
 {
   DkmSkinList skins;
@@ -109,6 +109,10 @@ private:
   std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
   void doLoadFrame(
     size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+  void doLoadFrames(
+    const std::vector<size_t>& frameIndices,
+    Assets::EntityModel& model,
+    Logger& logger) override;
 
   DkmSkinList parseSkins(Reader reader, size_t skinCount);
   DkmFrame parseFrame(Reader reader, size_t frameIndex, size_t vertexCount, int version);
@@ -409,7 +409,7 @@ EL::Expression ELParser::parseVariable()
   Token token = m_tokenizer.nextToken();
   expect(ELToken::Name, token);
   return EL::Expression(
-    EL::VariableExpression(token.data()), token.line(), token.column());
+    EL::VariableExpression(std::string{token.data()}), token.line(), token.column());
 }
 
 EL::Expression ELParser::parseLiteral()
@@ -547,7 +547,7 @@ EL::Expression ELParser::parseMap()
     {
       token = m_tokenizer.nextToken();
       expect(ELToken::String | ELToken::Name, token);
-      std::string key = token.data();
+      auto key = std::string{token.data()};
 
       expect(ELToken::Colon, m_tokenizer.nextToken());
       elements.insert({std::move(key), parseExpression()});
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionCache.h"
+
+#include "IO/ContentHash.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+
+std::optional<std::uint64_t> hashFile(const std::filesystem::path& path)
+{
+  return Disk::openFile(path)
+    .transform([](auto file) -> std::optional<std::uint64_t> {
+      auto reader = file->reader().buffer();
+      return hashContents(reader.stringView());
+    })
+    .transform_error([](auto) -> std::optional<std::uint64_t> { return std::nullopt; })
+    .value();
+}
+
+} // namespace
+
+std::optional<std::vector<EntityDefinitionClassInfo>> EntityDefinitionCache::get(
+  const std::filesystem::path& path, const std::string_view contents) const
+{
+  const auto lock = std::lock_guard{m_mutex};
+
+  const auto it = m_entries.find(path);
+  if (it == m_entries.end())
+  {
+    return std::nullopt;
+  }
+
+  const auto& entry = it->second;
+  if (
+    entry.hash != hashContents(contents)
+    || !std::all_of(
+      entry.includedFiles.begin(),
+      entry.includedFiles.end(),
+      [](const auto& includedFile) {
+        return hashFile(includedFile.path) == includedFile.hash;
+      }))
+  {
+    return std::nullopt;
+  }
+
+  return entry.classInfos;
+}
+
+void EntityDefinitionCache::put(
+  const std::filesystem::path& path,
+  const std::string_view contents,
+  const std::vector<std::filesystem::path>& includedPaths,
+  std::vector<EntityDefinitionClassInfo> classInfos)
+{
+  auto includedFiles = kdl::vec_transform(includedPaths, [](const auto& includedPath) {
+    return IncludedFile{includedPath, hashFile(includedPath)};
+  });
+
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries[path] =
+    Entry{hashContents(contents), std::move(includedFiles), std::move(classInfos)};
+}
+
+void EntityDefinitionCache::clear()
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries.clear();
+}
+
+EntityDefinitionCache& entityDefinitionCache()
+{
+  static auto cache = EntityDefinitionCache{};
+  return cache;
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/EntityDefinitionClassInfo.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Keeps the resolved class infos of entity definition files in memory, so that loading
+ * an unchanged file again, e.g. when opening another map of the same game, does not parse
+ * it again.
+ *
+ * An entry is only used if the contents of the file and of every file it includes have
+ * the same hashes as when the entry was stored. Since a cached file is not parsed again,
+ * parser warnings are only reported the first time it is loaded.
+ */
+class EntityDefinitionCache
+{
+private:
+  struct IncludedFile
+  {
+    std::filesystem::path path;
+    // empty if the file could not be read
+    std::optional<std::uint64_t> hash;
+  };
+
+  struct Entry
+  {
+    std::uint64_t hash;
+    std::vector<IncludedFile> includedFiles;
+    std::vector<EntityDefinitionClassInfo> classInfos;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<std::filesystem::path, Entry> m_entries;
+
+public:
+  /**
+   * Returns the cached class infos of the file at the given path if they are up to date
+   * for the given file contents and the current contents of the included files.
+   */
+  std::optional<std::vector<EntityDefinitionClassInfo>> get(
+    const std::filesystem::path& path, std::string_view contents) const;
+
+  /**
+   * Stores the resolved class infos that were parsed from the given contents of the file
+   * at the given path. The given included paths must be absolute.
+   */
+  void put(
+    const std::filesystem::path& path,
+    std::string_view contents,
+    const std::vector<std::filesystem::path>& includedPaths,
+    std::vector<EntityDefinitionClassInfo> classInfos);
+
+  void clear();
+};
+
+/**
+ * Returns the cache that is shared by all games.
+ */
+EntityDefinitionCache& entityDefinitionCache();
+
+} // namespace TrenchBroom::IO
@@ -420,11 +420,11 @@ std::vector<EntityDefinitionClassInfo> resolveInheritance(
   return result;
 }
 
-std::unique_ptr<Assets::EntityDefinition> EntityDefinitionParser::createDefinition(
-  const EntityDefinitionClassInfo& classInfo) const
+static std::unique_ptr<Assets::EntityDefinition> createDefinition(
+  const EntityDefinitionClassInfo& classInfo, const Color& defaultEntityColor)
 {
   const auto& name = classInfo.name;
-  const auto color = classInfo.color.value_or(m_defaultEntityColor);
+  const auto color = classInfo.color.value_or(defaultEntityColor);
   const auto size = classInfo.size.value_or(DefaultSize);
   auto description = classInfo.description.value_or("");
   auto& attributes = classInfo.propertyDefinitions;
@@ -451,16 +451,14 @@ std::unique_ptr<Assets::EntityDefinition> EntityDefinitionParser::createDefiniti
   };
 }
 
-std::vector<Assets::EntityDefinition*> EntityDefinitionParser::createDefinitions(
-  ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const
+std::vector<Assets::EntityDefinition*> createEntityDefinitions(
+  const std::vector<EntityDefinitionClassInfo>& resolvedClassInfos,
+  const Color& defaultEntityColor)
 {
-  const auto resolvedClasses =
-    resolveInheritance(status, filterRedundantClasses(status, classInfos));
-
   std::vector<Assets::EntityDefinition*> result;
-  for (const auto& classInfo : resolvedClasses)
+  for (const auto& classInfo : resolvedClassInfos)
   {
-    if (auto definition = createDefinition(classInfo))
+    if (auto definition = createDefinition(classInfo, defaultEntityColor))
     {
       result.push_back(definition.release());
     }
@@ -472,8 +470,19 @@ std::vector<Assets::EntityDefinition*> EntityDefinitionParser::createDefinitions
 EntityDefinitionParser::EntityDefinitionList EntityDefinitionParser::parseDefinitions(
   ParserStatus& status)
 {
-  auto classInfos = parseClassInfos(status);
-  return createDefinitions(status, std::move(classInfos));
+  return createEntityDefinitions(parseResolvedClassInfos(status), m_defaultEntityColor);
+}
+
+std::vector<EntityDefinitionClassInfo> EntityDefinitionParser::parseResolvedClassInfos(
+  ParserStatus& status)
+{
+  const auto classInfos = parseClassInfos(status);
+  return resolveInheritance(status, filterRedundantClasses(status, classInfos));
+}
+
+std::vector<std::filesystem::path> EntityDefinitionParser::includedPaths() const
+{
+  return {};
 }
 } // namespace IO
 } // namespace TrenchBroom
@@ -21,6 +21,7 @@
 
 #include "Color.h"
 
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -43,6 +44,14 @@ class ParserStatus;
 std::vector<EntityDefinitionClassInfo> resolveInheritance(
   ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos);
 
+/**
+ * Creates entity definitions from class infos whose inheritance has been resolved. The
+ * given color is used for definitions that do not specify a color.
+ */
+std::vector<Assets::EntityDefinition*> createEntityDefinitions(
+  const std::vector<EntityDefinitionClassInfo>& resolvedClassInfos,
+  const Color& defaultEntityColor);
+
 class EntityDefinitionParser
 {
 private:
@@ -60,12 +69,18 @@ public:
 
   EntityDefinitionList parseDefinitions(ParserStatus& status);
 
-private:
-  std::unique_ptr<Assets::EntityDefinition> createDefinition(
-    const EntityDefinitionClassInfo& classInfo) const;
-  std::vector<Assets::EntityDefinition*> createDefinitions(
-    ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const;
+  /**
+   * Parses the class infos and resolves their inheritance. Base classes are not included
+   * in the result.
+   */
+  std::vector<EntityDefinitionClassInfo> parseResolvedClassInfos(ParserStatus& status);
 
+  /**
+   * Returns the paths of the files that were included while parsing.
+   */
+  virtual std::vector<std::filesystem::path> includedPaths() const;
+
+private:
   virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(
     ParserStatus& status) = 0;
 };
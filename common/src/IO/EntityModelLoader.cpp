@@ -39,7 +39,16 @@ void EntityModelLoader::loadFrame(
   Assets::EntityModel& model,
   Logger& logger) const
 {
-  return doLoadFrame(path, frameIndex, model, logger);
+  return doLoadFrames(path, {frameIndex}, model, logger);
+}
+
+void EntityModelLoader::loadFrames(
+  const std::filesystem::path& path,
+  const std::vector<size_t>& frameIndices,
+  Assets::EntityModel& model,
+  Logger& logger) const
+{
+  return doLoadFrames(path, frameIndices, model, logger);
 }
 } // namespace IO
 } // namespace TrenchBroom
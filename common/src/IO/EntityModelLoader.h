@@ -21,6 +21,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -45,13 +46,18 @@ public:
     size_t frameIndex,
     Assets::EntityModel& model,
     Logger& logger) const;
+  void loadFrames(
+    const std::filesystem::path& path,
+    const std::vector<size_t>& frameIndices,
+    Assets::EntityModel& model,
+    Logger& logger) const;
 
 private:
   virtual std::unique_ptr<Assets::EntityModel> doInitializeModel(
     const std::filesystem::path& path, Logger& logger) const = 0;
-  virtual void doLoadFrame(
+  virtual void doLoadFrames(
     const std::filesystem::path& path,
-    size_t frameIndex,
+    const std::vector<size_t>& frameIndices,
     Assets::EntityModel& model,
     Logger& logger) const = 0;
 };
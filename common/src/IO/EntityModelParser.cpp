@@ -21,6 +21,8 @@
 
 #include "Assets/EntityModel.h"
 
+#include <kdl/parallel.h>
+
 namespace TrenchBroom
 {
 namespace IO
@@ -38,9 +40,34 @@ void EntityModelParser::loadFrame(
   return doLoadFrame(frameIndex, model, logger);
 }
 
+void EntityModelParser::loadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  return doLoadFrames(frameIndices, model, logger);
+}
+
+void EntityModelParser::loadFramesInParallel(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  // frames are large units of work, so every frame is a chunk of its own
+  kdl::parallel_for(
+    frameIndices.size(),
+    [&](const auto i) { doLoadFrame(frameIndices[i], model, logger); },
+    1);
+}
+
 void EntityModelParser::doLoadFrame(
   const size_t /* frameIndex */, Assets::EntityModel& /* model */, Logger& /* logger */)
 {
 }
+
+void EntityModelParser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  for (const auto frameIndex : frameIndices)
+  {
+    doLoadFrame(frameIndex, model, logger);
+  }
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -39,10 +40,22 @@ public:
 
   std::unique_ptr<Assets::EntityModel> initializeModel(Logger& logger);
   void loadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger);
+  void loadFrames(
+    const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger);
+
+protected:
+  /**
+   * Loads the given frames concurrently. Only parsers whose doLoadFrame does not log and
+   * only modifies the data of the frame being loaded may use this.
+   */
+  void loadFramesInParallel(
+    const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger);
 
 private:
   virtual std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) = 0;
   virtual void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger);
+  virtual void doLoadFrames(
+    const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger);
 };
 } // namespace IO
 } // namespace TrenchBroom
@@ -172,6 +172,11 @@ FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor)
 
 FgdParser::~FgdParser() = default;
 
+std::vector<std::filesystem::path> FgdParser::includedPaths() const
+{
+  return m_includedPaths;
+}
+
 FgdParser::TokenNameMap FgdParser::tokenNames() const
 {
   using namespace FgdToken;
@@ -445,7 +450,7 @@ std::vector<std::string> FgdParser::parseSuperClasses(ParserStatus& status)
     do
     {
       token = expect(status, FgdToken::Word, m_tokenizer.nextToken());
-      superClasses.push_back(token.data());
+      superClasses.emplace_back(token.data());
       token =
         expect(status, FgdToken::Comma | FgdToken::CParenthesis, m_tokenizer.nextToken());
     } while (token.type() == FgdToken::Comma);
@@ -596,13 +601,13 @@ FgdParser::PropertyDefinitionList FgdParser::parsePropertyDefinitions(
 
   while (token.type() != FgdToken::CBracket)
   {
-    const auto propertyKey = token.data();
+    const auto propertyKey = std::string{token.data()};
     const auto line = token.line();
     const auto column = token.column();
 
     expect(status, FgdToken::OParenthesis, m_tokenizer.nextToken());
     token = expect(status, FgdToken::Word, m_tokenizer.nextToken());
-    const auto typeName = token.data();
+    const auto typeName = std::string{token.data()};
     expect(status, FgdToken::CParenthesis, m_tokenizer.nextToken());
 
     auto propertyDefinition =
@@ -747,7 +752,7 @@ FgdParser::PropertyDefinitionPtr FgdParser::parseChoicesPropertyDefinition(
   auto options = Assets::ChoicePropertyOption::List{};
   while (token.type() != FgdToken::CBracket)
   {
-    const auto value = token.data();
+    const auto value = std::string{token.data()};
     expect(status, FgdToken::Colon, m_tokenizer.nextToken());
     const auto caption = parseString(status);
 
@@ -862,14 +867,14 @@ std::optional<std::string> FgdParser::parseDefaultStringValue(ParserStatus& stat
     if (token.type() == FgdToken::String)
     {
       token = m_tokenizer.nextToken();
-      return token.data();
+      return std::string{token.data()};
     }
     if (token.type() == FgdToken::Integer || token.type() == FgdToken::Decimal)
     {
       token = m_tokenizer.nextToken();
       status.warn(
         token.line(), token.column(), "Found numeric default value for string property");
-      return token.data();
+      return std::string{token.data()};
     }
   }
   return std::nullopt;
@@ -941,7 +946,7 @@ std::optional<std::string> FgdParser::parseDefaultChoiceValue(ParserStatus& stat
     if (token.hasType(FgdToken::String | FgdToken::Integer | FgdToken::Decimal))
     {
       token = m_tokenizer.nextToken();
-      return token.data();
+      return std::string{token.data()};
     }
   }
   return std::nullopt;
@@ -1017,7 +1022,7 @@ std::string FgdParser::parseString(ParserStatus& status)
   }
   else
   {
-    return token.data();
+    return std::string{token.data()};
   }
 }
 
@@ -1050,6 +1055,13 @@ std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
     m_tokenizer.line(), fmt::format("Parsing included file '{}'", path.string()));
 
   const auto filePath = currentRoot() / path;
+
+  // also record files that cannot be opened since they might be created later
+  if (const auto absolutePath = m_fs->makeAbsolute(filePath); absolutePath.is_success())
+  {
+    m_includedPaths.push_back(absolutePath.value());
+  }
+
   return m_fs->openFile(filePath)
     .transform([&](auto file) {
       status.debug(
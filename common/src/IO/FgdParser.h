@@ -79,6 +79,7 @@ private:
   using Token = FgdTokenizer::Token;
 
   std::vector<std::filesystem::path> m_paths;
+  std::vector<std::filesystem::path> m_includedPaths;
   std::unique_ptr<FileSystem> m_fs;
 
   FgdTokenizer m_tokenizer;
@@ -92,6 +93,8 @@ public:
 
   ~FgdParser() override;
 
+  std::vector<std::filesystem::path> includedPaths() const override;
+
 private:
   class PushIncludePath;
   void pushIncludePath(std::filesystem::path path);
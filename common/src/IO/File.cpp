@@ -25,6 +25,22 @@
 #include <kdl/result.h>
 
 #include <cstdio> // for FILE
+#include <tuple>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace TrenchBroom::IO
 {
@@ -134,6 +150,151 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
   });
 }
 
+namespace
+{
+#ifdef _WIN32
+Result<std::tuple<const char*, size_t>> mapPath(const std::filesystem::path& path)
+{
+  auto* fileHandle = CreateFileW(
+    path.wstring().c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,
+    nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return Error{"Cannot open file " + path.string()};
+  }
+
+  auto fileSize = LARGE_INTEGER{};
+  if (!GetFileSizeEx(fileHandle, &fileSize))
+  {
+    CloseHandle(fileHandle);
+    return Error{"Cannot get size of file " + path.string()};
+  }
+
+  const auto size = static_cast<size_t>(fileSize.QuadPart);
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    CloseHandle(fileHandle);
+    return std::tuple<const char*, size_t>{nullptr, 0};
+  }
+
+  auto* mappingHandle =
+    CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(fileHandle);
+  if (!mappingHandle)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  // the view keeps the mapping alive, so we can close its handle right away
+  const auto* begin =
+    static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  CloseHandle(mappingHandle);
+  if (!begin)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  return std::tuple{begin, size};
+}
+
+void unmap(const char* begin, const size_t /* size */)
+{
+  if (begin)
+  {
+    UnmapViewOfFile(begin);
+  }
+}
+#else
+Result<std::tuple<const char*, size_t>> mapPath(const std::filesystem::path& path)
+{
+  const auto fd = open(path.u8string().c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return Error{"Cannot open file " + path.string()};
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0)
+  {
+    close(fd);
+    return Error{"Cannot get size of file " + path.string()};
+  }
+
+  const auto size = static_cast<size_t>(fileStat.st_size);
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    close(fd);
+    return std::tuple<const char*, size_t>{nullptr, 0};
+  }
+
+  // the mapping remains valid after the file descriptor is closed
+  auto* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  return std::tuple{static_cast<const char*>(addr), size};
+}
+
+void unmap(const char* begin, const size_t size)
+{
+  if (begin)
+  {
+    munmap(const_cast<char*>(begin), size);
+  }
+}
+#endif
+} // namespace
+
+MappedFile::MappedFile(const char* begin, const size_t size)
+  : m_begin{begin}
+  , m_size{size}
+{
+}
+
+MappedFile::~MappedFile()
+{
+  unmap(m_begin, m_size);
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(begin(), end());
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+const char* MappedFile::begin() const
+{
+  return m_begin;
+}
+
+const char* MappedFile::end() const
+{
+  return m_begin + m_size;
+}
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  return mapPath(path).transform([](const auto& beginAndSize) {
+    const auto [begin, size] = beginAndSize;
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{new MappedFile{begin, size}};
+  });
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
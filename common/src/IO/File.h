@@ -107,6 +107,48 @@ public:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a read only memory mapping of a physical file on the disk.
+ * Readers created for this file access the mapped memory directly, so buffering a reader
+ * does not copy the file contents. The file is mapped when it is created and unmapped in
+ * the destructor.
+ */
+class MappedFile : public File
+{
+private:
+  const char* m_begin;
+  size_t m_size;
+
+  /**
+   * Creates a new file for the given mapped memory region.
+   */
+  MappedFile(const char* begin, size_t size);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  ~MappedFile() override;
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Returns the beginning of the mapped memory region.
+   */
+  const char* begin() const;
+
+  /**
+   * Returns the end of the mapped memory region.
+   */
+  const char* end() const;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
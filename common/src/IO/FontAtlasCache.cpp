@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FontAtlasCache.h"
+
+#include "Error.h"
+#include "IO/ContentHash.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/PathInfo.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <kdl/result.h>
+
+#include <fstream>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr auto Magic = std::string_view{"TBFA"};
+constexpr auto Version = std::uint32_t(1);
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::optional<FontAtlas> readCachedAtlas(Reader& reader, const std::string_view key)
+{
+  if (reader.readString(Magic.size()) != Magic)
+  {
+    return std::nullopt;
+  }
+  if (reader.readUnsignedInt<std::uint32_t>() != Version)
+  {
+    return std::nullopt;
+  }
+  if (
+    reader.readSize<std::uint64_t>() != key.size()
+    || reader.readSize<std::uint64_t>() != hashContents(key))
+  {
+    return std::nullopt;
+  }
+
+  const auto textureSize = reader.readUnsignedInt<std::uint32_t>();
+  const auto lineHeight = reader.readInt<std::int32_t>();
+
+  const auto glyphCount = reader.readSize<std::uint32_t>();
+  if (glyphCount * 5 * sizeof(std::uint32_t) > reader.size() - reader.position())
+  {
+    return std::nullopt;
+  }
+
+  auto glyphs = std::vector<FontAtlasGlyph>{};
+  glyphs.reserve(glyphCount);
+  for (size_t i = 0; i < glyphCount; ++i)
+  {
+    const auto x = reader.readUnsignedInt<std::uint32_t>();
+    const auto y = reader.readUnsignedInt<std::uint32_t>();
+    const auto width = reader.readUnsignedInt<std::uint32_t>();
+    const auto height = reader.readUnsignedInt<std::uint32_t>();
+    const auto advance = reader.readUnsignedInt<std::uint32_t>();
+    glyphs.push_back({x, y, width, height, advance});
+  }
+
+  const auto textureDataSize = size_t(textureSize) * size_t(textureSize);
+  if (textureSize == 0 || textureDataSize != reader.size() - reader.position())
+  {
+    return std::nullopt;
+  }
+
+  auto texture = std::vector<unsigned char>(textureDataSize);
+  reader.read(reinterpret_cast<char*>(texture.data()), texture.size());
+  return FontAtlas{textureSize, lineHeight, std::move(glyphs), std::move(texture)};
+}
+
+} // namespace
+
+FontAtlasCache::FontAtlasCache(std::filesystem::path directory)
+  : m_directory{std::move(directory)}
+{
+}
+
+const std::filesystem::path& FontAtlasCache::directory() const
+{
+  return m_directory;
+}
+
+std::filesystem::path FontAtlasCache::cachePath(const std::string& atlasName) const
+{
+  return m_directory / (atlasName + ".tbfont");
+}
+
+std::optional<FontAtlas> FontAtlasCache::readAtlas(
+  const std::string& atlasName, const std::string_view key) const
+{
+  const auto path = cachePath(atlasName);
+  if (Disk::pathInfo(path) != PathInfo::File)
+  {
+    return std::nullopt;
+  }
+
+  return Disk::openFileForReading(path)
+    .transform([&](auto file) -> std::optional<FontAtlas> {
+      try
+      {
+        auto reader = file->reader();
+        return readCachedAtlas(reader, key);
+      }
+      catch (const ReaderException&)
+      {
+        return std::nullopt;
+      }
+    })
+    .value_or(std::nullopt);
+}
+
+Result<void> FontAtlasCache::writeAtlas(
+  const std::string& atlasName, const std::string_view key, const FontAtlas& atlas) const
+{
+  const auto path = cachePath(atlasName);
+  auto tempPath = path;
+  tempPath += ".tmp";
+
+  // write to a temporary file first so that no partially written file is ever read
+  return Disk::createDirectory(m_directory)
+    .and_then([&](auto) {
+      return Disk::withOutputStream(
+        tempPath, std::ios::out | std::ios::binary, [&](auto& stream) {
+          stream.write(Magic.data(), std::streamsize(Magic.size()));
+          write(stream, Version);
+          write(stream, std::uint64_t(key.size()));
+          write(stream, hashContents(key));
+          write(stream, atlas.textureSize);
+          write(stream, atlas.lineHeight);
+          write(stream, std::uint32_t(atlas.glyphs.size()));
+          for (const auto& glyph : atlas.glyphs)
+          {
+            write(stream, glyph.x);
+            write(stream, glyph.y);
+            write(stream, glyph.width);
+            write(stream, glyph.height);
+            write(stream, glyph.advance);
+          }
+          stream.write(
+            reinterpret_cast<const char*>(atlas.texture.data()),
+            std::streamsize(atlas.texture.size()));
+        });
+    })
+    .and_then([&]() { return Disk::moveFile(tempPath, path); });
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * The position, size and advance of a glyph in a font atlas, in pixels.
+ */
+struct FontAtlasGlyph
+{
+  std::uint32_t x;
+  std::uint32_t y;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint32_t advance;
+};
+
+/**
+ * The rasterized glyphs of a font, rendered into a square single channel texture.
+ */
+struct FontAtlas
+{
+  std::uint32_t textureSize;
+  std::int32_t lineHeight;
+  std::vector<FontAtlasGlyph> glyphs;
+  std::vector<unsigned char> texture;
+};
+
+/**
+ * A directory of rasterized fonts, so that fonts do not need to be rasterized again
+ * whenever they are requested by a new window or after the render font changed.
+ *
+ * Each atlas is stored in a file named after the font and its size, together with the
+ * size and a hash of a key that identifies the font file's contents and the rasterized
+ * characters. A cached atlas is only used if it was stored with the same key. Unreadable
+ * or outdated cache files are ignored and overwritten.
+ */
+class FontAtlasCache
+{
+private:
+  std::filesystem::path m_directory;
+
+public:
+  explicit FontAtlasCache(std::filesystem::path directory);
+
+  const std::filesystem::path& directory() const;
+
+  /**
+   * Returns the path of the cache file for the atlas with the given name.
+   */
+  std::filesystem::path cachePath(const std::string& atlasName) const;
+
+  /**
+   * Reads the cached atlas with the given name. Returns std::nullopt if there is no
+   * cached atlas or if it was stored with a different key.
+   */
+  std::optional<FontAtlas> readAtlas(
+    const std::string& atlasName, std::string_view key) const;
+
+  /**
+   * Writes the given atlas to the cache.
+   */
+  Result<void> writeAtlas(
+    const std::string& atlasName, std::string_view key, const FontAtlas& atlas) const;
+};
+
+} // namespace TrenchBroom::IO
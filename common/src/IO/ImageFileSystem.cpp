@@ -239,8 +239,33 @@ void doFindImpl(
       [](const ImageFileEntry&) {}),
     entry);
 }
+
+void forEachEntryImpl(
+  const ImageEntry& entry,
+  const std::filesystem::path& entryPath,
+  const std::function<void(const std::filesystem::path&, PathInfo)>& f)
+{
+  std::visit(
+    kdl::overload(
+      [&](const ImageDirectoryEntry& directoryEntry) {
+        for (const auto& childEntry : directoryEntry.entries)
+        {
+          const auto childPath = entryPath / getName(childEntry);
+          f(childPath, isDirectory(childEntry) ? PathInfo::Directory : PathInfo::File);
+          forEachEntryImpl(childEntry, childPath, f);
+        }
+      },
+      [](const ImageFileEntry&) {}),
+    entry);
+}
 } // namespace
 
+void ImageFileSystemBase::forEachEntry(
+  const std::function<void(const std::filesystem::path&, PathInfo)>& f) const
+{
+  forEachEntryImpl(m_root, std::filesystem::path{}, f);
+}
+
 Result<std::vector<std::filesystem::path>> ImageFileSystemBase::doFind(
   const std::filesystem::path& path, const TraversalMode traversalMode) const
 {
@@ -275,7 +300,7 @@ Result<std::shared_ptr<File>> ImageFileSystemBase::doOpenFile(
     Result<std::shared_ptr<File>>{Error{"'" + path.string() + "' not found"}});
 }
 
-ImageFileSystem::ImageFileSystem(std::shared_ptr<CFile> file)
+ImageFileSystem::ImageFileSystem(std::shared_ptr<File> file)
   : m_file{std::move(file)}
 {
   ensure(m_file, "file must not be null");
@@ -33,7 +33,6 @@
 
 namespace TrenchBroom::IO
 {
-class CFile;
 class File;
 
 using GetImageFile = std::function<Result<std::shared_ptr<File>>()>;
@@ -71,6 +70,13 @@ public:
    */
   Result<void> reload();
 
+  /**
+   * Calls the given function with the path and type of every file and directory in this
+   * file system. Directories are visited before their contents.
+   */
+  void forEachEntry(
+    const std::function<void(const std::filesystem::path&, PathInfo)>& f) const;
+
 protected:
   void addFile(const std::filesystem::path& path, GetImageFile getFile);
 
@@ -88,10 +94,10 @@ private:
 class ImageFileSystem : public ImageFileSystemBase
 {
 protected:
-  std::shared_ptr<CFile> m_file;
+  std::shared_ptr<File> m_file;
 
 public:
-  explicit ImageFileSystem(std::shared_ptr<CFile> file);
+  explicit ImageFileSystem(std::shared_ptr<File> file);
 };
 
 template <typename T, typename... Args>
@@ -141,7 +141,7 @@ EL::Expression LegacyModelDefinitionParser::parseStaticModelDefinition(
   const size_t startColumn = token.column();
 
   EL::MapType map;
-  map[Assets::ModelSpecificationKeys::Path] = EL::Value(token.data());
+  map[Assets::ModelSpecificationKeys::Path] = EL::Value(std::string{token.data()});
 
   std::vector<size_t> indices;
 
@@ -182,7 +182,7 @@ EL::Expression LegacyModelDefinitionParser::parseStaticModelDefinition(
   {
     token = m_tokenizer.nextToken();
 
-    std::string attributeKey = token.data();
+    auto attributeKey = std::string{token.data()};
     const size_t line = token.line();
     const size_t column = token.column();
     EL::Expression keyExpression =
@@ -193,7 +193,7 @@ EL::Expression LegacyModelDefinitionParser::parseStaticModelDefinition(
     expect(status, MdlToken::String | MdlToken::Integer, token = m_tokenizer.nextToken());
     if (token.hasType(MdlToken::String))
     {
-      std::string attributeValue = token.data();
+      auto attributeValue = std::string{token.data()};
       EL::Expression valueExpression = EL::Expression(
         EL::LiteralExpression(EL::Value(std::move(attributeValue))),
         token.line(),
@@ -271,8 +271,8 @@ EL::Expression LegacyModelDefinitionParser::parseDynamicModelDefinition(
       }
       else
       {
-        const std::string msg =
-          "Expected 'skinKey' or 'frameKey', but found '" + token.data() + "'";
+        const auto msg = "Expected 'skinKey' or 'frameKey', but found '"
+                         + std::string{token.data()} + "'";
         status.error(token.line(), token.column(), msg);
         throw ParserException(token.line(), token.column(), msg);
       }
@@ -295,12 +295,14 @@ EL::Expression LegacyModelDefinitionParser::parseNamedValue(
   const size_t column = token.column();
   if (!kdl::ci::str_is_equal(name, token.data()))
     throw ParserException(
-      line, column, "Expected '" + name + "', but got '" + token.data() + "'");
+      line,
+      column,
+      "Expected '" + name + "', but got '" + std::string{token.data()} + "'");
 
   expect(status, MdlToken::Equality, token = m_tokenizer.nextToken());
   expect(status, MdlToken::String, token = m_tokenizer.nextToken());
 
-  return EL::Expression(EL::VariableExpression(token.data()), line, column);
+  return EL::Expression(EL::VariableExpression(std::string{token.data()}), line, column);
 }
 
 LegacyModelDefinitionParser::TokenNameMap LegacyModelDefinitionParser::tokenNames() const
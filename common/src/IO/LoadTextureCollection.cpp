@@ -35,6 +35,7 @@
 #include "IO/ReadQuake3ShaderTexture.h"
 #include "IO/ReadWalTexture.h"
 #include "IO/ResourceUtils.h"
+#include "IO/TextureCache.h"
 #include "IO/TextureUtils.h"
 #include "IO/TraversalMode.h"
 #include "Logger.h"
@@ -42,14 +43,20 @@
 
 #include "kdl/result_fold.h"
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/path_utils.h>
 #include <kdl/result.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -58,10 +65,10 @@ namespace TrenchBroom::IO
 namespace
 {
 bool shouldExclude(
-  const std::string& textureName, const std::vector<std::string>& patterns)
+  const std::string& textureName, const std::vector<kdl::ci::glob_matcher>& patterns)
 {
   return std::any_of(patterns.begin(), patterns.end(), [&](const auto& pattern) {
-    return kdl::ci::str_matches_glob(textureName, pattern);
+    return pattern.matches(textureName);
   });
 }
 
@@ -79,14 +86,16 @@ Result<Assets::Palette> loadPalette(
 }
 
 using ReadTextureFunc = std::function<Result<Assets::Texture, ReadTextureError>(
-  const File&, const std::filesystem::path&)>;
+  const File&, BufferedReader, const std::filesystem::path&)>;
 
 Result<Assets::Texture, ReadTextureError> readTexture(
   const File& file,
+  BufferedReader reader,
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const size_t prefixLength,
-  const std::optional<Assets::Palette>& palette)
+  const std::optional<Assets::Palette>& palette,
+  const TextureCache* textureCache)
 {
   const auto extension = kdl::str_to_lower(path.extension().string());
   if (extension == ".d")
@@ -96,44 +105,53 @@ Result<Assets::Texture, ReadTextureError> readTexture(
     {
       return ReadTextureError{std::move(name), "Could not load texture: missing palette"};
     }
-    auto reader = file.reader().buffer();
     return readIdMipTexture(std::move(name), reader, *palette);
   }
   else if (extension == ".c")
   {
     auto name = path.stem().string();
-    auto reader = file.reader().buffer();
     return readHlMipTexture(std::move(name), reader);
   }
   else if (extension == ".wal")
   {
     auto name = getTextureNameFromPathSuffix(path, prefixLength);
-    auto reader = file.reader().buffer();
     return readWalTexture(std::move(name), reader, palette);
   }
   else if (extension == ".m8")
   {
     auto name = getTextureNameFromPathSuffix(path, prefixLength);
-    auto reader = file.reader().buffer();
     return readM8Texture(std::move(name), reader);
   }
   else if (extension == ".dds")
   {
     auto name = getTextureNameFromPathSuffix(path, prefixLength);
-    auto reader = file.reader().buffer();
     return readDdsTexture(std::move(name), reader);
   }
   else if (extension.empty())
   {
     auto name = getTextureNameFromPathSuffix(path, prefixLength);
-    auto reader = file.reader().buffer();
     return readQuake3ShaderTexture(std::move(name), file, gameFS);
   }
   else if (isSupportedFreeImageExtension(extension))
   {
     auto name = getTextureNameFromPathSuffix(path, prefixLength);
-    auto reader = file.reader().buffer();
-    return readFreeImageTexture(std::move(name), reader);
+    if (!textureCache)
+    {
+      return readFreeImageTexture(std::move(name), reader);
+    }
+
+    const auto contents = reader.stringView();
+    if (auto texture = textureCache->readTexture(name, path, contents))
+    {
+      return std::move(*texture);
+    }
+    return readFreeImageTexture(std::move(name), reader).transform([&](auto texture) {
+      // the cache is optional, so failing to write to it is not an error
+      textureCache->writeTexture(texture, path, contents).or_else([](auto) {
+        return kdl::void_success;
+      });
+      return texture;
+    });
   }
 
   auto name = getTextureNameFromPathSuffix(path, prefixLength);
@@ -141,8 +159,19 @@ Result<Assets::Texture, ReadTextureError> readTexture(
     std::move(name), "Unknown texture file extension: " + path.extension().string()};
 }
 
+/**
+ * Quake 3 shader textures load their images from the game file system, so they cannot be
+ * read concurrently.
+ */
+bool readsFromFileSystem(const std::filesystem::path& path)
+{
+  return path.extension().empty();
+}
+
 Result<ReadTextureFunc> makeReadTextureFunc(
-  const FileSystem& gameFS, const Model::TextureConfig& textureConfig)
+  const FileSystem& gameFS,
+  const Model::TextureConfig& textureConfig,
+  const TextureCache* textureCache)
 {
   return loadPalette(gameFS, textureConfig)
     .transform([](auto palette) { return std::optional{std::move(palette)}; })
@@ -151,8 +180,11 @@ Result<ReadTextureFunc> makeReadTextureFunc(
       return [&,
               palette = std::move(palette),
               prefixLength = kdl::path_length(textureConfig.root)](
-               const File& file, const std::filesystem::path& path) {
-        return readTexture(file, path, gameFS, prefixLength, palette);
+               const File& file,
+               BufferedReader reader,
+               const std::filesystem::path& path) {
+        return readTexture(
+          file, std::move(reader), path, gameFS, prefixLength, palette, textureCache);
       };
     });
 }
@@ -177,7 +209,10 @@ Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger& logger)
+  Logger& logger,
+  const TextureCache* textureCache,
+  const bool compressTextures,
+  const bool generateMipmaps)
 {
   if (gameFS.pathInfo(path) != PathInfo::Directory)
   {
@@ -188,36 +223,125 @@ Result<Assets::TextureCollection> loadTextureCollection(
   const auto pathMatcher = !textureConfig.extensions.empty()
                              ? makeExtensionPathMatcher(textureConfig.extensions)
                              : matchAnyPath;
+  const auto excludes =
+    kdl::vec_transform(textureConfig.excludes, [](const auto& pattern) {
+      return kdl::ci::glob_matcher{pattern};
+    });
 
-  return makeReadTextureFunc(gameFS, textureConfig)
+  return makeReadTextureFunc(gameFS, textureConfig, textureCache)
     .join(
       gameFS.find(path, TraversalMode::Flat, pathMatcher)
         .transform([&](auto texturePaths) {
           return kdl::vec_filter(std::move(texturePaths), [&](const auto& texturePath) {
-            return !shouldExclude(texturePath.stem().string(), textureConfig.excludes);
+            return !shouldExclude(texturePath.stem().string(), excludes);
           });
         }))
     .and_then([&](const auto& readTexture, auto texturePaths) {
-      return kdl::fold_results(
-               kdl::vec_transform(
-                 texturePaths,
-                 [&](const auto& texturePath) {
-                   return gameFS.openFile(texturePath)
-                     .and_then([&](auto file) { return readTexture(*file, texturePath); })
-                     .or_else(makeReadTextureErrorHandler(gameFS, logger))
-                     .transform([&](auto texture) {
-                       gameFS.makeAbsolute(texturePath)
-                         .transform([&](auto absPath) {
-                           texture.setAbsolutePath(std::move(absPath));
-                         })
-                         .or_else([](auto) { return kdl::void_success; });
-                       texture.setRelativePath(texturePath);
-                       return texture;
-                     });
-                 }))
-        .transform([&](auto textures) {
-          return Assets::TextureCollection{path, std::move(textures)};
-        });
+      // the file system must not be accessed concurrently, so the texture files are
+      // opened and buffered serially on one thread; each texture is decoded as soon as its
+      // file is buffered, so that reading the files overlaps with decoding them
+      using OpenedFile = std::tuple<std::shared_ptr<File>, BufferedReader>;
+      auto files = std::vector<std::optional<Result<OpenedFile>>>(texturePaths.size());
+
+      auto mutex = std::mutex{};
+      auto fileOpened = std::condition_variable{};
+      auto openedFileCount = size_t(0);
+
+      auto openFiles = std::async(std::launch::async, [&]() {
+        for (size_t i = 0; i < texturePaths.size(); ++i)
+        {
+          auto file = [&]() -> Result<OpenedFile> {
+            try
+            {
+              return gameFS.openFile(texturePaths[i]).transform([](auto file_) {
+                auto reader = file_->reader().buffer();
+                return OpenedFile{std::move(file_), std::move(reader)};
+              });
+            }
+            catch (const std::exception& e)
+            {
+              // the decoding threads wait for every file, so this must not throw
+              return Error{e.what()};
+            }
+          }();
+
+          {
+            const auto lock = std::lock_guard{mutex};
+            files[i] = std::move(file);
+            ++openedFileCount;
+          }
+          fileOpened.notify_all();
+        }
+      });
+
+      const auto waitForFile = [&](const size_t i) -> const Result<OpenedFile>& {
+        auto lock = std::unique_lock{mutex};
+        fileOpened.wait(lock, [&]() { return openedFileCount > i; });
+        return *files[i];
+      };
+
+      auto decodedTextures =
+        std::vector<std::optional<Result<Assets::Texture, ReadTextureError>>>(
+          texturePaths.size());
+      const auto decodeTexture = [&](const size_t i) {
+        const auto& file = waitForFile(i);
+        if (file.is_success())
+        {
+          const auto& [file_, reader] = file.value();
+          decodedTextures[i] =
+            readTexture(*file_, reader, texturePaths[i]).transform([&](auto texture) {
+              if (compressTextures)
+              {
+                texture.compress();
+              }
+              if (generateMipmaps)
+              {
+                texture.discardMipmaps();
+              }
+              return texture;
+            });
+        }
+      };
+
+      kdl::parallel_for(texturePaths.size(), [&](const auto i) {
+        if (!readsFromFileSystem(texturePaths[i]))
+        {
+          decodeTexture(i);
+        }
+      });
+
+      // the remaining textures read from the file system, so all files must be open
+      openFiles.wait();
+      for (size_t i = 0; i < texturePaths.size(); ++i)
+      {
+        if (readsFromFileSystem(texturePaths[i]))
+        {
+          decodeTexture(i);
+        }
+      }
+
+      auto textures = std::vector<Result<Assets::Texture>>{};
+      textures.reserve(texturePaths.size());
+      for (size_t i = 0; i < texturePaths.size(); ++i)
+      {
+        const auto& texturePath = texturePaths[i];
+        textures.push_back(
+          std::move(*files[i])
+            .and_then([&](auto) { return std::move(*decodedTextures[i]); })
+            .or_else(makeReadTextureErrorHandler(gameFS, logger))
+            .transform([&](auto texture) {
+              gameFS.makeAbsolute(texturePath)
+                .transform(
+                  [&](auto absPath) { texture.setAbsolutePath(std::move(absPath)); })
+                .or_else([](auto) { return kdl::void_success; });
+              texture.setRelativePath(texturePath);
+              return texture;
+            }));
+      }
+
+      return kdl::fold_results(std::move(textures)).transform([&](auto textures_) {
+        return Assets::TextureCollection{path, std::move(textures_)};
+      });
     });
 }
 
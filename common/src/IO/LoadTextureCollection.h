@@ -44,14 +44,30 @@ struct TextureConfig;
 namespace TrenchBroom::IO
 {
 class FileSystem;
+class TextureCache;
 
 Result<std::vector<std::filesystem::path>> findTextureCollections(
   const FileSystem& gameFS, const Model::TextureConfig& textureConfig);
 
+/**
+ * Loads the textures in the given directory of the given file system.
+ *
+ * If a texture cache is given, textures stored in image formats decoded by FreeImage are
+ * read from the cache if possible, and written to it otherwise.
+ *
+ * If compressTextures is true, large RGBA textures are transcoded to an S3TC compressed
+ * format while they are decoded.
+ *
+ * If generateMipmaps is true, only the first mip level of uncompressed textures is kept
+ * and the remaining levels are generated by the driver when the textures are uploaded.
+ */
 Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger& logger);
+  Logger& logger,
+  const TextureCache* textureCache = nullptr,
+  bool compressTextures = false,
+  bool generateMipmaps = false);
 
 } // namespace TrenchBroom::IO
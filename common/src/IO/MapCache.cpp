@@ -0,0 +1,406 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Error.h"
+#include "IO/ContentHash.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "Model/Brush.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
+#include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+constexpr auto Magic = std::string_view{"TBMC"};
+constexpr auto Version = std::uint32_t(1);
+
+std::optional<CachedBrushGeometry> cacheBrushGeometry(const Model::BrushNode& brushNode)
+{
+  const auto& brush = brushNode.brush();
+
+  auto result = CachedBrushGeometry{brushNode.lineNumber(), {}, {}};
+  result.vertices.reserve(brush.vertexCount());
+
+  auto vertexIndices = std::unordered_map<const Model::BrushVertex*, size_t>{};
+  for (const auto* vertex : brush.vertices())
+  {
+    vertexIndices.emplace(vertex, result.vertices.size());
+    result.vertices.push_back(vertex->position());
+  }
+
+  result.faces.reserve(brush.faceCount());
+  for (const auto& face : brush.faces())
+  {
+    const auto* faceGeometry = face.geometry();
+    if (!faceGeometry)
+    {
+      return std::nullopt;
+    }
+
+    auto& cachedFace = result.faces.emplace_back(
+      CachedBrushGeometry::Face{face.points(), faceGeometry->plane(), {}});
+    for (const auto* halfEdge : faceGeometry->boundary())
+    {
+      cachedFace.vertexIndices.push_back(vertexIndices.at(halfEdge->origin()));
+    }
+  }
+
+  return result;
+}
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::ostream& stream, const size_t value)
+{
+  write(stream, std::uint64_t(value));
+}
+
+void writeVec(std::ostream& stream, const vm::vec3& vec)
+{
+  write(stream, vec.x());
+  write(stream, vec.y());
+  write(stream, vec.z());
+}
+
+void writeBounds(std::ostream& stream, const vm::bbox3& bounds)
+{
+  writeVec(stream, bounds.min);
+  writeVec(stream, bounds.max);
+}
+
+void writeBrushGeometry(std::ostream& stream, const CachedBrushGeometry& brushGeometry)
+{
+  writeSize(stream, brushGeometry.lineNumber);
+
+  writeSize(stream, brushGeometry.vertices.size());
+  for (const auto& vertex : brushGeometry.vertices)
+  {
+    writeVec(stream, vertex);
+  }
+
+  writeSize(stream, brushGeometry.faces.size());
+  for (const auto& face : brushGeometry.faces)
+  {
+    for (const auto& point : face.points)
+    {
+      writeVec(stream, point);
+    }
+    writeVec(stream, face.plane.normal);
+    write(stream, face.plane.distance);
+
+    writeSize(stream, face.vertexIndices.size());
+    for (const auto index : face.vertexIndices)
+    {
+      writeSize(stream, index);
+    }
+  }
+}
+
+/**
+ * Reads a size and checks that the remaining input can hold that many elements of the
+ * given size, so that a damaged file cannot cause huge allocations.
+ */
+size_t readCount(Reader& reader, const size_t elementSize)
+{
+  const auto count = reader.readSize<std::uint64_t>();
+  if (count > (reader.size() - reader.position()) / elementSize)
+  {
+    throw ReaderException{"Invalid element count"};
+  }
+  return count;
+}
+
+vm::vec3 readVec(Reader& reader)
+{
+  return reader.readVec<double, 3>();
+}
+
+vm::bbox3 readBounds(Reader& reader)
+{
+  const auto min = readVec(reader);
+  const auto max = readVec(reader);
+  return vm::bbox3{min, max};
+}
+
+CachedBrushGeometry readBrushGeometry(Reader& reader)
+{
+  auto result = CachedBrushGeometry{reader.readSize<std::uint64_t>(), {}, {}};
+
+  const auto vertexCount = readCount(reader, 3 * sizeof(double));
+  result.vertices.reserve(vertexCount);
+  for (size_t i = 0; i < vertexCount; ++i)
+  {
+    result.vertices.push_back(readVec(reader));
+  }
+
+  const auto faceCount = readCount(reader, 13 * sizeof(double));
+  result.faces.reserve(faceCount);
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    auto& face = result.faces.emplace_back();
+    for (auto& point : face.points)
+    {
+      point = readVec(reader);
+    }
+    face.plane.normal = readVec(reader);
+    face.plane.distance = reader.readDouble<double>();
+
+    const auto indexCount = readCount(reader, sizeof(std::uint64_t));
+    face.vertexIndices.reserve(indexCount);
+    for (size_t j = 0; j < indexCount; ++j)
+    {
+      face.vertexIndices.push_back(reader.readSize<std::uint64_t>());
+    }
+  }
+
+  return result;
+}
+
+Result<MapCache> readMapCache(
+  Reader& reader, const std::uint64_t mapFileHash, const vm::bbox3& worldBounds)
+{
+  if (reader.readString(Magic.size()) != Magic)
+  {
+    return Error{"Unknown map cache format"};
+  }
+  if (reader.readUnsignedInt<std::uint32_t>() != Version)
+  {
+    return Error{"Unsupported map cache version"};
+  }
+  if (reader.readSize<std::uint64_t>() != mapFileHash)
+  {
+    return Error{"Map cache is outdated"};
+  }
+  if (readBounds(reader) != worldBounds)
+  {
+    return Error{"Map cache was created for different world bounds"};
+  }
+
+  const auto mapFormat = static_cast<Model::MapFormat>(reader.readInt<std::int32_t>());
+
+  const auto brushCount = readCount(reader, 3 * sizeof(std::uint64_t));
+  auto brushGeometries = std::vector<CachedBrushGeometry>{};
+  brushGeometries.reserve(brushCount);
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    brushGeometries.push_back(readBrushGeometry(reader));
+  }
+
+  return MapCache{mapFormat, std::move(brushGeometries)};
+}
+
+} // namespace
+
+MapCache::MapCache(
+  const Model::MapFormat mapFormat, std::vector<CachedBrushGeometry> brushGeometries)
+  : m_mapFormat{mapFormat}
+  , m_brushGeometries{std::move(brushGeometries)}
+{
+  std::sort(
+    m_brushGeometries.begin(),
+    m_brushGeometries.end(),
+    [](const auto& lhs, const auto& rhs) { return lhs.lineNumber < rhs.lineNumber; });
+}
+
+MapCache MapCache::create(const Model::WorldNode& world)
+{
+  auto brushGeometries = std::vector<CachedBrushGeometry>{};
+
+  world.accept(kdl::overload(
+    [](auto&& thisLambda, const Model::WorldNode* worldNode) {
+      worldNode->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, const Model::LayerNode* layerNode) {
+      layerNode->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, const Model::GroupNode* groupNode) {
+      groupNode->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, const Model::EntityNode* entityNode) {
+      entityNode->visitChildren(thisLambda);
+    },
+    [&](const Model::BrushNode* brushNode) {
+      if (auto brushGeometry = cacheBrushGeometry(*brushNode))
+      {
+        brushGeometries.push_back(std::move(*brushGeometry));
+      }
+    },
+    [](const Model::PatchNode*) {}));
+
+  auto result = MapCache{world.mapFormat(), std::move(brushGeometries)};
+
+  // several brushes on the same line cannot be told apart, so they are not cached
+  auto& geometries = result.m_brushGeometries;
+  auto duplicateLines = std::vector<size_t>{};
+  for (size_t i = 1; i < geometries.size(); ++i)
+  {
+    if (geometries[i - 1].lineNumber == geometries[i].lineNumber)
+    {
+      duplicateLines.push_back(geometries[i].lineNumber);
+    }
+  }
+  kdl::vec_erase_if(geometries, [&](const auto& brushGeometry) {
+    return std::binary_search(
+      duplicateLines.begin(), duplicateLines.end(), brushGeometry.lineNumber);
+  });
+
+  return result;
+}
+
+Model::MapFormat MapCache::mapFormat() const
+{
+  return m_mapFormat;
+}
+
+const std::vector<CachedBrushGeometry>& MapCache::brushGeometries() const
+{
+  return m_brushGeometries;
+}
+
+std::optional<Model::Brush> MapCache::createBrush(
+  const size_t lineNumber, std::vector<Model::BrushFace>& faces) const
+{
+  const auto it = std::lower_bound(
+    m_brushGeometries.begin(),
+    m_brushGeometries.end(),
+    lineNumber,
+    [](const auto& brushGeometry, const auto l) { return brushGeometry.lineNumber < l; });
+  if (it == m_brushGeometries.end() || it->lineNumber != lineNumber)
+  {
+    return std::nullopt;
+  }
+
+  const auto& brushGeometry = *it;
+
+  // find the brush face for each geometry face, faces that were dropped when the brush
+  // geometry was computed have no geometry face
+  auto faceIndices = std::vector<size_t>{};
+  faceIndices.reserve(brushGeometry.faces.size());
+
+  auto used = std::vector<bool>(faces.size(), false);
+  for (const auto& cachedFace : brushGeometry.faces)
+  {
+    size_t i = 0;
+    while (i < faces.size() && (used[i] || faces[i].points() != cachedFace.points))
+    {
+      ++i;
+    }
+    if (i == faces.size())
+    {
+      return std::nullopt;
+    }
+
+    used[i] = true;
+    faceIndices.push_back(i);
+  }
+
+  auto geometry = Model::BrushGeometry::createFromFaces(
+    brushGeometry.vertices, kdl::vec_transform(brushGeometry.faces, [](const auto& f) {
+      return std::tuple{f.plane, f.vertexIndices};
+    }));
+  if (!geometry)
+  {
+    return std::nullopt;
+  }
+
+  auto brushFaces = kdl::vec_transform(
+    faceIndices, [&](const auto faceIndex) { return std::move(faces[faceIndex]); });
+  return Model::Brush::createFromGeometry(std::move(brushFaces), std::move(*geometry))
+    .transform([](auto brush) { return std::optional{std::move(brush)}; })
+    .value_or(std::nullopt);
+}
+
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath)
+{
+  auto result = mapPath;
+  result += ".tbcache";
+  return result;
+}
+
+Result<MapCache> readMapCache(
+  const std::filesystem::path& path,
+  const std::string_view mapFileContents,
+  const vm::bbox3& worldBounds)
+{
+  return Disk::openFileForReading(path).and_then(
+    [&](auto file) -> Result<MapCache> {
+      try
+      {
+        auto reader = file->reader();
+        return readMapCache(reader, hashContents(mapFileContents), worldBounds);
+      }
+      catch (const ReaderException& e)
+      {
+        return Error{"Could not read map cache: " + std::string{e.what()}};
+      }
+    });
+}
+
+Result<void> writeMapCache(
+  const std::filesystem::path& path,
+  const MapCache& mapCache,
+  const std::string_view mapFileContents,
+  const vm::bbox3& worldBounds)
+{
+  return Disk::withOutputStream(
+    path, std::ios::out | std::ios::binary, [&](auto& stream) {
+      stream.write(Magic.data(), std::streamsize(Magic.size()));
+      write(stream, Version);
+      write(stream, hashContents(mapFileContents));
+      writeBounds(stream, worldBounds);
+      write(stream, std::int32_t(mapCache.mapFormat()));
+
+      writeSize(stream, mapCache.brushGeometries().size());
+      for (const auto& brushGeometry : mapCache.brushGeometries())
+      {
+        writeBrushGeometry(stream, brushGeometry);
+      }
+    });
+}
+
+} // namespace IO
+} // namespace TrenchBroom
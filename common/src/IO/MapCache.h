@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+#include "Result.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+class Brush;
+class WorldNode;
+} // namespace Model
+
+namespace IO
+{
+
+/**
+ * The geometry of a brush as stored in a map cache.
+ */
+struct CachedBrushGeometry
+{
+  struct Face
+  {
+    /**
+     * The points of the brush face this geometry face belongs to.
+     */
+    Model::BrushFace::Points points;
+    vm::plane3 plane;
+    std::vector<size_t> vertexIndices;
+  };
+
+  size_t lineNumber;
+  std::vector<vm::vec3> vertices;
+  std::vector<Face> faces;
+};
+
+/**
+ * A binary sidecar file that stores the precomputed geometry of the brushes of a map
+ * file, so that reopening an unchanged map does not need to compute the geometry of every
+ * brush again.
+ *
+ * The cache is keyed by a hash of the map file's contents, the map format and the world
+ * bounds, so it is only used if none of these have changed since it was written. The
+ * cached geometries are identified by the line numbers of their brushes and are matched
+ * against the brush faces read from the map file, so an outdated or damaged cache entry
+ * is ignored. The map file remains the source of truth.
+ */
+class MapCache
+{
+private:
+  Model::MapFormat m_mapFormat;
+  std::vector<CachedBrushGeometry> m_brushGeometries;
+
+public:
+  MapCache(Model::MapFormat mapFormat, std::vector<CachedBrushGeometry> brushGeometries);
+
+  /**
+   * Creates a cache containing the geometries of all brushes of the given world.
+   */
+  static MapCache create(const Model::WorldNode& world);
+
+  Model::MapFormat mapFormat() const;
+  const std::vector<CachedBrushGeometry>& brushGeometries() const;
+
+  /**
+   * Creates a brush from the given faces using the cached geometry for the brush starting
+   * at the given line number.
+   *
+   * If there is no cached geometry for the given line number, or if the cached geometry
+   * does not match the given faces, std::nullopt is returned and the given faces are left
+   * unchanged. Otherwise, the faces are moved into the returned brush.
+   */
+  std::optional<Model::Brush> createBrush(
+    size_t lineNumber, std::vector<Model::BrushFace>& faces) const;
+};
+
+/**
+ * Returns the path of the cache file for the map file at the given path.
+ */
+std::filesystem::path mapCachePath(const std::filesystem::path& mapPath);
+
+/**
+ * Reads the map cache at the given path. Returns an error if the cache cannot be read or
+ * if it was not created for the given map file contents and world bounds.
+ */
+Result<MapCache> readMapCache(
+  const std::filesystem::path& path,
+  std::string_view mapFileContents,
+  const vm::bbox3& worldBounds);
+
+/**
+ * Writes the given cache to the given path for the given map file contents and world
+ * bounds.
+ */
+Result<void> writeMapCache(
+  const std::filesystem::path& path,
+  const MapCache& mapCache,
+  std::string_view mapFileContents,
+  const vm::bbox3& worldBounds);
+
+} // namespace IO
+} // namespace TrenchBroom
@@ -39,6 +39,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <future>
 #include <iterator> // for std::ostreambuf_iterator
 #include <memory>
 #include <sstream>
@@ -50,11 +52,20 @@ namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+// the number of nodes that are serialized together on a background task
+constexpr auto SerializationChunkSize = size_t(1024);
+
+// the number of chunks that may be serialized ahead of the writer
+constexpr auto MaxPendingSerializationChunks = size_t(4);
+} // namespace
+
 class QuakeFileSerializer : public MapFileSerializer
 {
 public:
-  explicit QuakeFileSerializer(std::ostream& stream)
-    : MapFileSerializer(stream)
+  QuakeFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : MapFileSerializer(format, stream)
   {
   }
 
@@ -145,8 +156,8 @@ protected:
 class Quake2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Quake2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Quake2FileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
@@ -179,8 +190,8 @@ protected:
 class Quake2ValveFileSerializer : public Quake2FileSerializer
 {
 public:
-  explicit Quake2ValveFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  Quake2ValveFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : Quake2FileSerializer(format, stream)
   {
   }
 
@@ -205,8 +216,8 @@ private:
   std::string SurfaceColorFormat;
 
 public:
-  explicit DaikatanaFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  DaikatanaFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : Quake2FileSerializer(format, stream)
     , SurfaceColorFormat(" %d %d %d")
   {
   }
@@ -244,8 +255,8 @@ protected:
 class Hexen2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Hexen2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Hexen2FileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
@@ -262,8 +273,8 @@ private:
 class ValveFileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit ValveFileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  ValveFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
@@ -282,41 +293,54 @@ std::unique_ptr<NodeSerializer> MapFileSerializer::create(
   switch (format)
   {
   case Model::MapFormat::Standard:
-    return std::make_unique<QuakeFileSerializer>(stream);
+    return std::make_unique<QuakeFileSerializer>(format, stream);
   case Model::MapFormat::Quake2:
     // TODO 2427: Implement Quake3 serializers and use them
   case Model::MapFormat::Quake3:
   case Model::MapFormat::Quake3_Legacy:
-    return std::make_unique<Quake2FileSerializer>(stream);
+    return std::make_unique<Quake2FileSerializer>(format, stream);
   case Model::MapFormat::Quake2_Valve:
   case Model::MapFormat::Quake3_Valve:
-    return std::make_unique<Quake2ValveFileSerializer>(stream);
+    return std::make_unique<Quake2ValveFileSerializer>(format, stream);
   case Model::MapFormat::Daikatana:
-    return std::make_unique<DaikatanaFileSerializer>(stream);
+    return std::make_unique<DaikatanaFileSerializer>(format, stream);
   case Model::MapFormat::Valve:
-    return std::make_unique<ValveFileSerializer>(stream);
+    return std::make_unique<ValveFileSerializer>(format, stream);
   case Model::MapFormat::Hexen2:
-    return std::make_unique<Hexen2FileSerializer>(stream);
+    return std::make_unique<Hexen2FileSerializer>(format, stream);
   case Model::MapFormat::Unknown:
     throw FileFormatException("Unknown map file format");
     switchDefault();
   }
 }
 
-MapFileSerializer::MapFileSerializer(std::ostream& stream)
-  : m_line(1)
+MapFileSerializer::MapFileSerializer(
+  const Model::MapFormat format, std::ostream& stream)
+  : m_format(format)
+  , m_line(1)
   , m_stream(stream)
+  , m_nextChunk(0)
+{
+}
+
+MapFileSerializer::~MapFileSerializer()
 {
+  // the pending tasks access this serializer and the nodes
+  waitForPendingChunks();
 }
 
 void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
 {
-  ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
+  waitForPendingChunks();
+  m_nodesToSerialize.clear();
+  m_nodeChunks.clear();
+  m_nextChunk = 0;
 
-  // collect nodes
-  std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>>
-    nodesToSerialize;
-  nodesToSerialize.reserve(rootNodes.size());
+  // collect nodes which have changed since they were last serialized
+  const auto addNodeToSerialize = [&](const auto* node) {
+    m_nodeChunks.emplace(node, m_nodesToSerialize.size() / SerializationChunkSize);
+    m_nodesToSerialize.push_back(node);
+  };
 
   Model::Node::visitAll(
     rootNodes,
@@ -333,32 +357,27 @@ void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootN
       [](auto&& thisLambda, const Model::EntityNode* entity) {
         entity->visitChildren(thisLambda);
       },
-      [&](const Model::BrushNode* brush) { nodesToSerialize.push_back(brush); },
-      [&](const Model::PatchNode* patchNode) { nodesToSerialize.push_back(patchNode); }));
-
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const Model::Node*, PrecomputedString>;
-  std::vector<Entry> result =
-    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
-      return std::visit(
-        kdl::overload(
-          [&](const Model::BrushNode* brushNode) {
-            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-          },
-          [&](const Model::PatchNode* patchNode) {
-            return Entry{patchNode, writePatch(patchNode->patch())};
-          }),
-        node);
-    });
-
-  // move strings into a map
-  for (auto& entry : result)
-  {
-    m_nodeToPrecomputedString.insert(std::move(entry));
-  }
+      [&](const Model::BrushNode* brush) {
+        if (!brush->serializedText(m_format))
+        {
+          addNodeToSerialize(brush);
+        }
+      },
+      [&](const Model::PatchNode* patchNode) {
+        if (!patchNode->serializedText(m_format))
+        {
+          addNodeToSerialize(patchNode);
+        }
+      }));
+
+  // start serializing the first chunks while the file header is written
+  launchChunks();
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  waitForPendingChunks();
+}
 
 void MapFileSerializer::doBeginEntity(const Model::Node* /* node */)
 {
@@ -394,14 +413,7 @@ void MapFileSerializer::doBrush(const Model::BrushNode* brush)
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
   ++m_line;
 
-  // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  writeSerializedText(brush);
 
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
   ++m_line;
@@ -422,14 +434,7 @@ void MapFileSerializer::doPatch(const Model::PatchNode* patchNode)
   ++m_line;
   m_startLineStack.push_back(m_line);
 
-  // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  writeSerializedText(patchNode);
 
   setFilePosition(patchNode);
 }
@@ -448,10 +453,98 @@ size_t MapFileSerializer::startLine()
   return result;
 }
 
+void MapFileSerializer::writeSerializedText(const Model::Node* node)
+{
+  if (const auto it = m_nodeChunks.find(node); it != m_nodeChunks.end())
+  {
+    waitForChunk(it->second);
+  }
+
+  const auto* serializedText = node->serializedText(m_format);
+  ensure(
+    serializedText != nullptr,
+    "attempted to serialize a node which was not passed to doBeginFile");
+  m_stream << serializedText->text;
+  m_line += serializedText->lineCount;
+}
+
+size_t MapFileSerializer::chunkCount() const
+{
+  return (m_nodesToSerialize.size() + SerializationChunkSize - 1)
+         / SerializationChunkSize;
+}
+
+void MapFileSerializer::launchChunks()
+{
+  while (m_pendingChunks.size() < MaxPendingSerializationChunks
+         && m_nextChunk < chunkCount())
+  {
+    const auto chunk = m_nextChunk++;
+    m_pendingChunks.push_back(
+      std::async(std::launch::async, [&, chunk]() { serializeChunk(chunk); }));
+  }
+}
+
+/**
+ * Waits until the given chunk and all chunks before it have been serialized, and
+ * launches the following chunks.
+ */
+void MapFileSerializer::waitForChunk(const size_t chunk)
+{
+  // the pending chunks are the ones right before m_nextChunk
+  while (chunk + m_pendingChunks.size() >= m_nextChunk)
+  {
+    if (m_pendingChunks.empty())
+    {
+      launchChunks();
+    }
+
+    auto pendingChunk = std::move(m_pendingChunks.front());
+    m_pendingChunks.pop_front();
+    pendingChunk.get();
+  }
+  launchChunks();
+}
+
+void MapFileSerializer::waitForPendingChunks()
+{
+  // chunks that were not launched yet belong to nodes which were not written, their text
+  // is serialized by the next call to doBeginFile
+  while (!m_pendingChunks.empty())
+  {
+    auto pendingChunk = std::move(m_pendingChunks.front());
+    m_pendingChunks.pop_front();
+    pendingChunk.wait();
+  }
+}
+
+/**
+ * Threadsafe
+ */
+void MapFileSerializer::serializeChunk(const size_t chunk) const
+{
+  const auto first = chunk * SerializationChunkSize;
+  const auto count =
+    std::min(SerializationChunkSize, m_nodesToSerialize.size() - first);
+
+  // serialize nodes to strings in parallel and cache the strings in the nodes
+  kdl::parallel_for(count, [&](const size_t i) {
+    std::visit(
+      kdl::overload(
+        [&](const Model::BrushNode* brushNode) {
+          brushNode->setSerializedText(writeBrushFaces(brushNode->brush()));
+        },
+        [&](const Model::PatchNode* patchNode) {
+          patchNode->setSerializedText(writePatch(patchNode->patch()));
+        }),
+      m_nodesToSerialize[first + i]);
+  });
+}
+
 /**
  * Threadsafe
  */
-MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
+Model::SerializedText MapFileSerializer::writeBrushFaces(
   const Model::Brush& brush) const
 {
   std::stringstream stream;
@@ -459,10 +552,10 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
   {
     doWriteBrushFace(stream, face);
   }
-  return PrecomputedString{stream.str(), brush.faces().size()};
+  return Model::SerializedText{m_format, stream.str(), brush.faces().size()};
 }
 
-MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
+Model::SerializedText MapFileSerializer::writePatch(
   const Model::BezierPatch& patch) const
 {
   size_t lineCount = 0u;
@@ -511,7 +604,7 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
   fmt::format_to(std::ostreambuf_iterator<char>(stream), "}}\n");
   ++lineCount;
 
-  return PrecomputedString{stream.str(), lineCount};
+  return Model::SerializedText{m_format, stream.str(), lineCount};
 }
 } // namespace IO
 } // namespace TrenchBroom
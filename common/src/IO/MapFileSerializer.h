@@ -22,8 +22,12 @@
 #include "IO/NodeSerializer.h"
 #include "Model/MapFormat.h"
 
+#include <deque>
+#include <future>
 #include <iosfwd>
 #include <memory>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom
@@ -37,6 +41,7 @@ class BrushFace;
 class EntityProperty;
 class Node;
 class PatchNode;
+struct SerializedText;
 } // namespace Model
 
 namespace IO
@@ -46,22 +51,30 @@ class MapFileSerializer : public NodeSerializer
 private:
   using LineStack = std::vector<size_t>;
   LineStack m_startLineStack;
+  Model::MapFormat m_format;
   size_t m_line;
   std::ostream& m_stream;
 
-  struct PrecomputedString
-  {
-    std::string string;
-    size_t lineCount;
-  };
-  std::unordered_map<const Model::Node*, PrecomputedString> m_nodeToPrecomputedString;
+  /**
+   * The nodes whose text is serialized while the file is written, in chunks of
+   * consecutive nodes. Each chunk is serialized in parallel on a background task, and at
+   * most a few chunks are in flight at any time. The writer waits for a chunk only when
+   * it reaches one of its nodes.
+   */
+  using NodeToSerialize = std::variant<const Model::BrushNode*, const Model::PatchNode*>;
+  std::vector<NodeToSerialize> m_nodesToSerialize;
+  std::unordered_map<const Model::Node*, size_t> m_nodeChunks;
+  std::deque<std::future<void>> m_pendingChunks;
+  size_t m_nextChunk;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
     Model::MapFormat format, std::ostream& stream);
 
+  ~MapFileSerializer() override;
+
 protected:
-  explicit MapFileSerializer(std::ostream& stream);
+  MapFileSerializer(Model::MapFormat format, std::ostream& stream);
 
 private:
   void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
@@ -78,12 +91,19 @@ private:
 private:
   void setFilePosition(const Model::Node* node);
   size_t startLine();
+  void writeSerializedText(const Model::Node* node);
+
+  size_t chunkCount() const;
+  void launchChunks();
+  void waitForChunk(size_t chunk);
+  void waitForPendingChunks();
 
 private: // threadsafe
+  void serializeChunk(size_t chunk) const;
   virtual void doWriteBrushFace(
     std::ostream& stream, const Model::BrushFace& face) const = 0;
-  PrecomputedString writeBrushFaces(const Model::Brush& brush) const;
-  PrecomputedString writePatch(const Model::BezierPatch& patch) const;
+  Model::SerializedText writeBrushFaces(const Model::Brush& brush) const;
+  Model::SerializedText writePatch(const Model::BezierPatch& patch) const;
 };
 } // namespace IO
 } // namespace TrenchBroom
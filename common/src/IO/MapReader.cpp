@@ -20,6 +20,9 @@
 #include "MapReader.h"
 
 #include "Error.h"
+#include "Exceptions.h"
+#include "IO/BufferedParserStatus.h"
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
@@ -44,10 +47,12 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_io.h>
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -61,17 +66,24 @@ MapReader::MapReader(
   const Model::MapFormat sourceMapFormat,
   const Model::MapFormat targetMapFormat,
   Model::EntityPropertyConfig entityPropertyConfig,
-  std::vector<std::string> linkedGroupsToKeep)
-  : StandardMapParser(std::move(str), sourceMapFormat, targetMapFormat)
+  std::vector<std::string> linkedGroupsToKeep,
+  const size_t startLine)
+  : StandardMapParser(str, sourceMapFormat, targetMapFormat, startLine)
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
   , m_linkedGroupsToKeep{std::move(linkedGroupsToKeep)}
 {
 }
 
-void MapReader::readEntities(const vm::bbox3& worldBounds, ParserStatus& status)
+void MapReader::readEntities(
+  const vm::bbox3& worldBounds, ParserStatus& status, const MapCache* mapCache)
 {
   m_worldBounds = worldBounds;
-  parseEntities(status);
+  m_mapCache = mapCache;
+  if (!parseEntitiesInChunks(status))
+  {
+    parseEntities(status);
+  }
   createNodes(status);
 }
 
@@ -114,7 +126,7 @@ void MapReader::onEndEntity(
 
 void MapReader::onBeginBrush(const size_t /* line */, ParserStatus& /* status */)
 {
-  m_objectInfos.emplace_back(BrushInfo{{}, 0, 0, m_currentEntityInfo});
+  m_objectInfos.emplace_back(BrushInfo{{}, 0, 0, m_currentEntityInfo, std::nullopt});
 }
 
 void MapReader::onEndBrush(
@@ -186,6 +198,270 @@ void MapReader::onPatch(
 
 // helper methods
 
+namespace
+{
+/** Inputs smaller than this are never split into chunks. */
+constexpr auto MinChunkSize = size_t(512) * 1024;
+
+/** A sequence of consecutive top level entities. */
+struct EntityChunk
+{
+  std::string_view str;
+  size_t startLine;
+  size_t entityCount;
+};
+
+std::string_view trimLine(std::string_view line)
+{
+  const auto first = line.find_first_not_of(" \t");
+  if (first == std::string_view::npos)
+  {
+    return std::string_view{};
+  }
+  const auto last = line.find_last_not_of(" \t");
+  return line.substr(first, last - first + 1);
+}
+
+/**
+ * Splits the given string into chunks of consecutive top level entities such that every
+ * chunk except the last one is at least as long as the given chunk size.
+ *
+ * Braces are only counted if they appear on a line by themselves, which is how map
+ * editors write them. This avoids having to tokenize the input since texture names
+ * such as `{fence` would otherwise be mistaken for braces. Lines are counted in the same
+ * way as the tokenizer counts them.
+ *
+ * Returns an empty vector if the braces are unbalanced.
+ */
+std::vector<EntityChunk> splitIntoEntityChunks(
+  const std::string_view str, const size_t chunkSize)
+{
+  auto chunks = std::vector<EntityChunk>{};
+
+  auto chunkStart = size_t(0);
+  auto chunkStartLine = size_t(1);
+  auto entityCount = size_t(0);
+
+  auto depth = size_t(0);
+  auto line = size_t(1);
+  auto pos = size_t(0);
+
+  while (pos < str.size())
+  {
+    const auto lineStart = pos;
+    const auto lineEnd = std::min(str.find_first_of("\r\n", lineStart), str.size());
+
+    const auto content = trimLine(str.substr(lineStart, lineEnd - lineStart));
+    if (content == "{")
+    {
+      if (depth == 0)
+      {
+        if (entityCount > 0 && lineStart - chunkStart >= chunkSize)
+        {
+          chunks.push_back(EntityChunk{
+            str.substr(chunkStart, lineStart - chunkStart), chunkStartLine, entityCount});
+          chunkStart = lineStart;
+          chunkStartLine = line;
+          entityCount = 0;
+        }
+        ++entityCount;
+      }
+      ++depth;
+    }
+    else if (content == "}")
+    {
+      if (depth == 0)
+      {
+        return {};
+      }
+      --depth;
+    }
+
+    pos = lineEnd;
+    if (pos < str.size())
+    {
+      pos += str[pos] == '\r' && pos + 1 < str.size() && str[pos + 1] == '\n' ? 2 : 1;
+      ++line;
+    }
+  }
+
+  chunks.push_back(EntityChunk{str.substr(chunkStart), chunkStartLine, entityCount});
+  return chunks;
+}
+
+/**
+ * Creates a brush from the faces of the given brush info. If the given map cache contains
+ * a matching geometry for the brush, it is used instead of computing the geometry. The
+ * faces are moved out of the given brush info.
+ */
+Result<Model::Brush> createBrush(
+  MapReader::BrushInfo& brushInfo, const vm::bbox3& worldBounds, const MapCache* mapCache)
+{
+  auto cachedBrush = mapCache ? mapCache->createBrush(brushInfo.startLine, brushInfo.faces)
+                              : std::nullopt;
+  return cachedBrush ? Result<Model::Brush>{std::move(*cachedBrush)}
+                     : Model::Brush::create(worldBounds, std::move(brushInfo.faces));
+}
+} // namespace
+
+/**
+ * Parses a chunk of top level entities and records the object infos for them. Layers,
+ * groups and other nodes are not created by a chunk reader, so the node callbacks are
+ * never called.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+private:
+  size_t m_entityCount = 0;
+
+public:
+  ChunkReader(
+    const EntityChunk& chunk,
+    const Model::MapFormat sourceMapFormat,
+    const Model::MapFormat targetMapFormat,
+    const vm::bbox3& worldBounds,
+    const MapCache* mapCache)
+    : MapReader{chunk.str, sourceMapFormat, targetMapFormat, {}, {}, chunk.startLine}
+  {
+    m_worldBounds = worldBounds;
+    m_mapCache = mapCache;
+  }
+
+  /**
+   * Parses the chunk, creates its brushes and returns the recorded object infos. Returns
+   * an empty optional if the chunk does not consist of exactly the given number of
+   * complete entities, which means that the chunk boundaries have been chosen
+   * incorrectly.
+   *
+   * @throws ParserException if parsing fails
+   */
+  std::optional<std::vector<ObjectInfo>> read(
+    const size_t expectedEntityCount, ParserStatus& status)
+  {
+    parseEntities(status);
+    if (m_currentEntityInfo || m_entityCount != expectedEntityCount)
+    {
+      return std::nullopt;
+    }
+
+    for (auto& objectInfo : m_objectInfos)
+    {
+      if (auto* brushInfo = std::get_if<BrushInfo>(&objectInfo))
+      {
+        brushInfo->brush = createBrush(*brushInfo, m_worldBounds, m_mapCache);
+      }
+    }
+
+    return std::move(m_objectInfos);
+  }
+
+private:
+  void onEndEntity(
+    const size_t startLine, const size_t lineCount, ParserStatus& status) override
+  {
+    MapReader::onEndEntity(startLine, lineCount, status);
+    ++m_entityCount;
+  }
+
+  Model::Node* onWorldNode(std::unique_ptr<Model::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<Model::Node>, ParserStatus&) override {}
+
+  void onNode(Model::Node*, std::unique_ptr<Model::Node>, ParserStatus&) override {}
+};
+
+/**
+ * Splits the input into chunks of top level entities and parses them in parallel. Indices
+ * of parent entities recorded in the object infos of each chunk are adjusted so that they
+ * refer to the merged object infos.
+ *
+ * Returns false if the input was not split or if any chunk could not be parsed. In that
+ * case, no object infos are recorded and no messages are logged.
+ */
+bool MapReader::parseEntitiesInChunks(ParserStatus& status)
+{
+  if (m_str.size() < 2 * MinChunkSize)
+  {
+    return false;
+  }
+
+  const auto threadCount = size_t(std::max(std::thread::hardware_concurrency(), 1u));
+  if (threadCount < 2)
+  {
+    return false;
+  }
+
+  // create more chunks than threads to balance the load
+  const auto chunkSize = std::max(MinChunkSize, m_str.size() / (threadCount * 4));
+  const auto chunks = splitIntoEntityChunks(m_str, chunkSize);
+  if (chunks.size() < 2)
+  {
+    return false;
+  }
+
+  auto chunkStatuses = std::vector<BufferedParserStatus>{};
+  chunkStatuses.reserve(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunkStatuses.emplace_back(status);
+  }
+
+  auto chunkObjectInfos =
+    std::vector<std::optional<std::vector<ObjectInfo>>>(chunks.size());
+  kdl::parallel_for(chunks.size(), [&](const size_t i) {
+    try
+    {
+      auto reader = ChunkReader{
+        chunks[i], m_sourceMapFormat, m_targetMapFormat, m_worldBounds, m_mapCache};
+      chunkObjectInfos[i] = reader.read(chunks[i].entityCount, chunkStatuses[i]);
+    }
+    catch (const ParserException&)
+    {
+      // leave the result empty, the input will be parsed again on the calling thread
+    }
+  });
+
+  if (!std::all_of(
+        chunkObjectInfos.begin(), chunkObjectInfos.end(), [](const auto& objectInfos) {
+          return objectInfos.has_value();
+        }))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunkStatuses[i].flush();
+
+    const auto indexOffset = m_objectInfos.size();
+    for (auto& objectInfo : *chunkObjectInfos[i])
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](BrushInfo& brushInfo) {
+            if (brushInfo.parentIndex)
+            {
+              *brushInfo.parentIndex += indexOffset;
+            }
+          },
+          [&](PatchInfo& patchInfo) {
+            if (patchInfo.parentIndex)
+            {
+              *patchInfo.parentIndex += indexOffset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  return true;
+}
+
 namespace
 {
 /** The type of a node's container. */
@@ -563,13 +839,16 @@ static CreateNodeResult createNodeFromEntityInfo(
 }
 
 /**
- * Creates a brush node from the given brush info. Returns an error if the brush could not
- * be created.
+ * Creates a brush node from the given brush info. If the brush was not already created
+ * while parsing, it is created now. Returns an error if the brush could not be created.
  */
 static CreateNodeResult createBrushNode(
-  MapReader::BrushInfo brushInfo, const vm::bbox3& worldBounds)
+  MapReader::BrushInfo brushInfo, const vm::bbox3& worldBounds, const MapCache* mapCache)
 {
-  return Model::Brush::create(worldBounds, std::move(brushInfo.faces))
+  auto brush = brushInfo.brush ? std::move(*brushInfo.brush)
+                               : createBrush(brushInfo, worldBounds, mapCache);
+
+  return std::move(brush)
     .transform([&](auto brush) {
       auto brushNode = std::make_unique<Model::BrushNode>(std::move(brush));
       brushNode->setFilePosition(brushInfo.startLine, brushInfo.lineCount);
@@ -581,7 +860,7 @@ static CreateNodeResult createBrushNode(
       };
     })
     .or_else([&](auto e) {
-      return CreateNodeResult{NodeError{brushInfo.startLine, kdl::str_to_string(e)}};
+      return CreateNodeResult{NodeError{brushInfo.startLine, std::move(e.msg)}};
     });
 }
 
@@ -616,6 +895,7 @@ static std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   std::vector<MapReader::ObjectInfo> objectInfos,
   const vm::bbox3& worldBounds,
   const Model::MapFormat mapFormat,
+  const MapCache* mapCache,
   ParserStatus& status)
 {
   // create nodes in parallel, moving data out of objectInfos
@@ -630,7 +910,7 @@ static std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
               entityPropertyConfig, std::move(entityInfo), mapFormat);
           },
           [&](MapReader::BrushInfo&& brushInfo) {
-            return createBrushNode(std::move(brushInfo), worldBounds);
+            return createBrushNode(std::move(brushInfo), worldBounds, mapCache);
           },
           [&](MapReader::PatchInfo&& patchInfo) {
             return createPatchNode(std::move(patchInfo));
@@ -971,6 +1251,7 @@ void MapReader::createNodes(ParserStatus& status)
     std::move(m_objectInfos),
     m_worldBounds,
     m_targetMapFormat,
+    m_mapCache,
     status);
 
   // call onWorldNode for the first world node, remember the default parent and clear out
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Error.h"
 #include "FloatType.h"
 #include "IO/StandardMapParser.h"
 #include "Model/BezierPatch.h"
@@ -54,6 +55,7 @@ class WorldNode;
 
 namespace IO
 {
+class MapCache;
 class ParserStatus;
 
 /**
@@ -66,7 +68,9 @@ class ParserStatus;
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). Large inputs are split at top level entity boundaries and the chunks
+ * are parsed in parallel. The brushes of a chunk are created as soon as the chunk has
+ * been parsed (see readEntities).
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -89,6 +93,8 @@ public: // only public so that helper methods can see these declarations
     size_t startLine;
     size_t lineCount;
     std::optional<size_t> parentIndex;
+    // the brush created from the faces if it was created right after parsing
+    std::optional<Result<Model::Brush>> brush;
   };
 
   struct PatchInfo
@@ -105,9 +111,13 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   Model::EntityPropertyConfig m_entityPropertyConfig;
   std::vector<std::string> m_linkedGroupsToKeep;
   vm::bbox3 m_worldBounds;
+  const MapCache* m_mapCache = nullptr;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -124,20 +134,39 @@ protected:
    * @param entityPropertyConfig the entity property config to use
    * @param linkedGroupsToKeep the IDs of linked groups which should not be unlinked even
    * if orphaned
+   * @param startLine the line number of the first line of the given string
    */
   MapReader(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
     Model::MapFormat targetMapFormat,
     Model::EntityPropertyConfig entityPropertyConfig,
-    std::vector<std::string> linkedGroupsToKeep);
+    std::vector<std::string> linkedGroupsToKeep,
+    size_t startLine = 1);
 
   /**
    * Attempts to parse as one or more entities.
    *
+   * If the input is large enough, it is split into chunks of top level entities which are
+   * parsed on several threads. The resulting object infos are merged in the order in
+   * which they appear in the input, and the messages logged while parsing the chunks are
+   * forwarded to the given status in the same order. If any chunk cannot be parsed, the
+   * entire input is parsed again on the calling thread, so that the reported errors are
+   * the same as if no chunks had been parsed.
+   *
+   * The brushes of each chunk are created on the thread that parsed the chunk right after
+   * parsing it, so that creating the brushes of one chunk overlaps with parsing the
+   * others, and the faces of a chunk are released before all chunks have been parsed.
+   *
+   * If a map cache is given, the brush geometries stored in it are used instead of
+   * computing them if they match the parsed brushes.
+   *
    * @throws ParserException if parsing fails
    */
-  void readEntities(const vm::bbox3& worldBounds, ParserStatus& status);
+  void readEntities(
+    const vm::bbox3& worldBounds,
+    ParserStatus& status,
+    const MapCache* mapCache = nullptr);
   /**
    * Attempts to parse as one or more brushes without any enclosing entity.
    *
@@ -188,6 +217,7 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  bool parseEntitiesInChunks(ParserStatus& status);
   void createNodes(ParserStatus& status);
 
 private: // subclassing interface - these will be called in the order that nodes should be
@@ -346,6 +346,12 @@ void Md2Parser::doLoadFrame(
   buildFrame(model, surface, frameIndex, frame, meshes);
 }
 
+void Md2Parser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  loadFramesInParallel(frameIndices, model, logger);
+}
+
 Md2Parser::Md2SkinList Md2Parser::parseSkins(Reader reader, const size_t skinCount)
 {
   Md2SkinList skins;
@@ -117,6 +117,10 @@ private:
   std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
   void doLoadFrame(
     size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+  void doLoadFrames(
+    const std::vector<size_t>& frameIndices,
+    Assets::EntityModel& model,
+    Logger& logger) override;
 
   Md2SkinList parseSkins(Reader reader, size_t skinCount);
   Md2Frame parseFrame(Reader reader, size_t frameIndex, size_t vertexCount);
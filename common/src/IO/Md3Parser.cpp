@@ -153,6 +153,12 @@ void Md3Parser::doLoadFrame(
   parseFrameSurfaces(reader.subReaderFromBegin(surfaceOffset), frame, model);
 }
 
+void Md3Parser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  loadFramesInParallel(frameIndices, model, logger);
+}
+
 void Md3Parser::parseSurfaces(
   Reader reader, const size_t surfaceCount, Assets::EntityModel& model, Logger& logger)
 {
@@ -333,6 +333,12 @@ void MdlParser::doLoadFrame(
     scale);
 }
 
+void MdlParser::doLoadFrames(
+  const std::vector<size_t>& frameIndices, Assets::EntityModel& model, Logger& logger)
+{
+  loadFramesInParallel(frameIndices, model, logger);
+}
+
 void MdlParser::parseSkins(
   Reader& reader,
   Assets::EntityModelSurface& surface,
@@ -29,10 +29,15 @@
 #include "Model/Polyhedron.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <utility>
 
 namespace TrenchBroom
@@ -152,42 +157,78 @@ static void writeMtlFile(
   }
 }
 
+/**
+ * Formats the given elements into the given stream. Consecutive chunks of elements are
+ * formatted into separate strings in parallel, and the strings are written in order, so
+ * the output is the same as if the elements were formatted one after another.
+ */
+template <typename T, typename F>
+static void writeInParallel(
+  std::ostream& str, const std::vector<T>& elements, const F& format)
+{
+  constexpr auto ChunkSize = size_t(1024);
+
+  const auto chunkCount = (elements.size() + ChunkSize - 1) / ChunkSize;
+  auto chunks = std::vector<std::string>(chunkCount);
+
+  kdl::parallel_for(
+    chunkCount,
+    [&](const size_t chunkIndex) {
+      auto& chunk = chunks[chunkIndex];
+      const auto first = chunkIndex * ChunkSize;
+      const auto last = std::min(first + ChunkSize, elements.size());
+      for (size_t i = first; i < last; ++i)
+      {
+        format(chunk, elements[i]);
+      }
+    },
+    1);
+
+  for (const auto& chunk : chunks)
+  {
+    str << chunk;
+  }
+}
+
 static void writeVertices(std::ostream& str, const std::vector<vm::vec3>& vertices)
 {
   str << "# vertices\n";
-  for (const vm::vec3& elem : vertices)
-  {
+  writeInParallel(str, vertices, [](std::string& chunk, const vm::vec3& elem) {
     // no idea why I have to switch Y and Z
     fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
-  }
+      std::back_inserter(chunk), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
+  });
 }
 
 static void writeTexCoords(std::ostream& str, const std::vector<vm::vec2f>& texCoords)
 {
   str << "# texture coordinates\n";
-  for (const vm::vec2f& elem : texCoords)
-  {
+  writeInParallel(str, texCoords, [](std::string& chunk, const vm::vec2f& elem) {
     // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
     // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "vt {} {}\n", elem.x(), -elem.y());
-  }
+    fmt::format_to(std::back_inserter(chunk), "vt {} {}\n", elem.x(), -elem.y());
+  });
 }
 
 static void writeNormals(std::ostream& str, const std::vector<vm::vec3>& normals)
 {
   str << "# normals\n";
-  for (const vm::vec3& elem : normals)
-  {
+  writeInParallel(str, normals, [](std::string& chunk, const vm::vec3& elem) {
     // no idea why I have to switch Y and Z
     fmt::format_to(
-      std::ostreambuf_iterator<char>(str),
-      "vn {} {} {}\n",
-      elem.x(),
-      elem.z(),
-      -elem.y());
-  }
+      std::back_inserter(chunk), "vn {} {} {}\n", elem.x(), elem.z(), -elem.y());
+  });
+}
+
+static void writeObjects(
+  std::ostream& str, const std::vector<ObjSerializer::Object>& objects)
+{
+  writeInParallel(
+    str, objects, [](std::string& chunk, const ObjSerializer::Object& object) {
+      auto objectStr = std::ostringstream{};
+      objectStr << object << "\n";
+      chunk += objectStr.str();
+    });
 }
 
 static void writeObjFile(
@@ -206,12 +247,7 @@ static void writeObjFile(
   str << "\n";
   writeNormals(str, normals);
   str << "\n";
-
-  for (const auto& object : objects)
-  {
-    str << object;
-    str << "\n";
-  }
+  writeObjects(str, objects);
 }
 
 void ObjSerializer::doEndFile()
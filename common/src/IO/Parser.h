@@ -87,7 +87,8 @@ protected:
       throw ParserException(
         token.line(),
         token.column(),
-        "Expected string '" + expected + "', but got '" + token.data() + "'");
+        "Expected string '" + expected + "', but got '" + std::string{token.data()}
+          + "'");
     }
   }
 
@@ -104,14 +105,15 @@ protected:
       token.line(),
       token.column(),
       "Expected string '" + kdl::str_join(expected, "', '", "', or '", "' or '")
-        + "', but got '" + token.data() + "'");
+        + "', but got '" + std::string{token.data()} + "'");
   }
 
 private:
   std::string expectString(const std::string& expected, const Token& token) const
   {
     return "Expected " + expected + ", but got " + tokenName(token.type())
-           + (!token.data().empty() ? " (raw data: '" + token.data() + "')" : "");
+           + (!token.data().empty() ? " (raw data: '" + std::string{token.data()} + "')"
+                                    : "");
   }
 
 protected:
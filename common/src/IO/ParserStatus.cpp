@@ -30,9 +30,11 @@ namespace TrenchBroom
 {
 namespace IO
 {
-ParserStatus::ParserStatus(Logger& logger, const std::string& prefix)
+ParserStatus::ParserStatus(
+  Logger& logger, const std::string& prefix, const size_t maxRepeatedMessages)
   : m_logger(logger)
   , m_prefix(prefix)
+  , m_maxRepeatedMessages(maxRepeatedMessages)
 {
 }
 
@@ -41,7 +43,13 @@ ParserStatus::~ParserStatus() {}
 void ParserStatus::progress(const double progress)
 {
   assert(progress >= 0.0 && progress <= 1.0);
-  doProgress(progress);
+
+  const auto now = std::chrono::steady_clock::now();
+  if (progress >= 1.0 || now - m_lastProgress >= ProgressInterval)
+  {
+    m_lastProgress = now;
+    doProgress(progress);
+  }
 }
 
 void ParserStatus::debug(const size_t line, const size_t column, const std::string& str)
@@ -123,10 +131,43 @@ void ParserStatus::errorAndThrow(const std::string& str)
   throw ParserException(buildMessage(str));
 }
 
+void ParserStatus::logSuppressedMessages()
+{
+  for (const auto& [key, count] : m_messageCounts)
+  {
+    if (count > m_maxRepeatedMessages)
+    {
+      const auto& [level, str] = key;
+
+      std::stringstream msg;
+      if (!m_prefix.empty())
+      {
+        msg << m_prefix << ": ";
+      }
+      msg << str << " (" << (count - m_maxRepeatedMessages) << " more like this)";
+      doLog(level, msg.str());
+    }
+  }
+  m_messageCounts.clear();
+}
+
+bool ParserStatus::shouldLog(const LogLevel level, const std::string& str)
+{
+  if (m_maxRepeatedMessages == 0 || level == LogLevel::Error)
+  {
+    return true;
+  }
+
+  return ++m_messageCounts[{level, str}] <= m_maxRepeatedMessages;
+}
+
 void ParserStatus::log(
   const LogLevel level, const size_t line, const size_t column, const std::string& str)
 {
-  doLog(level, buildMessage(line, column, str));
+  if (shouldLog(level, str))
+  {
+    doLog(level, buildMessage(line, column, str));
+  }
 }
 
 std::string ParserStatus::buildMessage(
@@ -143,7 +184,10 @@ std::string ParserStatus::buildMessage(
 
 void ParserStatus::log(const LogLevel level, const size_t line, const std::string& str)
 {
-  doLog(level, buildMessage(line, str));
+  if (shouldLog(level, str))
+  {
+    doLog(level, buildMessage(line, str));
+  }
 }
 
 std::string ParserStatus::buildMessage(const size_t line, const std::string& str) const
@@ -159,7 +203,10 @@ std::string ParserStatus::buildMessage(const size_t line, const std::string& str
 
 void ParserStatus::log(const LogLevel level, const std::string& str)
 {
-  doLog(level, buildMessage(str));
+  if (shouldLog(level, str))
+  {
+    doLog(level, buildMessage(str));
+  }
 }
 
 std::string ParserStatus::buildMessage(const std::string& str) const
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <map>
 #include <string>
+#include <tuple>
 
 namespace TrenchBroom
 {
@@ -30,12 +33,33 @@ namespace IO
 {
 class ParserStatus
 {
+public:
+  /**
+   * Progress is reported to subclasses at most once per interval, and when parsing is
+   * complete.
+   */
+  static constexpr auto ProgressInterval = std::chrono::milliseconds{50};
+
 private:
+  friend class BufferedParserStatus;
+
   Logger& m_logger;
   std::string m_prefix;
+  std::chrono::steady_clock::time_point m_lastProgress;
+
+  size_t m_maxRepeatedMessages;
+  std::map<std::tuple<LogLevel, std::string>, size_t> m_messageCounts;
 
 protected:
-  explicit ParserStatus(Logger& logger, const std::string& prefix);
+  /**
+   * Creates a parser status that logs to the given logger.
+   *
+   * If maxRepeatedMessages is not 0, only that many messages with the same level and text
+   * are logged, ignoring their position. The others are counted and summarized by
+   * logSuppressedMessages. Errors are always logged.
+   */
+  explicit ParserStatus(
+    Logger& logger, const std::string& prefix, size_t maxRepeatedMessages = 0);
 
 public:
   virtual ~ParserStatus();
@@ -61,7 +85,16 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+protected:
+  /**
+   * Logs a summary for every message that was suppressed because it was repeated too
+   * often, and resets the message counts.
+   */
+  void logSuppressedMessages();
+
 private:
+  bool shouldLog(LogLevel level, const std::string& str);
+
   void log(LogLevel level, size_t line, size_t column, const std::string& str);
   std::string buildMessage(size_t line, size_t column, const std::string& str) const;
 
@@ -37,9 +37,9 @@ PathMatcher makeExtensionPathMatcher(std::vector<std::string> extensions)
 
 PathMatcher makeFilenamePathMatcher(std::string pattern)
 {
-  return [pattern = std::move(pattern)](
+  return [matcher = kdl::ci::glob_matcher{std::move(pattern)}](
            const std::filesystem::path& path, const GetPathInfo&) {
-    return kdl::ci::str_matches_glob(path.filename().string(), pattern);
+    return matcher.matches(path.filename().string());
   };
 }
 
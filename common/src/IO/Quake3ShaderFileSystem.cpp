@@ -21,6 +21,7 @@
 
 #include "Assets/Quake3Shader.h"
 #include "Error.h"
+#include "IO/BufferedParserStatus.h"
 #include "IO/File.h"
 #include "IO/PathInfo.h"
 #include "IO/Quake3ShaderParser.h"
@@ -29,11 +30,15 @@
 #include "Logger.h"
 
 #include "kdl/result_fold.h"
+#include <kdl/parallel.h>
 #include <kdl/path_utils.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -63,30 +68,79 @@ Result<std::vector<Assets::Quake3Shader>> Quake3ShaderFileSystem::loadShaders()
     return std::vector<Assets::Quake3Shader>{};
   }
 
-  const auto loadShaderFile = [&](const auto& path) {
-    return m_fs.openFile(path).transform([&](auto file) {
-      auto bufferedReader = file->reader().buffer();
-      try
-      {
-        auto parser = Quake3ShaderParser{bufferedReader.stringView()};
-        auto status = SimpleParserStatus{m_logger, path.string()};
-        return parser.parse(status);
-      }
-      catch (const ParserException& e)
-      {
-        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
-        return std::vector<Assets::Quake3Shader>{};
-      }
-    });
+  struct ShaderFile
+  {
+    std::filesystem::path path;
+    std::shared_ptr<File> file;
+  };
+
+  struct ParseResult
+  {
+    std::vector<Assets::Quake3Shader> shaders;
+    std::optional<std::string> error;
+  };
+
+  // the files are opened on this thread because the file system is not thread safe, but
+  // the shader scripts are independent of each other, so they are parsed in parallel
+  const auto parseShaderFile = [&](const ShaderFile& shaderFile, auto& status) {
+    try
+    {
+      auto bufferedReader = shaderFile.file->reader().buffer();
+      auto parser = Quake3ShaderParser{bufferedReader.stringView()};
+      return ParseResult{parser.parse(status), std::nullopt};
+    }
+    catch (const ParserException& e)
+    {
+      return ParseResult{{}, e.what()};
+    }
   };
 
   return m_fs
     .find(m_shaderSearchPath, TraversalMode::Flat, makeExtensionPathMatcher({".shader"}))
     .and_then([&](auto paths) {
-      return kdl::fold_results(kdl::vec_transform(paths, loadShaderFile));
+      // sort the paths so that shaders are always linked in the same order
+      std::sort(paths.begin(), paths.end());
+      return kdl::fold_results(kdl::vec_transform(paths, [&](const auto& path) {
+        return m_fs.openFile(path).transform(
+          [&](auto file) { return ShaderFile{path, std::move(file)}; });
+      }));
     })
-    .transform([&](auto nestedShaders) {
+    .transform([&](auto shaderFiles) {
+      auto statuses = std::vector<SimpleParserStatus>{};
+      auto bufferedStatuses = std::vector<BufferedParserStatus>{};
+      statuses.reserve(shaderFiles.size());
+      bufferedStatuses.reserve(shaderFiles.size());
+      for (const auto& shaderFile : shaderFiles)
+      {
+        bufferedStatuses.emplace_back(
+          statuses.emplace_back(m_logger, shaderFile.path.string()));
+      }
+
+      auto parseResults = std::vector<ParseResult>(shaderFiles.size());
+      kdl::parallel_for(shaderFiles.size(), [&](const size_t i) {
+        parseResults[i] = parseShaderFile(shaderFiles[i], bufferedStatuses[i]);
+      });
+
+      auto nestedShaders = std::vector<std::vector<Assets::Quake3Shader>>{};
+      nestedShaders.reserve(shaderFiles.size());
+      for (size_t i = 0; i < shaderFiles.size(); ++i)
+      {
+        bufferedStatuses[i].flush();
+
+        auto& parseResult = parseResults[i];
+        if (parseResult.error)
+        {
+          m_logger.warn() << "Skipping malformed shader file " << shaderFiles[i].path
+                          << ": " << *parseResult.error;
+        }
+        else
+        {
+          nestedShaders.push_back(std::move(parseResult.shaders));
+        }
+      }
+
       auto allShaders = kdl::vec_flatten(std::move(nestedShaders));
+
       m_logger.info() << "Loaded " << allShaders.size() << " shaders";
       return allShaders;
     });
@@ -122,6 +176,16 @@ void Quake3ShaderFileSystem::linkTextures(
   std::vector<Assets::Quake3Shader>& shaders)
 {
   m_logger.debug() << "Linking textures...";
+
+  // index the shaders by path once instead of searching them for every texture; if
+  // several shaders have the same path, the first one is linked
+  auto shaderIndices = std::map<std::filesystem::path, size_t>{};
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    shaderIndices.emplace(shaders[i].shaderPath, i);
+  }
+
+  auto linked = std::vector<bool>(shaders.size(), false);
   for (const auto& texture : textures)
   {
     const auto shaderPath = kdl::path_remove_extension(texture);
@@ -129,27 +193,22 @@ void Quake3ShaderFileSystem::linkTextures(
     // Only link a shader if it has not been linked yet.
     if (pathInfo(shaderPath) != PathInfo::File)
     {
-      const auto shaderIt =
-        std::find_if(shaders.begin(), shaders.end(), [&shaderPath](const auto& shader) {
-          return shaderPath == shader.shaderPath;
-        });
-
-      if (shaderIt != std::end(shaders))
+      const auto shaderIt = shaderIndices.find(shaderPath);
+      if (shaderIt != shaderIndices.end())
       {
         // Found a matching shader.
-        auto& shader = *shaderIt;
+        const auto index = shaderIt->second;
 
         auto shaderFile = std::static_pointer_cast<File>(
-          std::make_shared<ObjectFile<Assets::Quake3Shader>>(shader));
+          std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaders[index]));
         addFile(
           shaderPath,
           [shaderFile = std::move(shaderFile)]() -> Result<std::shared_ptr<File>> {
             return shaderFile;
           });
 
-        // Remove the shader so that we don't revisit it when linking standalone
-        // shaders.
-        shaders.erase(shaderIt);
+        // Mark the shader so that we don't revisit it when linking standalone shaders.
+        linked[index] = true;
       }
       else
       {
@@ -163,6 +222,17 @@ void Quake3ShaderFileSystem::linkTextures(
       }
     }
   }
+
+  auto unlinkedShaders = std::vector<Assets::Quake3Shader>{};
+  unlinkedShaders.reserve(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    if (!linked[i])
+    {
+      unlinkedShaders.push_back(std::move(shaders[i]));
+    }
+  }
+  shaders = std::move(unlinkedShaders);
 }
 
 void Quake3ShaderFileSystem::linkStandaloneShaders(
@@ -216,7 +216,7 @@ void Quake3ShaderParser::parseBodyEntry(
   else if (key == "surfaceparm")
   {
     token = expect(Quake3ShaderToken::String, m_tokenizer.nextToken());
-    shader.surfaceParms.insert(token.data());
+    shader.surfaceParms.insert(std::string{token.data()});
   }
   else if (key == "cull")
   {
@@ -274,13 +274,17 @@ void Quake3ShaderParser::parseStageEntry(
       {
         valid = false;
         status.warn(
-          line, param1Column, "Unknown blendFunc source factor '" + param1 + "'");
+          line,
+          param1Column,
+          "Unknown blendFunc source factor '" + std::string{param1} + "'");
       }
       if (!stage.blendFunc.validateDestFactor())
       {
         valid = false;
         status.warn(
-          line, param2Column, "Unknown blendFunc destination factor '" + param2 + "'");
+          line,
+          param2Column,
+          "Unknown blendFunc destination factor '" + std::string{param2} + "'");
       }
       if (!valid)
       {
@@ -307,7 +311,8 @@ void Quake3ShaderParser::parseStageEntry(
       }
       else
       {
-        status.warn(line, param1Column, "Unknown blendFunc name '" + param1 + "'");
+        status.warn(
+          line, param1Column, "Unknown blendFunc name '" + std::string{param1} + "'");
       }
     }
   }
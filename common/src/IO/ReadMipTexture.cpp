@@ -96,10 +96,15 @@ Result<Assets::Texture, ReadTextureError> readMipTexture(
                                ? Assets::PaletteTransparency::Index255Transparent
                                : Assets::PaletteTransparency::Opaque;
 
-    Assets::setMipBufferSize(buffers, MipLevels, width, height, GL_RGBA);
+    // only the first mip level of masked textures is uploaded, so the others are not
+    // decoded at all
+    const auto mipLevelsToDecode =
+      transparent == Assets::PaletteTransparency::Index255Transparent ? size_t(1)
+                                                                      : MipLevels;
+    Assets::setMipBufferSize(buffers, mipLevelsToDecode, width, height, GL_RGBA);
     return getMipPalette(reader)
       .and_then([&](const auto& palette) {
-        for (size_t i = 0; i < MipLevels; ++i)
+        for (size_t i = 0; i < mipLevelsToDecode; ++i)
         {
           reader.seekFromBegin(offset[i]);
           const auto size = mipSize(width, height, i);
@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ShaderProgramCache.h"
+
+#include "Error.h"
+#include "IO/ContentHash.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/PathInfo.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <kdl/result.h>
+
+#include <fstream>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr auto Magic = std::string_view{"TBSP"};
+constexpr auto Version = std::uint32_t(1);
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::optional<ProgramBinary> readCachedProgram(Reader& reader, const std::string_view key)
+{
+  if (reader.readString(Magic.size()) != Magic)
+  {
+    return std::nullopt;
+  }
+  if (reader.readUnsignedInt<std::uint32_t>() != Version)
+  {
+    return std::nullopt;
+  }
+  if (
+    reader.readSize<std::uint64_t>() != key.size()
+    || reader.readSize<std::uint64_t>() != hashContents(key))
+  {
+    return std::nullopt;
+  }
+
+  const auto format = reader.readUnsignedInt<std::uint32_t>();
+  const auto size = reader.readSize<std::uint64_t>();
+  if (size == 0 || size != reader.size() - reader.position())
+  {
+    return std::nullopt;
+  }
+
+  auto data = std::vector<unsigned char>(size);
+  reader.read(reinterpret_cast<char*>(data.data()), data.size());
+  return ProgramBinary{format, std::move(data)};
+}
+
+} // namespace
+
+ShaderProgramCache::ShaderProgramCache(std::filesystem::path directory)
+  : m_directory{std::move(directory)}
+{
+}
+
+const std::filesystem::path& ShaderProgramCache::directory() const
+{
+  return m_directory;
+}
+
+std::filesystem::path ShaderProgramCache::cachePath(const std::string& programName) const
+{
+  return m_directory / (programName + ".tbprog");
+}
+
+std::optional<ProgramBinary> ShaderProgramCache::readProgram(
+  const std::string& programName, const std::string_view key) const
+{
+  const auto path = cachePath(programName);
+  if (Disk::pathInfo(path) != PathInfo::File)
+  {
+    return std::nullopt;
+  }
+
+  return Disk::openFileForReading(path)
+    .transform([&](auto file) -> std::optional<ProgramBinary> {
+      try
+      {
+        auto reader = file->reader();
+        return readCachedProgram(reader, key);
+      }
+      catch (const ReaderException&)
+      {
+        return std::nullopt;
+      }
+    })
+    .value_or(std::nullopt);
+}
+
+Result<void> ShaderProgramCache::writeProgram(
+  const std::string& programName,
+  const std::string_view key,
+  const ProgramBinary& binary) const
+{
+  const auto path = cachePath(programName);
+  auto tempPath = path;
+  tempPath += ".tmp";
+
+  // write to a temporary file first so that no partially written file is ever read
+  return Disk::createDirectory(m_directory)
+    .and_then([&](auto) {
+      return Disk::withOutputStream(
+        tempPath, std::ios::out | std::ios::binary, [&](auto& stream) {
+          stream.write(Magic.data(), std::streamsize(Magic.size()));
+          write(stream, Version);
+          write(stream, std::uint64_t(key.size()));
+          write(stream, hashContents(key));
+          write(stream, binary.format);
+          write(stream, std::uint64_t(binary.data.size()));
+          stream.write(
+            reinterpret_cast<const char*>(binary.data.data()),
+            std::streamsize(binary.data.size()));
+        });
+    })
+    .and_then([&]() { return Disk::moveFile(tempPath, path); });
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "Result.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * A linked shader program in one of the driver specific formats of
+ * GL_ARB_get_program_binary.
+ */
+struct ProgramBinary
+{
+  std::uint32_t format;
+  std::vector<unsigned char> data;
+};
+
+/**
+ * A directory of linked shader programs, so that the shaders do not need to be compiled
+ * and linked again every time the application starts.
+ *
+ * Program binaries can only be loaded by the driver that created them. Each program is
+ * stored in a file named after it, together with the size and a hash of a key that
+ * identifies the driver and the program's shader sources. A cached program is only used
+ * if it was stored with the same key. Unreadable or outdated cache files are ignored and
+ * overwritten.
+ */
+class ShaderProgramCache
+{
+private:
+  std::filesystem::path m_directory;
+
+public:
+  explicit ShaderProgramCache(std::filesystem::path directory);
+
+  const std::filesystem::path& directory() const;
+
+  /**
+   * Returns the path of the cache file for the program with the given name.
+   */
+  std::filesystem::path cachePath(const std::string& programName) const;
+
+  /**
+   * Reads the cached binary of the given program. Returns std::nullopt if there is no
+   * cached binary or if it was stored with a different key.
+   */
+  std::optional<ProgramBinary> readProgram(
+    const std::string& programName, std::string_view key) const;
+
+  /**
+   * Writes the given program binary to the cache.
+   */
+  Result<void> writeProgram(
+    const std::string& programName,
+    std::string_view key,
+    const ProgramBinary& binary) const;
+};
+
+} // namespace TrenchBroom::IO
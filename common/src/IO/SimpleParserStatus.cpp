@@ -26,10 +26,15 @@ namespace TrenchBroom
 namespace IO
 {
 SimpleParserStatus::SimpleParserStatus(Logger& logger, const std::string& prefix)
-  : ParserStatus(logger, prefix)
+  : ParserStatus(logger, prefix, MaxRepeatedMessages)
 {
 }
 
+SimpleParserStatus::~SimpleParserStatus()
+{
+  logSuppressedMessages();
+}
+
 void SimpleParserStatus::doProgress(const double /* progress */) {}
 } // namespace IO
 } // namespace TrenchBroom
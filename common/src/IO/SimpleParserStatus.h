@@ -27,10 +27,17 @@ namespace TrenchBroom
 {
 namespace IO
 {
+/**
+ * A parser status that logs at most MaxRepeatedMessages messages with the same text and
+ * summarizes the others when it is destroyed.
+ */
 class SimpleParserStatus : public ParserStatus
 {
 public:
+  static constexpr size_t MaxRepeatedMessages = 10;
+
   explicit SimpleParserStatus(Logger& logger, const std::string& prefix = "");
+  ~SimpleParserStatus() override;
 
 private:
   void doProgress(double progress) override;
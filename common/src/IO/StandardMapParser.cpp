@@ -29,6 +29,9 @@
 #include <vecmath/plane.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -42,15 +45,19 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(std::string_view str)
-  : Tokenizer(std::move(str), "\"", '\\')
+QuakeMapTokenizer::QuakeMapTokenizer(std::string_view str, const size_t line)
+  : Tokenizer(std::move(str), "\"", '\\', line)
   , m_skipEol(true)
 {
 }
 
 void QuakeMapTokenizer::setSkipEol(bool skipEol)
 {
-  m_skipEol = skipEol;
+  if (m_skipEol != skipEol)
+  {
+    m_skipEol = skipEol;
+    discardPeekedToken();
+  }
 }
 
 QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
@@ -160,8 +167,9 @@ const std::string StandardMapParser::PatchId = "patchDef2";
 StandardMapParser::StandardMapParser(
   std::string_view str,
   const Model::MapFormat sourceMapFormat,
-  const Model::MapFormat targetMapFormat)
-  : m_tokenizer(QuakeMapTokenizer(std::move(str)))
+  const Model::MapFormat targetMapFormat,
+  const size_t startLine)
+  : m_tokenizer(QuakeMapTokenizer(std::move(str), startLine))
   , m_sourceMapFormat(sourceMapFormat)
   , m_targetMapFormat(targetMapFormat)
 {
@@ -272,17 +280,17 @@ void StandardMapParser::parseEntityProperty(
 {
   auto token = m_tokenizer.nextToken();
   assert(token.type() == QuakeMapToken::String);
-  const auto name = token.data();
+  auto name = std::string{token.data()};
 
   const auto line = token.line();
   const auto column = token.column();
 
   expect(QuakeMapToken::String, token = m_tokenizer.nextToken());
-  const auto value = token.data();
+  auto value = std::string{token.data()};
 
   if (keys.count(name) == 0)
   {
-    properties.push_back(Model::EntityProperty(name, value));
+    properties.push_back(Model::EntityProperty(name, std::move(value)));
     keys.insert(name);
   }
   else
@@ -778,5 +786,209 @@ StandardMapParser::TokenNameMap StandardMapParser::tokenNames() const
   names[Eof] = "end of file";
   return names;
 }
+
+namespace
+{
+// enough for the worldspawn properties and the first few brushes of most maps
+constexpr auto MaxDetectionLength = size_t(1) << 16;
+constexpr auto MaxDetectionFaceCount = size_t(16);
+
+/**
+ * The syntax of a brush face: whether it has Valve texture axes, and the number of
+ * values following the texture name or axes.
+ */
+struct FaceSyntax
+{
+  bool valve;
+  size_t valueCount;
+};
+
+struct MapSyntax
+{
+  bool brushPrimitivesOrPatches = false;
+  std::vector<FaceSyntax> faces;
+};
+
+bool skipVector(
+  QuakeMapTokenizer& tokenizer,
+  const QuakeMapToken::Type o,
+  const QuakeMapToken::Type c,
+  const size_t size)
+{
+  if (!tokenizer.nextToken().hasType(o))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (!tokenizer.nextToken().hasType(QuakeMapToken::Number))
+    {
+      return false;
+    }
+  }
+  return tokenizer.nextToken().hasType(c);
+}
+
+/**
+ * Reads the remainder of a face whose first opening parenthesis was consumed. Returns
+ * std::nullopt if the face is malformed or cut off by the end of the string.
+ */
+std::optional<FaceSyntax> readFaceSyntax(QuakeMapTokenizer& tokenizer)
+{
+  using namespace QuakeMapToken;
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (!tokenizer.nextToken().hasType(Number))
+    {
+      return std::nullopt;
+    }
+  }
+  if (
+    !tokenizer.nextToken().hasType(CParenthesis)
+    || !skipVector(tokenizer, OParenthesis, CParenthesis, 3)
+    || !skipVector(tokenizer, OParenthesis, CParenthesis, 3))
+  {
+    return std::nullopt;
+  }
+
+  // the texture name is read like StandardMapParser::parseTextureName does
+  tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
+
+  auto face = FaceSyntax{false, 0};
+  if (tokenizer.peekToken().hasType(OBracket))
+  {
+    if (
+      !skipVector(tokenizer, OBracket, CBracket, 4)
+      || !skipVector(tokenizer, OBracket, CBracket, 4))
+    {
+      return std::nullopt;
+    }
+    face.valve = true;
+  }
+
+  while (!tokenizer.peekToken().hasType(OParenthesis | CBrace))
+  {
+    if (tokenizer.nextToken().hasType(Eof))
+    {
+      return std::nullopt;
+    }
+    ++face.valueCount;
+  }
+
+  return face;
+}
+
+MapSyntax readMapSyntax(const std::string_view str)
+{
+  using namespace QuakeMapToken;
+
+  auto syntax = MapSyntax{};
+  auto tokenizer = QuakeMapTokenizer{str.substr(0, MaxDetectionLength)};
+
+  try
+  {
+    auto depth = size_t(0);
+    auto token = tokenizer.nextToken();
+    while (!token.hasType(Eof) && syntax.faces.size() < MaxDetectionFaceCount)
+    {
+      if (token.hasType(OBrace))
+      {
+        ++depth;
+      }
+      else if (token.hasType(CBrace))
+      {
+        if (depth == 0 || (--depth == 0 && !syntax.faces.empty()))
+        {
+          break;
+        }
+      }
+      else if (depth == 2 && token.hasType(String))
+      {
+        if (token.data() == "brushDef" || token.data() == "patchDef2")
+        {
+          syntax.brushPrimitivesOrPatches = true;
+          break;
+        }
+      }
+      else if (depth == 2 && token.hasType(OParenthesis))
+      {
+        const auto face = readFaceSyntax(tokenizer);
+        if (!face)
+        {
+          break;
+        }
+        syntax.faces.push_back(*face);
+      }
+
+      token = tokenizer.nextToken();
+    }
+  }
+  catch (const ParserException&)
+  {
+    // the faces read so far are used
+  }
+
+  return syntax;
+}
+
+bool canParse(const Model::MapFormat mapFormat, const FaceSyntax& face)
+{
+  // the values following the texture name or axes that each format accepts; the extra
+  // values are optional in all formats that have them
+  const auto& [valve, valueCount] = face;
+  switch (mapFormat)
+  {
+  case Model::MapFormat::Standard:
+    return !valve && valueCount == 5;
+  case Model::MapFormat::Quake2:
+  case Model::MapFormat::Quake3_Legacy:
+  case Model::MapFormat::Quake3:
+    return !valve && (valueCount == 5 || valueCount == 8);
+  case Model::MapFormat::Hexen2:
+    return !valve && (valueCount == 5 || valueCount == 6);
+  case Model::MapFormat::Daikatana:
+    return !valve && (valueCount == 5 || valueCount == 8 || valueCount == 11);
+  case Model::MapFormat::Valve:
+    return valve && valueCount == 3;
+  case Model::MapFormat::Quake2_Valve:
+  case Model::MapFormat::Quake3_Valve:
+    return valve && (valueCount == 3 || valueCount == 6);
+  case Model::MapFormat::Unknown:
+    return false;
+    switchDefault();
+  }
+}
+
+bool canParse(const Model::MapFormat mapFormat, const MapSyntax& syntax)
+{
+  if (syntax.brushPrimitivesOrPatches)
+  {
+    return mapFormat == Model::MapFormat::Quake3;
+  }
+  return std::all_of(syntax.faces.begin(), syntax.faces.end(), [&](const auto& face) {
+    return canParse(mapFormat, face);
+  });
+}
+} // namespace
+
+std::vector<Model::MapFormat> detectMapFormats(
+  const std::string_view str, const std::vector<Model::MapFormat>& mapFormats)
+{
+  const auto syntax = readMapSyntax(str);
+  if (!syntax.brushPrimitivesOrPatches && syntax.faces.empty())
+  {
+    return mapFormats;
+  }
+
+  auto result = std::vector<Model::MapFormat>{};
+  std::copy_if(
+    mapFormats.begin(),
+    mapFormats.end(),
+    std::back_inserter(result),
+    [&](const auto mapFormat) { return canParse(mapFormat, syntax); });
+
+  return !result.empty() ? result : mapFormats;
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -64,7 +64,7 @@ private:
   bool m_skipEol;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -95,11 +95,13 @@ public:
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param startLine the line number of the first line of the given string
    */
   StandardMapParser(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
-    Model::MapFormat targetMapFormat);
+    Model::MapFormat targetMapFormat,
+    size_t startLine = 1);
 
   ~StandardMapParser() override;
 
@@ -157,5 +159,16 @@ private:
 private: // implement Parser interface
   TokenNameMap tokenNames() const override;
 };
+
+/**
+ * Returns those of the given map formats that can parse the brushes at the beginning of
+ * the given string, in the given order. Only a bounded prefix of the string is inspected,
+ * and only up to the end of the first entity that contains brushes.
+ *
+ * If the prefix contains no brushes or none of the given formats can parse them, all
+ * given formats are returned so that parsing reports the errors.
+ */
+std::vector<Model::MapFormat> detectMapFormats(
+  std::string_view str, const std::vector<Model::MapFormat>& mapFormats);
 } // namespace IO
 } // namespace TrenchBroom
@@ -0,0 +1,205 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCache.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Color.h"
+#include "Error.h"
+#include "IO/ContentHash.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/PathInfo.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <kdl/result.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr auto Magic = std::string_view{"TBTC"};
+constexpr auto Version = std::uint32_t(1);
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::ostream& stream, const size_t value)
+{
+  write(stream, std::uint64_t(value));
+}
+
+/**
+ * Reads a size and checks that the remaining input can hold that many bytes, so that a
+ * damaged file cannot cause huge allocations.
+ */
+size_t readByteCount(Reader& reader)
+{
+  const auto count = reader.readSize<std::uint64_t>();
+  if (count > reader.size() - reader.position())
+  {
+    throw ReaderException{"Invalid byte count"};
+  }
+  return count;
+}
+
+std::optional<Assets::Texture> readCachedTexture(
+  Reader& reader, std::string name, const std::string_view sourceContents)
+{
+  if (reader.readString(Magic.size()) != Magic)
+  {
+    return std::nullopt;
+  }
+  if (reader.readUnsignedInt<std::uint32_t>() != Version)
+  {
+    return std::nullopt;
+  }
+  if (
+    reader.readSize<std::uint64_t>() != sourceContents.size()
+    || reader.readSize<std::uint64_t>() != hashContents(sourceContents))
+  {
+    return std::nullopt;
+  }
+
+  const auto width = reader.readSize<std::uint64_t>();
+  const auto height = reader.readSize<std::uint64_t>();
+  const auto averageColor = Color{reader.readVec<float, 4>()};
+  const auto format = GLenum(reader.readUnsignedInt<std::uint32_t>());
+  const auto type = static_cast<Assets::TextureType>(reader.readInt<std::int32_t>());
+
+  const auto mipCount = readByteCount(reader);
+  auto buffers = Assets::TextureBufferList{};
+  buffers.reserve(mipCount);
+  for (size_t i = 0; i < mipCount; ++i)
+  {
+    auto& buffer = buffers.emplace_back(readByteCount(reader));
+    reader.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+  }
+
+  return Assets::Texture{
+    std::move(name), width, height, averageColor, std::move(buffers), format, type};
+}
+
+std::string hexString(const std::uint64_t value)
+{
+  auto str = std::stringstream{};
+  str << std::hex << std::setw(16) << std::setfill('0') << value;
+  return str.str();
+}
+
+} // namespace
+
+TextureCache::TextureCache(std::filesystem::path directory)
+  : m_directory{std::move(directory)}
+{
+}
+
+const std::filesystem::path& TextureCache::directory() const
+{
+  return m_directory;
+}
+
+std::filesystem::path TextureCache::cachePath(
+  const std::filesystem::path& sourcePath) const
+{
+  const auto sourcePathStr = sourcePath.generic_u8string();
+  const auto hash = hashContents(std::string_view{
+    reinterpret_cast<const char*>(sourcePathStr.data()), sourcePathStr.size()});
+  return m_directory / (hexString(hash) + ".tbtex");
+}
+
+std::optional<Assets::Texture> TextureCache::readTexture(
+  std::string name,
+  const std::filesystem::path& sourcePath,
+  const std::string_view sourceContents) const
+{
+  const auto path = cachePath(sourcePath);
+  if (Disk::pathInfo(path) != PathInfo::File)
+  {
+    return std::nullopt;
+  }
+
+  return Disk::openFileForReading(path)
+    .transform([&](auto file) -> std::optional<Assets::Texture> {
+      try
+      {
+        auto reader = file->reader();
+        return readCachedTexture(reader, std::move(name), sourceContents);
+      }
+      catch (const ReaderException&)
+      {
+        return std::nullopt;
+      }
+    })
+    .value_or(std::nullopt);
+}
+
+Result<void> TextureCache::writeTexture(
+  const Assets::Texture& texture,
+  const std::filesystem::path& sourcePath,
+  const std::string_view sourceContents) const
+{
+  const auto path = cachePath(sourcePath);
+  auto tempPath = path;
+  tempPath += ".tmp";
+
+  // write to a temporary file first so that no partially written file is ever read
+  return Disk::createDirectory(m_directory)
+    .and_then([&](auto) {
+      return Disk::withOutputStream(
+        tempPath, std::ios::out | std::ios::binary, [&](auto& stream) {
+          stream.write(Magic.data(), std::streamsize(Magic.size()));
+          write(stream, Version);
+          writeSize(stream, sourceContents.size());
+          write(stream, hashContents(sourceContents));
+
+          writeSize(stream, texture.width());
+          writeSize(stream, texture.height());
+          for (size_t i = 0; i < 4; ++i)
+          {
+            write(stream, texture.averageColor()[i]);
+          }
+          write(stream, std::uint32_t(texture.format()));
+          write(stream, std::int32_t(texture.type()));
+
+          const auto& buffers = texture.buffersIfUnprepared();
+          writeSize(stream, buffers.size());
+          for (const auto& buffer : buffers)
+          {
+            writeSize(stream, buffer.size());
+            stream.write(
+              reinterpret_cast<const char*>(buffer.data()),
+              std::streamsize(buffer.size()));
+          }
+        });
+    })
+    .and_then([&]() { return Disk::moveFile(tempPath, path); });
+}
+
+} // namespace TrenchBroom::IO
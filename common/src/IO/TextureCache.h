@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom::Assets
+{
+class Texture;
+}
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * A directory of decoded textures, so that textures stored in image formats that are
+ * expensive to decode do not need to be decoded again every time they are loaded.
+ *
+ * Each texture is stored in a file whose name is derived from the texture's path in the
+ * game file system. The file records the size and a hash of the encoded source data, so a
+ * cached texture is only used if its source has not changed. The source remains the source
+ * of truth; unreadable or outdated cache files are ignored and overwritten.
+ *
+ * The cache files of different textures are independent, so textures can be read from and
+ * written to the cache on several threads at once.
+ */
+class TextureCache
+{
+private:
+  std::filesystem::path m_directory;
+
+public:
+  explicit TextureCache(std::filesystem::path directory);
+
+  const std::filesystem::path& directory() const;
+
+  /**
+   * Returns the path of the cache file for the texture at the given source path.
+   */
+  std::filesystem::path cachePath(const std::filesystem::path& sourcePath) const;
+
+  /**
+   * Reads the cached texture for the given source path. Returns std::nullopt if there is
+   * no cached texture or if it was created from different source contents.
+   *
+   * @param name the name of the returned texture
+   * @param sourcePath the path of the texture in the game file system
+   * @param sourceContents the encoded texture data
+   */
+  std::optional<Assets::Texture> readTexture(
+    std::string name,
+    const std::filesystem::path& sourcePath,
+    std::string_view sourceContents) const;
+
+  /**
+   * Writes the given texture to the cache. Only the texture's image data and the
+   * properties that are determined by it are stored.
+   *
+   * @param texture the texture to write, must not be prepared
+   * @param sourcePath the path of the texture in the game file system
+   * @param sourceContents the encoded texture data
+   */
+  Result<void> writeTexture(
+    const Assets::Texture& texture,
+    const std::filesystem::path& sourcePath,
+    std::string_view sourceContents) const;
+};
+
+} // namespace TrenchBroom::IO
@@ -19,15 +19,77 @@
 
 #pragma once
 
-#include <kdl/string_utils.h>
-
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace TrenchBroom
 {
 namespace IO
 {
+namespace detail
+{
+/**
+ * Parses a number from the beginning of the given string without copying it. Like
+ * std::stol and std::stod, a leading plus sign is accepted and trailing characters are
+ * ignored. Returns an empty optional if the string does not start with a number or if
+ * the number is out of range.
+ */
+inline std::optional<long> parseTokenInteger(std::string_view str)
+{
+  if (str.size() > 1 && str.front() == '+' && str[1] != '-')
+  {
+    str.remove_prefix(1);
+  }
+
+  auto value = 0l;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+  return ec == std::errc{} ? std::optional{value} : std::nullopt;
+}
+
+inline std::optional<double> parseTokenFloat(std::string_view str)
+{
+#if defined(__cpp_lib_to_chars)
+  if (str.size() > 1 && str.front() == '+' && str[1] != '-')
+  {
+    str.remove_prefix(1);
+  }
+
+  auto value = 0.0;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+  return ec == std::errc{} ? std::optional{value} : std::nullopt;
+#else
+  // some standard libraries do not implement from_chars for floating point types, so
+  // fall back to strtod, which needs a null terminated copy of the string; numbers are
+  // short enough to fit into a buffer on the stack
+  constexpr auto BufferSize = size_t(64);
+  auto buffer = std::array<char, BufferSize>{};
+  auto string = std::string{};
+  auto* data = buffer.data();
+  if (str.size() < BufferSize)
+  {
+    std::copy(str.begin(), str.end(), buffer.begin());
+  }
+  else
+  {
+    string = std::string{str};
+    data = string.data();
+  }
+
+  char* end = nullptr;
+  errno = 0;
+  const auto value = std::strtod(data, &end);
+  return end != data && errno != ERANGE ? std::optional{value} : std::nullopt;
+#endif
+}
+} // namespace detail
+
 template <typename Type>
 class TokenTemplate
 {
@@ -75,7 +137,11 @@ public:
 
   const char* end() const { return m_end; }
 
-  const std::string data() const { return std::string(m_begin, length()); }
+  /**
+   * Returns the text of this token as a view into the tokenized string, which must
+   * outlive the returned view.
+   */
+  std::string_view data() const { return std::string_view(m_begin, length()); }
 
   size_t position() const { return m_position; }
 
@@ -88,13 +154,13 @@ public:
   template <typename T>
   T toFloat() const
   {
-    return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
+    return static_cast<T>(detail::parseTokenFloat(data()).value_or(0.0));
   }
 
   template <typename T>
   T toInteger() const
   {
-    return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
+    return static_cast<T>(detail::parseTokenInteger(data()).value_or(0l));
   }
 };
 } // namespace IO
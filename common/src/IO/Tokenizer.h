@@ -26,14 +26,96 @@
 #include <kdl/string_format.h>
 
 #include <cassert>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TB_TOKENIZER_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 namespace TrenchBroom
 {
 namespace IO
 {
+namespace detail
+{
+#if defined(TB_TOKENIZER_SSE2)
+inline size_t countTrailingZeros(const unsigned int mask)
+{
+  assert(mask != 0u);
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return static_cast<size_t>(index);
+#else
+  return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+/**
+ * Returns a pointer to the first character in [begin, end) that is contained in the given
+ * set of characters, or, if Contained is false, that is not contained in the given set.
+ * Returns end if there is no such character.
+ *
+ * If SSE2 is available, 16 characters are compared against the set at a time.
+ */
+template <bool Contained>
+const char* findFirstOf(const char* begin, const char* end, std::string_view chars)
+{
+  const auto isContained = [&](const char c) {
+    return chars.find(c) != std::string_view::npos;
+  };
+
+  auto* cur = begin;
+#if defined(TB_TOKENIZER_SSE2)
+  constexpr auto BlockSize = 16;
+  constexpr auto MaxChars = size_t(16);
+  if (chars.size() <= MaxChars)
+  {
+    __m128i needles[MaxChars];
+    for (size_t i = 0; i < chars.size(); ++i)
+    {
+      needles[i] = _mm_set1_epi8(chars[i]);
+    }
+
+    while (end - cur >= BlockSize)
+    {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+      auto matches = _mm_setzero_si128();
+      for (size_t i = 0; i < chars.size(); ++i)
+      {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+      }
+
+      auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+      if constexpr (!Contained)
+      {
+        mask = ~mask & 0xFFFFu;
+      }
+      if (mask != 0u)
+      {
+        return cur + countTrailingZeros(mask);
+      }
+      cur += BlockSize;
+    }
+  }
+#endif
+
+  while (cur < end && isContained(*cur) != Contained)
+  {
+    ++cur;
+  }
+  return cur;
+}
+} // namespace detail
+
 struct TokenizerState
 {
   const char* cur;
@@ -42,6 +124,12 @@ struct TokenizerState
   bool escaped;
 };
 
+inline bool operator==(const TokenizerState& lhs, const TokenizerState& rhs)
+{
+  return lhs.cur == rhs.cur && lhs.line == rhs.line && lhs.column == rhs.column
+         && lhs.escaped == rhs.escaped;
+}
+
 struct TokenizerStateAndSource
 {
   TokenizerState state;
@@ -57,6 +145,8 @@ protected:
   std::string m_escapableChars;
   char m_escapeChar;
   TokenizerState m_state;
+  // incremented whenever the tokenized string is replaced
+  size_t m_sourceVersion{0};
 
 public:
   TokenizerBase(
@@ -78,6 +168,7 @@ public:
   {
     m_begin = str.data();
     m_end = str.data() + str.length();
+    ++m_sourceVersion;
     // preserve m_escapableChars and m_escapeChar
     reset();
   }
@@ -91,6 +182,7 @@ public:
     m_state = snapshot.state;
     m_begin = snapshot.begin;
     m_end = snapshot.end;
+    ++m_sourceVersion;
   }
 
 protected:
@@ -140,6 +232,45 @@ protected:
     }
   }
 
+  /**
+   * Advances to the given position, which must not be past the end of the input. Has the
+   * same effect as calling advance() for every character up to the given position, but
+   * only the line breaks are visited individually.
+   */
+  void advanceTo(const char* target)
+  {
+    assert(target >= m_state.cur);
+    assert(target <= m_end);
+
+    while (m_state.cur < target)
+    {
+      const auto* lineBreak = detail::findFirstOf<true>(m_state.cur, target, "\n\r");
+      if (lineBreak > m_state.cur)
+      {
+        // within a line, a character is escaped if it follows an odd number of escape
+        // characters, so only the trailing escape characters of the run matter
+        const auto length = static_cast<size_t>(lineBreak - m_state.cur);
+        auto trailingEscapeChars = size_t(0);
+        while (trailingEscapeChars < length
+               && *(lineBreak - trailingEscapeChars - 1) == m_escapeChar)
+        {
+          ++trailingEscapeChars;
+        }
+
+        const auto oddEscapeChars = trailingEscapeChars % 2 == 1;
+        m_state.escaped = trailingEscapeChars == length ? m_state.escaped != oddEscapeChars
+                                                        : oddEscapeChars;
+        m_state.column += length;
+        m_state.cur = lineBreak;
+      }
+
+      if (m_state.cur < target)
+      {
+        advance();
+      }
+    }
+  }
+
   void advance()
   {
     errorIfEof();
@@ -238,6 +369,22 @@ private:
     ~SaveAndRestoreState() { m_target = m_snapshot; }
   };
 
+  /**
+   * The token that was last peeked, together with the states before and after it. Parsers
+   * usually peek at a token before consuming it, so the next call to nextToken can adopt
+   * the state after the token instead of tokenizing it again.
+   */
+  struct PeekedToken
+  {
+    size_t sourceVersion;
+    TokenizerState stateBefore;
+    TokenType skipTokens;
+    Token token;
+    TokenizerState stateAfter;
+  };
+
+  std::optional<PeekedToken> m_peekedToken;
+
 public:
   static const std::string& Whitespace()
   {
@@ -261,18 +408,27 @@ public:
 
   Token nextToken(const TokenType skipTokens = 0u)
   {
-    auto token = emitToken();
-    while (token.hasType(skipTokens))
+    if (isPeekedToken(skipTokens))
     {
-      token = emitToken();
+      m_state = m_peekedToken->stateAfter;
+      return m_peekedToken->token;
     }
-    return token;
+
+    return readToken(skipTokens);
   }
 
   Token peekToken(const TokenType skipTokens = 0u)
   {
-    SaveAndRestoreState oldState(m_state);
-    return nextToken(skipTokens);
+    if (!isPeekedToken(skipTokens))
+    {
+      SaveAndRestoreState oldState(m_state);
+      const auto stateBefore = m_state;
+      auto token = readToken(skipTokens);
+      m_peekedToken =
+        PeekedToken{m_sourceVersion, stateBefore, skipTokens, token, m_state};
+    }
+
+    return m_peekedToken->token;
   }
 
   void skipToken(const TokenType skipTokens = ~0u)
@@ -351,6 +507,11 @@ public:
   void restore(const TokenizerState& snapshot) { m_state = snapshot; }
 
 protected:
+  /**
+   * Must be called by subclasses whenever they change how tokens are emitted.
+   */
+  void discardPeekedToken() { m_peekedToken = std::nullopt; }
+
   const char* curPos() const { return m_state.cur; }
 
   char curChar() const
@@ -452,28 +613,34 @@ protected:
   {
     if (!eof())
     {
-      do
-      {
-        advance();
-      } while (!eof() && !isAnyOf(curChar(), delims));
+      advance();
+      advanceTo(detail::findFirstOf<true>(curPos(), m_end, delims));
     }
     return curPos();
   }
 
   const char* readWhile(std::string_view allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
-    {
-      advance();
-    }
+    advanceTo(detail::findFirstOf<false>(curPos(), m_end, allow));
     return curPos();
   }
 
   const char* readQuotedString(
     const char delim = '"', std::string_view hackDelims = std::string_view())
   {
-    while (!eof() && (curChar() != delim || isEscaped()))
+    // only these characters can end the string or change whether it ends, so everything
+    // in between can be skipped at once
+    const char stopChars[] = {delim, m_escapeChar, '"'};
+    const auto stops = std::string_view{stopChars, sizeof(stopChars)};
+
+    while (true)
     {
+      advanceTo(detail::findFirstOf<true>(curPos(), m_end, stops));
+      if (eof() || (curChar() == delim && !isEscaped()))
+      {
+        break;
+      }
+
       // This is a hack to handle paths with trailing backslashes that get misinterpreted
       // as escaped double quotation marks.
       if (
@@ -493,19 +660,13 @@ protected:
 
   const char* discardWhile(std::string_view allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
-    {
-      advance();
-    }
+    advanceTo(detail::findFirstOf<false>(curPos(), m_end, allow));
     return curPos();
   }
 
   const char* discardUntil(std::string_view delims)
   {
-    while (!eof() && !isAnyOf(curChar(), delims))
-    {
-      advance();
-    }
+    advanceTo(detail::findFirstOf<true>(curPos(), m_end, delims));
     return curPos();
   }
 
@@ -532,9 +693,12 @@ protected:
       return curPos();
     }
 
+    const auto first = pattern.substr(0, 1);
+    advanceTo(detail::findFirstOf<true>(curPos(), m_end, first));
     while (!eof() && !matchesPattern(pattern))
     {
       advance();
+      advanceTo(detail::findFirstOf<true>(curPos(), m_end, first));
     }
 
     if (eof())
@@ -574,6 +738,24 @@ protected:
   }
 
   virtual Token emitToken() = 0;
+
+private:
+  Token readToken(const TokenType skipTokens)
+  {
+    auto token = emitToken();
+    while (token.hasType(skipTokens))
+    {
+      token = emitToken();
+    }
+    return token;
+  }
+
+  bool isPeekedToken(const TokenType skipTokens) const
+  {
+    return m_peekedToken && m_peekedToken->sourceVersion == m_sourceVersion
+           && m_peekedToken->skipTokens == skipTokens
+           && m_peekedToken->stateBefore == m_state;
+  }
 };
 } // namespace IO
 } // namespace TrenchBroom
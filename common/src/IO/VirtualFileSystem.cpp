@@ -21,6 +21,7 @@
 
 #include "Error.h"
 #include "IO/File.h"
+#include "IO/ImageFileSystem.h"
 #include "IO/PathInfo.h"
 
 #include "kdl/result_fold.h"
@@ -56,6 +57,17 @@ std::filesystem::path suffix(
   return kdl::path_clip(path, kdl::path_length(mountPoint.path));
 }
 
+std::string indexKey(const std::filesystem::path& path)
+{
+  auto normalizedPath = path.lexically_normal();
+  if (!normalizedPath.has_filename() && normalizedPath.has_parent_path())
+  {
+    // remove trailing separator
+    normalizedPath = normalizedPath.parent_path();
+  }
+  return normalizedPath.generic_string();
+}
+
 } // namespace
 
 VirtualMountPointId::VirtualMountPointId()
@@ -76,20 +88,10 @@ bool operator!=(const VirtualMountPointId& lhs, const VirtualMountPointId& rhs)
 Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolvedPath = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      const auto absPath = mountPoint.mountedFileSystem->makeAbsolute(pathSuffix);
-      if (
-        absPath.is_success()
-        && mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
-      {
-        return absPath;
-      }
-    }
+    const auto& mountPoint = m_mountPoints[resolvedPath->mountPointIndex];
+    return mountPoint.mountedFileSystem->makeAbsolute(suffix(mountPoint, path));
   }
 
   return Error{"Failed to make absolute path of '" + path.string() + "'"};
@@ -97,18 +99,9 @@ Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
 
 PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolvedPath = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return pathInfo;
-      }
-    }
+    return resolvedPath->pathInfo;
   }
 
   return std::any_of(
@@ -127,7 +120,9 @@ VirtualMountPointId VirtualFileSystem::mount(
   const std::filesystem::path& path, std::unique_ptr<FileSystem> fs)
 {
   const auto id = VirtualMountPointId{};
-  m_mountPoints.push_back({id, path, std::move(fs)});
+  const auto indexed = dynamic_cast<const ImageFileSystemBase*>(fs.get()) != nullptr;
+  m_mountPoints.push_back({id, path, std::move(fs), indexed});
+  addToIndex(m_mountPoints.size() - 1);
   return id;
 }
 
@@ -140,6 +135,7 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
       it != m_mountPoints.end())
   {
     m_mountPoints.erase(it);
+    rebuildIndex();
     return true;
   }
   return false;
@@ -148,6 +144,16 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
 void VirtualFileSystem::unmountAll()
 {
   m_mountPoints.clear();
+  m_index.clear();
+}
+
+void VirtualFileSystem::rebuildIndex()
+{
+  m_index.clear();
+  for (size_t i = 0; i < m_mountPoints.size(); ++i)
+  {
+    addToIndex(i);
+  }
 }
 
 Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
@@ -228,20 +234,57 @@ Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
 Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolvedPath = resolve(path))
+  {
+    const auto& mountPoint = m_mountPoints[resolvedPath->mountPointIndex];
+    return mountPoint.mountedFileSystem->openFile(suffix(mountPoint, path));
+  }
+
+  return Error{"'" + path.string() + "' not found"};
+}
+
+void VirtualFileSystem::addToIndex(const size_t mountPointIndex)
+{
+  const auto& mountPoint = m_mountPoints[mountPointIndex];
+  if (!mountPoint.indexed)
+  {
+    return;
+  }
+
+  const auto& imageFs =
+    static_cast<const ImageFileSystemBase&>(*mountPoint.mountedFileSystem);
+
+  m_index[indexKey(mountPoint.path)] = {mountPointIndex, PathInfo::Directory};
+  imageFs.forEachEntry([&](const auto& entryPath, const auto entryPathInfo) {
+    m_index[indexKey(mountPoint.path / entryPath)] = {mountPointIndex, entryPathInfo};
+  });
+}
+
+std::optional<VirtualFileSystem::IndexEntry> VirtualFileSystem::resolve(
+  const std::filesystem::path& path) const
+{
+  const auto indexIt = m_index.find(indexKey(path));
+  const auto indexEntry = indexIt != m_index.end()
+                            ? std::optional<IndexEntry>{indexIt->second}
+                            : std::nullopt;
+
+  // only unindexed mount points above the indexed one can take precedence
+  const auto firstCandidate = indexEntry ? indexEntry->mountPointIndex + 1 : size_t(0);
+  for (auto i = m_mountPoints.size(); i > firstCandidate; --i)
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
+    const auto& mountPoint = m_mountPoints[i - 1];
+    if (!mountPoint.indexed && matches(mountPoint, path))
     {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
+      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(
+            suffix(mountPoint, path));
+          pathInfo != PathInfo::Unknown)
       {
-        return mountPoint.mountedFileSystem->openFile(pathSuffix);
+        return IndexEntry{i - 1, pathInfo};
       }
     }
   }
 
-  return Error{"'" + path.string() + "' not found"};
+  return indexEntry;
 }
 
 WritableVirtualFileSystem::WritableVirtualFileSystem(
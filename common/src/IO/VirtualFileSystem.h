@@ -22,8 +22,13 @@
 #include "IO/FileSystem.h"
 #include "Result.h"
 
+#include <kdl/string_compare.h>
+
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -48,13 +53,33 @@ struct VirtualMountPoint
   VirtualMountPointId id;
   std::filesystem::path path;
   std::unique_ptr<FileSystem> mountedFileSystem;
+  bool indexed;
 };
 
+/**
+ * Mounts file systems at virtual paths. If a path exists in more than one mounted file
+ * system, the file system that was mounted last takes precedence.
+ *
+ * The contents of image file systems such as pak and zip files do not change once they
+ * are mounted, so they are recorded in a merged, case insensitive index of all mounts.
+ * This resolves paths into image file systems with a single lookup instead of asking each
+ * mounted file system in turn. Other file systems are still queried individually.
+ */
 class VirtualFileSystem : public FileSystem
 {
 private:
+  struct IndexEntry
+  {
+    size_t mountPointIndex;
+    PathInfo pathInfo;
+  };
+
   std::vector<VirtualMountPoint> m_mountPoints;
 
+  // maps generic paths to the last indexed mount point containing them, ignoring case
+  std::unordered_map<std::string, IndexEntry, kdl::ci::string_hash, kdl::ci::string_equal>
+    m_index;
+
 public:
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
@@ -66,10 +91,24 @@ public:
   void unmountAll();
 
 protected:
+  /**
+   * Rebuilds the path index. Must be called when the contents of a mounted image file
+   * system change, e.g. because it was reloaded.
+   */
+  void rebuildIndex();
+
   Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, TraversalMode traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+
+private:
+  void addToIndex(size_t mountPointIndex);
+
+  /**
+   * Finds the mount point that takes precedence for the given path.
+   */
+  std::optional<IndexEntry> resolve(const std::filesystem::path& path) const;
 };
 
 class WritableVirtualFileSystem : public WritableFileSystem
@@ -21,6 +21,7 @@
 
 #include "Color.h"
 #include "IO/ParserStatus.h"
+#include "IO/StandardMapParser.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/EntityProperties.h"
@@ -68,14 +69,19 @@ WorldReader::WorldReader(
   std::string_view str,
   const Model::MapFormat sourceAndTargetMapFormat,
   const Model::EntityPropertyConfig& entityPropertyConfig)
-  : MapReader(
-    std::move(str),
-    sourceAndTargetMapFormat,
-    sourceAndTargetMapFormat,
-    entityPropertyConfig,
-    {})
+  : WorldReader{
+    str, sourceAndTargetMapFormat, sourceAndTargetMapFormat, entityPropertyConfig}
+{
+}
+
+WorldReader::WorldReader(
+  std::string_view str,
+  const Model::MapFormat sourceMapFormat,
+  const Model::MapFormat targetMapFormat,
+  const Model::EntityPropertyConfig& entityPropertyConfig)
+  : MapReader(std::move(str), sourceMapFormat, targetMapFormat, entityPropertyConfig, {})
   , m_world(std::make_unique<Model::WorldNode>(
-      entityPropertyConfig, Model::Entity{}, sourceAndTargetMapFormat))
+      entityPropertyConfig, Model::Entity{}, targetMapFormat))
 {
   m_world->disableNodeTreeUpdates();
 }
@@ -85,11 +91,13 @@ std::unique_ptr<Model::WorldNode> WorldReader::tryRead(
   const std::vector<Model::MapFormat>& mapFormatsToTry,
   const vm::bbox3& worldBounds,
   const Model::EntityPropertyConfig& entityPropertyConfig,
-  ParserStatus& status)
+  ParserStatus& status,
+  const MapCache* mapCache)
 {
   std::vector<std::tuple<Model::MapFormat, std::string>> parserExceptions;
 
-  for (const auto mapFormat : mapFormatsToTry)
+  // only the formats that can parse the first brushes are tried
+  for (const auto mapFormat : detectMapFormats(str, mapFormatsToTry))
   {
     if (mapFormat == Model::MapFormat::Unknown)
     {
@@ -99,7 +107,7 @@ std::unique_ptr<Model::WorldNode> WorldReader::tryRead(
     try
     {
       WorldReader reader{str, mapFormat, entityPropertyConfig};
-      return reader.read(worldBounds, status);
+      return reader.read(worldBounds, status, mapCache);
     }
     catch (const ParserException& e)
     {
@@ -121,9 +129,9 @@ std::unique_ptr<Model::WorldNode> WorldReader::tryRead(
 }
 
 std::unique_ptr<Model::WorldNode> WorldReader::read(
-  const vm::bbox3& worldBounds, ParserStatus& status)
+  const vm::bbox3& worldBounds, ParserStatus& status, const MapCache* mapCache)
 {
-  readEntities(worldBounds, status);
+  readEntities(worldBounds, status, mapCache);
   sanitizeLayerSortIndicies(status);
   m_world->rebuildNodeTree();
   m_world->enableNodeTreeUpdates();
@@ -37,6 +37,7 @@ class WorldNode;
 
 namespace IO
 {
+class MapCache;
 class ParserStatus;
 
 class WorldReaderException : public Exception
@@ -60,17 +61,37 @@ public:
     Model::MapFormat sourceAndTargetMapFormat,
     const Model::EntityPropertyConfig& entityPropertyConfig);
 
+  /**
+   * Creates a reader that parses the given string in the given source map format and
+   * converts the world to the given target map format.
+   */
+  WorldReader(
+    std::string_view str,
+    Model::MapFormat sourceMapFormat,
+    Model::MapFormat targetMapFormat,
+    const Model::EntityPropertyConfig& entityPropertyConfig);
+
+  /**
+   * Reads the world. If a map cache is given, the brush geometries stored in it are used
+   * if they match the parsed brushes.
+   */
   std::unique_ptr<Model::WorldNode> read(
-    const vm::bbox3& worldBounds, ParserStatus& status);
+    const vm::bbox3& worldBounds,
+    ParserStatus& status,
+    const MapCache* mapCache = nullptr);
 
   /**
    * Try to parse the given string as the given map formats, in order.
    * Returns the world if parsing is successful, otherwise throws an exception.
    *
+   * Formats that cannot parse the first brushes of the string are skipped, see
+   * detectMapFormats().
+   *
    * @param str the string to parse
    * @param mapFormatsToTry formats to try, in order
    * @param worldBounds world bounds
    * @param status status
+   * @param mapCache the map cache to use, if any
    * @return the world node
    * @throws WorldReaderException if `str` can't be parsed by any of the given formats
    */
@@ -79,7 +100,8 @@ public:
     const std::vector<Model::MapFormat>& mapFormatsToTry,
     const vm::bbox3& worldBounds,
     const Model::EntityPropertyConfig& entityPropertyConfig,
-    ParserStatus& status);
+    ParserStatus& status,
+    const MapCache* mapCache = nullptr);
 
 private:
   void sanitizeLayerSortIndicies(ParserStatus& status);
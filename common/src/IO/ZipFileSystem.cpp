@@ -25,25 +25,167 @@
 
 #include <kdl/result.h>
 
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 
 namespace TrenchBroom::IO
 {
+namespace
+{
+
+class ZipFileCache
+{
+private:
+  using Key = std::pair<size_t, mz_uint>;
+
+  struct CacheEntry
+  {
+    Key key;
+    std::shared_ptr<File> file;
+  };
+
+  mutable std::mutex m_mutex;
+  size_t m_nextCacheId = 1;
+  size_t m_size = 0;
+
+  // most recently used entries come first
+  std::list<CacheEntry> m_entries;
+  std::map<Key, std::list<CacheEntry>::iterator> m_lookup;
+
+public:
+  size_t nextCacheId()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_nextCacheId++;
+  }
+
+  size_t size() const
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_size;
+  }
+
+  std::shared_ptr<File> get(const size_t cacheId, const mz_uint fileIndex)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    if (const auto it = m_lookup.find({cacheId, fileIndex}); it != m_lookup.end())
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return it->second->file;
+    }
+    return nullptr;
+  }
+
+  void put(const size_t cacheId, const mz_uint fileIndex, std::shared_ptr<File> file)
+  {
+    if (file->size() > MaxCachedZipFileSize)
+    {
+      return;
+    }
+
+    const auto lock = std::lock_guard{m_mutex};
+    const auto key = Key{cacheId, fileIndex};
+    if (m_lookup.count(key) > 0)
+    {
+      return;
+    }
+
+    m_size += file->size();
+    m_entries.push_front({key, std::move(file)});
+    m_lookup.emplace(key, m_entries.begin());
+
+    while (m_size > MaxZipFileCacheSize)
+    {
+      erase(std::prev(m_entries.end()));
+    }
+  }
+
+  void evict(const size_t cacheId)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      it = it->key.first == cacheId ? erase(it) : std::next(it);
+    }
+  }
+
+  void clear()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_lookup.clear();
+    m_entries.clear();
+    m_size = 0;
+  }
+
+private:
+  std::list<CacheEntry>::iterator erase(const std::list<CacheEntry>::iterator it)
+  {
+    m_size -= it->file->size();
+    m_lookup.erase(it->key);
+    return m_entries.erase(it);
+  }
+};
+
+ZipFileCache& zipFileCache()
+{
+  // intentionally leaked so that file systems destroyed during static destruction can
+  // still evict their entries
+  static auto* cache = new ZipFileCache{};
+  return *cache;
+}
+
+} // namespace
+
+size_t zipFileCacheSize()
+{
+  return zipFileCache().size();
+}
+
+void clearZipFileCache()
+{
+  zipFileCache().clear();
+}
+
 // ZipFileSystem
 
 ZipFileSystem::~ZipFileSystem()
 {
+  zipFileCache().evict(m_cacheId);
   mz_zip_reader_end(&m_archive);
 }
 
 Result<void> ZipFileSystem::doReadDirectory()
 {
+  // entries cached for a previous directory may refer to different files now
+  zipFileCache().evict(m_cacheId);
+  m_cacheId = zipFileCache().nextCacheId();
+
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (const auto* mappedFile = dynamic_cast<const MappedFile*>(m_file.get()))
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    // read the archive directly from the mapped memory
+    if (
+      mz_zip_reader_init_mem(&m_archive, mappedFile->begin(), mappedFile->size(), 0)
+      != MZ_TRUE)
+    {
+      return Error{"Error calling mz_zip_reader_init_mem"};
+    }
+  }
+  else if (const auto* cFile = dynamic_cast<const CFile*>(m_file.get()))
+  {
+    if (mz_zip_reader_init_cfile(&m_archive, cFile->file(), cFile->size(), 0) != MZ_TRUE)
+    {
+      return Error{"Error calling mz_zip_reader_init_cfile"};
+    }
+  }
+  else
+  {
+    return Error{"Unsupported file type for zip archive"};
   }
 
   const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -51,26 +193,8 @@ Result<void> ZipFileSystem::doReadDirectory()
   {
     if (!mz_zip_reader_is_file_a_directory(&m_archive, i))
     {
-      const auto path = std::filesystem::path{filename(i)};
-      addFile(path, [=]() -> Result<std::shared_ptr<File>> {
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{"mz_zip_reader_file_stat failed for " + path.string()};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
-      });
+      auto path = std::filesystem::path{filename(i)};
+      addFile(path, [this, i, path]() { return extractFile(i, path); });
     }
   }
 
@@ -85,6 +209,35 @@ Result<void> ZipFileSystem::doReadDirectory()
   return kdl::void_success;
 }
 
+Result<std::shared_ptr<File>> ZipFileSystem::extractFile(
+  const mz_uint fileIndex, const std::filesystem::path& path)
+{
+  if (auto file = zipFileCache().get(m_cacheId, fileIndex))
+  {
+    return file;
+  }
+
+  auto stat = mz_zip_archive_file_stat{};
+  if (!mz_zip_reader_file_stat(&m_archive, fileIndex, &stat))
+  {
+    return Error{"mz_zip_reader_file_stat failed for " + path.string()};
+  }
+
+  const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+  auto data = std::make_unique<char[]>(uncompressedSize);
+  auto* begin = data.get();
+
+  if (!mz_zip_reader_extract_to_mem(&m_archive, fileIndex, begin, uncompressedSize, 0))
+  {
+    return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
+  }
+
+  auto file = std::static_pointer_cast<File>(
+    std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+  zipFileCache().put(m_cacheId, fileIndex, file);
+  return file;
+}
+
 /**
  * Helper to get the filename of a file in the zip archive
  */
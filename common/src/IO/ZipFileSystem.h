@@ -30,10 +30,23 @@
 namespace TrenchBroom::IO
 {
 
+/**
+ * Files extracted from zip archives are kept in a least recently used cache that is
+ * shared by all zip file systems, so that reading the same file again does not
+ * decompress it again. The cache is bounded by the total size of the cached files.
+ */
+constexpr auto MaxZipFileCacheSize = size_t(32 * 1024 * 1024);
+
+/**
+ * Files larger than this are never cached.
+ */
+constexpr auto MaxCachedZipFileSize = size_t(4 * 1024 * 1024);
+
 class ZipFileSystem : public ImageFileSystem
 {
 private:
   mz_zip_archive m_archive;
+  size_t m_cacheId = 0;
 
 public:
   using ImageFileSystem::ImageFileSystem;
@@ -42,6 +55,20 @@ public:
 private:
   Result<void> doReadDirectory() override;
 
+  Result<std::shared_ptr<File>> extractFile(
+    mz_uint fileIndex, const std::filesystem::path& path);
+
   std::string filename(mz_uint fileIndex);
 };
+
+/**
+ * Returns the total size of the files that are currently held in the zip file cache.
+ */
+size_t zipFileCacheSize();
+
+/**
+ * Removes all files from the zip file cache.
+ */
+void clearZipFileCache();
+
 } // namespace TrenchBroom::IO
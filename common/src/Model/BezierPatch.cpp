@@ -28,6 +28,7 @@
 #include <vecmath/bezier_surface.h>
 #include <vecmath/vec_io.h>
 
+#include <array>
 #include <cassert>
 
 namespace TrenchBroom
@@ -305,25 +306,34 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   value of v
   */
 
+  // Every surface is sampled at the same values of u and v, so the Bernstein polynomials
+  // are evaluated only once. For each grid row, the curve through each surface at v is
+  // computed once, so that each grid point only needs to be interpolated along u.
+  auto basis = std::vector<std::array<FloatType, 3>>{};
+  basis.reserve(quadsPerSurfaceSide + 1u);
+  for (size_t i = 0u; i <= quadsPerSurfaceSide; ++i)
+  {
+    basis.push_back(vm::quadratic_bernstein_basis(
+      static_cast<FloatType>(i) / static_cast<FloatType>(quadsPerSurfaceSide)));
+  }
+
   for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
   {
     const size_t surfaceRow =
       (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-    const FloatType v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide)
-                        / static_cast<FloatType>(quadsPerSurfaceSide);
+    const auto& vBasis = basis[gridRow - surfaceRow * quadsPerSurfaceSide];
 
-    for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
+    for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount(); ++surfaceCol)
     {
-      const size_t surfaceCol =
-        (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-      const FloatType u =
-        static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide)
-        / static_cast<FloatType>(quadsPerSurfaceSide);
-
       const auto& surfaceControlPoints =
         allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-      auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-      grid.push_back(std::move(point));
+      const auto curve = vm::quadratic_bezier_surface_curve(surfaceControlPoints, vBasis);
+
+      // the shared point with the previous surface was already sampled from that surface
+      for (size_t i = surfaceCol > 0u ? 1u : 0u; i <= quadsPerSurfaceSide; ++i)
+      {
+        grid.push_back(vm::evaluate_quadratic_bezier_curve(curve, basis[i]));
+      }
     }
   }
 
@@ -29,6 +29,7 @@
 #include "Polyhedron.h"
 #include "Polyhedron_Matcher.h"
 
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/result_fold.h>
 #include <kdl/string_utils.h>
@@ -43,43 +44,27 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
 
+#include <array>
 #include <iterator>
+#include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom::Model
 {
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces(other.m_faces)
-  , m_geometry(
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr)
+  , m_geometry(other.m_geometry)
 {
-  if (m_geometry)
+  // copying a face does not copy its geometry, so link the copies to the shared geometry
+  for (size_t i = 0u; i < m_faces.size(); ++i)
   {
-    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
-    {
-      if (const auto faceIndex = faceGeometry->payload())
-      {
-        BrushFace& face = m_faces[*faceIndex];
-        face.setGeometry(faceGeometry);
-      }
-    }
+    m_faces[i].setGeometry(other.m_faces[i].geometry());
   }
 }
 
@@ -118,15 +103,148 @@ Result<Brush> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace>
   });
 }
 
+Result<Brush> Brush::createFromGeometry(
+  std::vector<BrushFace> faces, BrushGeometry geometry)
+{
+  if (faces.size() != geometry.faceCount())
+  {
+    return Error{"Brush is incomplete"};
+  }
+
+  Brush brush(std::move(faces));
+  brush.m_geometry = std::make_unique<BrushGeometry>(std::move(geometry));
+
+  size_t i = 0u;
+  for (BrushFaceGeometry* faceGeometry : brush.m_geometry->faces())
+  {
+    brush.m_faces[i].setGeometry(faceGeometry);
+    faceGeometry->setPayload(i);
+    ++i;
+  }
+
+  assert(brush.checkFaceLinks());
+
+  return brush;
+}
+
+namespace
+{
+/**
+ * Returns the side of a box that is bounded by a plane with the given normal if the
+ * normal is a coordinate axis. Sides 0 to 2 are the maximum and sides 3 to 5 are the
+ * minimum of the box along the X, Y and Z axes.
+ */
+std::optional<size_t> findAxialSide(const vm::vec3& normal)
+{
+  for (size_t i = 0u; i < 3u; ++i)
+  {
+    if (normal == vm::vec3::axis(i))
+    {
+      return i;
+    }
+    if (normal == -vm::vec3::axis(i))
+    {
+      return i + 3u;
+    }
+  }
+  return std::nullopt;
+}
+
+using AxialFaces = std::array<std::optional<size_t>, 6>;
+
+/**
+ * If the normals of all of the given sorted faces are coordinate axes, clipping the world
+ * bounds with the faces only moves the sides of the world bounds, so the resulting box can
+ * be computed directly. This is the case for most brushes in a typical map.
+ *
+ * Returns the box and the index of the face bounding each side of the box, if any. A face
+ * is only used if clipping with it would change the world bounds. Of several faces with
+ * the same normal, only the first one is used because it is the one that clipping would
+ * keep since the faces are sorted by their distance. The remaining faces must still be
+ * clipped, which leaves the box unchanged.
+ *
+ * If any face is not axis aligned, the world bounds are returned without any faces. Such
+ * brushes are not handled because clipping their faces in a different order can yield
+ * different results in degenerate cases.
+ */
+std::tuple<vm::bbox3, AxialFaces> computeAxialBounds(
+  const std::vector<BrushFace>& faces, const vm::bbox3& worldBounds)
+{
+  constexpr auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+
+  auto bounds = worldBounds;
+  auto axialFaces = AxialFaces{};
+  auto seenSides = std::array<bool, 6>{};
+
+  for (size_t i = 0u; i < faces.size(); ++i)
+  {
+    const auto& boundary = faces[i].boundary();
+    const auto side = findAxialSide(boundary.normal);
+    if (!side)
+    {
+      return {worldBounds, AxialFaces{}};
+    }
+
+    if (!seenSides[*side])
+    {
+      seenSides[*side] = true;
+
+      const auto axis = *side % 3u;
+      if (*side < 3u && boundary.distance < bounds.max[axis] - epsilon)
+      {
+        bounds.max[axis] = boundary.distance;
+        axialFaces[*side] = i;
+      }
+      else if (*side >= 3u && -boundary.distance > bounds.min[axis] + epsilon)
+      {
+        bounds.min[axis] = -boundary.distance;
+        axialFaces[*side] = i;
+      }
+    }
+  }
+
+  for (size_t i = 0u; i < 3u; ++i)
+  {
+    if (bounds.max[i] - bounds.min[i] <= epsilon)
+    {
+      // let clipping decide whether the brush is empty
+      return {worldBounds, AxialFaces{}};
+    }
+  }
+
+  return {bounds, axialFaces};
+}
+} // namespace
+
 Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
 {
   // First, add all faces to the brush geometry
   BrushFace::sortFaces(m_faces);
 
-  auto geometry = std::make_unique<BrushGeometry>(worldBounds);
+  const auto [bounds, axialFaces] = computeAxialBounds(m_faces, worldBounds);
+  auto geometry = std::make_unique<BrushGeometry>(bounds);
+
+  auto isAxialFace = std::vector<bool>(m_faces.size(), false);
+  for (BrushFaceGeometry* faceGeometry : geometry->faces())
+  {
+    const auto normal = faceGeometry->normal();
+    const auto axis = vm::find_abs_max_component(normal);
+    const auto side = normal[axis] > 0.0 ? axis : axis + 3u;
+    if (const auto faceIndex = axialFaces[side])
+    {
+      m_faces[*faceIndex].setGeometry(faceGeometry);
+      faceGeometry->setPayload(*faceIndex);
+      isAxialFace[*faceIndex] = true;
+    }
+  }
 
   for (size_t i = 0u; i < m_faces.size(); ++i)
   {
+    if (isAxialFace[i])
+    {
+      continue;
+    }
+
     BrushFace& face = m_faces[i];
     const auto result = geometry->clip(face.boundary());
     if (result.success())
@@ -148,16 +266,13 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
     return Error{"Brush is invalid"};
   }
 
-  // Now collect all faces which still remain
-  std::vector<BrushFace> remainingFaces;
-  remainingFaces.reserve(m_faces.size());
-
+  // Now collect all faces which still remain, keeping their order
+  auto remainingFaceGeometries = std::vector<BrushFaceGeometry*>(m_faces.size(), nullptr);
   for (BrushFaceGeometry* faceGeometry : geometry->faces())
   {
     if (const auto faceIndex = faceGeometry->payload())
     {
-      remainingFaces.push_back(std::move(m_faces[*faceIndex]));
-      faceGeometry->setPayload(remainingFaces.size() - 1u);
+      remainingFaceGeometries[*faceIndex] = faceGeometry;
     }
     else
     {
@@ -165,6 +280,18 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
     }
   }
 
+  std::vector<BrushFace> remainingFaces;
+  remainingFaces.reserve(m_faces.size());
+
+  for (size_t i = 0u; i < m_faces.size(); ++i)
+  {
+    if (auto* faceGeometry = remainingFaceGeometries[i])
+    {
+      remainingFaces.push_back(std::move(m_faces[i]));
+      faceGeometry->setPayload(remainingFaces.size() - 1u);
+    }
+  }
+
   m_faces = std::move(remainingFaces);
   m_geometry = std::move(geometry);
 
@@ -561,6 +688,12 @@ std::vector<const BrushFace*> Brush::incidentFaces(const BrushVertex* vertex) co
   return result;
 }
 
+size_t Brush::geometryMemoryUsage() const
+{
+  ensure(m_geometry != nullptr, "geometry is null");
+  return m_geometry->memoryUsage();
+}
+
 bool Brush::canMoveVertices(
   const vm::bbox3& worldBounds,
   const std::vector<vm::vec3>& vertices,
@@ -604,6 +737,14 @@ Result<void> Brush::addVertex(const vm::bbox3& worldBounds, const vm::vec3& posi
 static BrushGeometry removeVerticesFromGeometry(
   const BrushGeometry& geometry, const std::vector<vm::vec3>& vertexPositions)
 {
+  if (vertexPositions.size() == 1)
+  {
+    if (auto result = geometry.withoutVertex(vertexPositions.front()))
+    {
+      return std::move(*result);
+    }
+  }
+
   std::vector<vm::vec3> points;
   points.reserve(geometry.vertexCount());
 
@@ -619,6 +760,43 @@ static BrushGeometry removeVerticesFromGeometry(
   return BrushGeometry(points);
 }
 
+/**
+ * Moving a single vertex is the common case when dragging vertices, so in that case, only
+ * the faces around the moved vertex are recomputed if possible.
+ */
+static BrushGeometry moveVerticesInGeometry(
+  const BrushGeometry& geometry,
+  const std::vector<vm::vec3>& vertexPositions,
+  const vm::vec3& delta)
+{
+  if (vertexPositions.size() == 1)
+  {
+    const auto& position = vertexPositions.front();
+    if (auto result = geometry.withMovedVertex(position, position + delta))
+    {
+      return std::move(*result);
+    }
+  }
+
+  std::vector<vm::vec3> points;
+  points.reserve(geometry.vertexCount());
+
+  for (const auto* vertex : geometry.vertices())
+  {
+    const auto& position = vertex->position();
+    if (kdl::vec_contains(vertexPositions, position))
+    {
+      points.push_back(position + delta);
+    }
+    else
+    {
+      points.push_back(position);
+    }
+  }
+
+  return BrushGeometry(std::move(points));
+}
+
 bool Brush::canRemoveVertices(
   const vm::bbox3& /* worldBounds */, const std::vector<vm::vec3>& vertexPositions) const
 {
@@ -841,35 +1019,21 @@ Brush::CanMoveVerticesResult Brush::doCanMoveVertices(
   const auto vertexSet =
     std::set<vm::vec3>(std::begin(vertexPositions), std::end(vertexPositions));
 
-  std::vector<vm::vec3> remainingPoints;
-  remainingPoints.reserve(vertexCount());
-
   std::vector<vm::vec3> movingPoints;
   movingPoints.reserve(vertexCount());
 
-  std::vector<vm::vec3> resultPoints;
-  resultPoints.reserve(vertexCount());
-
   for (const auto* vertex : m_geometry->vertices())
   {
     const auto& position = vertex->position();
-    if (!vertexSet.count(position))
-    {
-      // the vertex is not moving
-      remainingPoints.push_back(position);
-      resultPoints.push_back(position);
-    }
-    else
+    if (vertexSet.count(position))
     {
-      // the vertex is moving
       movingPoints.push_back(position);
-      resultPoints.push_back(position + delta);
     }
   }
 
-  BrushGeometry remaining(remainingPoints);
+  BrushGeometry remaining = removeVerticesFromGeometry(*m_geometry, movingPoints);
   BrushGeometry moving(movingPoints);
-  BrushGeometry result(resultPoints);
+  BrushGeometry result = moveVerticesInGeometry(*m_geometry, movingPoints, delta);
 
   // Will the result go out of world bounds?
   if (!worldBounds.contains(result.bounds()))
@@ -955,23 +1119,8 @@ Result<void> Brush::doMoveVertices(
   ensure(!vertexPositions.empty(), "no vertex positions");
   assert(canMoveVertices(worldBounds, vertexPositions, delta));
 
-  std::vector<vm::vec3> newVertices;
-  newVertices.reserve(vertexCount());
-
-  for (const auto* vertex : m_geometry->vertices())
-  {
-    const auto& position = vertex->position();
-    if (kdl::vec_contains(vertexPositions, position))
-    {
-      newVertices.push_back(position + delta);
-    }
-    else
-    {
-      newVertices.push_back(position);
-    }
-  }
-
-  BrushGeometry newGeometry(newVertices);
+  const BrushGeometry newGeometry =
+    moveVerticesInGeometry(*m_geometry, vertexPositions, delta);
 
   using VecMap = std::map<vm::vec3, vm::vec3>;
   VecMap vertexMapping;
@@ -1149,18 +1298,14 @@ std::vector<Result<Brush>> Brush::subtract(
 
   for (const auto* subtrahend : subtrahends)
   {
-    auto nextResults = std::vector<BrushGeometry>{};
-
-    for (const BrushGeometry& fragment : result)
-    {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
-    }
-
-    result = std::move(nextResults);
+    // the fragments are disjoint, so they can be subtracted from independently
+    result = kdl::vec_flatten(kdl::vec_parallel_transform(
+      std::move(result), [&](const BrushGeometry& fragment) {
+        return fragment.subtract(*subtrahend->m_geometry);
+      }));
   }
 
-  return kdl::vec_transform(result, [&](const auto& geometry) {
+  return kdl::vec_parallel_transform(std::move(result), [&](const auto& geometry) {
     return createBrush(mapFormat, worldBounds, defaultTextureName, geometry, subtrahends);
   });
 }
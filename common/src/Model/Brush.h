@@ -41,8 +41,6 @@ enum class MapFormat;
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -54,7 +52,13 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is never modified once it has been built, so copies of a brush share it
+   * with the original. This keeps copies cheap, e.g. the snapshots taken for undo when
+   * only the face attributes of a brush change.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
 
 public:
   Brush();
@@ -69,6 +73,16 @@ public:
 
   static Result<Brush> create(const vm::bbox3& worldBounds, std::vector<BrushFace> faces);
 
+  /**
+   * Creates a brush with the given faces and geometry without computing the geometry
+   * from the faces. The i-th face of the given geometry must belong to the i-th given
+   * face.
+   *
+   * Returns an error if the number of faces and geometry faces differ.
+   */
+  static Result<Brush> createFromGeometry(
+    std::vector<BrushFace> faces, BrushGeometry geometry);
+
 private:
   Brush(std::vector<BrushFace> faces);
 
@@ -162,6 +176,13 @@ public:
 
   std::vector<const BrushFace*> incidentFaces(const BrushVertex* vertex) const;
 
+  /**
+   * Returns the number of bytes occupied by this brush's geometry, see
+   * Polyhedron::memoryUsage(). Since copies of a brush share their geometry, the result
+   * may be shared with other brushes.
+   */
+  size_t geometryMemoryUsage() const;
+
   // vertex operations
   bool canMoveVertices(
     const vm::bbox3& worldBounds,
@@ -27,6 +27,7 @@
 #include "Model/MapFormat.h"
 #include "Model/ParallelTexCoordSystem.h"
 #include "Model/ParaxialTexCoordSystem.h"
+#include "Model/TagManager.h"
 #include "Model/TagMatcher.h"
 #include "Model/TagVisitor.h"
 #include "Model/TexCoordSystem.h"
@@ -40,6 +41,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/intersection.h>
 #include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/plane.h>
 #include <vecmath/plane_io.h>
 #include <vecmath/polygon.h>
@@ -77,6 +79,7 @@ BrushFace::BrushFace(const BrushFace& other)
   , m_lineCount(other.m_lineCount)
   , m_selected(other.m_selected)
   , m_markedToRenderFace(false)
+  , m_tagInputs(other.m_tagInputs)
 {
 }
 
@@ -92,6 +95,7 @@ BrushFace::BrushFace(BrushFace&& other) noexcept
   , m_lineCount(other.m_lineCount)
   , m_selected(other.m_selected)
   , m_markedToRenderFace(false)
+  , m_tagInputs(std::move(other.m_tagInputs))
 {
 }
 
@@ -116,6 +120,7 @@ void swap(BrushFace& lhs, BrushFace& rhs) noexcept
   swap(lhs.m_lineCount, rhs.m_lineCount);
   swap(lhs.m_selected, rhs.m_selected);
   swap(lhs.m_markedToRenderFace, rhs.m_markedToRenderFace);
+  swap(lhs.m_tagInputs, rhs.m_tagInputs);
 }
 
 BrushFace::~BrushFace() = default;
@@ -650,10 +655,7 @@ Result<void> BrushFace::transform(const vm::mat4x4& transform, const bool lockTe
   const vm::plane3 oldBoundary = m_boundary;
 
   m_boundary = m_boundary.transform(transform);
-  for (size_t i = 0; i < 3; ++i)
-  {
-    m_points[i] = transform * m_points[i];
-  }
+  vm::transform_points(transform, m_points.begin(), m_points.end());
 
   if (
     dot(cross(m_points[2] - m_points[0], m_points[1] - m_points[0]), m_boundary.normal)
@@ -842,6 +844,11 @@ vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const
   return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
 }
 
+TexCoordProjection BrushFace::textureCoordsProjection() const
+{
+  return m_texCoordSystem->texCoordProjection(m_attributes, textureSize());
+}
+
 FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const
 {
   ensure(m_geometry != nullptr, "geometry is null");
@@ -900,6 +907,46 @@ bool BrushFace::isMarked() const
   return m_markedToRenderFace;
 }
 
+bool BrushFace::TagInputs::operator==(const TagInputs& other) const
+{
+  return textureName == other.textureName && texture == other.texture
+         && surfaceContents == other.surfaceContents
+         && surfaceFlags == other.surfaceFlags
+         && tagManagerGeneration == other.tagManagerGeneration
+         && tagMask == other.tagMask;
+}
+
+void BrushFace::updateTags(TagManager& tagManager)
+{
+  auto inputs = tagInputs(tagManager);
+  if (m_tagInputs && *m_tagInputs == inputs)
+  {
+    return;
+  }
+
+  Taggable::updateTags(tagManager);
+
+  inputs.tagMask = tagMask();
+  m_tagInputs = std::move(inputs);
+}
+
+void BrushFace::clearTags()
+{
+  Taggable::clearTags();
+  m_tagInputs = std::nullopt;
+}
+
+BrushFace::TagInputs BrushFace::tagInputs(const TagManager& tagManager) const
+{
+  return {
+    m_attributes.textureName(),
+    texture(),
+    resolvedSurfaceContents(),
+    resolvedSurfaceFlags(),
+    tagManager.generation(),
+    tagMask()};
+}
+
 void BrushFace::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
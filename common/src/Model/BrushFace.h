@@ -36,6 +36,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,7 @@ class Texture;
 
 namespace TrenchBroom::Model
 {
+struct TexCoordProjection;
 class TexCoordSystem;
 class TexCoordSystemSnapshot;
 enum class WrapStyle;
@@ -103,6 +105,24 @@ private:
   // brush renderer
   mutable bool m_markedToRenderFace;
 
+  /**
+   * Everything the smart tag matchers can inspect on a face. The inputs at the time of the
+   * last tag update are stored so that updating the tags again can be skipped if none of
+   * them has changed, e.g. when a brush is moved.
+   */
+  struct TagInputs
+  {
+    std::string textureName;
+    const Assets::Texture* texture;
+    int surfaceContents;
+    int surfaceFlags;
+    size_t tagManagerGeneration;
+    TagType::Type tagMask;
+
+    bool operator==(const TagInputs& other) const;
+  };
+  std::optional<TagInputs> m_tagInputs;
+
 public:
   BrushFace(const BrushFace& other);
   BrushFace(BrushFace&& other) noexcept;
@@ -263,6 +283,7 @@ public:
   void deselect();
 
   vm::vec2f textureCoords(const vm::vec3& point) const;
+  TexCoordProjection textureCoordsProjection() const;
 
   FloatType intersectWithRay(const vm::ray3& ray) const;
 
@@ -281,7 +302,13 @@ public: // brush renderer
   void setMarked(bool marked) const;
   bool isMarked() const;
 
-private: // implement Taggable interface
+public: // implement Taggable interface
+  void updateTags(TagManager& tagManager) override;
+  void clearTags() override;
+
+private:
+  TagInputs tagInputs(const TagManager& tagManager) const;
+
   void doAcceptTagVisitor(TagVisitor& visitor) override;
   void doAcceptTagVisitor(ConstTagVisitor& visitor) const override;
 };
@@ -21,50 +21,214 @@
 
 #include "Assets/Texture.h"
 
-#include <kdl/reflection_impl.h>
+#include <kdl/struct_io.h>
 
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
 #include <string>
+#include <unordered_set>
 
 namespace TrenchBroom
 {
 namespace Model
 {
-const std::string BrushFaceAttributes::NoTextureName = "__TB_empty";
+struct BrushFaceAttributesData
+  : public std::enable_shared_from_this<BrushFaceAttributesData>
+{
+  const std::string* textureName;
+
+  vm::vec2f offset = vm::vec2f::zero();
+  vm::vec2f scale = vm::vec2f{1.0f, 1.0f};
+  float rotation = 0.0f;
+
+  std::optional<int> surfaceContents;
+  std::optional<int> surfaceFlags;
+  std::optional<float> surfaceValue;
+
+  std::optional<Color> color;
+
+  explicit BrushFaceAttributesData(const std::string& i_textureName)
+    : textureName{&i_textureName}
+  {
+  }
+};
+
+namespace
+{
 
-BrushFaceAttributes::BrushFaceAttributes(std::string_view textureName)
-  : m_textureName(textureName)
-  , m_offset(vm::vec2f::zero())
-  , m_scale(vm::vec2f(1.0f, 1.0f))
-  , m_rotation(0.0f)
+bool operator==(const BrushFaceAttributesData& lhs, const BrushFaceAttributesData& rhs)
 {
+  // texture names are interned, so they can be compared by address
+  return lhs.textureName == rhs.textureName && lhs.offset == rhs.offset
+         && lhs.scale == rhs.scale && lhs.rotation == rhs.rotation
+         && lhs.surfaceContents == rhs.surfaceContents
+         && lhs.surfaceFlags == rhs.surfaceFlags && lhs.surfaceValue == rhs.surfaceValue
+         && lhs.color == rhs.color;
 }
 
-BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other)
-  : m_textureName(other.m_textureName)
-  , m_offset(other.m_offset)
-  , m_scale(other.m_scale)
-  , m_rotation(other.m_rotation)
-  , m_surfaceContents(other.m_surfaceContents)
-  , m_surfaceFlags(other.m_surfaceFlags)
-  , m_surfaceValue(other.m_surfaceValue)
-  , m_color(other.m_color)
+template <typename T>
+void combineHash(size_t& seed, const T& value)
 {
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T, size_t S>
+void combineHash(size_t& seed, const vm::vec<T, S>& value)
+{
+  for (size_t i = 0; i < S; ++i)
+  {
+    combineHash(seed, value[i]);
+  }
 }
 
+struct DataHash
+{
+  size_t operator()(const BrushFaceAttributesData* data) const
+  {
+    auto seed = size_t(0);
+    combineHash(seed, data->textureName);
+    combineHash(seed, data->offset);
+    combineHash(seed, data->scale);
+    combineHash(seed, data->rotation);
+    combineHash(seed, data->surfaceContents);
+    combineHash(seed, data->surfaceFlags);
+    combineHash(seed, data->surfaceValue);
+    if (data->color)
+    {
+      combineHash<float, 4>(seed, *data->color);
+    }
+    return seed;
+  }
+};
+
+struct DataEqual
+{
+  bool operator()(
+    const BrushFaceAttributesData* lhs, const BrushFaceAttributesData* rhs) const
+  {
+    return *lhs == *rhs;
+  }
+};
+
+/**
+ * Returns the interned instance of the given texture name. Interned names are never
+ * removed, so the returned reference remains valid until the program exits.
+ *
+ * This function is thread safe because maps are loaded on multiple threads.
+ */
+const std::string& internTextureName(std::string_view textureName)
+{
+  static auto mutex = std::shared_mutex{};
+  static auto textureNames = std::unordered_set<std::string>{};
+
+  auto key = std::string{textureName};
+  {
+    const auto lock = std::shared_lock{mutex};
+    if (const auto it = textureNames.find(key); it != textureNames.end())
+    {
+      return *it;
+    }
+  }
+
+  const auto lock = std::unique_lock{mutex};
+  return *textureNames.insert(std::move(key)).first;
+}
+
+/**
+ * The live data blocks. A block removes itself from the pool when its last owner releases
+ * it. The pool is never destroyed because blocks may outlive static objects.
+ */
+struct DataPool
+{
+  std::shared_mutex mutex;
+  std::unordered_set<const BrushFaceAttributesData*, DataHash, DataEqual> blocks;
+};
+
+DataPool& dataPool()
+{
+  static auto* pool = new DataPool{};
+  return *pool;
+}
+
+void releaseData(const BrushFaceAttributesData* data)
+{
+  auto& pool = dataPool();
+  {
+    const auto lock = std::unique_lock{pool.mutex};
+
+    // the pool might already contain a replacement block if this block was found
+    // expired by internData
+    if (const auto it = pool.blocks.find(data); it != pool.blocks.end() && *it == data)
+    {
+      pool.blocks.erase(it);
+    }
+  }
+  delete data;
+}
+
+/**
+ * Returns the shared block that is equal to the given data, creating it if necessary.
+ *
+ * This function is thread safe because maps are loaded on multiple threads.
+ */
+std::shared_ptr<const BrushFaceAttributesData> internData(BrushFaceAttributesData data)
+{
+  auto& pool = dataPool();
+  {
+    const auto lock = std::shared_lock{pool.mutex};
+    if (const auto it = pool.blocks.find(&data); it != pool.blocks.end())
+    {
+      if (auto block = (*it)->weak_from_this().lock())
+      {
+        return block;
+      }
+    }
+  }
+
+  const auto lock = std::unique_lock{pool.mutex};
+  if (const auto it = pool.blocks.find(&data); it != pool.blocks.end())
+  {
+    if (auto block = (*it)->weak_from_this().lock())
+    {
+      return block;
+    }
+
+    // the block is being released by another thread
+    pool.blocks.erase(it);
+  }
+
+  auto block = std::shared_ptr<const BrushFaceAttributesData>{
+    new BrushFaceAttributesData{std::move(data)}, releaseData};
+  pool.blocks.insert(block.get());
+  return block;
+}
+
+} // namespace
+
+const std::string BrushFaceAttributes::NoTextureName = "__TB_empty";
+
+BrushFaceAttributes::BrushFaceAttributes(const std::string_view textureName)
+  : m_data{internData(BrushFaceAttributesData{internTextureName(textureName)})}
+{
+}
+
+BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other) = default;
+
 BrushFaceAttributes::BrushFaceAttributes(
-  std::string_view textureName, const BrushFaceAttributes& other)
-  : m_textureName(textureName)
-  , m_offset(other.m_offset)
-  , m_scale(other.m_scale)
-  , m_rotation(other.m_rotation)
-  , m_surfaceContents(other.m_surfaceContents)
-  , m_surfaceFlags(other.m_surfaceFlags)
-  , m_surfaceValue(other.m_surfaceValue)
-  , m_color(other.m_color)
+  const std::string_view textureName, const BrushFaceAttributes& other)
+  : m_data{other.m_data}
 {
+  if (textureName != *m_data->textureName)
+  {
+    auto data = *m_data;
+    data.textureName = &internTextureName(textureName);
+    m_data = internData(std::move(data));
+  }
 }
 
 BrushFaceAttributes& BrushFaceAttributes::operator=(BrushFaceAttributes other)
@@ -74,39 +238,52 @@ BrushFaceAttributes& BrushFaceAttributes::operator=(BrushFaceAttributes other)
   return *this;
 }
 
-kdl_reflect_impl(BrushFaceAttributes);
+bool operator==(const BrushFaceAttributes& lhs, const BrushFaceAttributes& rhs)
+{
+  return lhs.m_data == rhs.m_data || *lhs.m_data == *rhs.m_data;
+}
+
+bool operator!=(const BrushFaceAttributes& lhs, const BrushFaceAttributes& rhs)
+{
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const BrushFaceAttributes& rhs)
+{
+  kdl::struct_stream{lhs} << "BrushFaceAttributes"
+                          << "m_textureName" << rhs.textureName() << "m_offset"
+                          << rhs.offset() << "m_scale" << rhs.scale() << "m_rotation"
+                          << rhs.rotation() << "m_surfaceContents"
+                          << rhs.surfaceContents() << "m_surfaceFlags"
+                          << rhs.surfaceFlags() << "m_surfaceValue"
+                          << rhs.surfaceValue() << "m_color" << rhs.color();
+  return lhs;
+}
 
 void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs)
 {
   using std::swap;
-  swap(lhs.m_textureName, rhs.m_textureName);
-  swap(lhs.m_offset, rhs.m_offset);
-  swap(lhs.m_scale, rhs.m_scale);
-  swap(lhs.m_rotation, rhs.m_rotation);
-  swap(lhs.m_surfaceContents, rhs.m_surfaceContents);
-  swap(lhs.m_surfaceFlags, rhs.m_surfaceFlags);
-  swap(lhs.m_surfaceValue, rhs.m_surfaceValue);
-  swap(lhs.m_color, rhs.m_color);
+  swap(lhs.m_data, rhs.m_data);
 }
 
 const std::string& BrushFaceAttributes::textureName() const
 {
-  return m_textureName;
+  return *m_data->textureName;
 }
 
 const vm::vec2f& BrushFaceAttributes::offset() const
 {
-  return m_offset;
+  return m_data->offset;
 }
 
 float BrushFaceAttributes::xOffset() const
 {
-  return m_offset.x();
+  return m_data->offset.x();
 }
 
 float BrushFaceAttributes::yOffset() const
 {
-  return m_offset.y();
+  return m_data->offset.y();
 }
 
 vm::vec2f BrushFaceAttributes::modOffset(
@@ -117,214 +294,208 @@ vm::vec2f BrushFaceAttributes::modOffset(
 
 const vm::vec2f& BrushFaceAttributes::scale() const
 {
-  return m_scale;
+  return m_data->scale;
 }
 
 float BrushFaceAttributes::xScale() const
 {
-  return m_scale.x();
+  return m_data->scale.x();
 }
 
 float BrushFaceAttributes::yScale() const
 {
-  return m_scale.y();
+  return m_data->scale.y();
 }
 
 float BrushFaceAttributes::rotation() const
 {
-  return m_rotation;
+  return m_data->rotation;
 }
 
 bool BrushFaceAttributes::hasSurfaceAttributes() const
 {
-  return m_surfaceContents || m_surfaceFlags || m_surfaceValue;
+  return m_data->surfaceContents || m_data->surfaceFlags || m_data->surfaceValue;
 }
 
 const std::optional<int>& BrushFaceAttributes::surfaceContents() const
 {
-  return m_surfaceContents;
+  return m_data->surfaceContents;
 }
 
 const std::optional<int>& BrushFaceAttributes::surfaceFlags() const
 {
-  return m_surfaceFlags;
+  return m_data->surfaceFlags;
 }
 
 const std::optional<float>& BrushFaceAttributes::surfaceValue() const
 {
-  return m_surfaceValue;
+  return m_data->surfaceValue;
 }
 
 bool BrushFaceAttributes::hasColor() const
 {
-  return m_color.has_value();
+  return m_data->color.has_value();
 }
 
 const std::optional<Color>& BrushFaceAttributes::color() const
 {
-  return m_color;
+  return m_data->color;
 }
 
 bool BrushFaceAttributes::valid() const
 {
-  return !vm::is_zero(m_scale.x(), vm::Cf::almost_zero())
-         && !vm::is_zero(m_scale.y(), vm::Cf::almost_zero());
+  return !vm::is_zero(m_data->scale.x(), vm::Cf::almost_zero())
+         && !vm::is_zero(m_data->scale.y(), vm::Cf::almost_zero());
 }
 
 bool BrushFaceAttributes::setTextureName(const std::string& textureName)
 {
-  if (textureName == m_textureName)
+  if (textureName == *m_data->textureName)
   {
     return false;
   }
-  else
-  {
-    m_textureName = textureName;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.textureName = &internTextureName(textureName);
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setOffset(const vm::vec2f& offset)
 {
-  if (offset == m_offset)
+  if (offset == m_data->offset)
   {
     return false;
   }
-  else
-  {
-    m_offset = offset;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.offset = offset;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setXOffset(const float xOffset)
 {
-  if (xOffset == m_offset.x())
+  if (xOffset == m_data->offset.x())
   {
     return false;
   }
-  else
-  {
-    m_offset[0] = xOffset;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.offset[0] = xOffset;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setYOffset(const float yOffset)
 {
-  if (yOffset == m_offset.y())
+  if (yOffset == m_data->offset.y())
   {
     return false;
   }
-  else
-  {
-    m_offset[1] = yOffset;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.offset[1] = yOffset;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setScale(const vm::vec2f& scale)
 {
-  if (scale == m_scale)
+  if (scale == m_data->scale)
   {
     return false;
   }
-  else
-  {
-    m_scale = scale;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.scale = scale;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setXScale(const float xScale)
 {
-  if (xScale == m_scale.x())
+  if (xScale == m_data->scale.x())
   {
     return false;
   }
-  else
-  {
-    m_scale[0] = xScale;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.scale[0] = xScale;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setYScale(const float yScale)
 {
-  if (yScale == m_scale.y())
+  if (yScale == m_data->scale.y())
   {
     return false;
   }
-  else
-  {
-    m_scale[1] = yScale;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.scale[1] = yScale;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setRotation(const float rotation)
 {
-  if (rotation == m_rotation)
+  if (rotation == m_data->rotation)
   {
     return false;
   }
-  else
-  {
-    m_rotation = rotation;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.rotation = rotation;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setSurfaceContents(const std::optional<int>& surfaceContents)
 {
-  if (surfaceContents == m_surfaceContents)
+  if (surfaceContents == m_data->surfaceContents)
   {
     return false;
   }
-  else
-  {
-    m_surfaceContents = surfaceContents;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.surfaceContents = surfaceContents;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setSurfaceFlags(const std::optional<int>& surfaceFlags)
 {
-  if (surfaceFlags == m_surfaceFlags)
+  if (surfaceFlags == m_data->surfaceFlags)
   {
     return false;
   }
-  else
-  {
-    m_surfaceFlags = surfaceFlags;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.surfaceFlags = surfaceFlags;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setSurfaceValue(const std::optional<float>& surfaceValue)
 {
-  if (surfaceValue == m_surfaceValue)
+  if (surfaceValue == m_data->surfaceValue)
   {
     return false;
   }
-  else
-  {
-    m_surfaceValue = surfaceValue;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.surfaceValue = surfaceValue;
+  return setData(std::move(data));
 }
 
 bool BrushFaceAttributes::setColor(const std::optional<Color>& color)
 {
-  if (color == m_color)
+  if (color == m_data->color)
   {
     return false;
   }
-  else
-  {
-    m_color = color;
-    return true;
-  }
+
+  auto data = *m_data;
+  data.color = color;
+  return setData(std::move(data));
+}
+
+bool BrushFaceAttributes::setData(BrushFaceAttributesData data)
+{
+  m_data = internData(std::move(data));
+  return true;
 }
 } // namespace Model
 } // namespace TrenchBroom
@@ -21,10 +21,10 @@
 
 #include "Color.h"
 
-#include <kdl/reflection_decl.h>
-
 #include <vecmath/forward.h>
 
+#include <iosfwd>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -39,23 +39,25 @@ class Texture;
 namespace Model
 {
 
+struct BrushFaceAttributesData;
+
+/**
+ * The texture attributes of a brush face.
+ *
+ * Most faces of a map share their attributes with other faces, so the values are stored
+ * in an immutable block that is shared by all attributes with equal values. Blocks are
+ * interned, which makes copying attributes cheap and lets equal attributes share their
+ * block even if they were created separately, e.g. when parsing a map. Every setter
+ * replaces this object's block with the interned block for the new values. Texture names
+ * are interned too.
+ */
 class BrushFaceAttributes
 {
 public:
   static const std::string NoTextureName;
 
 private:
-  std::string m_textureName;
-
-  vm::vec2f m_offset;
-  vm::vec2f m_scale;
-  float m_rotation;
-
-  std::optional<int> m_surfaceContents;
-  std::optional<int> m_surfaceFlags;
-  std::optional<float> m_surfaceValue;
-
-  std::optional<Color> m_color;
+  std::shared_ptr<const BrushFaceAttributesData> m_data;
 
 public:
   explicit BrushFaceAttributes(std::string_view textureName);
@@ -64,16 +66,9 @@ public:
 
   BrushFaceAttributes& operator=(BrushFaceAttributes other);
 
-  kdl_reflect_decl(
-    BrushFaceAttributes,
-    m_textureName,
-    m_offset,
-    m_scale,
-    m_rotation,
-    m_surfaceContents,
-    m_surfaceFlags,
-    m_surfaceValue,
-    m_color);
+  friend bool operator==(const BrushFaceAttributes& lhs, const BrushFaceAttributes& rhs);
+  friend bool operator!=(const BrushFaceAttributes& lhs, const BrushFaceAttributes& rhs);
+  friend std::ostream& operator<<(std::ostream& lhs, const BrushFaceAttributes& rhs);
 
   friend void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs);
 
@@ -112,6 +107,9 @@ public:
   bool setSurfaceFlags(const std::optional<int>& surfaceFlags);
   bool setSurfaceValue(const std::optional<float>& surfaceValue);
   bool setColor(const std::optional<Color>& color);
+
+private:
+  bool setData(BrushFaceAttributesData data);
 };
 
 } // namespace Model
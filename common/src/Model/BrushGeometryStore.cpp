@@ -0,0 +1,284 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushGeometryStore.h"
+
+#include "Ensure.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/Polyhedron.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+namespace TrenchBroom::Model
+{
+
+void BrushGeometryStore::addBrush(const BrushNode& brushNode)
+{
+  assert(!contains(brushNode));
+
+  const auto index = m_brushNodes.size();
+  m_brushNodes.push_back(&brushNode);
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    m_boundsMin[axis].push_back(0.0);
+    m_boundsMax[axis].push_back(0.0);
+  }
+  m_vertexRanges.push_back({m_vertices[0].size(), 0});
+  m_faceRanges.push_back({m_planeDistances.size(), 0});
+  m_vertexCapacities.push_back(0);
+  m_faceCapacities.push_back(0);
+  m_brushIndices.emplace(&brushNode, index);
+
+  writeGeometry(index);
+}
+
+void BrushGeometryStore::updateBrush(const BrushNode& brushNode)
+{
+  writeGeometry(brushIndex(brushNode));
+  compactIfFragmented();
+}
+
+void BrushGeometryStore::removeBrush(const BrushNode& brushNode)
+{
+  const auto index = brushIndex(brushNode);
+  m_vertexCount -= m_vertexRanges[index].count;
+  m_faceCount -= m_faceRanges[index].count;
+  m_brushIndices.erase(&brushNode);
+
+  // move the last brush into the slot of the removed brush
+  const auto removeAt = [&](auto& values) {
+    values[index] = std::move(values.back());
+    values.pop_back();
+  };
+
+  removeAt(m_brushNodes);
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    removeAt(m_boundsMin[axis]);
+    removeAt(m_boundsMax[axis]);
+  }
+  removeAt(m_vertexRanges);
+  removeAt(m_faceRanges);
+  removeAt(m_vertexCapacities);
+  removeAt(m_faceCapacities);
+
+  if (index < m_brushNodes.size())
+  {
+    m_brushIndices[m_brushNodes[index]] = index;
+  }
+
+  compactIfFragmented();
+}
+
+void BrushGeometryStore::clear()
+{
+  *this = BrushGeometryStore{};
+}
+
+void BrushGeometryStore::compact()
+{
+  auto vertices = std::array<std::vector<FloatType>, 3>{};
+  auto planeNormals = std::array<std::vector<FloatType>, 3>{};
+  auto planeDistances = std::vector<FloatType>{};
+
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    vertices[axis].reserve(m_vertexCount);
+    planeNormals[axis].reserve(m_faceCount);
+  }
+  planeDistances.reserve(m_faceCount);
+
+  const auto copyRange = [](const auto& from, auto& to, const Range& range) {
+    const auto begin = std::next(from.begin(), static_cast<std::ptrdiff_t>(range.offset));
+    to.insert(to.end(), begin, std::next(begin, static_cast<std::ptrdiff_t>(range.count)));
+  };
+
+  for (size_t i = 0; i < m_brushNodes.size(); ++i)
+  {
+    auto& vertexRange = m_vertexRanges[i];
+    auto& faceRange = m_faceRanges[i];
+
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      copyRange(m_vertices[axis], vertices[axis], vertexRange);
+      copyRange(m_planeNormals[axis], planeNormals[axis], faceRange);
+    }
+    copyRange(m_planeDistances, planeDistances, faceRange);
+
+    vertexRange.offset = vertices[0].size() - vertexRange.count;
+    faceRange.offset = planeDistances.size() - faceRange.count;
+    m_vertexCapacities[i] = vertexRange.count;
+    m_faceCapacities[i] = faceRange.count;
+  }
+
+  m_vertices = std::move(vertices);
+  m_planeNormals = std::move(planeNormals);
+  m_planeDistances = std::move(planeDistances);
+}
+
+size_t BrushGeometryStore::brushCount() const
+{
+  return m_brushNodes.size();
+}
+
+bool BrushGeometryStore::contains(const BrushNode& brushNode) const
+{
+  return m_brushIndices.find(&brushNode) != m_brushIndices.end();
+}
+
+size_t BrushGeometryStore::brushIndex(const BrushNode& brushNode) const
+{
+  const auto it = m_brushIndices.find(&brushNode);
+  ensure(it != m_brushIndices.end(), "brush node is contained in the store");
+  return it->second;
+}
+
+const std::vector<const BrushNode*>& BrushGeometryStore::brushNodes() const
+{
+  return m_brushNodes;
+}
+
+const std::vector<FloatType>& BrushGeometryStore::boundsMin(const size_t axis) const
+{
+  return m_boundsMin[axis];
+}
+
+const std::vector<FloatType>& BrushGeometryStore::boundsMax(const size_t axis) const
+{
+  return m_boundsMax[axis];
+}
+
+const std::vector<BrushGeometryStore::Range>& BrushGeometryStore::vertexRanges() const
+{
+  return m_vertexRanges;
+}
+
+const std::vector<BrushGeometryStore::Range>& BrushGeometryStore::faceRanges() const
+{
+  return m_faceRanges;
+}
+
+const std::vector<FloatType>& BrushGeometryStore::vertices(const size_t axis) const
+{
+  return m_vertices[axis];
+}
+
+const std::vector<FloatType>& BrushGeometryStore::planeNormals(const size_t axis) const
+{
+  return m_planeNormals[axis];
+}
+
+const std::vector<FloatType>& BrushGeometryStore::planeDistances() const
+{
+  return m_planeDistances;
+}
+
+size_t BrushGeometryStore::unusedVertexCount() const
+{
+  return m_vertices[0].size() - m_vertexCount;
+}
+
+size_t BrushGeometryStore::unusedFaceCount() const
+{
+  return m_planeDistances.size() - m_faceCount;
+}
+
+void BrushGeometryStore::writeGeometry(const size_t brushIndex)
+{
+  const auto& brush = m_brushNodes[brushIndex]->brush();
+
+  const auto& bounds = brush.bounds();
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    m_boundsMin[axis][brushIndex] = bounds.min[axis];
+    m_boundsMax[axis][brushIndex] = bounds.max[axis];
+  }
+
+  auto& vertexRange = m_vertexRanges[brushIndex];
+  const auto vertexCount = brush.vertexCount();
+  if (vertexCount > m_vertexCapacities[brushIndex])
+  {
+    // the vertices don't fit into the current range, move them to the end
+    vertexRange.offset = m_vertices[0].size();
+    m_vertexCapacities[brushIndex] = vertexCount;
+    for (auto& coords : m_vertices)
+    {
+      coords.resize(vertexRange.offset + vertexCount);
+    }
+  }
+  m_vertexCount = m_vertexCount - vertexRange.count + vertexCount;
+  vertexRange.count = vertexCount;
+
+  auto vertexIndex = vertexRange.offset;
+  for (const auto* vertex : brush.vertices())
+  {
+    const auto& position = vertex->position();
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      m_vertices[axis][vertexIndex] = position[axis];
+    }
+    ++vertexIndex;
+  }
+
+  auto& faceRange = m_faceRanges[brushIndex];
+  const auto faceCount = brush.faceCount();
+  if (faceCount > m_faceCapacities[brushIndex])
+  {
+    faceRange.offset = m_planeDistances.size();
+    m_faceCapacities[brushIndex] = faceCount;
+    for (auto& coords : m_planeNormals)
+    {
+      coords.resize(faceRange.offset + faceCount);
+    }
+    m_planeDistances.resize(faceRange.offset + faceCount);
+  }
+  m_faceCount = m_faceCount - faceRange.count + faceCount;
+  faceRange.count = faceCount;
+
+  auto faceIndex = faceRange.offset;
+  for (const auto& face : brush.faces())
+  {
+    const auto& boundary = face.boundary();
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      m_planeNormals[axis][faceIndex] = boundary.normal[axis];
+    }
+    m_planeDistances[faceIndex] = boundary.distance;
+    ++faceIndex;
+  }
+}
+
+void BrushGeometryStore::compactIfFragmented()
+{
+  if (unusedVertexCount() > m_vertexCount || unusedFaceCount() > m_faceCount)
+  {
+    compact();
+  }
+}
+
+} // namespace TrenchBroom::Model
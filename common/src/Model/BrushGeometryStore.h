@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class BrushNode;
+
+/**
+ * A compact copy of the bounds, vertices and face planes of a set of brushes, stored as
+ * structure of arrays so that bulk queries can scan it linearly instead of following the
+ * pointers of every brush's faces and polyhedron.
+ *
+ * Every brush has an index into the per brush arrays. The vertices and face planes of a
+ * brush occupy a contiguous range of the per vertex and per face arrays. When a brush is
+ * updated and its geometry no longer fits into its range, it is moved to the end of the
+ * arrays. The unused entries are only removed when more than half of the entries are
+ * unused, or when compact() is called, so a linear scan over the per vertex or per face
+ * arrays must skip entries that are not within the range of any brush.
+ *
+ * The indices of brushes change when brushes are removed.
+ */
+class BrushGeometryStore
+{
+public:
+  struct Range
+  {
+    size_t offset;
+    size_t count;
+  };
+
+private:
+  // per brush
+  std::vector<const BrushNode*> m_brushNodes;
+  std::array<std::vector<FloatType>, 3> m_boundsMin;
+  std::array<std::vector<FloatType>, 3> m_boundsMax;
+  std::vector<Range> m_vertexRanges;
+  std::vector<Range> m_faceRanges;
+  // the number of entries reserved for the vertices and faces of each brush
+  std::vector<size_t> m_vertexCapacities;
+  std::vector<size_t> m_faceCapacities;
+
+  // per vertex
+  std::array<std::vector<FloatType>, 3> m_vertices;
+
+  // per face
+  std::array<std::vector<FloatType>, 3> m_planeNormals;
+  std::vector<FloatType> m_planeDistances;
+
+  std::unordered_map<const BrushNode*, size_t> m_brushIndices;
+  // the number of vertices and faces of all brushes
+  size_t m_vertexCount{0};
+  size_t m_faceCount{0};
+
+public:
+  void addBrush(const BrushNode& brushNode);
+  void updateBrush(const BrushNode& brushNode);
+  void removeBrush(const BrushNode& brushNode);
+  void clear();
+
+  /**
+   * Removes all unused entries from the per vertex and per face arrays and orders the
+   * ranges by brush index.
+   */
+  void compact();
+
+  size_t brushCount() const;
+  bool contains(const BrushNode& brushNode) const;
+  size_t brushIndex(const BrushNode& brushNode) const;
+
+  const std::vector<const BrushNode*>& brushNodes() const;
+  const std::vector<FloatType>& boundsMin(size_t axis) const;
+  const std::vector<FloatType>& boundsMax(size_t axis) const;
+  const std::vector<Range>& vertexRanges() const;
+  const std::vector<Range>& faceRanges() const;
+
+  const std::vector<FloatType>& vertices(size_t axis) const;
+  const std::vector<FloatType>& planeNormals(size_t axis) const;
+  const std::vector<FloatType>& planeDistances() const;
+
+  /**
+   * The number of entries in the per vertex and per face arrays that are not used by any
+   * brush.
+   */
+  size_t unusedVertexCount() const;
+  size_t unusedFaceCount() const;
+
+private:
+  void writeGeometry(size_t brushIndex);
+  void compactIfFragmented();
+};
+
+} // namespace TrenchBroom::Model
@@ -58,6 +58,7 @@
 
 #include <algorithm> // for std::remove
 #include <iterator>
+#include <limits>
 #include <set>
 #include <string>
 #include <vector>
@@ -154,6 +155,8 @@ void BrushNode::setFaceTexture(const size_t faceIndex, Assets::Texture* texture)
 {
   m_brush.face(faceIndex).setTexture(texture);
 
+  // the serialized surface attributes of a face may be resolved from its texture
+  invalidateSerializedText();
   invalidateIssues();
   invalidateVertexCache();
 }
@@ -387,18 +390,65 @@ void BrushNode::doFindNodesContaining(const vm::vec3& point, std::vector<Node*>&
 std::optional<std::tuple<FloatType, size_t>> BrushNode::findFaceHit(
   const vm::ray3& ray) const
 {
-  if (!vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds())))
+  if (vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds())))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+    return std::nullopt;
+  }
+
+  // Clip the ray against the face planes first. Since the brush is convex, the ray can
+  // only hit the face whose plane it enters last, and it misses the brush if the point
+  // where it enters that plane is outside of any other face plane. This only needs a few
+  // dot products per face, whereas the polygon tests below are expensive.
+  auto entryDistance = -std::numeric_limits<FloatType>::infinity();
+  auto entryFaceIndex = std::optional<size_t>{};
+  for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+  {
+    const auto& plane = m_brush.face(i).boundary();
+    const auto cos = vm::dot(plane.normal, ray.direction);
+    if (cos < FloatType(0))
     {
-      const auto& face = m_brush.face(i);
-      const auto distance = face.intersectWithRay(ray);
-      if (!vm::is_nan(distance))
+      const auto distance = -plane.point_distance(ray.origin) / cos;
+      if (distance > entryDistance)
       {
-        return std::make_tuple(distance, i);
+        entryDistance = distance;
+        entryFaceIndex = i;
       }
     }
   }
+
+  if (!entryFaceIndex)
+  {
+    return std::nullopt;
+  }
+
+  // the face polygons may deviate slightly from their planes, so only reject the ray if
+  // it clearly misses the brush
+  constexpr auto clipEpsilon = FloatType(0.1);
+  const auto entryPoint = vm::point_at_distance(ray, entryDistance);
+  for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+  {
+    if (m_brush.face(i).boundary().point_distance(entryPoint) > clipEpsilon)
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (const auto distance = m_brush.face(*entryFaceIndex).intersectWithRay(ray);
+      !vm::is_nan(distance))
+  {
+    return std::make_tuple(distance, *entryFaceIndex);
+  }
+
+  // the ray passes close to an edge of the entry face, so check all faces
+  for (size_t i = 0u; i < m_brush.faceCount(); ++i)
+  {
+    const auto& face = m_brush.face(i);
+    const auto distance = face.intersectWithRay(ray);
+    if (!vm::is_nan(distance))
+    {
+      return std::make_tuple(distance, i);
+    }
+  }
   return std::nullopt;
 }
 
@@ -210,12 +210,11 @@ bool EditorContext::visible(const Model::BrushNode* brushNode) const
     return false;
   }
 
-  if (brushNode->hasTag(m_hiddenTags))
-  {
-    return false;
-  }
-
-  if (brushNode->allFacesHaveAnyTagInMask(m_hiddenTags))
+  // checking the face tags visits every face, so skip it if nothing is hidden by tags
+  if (
+    m_hiddenTags != 0
+    && (brushNode->hasTag(m_hiddenTags)
+        || brushNode->allFacesHaveAnyTagInMask(m_hiddenTags)))
   {
     return false;
   }
@@ -231,7 +230,7 @@ bool EditorContext::visible(const Model::BrushNode* brushNode) const
 bool EditorContext::visible(
   const Model::BrushNode* brushNode, const Model::BrushFace& face) const
 {
-  return visible(brushNode) && !face.hasTag(m_hiddenTags);
+  return visible(brushNode) && !hidden(face);
 }
 
 bool EditorContext::visible(const Model::PatchNode* patchNode) const
@@ -249,6 +248,11 @@ bool EditorContext::visible(const Model::PatchNode* patchNode) const
   return patchNode->visible();
 }
 
+bool EditorContext::hidden(const Model::BrushFace& face) const
+{
+  return face.hasTag(m_hiddenTags);
+}
+
 bool EditorContext::anyChildVisible(const Model::Node* node) const
 {
   const auto& children = node->children();
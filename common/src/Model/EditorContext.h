@@ -87,6 +87,12 @@ public:
   bool visible(const Model::BrushNode* brushNode, const Model::BrushFace& face) const;
   bool visible(const Model::PatchNode* patchNode) const;
 
+  /**
+   * Indicates whether the given face is hidden by its tags, regardless of whether its
+   * brush is visible.
+   */
+  bool hidden(const Model::BrushFace& face) const;
+
 private:
   bool anyChildVisible(const Model::Node* node) const;
 
@@ -114,6 +114,7 @@ void Entity::setProperties(
   const EntityPropertyConfig& propertyConfig, std::vector<EntityProperty> properties)
 {
   m_properties = std::move(properties);
+  invalidateCachedSpecifications();
   updateCachedProperties(propertyConfig);
 }
 
@@ -170,6 +171,7 @@ void Entity::setDefinition(
   }
 
   m_definition = Assets::AssetReference{definition};
+  invalidateCachedSpecifications();
   updateCachedProperties(propertyConfig);
 }
 
@@ -196,8 +198,13 @@ Assets::ModelSpecification Entity::modelSpecification() const
     const auto* pointDefinition =
       dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->modelDefinition().modelSpecification(variableStore);
+    if (!m_cachedModelSpecification)
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointDefinition->modelDefinition().modelSpecification(variableStore);
+    }
+    return *m_cachedModelSpecification;
   }
   else
   {
@@ -216,8 +223,13 @@ Assets::DecalSpecification Entity::decalSpecification() const
     const auto* pointDefinition =
       dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition().decalSpecification(variableStore);
+    if (!m_cachedDecalSpecification)
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition().decalSpecification(variableStore);
+    }
+    return *m_cachedDecalSpecification;
   }
   else
   {
@@ -234,6 +246,7 @@ void Entity::unsetEntityDefinitionAndModel()
 
   m_definition = Assets::AssetReference<Assets::EntityDefinition>{};
   m_model = nullptr;
+  invalidateCachedSpecifications();
   m_cachedProperties.rotation = entityRotation(*this);
   m_cachedProperties.modelTransformation = vm::mat4x4::identity();
 }
@@ -255,10 +268,11 @@ void Entity::addOrUpdateProperty(
 
     if (defaultToProtected && !kdl::vec_contains(m_protectedProperties, key))
     {
-      m_protectedProperties.push_back(std::move(key));
+      m_protectedProperties.push_back(key);
     }
   }
-  updateCachedProperties(propertyConfig);
+  invalidateCachedSpecifications(key);
+  updateCachedProperties(propertyConfig, key);
 }
 
 void Entity::renameProperty(
@@ -288,6 +302,9 @@ void Entity::renameProperty(
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
+
     oldIt->setKey(std::move(newKey));
     updateCachedProperties(propertyConfig);
   }
@@ -300,7 +317,8 @@ void Entity::removeProperty(
   if (it != std::end(m_properties))
   {
     m_properties.erase(it);
-    updateCachedProperties(propertyConfig);
+    invalidateCachedSpecifications(key);
+    updateCachedProperties(propertyConfig, key);
   }
 }
 
@@ -312,6 +330,7 @@ void Entity::removeNumberedProperty(
   {
     if (it->hasNumberedPrefix(prefix))
     {
+      invalidateCachedSpecifications(it->key());
       it = m_properties.erase(it);
     }
     else
@@ -456,6 +475,37 @@ void Entity::updateCachedProperties(const EntityPropertyConfig& propertyConfig)
                 : vm::vec3::zero();
   m_cachedProperties.rotation = entityRotation(*this);
 
+  updateCachedModelTransformation(propertyConfig);
+}
+
+void Entity::updateCachedProperties(
+  const EntityPropertyConfig& propertyConfig, const std::string& key)
+{
+  if (
+    key == EntityPropertyKeys::Classname || key == EntityPropertyKeys::Origin
+    || key == EntityPropertyKeys::Angle || key == EntityPropertyKeys::Angles
+    || key == EntityPropertyKeys::Mangle || key == EntityPropertyKeys::Target)
+  {
+    updateCachedProperties(propertyConfig);
+    return;
+  }
+
+  // the default scale expression may refer to any property
+  if (
+    const auto* pointDefinition =
+      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  {
+    if (
+      propertyConfig.defaultModelScaleExpression
+      || kdl::vec_contains(pointDefinition->modelDefinition().variableNames(), key))
+    {
+      updateCachedModelTransformation(propertyConfig);
+    }
+  }
+}
+
+void Entity::updateCachedModelTransformation(const EntityPropertyConfig& propertyConfig)
+{
   if (
     const auto* pointDefinition =
       dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
@@ -474,6 +524,29 @@ void Entity::updateCachedProperties(const EntityPropertyConfig& propertyConfig)
   }
 }
 
+void Entity::invalidateCachedSpecifications()
+{
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
+}
+
+void Entity::invalidateCachedSpecifications(const std::string& key)
+{
+  if (
+    const auto* pointDefinition =
+      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  {
+    if (kdl::vec_contains(pointDefinition->modelDefinition().variableNames(), key))
+    {
+      m_cachedModelSpecification = std::nullopt;
+    }
+    if (kdl::vec_contains(pointDefinition->decalDefinition().variableNames(), key))
+    {
+      m_cachedDecalSpecification = std::nullopt;
+    }
+  }
+}
+
 bool operator==(const Entity& lhs, const Entity& rhs)
 {
   return lhs.properties() == rhs.properties();
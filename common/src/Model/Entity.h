@@ -20,6 +20,8 @@
 #pragma once
 
 #include "Assets/AssetReference.h"
+#include "Assets/DecalDefinition.h"
+#include "Assets/ModelDefinition.h"
 #include "FloatType.h"
 #include "Model/EntityProperties.h"
 
@@ -35,10 +37,8 @@ namespace TrenchBroom
 {
 namespace Assets
 {
-struct DecalSpecification;
 class EntityDefinition;
 class EntityModelFrame;
-struct ModelSpecification;
 } // namespace Assets
 
 namespace Model
@@ -116,6 +116,14 @@ private:
 
   CachedProperties m_cachedProperties;
 
+  /**
+   * The model and decal specifications are evaluated lazily and cached. A cached
+   * specification is only discarded when the definition changes or when a property that
+   * the corresponding expression refers to changes.
+   */
+  mutable std::optional<Assets::ModelSpecification> m_cachedModelSpecification;
+  mutable std::optional<Assets::DecalSpecification> m_cachedDecalSpecification;
+
 public:
   Entity();
   Entity(
@@ -209,6 +217,16 @@ private:
     const EntityPropertyConfig& propertyConfig, const vm::mat4x4& rotation);
 
   void updateCachedProperties(const EntityPropertyConfig& propertyConfig);
+
+  /**
+   * Updates only the cached properties that depend on the property with the given key.
+   */
+  void updateCachedProperties(
+    const EntityPropertyConfig& propertyConfig, const std::string& key);
+  void updateCachedModelTransformation(const EntityPropertyConfig& propertyConfig);
+
+  void invalidateCachedSpecifications();
+  void invalidateCachedSpecifications(const std::string& key);
 };
 
 bool operator==(const Entity& lhs, const Entity& rhs);
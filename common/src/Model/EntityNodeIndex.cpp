@@ -28,14 +28,39 @@
 #include <kdl/vector_utils.h>
 
 #include <iterator>
-#include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Model
 {
+namespace
+{
+void appendEscaped(std::string& pattern, const std::string_view str)
+{
+  for (const auto c : str)
+  {
+    if (c == '?' || c == '*' || c == '%' || c == '\\')
+    {
+      pattern.push_back('\\');
+    }
+    pattern.push_back(c);
+  }
+}
+
+std::string keyValueIndexKey(const std::string& key, const std::string& value)
+{
+  auto result = std::string{};
+  result.reserve(key.size() + 1u + value.size());
+  result.append(key);
+  result.push_back('\0');
+  result.append(value);
+  return result;
+}
+} // namespace
+
 EntityNodeIndexQuery EntityNodeIndexQuery::exact(const std::string& pattern)
 {
   return EntityNodeIndexQuery(Type_Exact, pattern);
@@ -56,28 +81,41 @@ EntityNodeIndexQuery EntityNodeIndexQuery::any()
   return EntityNodeIndexQuery(Type_Any);
 }
 
-std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
-  const EntityNodeStringIndex& index) const
+std::string EntityNodeIndexQuery::keyPattern() const
 {
-  std::set<EntityNodeBase*> result;
+  auto result = std::string{};
   switch (m_type)
   {
   case Type_Exact:
-    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
+    appendEscaped(result, m_pattern);
     break;
   case Type_Prefix:
-    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+    appendEscaped(result, m_pattern);
+    result.push_back('*');
     break;
   case Type_Numbered:
-    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+    appendEscaped(result, m_pattern);
+    result.append("%*");
     break;
   case Type_Any:
+    result.push_back('*');
     break;
     switchDefault();
   }
   return result;
 }
 
+std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
+  const EntityNodeStringIndex& index) const
+{
+  std::set<EntityNodeBase*> result;
+  if (m_type != Type_Any)
+  {
+    index.find_matches(keyPattern(), std::inserter(result, std::end(result)));
+  }
+  return result;
+}
+
 bool EntityNodeIndexQuery::execute(
   const EntityNodeBase* node, const std::string& value) const
 {
@@ -121,7 +159,7 @@ EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& p
 
 EntityNodeIndex::EntityNodeIndex()
   : m_keyIndex(std::make_unique<EntityNodeStringIndex>())
-  , m_valueIndex(std::make_unique<EntityNodeStringIndex>())
+  , m_keyValueIndex(std::make_unique<EntityNodeStringIndex>())
 {
 }
 
@@ -143,41 +181,28 @@ void EntityNodeIndex::addProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
   m_keyIndex->insert(key, node);
-  m_valueIndex->insert(value, node);
+  m_keyValueIndex->insert(keyValueIndexKey(key, value), node);
 }
 
 void EntityNodeIndex::removeProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
   m_keyIndex->remove(key, node);
-  m_valueIndex->remove(value, node);
+  m_keyValueIndex->remove(keyValueIndexKey(key, value), node);
 }
 
 std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
   const EntityNodeIndexQuery& keyQuery, const std::string& value) const
 {
-  // first, find Nodes which have `value` as the value for any key
-  std::vector<EntityNodeBase*> result;
-  m_valueIndex->find_matches(value, std::back_inserter(result));
-  if (result.empty())
-  {
-    return {};
-  }
-
-  result = kdl::vec_sort_and_remove_duplicates(std::move(result));
+  auto pattern = keyQuery.keyPattern();
+  pattern.push_back('\0');
+  appendEscaped(pattern, value);
 
-  // next, remove results from the result set that don't match `keyQuery`
-  auto it = std::begin(result);
-  while (it != std::end(result))
-  {
-    const EntityNodeBase* node = *it;
-    if (!keyQuery.execute(node, value))
-      it = result.erase(it);
-    else
-      ++it;
-  }
+  std::vector<EntityNodeBase*> result;
+  m_keyValueIndex->find_matches(pattern, std::back_inserter(result));
 
-  return result;
+  // a node can match more than once if the query matches more than one key
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
 std::vector<std::string> EntityNodeIndex::allKeys() const
@@ -56,6 +56,12 @@ public:
   static EntityNodeIndexQuery numbered(const std::string& pattern);
   static EntityNodeIndexQuery any();
 
+  /**
+   * Returns a glob pattern that matches the keys matched by this query. Special
+   * characters in the query pattern are escaped.
+   */
+  std::string keyPattern() const;
+
   std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
   bool execute(const EntityNodeBase* node, const std::string& value) const;
   std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
@@ -64,11 +70,20 @@ private:
   explicit EntityNodeIndexQuery(Type type, const std::string& pattern = "");
 };
 
+/**
+ * Indexes entity nodes by their property keys and values.
+ *
+ * Besides an index of the property keys, this maintains an index of strings consisting of
+ * a property's key and value separated by a null character. Finding the nodes with a
+ * given value for the keys matched by a query is a single lookup in that index, so the
+ * cost depends on the length of the key and value and on the number of results, but not
+ * on how many other nodes share the same key or the same value.
+ */
 class EntityNodeIndex
 {
 private:
   std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
-  std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+  std::unique_ptr<EntityNodeStringIndex> m_keyValueIndex;
 
 public:
   EntityNodeIndex();
@@ -23,47 +23,81 @@
 
 #include <kdl/reflection_impl.h>
 #include <kdl/string_compare.h>
+#include <kdl/struct_io.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Model
 {
+namespace
+{
+/**
+ * Returns the interned instance of the given key. Interned keys are never removed, so the
+ * returned reference remains valid until the program exits.
+ *
+ * This function is thread safe because maps are loaded on multiple threads.
+ */
+const std::string& internKey(std::string key)
+{
+  static auto mutex = std::shared_mutex{};
+  static auto keys = std::unordered_set<std::string>{};
+
+  {
+    const auto lock = std::shared_lock{mutex};
+    if (const auto it = keys.find(key); it != keys.end())
+    {
+      return *it;
+    }
+  }
+
+  const auto lock = std::unique_lock{mutex};
+  return *keys.insert(std::move(key)).first;
+}
+} // namespace
+
 namespace EntityPropertyKeys
 {
-const std::string Classname = "classname";
-const std::string Origin = "origin";
-const std::string Wad = "wad";
-const std::string Mods = "_tb_mod";
-const std::string Spawnflags = "spawnflags";
-const std::string EntityDefinitions = "_tb_def";
-const std::string Angle = "angle";
-const std::string Angles = "angles";
-const std::string Mangle = "mangle";
-const std::string Target = "target";
-const std::string Targetname = "targetname";
-const std::string Killtarget = "killtarget";
-const std::string ProtectedEntityProperties = "_tb_protected_properties";
-const std::string GroupType = "_tb_type";
-const std::string LayerId = "_tb_id";
-const std::string LayerName = "_tb_name";
-const std::string LayerSortIndex = "_tb_layer_sort_index";
-const std::string LayerColor = "_tb_layer_color";
-const std::string LayerLocked = "_tb_layer_locked";
-const std::string LayerHidden = "_tb_layer_hidden";
-const std::string LayerOmitFromExport = "_tb_layer_omit_from_export";
-const std::string Layer = "_tb_layer";
-const std::string GroupId = "_tb_id";
-const std::string GroupName = "_tb_name";
-const std::string Group = "_tb_group";
-const std::string GroupTransformation = "_tb_transformation";
-const std::string LinkedGroupId = "_tb_linked_group_id";
-const std::string Message = "_tb_message";
-const std::string ValveVersion = "mapversion";
-const std::string SoftMapBounds = "_tb_soft_map_bounds";
+const std::string& Classname = internKey("classname");
+const std::string& Origin = internKey("origin");
+const std::string& Wad = internKey("wad");
+const std::string& Mods = internKey("_tb_mod");
+const std::string& Spawnflags = internKey("spawnflags");
+const std::string& EntityDefinitions = internKey("_tb_def");
+const std::string& Angle = internKey("angle");
+const std::string& Angles = internKey("angles");
+const std::string& Mangle = internKey("mangle");
+const std::string& Target = internKey("target");
+const std::string& Targetname = internKey("targetname");
+const std::string& Killtarget = internKey("killtarget");
+const std::string& ProtectedEntityProperties = internKey("_tb_protected_properties");
+const std::string& GroupType = internKey("_tb_type");
+const std::string& LayerId = internKey("_tb_id");
+const std::string& LayerName = internKey("_tb_name");
+const std::string& LayerSortIndex = internKey("_tb_layer_sort_index");
+const std::string& LayerColor = internKey("_tb_layer_color");
+const std::string& LayerLocked = internKey("_tb_layer_locked");
+const std::string& LayerHidden = internKey("_tb_layer_hidden");
+const std::string& LayerOmitFromExport = internKey("_tb_layer_omit_from_export");
+const std::string& Layer = internKey("_tb_layer");
+const std::string& GroupId = internKey("_tb_id");
+const std::string& GroupName = internKey("_tb_name");
+const std::string& Group = internKey("_tb_group");
+const std::string& GroupTransformation = internKey("_tb_transformation");
+const std::string& LinkedGroupId = internKey("_tb_linked_group_id");
+const std::string& Message = internKey("_tb_message");
+const std::string& ValveVersion = internKey("mapversion");
+const std::string& SoftMapBounds = internKey("_tb_soft_map_bounds");
 } // namespace EntityPropertyKeys
 
 namespace EntityPropertyValues
@@ -85,24 +119,78 @@ kdl_reflect_impl(EntityPropertyConfig);
 
 bool isNumberedProperty(std::string_view prefix, std::string_view key)
 {
-  // %* matches 0 or more digits
-  const std::string pattern = std::string(prefix) + "%*";
-  return kdl::cs::str_matches_glob(key, pattern);
+  // the key must consist of the prefix followed by 0 or more digits
+  return kdl::cs::str_is_prefix(key, prefix)
+         && std::all_of(
+           std::next(std::begin(key), std::ptrdiff_t(prefix.size())),
+           std::end(key),
+           [](const auto c) { return c >= '0' && c <= '9'; });
 }
 
-EntityProperty::EntityProperty() = default;
+EntityProperty::EntityProperty()
+  : m_key{&internKey("")}
+{
+}
 
 EntityProperty::EntityProperty(std::string key, std::string value)
-  : m_key{std::move(key)}
+  : m_key{&internKey(std::move(key))}
   , m_value{std::move(value)}
 {
 }
 
-kdl_reflect_impl(EntityProperty);
+namespace
+{
+int compare(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  // interned keys are equal if and only if they have the same address
+  if (&lhs.key() != &rhs.key())
+  {
+    return lhs.key() < rhs.key() ? -1 : 1;
+  }
+  return lhs.value().compare(rhs.value());
+}
+} // namespace
+
+bool operator==(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return lhs.m_key == rhs.m_key && lhs.m_value == rhs.m_value;
+}
+
+bool operator!=(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator<(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return compare(lhs, rhs) < 0;
+}
+
+bool operator<=(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return compare(lhs, rhs) <= 0;
+}
+
+bool operator>(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return compare(lhs, rhs) > 0;
+}
+
+bool operator>=(const EntityProperty& lhs, const EntityProperty& rhs)
+{
+  return compare(lhs, rhs) >= 0;
+}
+
+std::ostream& operator<<(std::ostream& lhs, const EntityProperty& rhs)
+{
+  kdl::struct_stream{lhs} << "EntityProperty"
+                          << "m_key" << rhs.key() << "m_value" << rhs.value();
+  return lhs;
+}
 
 const std::string& EntityProperty::key() const
 {
-  return m_key;
+  return *m_key;
 }
 
 const std::string& EntityProperty::value() const
@@ -112,7 +200,9 @@ const std::string& EntityProperty::value() const
 
 bool EntityProperty::hasKey(std::string_view key) const
 {
-  return kdl::cs::str_is_equal(m_key, key);
+  // compare the addresses first in case the given key is interned
+  return (m_key->data() == key.data() && m_key->size() == key.size())
+         || kdl::cs::str_is_equal(*m_key, key);
 }
 
 bool EntityProperty::hasValue(const std::string_view value) const
@@ -127,7 +217,7 @@ bool EntityProperty::hasKeyAndValue(std::string_view key, std::string_view value
 
 bool EntityProperty::hasPrefix(const std::string_view prefix) const
 {
-  return kdl::cs::str_is_prefix(m_key, prefix);
+  return kdl::cs::str_is_prefix(*m_key, prefix);
 }
 
 bool EntityProperty::hasPrefixAndValue(
@@ -138,7 +228,7 @@ bool EntityProperty::hasPrefixAndValue(
 
 bool EntityProperty::hasNumberedPrefix(const std::string_view prefix) const
 {
-  return isNumberedProperty(prefix, m_key);
+  return isNumberedProperty(prefix, *m_key);
 }
 
 bool EntityProperty::hasNumberedPrefixAndValue(
@@ -149,7 +239,7 @@ bool EntityProperty::hasNumberedPrefixAndValue(
 
 void EntityProperty::setKey(std::string key)
 {
-  m_key = std::move(key);
+  m_key = &internKey(std::move(key));
 }
 
 void EntityProperty::setValue(std::string value)
@@ -23,8 +23,10 @@
 
 #include <kdl/reflection_decl.h>
 
+#include <iosfwd>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom
@@ -33,36 +35,36 @@ namespace Model
 {
 namespace EntityPropertyKeys
 {
-extern const std::string Classname;
-extern const std::string Origin;
-extern const std::string Wad;
-extern const std::string Mods;
-extern const std::string Spawnflags;
-extern const std::string EntityDefinitions;
-extern const std::string Angle;
-extern const std::string Angles;
-extern const std::string Mangle;
-extern const std::string Target;
-extern const std::string Targetname;
-extern const std::string Killtarget;
-extern const std::string ProtectedEntityProperties;
-extern const std::string GroupType;
-extern const std::string LayerId;
-extern const std::string LayerName;
-extern const std::string LayerSortIndex;
-extern const std::string LayerColor;
-extern const std::string LayerLocked;
-extern const std::string LayerHidden;
-extern const std::string LayerOmitFromExport;
-extern const std::string Layer;
-extern const std::string GroupId;
-extern const std::string GroupName;
-extern const std::string Group;
-extern const std::string GroupTransformation;
-extern const std::string LinkedGroupId;
-extern const std::string Message;
-extern const std::string ValveVersion;
-extern const std::string SoftMapBounds;
+extern const std::string& Classname;
+extern const std::string& Origin;
+extern const std::string& Wad;
+extern const std::string& Mods;
+extern const std::string& Spawnflags;
+extern const std::string& EntityDefinitions;
+extern const std::string& Angle;
+extern const std::string& Angles;
+extern const std::string& Mangle;
+extern const std::string& Target;
+extern const std::string& Targetname;
+extern const std::string& Killtarget;
+extern const std::string& ProtectedEntityProperties;
+extern const std::string& GroupType;
+extern const std::string& LayerId;
+extern const std::string& LayerName;
+extern const std::string& LayerSortIndex;
+extern const std::string& LayerColor;
+extern const std::string& LayerLocked;
+extern const std::string& LayerHidden;
+extern const std::string& LayerOmitFromExport;
+extern const std::string& Layer;
+extern const std::string& GroupId;
+extern const std::string& GroupName;
+extern const std::string& Group;
+extern const std::string& GroupTransformation;
+extern const std::string& LinkedGroupId;
+extern const std::string& Message;
+extern const std::string& ValveVersion;
+extern const std::string& SoftMapBounds;
 } // namespace EntityPropertyKeys
 
 namespace EntityPropertyValues
@@ -95,17 +97,31 @@ struct EntityPropertyConfig
 
 bool isNumberedProperty(std::string_view prefix, std::string_view key);
 
+/**
+ * A key / value pair of an entity.
+ *
+ * Property keys are interned: All properties with the same key refer to a single shared
+ * instance of that key, which is never freed. This saves memory because most keys occur
+ * in many entities, and it allows comparing the keys of two properties by their
+ * addresses. The keys in EntityPropertyKeys refer to the interned instances too.
+ */
 class EntityProperty
 {
 private:
-  std::string m_key;
+  const std::string* m_key;
   std::string m_value;
 
 public:
   EntityProperty();
   EntityProperty(std::string key, std::string value);
 
-  kdl_reflect_decl(EntityProperty, m_key, m_value);
+  friend bool operator==(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend bool operator!=(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend bool operator<(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend bool operator<=(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend bool operator>(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend bool operator>=(const EntityProperty& lhs, const EntityProperty& rhs);
+  friend std::ostream& operator<<(std::ostream& lhs, const EntityProperty& rhs);
 
   const std::string& key() const;
   const std::string& value() const;
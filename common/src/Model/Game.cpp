@@ -111,11 +111,21 @@ Result<void> Game::writeMap(WorldNode& world, const std::filesystem::path& path)
   return doWriteMap(world, path);
 }
 
+void Game::writeMap(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMap(world, stream);
+}
+
 Result<void> Game::exportMap(WorldNode& world, const IO::ExportOptions& options) const
 {
   return doExportMap(world, options);
 }
 
+void Game::exportMap(WorldNode& world, std::ostream& stream) const
+{
+  doExportMap(world, stream);
+}
+
 std::vector<Node*> Game::parseNodes(
   const std::string& str,
   const MapFormat mapFormat,
@@ -170,6 +180,11 @@ Result<void> Game::reloadShaders()
   return doReloadShaders();
 }
 
+void Game::refreshFileSystem()
+{
+  doRefreshFileSystem();
+}
+
 bool Game::isEntityDefinitionFile(const std::filesystem::path& path) const
 {
   return doIsEntityDefinitionFile(path);
@@ -31,6 +31,7 @@
 #include <vecmath/forward.h>
 
 #include <filesystem>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
@@ -114,7 +115,9 @@ public: // loading and writing map files
     const std::filesystem::path& path,
     Logger& logger) const;
   Result<void> writeMap(WorldNode& world, const std::filesystem::path& path) const;
+  void writeMap(WorldNode& world, std::ostream& stream) const;
   Result<void> exportMap(WorldNode& world, const IO::ExportOptions& options) const;
+  void exportMap(WorldNode& world, std::ostream& stream) const;
 
 public: // parsing and serializing objects
   std::vector<Node*> parseNodes(
@@ -143,6 +146,7 @@ public: // texture collection handling
     const std::vector<std::filesystem::path>& wadPaths,
     Logger& logger);
   Result<void> reloadShaders();
+  void refreshFileSystem();
 
 public: // entity definition handling
   bool isEntityDefinitionFile(const std::filesystem::path& path) const;
@@ -191,8 +195,10 @@ private: // subclassing interface
     Logger& logger) const = 0;
   virtual Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path) const = 0;
+  virtual void doWriteMap(WorldNode& world, std::ostream& stream) const = 0;
   virtual Result<void> doExportMap(
     WorldNode& world, const IO::ExportOptions& options) const = 0;
+  virtual void doExportMap(WorldNode& world, std::ostream& stream) const = 0;
 
   virtual std::vector<Node*> doParseNodes(
     const std::string& str,
@@ -219,6 +225,7 @@ private: // subclassing interface
     const std::vector<std::filesystem::path>& wadPaths,
     Logger& logger) = 0;
   virtual Result<void> doReloadShaders() = 0;
+  virtual void doRefreshFileSystem() = 0;
 
   virtual bool doIsEntityDefinitionFile(const std::filesystem::path& path) const = 0;
   virtual std::vector<Assets::EntityDefinitionFileSpec> doAllEntityDefinitionFiles()
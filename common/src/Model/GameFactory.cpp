@@ -45,6 +45,7 @@
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -63,8 +64,16 @@ GameFactory& GameFactory::instance()
 Result<std::vector<std::string>> GameFactory::initialize(
   const GamePathConfig& gamePathConfig)
 {
+  const auto startTime = std::chrono::steady_clock::now();
   return initializeFileSystem(gamePathConfig).and_then([&]() {
-    return loadGameConfigs();
+    const auto fileSystemTime = std::chrono::steady_clock::now();
+    m_loadStats.fileSystemTime = fileSystemTime - startTime;
+
+    return loadGameConfigs().transform([&](auto errors) {
+      m_loadStats.gameConfigs = m_configs.size();
+      m_loadStats.gameConfigsTime = std::chrono::steady_clock::now() - fileSystemTime;
+      return errors;
+    });
   });
 }
 
@@ -75,8 +84,11 @@ void GameFactory::reset()
 
   m_names.clear();
   m_configs.clear();
+  m_loadedProfiles.clear();
   m_gamePaths.clear();
   m_defaultEngines.clear();
+
+  m_loadStats = LoadStats{};
 }
 
 void GameFactory::saveGameEngineConfig(
@@ -105,21 +117,38 @@ size_t GameFactory::gameCount() const
 
 std::shared_ptr<Game> GameFactory::createGame(const std::string& gameName, Logger& logger)
 {
+  if (m_loadedProfiles.count(gameName) == 0)
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    loadProfiles(findGameConfig(gameName));
+    logger.debug() << "Loaded profiles for " << gameName << " in "
+                   << std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - startTime)
+                          .count()
+                   << "ms";
+  }
+
   return std::make_shared<GameImpl>(gameConfig(gameName), gamePath(gameName), logger);
 }
 
 std::vector<std::string> GameFactory::fileFormats(const std::string& gameName) const
 {
-  return kdl::vec_transform(
-    gameConfig(gameName).fileFormats, [](const auto& format) { return format.format; });
+  return kdl::vec_transform(findGameConfig(gameName).fileFormats, [](const auto& format) {
+    return format.format;
+  });
 }
 
 std::filesystem::path GameFactory::iconPath(const std::string& gameName) const
 {
-  const auto& config = gameConfig(gameName);
+  const auto& config = findGameConfig(gameName);
   return config.findConfigFile(config.icon);
 }
 
+bool GameFactory::experimental(const std::string& gameName) const
+{
+  return findGameConfig(gameName).experimental;
+}
+
 std::filesystem::path GameFactory::gamePath(const std::string& gameName) const
 {
   const auto it = m_gamePaths.find(gameName);
@@ -182,22 +211,16 @@ bool GameFactory::setCompilationToolPath(
 
 GameConfig& GameFactory::gameConfig(const std::string& name)
 {
-  const auto cIt = m_configs.find(name);
-  if (cIt == std::end(m_configs))
-  {
-    throw GameException{"Unknown game: " + name};
-  }
-  return cIt->second;
+  auto& config = findGameConfig(name);
+  loadProfiles(config);
+  return config;
 }
 
 const GameConfig& GameFactory::gameConfig(const std::string& name) const
 {
-  const auto cIt = m_configs.find(name);
-  if (cIt == std::end(m_configs))
-  {
-    throw GameException{"Unknown game: " + name};
-  }
-  return cIt->second;
+  auto& config = findGameConfig(name);
+  loadProfiles(config);
+  return config;
 }
 
 namespace
@@ -250,6 +273,11 @@ const std::filesystem::path& GameFactory::userGameConfigsPath() const
   return m_userGameDir;
 }
 
+const GameFactory::LoadStats& GameFactory::loadStats() const
+{
+  return m_loadStats;
+}
+
 GameFactory::GameFactory() = default;
 
 Result<void> GameFactory::initializeFileSystem(const GamePathConfig& gamePathConfig)
@@ -304,9 +332,6 @@ Result<void> GameFactory::loadGameConfig(const std::filesystem::path& path)
       {
         auto config = parser.parse();
 
-        loadCompilationConfig(config);
-        loadGameEngineConfig(config);
-
         const auto configName = config.name;
         m_configs.emplace(configName, std::move(config));
         kdl::wrap_set(m_names).insert(configName);
@@ -330,7 +355,32 @@ Result<void> GameFactory::loadGameConfig(const std::filesystem::path& path)
     });
 }
 
-void GameFactory::loadCompilationConfig(GameConfig& gameConfig)
+GameConfig& GameFactory::findGameConfig(const std::string& gameName) const
+{
+  const auto cIt = m_configs.find(gameName);
+  if (cIt == std::end(m_configs))
+  {
+    throw GameException{"Unknown game: " + gameName};
+  }
+  return cIt->second;
+}
+
+void GameFactory::loadProfiles(GameConfig& gameConfig) const
+{
+  if (!m_loadedProfiles.insert(gameConfig.name).second)
+  {
+    return;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  loadCompilationConfig(gameConfig);
+  loadGameEngineConfig(gameConfig);
+
+  m_loadStats.loadedProfiles += 1;
+  m_loadStats.profilesTime += std::chrono::steady_clock::now() - startTime;
+}
+
+void GameFactory::loadCompilationConfig(GameConfig& gameConfig) const
 {
   const auto path = std::filesystem::path{gameConfig.name} / "CompilationProfiles.cfg";
   try
@@ -360,7 +410,7 @@ void GameFactory::loadCompilationConfig(GameConfig& gameConfig)
   }
 }
 
-void GameFactory::loadGameEngineConfig(GameConfig& gameConfig)
+void GameFactory::loadGameEngineConfig(GameConfig& gameConfig) const
 {
   const auto path = std::filesystem::path{gameConfig.name} / "GameEngineProfiles.cfg";
   try
@@ -22,9 +22,11 @@
 #include "Model/MapFormat.h"
 #include "Result.h"
 
+#include <chrono>
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -57,6 +59,16 @@ struct GamePathConfig
 
 class GameFactory
 {
+public:
+  struct LoadStats
+  {
+    size_t gameConfigs{0};
+    size_t loadedProfiles{0};
+    std::chrono::steady_clock::duration fileSystemTime{};
+    std::chrono::steady_clock::duration gameConfigsTime{};
+    std::chrono::steady_clock::duration profilesTime{};
+  };
+
 private:
   using ConfigMap = std::map<std::string, GameConfig>;
   using GamePathMap = std::map<std::string, Preference<std::filesystem::path>>;
@@ -65,17 +77,23 @@ private:
   std::unique_ptr<IO::WritableVirtualFileSystem> m_configFs;
 
   std::vector<std::string> m_names;
-  ConfigMap m_configs;
+  // the compilation and game engine profiles are loaded on first access to a config
+  mutable ConfigMap m_configs;
+  mutable std::set<std::string> m_loadedProfiles;
   mutable GamePathMap m_gamePaths;
   mutable GamePathMap m_defaultEngines;
 
+  mutable LoadStats m_loadStats;
+
 public:
   static GameFactory& instance();
 
   /**
    * Initializes the game factory, must be called once when the application starts.
    * Initialization comprises building a file system to find the builtin and user-provided
-   * game configurations and loading them.
+   * game configurations and loading them. The compilation and game engine profiles of a
+   * game are only loaded when its configuration is accessed via gameConfig() or
+   * createGame() for the first time.
    *
    * If the file system cannot be built, a Error is returned. Since this is a fatal
    * error, the caller should inform the user of the error and terminate the application.
@@ -125,6 +143,7 @@ public:
 
   std::vector<std::string> fileFormats(const std::string& gameName) const;
   std::filesystem::path iconPath(const std::string& gameName) const;
+  bool experimental(const std::string& gameName) const;
   std::filesystem::path gamePath(const std::string& gameName) const;
   bool setGamePath(const std::string& gameName, const std::filesystem::path& gamePath);
   bool isGamePathPreference(
@@ -137,6 +156,10 @@ public:
     const std::string& toolName,
     const std::filesystem::path& gamePath);
 
+  /**
+   * Returns the configuration of the game with the given name, loading its compilation
+   * and game engine profiles if they haven't been loaded yet.
+   */
   GameConfig& gameConfig(const std::string& gameName);
   const GameConfig& gameConfig(const std::string& gameName) const;
 
@@ -159,13 +182,20 @@ public:
    */
   const std::filesystem::path& userGameConfigsPath() const;
 
+  /**
+   * Returns the time spent in the phases of initialization and in loading profiles.
+   */
+  const LoadStats& loadStats() const;
+
 private:
   GameFactory();
   Result<void> initializeFileSystem(const GamePathConfig& gamePathConfig);
   Result<std::vector<std::string>> loadGameConfigs();
   Result<void> loadGameConfig(const std::filesystem::path& path);
-  void loadCompilationConfig(GameConfig& gameConfig);
-  void loadGameEngineConfig(GameConfig& gameConfig);
+  GameConfig& findGameConfig(const std::string& gameName) const;
+  void loadProfiles(GameConfig& gameConfig) const;
+  void loadCompilationConfig(GameConfig& gameConfig) const;
+  void loadGameEngineConfig(GameConfig& gameConfig) const;
 
   void writeCompilationConfig(
     GameConfig& gameConfig, CompilationConfig compilationConfig, Logger& logger);
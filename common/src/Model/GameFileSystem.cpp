@@ -35,10 +35,12 @@
 #include "Model/GameConfig.h"
 
 #include "kdl/result_fold.h"
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom::Model
 {
@@ -51,6 +53,7 @@ void GameFileSystem::initialize(
 {
   unmountAll();
   m_shaderFS = nullptr;
+  m_diskFileSystems.clear();
 
   addDefaultAssetPaths(config, logger);
 
@@ -61,9 +64,25 @@ void GameFileSystem::initialize(
   }
 }
 
+void GameFileSystem::refresh()
+{
+  for (auto* diskFS : m_diskFileSystems)
+  {
+    diskFS->refresh();
+  }
+  rebuildIndex();
+}
+
 Result<void> GameFileSystem::reloadShaders()
 {
-  return m_shaderFS ? m_shaderFS->reload() : Result<void>{};
+  if (!m_shaderFS)
+  {
+    return Result<void>{};
+  }
+
+  auto result = m_shaderFS->reload();
+  rebuildIndex();
+  return result;
 }
 
 void GameFileSystem::reloadWads(
@@ -119,7 +138,9 @@ void GameFileSystem::addGameFileSystems(
 void GameFileSystem::addFileSystemPath(const std::filesystem::path& path, Logger& logger)
 {
   logger.info() << "Adding file system path " << path;
-  mount("", std::make_unique<IO::DiskFileSystem>(path));
+  auto diskFS = std::make_unique<IO::CachedDiskFileSystem>(path);
+  m_diskFileSystems.push_back(diskFS.get());
+  mount("", std::move(diskFS));
 }
 
 namespace
@@ -129,7 +150,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
 {
   if (kdl::ci::str_is_equal(packageFormat, "idpak"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::openFileForReading(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::IdPakFileSystem>(std::move(file));
       })
@@ -137,7 +158,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
   }
   else if (kdl::ci::str_is_equal(packageFormat, "dkpak"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::openFileForReading(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::DkPakFileSystem>(std::move(file));
       })
@@ -145,7 +166,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
   }
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::openFileForReading(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::ZipFileSystem>(std::move(file));
       })
@@ -173,17 +194,27 @@ void GameFileSystem::addFileSystemPackages(
         IO::TraversalMode::Flat,
         IO::makeExtensionPathMatcher(packageExtensions))
       .and_then([&](auto packagePaths) {
-        return kdl::fold_results(
-          kdl::vec_transform(std::move(packagePaths), [&](auto packagePath) {
+        // Opening a package reads its entire directory, which is independent of the other
+        // packages, so the packages are opened in parallel. They must be mounted in their
+        // original order though, since later packages override earlier ones.
+        auto fileSystems =
+          kdl::vec_parallel_transform(packagePaths, [&](const auto& packagePath) {
             return diskFS.makeAbsolute(packagePath)
               .and_then([&](const auto& absPackagePath) {
                 return createImageFileSystem(packageFormat, absPackagePath);
-              })
-              .transform([&](auto fs) {
-                logger.info() << "Adding file system package " << packagePath;
-                mount("", std::move(fs));
               });
+          });
+
+        auto results = std::vector<Result<void>>{};
+        results.reserve(fileSystems.size());
+        for (size_t i = 0; i < fileSystems.size(); ++i)
+        {
+          results.push_back(std::move(fileSystems[i]).transform([&](auto fs) {
+            logger.info() << "Adding file system package " << packagePaths[i];
+            mount("", std::move(fs));
           }));
+        }
+        return kdl::fold_results(std::move(results));
       })
       .transform_error([&](auto e) {
         logger.error() << "Could not add file system packages: " << e.msg;
@@ -218,14 +249,19 @@ void GameFileSystem::mountWads(
   const std::vector<std::filesystem::path>& wadPaths,
   Logger& logger)
 {
-  for (const auto& wadPath : wadPaths)
+  // the wads are opened in parallel, but mounted in order, see addFileSystemPackages
+  auto fileSystems = kdl::vec_parallel_transform(wadPaths, [&](const auto& wadPath) {
+    const auto resolvedWadPath = IO::Disk::resolvePath(wadSearchPaths, wadPath);
+    return IO::Disk::openFileForReading(resolvedWadPath).and_then([](auto file) {
+      return IO::createImageFileSystem<IO::WadFileSystem>(std::move(file));
+    });
+  });
+
+  for (size_t i = 0; i < wadPaths.size(); ++i)
   {
+    const auto& wadPath = wadPaths[i];
     const auto mountPath = rootPath / wadPath.filename();
-    const auto resolvedWadPath = IO::Disk::resolvePath(wadSearchPaths, wadPath);
-    IO::Disk::openFile(resolvedWadPath)
-      .and_then([](auto file) {
-        return IO::createImageFileSystem<IO::WadFileSystem>(std::move(file));
-      })
+    std::move(fileSystems[i])
       .transform(
         [&](auto fs) { m_wadMountPoints.push_back(mount(mountPath, std::move(fs))); })
       .transform_error([&](auto e) {
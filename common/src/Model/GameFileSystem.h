@@ -33,6 +33,7 @@ class Logger;
 
 namespace TrenchBroom::IO
 {
+class CachedDiskFileSystem;
 class Quake3ShaderFileSystem;
 } // namespace TrenchBroom::IO
 
@@ -44,6 +45,7 @@ class GameFileSystem : public IO::VirtualFileSystem
 {
 private:
   IO::Quake3ShaderFileSystem* m_shaderFS = nullptr;
+  std::vector<IO::CachedDiskFileSystem*> m_diskFileSystems;
   std::vector<IO::VirtualMountPointId> m_wadMountPoints;
 
 public:
@@ -52,6 +54,11 @@ public:
     const std::filesystem::path& gamePath,
     const std::vector<std::filesystem::path>& additionalSearchPaths,
     Logger& logger);
+  /**
+   * Discards the cached directory listings of all mounted file system paths so that
+   * changes made on disk become visible.
+   */
+  void refresh();
   Result<void> reloadShaders();
   void reloadWads(
     const std::filesystem::path& rootPath,
@@ -35,12 +35,14 @@
 #include "IO/DiskIO.h"
 #include "IO/DkmParser.h"
 #include "IO/EntParser.h"
+#include "IO/EntityDefinitionCache.h"
 #include "IO/ExportOptions.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/GameConfigParser.h"
 #include "IO/ImageSpriteParser.h"
 #include "IO/LoadTextureCollection.h"
+#include "IO/MapCache.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
 #include "IO/MdlParser.h"
@@ -75,11 +77,45 @@
 #include <vecmath/vec_io.h>
 
 #include <fstream>
+#include <future>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom::Model
 {
+namespace
+{
+/**
+ * Maps with fewer brushes load quickly enough that writing a map cache isn't worth it.
+ */
+constexpr auto MinCachedBrushCount = size_t(10'000);
+
+template <typename CreateParser>
+Result<std::vector<Assets::EntityDefinition*>> loadEntityDefinitions(
+  IO::ParserStatus& status,
+  const std::filesystem::path& path,
+  const Color& defaultColor,
+  const CreateParser& createParser)
+{
+  return IO::Disk::openFile(path).transform([&](auto file) {
+    auto reader = file->reader().buffer();
+    const auto contents = reader.stringView();
+
+    auto& cache = IO::entityDefinitionCache();
+    if (const auto classInfos = cache.get(path, contents))
+    {
+      return IO::createEntityDefinitions(*classInfos, defaultColor);
+    }
+
+    auto parser = createParser(contents);
+    auto classInfos = parser->parseResolvedClassInfos(status);
+    auto definitions = IO::createEntityDefinitions(classInfos, defaultColor);
+    cache.put(path, contents, parser->includedPaths(), std::move(classInfos));
+    return definitions;
+  });
+}
+} // namespace
+
 GameImpl::GameImpl(GameConfig& config, std::filesystem::path gamePath, Logger& logger)
   : m_config{config}
   , m_gamePath{std::move(gamePath)}
@@ -92,6 +128,24 @@ void GameImpl::initializeFileSystem(Logger& logger)
   m_fs.initialize(m_config, m_gamePath, m_additionalSearchPaths, logger);
 }
 
+/**
+ * Waits for the pending map cache write, if any. A failure is reported to the given
+ * logger because the worker thread must not log.
+ */
+void GameImpl::finishPendingMapCacheWrite(Logger& logger) const
+{
+  if (m_pendingMapCacheWrite)
+  {
+    auto pendingMapCacheWrite = std::move(*m_pendingMapCacheWrite);
+    m_pendingMapCacheWrite = std::nullopt;
+
+    pendingMapCacheWrite.result.get().transform_error([&](const auto& e) {
+      logger.warn() << "Could not write map cache " << pendingMapCacheWrite.path << ": "
+                    << e.msg;
+    });
+  }
+}
+
 const std::string& GameImpl::doGameName() const
 {
   return m_config.name;
@@ -216,42 +270,80 @@ Result<std::unique_ptr<WorldNode>> GameImpl::doLoadMap(
   const std::filesystem::path& path,
   Logger& logger) const
 {
+  // the pending write might be for the map that is loaded now
+  finishPendingMapCacheWrite(logger);
+
   auto parserStatus = IO::SimpleParserStatus{logger};
-  return IO::Disk::openFile(path).transform([&](auto file) {
+  return IO::Disk::openFileForReading(path).transform([&](auto file) {
     auto fileReader = file->reader().buffer();
-    if (format == MapFormat::Unknown)
+    const auto mapFileContents = fileReader.stringView();
+
+    const auto cachePath = IO::mapCachePath(path);
+    const auto mapCache = IO::readMapCache(cachePath, mapFileContents, worldBounds);
+    const auto* mapCachePtr = mapCache.is_success() ? &mapCache.value() : nullptr;
+
+    auto world = [&]() {
+      if (format == MapFormat::Unknown)
+      {
+        // Try all formats listed in the game config
+        const auto possibleFormats = kdl::vec_transform(
+          m_config.fileFormats,
+          [](const auto& config) { return Model::formatFromName(config.format); });
+
+        return IO::WorldReader::tryRead(
+          mapFileContents,
+          possibleFormats,
+          worldBounds,
+          entityPropertyConfig(),
+          parserStatus,
+          mapCachePtr);
+      }
+
+      auto worldReader = IO::WorldReader{mapFileContents, format, entityPropertyConfig()};
+      return worldReader.read(worldBounds, parserStatus, mapCachePtr);
+    }();
+
+    if (!mapCachePtr)
     {
-      // Try all formats listed in the game config
-      const auto possibleFormats = kdl::vec_transform(
-        m_config.fileFormats,
-        [](const auto& config) { return Model::formatFromName(config.format); });
-
-      return IO::WorldReader::tryRead(
-        fileReader.stringView(),
-        possibleFormats,
-        worldBounds,
-        entityPropertyConfig(),
-        parserStatus);
+      auto newMapCache = IO::MapCache::create(*world);
+      if (newMapCache.brushGeometries().size() >= MinCachedBrushCount)
+      {
+        // the reader keeps the map file contents alive until the cache is written
+        m_pendingMapCacheWrite = PendingMapCacheWrite{
+          cachePath,
+          std::async(
+            std::launch::async,
+            [cachePath,
+             newMapCache = std::move(newMapCache),
+             fileReader,
+             worldBounds]() {
+              return IO::writeMapCache(
+                cachePath, newMapCache, fileReader.stringView(), worldBounds);
+            })};
+      }
     }
 
-    auto worldReader =
-      IO::WorldReader{fileReader.stringView(), format, entityPropertyConfig()};
-    return worldReader.read(worldBounds, parserStatus);
+    return world;
   });
 }
 
+void GameImpl::doWriteMap(
+  WorldNode& world, std::ostream& stream, const bool exporting) const
+{
+  const auto mapFormatName = formatName(world.mapFormat());
+  stream << "// Game: " << gameName() << "\n"
+         << "// Format: " << mapFormatName << "\n";
+
+  auto writer = IO::NodeWriter{world, stream};
+  writer.setExporting(exporting);
+  writer.writeMap();
+}
+
 Result<void> GameImpl::doWriteMap(
   WorldNode& world, const std::filesystem::path& path, const bool exporting) const
 {
-  return IO::Disk::withOutputStream(path, [&](auto& stream) {
-    const auto mapFormatName = formatName(world.mapFormat());
-    stream << "// Game: " << gameName() << "\n"
-           << "// Format: " << mapFormatName << "\n";
-
-    auto writer = IO::NodeWriter{world, stream};
-    writer.setExporting(exporting);
-    writer.writeMap();
-  });
+  return IO::Disk::withOutputStream(
+    path, [&](auto& stream) { doWriteMap(world, stream, exporting); });
 }
 
 Result<void> GameImpl::doWriteMap(
@@ -260,6 +352,11 @@ Result<void> GameImpl::doWriteMap(
   return doWriteMap(world, path, false);
 }
 
+void GameImpl::doWriteMap(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMap(world, stream, false);
+}
+
 Result<void> GameImpl::doExportMap(
   WorldNode& world, const IO::ExportOptions& options) const
 {
@@ -284,6 +381,11 @@ Result<void> GameImpl::doExportMap(
     options);
 }
 
+void GameImpl::doExportMap(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMap(world, stream, true);
+}
+
 std::vector<Node*> GameImpl::doParseNodes(
   const std::string& str,
   const MapFormat mapFormat,
@@ -354,6 +456,11 @@ Result<void> GameImpl::doReloadShaders()
   return m_fs.reloadShaders();
 }
 
+void GameImpl::doRefreshFileSystem()
+{
+  m_fs.refresh();
+}
+
 bool GameImpl::doIsEntityDefinitionFile(const std::filesystem::path& path) const
 {
   static const auto extensions = {".fgd", ".def", ".ent"};
@@ -371,26 +478,20 @@ Result<std::vector<Assets::EntityDefinition*>> GameImpl::doLoadEntityDefinitions
 
   if (kdl::ci::str_is_equal(".fgd", extension))
   {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::FgdParser{reader.stringView(), defaultColor, path};
-      return parser.parseDefinitions(status);
+    return loadEntityDefinitions(status, path, defaultColor, [&](const auto str) {
+      return std::make_unique<IO::FgdParser>(str, defaultColor, path);
     });
   }
   if (kdl::ci::str_is_equal(".def", extension))
   {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::DefParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
+    return loadEntityDefinitions(status, path, defaultColor, [&](const auto str) {
+      return std::make_unique<IO::DefParser>(str, defaultColor);
     });
   }
   if (kdl::ci::str_is_equal(".ent", extension))
   {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::EntParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
+    return loadEntityDefinitions(status, path, defaultColor, [&](const auto str) {
+      return std::make_unique<IO::EntParser>(str, defaultColor);
     });
   }
 
@@ -532,9 +633,9 @@ std::unique_ptr<Assets::EntityModel> GameImpl::doInitializeModel(
   }
 }
 
-void GameImpl::doLoadFrame(
+void GameImpl::doLoadFrames(
   const std::filesystem::path& path,
-  size_t frameIndex,
+  const std::vector<size_t>& frameIndices,
   Assets::EntityModel& model,
   Logger& logger) const
 {
@@ -542,8 +643,11 @@ void GameImpl::doLoadFrame(
 
   try
   {
-    ensure(model.frame(frameIndex) != nullptr, "invalid frame index");
-    ensure(!model.frame(frameIndex)->loaded(), "frame already loaded");
+    for (const auto frameIndex : frameIndices)
+    {
+      ensure(model.frame(frameIndex) != nullptr, "invalid frame index");
+      ensure(!model.frame(frameIndex)->loaded(), "frame already loaded");
+    }
 
     m_fs.openFile(path)
       .and_then([&](auto file) -> result_type {
@@ -554,64 +658,64 @@ void GameImpl::doLoadFrame(
         {
           return loadTexturePalette().transform([&](auto palette) {
             auto parser = IO::MdlParser{modelName, reader, palette};
-            parser.loadFrame(frameIndex, model, logger);
+            parser.loadFrames(frameIndices, model, logger);
           });
         }
         if (IO::Md2Parser::canParse(path, reader))
         {
           return loadTexturePalette().transform([&](auto palette) {
             auto parser = IO::Md2Parser{modelName, reader, palette, m_fs};
-            parser.loadFrame(frameIndex, model, logger);
+            parser.loadFrames(frameIndices, model, logger);
           });
         }
         if (IO::Bsp29Parser::canParse(path, reader))
         {
           return loadTexturePalette().transform([&](auto palette) {
             auto parser = IO::Bsp29Parser{modelName, reader, palette, m_fs};
-            parser.loadFrame(frameIndex, model, logger);
+            parser.loadFrames(frameIndices, model, logger);
           });
         }
         if (IO::SprParser::canParse(path, reader))
         {
           return loadTexturePalette().transform([&](auto palette) {
             auto parser = IO::SprParser{modelName, reader, palette};
-            parser.loadFrame(frameIndex, model, logger);
+            parser.loadFrames(frameIndices, model, logger);
           });
         }
         if (IO::Md3Parser::canParse(path, reader))
         {
           auto parser = IO::Md3Parser{modelName, reader, m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         if (IO::MdxParser::canParse(path, reader))
         {
           auto parser = IO::MdxParser{modelName, reader, m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         if (IO::DkmParser::canParse(path, reader))
         {
           auto parser = IO::DkmParser{modelName, reader, m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         if (IO::AseParser::canParse(path))
         {
           auto parser = IO::AseParser{modelName, reader.stringView(), m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         if (IO::ImageSpriteParser::canParse(path))
         {
           auto parser = IO::ImageSpriteParser{modelName, file, m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         if (IO::AssimpParser::canParse(path))
         {
           auto parser = IO::AssimpParser{path, m_fs};
-          parser.loadFrame(frameIndex, model, logger);
+          parser.loadFrames(frameIndices, model, logger);
           return kdl::void_success;
         }
         return Error{"Unknown model format: '" + path.string() + "'"};
@@ -19,12 +19,17 @@
 
 #pragma once
 
+#include "Error.h"
 #include "FloatType.h"
 #include "Model/Game.h"
 #include "Model/GameFileSystem.h"
 #include "Result.h"
 
+#include <kdl/result.h>
+
 #include <filesystem>
+#include <future>
+#include <iosfwd>
 #include <memory>
 #include <optional>
 #include <string>
@@ -52,11 +57,23 @@ private:
   std::filesystem::path m_gamePath;
   std::vector<std::filesystem::path> m_additionalSearchPaths;
 
+  /**
+   * A map cache that is being written on a worker thread after its map was loaded, so
+   * that the document can be shown without waiting for the file to be written.
+   */
+  struct PendingMapCacheWrite
+  {
+    std::filesystem::path path;
+    std::future<Result<void>> result;
+  };
+  mutable std::optional<PendingMapCacheWrite> m_pendingMapCacheWrite;
+
 public:
   GameImpl(GameConfig& config, std::filesystem::path gamePath, Logger& logger);
 
 private:
   void initializeFileSystem(Logger& logger);
+  void finishPendingMapCacheWrite(Logger& logger) const;
 
 private:
   const std::string& doGameName() const override;
@@ -83,12 +100,15 @@ private:
     const vm::bbox3& worldBounds,
     const std::filesystem::path& path,
     Logger& logger) const override;
+  void doWriteMap(WorldNode& world, std::ostream& stream, bool exporting) const;
   Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path, bool exporting) const;
   Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path) const override;
+  void doWriteMap(WorldNode& world, std::ostream& stream) const override;
   Result<void> doExportMap(
     WorldNode& world, const IO::ExportOptions& options) const override;
+  void doExportMap(WorldNode& world, std::ostream& stream) const override;
 
   std::vector<Node*> doParseNodes(
     const std::string& str,
@@ -119,6 +139,7 @@ private:
     const std::vector<std::filesystem::path>& wadPaths,
     Logger& logger) override;
   Result<void> doReloadShaders() override;
+  void doRefreshFileSystem() override;
 
   bool doIsEntityDefinitionFile(const std::filesystem::path& path) const override;
   Result<std::vector<Assets::EntityDefinition*>> doLoadEntityDefinitions(
@@ -134,9 +155,9 @@ private:
 
   std::unique_ptr<Assets::EntityModel> doInitializeModel(
     const std::filesystem::path& path, Logger& logger) const override;
-  void doLoadFrame(
+  void doLoadFrames(
     const std::filesystem::path& path,
-    size_t frameIndex,
+    const std::vector<size_t>& frameIndices,
     Assets::EntityModel& model,
     Logger& logger) const override;
 
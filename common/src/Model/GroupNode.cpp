@@ -23,6 +23,7 @@
 #include "Error.h"
 #include "FloatType.h"
 #include "Model/Brush.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
@@ -32,6 +33,7 @@
 #include "Model/PatchNode.h"
 #include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
+#include "Model/TexCoordSystem.h"
 #include "Model/Validator.h"
 #include "Model/WorldNode.h"
 
@@ -44,7 +46,9 @@
 
 #include <vecmath/ray.h>
 
+#include <algorithm>
 #include <functional>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -131,14 +135,17 @@ static Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
 
 /**
  * Given a node, clones its children recursively and applies the given transform.
+ * `nodesToClone` must contain the nodes returned by collectNodesToCloneAndTransform for
+ * `node`.
  *
  * Returns a vector of the cloned direct children of `node`.
  */
 static Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
-  const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
+  const Node& node,
+  const std::vector<const Node*>& nodesToClone,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
 {
-  auto nodesToClone = collectNodesToCloneAndTransform(node);
-
   using TransformResult = Result<std::pair<const Node*, NodeContents>>;
 
   // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
@@ -236,24 +243,15 @@ static void preserveGroupNames(
 }
 
 static void preserveEntityProperties(
-  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+  Entity& clonedEntity,
+  const Entity& correspondingEntity,
+  const EntityPropertyConfig& entityPropertyConfig)
 {
-  if (
-    clonedEntityNode.entity().protectedProperties().empty()
-    && correspondingEntityNode.entity().protectedProperties().empty())
-  {
-    return;
-  }
-
-  auto clonedEntity = clonedEntityNode.entity();
-  const auto& correspondingEntity = correspondingEntityNode.entity();
-
   const auto allProtectedProperties = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
     clonedEntity.protectedProperties(), correspondingEntity.protectedProperties()));
 
   clonedEntity.setProtectedProperties(correspondingEntity.protectedProperties());
 
-  const auto entityPropertyConfig = clonedEntityNode.entityPropertyConfig();
   for (const auto& propertyKey : allProtectedProperties)
   {
     // this can change the order of properties
@@ -263,7 +261,23 @@ static void preserveEntityProperties(
       clonedEntity.addOrUpdateProperty(entityPropertyConfig, propertyKey, *propertyValue);
     }
   }
+}
+
+static void preserveEntityProperties(
+  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+{
+  if (
+    clonedEntityNode.entity().protectedProperties().empty()
+    && correspondingEntityNode.entity().protectedProperties().empty())
+  {
+    return;
+  }
 
+  auto clonedEntity = clonedEntityNode.entity();
+  preserveEntityProperties(
+    clonedEntity,
+    correspondingEntityNode.entity(),
+    clonedEntityNode.entityPropertyConfig());
   clonedEntityNode.setEntity(std::move(clonedEntity));
 }
 
@@ -323,11 +337,16 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const auto _invertedSourceTransformation = invertedSourceTransformation;
   const auto targetGroupNodesToUpdate =
     kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
-  return kdl::fold_results(
-    kdl::vec_transform(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
+  const auto nodesToClone = collectNodesToCloneAndTransform(sourceGroupNode);
+
+  // The target groups are independent of each other, so they are updated in parallel.
+  // Each target only reads the source nodes and its own children.
+  return kdl::fold_results(kdl::vec_parallel_transform(
+    targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
       const auto transformation =
         targetGroupNode->group().transformation() * _invertedSourceTransformation;
-      return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
+      return cloneAndTransformChildren(
+               sourceGroupNode, nodesToClone, worldBounds, transformation)
         .transform([&](std::vector<std::unique_ptr<Node>>&& newChildren) {
           preserveGroupNames(newChildren, targetGroupNode->children());
           preserveEntityProperties(newChildren, targetGroupNode->children());
@@ -338,6 +357,221 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
     }));
 }
 
+static bool haveSameNodeType(const Node& lhs, const Node& rhs)
+{
+  return lhs.accept(kdl::overload(
+    [&](const WorldNode*) { return dynamic_cast<const WorldNode*>(&rhs) != nullptr; },
+    [&](const LayerNode*) { return dynamic_cast<const LayerNode*>(&rhs) != nullptr; },
+    [&](const GroupNode*) { return dynamic_cast<const GroupNode*>(&rhs) != nullptr; },
+    [&](const EntityNode*) { return dynamic_cast<const EntityNode*>(&rhs) != nullptr; },
+    [&](const BrushNode*) { return dynamic_cast<const BrushNode*>(&rhs) != nullptr; },
+    [&](const PatchNode*) { return dynamic_cast<const PatchNode*>(&rhs) != nullptr; }));
+}
+
+/**
+ * Checks whether the given nodes have the same number of children, and whether their
+ * children have the same types and (recursively) the same structure.
+ */
+static bool haveSameStructure(const Node& lhs, const Node& rhs)
+{
+  return std::equal(
+    std::begin(lhs.children()),
+    std::end(lhs.children()),
+    std::begin(rhs.children()),
+    std::end(rhs.children()),
+    [](const auto* lhsChild, const auto* rhsChild) {
+      return haveSameNodeType(*lhsChild, *rhsChild)
+             && haveSameStructure(*lhsChild, *rhsChild);
+    });
+}
+
+/**
+ * Brush face equality does not consider the texture coordinate systems, but they must be
+ * propagated to linked brushes, too.
+ */
+static bool haveSameTexCoordSystems(const Brush& lhs, const Brush& rhs)
+{
+  return std::equal(
+    std::begin(lhs.faces()),
+    std::end(lhs.faces()),
+    std::begin(rhs.faces()),
+    std::end(rhs.faces()),
+    [](const auto& lhsFace, const auto& rhsFace) {
+      return lhsFace.texCoordSystem() == rhsFace.texCoordSystem();
+    });
+}
+
+/**
+ * Transforms the contents of the given source node into a linked group and compares them
+ * to the contents of the given corresponding target node.
+ *
+ * Returns the new contents of the target node, or an empty optional if the contents of
+ * the target node would not change.
+ */
+static Result<std::optional<NodeContents>> transformLinkedNodeContents(
+  const Node& sourceNode,
+  const Node& targetNode,
+  const vm::mat4x4& transformation,
+  const vm::bbox3& worldBounds)
+{
+  using TransformResult = Result<std::optional<NodeContents>>;
+
+  return sourceNode.accept(kdl::overload(
+    [](const WorldNode*) -> TransformResult {
+      ensure(false, "Linked group structure is valid");
+    },
+    [](const LayerNode*) -> TransformResult {
+      ensure(false, "Linked group structure is valid");
+    },
+    [&](const GroupNode* sourceGroupNode) -> TransformResult {
+      const auto& targetGroup = static_cast<const GroupNode&>(targetNode).group();
+
+      auto group = sourceGroupNode->group();
+      group.transform(transformation);
+      group.setName(targetGroup.name());
+
+      if (group == targetGroup)
+      {
+        return std::optional<NodeContents>{};
+      }
+      return std::optional{NodeContents{std::move(group)}};
+    },
+    [&](const EntityNode* sourceEntityNode) -> TransformResult {
+      const auto& targetEntityNode = static_cast<const EntityNode&>(targetNode);
+      const auto& targetEntity = targetEntityNode.entity();
+
+      auto entity = sourceEntityNode->entity();
+      entity.transform(sourceEntityNode->entityPropertyConfig(), transformation);
+      if (
+        !entity.protectedProperties().empty()
+        || !targetEntity.protectedProperties().empty())
+      {
+        preserveEntityProperties(
+          entity, targetEntity, targetEntityNode.entityPropertyConfig());
+      }
+
+      if (entity == targetEntity)
+      {
+        return std::optional<NodeContents>{};
+      }
+      if (!worldBounds.contains(EntityNode{entity}.logicalBounds()))
+      {
+        return Error{"Updating a linked node would exceed world bounds"};
+      }
+      return std::optional{NodeContents{std::move(entity)}};
+    },
+    [&](const BrushNode* sourceBrushNode) -> TransformResult {
+      const auto& targetBrush = static_cast<const BrushNode&>(targetNode).brush();
+
+      auto brush = sourceBrushNode->brush();
+      return brush.transform(worldBounds, transformation, true)
+        .or_else([](const auto&) -> Result<void> {
+          return Error{"Failed to transform a linked node"};
+        })
+        .and_then([&]() -> TransformResult {
+          if (brush == targetBrush && haveSameTexCoordSystems(brush, targetBrush))
+          {
+            return std::optional<NodeContents>{};
+          }
+          if (!worldBounds.contains(brush.bounds()))
+          {
+            return Error{"Updating a linked node would exceed world bounds"};
+          }
+          return std::optional{NodeContents{std::move(brush)}};
+        });
+    },
+    [&](const PatchNode* sourcePatchNode) -> TransformResult {
+      const auto& targetPatch = static_cast<const PatchNode&>(targetNode).patch();
+
+      auto patch = sourcePatchNode->patch();
+      patch.transform(transformation);
+
+      if (patch == targetPatch)
+      {
+        return std::optional<NodeContents>{};
+      }
+      if (!worldBounds.contains(patch.bounds()))
+      {
+        return Error{"Updating a linked node would exceed world bounds"};
+      }
+      return std::optional{NodeContents{std::move(patch)}};
+    }));
+}
+
+Result<UpdateLinkedGroupContentsResult> updateLinkedGroupContents(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Model::GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds)
+{
+  using ContentsToSwap = std::vector<std::pair<Node*, NodeContents>>;
+  using TargetUpdate = std::pair<GroupNode*, std::optional<ContentsToSwap>>;
+
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto [success, invertedSourceTransformation] =
+    vm::invert(sourceGroup.transformation());
+  if (!success)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  const auto _invertedSourceTransformation = invertedSourceTransformation;
+  const auto targetGroupNodesToUpdate =
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  const auto sourceNodes = collectNodesToCloneAndTransform(sourceGroupNode);
+
+  const auto updateTargetGroupNode = [&](auto* targetGroupNode) -> Result<TargetUpdate> {
+    if (!haveSameStructure(sourceGroupNode, *targetGroupNode))
+    {
+      return TargetUpdate{targetGroupNode, std::nullopt};
+    }
+
+    // both trees have the same structure, so their nodes correspond to each other by
+    // their position in the pre-order traversal
+    const auto targetNodes = collectDescendants({targetGroupNode});
+    const auto transformation =
+      targetGroupNode->group().transformation() * _invertedSourceTransformation;
+
+    auto transformResults = std::vector<Result<std::optional<NodeContents>>>{};
+    transformResults.reserve(sourceNodes.size());
+    for (size_t i = 0; i < sourceNodes.size(); ++i)
+    {
+      transformResults.push_back(transformLinkedNodeContents(
+        *sourceNodes[i], *targetNodes[i], transformation, worldBounds));
+    }
+
+    return kdl::fold_results(std::move(transformResults))
+      .transform([&](auto newContents) {
+        auto contentsToSwap = ContentsToSwap{};
+        for (size_t i = 0; i < newContents.size(); ++i)
+        {
+          if (newContents[i])
+          {
+            contentsToSwap.emplace_back(targetNodes[i], std::move(*newContents[i]));
+          }
+        }
+        return TargetUpdate{targetGroupNode, std::move(contentsToSwap)};
+      });
+  };
+
+  return kdl::fold_results(
+           kdl::vec_parallel_transform(targetGroupNodesToUpdate, updateTargetGroupNode))
+    .transform([](auto targetUpdates) {
+      auto result = UpdateLinkedGroupContentsResult{};
+      for (auto& [targetGroupNode, contentsToSwap] : targetUpdates)
+      {
+        if (!contentsToSwap)
+        {
+          result.groupNodesToReplace.push_back(targetGroupNode);
+        }
+        else if (!contentsToSwap->empty())
+        {
+          result.contentsToSwap.emplace_back(targetGroupNode, std::move(*contentsToSwap));
+        }
+      }
+      return result;
+    });
+}
+
 GroupNode::GroupNode(Group group)
   : m_group{std::move(group)}
   , m_editState{EditState::Closed}
@@ -24,6 +24,7 @@
 #include "Model/Group.h"
 #include "Model/IdType.h"
 #include "Model/Node.h"
+#include "Model/NodeContents.h"
 #include "Model/Object.h"
 #include "Result.h"
 
@@ -72,6 +73,44 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const std::vector<Model::GroupNode*>& targetGroupNodes,
   const vm::bbox3& worldBounds);
 
+struct UpdateLinkedGroupContentsResult
+{
+  /**
+   * For each target group node with at least one changed descendant, the descendants
+   * whose contents should be swapped and their new contents.
+   */
+  std::vector<std::pair<Node*, std::vector<std::pair<Node*, NodeContents>>>>
+    contentsToSwap;
+
+  /**
+   * The target group nodes whose structure differs from that of the source group node.
+   * These must be updated by replacing their children using `updateLinkedGroups`.
+   */
+  std::vector<GroupNode*> groupNodesToReplace;
+};
+
+/**
+ * Computes the changes that are necessary to update the given target group nodes from
+ * the given source group node without replacing their children.
+ *
+ * Nodes in linked groups correspond to each other by their position in the node tree. If
+ * a target group node has the same structure as the source group node, then each
+ * descendant of the source node is transformed into the target group and its contents
+ * are compared to those of the corresponding target node. Only the target nodes whose
+ * contents differ are returned, so the cost of applying and undoing the update is
+ * proportional to the number of changed nodes rather than to the size of the groups.
+ *
+ * Target group nodes whose structure differs from the source group node are returned
+ * separately and must be updated by calling `updateLinkedGroups`.
+ *
+ * Group names and protected entity properties are preserved in the same way as by
+ * `updateLinkedGroups`, and this operation fails under the same conditions.
+ */
+Result<UpdateLinkedGroupContentsResult> updateLinkedGroupContents(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Model::GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds);
+
 /**
  * A group of nodes that can be edited as one.
  *
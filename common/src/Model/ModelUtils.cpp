@@ -28,6 +28,7 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeContents.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 #include "Polyhedron.h"
@@ -35,6 +36,7 @@
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom
@@ -430,6 +432,33 @@ static std::vector<Node*> collectMatchingNodes(
   return result;
 }
 
+NodeCollection collectNodesByType(const std::vector<Node*>& nodes)
+{
+  auto result = NodeCollection{};
+
+  for (auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+      [&](auto&& thisLambda, LayerNode* layer) {
+        result.addNode(layer);
+        layer->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, GroupNode* group) {
+        result.addNode(group);
+        group->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, EntityNode* entity) {
+        result.addNode(entity);
+        entity->visitChildren(thisLambda);
+      },
+      [&](BrushNode* brush) { result.addNode(brush); },
+      [&](PatchNode* patch) { result.addNode(patch); }));
+  }
+
+  return result;
+}
+
 std::vector<Node*> collectTouchingNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
 {
@@ -532,48 +561,36 @@ std::vector<Node*> collectSelectableNodes(
 
 std::vector<BrushFaceHandle> collectBrushFaces(const std::vector<Node*>& nodes)
 {
+  const auto nodesByType = collectNodesByType(nodes);
+
   auto faces = std::vector<BrushFaceHandle>{};
-  for (auto* node : nodes)
+  for (auto* brushNode : nodesByType.brushes())
   {
-    node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
-      [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
-      [](auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
-      [&](BrushNode* brushNode) {
-        const auto& brush = brushNode->brush();
-        for (size_t i = 0; i < brush.faceCount(); ++i)
-        {
-          faces.emplace_back(brushNode, i);
-        }
-      },
-      [](PatchNode*) {}));
+    const auto& brush = brushNode->brush();
+    for (size_t i = 0; i < brush.faceCount(); ++i)
+    {
+      faces.emplace_back(brushNode, i);
+    }
   }
   return faces;
 }
 
 std::vector<BrushFaceHandle> collectSelectedBrushFaces(const std::vector<Node*>& nodes)
 {
+  const auto nodesByType = collectNodesByType(nodes);
+
   auto faces = std::vector<BrushFaceHandle>{};
-  for (auto* node : nodes)
+  for (auto* brushNode : nodesByType.brushes())
   {
-    node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
-      [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
-      [](auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
-      [&](BrushNode* brushNode) {
-        const auto& brush = brushNode->brush();
-        for (size_t i = 0; i < brush.faceCount(); ++i)
-        {
-          const auto& face = brush.face(i);
-          if (face.selected())
-          {
-            faces.emplace_back(brushNode, i);
-          }
-        }
-      },
-      [](PatchNode*) {}));
+    const auto& brush = brushNode->brush();
+    for (size_t i = 0; i < brush.faceCount(); ++i)
+    {
+      const auto& face = brush.face(i);
+      if (face.selected())
+      {
+        faces.emplace_back(brushNode, i);
+      }
+    }
   }
   return faces;
 }
@@ -581,26 +598,20 @@ std::vector<BrushFaceHandle> collectSelectedBrushFaces(const std::vector<Node*>&
 std::vector<BrushFaceHandle> collectSelectableBrushFaces(
   const std::vector<Node*>& nodes, const EditorContext& editorContext)
 {
+  const auto nodesByType = collectNodesByType(nodes);
+
   auto faces = std::vector<BrushFaceHandle>{};
-  for (auto* node : nodes)
+  for (auto* brushNode : nodesByType.brushes())
   {
-    node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
-      [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
-      [](auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
-      [&](BrushNode* brushNode) {
-        const auto& brush = brushNode->brush();
-        for (size_t i = 0; i < brush.faceCount(); ++i)
-        {
-          const auto& face = brush.face(i);
-          if (editorContext.selectable(brushNode, face))
-          {
-            faces.emplace_back(brushNode, i);
-          }
-        }
-      },
-      [](PatchNode*) {}));
+    const auto& brush = brushNode->brush();
+    for (size_t i = 0; i < brush.faceCount(); ++i)
+    {
+      const auto& face = brush.face(i);
+      if (editorContext.selectable(brushNode, face))
+      {
+        faces.emplace_back(brushNode, i);
+      }
+    }
   }
   return faces;
 }
@@ -686,6 +697,67 @@ static void getContainingLinkedGroups(
   }
 }
 
+static size_t estimateMemorySize(const Entity& entity)
+{
+  auto result = sizeof(Entity);
+  for (const auto& property : entity.properties())
+  {
+    result +=
+      sizeof(EntityProperty) + property.key().capacity() + property.value().capacity();
+  }
+  return result;
+}
+
+static size_t estimateMemorySize(const Brush& brush)
+{
+  // the geometry may be shared with other copies of the brush, but it is counted anyway
+  return sizeof(Brush)
+         + brush.faceCount() * (sizeof(BrushFace) + sizeof(BrushFaceGeometry))
+         + brush.vertexCount() * sizeof(BrushVertex)
+         + brush.edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge));
+}
+
+static size_t estimateMemorySize(const BezierPatch& patch)
+{
+  return sizeof(BezierPatch) + patch.controlPoints().size() * sizeof(BezierPatch::Point);
+}
+
+size_t estimateMemorySize(const NodeContents& contents)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Layer&) { return sizeof(Layer); },
+      [](const Group&) { return sizeof(Group); },
+      [](const Entity& entity) { return estimateMemorySize(entity); },
+      [](const Brush& brush) { return estimateMemorySize(brush); },
+      [](const BezierPatch& patch) { return estimateMemorySize(patch); }),
+    contents.get());
+}
+
+size_t estimateMemorySize(const std::vector<Node*>& nodes)
+{
+  auto result = size_t(0);
+  for (const auto* node : collectNodes(nodes))
+  {
+    result += node->accept(kdl::overload(
+      [](const WorldNode* worldNode) {
+        return sizeof(WorldNode) + estimateMemorySize(worldNode->entity());
+      },
+      [](const LayerNode*) { return sizeof(LayerNode); },
+      [](const GroupNode*) { return sizeof(GroupNode); },
+      [](const EntityNode* entityNode) {
+        return sizeof(EntityNode) + estimateMemorySize(entityNode->entity());
+      },
+      [](const BrushNode* brushNode) {
+        return sizeof(BrushNode) + estimateMemorySize(brushNode->brush());
+      },
+      [](const PatchNode* patchNode) {
+        return sizeof(PatchNode) + estimateMemorySize(patchNode->patch());
+      }));
+  }
+  return result;
+}
+
 SelectionResult nodeSelectionWithLinkedGroupConstraints(
   Model::WorldNode& world, const std::vector<Model::Node*>& nodes)
 {
@@ -23,6 +23,7 @@
 #include "Model/BrushFaceHandle.h"
 #include "Model/HitType.h"
 #include "Model/Node.h"
+#include "Model/NodeCollection.h"
 
 #include <vecmath/bbox.h>
 
@@ -38,6 +39,7 @@ class BrushFaceHandle;
 class EditorContext;
 class LayerNode;
 class Node;
+class NodeContents;
 
 HitType::Type nodeHitType();
 
@@ -82,6 +84,15 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
 
 std::vector<Node*> collectNodes(const std::vector<Node*>& nodes);
 
+/**
+ * Collects the given nodes and their descendants in a single traversal and partitions
+ * them by type. World nodes are traversed, but not collected. The nodes of each type
+ * are stored contiguously in the order in which they were visited, so callers that only
+ * care about one type of node can iterate over it in a tight loop without dispatching
+ * on the type of each node again.
+ */
+NodeCollection collectNodesByType(const std::vector<Node*>& nodes);
+
 std::vector<Node*> collectTouchingNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 std::vector<Node*> collectContainedNodes(
@@ -105,6 +116,17 @@ vm::bbox3 computePhysicalBounds(
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
 std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
+/**
+ * Estimates the number of bytes of memory used by the given node contents. The estimate
+ * is meant to limit the memory used by the undo history, so it need not be exact.
+ */
+size_t estimateMemorySize(const NodeContents& contents);
+
+/**
+ * Estimates the number of bytes of memory used by the given nodes and their descendants.
+ */
+size_t estimateMemorySize(const std::vector<Node*>& nodes);
+
 struct SelectionResult
 {
   std::vector<Model::Node*> nodesToSelect;
@@ -21,12 +21,16 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/BrushNode.h"
 #include "Model/EntityProperties.h"
 #include "Model/Issue.h"
 #include "Model/LockState.h"
+#include "Model/MapFormat.h"
 #include "Model/Validator.h"
 #include "Model/VisibilityState.h"
 
+#include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/reflection_impl.h>
 #include <kdl/vector_utils.h>
 
@@ -507,6 +511,7 @@ void Node::nodeDidChange()
   {
     m_parent->childDidChange(this);
   }
+  invalidateSerializedText();
   invalidateIssues();
 }
 
@@ -850,6 +855,22 @@ bool Node::containsLine(const size_t lineNumber) const
   return lineNumber >= m_lineNumber && lineNumber < m_lineNumber + m_lineCount;
 }
 
+const SerializedText* Node::serializedText(const MapFormat format) const
+{
+  return m_serializedText && m_serializedText->format == format ? &*m_serializedText
+                                                                : nullptr;
+}
+
+void Node::setSerializedText(SerializedText serializedText) const
+{
+  m_serializedText = std::move(serializedText);
+}
+
+void Node::invalidateSerializedText() const
+{
+  m_serializedText = std::nullopt;
+}
+
 std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& validators)
 {
   validateIssues(validators);
@@ -857,6 +878,55 @@ std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& vali
     m_issues, [](const auto& issue) { return const_cast<const Issue*>(issue.get()); });
 }
 
+void Node::validateIssues(
+  const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators)
+{
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (auto* node : nodes)
+  {
+    if (!node->m_issuesValid)
+    {
+      node->accept(kdl::overload(
+        [&](WorldNode*) { node->validateIssues(validators); },
+        [&](LayerNode*) { node->validateIssues(validators); },
+        [&](GroupNode*) { node->validateIssues(validators); },
+        [&](EntityNode*) { node->validateIssues(validators); },
+        [&](BrushNode* brushNode) { brushNodes.push_back(brushNode); },
+        [&](PatchNode*) { node->validateIssues(validators); }));
+    }
+  }
+
+  constexpr auto BatchSize = size_t(256);
+  const auto batchCount = (brushNodes.size() + BatchSize - 1) / BatchSize;
+
+  kdl::parallel_for(
+    batchCount,
+    [&](const size_t batchIndex) {
+      const auto first = batchIndex * BatchSize;
+      const auto last = std::min(first + BatchSize, brushNodes.size());
+
+      auto batch = std::vector<BrushNode*>{};
+      batch.reserve(last - first);
+      for (auto i = first; i < last; ++i)
+      {
+        batch.push_back(brushNodes[i]);
+      }
+
+      auto issues = std::vector<std::vector<std::unique_ptr<Issue>>>(batch.size());
+      for (const auto* validator : validators)
+      {
+        validator->validate(batch, issues);
+      }
+
+      for (size_t i = 0; i < batch.size(); ++i)
+      {
+        batch[i]->m_issues = std::move(issues[i]);
+        batch[i]->m_issuesValid = true;
+      }
+    },
+    1);
+}
+
 bool Node::issueHidden(const IssueType type) const
 {
   return (type & m_hiddenIssues) != 0;
@@ -31,6 +31,7 @@
 #include <vecmath/util.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -44,6 +45,7 @@ struct EntityPropertyConfig;
 class ConstNodeVisitor;
 class Issue;
 enum class LockState;
+enum class MapFormat;
 class NodeVisitor;
 class PickResult;
 class Validator;
@@ -56,6 +58,16 @@ struct NodePath
   kdl_reflect_decl(NodePath, indices);
 };
 
+/**
+ * The text that a node was serialized to when it was last written in a map format.
+ */
+struct SerializedText
+{
+  MapFormat format;
+  std::string text;
+  size_t lineCount;
+};
+
 class Node : public Taggable
 {
 private:
@@ -74,6 +86,8 @@ private:
   mutable size_t m_lineNumber;
   mutable size_t m_lineCount;
 
+  mutable std::optional<SerializedText> m_serializedText;
+
   mutable std::vector<std::unique_ptr<Issue>> m_issues;
   mutable bool m_issuesValid;
   IssueType m_hiddenIssues;
@@ -372,9 +386,26 @@ public: // file position
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
+public: // serialization cache
+  /**
+   * Returns the text that this node was last serialized to in the given map format, or
+   * nullptr if this node has changed since then or was last serialized in another format.
+   */
+  const SerializedText* serializedText(MapFormat format) const;
+  void setSerializedText(SerializedText serializedText) const;
+  void invalidateSerializedText() const;
+
 public: // issue management
   std::vector<const Issue*> issues(const std::vector<const Validator*>& validators);
 
+  /**
+   * Validates the issues of all given nodes whose issues are not valid. Brush nodes are
+   * split into batches that are validated in parallel, the remaining nodes are validated
+   * one at a time.
+   */
+  static void validateIssues(
+    const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators);
+
   bool issueHidden(IssueType type) const;
   void setIssueHidden(IssueType type, bool hidden);
 
@@ -32,6 +32,7 @@
 #include <kdl/reflection_impl.h>
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -196,104 +197,85 @@ void NodeCollection::addNode(Node* node)
   ensure(node != nullptr, "node is null");
   node->accept(kdl::overload(
     [](WorldNode*) {},
-    [&](LayerNode* layer) {
-      m_nodes.push_back(layer);
-      m_layers.push_back(layer);
-    },
-    [&](GroupNode* group) {
-      m_nodes.push_back(group);
-      m_groups.push_back(group);
-    },
-    [&](EntityNode* entity) {
-      m_nodes.push_back(entity);
-      m_entities.push_back(entity);
-    },
-    [&](BrushNode* brush) {
-      m_nodes.push_back(brush);
-      m_brushes.push_back(brush);
-    },
-    [&](PatchNode* patch) {
-      m_nodes.push_back(patch);
-      m_patches.push_back(patch);
-    }));
-}
-
-static const auto doRemoveNodes = [](
-                                    auto& nodes,
-                                    auto& layers,
-                                    auto& groups,
-                                    auto& entities,
-                                    auto& brushes,
-                                    auto& patches,
-                                    auto cur,
-                                    auto end) {
-  auto nodeEnd = std::end(nodes);
-  auto layerEnd = std::end(layers);
-  auto groupEnd = std::end(groups);
-  auto entityEnd = std::end(entities);
-  auto brushEnd = std::end(brushes);
-  auto patchEnd = std::end(patches);
-
-  while (cur != end)
-  {
-    (*cur)->accept(kdl::overload(
-      [](WorldNode*) {},
-      [&](LayerNode* layer) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, layer);
-        layerEnd = std::remove(std::begin(layers), layerEnd, layer);
-      },
-      [&](GroupNode* group) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, group);
-        groupEnd = std::remove(std::begin(groups), groupEnd, group);
-      },
-      [&](EntityNode* entity) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, entity);
-        entityEnd = std::remove(std::begin(entities), entityEnd, entity);
-      },
-      [&](BrushNode* brush) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, brush);
-        brushEnd = std::remove(std::begin(brushes), brushEnd, brush);
-      },
-      [&](PatchNode* patch) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, patch);
-        patchEnd = std::remove(std::begin(patches), patchEnd, patch);
-      }));
-    ++cur;
-  }
+    [&](LayerNode* layer) { addNode(layer); },
+    [&](GroupNode* group) { addNode(group); },
+    [&](EntityNode* entity) { addNode(entity); },
+    [&](BrushNode* brush) { addNode(brush); },
+    [&](PatchNode* patch) { addNode(patch); }));
+}
 
-  nodes.erase(nodeEnd, std::end(nodes));
-  layers.erase(layerEnd, std::end(layers));
-  groups.erase(groupEnd, std::end(groups));
-  entities.erase(entityEnd, std::end(entities));
-  brushes.erase(brushEnd, std::end(brushes));
-  patches.erase(patchEnd, std::end(patches));
-};
+void NodeCollection::addNode(LayerNode* layer)
+{
+  ensure(layer != nullptr, "layer is null");
+  m_nodes.push_back(layer);
+  m_layers.push_back(layer);
+}
+
+void NodeCollection::addNode(GroupNode* group)
+{
+  ensure(group != nullptr, "group is null");
+  m_nodes.push_back(group);
+  m_groups.push_back(group);
+}
+
+void NodeCollection::addNode(EntityNode* entity)
+{
+  ensure(entity != nullptr, "entity is null");
+  m_nodes.push_back(entity);
+  m_entities.push_back(entity);
+}
+
+void NodeCollection::addNode(BrushNode* brush)
+{
+  ensure(brush != nullptr, "brush is null");
+  m_nodes.push_back(brush);
+  m_brushes.push_back(brush);
+}
+
+void NodeCollection::addNode(PatchNode* patch)
+{
+  ensure(patch != nullptr, "patch is null");
+  m_nodes.push_back(patch);
+  m_patches.push_back(patch);
+}
+
+namespace
+{
+template <typename T, typename P>
+void eraseNodesIf(std::vector<T*>& nodes, const P& predicate)
+{
+  nodes.erase(std::remove_if(nodes.begin(), nodes.end(), predicate), nodes.end());
+}
+} // namespace
 
 void NodeCollection::removeNodes(const std::vector<Node*>& nodes)
 {
-  doRemoveNodes(
-    m_nodes,
-    m_layers,
-    m_groups,
-    m_entities,
-    m_brushes,
-    m_patches,
-    std::begin(nodes),
-    std::end(nodes));
+  // use a hash set so that the cost is linear in the size of this collection instead of
+  // proportional to the product of both sizes
+  const auto nodesToRemove = std::unordered_set<const Node*>{nodes.begin(), nodes.end()};
+  const auto isRemoved = [&](const Node* node) { return nodesToRemove.count(node) > 0u; };
+
+  eraseNodesIf(m_nodes, isRemoved);
+  eraseNodesIf(m_layers, isRemoved);
+  eraseNodesIf(m_groups, isRemoved);
+  eraseNodesIf(m_entities, isRemoved);
+  eraseNodesIf(m_brushes, isRemoved);
+  eraseNodesIf(m_patches, isRemoved);
 }
 
 void NodeCollection::removeNode(Node* node)
 {
   ensure(node != nullptr, "node is null");
-  doRemoveNodes(
-    m_nodes,
-    m_layers,
-    m_groups,
-    m_entities,
-    m_brushes,
-    m_patches,
-    &node,
-    std::next(&node));
+  const auto isRemoved = [&](const Node* other) { return other == node; };
+
+  eraseNodesIf(m_nodes, isRemoved);
+  node->accept(kdl::overload(
+    [](WorldNode*) {},
+    [&](LayerNode*) { eraseNodesIf(m_layers, isRemoved); },
+    [&](GroupNode*) { eraseNodesIf(m_groups, isRemoved); },
+    [&](EntityNode*) { eraseNodesIf(m_entities, isRemoved); },
+    [&](BrushNode*) { eraseNodesIf(m_brushes, isRemoved); },
+    [&](PatchNode*) { eraseNodesIf(m_patches, isRemoved); }));
 }
 
 void NodeCollection::clear()
@@ -85,6 +85,11 @@ public:
 
   void addNodes(const std::vector<Node*>& nodes);
   void addNode(Node* node);
+  void addNode(LayerNode* layer);
+  void addNode(GroupNode* group);
+  void addNode(EntityNode* entity);
+  void addNode(BrushNode* brush);
+  void addNode(PatchNode* patch);
 
   void removeNodes(const std::vector<Node*>& nodes);
   void removeNode(Node* node);
@@ -26,6 +26,8 @@
 #include "Model/MapFacade.h"
 #include "Polyhedron.h"
 
+#include <vecmath/scalar.h>
+
 #include <string>
 
 namespace TrenchBroom
@@ -42,6 +44,50 @@ IssueQuickFix makeSnapVerticesQuickFix()
             facade.snapVertices(1);
           }};
 }
+
+/**
+ * Copies the vertex coordinates of the given brush into the given buffer, replacing its
+ * previous contents.
+ */
+void copyVertexCoordinates(const BrushNode& brushNode, std::vector<FloatType>& buffer)
+{
+  const auto& vertices = brushNode.brush().vertices();
+  buffer.clear();
+  buffer.reserve(3 * vertices.size());
+  for (const auto* vertex : vertices)
+  {
+    const auto& position = vertex->position();
+    buffer.insert(buffer.end(), position.v, position.v + 3);
+  }
+}
+
+/**
+ * Checks the given coordinates without branching so that the compiler can vectorize the
+ * loop. The coordinates are bounded by the world bounds, so truncating them towards zero
+ * cannot overflow.
+ */
+bool hasNonIntegerCoordinates(const std::vector<FloatType>& coordinates)
+{
+  auto result = false;
+  for (const auto coordinate : coordinates)
+  {
+    result |= coordinate != vm::trunc(coordinate);
+  }
+  return result;
+}
+
+void validateInternal(
+  BrushNode& brushNode,
+  std::vector<FloatType>& buffer,
+  std::vector<std::unique_ptr<Issue>>& issues)
+{
+  copyVertexCoordinates(brushNode, buffer);
+  if (hasNonIntegerCoordinates(buffer))
+  {
+    issues.push_back(
+      std::make_unique<Issue>(Type, brushNode, "Brush has non-integer vertices"));
+  }
+}
 } // namespace
 
 NonIntegerVerticesValidator::NonIntegerVerticesValidator()
@@ -53,13 +99,19 @@ NonIntegerVerticesValidator::NonIntegerVerticesValidator()
 void NonIntegerVerticesValidator::doValidate(
   BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
-  const auto& vertices = brushNode.brush().vertices();
-  if (!std::all_of(vertices.begin(), vertices.end(), [](const auto* vertex) {
-        return vm::is_integral(vertex->position());
-      }))
+  auto buffer = std::vector<FloatType>{};
+  validateInternal(brushNode, buffer, issues);
+}
+
+void NonIntegerVerticesValidator::doValidate(
+  const std::vector<BrushNode*>& brushNodes,
+  std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const
+{
+  // reuse the buffer for the entire batch
+  auto buffer = std::vector<FloatType>{};
+  for (size_t i = 0; i < brushNodes.size(); ++i)
   {
-    issues.push_back(
-      std::make_unique<Issue>(Type, brushNode, "Brush has non-integer vertices"));
+    validateInternal(*brushNodes[i], buffer, issues[i]);
   }
 }
 } // namespace Model
@@ -35,6 +35,9 @@ public:
 private:
   void doValidate(
     BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues) const override;
+  void doValidate(
+    const std::vector<BrushNode*>& brushNodes,
+    std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const override;
 };
 } // namespace Model
 } // namespace TrenchBroom
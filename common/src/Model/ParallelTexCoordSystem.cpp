@@ -170,14 +170,6 @@ bool ParallelTexCoordSystem::isRotationInverted(const vm::vec3& /* normal */) co
   return false;
 }
 
-vm::vec2f ParallelTexCoordSystem::doGetTexCoords(
-  const vm::vec3& point,
-  const BrushFaceAttributes& attribs,
-  const vm::vec2f& textureSize) const
-{
-  return (computeTexCoords(point, attribs.scale()) + attribs.offset()) / textureSize;
-}
-
 /**
  * Rotates from `oldAngle` to `newAngle`. Both of these are in CCW degrees about
  * the texture normal (`getZAxis()`). The provided `normal` is ignored.
@@ -179,14 +179,6 @@ bool ParaxialTexCoordSystem::isRotationInverted(const vm::vec3& normal) const
   return index % 2 == 0;
 }
 
-vm::vec2f ParaxialTexCoordSystem::doGetTexCoords(
-  const vm::vec3& point,
-  const BrushFaceAttributes& attribs,
-  const vm::vec2f& textureSize) const
-{
-  return (computeTexCoords(point, attribs.scale()) + attribs.offset()) / textureSize;
-}
-
 void ParaxialTexCoordSystem::doSetRotation(
   const vm::vec3& normal, const float /* oldAngle */, const float newAngle)
 {
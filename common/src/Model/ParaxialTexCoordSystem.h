@@ -75,10 +75,6 @@ private:
   void doResetTextureAxesToParallel(const vm::vec3& normal, float angle) override;
 
   bool isRotationInverted(const vm::vec3& normal) const override;
-  vm::vec2f doGetTexCoords(
-    const vm::vec3& point,
-    const BrushFaceAttributes& attribs,
-    const vm::vec2f& textureSize) const override;
 
   void doSetRotation(const vm::vec3& normal, float oldAngle, float newAngle) override;
   void doTransform(
@@ -39,6 +39,8 @@
 #include <vecmath/intersection.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <ostream>
 #include <string>
@@ -49,6 +51,12 @@ namespace Model
 {
 constexpr static size_t DefaultSubdivisionsPerSurface = 3u;
 
+// The maximum distance between a rendered patch and its exact surface
+constexpr static auto RenderPositionTolerance = static_cast<FloatType>(0.5);
+
+// The maximum difference between rendered and exact texture coordinates
+constexpr static auto RenderTexCoordTolerance = static_cast<FloatType>(1.0 / 256.0);
+
 kdl_reflect_impl(PatchGrid::Point);
 
 const PatchGrid::Point& PatchGrid::point(const size_t row, const size_t col) const
@@ -293,11 +301,111 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
     gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
 }
 
+namespace
+{
+/**
+ * Returns the sum of the largest second differences of the given components of the
+ * control points along the rows and along the columns of the surfaces of the given patch.
+ */
+template <size_t S>
+FloatType maxSecondDifference(const BezierPatch& patch, const size_t offset)
+{
+  const auto component = [&](const size_t row, const size_t col) {
+    return vm::slice<S>(patch.controlPoint(row, col), offset);
+  };
+
+  auto maxAlongRows = static_cast<FloatType>(0);
+  for (size_t row = 0u; row < patch.pointRowCount(); ++row)
+  {
+    for (size_t col = 0u; col + 2u < patch.pointColumnCount(); col += 2u)
+    {
+      const auto difference = component(row, col)
+                              - static_cast<FloatType>(2) * component(row, col + 1u)
+                              + component(row, col + 2u);
+      maxAlongRows = std::max(maxAlongRows, vm::length(difference));
+    }
+  }
+
+  auto maxAlongColumns = static_cast<FloatType>(0);
+  for (size_t col = 0u; col < patch.pointColumnCount(); ++col)
+  {
+    for (size_t row = 0u; row + 2u < patch.pointRowCount(); row += 2u)
+    {
+      const auto difference = component(row, col)
+                              - static_cast<FloatType>(2) * component(row + 1u, col)
+                              + component(row + 2u, col);
+      maxAlongColumns = std::max(maxAlongColumns, vm::length(difference));
+    }
+  }
+
+  return maxAlongRows + maxAlongColumns;
+}
+
+std::optional<PatchGrid> makeRenderGrid(const BezierPatch& patch, const PatchGrid& grid)
+{
+  const auto subdivisionsPerSurface =
+    computeRenderSubdivisionsPerSurface(patch, DefaultSubdivisionsPerSurface);
+  if (subdivisionsPerSurface == DefaultSubdivisionsPerSurface)
+  {
+    return std::nullopt;
+  }
+
+  const auto step = size_t(1) << (DefaultSubdivisionsPerSurface - subdivisionsPerSurface);
+  return coarsenPatchGrid(grid, step);
+}
+} // namespace
+
+size_t computeRenderSubdivisionsPerSurface(
+  const BezierPatch& patch, const size_t maxSubdivisionsPerSurface)
+{
+  const auto positionDifference = maxSecondDifference<3>(patch, 0u);
+  const auto texCoordDifference = maxSecondDifference<2>(patch, 3u);
+
+  // The distance between a biquadratic surface and its bilinear interpolation over a
+  // grid with cells of size h (in parameter space) is at most the sum of the second
+  // differences times h^2 / 4. Every subdivision halves h.
+  auto subdivisionsPerSurface = size_t(0);
+  auto errorFactor = static_cast<FloatType>(0.25);
+  while (subdivisionsPerSurface < maxSubdivisionsPerSurface
+         && (positionDifference * errorFactor > RenderPositionTolerance
+             || texCoordDifference * errorFactor > RenderTexCoordTolerance))
+  {
+    ++subdivisionsPerSurface;
+    errorFactor /= static_cast<FloatType>(4);
+  }
+
+  return subdivisionsPerSurface;
+}
+
+PatchGrid coarsenPatchGrid(const PatchGrid& grid, const size_t step)
+{
+  assert(step > 0u);
+  assert(grid.quadRowCount() % step == 0u);
+  assert(grid.quadColumnCount() % step == 0u);
+
+  const auto pointRowCount = grid.quadRowCount() / step + 1u;
+  const auto pointColumnCount = grid.quadColumnCount() / step + 1u;
+
+  auto points = std::vector<PatchGrid::Point>{};
+  points.reserve(pointRowCount * pointColumnCount);
+  for (size_t row = 0u; row < pointRowCount; ++row)
+  {
+    for (size_t col = 0u; col < pointColumnCount; ++col)
+    {
+      points.push_back(grid.point(row * step, col * step));
+    }
+  }
+
+  // the bounds of the given grid contain the coarser grid
+  return {pointRowCount, pointColumnCount, std::move(points), grid.bounds};
+}
+
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
   : m_patch{std::move(patch)}
   , m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)}
+  , m_renderGrid{makeRenderGrid(m_patch, m_grid)}
 {
 }
 
@@ -339,6 +447,7 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
   m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+  m_renderGrid = makeRenderGrid(m_patch, m_grid);
   return previousPatch;
 }
 
@@ -352,6 +461,11 @@ const PatchGrid& PatchNode::grid() const
   return m_grid;
 }
 
+const PatchGrid& PatchNode::renderGrid() const
+{
+  return m_renderGrid ? *m_renderGrid : m_grid;
+}
+
 const std::string& PatchNode::doGetName() const
 {
   static const auto name = std::string{"patch"};
@@ -422,17 +536,39 @@ void PatchNode::doPick(
   {
     return;
   }
-  const auto pickTriangle = [&](const auto& p0, const auto& p1, const auto& p2) {
-    if (const auto distance = vm::intersect_ray_triangle(pickRay, p0, p1, p2);
-        !vm::is_nan(distance))
+
+  // test the triangles in batches, but report the first hit in the original order
+  constexpr auto BatchSize = size_t(8);
+  auto p1 = std::array<vm::vec3, BatchSize>{};
+  auto p2 = std::array<vm::vec3, BatchSize>{};
+  auto p3 = std::array<vm::vec3, BatchSize>{};
+  auto batchCount = size_t(0);
+
+  // the slots after the last triangle of an incomplete batch are either degenerate or
+  // hold triangles that already missed, so they need not be cleared
+  const auto pickBatch = [&]() {
+    batchCount = 0u;
+
+    const auto distances = vm::intersect_ray_triangles(pickRay, p1, p2, p3);
+    const auto it = std::find_if(distances.begin(), distances.end(), [](const auto d) {
+      return !vm::is_nan(d);
+    });
+    if (it != distances.end())
     {
-      const auto hitPoint = vm::point_at_distance(pickRay, distance);
-      pickResult.addHit(Hit(PatchHitType, distance, hitPoint, this));
+      const auto hitPoint = vm::point_at_distance(pickRay, *it);
+      pickResult.addHit(Hit(PatchHitType, *it, hitPoint, this));
       return true;
     }
     return false;
   };
 
+  const auto addTriangle = [&](const auto& v0, const auto& v1, const auto& v2) {
+    p1[batchCount] = v0;
+    p2[batchCount] = v1;
+    p3[batchCount] = v2;
+    return ++batchCount == BatchSize && pickBatch();
+  };
+
   for (size_t row = 0u; row < m_grid.pointRowCount - 1u; ++row)
   {
     for (size_t col = 0u; col < m_grid.pointColumnCount - 1u; ++col)
@@ -442,12 +578,17 @@ void PatchNode::doPick(
       const auto v2 = m_grid.point(row + 1u, col + 1u).position;
       const auto v3 = m_grid.point(row + 1u, col).position;
 
-      if (pickTriangle(v0, v1, v2) || pickTriangle(v2, v3, v0))
+      if (addTriangle(v0, v1, v2) || addTriangle(v2, v3, v0))
       {
         return;
       }
     }
   }
+
+  if (batchCount > 0u)
+  {
+    pickBatch();
+  }
 }
 
 void PatchNode::doFindNodesContaining(const vm::vec3&, std::vector<Node*>&) {}
@@ -75,6 +75,29 @@ std::vector<vm::vec3> computeGridNormals(
 // public for testing
 PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
 
+/**
+ * Returns the smallest number of subdivisions per surface, up to the given maximum, for
+ * which a grid of the given patch stays within a fixed distance of the exact surface and
+ * its texture coordinates.
+ *
+ * The bound is derived from the second differences of the control points, so flat patches
+ * and small patches need fewer subdivisions than large, strongly curved patches.
+ *
+ * public for testing
+ */
+size_t computeRenderSubdivisionsPerSurface(
+  const BezierPatch& patch, size_t maxSubdivisionsPerSurface);
+
+/**
+ * Returns a grid that contains every step-th row and column of the given grid. Since the
+ * points of a coarser grid of a patch are a subset of the points of a finer grid, this
+ * yields the same points as evaluating the patch with fewer subdivisions, but keeps the
+ * more accurate normals of the given grid.
+ *
+ * public for testing
+ */
+PatchGrid coarsenPatchGrid(const PatchGrid& grid, size_t step);
+
 class PatchNode : public Node, public Object
 {
 public:
@@ -84,6 +107,11 @@ private:
   BezierPatch m_patch;
   PatchGrid m_grid;
 
+  /**
+   * A coarser grid for rendering, or nullopt if the patch needs the full grid.
+   */
+  std::optional<PatchGrid> m_renderGrid;
+
 public:
   explicit PatchNode(BezierPatch patch);
 
@@ -97,6 +125,12 @@ public:
 
   const PatchGrid& grid() const;
 
+  /**
+   * Returns the grid to render, which is coarser than grid() if the patch is flat enough.
+   * Use grid() for picking and other computations that need the full grid.
+   */
+  const PatchGrid& renderGrid() const;
+
 private: // implement Node interface
   const std::string& doGetName() const override;
   const vm::bbox3& doGetLogicalBounds() const override;
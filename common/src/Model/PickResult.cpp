@@ -53,12 +53,14 @@ public:
 };
 
 PickResult::PickResult(std::shared_ptr<CompareHits> compare)
-  : m_compare(std::move(compare))
+  : m_sorted(true)
+  , m_compare(std::move(compare))
 {
 }
 
 PickResult::PickResult()
-  : m_compare(std::make_shared<CompareHitsByDistance>())
+  : m_sorted(true)
+  , m_compare(std::make_shared<CompareHitsByDistance>())
 {
 }
 
@@ -93,20 +95,20 @@ void PickResult::addHit(const Hit& hit)
   {
     return;
   }
-  ensure(m_compare.get() != nullptr, "compare is null");
-  auto pos = std::upper_bound(
-    std::begin(m_hits), std::end(m_hits), hit, CompareWrapper(m_compare.get()));
-  m_hits.insert(pos, hit);
+  m_hits.push_back(hit);
+  m_sorted = false;
 }
 
 const std::vector<Hit>& PickResult::all() const
 {
+  sortHits();
   return m_hits;
 }
 
 const Hit& PickResult::first(const HitFilter& filter) const
 {
   const auto occluder = HitFilters::type(HitType::AnyType);
+  sortHits();
 
   if (!m_hits.empty())
   {
@@ -152,12 +154,26 @@ const Hit& PickResult::first(const HitFilter& filter) const
 
 std::vector<Hit> PickResult::all(const HitFilter& filter) const
 {
+  sortHits();
   return kdl::vec_filter(m_hits, filter);
 }
 
 void PickResult::clear()
 {
   m_hits.clear();
+  m_sorted = true;
+}
+
+void PickResult::sortHits() const
+{
+  if (!m_sorted)
+  {
+    ensure(m_compare.get() != nullptr, "compare is null");
+    // a stable sort keeps hits that compare equal in the order they were added
+    std::stable_sort(
+      std::begin(m_hits), std::end(m_hits), CompareWrapper(m_compare.get()));
+    m_sorted = true;
+  }
 }
 } // namespace Model
 } // namespace TrenchBroom
@@ -38,7 +38,9 @@ class HitQuery;
 class PickResult
 {
 private:
-  std::vector<Hit> m_hits;
+  // hits are appended unsorted and only sorted when they are queried
+  mutable std::vector<Hit> m_hits;
+  mutable bool m_sorted;
   std::shared_ptr<CompareHits> m_compare;
   class CompareWrapper;
 
@@ -63,6 +65,9 @@ public:
   std::vector<Hit> all(const HitFilter& filter) const;
 
   void clear();
+
+private:
+  void sortHits() const;
 };
 } // namespace Model
 } // namespace TrenchBroom
@@ -30,10 +30,12 @@
 #include <vecmath/util.h>
 #include <vecmath/vec.h>
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include <variant>
 #include <vector>
@@ -113,6 +115,12 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Allocates and frees vertices using a kdl::memory_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the position of this vertex.
    */
@@ -260,6 +268,12 @@ private:
   Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Allocates and frees edges using a kdl::memory_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -577,6 +591,12 @@ private:
   Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Allocates and frees half edges using a kdl::memory_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -803,6 +823,12 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Allocates and frees faces using a kdl::memory_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
@@ -1213,6 +1239,23 @@ public: // Constructors
    */
   explicit Polyhedron(std::vector<vm::vec<T, 3>> positions);
 
+  /**
+   * Constructs a polyhedron with the given vertices and faces, e.g. to restore a
+   * polyhedron that was previously stored. Every face is given by its plane and the
+   * indices of its boundary vertices in the order in which Face::boundary() returns them.
+   *
+   * The faces must form a closed surface where every edge is shared by exactly two faces,
+   * otherwise std::nullopt is returned. The geometric validity of the polyhedron is not
+   * checked.
+   *
+   * @param positions the vertex positions
+   * @param faces the planes and boundary vertex indices of the faces
+   * @return the polyhedron or std::nullopt if the faces do not form a closed surface
+   */
+  static std::optional<Polyhedron> createFromFaces(
+    const std::vector<vm::vec<T, 3>>& positions,
+    const std::vector<std::tuple<vm::plane<T, 3>, std::vector<size_t>>>& faces);
+
   /**
    * Copy constructor.
    */
@@ -1347,6 +1390,12 @@ public: // Accessors
    */
   const vm::bbox<T, 3>& bounds() const;
 
+  /**
+   * Returns the number of bytes occupied by this polyhedron and its vertices, edges, half
+   * edges and faces, excluding allocator overhead.
+   */
+  size_t memoryUsage() const;
+
   /**
    * Indicates whether this polyhedron is empty.
    *
@@ -1688,6 +1737,44 @@ public:
 
   /* ====================== Implementation in Polyhedron_ConvexHull.h
    * ====================== */
+public: // Convex hull; incremental updates
+  /**
+   * Returns the convex hull of the vertices of this polyhedron without the vertex at the
+   * given position.
+   *
+   * Only the faces incident to the removed vertex are recomputed. Removing them leaves a
+   * hole that is bounded by their remaining vertices, and the hole is filled with those
+   * faces of the convex hull of the boundary vertices which face the removed vertex. All
+   * other faces are retained.
+   *
+   * Returns std::nullopt if the given position is not a vertex of this polyhedron, if the
+   * result is not a polyhedron, or if rounding errors make a new face coplanar with a
+   * retained face. In these cases, the convex hull must be computed from the remaining
+   * vertices.
+   *
+   * @param position the position of the vertex to remove
+   * @return the convex hull of the remaining vertices or std::nullopt
+   */
+  std::optional<Polyhedron> withoutVertex(const vm::vec<T, 3>& position) const;
+
+  /**
+   * Returns the convex hull of the vertices of this polyhedron with the vertex at the
+   * given position moved to the given new position.
+   *
+   * The vertex is removed by calling withoutVertex, and the new position is added to the
+   * result, which only replaces the faces that are visible from the new position. This is
+   * much faster than computing the convex hull of all vertex positions if the polyhedron
+   * has many faces.
+   *
+   * Returns std::nullopt if the vertex cannot be removed incrementally.
+   *
+   * @param position the position of the vertex to move
+   * @param newPosition the position to move the vertex to
+   * @return the convex hull of the moved vertices or std::nullopt
+   */
+  std::optional<Polyhedron> withMovedVertex(
+    const vm::vec<T, 3>& position, const vm::vec<T, 3>& newPosition) const;
+
 private: // Convex hull; adding and removing points
   /**
    * Adds the given points to this polyhedron. The effect of adding the given points to a
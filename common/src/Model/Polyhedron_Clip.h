@@ -126,6 +126,7 @@ typename Polyhedron<T, FP, VP>::ClipResult Polyhedron<T, FP, VP>::clip(
     {
       assertResult(mergeNeighbours(edge->firstEdge()));
     }
+    updateBounds();
     assert(checkInvariant());
 
     /*
@@ -147,42 +148,67 @@ std::optional<typename Polyhedron<T, FP, VP>::ClipResult::FailureReason> Polyhed
   FP,
   VP>::checkIntersects(const vm::plane<T, 3>& plane) const
 {
-  std::size_t above = 0u;
-  std::size_t below = 0u;
-  std::size_t inside = 0u;
+  const auto epsilon = vm::constants<T>::point_status_epsilon();
+
+  // First, classify the corners of the bounding box that are farthest above and below
+  // the plane. Since rounding is monotonic, no vertex can have a greater (smaller)
+  // distance to the plane than the farthest corner above (below) it, so if these corners
+  // already decide the outcome, we can skip the vertices entirely.
+  const auto& normal = plane.normal;
+  auto maxCorner = m_bounds.min;
+  auto minCorner = m_bounds.max;
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    if (normal[i] >= T(0))
+    {
+      maxCorner[i] = m_bounds.max[i];
+      minCorner[i] = m_bounds.min[i];
+    }
+  }
+
+  if (plane.point_distance(maxCorner) <= epsilon)
+  {
+    return ClipResult::FailureReason::Unchanged;
+  }
+  if (plane.point_distance(minCorner) >= -epsilon)
+  {
+    return ClipResult::FailureReason::Empty;
+  }
+
+  // The plane passes through the bounding box, so we have to classify the vertices. We
+  // can stop as soon as we have found vertices on both sides of the plane.
+  auto hasAbove = false;
+  auto hasBelow = false;
 
   for (const Vertex* currentVertex : m_vertices)
   {
-    const vm::plane_status status = plane.point_status(
-      currentVertex->position(), vm::constants<T>::point_status_epsilon());
+    const vm::plane_status status = plane.point_status(currentVertex->position(), epsilon);
     switch (status)
     {
     case vm::plane_status::above:
-      ++above;
+      hasAbove = true;
       break;
     case vm::plane_status::below:
-      ++below;
+      hasBelow = true;
       break;
     case vm::plane_status::inside:
-      ++inside;
       break;
       switchDefault();
     }
-  }
 
-  assert(above + below + inside == m_vertices.size());
+    if (hasAbove && hasBelow)
+    {
+      return std::nullopt;
+    }
+  }
 
-  if (below + inside == m_vertices.size())
+  if (!hasAbove)
   {
     return ClipResult::FailureReason::Unchanged;
   }
-  else if (above + inside == m_vertices.size())
-  {
-    return ClipResult::FailureReason::Empty;
-  }
   else
   {
-    return std::nullopt;
+    return ClipResult::FailureReason::Empty;
   }
 }
 
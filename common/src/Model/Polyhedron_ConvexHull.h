@@ -31,6 +31,10 @@
 #include <vecmath/util.h>
 
 #include <list>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -66,6 +70,177 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
   }
 }
 
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::withoutVertex(
+  const vm::vec<T, 3>& position) const
+{
+  if (!polyhedron())
+  {
+    return std::nullopt;
+  }
+
+  const auto* removedVertex = findVertexByPosition(position);
+  if (removedVertex == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  auto positions = std::vector<vm::vec<T, 3>>{};
+  auto indices = std::unordered_map<const Vertex*, size_t>{};
+  positions.reserve(vertexCount() - 1u);
+  for (const auto* vertex : m_vertices)
+  {
+    if (vertex != removedVertex)
+    {
+      indices.emplace(vertex, positions.size());
+      positions.push_back(vertex->position());
+    }
+  }
+
+  const auto planeEpsilon = computePlaneEpsilon(positions);
+  const auto halfEdgeKey = [&](const size_t origin, const size_t destination) {
+    return origin * positions.size() + destination;
+  };
+
+  // the faces that are not incident to the removed vertex are retained, the vertices of
+  // the incident faces bound the hole that is left when the incident faces are removed
+  auto faces = std::vector<std::tuple<vm::plane<T, 3>, std::vector<size_t>>>{};
+  auto retainedHalfEdges = std::unordered_map<size_t, const Face*>{};
+  auto holeIndices = std::map<vm::vec<T, 3>, size_t>{};
+
+  for (const auto* face : m_faces)
+  {
+    const auto& boundary = face->boundary();
+    const auto isIncident = std::any_of(
+      std::begin(boundary), std::end(boundary), [&](const auto* halfEdge) {
+        return halfEdge->origin() == removedVertex;
+      });
+
+    if (isIncident)
+    {
+      for (const auto* halfEdge : boundary)
+      {
+        const auto* origin = halfEdge->origin();
+        if (origin != removedVertex)
+        {
+          holeIndices.emplace(origin->position(), indices[origin]);
+        }
+      }
+    }
+    else
+    {
+      auto faceIndices = std::vector<size_t>{};
+      faceIndices.reserve(boundary.size());
+      for (const auto* halfEdge : boundary)
+      {
+        faceIndices.push_back(indices[halfEdge->origin()]);
+        retainedHalfEdges.emplace(
+          halfEdgeKey(
+            indices[halfEdge->origin()], indices[halfEdge->destination()]),
+          face);
+      }
+      faces.emplace_back(face->plane(), std::move(faceIndices));
+    }
+  }
+
+  // use the same plane epsilon as when computing the convex hull of all positions
+  auto hull = Polyhedron{};
+  for (const auto& [holePosition, index] : holeIndices)
+  {
+    hull.addPoint(holePosition, planeEpsilon);
+  }
+
+  if (!hull.polyhedron() && !hull.polygon())
+  {
+    return std::nullopt;
+  }
+
+  // Fills the hole with the given face of the hull. The face must not be coplanar with
+  // any adjacent retained face, otherwise the faces would have to be merged.
+  const auto addFillFace = [&](const Face* hullFace, const bool flip) {
+    auto faceIndices = std::vector<size_t>{};
+    for (const auto* halfEdge : hullFace->boundary())
+    {
+      const auto index = holeIndices.find(halfEdge->origin()->position());
+      if (index == std::end(holeIndices))
+      {
+        return false;
+      }
+      faceIndices.push_back(index->second);
+    }
+
+    if (flip)
+    {
+      std::reverse(std::begin(faceIndices), std::end(faceIndices));
+    }
+
+    const auto normal = flip ? -hullFace->normal() : hullFace->normal();
+    for (size_t i = 0; i < faceIndices.size(); ++i)
+    {
+      const auto origin = faceIndices[i];
+      const auto destination = faceIndices[(i + 1) % faceIndices.size()];
+      const auto neighbour = retainedHalfEdges.find(halfEdgeKey(destination, origin));
+      if (
+        neighbour != std::end(retainedHalfEdges)
+        && T(1) - vm::dot(neighbour->second->normal(), normal)
+             < vm::constants<T>::colinear_epsilon()
+        && hullFace->verticesOnPlane(neighbour->second->plane(), planeEpsilon))
+      {
+        return false;
+      }
+    }
+
+    faces.emplace_back(
+      flip ? hullFace->plane().flip() : hullFace->plane(), std::move(faceIndices));
+    return true;
+  };
+
+  const auto pointEpsilon = vm::constants<T>::point_status_epsilon();
+  if (hull.polygon())
+  {
+    // the hole is planar and filled with a single face
+    const auto* hullFace = hull.faces().front();
+    const auto status = hullFace->pointStatus(position, pointEpsilon);
+    if (
+      status == vm::plane_status::inside
+      || !addFillFace(hullFace, status == vm::plane_status::below))
+    {
+      return std::nullopt;
+    }
+  }
+  else
+  {
+    // the removed vertex can be on the plane of a face of the hull if that face replaces
+    // an incident face
+    for (const auto* hullFace : hull.faces())
+    {
+      if (
+        hullFace->pointStatus(position, pointEpsilon) != vm::plane_status::below
+        && !addFillFace(hullFace, false))
+      {
+        return std::nullopt;
+      }
+    }
+  }
+
+  // fails if the fill faces do not close the hole
+  return createFromFaces(positions, faces);
+}
+
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::withMovedVertex(
+  const vm::vec<T, 3>& position, const vm::vec<T, 3>& newPosition) const
+{
+  auto result = withoutVertex(position);
+  if (result)
+  {
+    auto positions = result->vertexPositions();
+    positions.push_back(newPosition);
+    result->addPoint(newPosition, computePlaneEpsilon(positions));
+  }
+  return result;
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPoint(
   const vm::vec<T, 3>& position, const T planeEpsilon)
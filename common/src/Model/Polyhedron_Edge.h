@@ -22,12 +22,17 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include <kdl/memory_pool.h>
+
 #include <vecmath/distance.h>
 #include <vecmath/plane.h>
 #include <vecmath/scalar.h>
 #include <vecmath/segment.h>
 #include <vecmath/vec.h>
 
+#include <cassert>
+#include <cstddef>
+
 namespace TrenchBroom
 {
 namespace Model
@@ -74,6 +79,20 @@ Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Edge));
+  unused(size);
+  return kdl::memory_pool<sizeof(Edge), alignof(Edge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr)
+{
+  kdl::memory_pool<sizeof(Edge), alignof(Edge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_Edge<T, FP, VP>::Vertex* Polyhedron_Edge<T, FP, VP>::firstVertex()
   const
@@ -19,8 +19,14 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
+#include <kdl/memory_pool.h>
+
+#include <cassert>
+#include <cstddef>
+
 namespace TrenchBroom
 {
 namespace Model
@@ -63,6 +69,20 @@ Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   setAsLeaving();
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(HalfEdge));
+  unused(size);
+  return kdl::memory_pool<sizeof(HalfEdge), alignof(HalfEdge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr)
+{
+  kdl::memory_pool<sizeof(HalfEdge), alignof(HalfEdge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_HalfEdge<T, FP, VP>::Vertex* Polyhedron_HalfEdge<T, FP, VP>::origin()
   const
@@ -26,8 +26,10 @@
 #include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -63,6 +65,11 @@ namespace Model
  * from the left polyhedron for each face of the right polyhedron. If multiple faces of
  * the left polyhedron have a maximal matching score, the matcher selects a face such that
  * its normal is closest to the normal of the right face.
+ *
+ * Only the left faces that are incident to a vertex related to a vertex of the right face
+ * or that share a vertex position with it can have a nonzero score, so the matcher only
+ * scores these candidates. Vertices are looked up by their positions using maps, so the
+ * cost of matching is close to linear in the number of faces and vertices.
  */
 template <typename P>
 class PolyhedronMatcher
@@ -75,18 +82,25 @@ private:
   using HalfEdge = typename P::HalfEdge;
   using Face = typename P::Face;
   using VMap = std::map<V, V>;
+  using VertexPositionMap = std::map<V, Vertex*>;
 
   using VertexRelation = kdl::binary_relation<Vertex*, Vertex*>;
 
   const P& m_left;
   const P& m_right;
+  const VertexPositionMap m_leftVerticesByPosition;
+  const std::vector<Face*> m_leftFaces;
+  const std::unordered_map<const Face*, size_t> m_leftFaceIndices;
   const VertexRelation m_vertexRelation;
 
 public:
   PolyhedronMatcher(const P& left, const P& right)
     : m_left(left)
     , m_right(right)
-    , m_vertexRelation(buildVertexRelation(m_left, m_right))
+    , m_leftVerticesByPosition(buildVertexPositionMap(m_left))
+    , m_leftFaces(collectFaces(m_left))
+    , m_leftFaceIndices(buildFaceIndices(m_leftFaces))
+    , m_vertexRelation(buildVertexRelation(m_left, m_leftVerticesByPosition, m_right))
   {
   }
 
@@ -94,14 +108,26 @@ public:
     const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
     : m_left(left)
     , m_right(right)
-    , m_vertexRelation(buildVertexRelation(m_left, m_right, vertices, delta))
+    , m_leftVerticesByPosition(buildVertexPositionMap(m_left))
+    , m_leftFaces(collectFaces(m_left))
+    , m_leftFaceIndices(buildFaceIndices(m_leftFaces))
+    , m_vertexRelation(
+        buildVertexRelation(m_left, m_leftVerticesByPosition, m_right, vertices, delta))
   {
   }
 
   PolyhedronMatcher(const P& left, const P& right, const VMap& vertexMap)
     : m_left(left)
     , m_right(right)
-    , m_vertexRelation(buildVertexRelation(m_left, m_right, vertexMap))
+    , m_leftVerticesByPosition(buildVertexPositionMap(m_left))
+    , m_leftFaces(collectFaces(m_left))
+    , m_leftFaceIndices(buildFaceIndices(m_leftFaces))
+    , m_vertexRelation(buildVertexRelation(
+        m_left,
+        m_leftVerticesByPosition,
+        m_right,
+        buildVertexPositionMap(m_right),
+        vertexMap))
   {
   }
 
@@ -180,25 +206,72 @@ private:
     MatchingFaces result;
     size_t bestMatchScore = 0;
 
-    auto* firstLeftFace = m_left.faces().front();
-    auto* currentLeftFace = firstLeftFace;
-    do
+    for (auto* leftFace : findCandidateLeftFaces(rightFace))
     {
-      const auto matchScore = computeMatchScore(currentLeftFace, rightFace);
+      const auto matchScore = computeMatchScore(leftFace, rightFace);
       if (matchScore > bestMatchScore)
       {
         result.clear();
-        result.push_back(currentLeftFace);
+        result.push_back(leftFace);
         bestMatchScore = matchScore;
       }
-      else if (matchScore == bestMatchScore)
+      else if (matchScore == bestMatchScore && matchScore > 0)
       {
-        result.push_back(currentLeftFace);
+        result.push_back(leftFace);
       }
-      currentLeftFace = currentLeftFace->next();
-    } while (currentLeftFace != firstLeftFace);
+    }
 
-    return result;
+    // If no candidate has a nonzero score, then every left face has a score of zero.
+    return result.empty() ? m_leftFaces : result;
+  }
+
+  /**
+   * Find the faces of the left polyhedron that can have a nonzero matching score with
+   * the given face of the right polyhedron. These are the faces incident to a left vertex
+   * that is related to a vertex of the given face or that has the same position as a
+   * vertex of the given face.
+   *
+   * @param rightFace the face of the right polyhedron
+   * @return the candidate faces in the order in which they appear in the left polyhedron
+   */
+  MatchingFaces findCandidateLeftFaces(Face* rightFace) const
+  {
+    std::vector<size_t> faceIndices;
+
+    const auto addIncidentFaces = [&](Vertex* leftVertex) {
+      auto* firstEdge = leftVertex->leaving();
+      auto* currentEdge = firstEdge;
+      do
+      {
+        faceIndices.push_back(m_leftFaceIndices.at(currentEdge->face()));
+        currentEdge = currentEdge->nextIncident();
+      } while (currentEdge != firstEdge);
+    };
+
+    auto* firstRightEdge = rightFace->boundary().front();
+    auto* currentRightEdge = firstRightEdge;
+    do
+    {
+      const auto [begin, end] = m_vertexRelation.left_range(currentRightEdge->origin());
+      std::for_each(begin, end, addIncidentFaces);
+      currentRightEdge = currentRightEdge->next();
+    } while (currentRightEdge != firstRightEdge);
+
+    // A left face with the same vertex positions has a perfect score even if its vertices
+    // are unrelated. Such a face is incident to the left vertex at the position of any
+    // vertex of the right face, so it suffices to check one of them.
+    if (
+      auto* leftVertex = findVertexByPosition(
+        m_leftVerticesByPosition, firstRightEdge->origin()->position()))
+    {
+      addIncidentFaces(leftVertex);
+    }
+
+    std::sort(faceIndices.begin(), faceIndices.end());
+    faceIndices.erase(
+      std::unique(faceIndices.begin(), faceIndices.end()), faceIndices.end());
+
+    return kdl::vec_transform(faceIndices, [&](const auto i) { return m_leftFaces[i]; });
   }
 
 public:
@@ -262,15 +335,82 @@ private:
       return std::numeric_limits<size_t>::max();
     }
 
+    const auto& rightBoundary = rightFace->boundary();
+    const auto isRightVertex = [&](const Vertex* vertex) {
+      return std::any_of(
+        rightBoundary.begin(), rightBoundary.end(), [&](const HalfEdge* halfEdge) {
+          return halfEdge->origin() == vertex;
+        });
+    };
+
+    // Count the related pairs by looking up the relation once per left vertex instead of
+    // once for every pair of vertices.
     size_t result = 0;
-    visitMatchingVertexPairs(
-      leftFace,
-      rightFace,
-      [&result](Vertex* /* leftVertex */, Vertex* /* rightVertex */) { ++result; });
+    for (const auto* leftEdge : leftFace->boundary())
+    {
+      const auto [begin, end] = m_vertexRelation.right_range(leftEdge->origin());
+      result += size_t(std::count_if(begin, end, isRightVertex));
+    }
     return result;
   }
 
 private:
+  /**
+   * Maps the position of each vertex of the given polyhedron to that vertex.
+   *
+   * @param polyhedron the polyhedron
+   * @return the vertex position map
+   */
+  static VertexPositionMap buildVertexPositionMap(const P& polyhedron)
+  {
+    VertexPositionMap result;
+
+    auto* firstVertex = polyhedron.vertices().front();
+    auto* currentVertex = firstVertex;
+    do
+    {
+      result.emplace(currentVertex->position(), currentVertex);
+      currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    return result;
+  }
+
+  static Vertex* findVertexByPosition(
+    const VertexPositionMap& vertexPositionMap, const V& position)
+  {
+    const auto it = vertexPositionMap.find(position);
+    return it != vertexPositionMap.end() ? it->second : nullptr;
+  }
+
+  static std::vector<Face*> collectFaces(const P& polyhedron)
+  {
+    std::vector<Face*> result;
+    result.reserve(polyhedron.faceCount());
+
+    auto* firstFace = polyhedron.faces().front();
+    auto* currentFace = firstFace;
+    do
+    {
+      result.push_back(currentFace);
+      currentFace = currentFace->next();
+    } while (currentFace != firstFace);
+
+    return result;
+  }
+
+  static std::unordered_map<const Face*, size_t> buildFaceIndices(
+    const std::vector<Face*>& faces)
+  {
+    std::unordered_map<const Face*, size_t> result;
+    result.reserve(faces.size());
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+      result.emplace(faces[i], i);
+    }
+    return result;
+  }
+
   /**
    * Build the vertex relation for the given left and right polyhedra.
    *
@@ -280,26 +420,27 @@ private:
    * expandVertexRelation function.
    *
    * @param left the left polyhedron
+   * @param leftVerticesByPosition the vertices of the left polyhedron by their positions
    * @param right the right polyhedron
    * @return the vertex relation
    */
-  static VertexRelation buildVertexRelation(const P& left, const P& right)
+  static VertexRelation buildVertexRelation(
+    const P& left, const VertexPositionMap& leftVerticesByPosition, const P& right)
   {
     VertexRelation result;
 
-    auto* firstLeftVertex = left.vertices().front();
-    auto* currentLeftVertex = firstLeftVertex;
+    auto* firstRightVertex = right.vertices().front();
+    auto* currentRightVertex = firstRightVertex;
     do
     {
-      const auto& position = currentLeftVertex->position();
-      auto* currentRightVertex = right.findVertexByPosition(position);
-      if (currentRightVertex != nullptr)
+      const auto& position = currentRightVertex->position();
+      if (auto* leftVertex = findVertexByPosition(leftVerticesByPosition, position))
       {
-        result.insert(currentLeftVertex, currentRightVertex);
+        result.insert(leftVertex, currentRightVertex);
       }
 
-      currentLeftVertex = currentLeftVertex->next();
-    } while (currentLeftVertex != firstLeftVertex);
+      currentRightVertex = currentRightVertex->next();
+    } while (currentRightVertex != firstRightVertex);
 
     return expandVertexRelation(left, right, result);
   }
@@ -314,14 +455,21 @@ private:
    * polyhedron.
    *
    * @param left the left polyhedron
+   * @param leftVerticesByPosition the vertices of the left polyhedron by their positions
    * @param right the right polyhedron
    * @param vertices the vertices that have been moved
    * @param delta the move delta
    * @return the vertex relation
    */
   static VertexRelation buildVertexRelation(
-    const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
+    const P& left,
+    const VertexPositionMap& leftVerticesByPosition,
+    const P& right,
+    const std::vector<V>& vertices,
+    const V& delta)
   {
+    const auto rightVerticesByPosition = buildVertexPositionMap(right);
+
     VMap vertexMap;
     const auto vertexSet = kdl::vector_set<V>::create(vertices);
 
@@ -335,20 +483,22 @@ private:
       // vm::Constants<T>::almost_zero()
       if (vertexSet.count(position) > 0u)
       {
-        if (right.hasVertex(position))
+        if (findVertexByPosition(rightVerticesByPosition, position) != nullptr)
         {
           vertexMap.insert(std::make_pair(position, position));
         }
       }
       else
       {
-        assert(right.hasVertex(position + delta));
+        assert(
+          findVertexByPosition(rightVerticesByPosition, position + delta) != nullptr);
         vertexMap.insert(std::make_pair(position, position + delta));
       }
       currentVertex = currentVertex->next();
     } while (currentVertex != firstVertex);
 
-    return buildVertexRelation(left, right, vertexMap);
+    return buildVertexRelation(
+      left, leftVerticesByPosition, right, rightVerticesByPosition, vertexMap);
   }
 
   /**
@@ -356,19 +506,26 @@ private:
    * vertices.
    *
    * @param left the left polyhedron
+   * @param leftVerticesByPosition the vertices of the left polyhedron by their positions
    * @param right the right polyhedron
+   * @param rightVerticesByPosition the vertices of the right polyhedron by their
+   * positions
    * @param vertexMap a set of corresponding vertices for which to build the relation
    * @return the vertex relation
    */
   static VertexRelation buildVertexRelation(
-    const P& left, const P& right, const VMap& vertexMap)
+    const P& left,
+    const VertexPositionMap& leftVerticesByPosition,
+    const P& right,
+    const VertexPositionMap& rightVerticesByPosition,
+    const VMap& vertexMap)
   {
     VertexRelation result;
 
     for (const auto& [leftPosition, rightPosition] : vertexMap)
     {
-      auto* leftVertex = left.findVertexByPosition(leftPosition);
-      auto* rightVertex = right.findVertexByPosition(rightPosition);
+      auto* leftVertex = findVertexByPosition(leftVerticesByPosition, leftPosition);
+      auto* rightVertex = findVertexByPosition(rightVerticesByPosition, rightPosition);
 
       assert(leftVertex != nullptr);
       assert(rightVertex != nullptr);
@@ -31,9 +31,12 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <optional>
 #include <sstream>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -230,6 +233,96 @@ Polyhedron<T, FP, VP>::Polyhedron(
   Copy copy(other.faces(), other.edges(), other.vertices(), *this, callback);
 }
 
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::createFromFaces(
+  const std::vector<vm::vec<T, 3>>& positions,
+  const std::vector<std::tuple<vm::plane<T, 3>, std::vector<size_t>>>& faces)
+{
+  if (positions.size() < 4 || faces.size() < 4)
+  {
+    return std::nullopt;
+  }
+
+  auto result = Polyhedron{};
+
+  auto vertices = std::vector<Vertex*>{};
+  vertices.reserve(positions.size());
+  for (const auto& position : positions)
+  {
+    auto* vertex = new Vertex{position};
+    result.m_vertices.push_back(vertex);
+    vertices.push_back(vertex);
+  }
+
+  // maps the origin and destination vertex indices of each half edge to the half edge
+  auto halfEdges = std::unordered_map<size_t, HalfEdge*>{};
+  const auto halfEdgeKey = [&](const size_t origin, const size_t destination) {
+    return origin * positions.size() + destination;
+  };
+
+  for (const auto& [plane, indices] : faces)
+  {
+    if (indices.size() < 3)
+    {
+      return std::nullopt;
+    }
+
+    auto boundary = HalfEdgeList{};
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      const auto origin = indices[i];
+      const auto destination = indices[(i + 1) % indices.size()];
+      if (
+        origin >= positions.size() || destination >= positions.size()
+        || origin == destination)
+      {
+        return std::nullopt;
+      }
+
+      auto* halfEdge = new HalfEdge{vertices[origin]};
+      boundary.push_back(halfEdge);
+      if (!halfEdges.emplace(halfEdgeKey(origin, destination), halfEdge).second)
+      {
+        return std::nullopt;
+      }
+    }
+
+    result.m_faces.push_back(new Face{std::move(boundary), plane});
+  }
+
+  for (const auto& face : faces)
+  {
+    const auto& indices = std::get<1>(face);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      const auto origin = indices[i];
+      const auto destination = indices[(i + 1) % indices.size()];
+      const auto twin = halfEdges.find(halfEdgeKey(destination, origin));
+      if (twin == halfEdges.end())
+      {
+        return std::nullopt;
+      }
+
+      if (origin < destination)
+      {
+        result.m_edges.push_back(
+          new Edge{halfEdges[halfEdgeKey(origin, destination)], twin->second});
+      }
+    }
+  }
+
+  for (const auto* vertex : result.m_vertices)
+  {
+    if (!vertex->leaving())
+    {
+      return std::nullopt;
+    }
+  }
+
+  result.updateBounds();
+  return result;
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron<T, FP, VP>::Polyhedron(Polyhedron<T, FP, VP>&& other) noexcept
   : m_vertices(std::move(other.m_vertices))
@@ -546,6 +639,20 @@ const vm::bbox<T, 3>& Polyhedron<T, FP, VP>::bounds() const
   return m_bounds;
 }
 
+template <typename T, typename FP, typename VP>
+size_t Polyhedron<T, FP, VP>::memoryUsage() const
+{
+  auto halfEdgeCount = size_t(0);
+  for (const auto* face : m_faces)
+  {
+    halfEdgeCount += face->boundary().size();
+  }
+
+  return sizeof(Polyhedron) + m_vertices.size() * sizeof(Vertex)
+         + m_edges.size() * sizeof(Edge) + halfEdgeCount * sizeof(HalfEdge)
+         + m_faces.size() * sizeof(Face);
+}
+
 template <typename T, typename FP, typename VP>
 bool Polyhedron<T, FP, VP>::empty() const
 {
@@ -19,9 +19,14 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
 #include <kdl/intrusive_circular_list.h>
+#include <kdl/memory_pool.h>
+
+#include <cassert>
+#include <cstddef>
 
 namespace TrenchBroom
 {
@@ -65,6 +70,20 @@ Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
 {
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Vertex));
+  unused(size);
+  return kdl::memory_pool<sizeof(Vertex), alignof(Vertex)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr)
+{
+  kdl::memory_pool<sizeof(Vertex), alignof(Vertex)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const vm::vec<T, 3>& Polyhedron_Vertex<T, FP, VP>::position() const
 {
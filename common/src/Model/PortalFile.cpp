@@ -22,15 +22,23 @@
 #include "Error.h"
 #include "IO/DiskIO.h"
 
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/forward.h>
 #include <vecmath/polygon.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace TrenchBroom::Model
 {
@@ -53,97 +61,178 @@ bool canLoadPortalFile(const std::filesystem::path& path)
     .value();
 }
 
+namespace
+{
+const auto LineSplitter = std::string_view{"() \n\t\r"};
+
+std::vector<std::string_view> splitLines(const std::string_view str)
+{
+  auto lines = std::vector<std::string_view>{};
+  for (size_t first = 0; first < str.size();)
+  {
+    const auto last = std::min(str.find('\n', first), str.size());
+    lines.push_back(str.substr(first, last - first));
+    first = last + 1;
+  }
+  return lines;
+}
+
+std::vector<std::string_view> splitComponents(const std::string_view line)
+{
+  auto components = std::vector<std::string_view>{};
+  for (auto first = line.find_first_not_of(LineSplitter);
+       first != std::string_view::npos;)
+  {
+    const auto last = std::min(line.find_first_of(LineSplitter, first), line.size());
+    components.push_back(line.substr(first, last - first));
+    first = line.find_first_not_of(LineSplitter, last);
+  }
+  return components;
+}
+
+std::optional<size_t> parseCount(const std::string_view str)
+{
+  const auto components = splitComponents(str);
+  if (components.empty())
+  {
+    return std::nullopt;
+  }
+
+  auto* end = static_cast<char*>(nullptr);
+  const auto value = std::strtoul(std::string{components.front()}.c_str(), &end, 10);
+  return end != nullptr && *end == '\0' ? std::optional{size_t(value)} : std::nullopt;
+}
+
+std::optional<float> parseFloat(const std::string_view str)
+{
+  // the component is followed by a delimiter or the end of the buffer, so strtof stops
+  // at its end
+  auto* end = static_cast<char*>(nullptr);
+  const auto value = std::strtof(str.data(), &end);
+  return end == str.data() + str.size() ? std::optional{value} : std::nullopt;
+}
+
+std::optional<vm::polygon3f> parsePortal(
+  const std::string_view line, const bool prt1ForQ3)
+{
+  const auto components = splitComponents(line);
+  if (components.size() < 3)
+  {
+    return std::nullopt;
+  }
+
+  const auto numPoints = parseCount(components[0]);
+  if (!numPoints)
+  {
+    return std::nullopt;
+  }
+
+  auto verts = std::vector<vm::vec3f>{};
+  verts.reserve(*numPoints);
+
+  auto ptr = prt1ForQ3 ? 4u : 3u;
+  for (size_t j = 0; j < *numPoints; ++j)
+  {
+    if (ptr + 2 >= components.size())
+    {
+      return std::nullopt;
+    }
+
+    const auto x = parseFloat(components[ptr]);
+    const auto y = parseFloat(components[ptr + 1]);
+    const auto z = parseFloat(components[ptr + 2]);
+    if (!x || !y || !z)
+    {
+      return std::nullopt;
+    }
+
+    verts.emplace_back(*x, *y, *z);
+    ptr += 3;
+  }
+
+  return vm::polygon3f{std::move(verts)};
+}
+} // namespace
+
 Result<PortalFile> loadPortalFile(std::istream& stream)
 {
-  static const auto lineSplitter = "() \n\t\r";
+  // read the entire file into one buffer so that the portals can be parsed in parallel
+  const auto buffer = std::string{
+    std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+  const auto lines = splitLines(buffer);
+
+  auto currentLine = size_t(0);
+  auto headerIncomplete = false;
+  const auto nextLine = [&]() {
+    if (currentLine < lines.size())
+    {
+      return lines[currentLine++];
+    }
+    headerIncomplete = true;
+    return std::string_view{};
+  };
 
-  auto line = std::string{};
-  auto numPortals = 0ul;
+  auto numPortals = std::optional<size_t>{};
   auto prt1ForQ3 = false;
 
   // read header
-  std::getline(stream, line);
-  const auto formatCode = kdl::str_trim(line); // trim off any trailing \r
+  const auto formatCode =
+    kdl::str_trim(std::string{nextLine()}); // trim off any trailing \r
 
   if (formatCode == "PRT1")
   {
-    std::getline(stream, line); // number of leafs (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
-    const auto mark = stream.tellg();
-    std::getline(stream, line);
-    // If this line contains a single value, it is Q3-style PRT1 (value is
-    // number of solid faces -- will ignore). Otherwise is Q1/Q2 style and we
-    // will rewind the stream to process this line accordingly.
-    const auto componentsCheck = kdl::str_split(line, lineSplitter);
-    if (componentsCheck.size() == 1)
+    nextLine(); // number of leafs (ignored)
+    numPortals = parseCount(nextLine());
+
+    // If the next line contains a single value, it is Q3-style PRT1 (value is
+    // number of solid faces -- will ignore). Otherwise is Q1/Q2 style and the line is
+    // the first portal.
+    if (currentLine < lines.size() && splitComponents(lines[currentLine]).size() == 1)
     {
       prt1ForQ3 = true;
-    }
-    else
-    {
-      stream.seekg(mark);
+      ++currentLine;
     }
   }
   else if (formatCode == "PRT2")
   {
-    std::getline(stream, line); // number of leafs (ignored)
-    std::getline(stream, line); // number of clusters (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
+    nextLine(); // number of leafs (ignored)
+    nextLine(); // number of clusters (ignored)
+    numPortals = parseCount(nextLine());
   }
   else if (formatCode == "PRT1-AM")
   {
-    std::getline(stream, line); // number of clusters (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
-    std::getline(stream, line); // number of leafs (ignored)
+    nextLine(); // number of clusters (ignored)
+    numPortals = parseCount(nextLine());
+    nextLine(); // number of leafs (ignored)
   }
   else
   {
     return Error{"Unknown portal format: " + formatCode};
   }
 
-  if (!stream.good())
+  if (headerIncomplete || !numPortals)
   {
     return Error{"Error reading header"};
   }
 
-  // read portals
-  auto portals = std::vector<vm::polygon3f>{};
-  portals.reserve(numPortals);
-
-  for (size_t i = 0; i < numPortals; ++i)
+  if (lines.size() - currentLine < *numPortals)
   {
-    std::getline(stream, line);
-    const auto components = kdl::str_split(line, lineSplitter);
-
-    if (!stream.good() || components.size() < 3)
-    {
-      return Error{"Error reading portal"};
-    }
+    return Error{"Error reading portal"};
+  }
 
-    auto verts = std::vector<vm::vec3f>{};
-    auto ptr = prt1ForQ3 ? 4u : 3u;
-    const int numPoints = std::stoi(components.at(0));
-    for (int j = 0; j < numPoints; ++j)
-    {
-      if (ptr + 2 >= components.size())
-      {
-        return Error{"Error reading portal"};
-      }
-
-      verts.emplace_back(
-        std::stof(components.at(ptr)),
-        std::stof(components.at(ptr + 1)),
-        std::stof(components.at(ptr + 2)));
-      ptr += 3;
-    }
+  // read portals
+  auto portals = std::vector<std::optional<vm::polygon3f>>(*numPortals);
+  kdl::parallel_for(*numPortals, [&](const size_t i) {
+    portals[i] = parsePortal(lines[currentLine + i], prt1ForQ3);
+  });
 
-    portals.emplace_back(std::move(verts));
+  if (std::any_of(portals.begin(), portals.end(), [](const auto& p) { return !p; }))
+  {
+    return Error{"Error reading portal"};
   }
-  return PortalFile{std::move(portals)};
-}
 
+  return PortalFile{kdl::vec_transform(
+    std::move(portals), [](auto&& portal) { return std::move(*portal); })};
+}
 
 } // namespace TrenchBroom::Model
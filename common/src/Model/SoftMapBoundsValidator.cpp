@@ -83,5 +83,26 @@ void SoftMapBoundsValidator::doValidate(
 {
   validateInternal(kdl::mem_lock(m_game), m_world, patchNode, issues);
 }
+
+void SoftMapBoundsValidator::doValidate(
+  const std::vector<BrushNode*>& brushNodes,
+  std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const
+{
+  // extract the bounds from the world once for the entire batch
+  const auto bounds = kdl::mem_lock(m_game)->extractSoftMapBounds(m_world.entity());
+  if (!bounds.bounds)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    if (!bounds.bounds->contains(brushNodes[i]->logicalBounds()))
+    {
+      issues[i].push_back(std::make_unique<Issue>(
+        Type, *brushNodes[i], "Object is out of soft map bounds"));
+    }
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
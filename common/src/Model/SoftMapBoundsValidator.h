@@ -51,6 +51,9 @@ private:
     BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues) const override;
   void doValidate(
     PatchNode& patchNode, std::vector<std::unique_ptr<Issue>>& issues) const override;
+  void doValidate(
+    const std::vector<BrushNode*>& brushNodes,
+    std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const override;
 };
 } // namespace Model
 } // namespace TrenchBroom
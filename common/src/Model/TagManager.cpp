@@ -24,6 +24,7 @@
 #include "Model/TagType.h"
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 
@@ -31,6 +32,15 @@ namespace TrenchBroom
 {
 namespace Model
 {
+namespace
+{
+size_t nextGeneration()
+{
+  static auto generation = std::atomic<size_t>{0};
+  return ++generation;
+}
+} // namespace
+
 bool TagManager::TagCmp::operator()(const SmartTag& lhs, const SmartTag& rhs) const
 {
   return lhs.name() < rhs.name();
@@ -51,6 +61,16 @@ bool TagManager::TagCmp::operator()(const std::string& lhs, const std::string& r
   return lhs < rhs;
 }
 
+TagManager::TagManager()
+  : m_generation{nextGeneration()}
+{
+}
+
+size_t TagManager::generation() const
+{
+  return m_generation;
+}
+
 const std::vector<SmartTag>& TagManager::smartTags() const
 {
   return m_smartTags.get_data();
@@ -110,11 +130,13 @@ void TagManager::registerSmartTags(const std::vector<SmartTag>& tags)
 
     it->setIndex(nextIndex);
   }
+  m_generation = nextGeneration();
 }
 
 void TagManager::clearSmartTags()
 {
   m_smartTags.clear();
+  m_generation = nextGeneration();
 }
 
 void TagManager::updateTags(Taggable& taggable) const
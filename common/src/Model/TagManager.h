@@ -44,8 +44,19 @@ private:
   };
 
   kdl::vector_set<SmartTag, TagCmp> m_smartTags;
+  size_t m_generation;
 
 public:
+  TagManager();
+
+  /**
+   * Returns a number that identifies the smart tags currently registered with this
+   * manager. It is unique among all tag managers and changes whenever smart tags are
+   * registered or cleared, so it can be used to detect whether tags that were computed
+   * earlier are still up to date.
+   */
+  size_t generation() const;
+
   /**
    * Returns a vector containing all smart tags registered with this manager.
    */
@@ -135,13 +135,14 @@ void TextureTagMatcher::appendToStream(std::ostream& str) const
 }
 
 TextureNameTagMatcher::TextureNameTagMatcher(const std::string& pattern)
-  : m_pattern(pattern)
+  : m_pattern{pattern}
+  , m_matchLastComponent{pattern.find('/') == std::string::npos}
 {
 }
 
 std::unique_ptr<TagMatcher> TextureNameTagMatcher::clone() const
 {
-  return std::make_unique<TextureNameTagMatcher>(m_pattern);
+  return std::make_unique<TextureNameTagMatcher>(m_pattern.pattern());
 }
 
 bool TextureNameTagMatcher::matches(const Taggable& taggable) const
@@ -157,7 +158,7 @@ bool TextureNameTagMatcher::matches(const Taggable& taggable) const
 void TextureNameTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "TextureNameTagMatcher"
-                          << "m_pattern" << m_pattern;
+                          << "m_pattern" << m_pattern.pattern();
 }
 
 bool TextureNameTagMatcher::matchesTexture(const Assets::Texture* texture) const
@@ -171,9 +172,7 @@ bool TextureNameTagMatcher::matchesTexture(const Assets::Texture* texture) const
 
 bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) const
 {
-  // If the match pattern doesn't contain a slash, match against
-  // only the last component of the texture name.
-  if (m_pattern.find('/') == std::string::npos)
+  if (m_matchLastComponent)
   {
     const auto pos = textureName.find_last_of('/');
     if (pos != std::string::npos)
@@ -182,7 +181,7 @@ bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) con
     }
   }
 
-  return kdl::ci::str_matches_glob(textureName, m_pattern);
+  return m_pattern.matches(textureName);
 }
 
 SurfaceParmTagMatcher::SurfaceParmTagMatcher(const std::string& parameter)
@@ -387,14 +386,14 @@ std::unique_ptr<TagMatcher> SurfaceFlagsTagMatcher::clone() const
 
 EntityClassNameTagMatcher::EntityClassNameTagMatcher(
   const std::string& pattern, const std::string& texture)
-  : m_pattern(pattern)
+  : m_pattern{pattern}
   , m_texture(texture)
 {
 }
 
 std::unique_ptr<TagMatcher> EntityClassNameTagMatcher::clone() const
 {
-  return std::make_unique<EntityClassNameTagMatcher>(m_pattern, m_texture);
+  return std::make_unique<EntityClassNameTagMatcher>(m_pattern.pattern(), m_texture);
 }
 
 bool EntityClassNameTagMatcher::matches(const Taggable& taggable) const
@@ -512,12 +511,13 @@ bool EntityClassNameTagMatcher::canDisable() const
 void EntityClassNameTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "EntityClassNameMatcher"
-                          << "m_pattern" << m_pattern << "m_texture" << m_texture;
+                          << "m_pattern" << m_pattern.pattern() << "m_texture"
+                          << m_texture;
 }
 
 bool EntityClassNameTagMatcher::matchesClassname(const std::string& classname) const
 {
-  return kdl::ci::str_matches_glob(classname, m_pattern);
+  return m_pattern.matches(classname);
 }
 } // namespace Model
 } // namespace TrenchBroom
@@ -23,6 +23,7 @@
 #include "Model/Tag.h"
 #include "Model/TagVisitor.h"
 
+#include <kdl/string_compare.h>
 #include <kdl/vector_set.h>
 
 #include <functional>
@@ -98,7 +99,10 @@ private:
 class TextureNameTagMatcher : public TextureTagMatcher
 {
 private:
-  std::string m_pattern;
+  kdl::ci::glob_matcher m_pattern;
+  // if the pattern doesn't contain a slash, only the last component of a texture name
+  // is matched
+  bool m_matchLastComponent;
 
 public:
   explicit TextureNameTagMatcher(const std::string& pattern);
@@ -175,7 +179,7 @@ public:
 class EntityClassNameTagMatcher : public TagMatcher
 {
 private:
-  std::string m_pattern;
+  kdl::ci::glob_matcher m_pattern;
   /**
    * The texture to set when this tag is enabled.
    */
@@ -105,7 +105,17 @@ vm::vec2f TexCoordSystem::getTexCoords(
   const BrushFaceAttributes& attribs,
   const vm::vec2f& textureSize) const
 {
-  return doGetTexCoords(point, attribs, textureSize);
+  return texCoordProjection(attribs, textureSize)(point);
+}
+
+TexCoordProjection TexCoordSystem::texCoordProjection(
+  const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const
+{
+  return TexCoordProjection{
+    safeScaleAxis(getXAxis(), attribs.scale().x()),
+    safeScaleAxis(getYAxis(), attribs.scale().y()),
+    attribs.offset(),
+    textureSize};
 }
 
 void TexCoordSystem::setRotation(
@@ -52,6 +52,26 @@ private:
   friend class ParaxialTexCoordSystem;
 };
 
+/**
+ * Maps points to texture coordinates using the scaled texture axes, offset and texture
+ * size of a face. Use this instead of TexCoordSystem::getTexCoords when computing the
+ * texture coordinates of many points, e.g. all vertices of a face, because the texture
+ * axes are only scaled once and no virtual calls are made per point.
+ */
+struct TexCoordProjection
+{
+  vm::vec3 xAxis;
+  vm::vec3 yAxis;
+  vm::vec2f offset;
+  vm::vec2f textureSize;
+
+  vm::vec2f operator()(const vm::vec3& point) const
+  {
+    return (vm::vec2f(vm::dot(point, xAxis), vm::dot(point, yAxis)) + offset)
+           / textureSize;
+  }
+};
+
 enum class WrapStyle
 {
   Projection,
@@ -86,6 +106,8 @@ public:
     const vm::vec3& point,
     const BrushFaceAttributes& attribs,
     const vm::vec2f& textureSize) const;
+  TexCoordProjection texCoordProjection(
+    const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const;
 
   void setRotation(const vm::vec3& normal, float oldAngle, float newAngle);
   void transform(
@@ -148,10 +170,6 @@ private:
   virtual void doResetTextureAxesToParallel(const vm::vec3& normal, float angle) = 0;
 
   virtual bool isRotationInverted(const vm::vec3& normal) const = 0;
-  virtual vm::vec2f doGetTexCoords(
-    const vm::vec3& point,
-    const BrushFaceAttributes& attribs,
-    const vm::vec2f& textureSize) const = 0;
 
   virtual void doSetRotation(const vm::vec3& normal, float oldAngle, float newAngle) = 0;
   virtual void doTransform(
@@ -64,6 +64,14 @@ void Validator::validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues
     [&](PatchNode* patchNode) { doValidate(*patchNode, issues); }));
 }
 
+void Validator::validate(
+  const std::vector<BrushNode*>& brushNodes,
+  std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const
+{
+  assert(brushNodes.size() == issues.size());
+  doValidate(brushNodes, issues);
+}
+
 Validator::Validator(const IssueType type, const std::string& description)
   : m_type{type}
   , m_description{description}
@@ -90,5 +98,14 @@ void Validator::doValidate(
 void Validator::doValidate(BrushNode&, std::vector<std::unique_ptr<Issue>>&) const {}
 void Validator::doValidate(PatchNode&, std::vector<std::unique_ptr<Issue>>&) const {}
 void Validator::doValidate(EntityNodeBase&, std::vector<std::unique_ptr<Issue>>&) const {}
+void Validator::doValidate(
+  const std::vector<BrushNode*>& brushNodes,
+  std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const
+{
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    doValidate(*brushNodes[i], issues[i]);
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
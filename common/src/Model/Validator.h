@@ -56,6 +56,15 @@ public:
 
   void validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const;
 
+  /**
+   * Validates a batch of brush nodes and appends the issues found for brushNodes[i] to
+   * issues[i]. Batches of the same collection are validated concurrently, so
+   * implementations must only read the given nodes and must not modify shared state.
+   */
+  void validate(
+    const std::vector<BrushNode*>& brushNodes,
+    std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const;
+
 protected:
   Validator(IssueType type, const std::string& description);
   void addQuickFix(IssueQuickFix quickFix);
@@ -75,6 +84,14 @@ private:
     PatchNode& patchNode, std::vector<std::unique_ptr<Issue>>& issues) const;
   virtual void doValidate(
     EntityNodeBase& node, std::vector<std::unique_ptr<Issue>>& issues) const;
+
+  /**
+   * Validates each of the given brush nodes individually. Override to share work
+   * between the nodes of a batch.
+   */
+  virtual void doValidate(
+    const std::vector<BrushNode*>& brushNodes,
+    std::vector<std::vector<std::unique_ptr<Issue>>>& issues) const;
 };
 } // namespace Model
 } // namespace TrenchBroom
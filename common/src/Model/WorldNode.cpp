@@ -21,31 +21,74 @@
 
 #include "Ensure.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushGeometryStore.h"
 #include "Model/BrushNode.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
+#include "Model/Hit.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 #include "Model/Validator.h"
 #include "Model/ValidatorRegistry.h"
 #include "octree.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox_io.h>
 
+#include <cassert>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Model
 {
+namespace
+{
+/**
+ * Collects the given node and its descendants that belong in the node tree along with
+ * their bounds. `node` may be the root of a subtree that is not added to the node tree
+ * itself, e.g. a group, but some of its descendants may be.
+ */
+void collectNodeTreeItems(Node* node, std::vector<std::tuple<vm::bbox3, Node*>>& items)
+{
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      items.emplace_back(entity->physicalBounds(), entity);
+      entity->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brush) { items.emplace_back(brush->physicalBounds(), brush); },
+    [&](PatchNode* patch) { items.emplace_back(patch->physicalBounds(), patch); }));
+}
+
+template <typename F>
+void visitBrushNodes(const Node& node, const F& f)
+{
+  node.accept(kdl::overload(
+    [](auto&& thisLambda, const WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, const LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, const GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, const EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+    },
+    [&](const BrushNode* brush) { f(*brush); },
+    [](const PatchNode*) {}));
+}
+} // namespace
+
 WorldNode::WorldNode(
   EntityPropertyConfig entityPropertyConfig, Entity entity, const MapFormat mapFormat)
   : m_entityPropertyConfig{std::move(entityPropertyConfig)}
@@ -53,7 +96,7 @@ WorldNode::WorldNode(
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
-  , m_nodeTree{std::make_unique<NodeTree>(256.0)}
+  , m_nodeTree{std::make_unique<NodeTree>(256.0, true)}
   , m_updateNodeTree{true}
 {
   entity.addOrUpdateProperty(
@@ -88,9 +131,25 @@ MapFormat WorldNode::mapFormat() const
 
 const WorldNode::NodeTree& WorldNode::nodeTree() const
 {
+  flushDeferredNodeTreeUpdates();
   return *m_nodeTree;
 }
 
+void WorldNode::pickNearest(
+  const EditorContext& editorContext,
+  const vm::ray3& ray,
+  const HitFilter& filter,
+  PickResult& pickResult)
+{
+  flushDeferredNodeTreeUpdates();
+  m_nodeTree->visit_intersectors_nearest_first(ray, [&](auto* node) {
+    node->pick(editorContext, ray, pickResult);
+
+    const auto& hit = pickResult.first(filter);
+    return hit.isMatch() ? hit.distance() : std::numeric_limits<FloatType>::infinity();
+  });
+}
+
 LayerNode* WorldNode::defaultLayer()
 {
   ensure(m_defaultLayer != nullptr, "defaultLayer is null");
@@ -248,10 +307,72 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
+  m_nodesWithDeferredTreeUpdates.clear();
   m_nodeTree->clear();
+  m_nodeTree->insert(kdl::vec_transform(
+    nodes, [](auto* node) { return std::tuple{node->physicalBounds(), node}; }));
+}
+
+void WorldNode::addToNodeTree(const std::vector<Node*>& nodes)
+{
+  auto nodeTreeItems = std::vector<std::tuple<vm::bbox3, Node*>>{};
   for (auto* node : nodes)
   {
-    m_nodeTree->insert(node->physicalBounds(), node);
+    collectNodeTreeItems(node, nodeTreeItems);
+  }
+  m_nodeTree->insert(std::move(nodeTreeItems));
+}
+
+void WorldNode::deferNodeTreeUpdates()
+{
+  ++m_nodeTreeUpdateDeferrals;
+}
+
+void WorldNode::applyDeferredNodeTreeUpdates()
+{
+  assert(m_nodeTreeUpdateDeferrals > 0u);
+  if (m_nodeTreeUpdateDeferrals > 0u && --m_nodeTreeUpdateDeferrals == 0u)
+  {
+    flushDeferredNodeTreeUpdates();
+  }
+}
+
+const BrushGeometryStore& WorldNode::brushGeometryStore() const
+{
+  if (!m_brushGeometryStore)
+  {
+    m_brushGeometryStore = std::make_unique<BrushGeometryStore>();
+    visitBrushNodes(
+      *this, [&](const BrushNode& brush) { m_brushGeometryStore->addBrush(brush); });
+  }
+  return *m_brushGeometryStore;
+}
+
+void WorldNode::flushDeferredNodeTreeUpdates() const
+{
+  if (!m_nodesWithDeferredTreeUpdates.empty())
+  {
+    auto nodeTreeItems = std::vector<std::tuple<vm::bbox3, Node*>>{};
+    nodeTreeItems.reserve(m_nodesWithDeferredTreeUpdates.size());
+    for (auto* node : m_nodesWithDeferredTreeUpdates)
+    {
+      nodeTreeItems.emplace_back(node->physicalBounds(), node);
+    }
+    m_nodesWithDeferredTreeUpdates.clear();
+
+    m_nodeTree->update(std::move(nodeTreeItems));
+  }
+}
+
+void WorldNode::updateNodeTree(Node* node)
+{
+  if (m_nodeTreeUpdateDeferrals > 0u)
+  {
+    m_nodesWithDeferredTreeUpdates.insert(node);
+  }
+  else
+  {
+    m_nodeTree->update(node->physicalBounds(), node);
   }
 }
 
@@ -353,16 +474,15 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
   // being connected and add it or any descendants that need to be added.
   if (m_updateNodeTree)
   {
-    node->accept(kdl::overload(
-      [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, EntityNode* entity) {
-        m_nodeTree->insert(entity->physicalBounds(), entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](BrushNode* brush) { m_nodeTree->insert(brush->physicalBounds(), brush); },
-      [&](PatchNode* patch) { m_nodeTree->insert(patch->physicalBounds(), patch); }));
+    auto nodeTreeItems = std::vector<std::tuple<vm::bbox3, Node*>>{};
+    collectNodeTreeItems(node, nodeTreeItems);
+    m_nodeTree->insert(std::move(nodeTreeItems));
+  }
+
+  if (m_brushGeometryStore)
+  {
+    visitBrushNodes(
+      *node, [&](const BrushNode& brush) { m_brushGeometryStore->addBrush(brush); });
   }
 
   const auto updatePersistentId = [&](auto* persistentNode) {
@@ -399,10 +519,19 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
 
 void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
 {
-  if (m_updateNodeTree)
+  if (m_brushGeometryStore)
+  {
+    visitBrushNodes(
+      *node, [&](const BrushNode& brush) { m_brushGeometryStore->removeBrush(brush); });
+  }
+
+  // the removed nodes must not remain in the deferred updates even if node tree updates
+  // are disabled
+  if (m_updateNodeTree || !m_nodesWithDeferredTreeUpdates.empty())
   {
     const auto doRemove = [&](auto* nodeToRemove) {
-      if (!m_nodeTree->remove(nodeToRemove))
+      m_nodesWithDeferredTreeUpdates.erase(nodeToRemove);
+      if (m_updateNodeTree && !m_nodeTree->remove(nodeToRemove))
       {
         auto str = std::stringstream();
         str << "Node not found with bounds " << nodeToRemove->physicalBounds() << ": "
@@ -426,15 +555,28 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
 {
+  // brushes notify this whenever their geometry changes, even if their bounds stay
+  // the same
+  if (m_brushGeometryStore)
+  {
+    node->accept(kdl::overload(
+      [](WorldNode*) {},
+      [](LayerNode*) {},
+      [](GroupNode*) {},
+      [](EntityNode*) {},
+      [&](BrushNode* brush) { m_brushGeometryStore->updateBrush(*brush); },
+      [](PatchNode*) {}));
+  }
+
   if (m_updateNodeTree)
   {
     node->accept(kdl::overload(
       [](WorldNode*) {},
       [](LayerNode*) {},
       [](GroupNode*) {},
-      [&](EntityNode* entity) { m_nodeTree->update(entity->physicalBounds(), entity); },
-      [&](BrushNode* brush) { m_nodeTree->update(brush->physicalBounds(), brush); },
-      [&](PatchNode* patch) { m_nodeTree->update(patch->physicalBounds(), patch); }));
+      [&](EntityNode* entity) { updateNodeTree(entity); },
+      [&](BrushNode* brush) { updateNodeTree(brush); },
+      [&](PatchNode* patch) { updateNodeTree(patch); }));
   }
 }
 
@@ -446,6 +588,7 @@ bool WorldNode::doSelectable() const
 void WorldNode::doPick(
   const EditorContext& editorContext, const vm::ray3& ray, PickResult& pickResult)
 {
+  flushDeferredNodeTreeUpdates();
   for (auto* node : m_nodeTree->find_intersectors(ray))
   {
     node->pick(editorContext, ray, pickResult);
@@ -454,9 +597,40 @@ void WorldNode::doPick(
 
 void WorldNode::doFindNodesContaining(const vm::vec3& point, std::vector<Node*>& result)
 {
-  for (auto* node : m_nodeTree->find_containers(point))
+  static constexpr auto ChunkSize = size_t(64);
+
+  flushDeferredNodeTreeUpdates();
+
+  // The node tree contains every descendant that can contain a point, so each candidate
+  // only needs to test itself and not its children. The candidates are independent, so
+  // they can be tested in parallel.
+  const auto candidates = m_nodeTree->find_containers(point);
+  const auto containsPoint = kdl::vec_parallel_transform(
+    candidates,
+    [&](const Node* node) {
+      return node->accept(kdl::overload(
+        [](const WorldNode*) { return false; },
+        [](const LayerNode*) { return false; },
+        [&](const GroupNode* groupNode) {
+          return groupNode->logicalBounds().contains(point);
+        },
+        [&](const EntityNode* entityNode) {
+          return !entityNode->hasChildren()
+                 && entityNode->logicalBounds().contains(point);
+        },
+        [&](const BrushNode* brushNode) {
+          return brushNode->brush().containsPoint(point);
+        },
+        [](const PatchNode*) { return false; }));
+    },
+    ChunkSize);
+
+  for (size_t i = 0; i < candidates.size(); ++i)
   {
-    node->findNodesContaining(point, result);
+    if (containsPoint[i])
+    {
+      result.push_back(candidates[i]);
+    }
   }
 }
 
@@ -23,6 +23,7 @@
 #include "Macros.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
+#include "Model/HitFilter.h"
 #include "Model/IdType.h"
 #include "Model/MapFormat.h"
 #include "Model/Node.h"
@@ -31,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -40,6 +42,7 @@ class octree;
 
 namespace Model
 {
+class BrushGeometryStore;
 class EntityNodeIndex;
 class IssueQuickFix;
 enum class MapFormat;
@@ -59,9 +62,13 @@ private:
   using NodeTree = octree<FloatType, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
+  size_t m_nodeTreeUpdateDeferrals = 0;
+  mutable std::unordered_set<Node*> m_nodesWithDeferredTreeUpdates;
 
   IdType m_nextPersistentId = 1;
 
+  mutable std::unique_ptr<BrushGeometryStore> m_brushGeometryStore;
+
 public:
   WorldNode(
     EntityPropertyConfig entityPropertyConfig, Entity entity, MapFormat mapFormat);
@@ -78,6 +85,22 @@ public:
 
   const NodeTree& nodeTree() const;
 
+  /**
+   * Picks the nodes hit by the given ray in the order of their distance from the ray
+   * origin, and stops once no remaining node can yield a hit that is closer than the
+   * first hit matching the given filter.
+   *
+   * Afterwards, pickResult.first(filter) is the same hit that a full pick would have
+   * found, but pickResult may not contain all other hits. The given pick result must be
+   * ordered by distance and the hits matching the given filter must have no error, e.g.
+   * brush or patch hits.
+   */
+  void pickNearest(
+    const EditorContext& editorContext,
+    const vm::ray3& ray,
+    const HitFilter& filter,
+    PickResult& pickResult);
+
 public: // layer management
   LayerNode* defaultLayer();
 
@@ -142,7 +165,32 @@ public: // node tree bulk updating
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Adds the given nodes and their descendants to the node tree all at once. Call this
+   * after adding many nodes to this world while node tree updates were disabled.
+   */
+  void addToNodeTree(const std::vector<Node*>& nodes);
+
+  /**
+   * Defers updating the node tree when the bounds of nodes change until
+   * applyDeferredNodeTreeUpdates has been called once for every call to this function.
+   * The deferred updates are then applied all at once. They are also applied before the
+   * node tree is queried, so queries always see the current bounds.
+   */
+  void deferNodeTreeUpdates();
+  void applyDeferredNodeTreeUpdates();
+
+public: // brush geometry
+  /**
+   * Returns a compact copy of the geometry of all brushes in this world for bulk
+   * queries. The store is created on first access and is then kept up to date as
+   * brushes are added, removed or changed.
+   */
+  const BrushGeometryStore& brushGeometryStore() const;
+
 private:
+  void flushDeferredNodeTreeUpdates() const;
+  void updateNodeTree(Node* node);
   void invalidateAllIssues();
 
 private: // implement Node interface
@@ -26,6 +26,7 @@
 #include "Macros.h"
 #include "View/KeyboardShortcut.h"
 
+#include <cstddef>
 #include <filesystem>
 #include <optional>
 
@@ -125,6 +126,7 @@ private:
   T m_value;
   bool m_valid;
   bool m_readOnly;
+  size_t m_generation;
 
 public:
   Preference(
@@ -134,6 +136,7 @@ public:
     , m_value{m_defaultValue}
     , m_valid{false}
     , m_readOnly{readOnly}
+    , m_generation{0}
   {
   }
 
@@ -162,6 +165,14 @@ public: // PreferenceManager private
 
   void setValid(const bool _valid) override { m_valid = _valid; }
 
+  /**
+   * The generation of the preference manager in which this preference was last
+   * validated, see PreferenceManager::get().
+   */
+  size_t generation() const { return m_generation; }
+
+  void setGeneration(const size_t generation) { m_generation = generation; }
+
   const T& value() const
   {
     assert(m_valid);
@@ -48,6 +48,7 @@ namespace TrenchBroom
 
 std::unique_ptr<PreferenceManager> PreferenceManager::m_instance;
 bool PreferenceManager::m_initialized = false;
+size_t PreferenceManager::m_generation = 1;
 
 PreferenceManager& PreferenceManager::instance()
 {
@@ -291,6 +292,7 @@ void AppPreferenceManager::invalidatePreferences()
   // Force all currently known Preference<T> objects to deserialize from m_cache next
   // time they are accessed Note, because new Preference<T> objects can be created at
   // runtime, we need this sort of lazy loading system.
+  ++m_generation;
   for (auto* pref : Preferences::staticPreferences())
   {
     pref->setValid(false);
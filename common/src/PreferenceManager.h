@@ -55,6 +55,12 @@ private:
   static bool m_initialized;
 
 protected:
+  /**
+   * Incremented whenever preferences are invalidated or the instance is replaced. A
+   * preference that was validated in the current generation is read directly.
+   */
+  static size_t m_generation;
+
   std::map<std::filesystem::path, std::unique_ptr<PreferenceBase>> m_dynamicPreferences;
 
 public:
@@ -68,12 +74,14 @@ public:
   {
     m_instance = std::make_unique<T>();
     m_initialized = false;
+    ++m_generation;
   }
 
   static void destroyInstance()
   {
     m_instance.reset();
     m_initialized = false;
+    ++m_generation;
   }
 
   template <typename T>
@@ -99,12 +107,18 @@ public:
   }
 
   /**
-   * Public API for getting the value of a preference.
+   * Public API for getting the value of a preference. A preference is only validated on
+   * the first access after it was invalidated; afterwards, its value is returned
+   * directly.
    */
   template <typename T>
   const T& get(Preference<T>& preference)
   {
-    validatePreference(preference);
+    if (preference.generation() != m_generation)
+    {
+      validatePreference(preference);
+      preference.setGeneration(m_generation);
+    }
     return preference.value();
   }
 
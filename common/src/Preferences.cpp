@@ -60,6 +60,16 @@ Preference<Color> PortalFileBorderColor(
 Preference<Color> PortalFileFillColor(
   "Renderer/Colors/Portal file fill", Color(1.0f, 0.4f, 0.4f, 0.2f));
 Preference<bool> ShowFPS("Renderer/Show FPS", false);
+Preference<bool> ShowRenderProfile("Renderer/Show render profile", false);
+Preference<bool> ShowFrameTelemetry("Renderer/Show frame telemetry", false);
+Preference<bool> LogFrameTelemetry("Renderer/Log frame telemetry", false);
+
+Preference<std::filesystem::path>& RenderProfileFile()
+{
+  static Preference<std::filesystem::path> renderProfileFile(
+    "Renderer/Render profile file", std::filesystem::path{});
+  return renderProfileFile;
+}
 
 Preference<Color>& axisColor(vm::axis::type axis)
 {
@@ -187,9 +197,25 @@ Preference<Color> GridColor2D("Rendere/Grid/Color2D", Color(0.8f, 0.8f, 0.8f, 0.
 Preference<int> TextureMinFilter("Renderer/Texture mode min filter", 0x2700);
 Preference<int> TextureMagFilter("Renderer/Texture mode mag filter", 0x2600);
 Preference<bool> EnableMSAA("Renderer/Enable multisampling", true);
+Preference<bool> EnableEntityLod("Renderer/Enable entity LOD", true);
+Preference<int> EntityLodModelSize("Renderer/Entity LOD model size", 8);
+Preference<int> EntityLodBoundsSize("Renderer/Entity LOD bounds size", 2);
+Preference<int> EntityLodLabelSize("Renderer/Entity LOD label size", 16);
+Preference<bool> EnableOcclusionCulling("Renderer/Enable occlusion culling", false);
+Preference<int> EntityModelMemoryBudget("Renderer/Entity model memory budget", 512);
+Preference<bool> CompressTextures("Renderer/Compress textures", false);
+Preference<bool> GenerateMipmaps("Renderer/Generate mipmaps", false);
 
 Preference<bool> TextureLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 1024);
+
+Preference<std::filesystem::path>& TextureCacheDirectory()
+{
+  static Preference<std::filesystem::path> cacheDirectory(
+    "Renderer/Texture cache directory", std::filesystem::path{});
+  return cacheDirectory;
+}
 
 Preference<std::filesystem::path>& RendererFontPath()
 {
@@ -329,6 +355,10 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &PortalFileBorderColor,
     &PortalFileFillColor,
     &ShowFPS,
+    &ShowRenderProfile,
+    &ShowFrameTelemetry,
+    &LogFrameTelemetry,
+    &RenderProfileFile(),
     &CompassBackgroundColor,
     &CompassBackgroundOutlineColor,
     &CompassAxisOutlineColor,
@@ -382,8 +412,18 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &GridColor2D,
     &TextureMinFilter,
     &TextureMagFilter,
+    &EnableEntityLod,
+    &EntityLodModelSize,
+    &EntityLodBoundsSize,
+    &EntityLodLabelSize,
+    &EnableOcclusionCulling,
+    &EntityModelMemoryBudget,
+    &CompressTextures,
+    &GenerateMipmaps,
+    &TextureCacheDirectory(),
     &TextureLock,
     &UVLock,
+    &UndoMemoryBudget,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
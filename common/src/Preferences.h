@@ -54,6 +54,13 @@ extern Preference<Color> PointFileColor;
 extern Preference<Color> PortalFileBorderColor;
 extern Preference<Color> PortalFileFillColor;
 extern Preference<bool> ShowFPS;
+extern Preference<bool> ShowRenderProfile;
+extern Preference<bool> ShowFrameTelemetry;
+// if true, the frame telemetry is written to the console once per second
+extern Preference<bool> LogFrameTelemetry;
+
+// if not empty, the render profile is appended to this file as CSV
+Preference<std::filesystem::path>& RenderProfileFile();
 
 Preference<Color>& axisColor(vm::axis::type axis);
 
@@ -129,9 +136,33 @@ extern Preference<int> TextureMinFilter;
 extern Preference<int> TextureMagFilter;
 extern Preference<bool> EnableMSAA;
 
+// in pixels, entities smaller than these sizes are rendered with less detail in 3D views
+extern Preference<bool> EnableEntityLod;
+extern Preference<int> EntityLodModelSize;
+extern Preference<int> EntityLodBoundsSize;
+extern Preference<int> EntityLodLabelSize;
+
+// skip brushes and entity models that are hidden behind large brushes in 3D views
+extern Preference<bool> EnableOcclusionCulling;
+
+// in MiB
+extern Preference<int> EntityModelMemoryBudget;
+
+extern Preference<bool> CompressTextures;
+
+// keep only the first mip level of uncompressed textures and let the driver generate
+// the others
+extern Preference<bool> GenerateMipmaps;
+
+// if empty, decoded textures are not cached
+Preference<std::filesystem::path>& TextureCacheDirectory();
+
 extern Preference<bool> TextureLock;
 extern Preference<bool> UVLock;
 
+// in MiB
+extern Preference<int> UndoMemoryBudget;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
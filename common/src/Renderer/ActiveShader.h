@@ -45,6 +45,17 @@ public:
   {
     m_program.set(name, value);
   }
+
+  GLint findUniformLocation(const std::string& name) const
+  {
+    return m_program.findUniformLocation(name);
+  }
+
+  template <class T>
+  void set(const GLint location, const T& value)
+  {
+    m_program.set(location, value);
+  }
 };
 } // namespace Renderer
 } // namespace TrenchBroom
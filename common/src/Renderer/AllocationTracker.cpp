@@ -204,6 +204,8 @@ AllocationTracker::Block* AllocationTracker::allocate(const size_t needed)
   block->nextOfSameSize = nullptr;
   block->prevOfSameSize = nullptr;
 
+  m_usedSize += needed;
+
   if (block->size == needed)
   {
     // lucky case: exact size. we're done
@@ -257,6 +259,9 @@ void AllocationTracker::free(Block* block)
   assert(block->prevOfSameSize == nullptr);
   assert(block->nextOfSameSize == nullptr);
 
+  assert(m_usedSize >= block->size);
+  m_usedSize -= block->size;
+
   Block* left = block->left;
   Block* right = block->right;
 
@@ -362,6 +367,7 @@ void AllocationTracker::free(Block* block)
 
 AllocationTracker::AllocationTracker(const Index initial_capacity)
   : m_capacity(0)
+  , m_usedSize(0)
   , m_leftmostBlock(nullptr)
   , m_rightmostBlock(nullptr)
   , m_recycledBlockList(nullptr)
@@ -375,6 +381,7 @@ AllocationTracker::AllocationTracker(const Index initial_capacity)
 
 AllocationTracker::AllocationTracker()
   : m_capacity(0)
+  , m_usedSize(0)
   , m_leftmostBlock(nullptr)
   , m_rightmostBlock(nullptr)
   , m_recycledBlockList(nullptr)
@@ -486,6 +493,105 @@ bool AllocationTracker::hasAllocations() const
   return false;
 }
 
+AllocationTracker::Index AllocationTracker::usedSize() const
+{
+  return m_usedSize;
+}
+
+double AllocationTracker::fragmentation() const
+{
+  const Index freeSize = m_capacity - m_usedSize;
+  if (freeSize == 0)
+  {
+    return 0.0;
+  }
+
+  return 1.0
+         - static_cast<double>(largestPossibleAllocation())
+             / static_cast<double>(freeSize);
+}
+
+std::vector<AllocationTracker::Move> AllocationTracker::compact(const size_t maxMoves)
+{
+  checkInvariants();
+
+  auto moves = std::vector<Move>{};
+
+  // adjacent free blocks are always merged, so a free block that is not the rightmost
+  // block is followed by a used block
+  Block* hole = m_leftmostBlock;
+  while (hole != nullptr && !hole->free)
+  {
+    hole = hole->right;
+  }
+
+  while (hole != nullptr && hole->right != nullptr && moves.size() < maxMoves)
+  {
+    assert(hole->free);
+
+    Block* used = hole->right;
+    assert(!used->free);
+
+    Block* left = hole->left;
+    Block* right = used->right;
+
+    // swap the used block and the hole, the hole keeps its size and stays in its bin
+    moves.push_back(Move{used, used->pos});
+    used->pos = hole->pos;
+    hole->pos = used->pos + used->size;
+
+    used->left = left;
+    used->right = hole;
+    hole->left = used;
+    hole->right = right;
+
+    if (left == nullptr)
+    {
+      assert(m_leftmostBlock == hole);
+      m_leftmostBlock = used;
+    }
+    else
+    {
+      left->right = used;
+    }
+
+    if (right == nullptr)
+    {
+      assert(m_rightmostBlock == used);
+      m_rightmostBlock = hole;
+    }
+    else
+    {
+      right->left = hole;
+
+      if (right->free)
+      {
+        // merge the hole with the free block it has moved next to
+        unlinkFromBinList(hole);
+        unlinkFromBinList(right);
+
+        hole->size += right->size;
+        hole->right = right->right;
+        if (hole->right == nullptr)
+        {
+          assert(m_rightmostBlock == right);
+          m_rightmostBlock = hole;
+        }
+        else
+        {
+          hole->right->left = hole;
+        }
+
+        recycle(right);
+        linkToBinList(hole);
+      }
+    }
+  }
+
+  checkInvariants();
+  return moves;
+}
+
 // Testing / debugging
 
 std::vector<AllocationTracker::Range> AllocationTracker::freeBlocks() const
@@ -568,6 +674,16 @@ void AllocationTracker::checkInvariants() const
   }
   assert(m_capacity == totalSize);
 
+  size_t usedSize = 0;
+  for (Block* block = m_leftmostBlock; block != nullptr; block = block->right)
+  {
+    if (!block->free)
+    {
+      usedSize += block->size;
+    }
+  }
+  assert(m_usedSize == usedSize);
+
   // check the size map
   for (const auto& headBlock : m_freeBlockSizeBins)
   {
@@ -74,6 +74,11 @@ private:
    */
   Index m_capacity;
 
+  /**
+   * Sum of `size` of all used Blocks.
+   */
+  Index m_usedSize;
+
   /**
    * Points to the Block with pos 0. Used to free all of the blocks in the destructor
    */
@@ -134,6 +139,35 @@ public:
    */
   bool hasAllocations() const;
 
+  /**
+   * @return the sum of the sizes of all allocations. Constant time.
+   */
+  Index usedSize() const;
+
+  /**
+   * @return the share of the free space that is not part of the largest free block, i.e.
+   * 0 if all free space is contiguous and close to 1 if it is scattered across many small
+   * blocks. Constant time.
+   */
+  double fragmentation() const;
+
+  struct Move
+  {
+    Block* block;
+    Index oldPos;
+  };
+
+  /**
+   * Moves up to `maxMoves` allocations down into the free blocks to their left, starting
+   * with the leftmost free block. Repeated calls pack all allocations at the start and
+   * merge the free space into one block at the end.
+   *
+   * The moved Blocks keep their identity, only their `pos` changes, so the caller must
+   * move the data of each returned Block from `oldPos` to its new `pos`. The old and new
+   * ranges of a Block may overlap.
+   */
+  std::vector<Move> compact(size_t maxMoves);
+
   // Testing / debugging
 
   class Range
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BackgroundUploader.h"
+
+#include "Renderer/GL.h"
+
+#include <cassert>
+#include <utility>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+// in nanoseconds
+constexpr auto FenceTimeout = GLuint64(100'000'000);
+} // namespace
+
+BackgroundUploader::BackgroundUploader(
+  std::function<bool()> createContext, Function destroyContext)
+  : m_createContext{std::move(createContext)}
+  , m_destroyContext{std::move(destroyContext)}
+  , m_thread{[&]() { run(); }}
+{
+}
+
+BackgroundUploader::~BackgroundUploader()
+{
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_stopped = true;
+  }
+  m_uploadQueued.notify_all();
+  m_thread.join();
+}
+
+bool BackgroundUploader::available() const
+{
+  return m_state == State::Running;
+}
+
+void BackgroundUploader::enqueue(Function upload, Function completion)
+{
+  assert(available());
+
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_queuedUploads.push_back(Upload{std::move(upload), std::move(completion)});
+    ++m_pendingUploadCount;
+  }
+  m_uploadQueued.notify_one();
+}
+
+size_t BackgroundUploader::pendingUploadCount() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_pendingUploadCount;
+}
+
+void BackgroundUploader::processCompletedUploads()
+{
+  auto completions = std::vector<Function>{};
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    completions = std::exchange(m_completions, {});
+    m_pendingUploadCount -= completions.size();
+  }
+
+  for (const auto& completion : completions)
+  {
+    completion();
+  }
+}
+
+void BackgroundUploader::waitForUploads()
+{
+  {
+    auto lock = std::unique_lock{m_mutex};
+    m_uploadCompleted.wait(
+      lock, [&]() { return m_completions.size() == m_pendingUploadCount; });
+  }
+  processCompletedUploads();
+}
+
+void BackgroundUploader::run()
+{
+  if (!m_createContext())
+  {
+    m_state = State::Failed;
+    return;
+  }
+  m_state = State::Running;
+
+  auto lock = std::unique_lock{m_mutex};
+  while (true)
+  {
+    m_uploadQueued.wait(lock, [&]() { return m_stopped || !m_queuedUploads.empty(); });
+    if (m_stopped)
+    {
+      break;
+    }
+
+    auto upload = std::move(m_queuedUploads.front());
+    m_queuedUploads.pop_front();
+    lock.unlock();
+
+    upload.upload();
+
+    // the objects are shared with the render contexts, which must not use them before
+    // the GPU has executed the upload
+    const auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout)
+           == GL_TIMEOUT_EXPIRED)
+    {
+    }
+    glAssert(glDeleteSync(fence));
+
+    lock.lock();
+    m_completions.push_back(std::move(upload.completion));
+    m_uploadCompleted.notify_all();
+  }
+  lock.unlock();
+
+  m_destroyContext();
+}
+
+} // namespace TrenchBroom::Renderer
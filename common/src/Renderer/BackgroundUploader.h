@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+
+/**
+ * Runs GL uploads on a worker thread that has its own GL context, which shares its
+ * objects with the render contexts. This keeps large uploads from stalling the frames
+ * that are rendered in the meantime.
+ *
+ * The worker places a fence after every upload and waits for the GPU to pass it before
+ * the upload is considered complete, so the uploaded objects are fully defined when
+ * other contexts use them. Completion functions are called on the render thread by
+ * processCompletedUploads(), and the uploaded objects must not be used for rendering
+ * before their completion function was called.
+ */
+class BackgroundUploader
+{
+public:
+  using Function = std::function<void()>;
+
+private:
+  enum class State
+  {
+    Starting,
+    Running,
+    Failed,
+  };
+
+  struct Upload
+  {
+    Function upload;
+    Function completion;
+  };
+
+  std::function<bool()> m_createContext;
+  Function m_destroyContext;
+
+  std::atomic<State> m_state{State::Starting};
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_uploadQueued;
+  std::condition_variable m_uploadCompleted;
+  std::deque<Upload> m_queuedUploads;
+  std::vector<Function> m_completions;
+  size_t m_pendingUploadCount{0};
+  bool m_stopped{false};
+
+  std::thread m_thread;
+
+public:
+  /**
+   * Creates an uploader and starts its worker thread. The given functions are called on
+   * the worker thread to create a GL context and make it current, and to destroy it when
+   * the uploader is destroyed. If the context cannot be created, the uploader never
+   * becomes available.
+   */
+  BackgroundUploader(std::function<bool()> createContext, Function destroyContext);
+  ~BackgroundUploader();
+
+  /**
+   * Indicates whether the worker's GL context was created successfully. Uploads must
+   * only be enqueued if this returns true.
+   */
+  bool available() const;
+
+  /**
+   * Enqueues the given upload function to be called on the worker thread. Once the GPU
+   * has executed the upload, the given completion function is called by the next call to
+   * processCompletedUploads() or waitForUploads().
+   */
+  void enqueue(Function upload, Function completion);
+
+  /**
+   * Returns the number of uploads whose completion function has not been called yet.
+   */
+  size_t pendingUploadCount() const;
+
+  /**
+   * Calls the completion functions of the uploads that have completed since the last
+   * call. Must be called on the render thread.
+   */
+  void processCompletedUploads();
+
+  /**
+   * Blocks until all enqueued uploads have completed and calls their completion
+   * functions. Must be called on the render thread before the data referenced by any
+   * pending upload is destroyed.
+   */
+  void waitForUploads();
+
+  deleteCopyAndMove(BackgroundUploader);
+
+private:
+  void run();
+};
+
+} // namespace TrenchBroom::Renderer
@@ -29,10 +29,20 @@
 #include "Preferences.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/flat_hash_map.h>
+#include <kdl/parallel.h>
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <optional>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
@@ -80,8 +90,13 @@ bool BrushRenderer::DefaultFilter::visible(
   const auto& firstFace = brush.face(*firstFaceIndex);
   const auto& secondFace = brush.face(*secondFaceIndex);
 
-  return m_context.visible(&brushNode, firstFace)
-         || m_context.visible(&brushNode, secondFace);
+  return m_context.visible(&brushNode)
+         && (!m_context.hidden(firstFace) || !m_context.hidden(secondFace));
+}
+
+bool BrushRenderer::DefaultFilter::hidden(const Model::BrushFace& face) const
+{
+  return m_context.hidden(face);
 }
 
 bool BrushRenderer::DefaultFilter::editable(const Model::BrushNode& brush) const
@@ -143,6 +158,7 @@ BrushRenderer::Filter::RenderSettings BrushRenderer::NoFilter::markFaces(
 
 BrushRenderer::BrushRenderer()
   : m_filter{std::make_unique<NoFilter>()}
+  , m_projectedEdgeAxes{false, false, false}
   , m_showEdges{false}
   , m_grayscale{false}
   , m_tint{false}
@@ -150,21 +166,33 @@ BrushRenderer::BrushRenderer()
   , m_forceTransparent{false}
   , m_transparencyAlpha{1.0f}
   , m_showHiddenBrushes{false}
+  , m_visibleBrushes{nullptr}
+  , m_renderRangesValid{false}
+  , m_culledBrushCount{0}
 {
   clear();
 }
 
 void BrushRenderer::invalidate()
 {
-  for (auto* brushNode : m_allBrushes)
+  m_invalidBrushSlots.clear();
+  m_invalidBrushCount = 0;
+
+  for (size_t i = 0; i < m_brushSlots.size(); ++i)
   {
-    // this will also invalidate already invalid brushes, which
-    // is unnecessary
-    removeBrushFromVbo(*brushNode);
+    auto& slot = m_brushSlots[i];
+    if (slot.brushNode != nullptr)
+    {
+      // this will also invalidate already invalid brushes, which
+      // is unnecessary
+      removeBrushFromVbo(slot);
+      slot.valid = false;
+      m_invalidBrushSlots.push_back(i);
+      ++m_invalidBrushCount;
+    }
   }
-  m_invalidBrushes = m_allBrushes;
 
-  assert(m_brushInfo.empty());
+  assert(m_vboBrushCount == 0u);
   assert(m_transparentFaces->empty());
   assert(m_opaqueFaces->empty());
 }
@@ -172,32 +200,78 @@ void BrushRenderer::invalidate()
 void BrushRenderer::invalidateBrush(const Model::BrushNode* brushNode)
 {
   // skip brushes that are not in the renderer
-  if (m_allBrushes.find(brushNode) == std::end(m_allBrushes))
+  auto* slot = findBrushSlot(*brushNode);
+  if (slot == nullptr)
   {
-    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
-    assert(m_invalidBrushes.find(brushNode) == std::end(m_invalidBrushes));
     return;
   }
-  // if it's not in the invalid set, put it in
-  if (m_invalidBrushes.insert(brushNode).second)
+  // if it's not invalid yet, mark it as such
+  if (slot->valid)
   {
-    removeBrushFromVbo(*brushNode);
+    slot->valid = false;
+    m_invalidBrushSlots.push_back(size_t(slot - m_brushSlots.data()));
+    ++m_invalidBrushCount;
+    removeBrushFromVbo(*slot);
   }
 }
 
 bool BrushRenderer::valid() const
 {
-  return m_invalidBrushes.empty();
+  return m_invalidBrushCount == 0u;
+}
+
+void BrushRenderer::setBrushSuppressed(
+  const Model::BrushNode* brushNode, const bool suppressed)
+{
+  const auto* slot = findBrushSlot(*brushNode);
+  if (slot == nullptr)
+  {
+    return;
+  }
+
+  const auto slotIndex = size_t(slot - m_brushSlots.data());
+  if (slotIndex >= m_suppressedBrushSlots.size())
+  {
+    if (!suppressed)
+    {
+      return;
+    }
+    m_suppressedBrushSlots.resize(m_brushSlots.size(), false);
+  }
+
+  if (m_suppressedBrushSlots[slotIndex] != suppressed)
+  {
+    m_suppressedBrushSlots[slotIndex] = suppressed;
+    if (suppressed)
+    {
+      ++m_suppressedBrushCount;
+    }
+    else
+    {
+      --m_suppressedBrushCount;
+    }
+    m_renderRangesValid = false;
+  }
 }
 
 void BrushRenderer::clear()
 {
-  m_brushInfo.clear();
-  m_allBrushes.clear();
-  m_invalidBrushes.clear();
+  m_brushSlots.clear();
+  m_freeBrushSlots.clear();
+  m_invalidBrushSlots.clear();
+  m_invalidBrushCount = 0;
+  m_vboBrushCount = 0;
+  m_suppressedBrushSlots.clear();
+  m_suppressedBrushCount = 0;
+  m_renderRangesValid = false;
+  m_culledBrushCount = 0;
 
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_edgeIndices = std::make_shared<BrushIndexArray>();
+  for (auto& projectedEdgeIndices : m_projectedEdgeIndices)
+  {
+    projectedEdgeIndices = std::make_shared<BrushIndexArray>();
+  }
   m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
 
@@ -205,6 +279,11 @@ void BrushRenderer::clear()
   m_transparentFaceRenderer =
     FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    m_projectedEdgeRenderers[axis] =
+      IndexedEdgeRenderer{m_vertexArray, m_projectedEdgeIndices[axis]};
+  }
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -274,6 +353,96 @@ void BrushRenderer::setShowHiddenBrushes(const bool showHiddenBrushes)
   }
 }
 
+void BrushRenderer::setVisibleBrushes(
+  const std::vector<const Model::BrushNode*>* visibleBrushes)
+{
+  if (visibleBrushes != nullptr || m_visibleBrushes != nullptr)
+  {
+    m_visibleBrushes = visibleBrushes;
+    m_renderRangesValid = false;
+  }
+}
+
+size_t BrushRenderer::culledBrushCount() const
+{
+  return m_culledBrushCount;
+}
+
+BrushRenderer::AllocationStats BrushRenderer::allocationStats() const
+{
+  const auto& vertexTracker = m_vertexArray->allocationTracker();
+  auto result = AllocationStats{
+    vertexTracker.capacity(),
+    vertexTracker.usedSize(),
+    vertexTracker.fragmentation(),
+    0,
+    0,
+  };
+
+  const auto addIndexArray = [&](const BrushIndexArray& indexArray) {
+    const auto& indexTracker = indexArray.allocationTracker();
+    result.indexCapacity += indexTracker.capacity();
+    result.usedIndices += indexTracker.usedSize();
+  };
+
+  addIndexArray(*m_edgeIndices);
+  for (const auto& projectedEdgeIndices : m_projectedEdgeIndices)
+  {
+    addIndexArray(*projectedEdgeIndices);
+  }
+  for (const auto& [texture, indexArray] : *m_opaqueFaces)
+  {
+    addIndexArray(*indexArray);
+  }
+  for (const auto& [texture, indexArray] : *m_transparentFaces)
+  {
+    addIndexArray(*indexArray);
+  }
+
+  return result;
+}
+
+size_t BrushRenderer::memoryUsage() const
+{
+  auto result = m_vertexArray->memoryUsage() + m_edgeIndices->memoryUsage();
+  for (const auto& projectedEdgeIndices : m_projectedEdgeIndices)
+  {
+    result += projectedEdgeIndices->memoryUsage();
+  }
+  for (const auto& [texture, indexArray] : *m_opaqueFaces)
+  {
+    result += indexArray->memoryUsage();
+  }
+  for (const auto& [texture, indexArray] : *m_transparentFaces)
+  {
+    result += indexArray->memoryUsage();
+  }
+  return result;
+}
+
+void BrushRenderer::prepare()
+{
+  if (m_brushSlots.size() > m_freeBrushSlots.size())
+  {
+    if (!valid())
+    {
+      validate();
+    }
+    else
+    {
+      compact();
+    }
+  }
+}
+
+/**
+ * Returns the axis that a 2D view looks along.
+ */
+static size_t viewAxis(const RenderContext& renderContext)
+{
+  return vm::find_abs_max_component(renderContext.camera().direction());
+}
+
 void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   renderOpaque(renderContext, renderBatch);
@@ -282,19 +451,35 @@ void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
 
 void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  if (!m_allBrushes.empty())
+  if (m_brushSlots.size() > m_freeBrushSlots.size())
   {
+    const auto showEdges = renderContext.showEdges() || m_showEdges;
+    if (showEdges && renderContext.render2D())
+    {
+      // the first 2D view along an axis requires the projected edges of all brushes
+      const auto axis = viewAxis(renderContext);
+      if (!m_projectedEdgeAxes[axis])
+      {
+        m_projectedEdgeAxes[axis] = true;
+        invalidate();
+      }
+    }
+
     if (!valid())
     {
       validate();
     }
+    if (!m_renderRangesValid)
+    {
+      validateRenderRanges();
+    }
     if (renderContext.showFaces())
     {
       renderOpaqueFaces(renderBatch);
     }
-    if (renderContext.showEdges() || m_showEdges)
+    if (showEdges)
     {
-      renderEdges(renderBatch);
+      renderEdges(renderContext, renderBatch);
     }
   }
 }
@@ -302,12 +487,16 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
 void BrushRenderer::renderTransparent(
   RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  if (!m_allBrushes.empty())
+  if (m_brushSlots.size() > m_freeBrushSlots.size())
   {
     if (!valid())
     {
       validate();
     }
+    if (!m_renderRangesValid)
+    {
+      validateRenderRanges();
+    }
     if (renderContext.showFaces())
     {
       renderTransparentFaces(renderBatch);
@@ -332,13 +521,270 @@ void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
   m_transparentFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderEdges(RenderBatch& renderBatch)
+void BrushRenderer::renderEdges(RenderContext& renderContext, RenderBatch& renderBatch)
 {
+  auto& edgeRenderer = renderContext.render2D()
+                         ? m_projectedEdgeRenderers[viewAxis(renderContext)]
+                         : m_edgeRenderer;
+
   if (m_showOccludedEdges)
   {
-    m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+    edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+  }
+  edgeRenderer.render(renderBatch, m_edgeColor);
+}
+
+namespace
+{
+using Range = IndexHolder::Range;
+
+void addRange(std::vector<Range>& ranges, const AllocationTracker::Block* key)
+{
+  if (key != nullptr && key->size > 0)
+  {
+    ranges.push_back({key->pos, key->size});
+  }
+}
+
+/**
+ * Sorts the given ranges and merges adjacent ranges so that they can be drawn with as
+ * few entries as possible.
+ */
+std::vector<Range> mergeRanges(std::vector<Range> ranges)
+{
+  std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.offset < rhs.offset;
+  });
+
+  auto result = std::vector<Range>{};
+  for (const auto& range : ranges)
+  {
+    if (!result.empty() && result.back().offset + result.back().count == range.offset)
+    {
+      result.back().count += range.count;
+    }
+    else
+    {
+      result.push_back(range);
+    }
+  }
+  return result;
+}
+
+/**
+ * The number of blocks to move per array and frame when compacting fragmented arrays.
+ */
+constexpr size_t CompactionMovesPerFrame = 256;
+
+/**
+ * Arrays are compacted once more than half of their free space is scattered in blocks
+ * other than the largest one.
+ */
+bool shouldCompact(const AllocationTracker& allocationTracker)
+{
+  return allocationTracker.fragmentation() > 0.5;
+}
+
+template <typename IndexArrayMap>
+bool compactIndexArrays(IndexArrayMap& indexArrays)
+{
+  auto moved = false;
+  for (auto& [texture, indexArray] : indexArrays)
+  {
+    if (shouldCompact(indexArray->allocationTracker()))
+    {
+      moved = indexArray->compact(CompactionMovesPerFrame) > 0 || moved;
+    }
+  }
+  return moved;
+}
+
+template <typename IndexArrayMap>
+void setRenderRanges(
+  IndexArrayMap& indexArrays,
+  kdl::flat_hash_map<const Assets::Texture*, std::vector<Range>>& ranges)
+{
+  for (auto& [texture, indexArray] : indexArrays)
+  {
+    auto it = ranges.find(texture);
+    indexArray->setRenderRanges(
+      it != ranges.end() ? mergeRanges(std::move(it->second)) : std::vector<Range>{});
+  }
+}
+} // namespace
+
+void BrushRenderer::validateRenderRanges()
+{
+  m_culledBrushCount = 0;
+
+  if (m_visibleBrushes == nullptr && m_suppressedBrushCount == 0)
+  {
+    m_edgeIndices->setRenderRanges(std::nullopt);
+    for (auto& projectedEdgeIndices : m_projectedEdgeIndices)
+    {
+      projectedEdgeIndices->setRenderRanges(std::nullopt);
+    }
+    for (auto& [texture, indexArray] : *m_opaqueFaces)
+    {
+      indexArray->setRenderRanges(std::nullopt);
+    }
+    for (auto& [texture, indexArray] : *m_transparentFaces)
+    {
+      indexArray->setRenderRanges(std::nullopt);
+    }
+  }
+  else
+  {
+    auto edgeRanges = std::vector<Range>{};
+    auto projectedEdgeRanges = std::array<std::vector<Range>, 3>{};
+    auto opaqueRanges = kdl::flat_hash_map<const Assets::Texture*, std::vector<Range>>{};
+    auto transparentRanges =
+      kdl::flat_hash_map<const Assets::Texture*, std::vector<Range>>{};
+
+    const auto isSuppressed = [&](const size_t slotIndex) {
+      return slotIndex < m_suppressedBrushSlots.size()
+             && m_suppressedBrushSlots[slotIndex];
+    };
+
+    auto renderedBrushCount = size_t(0);
+    const auto addBrushRanges = [&](const size_t slotIndex) {
+      const auto& slot = m_brushSlots[slotIndex];
+      if (slot.info && !isSuppressed(slotIndex))
+      {
+        const auto& info = *slot.info;
+        addRange(edgeRanges, info.edgeIndicesKey);
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+          addRange(projectedEdgeRanges[axis], info.projectedEdgeIndicesKeys[axis]);
+        }
+        for (const auto& [texture, key] : info.opaqueFaceIndicesKeys)
+        {
+          addRange(opaqueRanges[texture], key);
+        }
+        for (const auto& [texture, key] : info.transparentFaceIndicesKeys)
+        {
+          addRange(transparentRanges[texture], key);
+        }
+        ++renderedBrushCount;
+      }
+    };
+
+    if (m_visibleBrushes != nullptr)
+    {
+      for (const auto* brushNode : *m_visibleBrushes)
+      {
+        if (const auto* slot = findBrushSlot(*brushNode))
+        {
+          addBrushRanges(size_t(slot - m_brushSlots.data()));
+        }
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < m_brushSlots.size(); ++i)
+      {
+        addBrushRanges(i);
+      }
+    }
+
+    m_edgeIndices->setRenderRanges(mergeRanges(std::move(edgeRanges)));
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      m_projectedEdgeIndices[axis]->setRenderRanges(
+        mergeRanges(std::move(projectedEdgeRanges[axis])));
+    }
+    setRenderRanges(*m_opaqueFaces, opaqueRanges);
+    setRenderRanges(*m_transparentFaces, transparentRanges);
+
+    auto suppressedVboBrushCount = size_t(0);
+    for (size_t i = 0; i < m_suppressedBrushSlots.size(); ++i)
+    {
+      if (m_suppressedBrushSlots[i] && m_brushSlots[i].info)
+      {
+        ++suppressedVboBrushCount;
+      }
+    }
+
+    assert(renderedBrushCount + suppressedVboBrushCount <= m_vboBrushCount);
+    m_culledBrushCount = m_vboBrushCount - renderedBrushCount - suppressedVboBrushCount;
+  }
+
+  m_renderRangesValid = true;
+}
+
+void BrushRenderer::compact()
+{
+  if (shouldCompact(m_vertexArray->allocationTracker()))
+  {
+    const auto moves = m_vertexArray->compact(CompactionMovesPerFrame);
+    if (!moves.empty())
+    {
+      auto infoByVertexKey =
+        kdl::flat_hash_map<const AllocationTracker::Block*, const BrushInfo*>{};
+      infoByVertexKey.reserve(m_vboBrushCount);
+      for (const auto& slot : m_brushSlots)
+      {
+        if (slot.info)
+        {
+          infoByVertexKey.try_emplace(slot.info->vertexHolderKey, &*slot.info);
+        }
+      }
+
+      for (const auto& [block, oldPos] : moves)
+      {
+        rebaseBrushIndices(
+          *infoByVertexKey.at(block),
+          static_cast<GLuint>(oldPos),
+          static_cast<GLuint>(block->pos));
+      }
+    }
+  }
+
+  // moving indices invalidates the render ranges, but moving vertices does not
+  auto movedIndices = false;
+  if (shouldCompact(m_edgeIndices->allocationTracker()))
+  {
+    movedIndices = m_edgeIndices->compact(CompactionMovesPerFrame) > 0;
+  }
+  for (auto& projectedEdgeIndices : m_projectedEdgeIndices)
+  {
+    if (shouldCompact(projectedEdgeIndices->allocationTracker()))
+    {
+      movedIndices =
+        projectedEdgeIndices->compact(CompactionMovesPerFrame) > 0 || movedIndices;
+    }
+  }
+  movedIndices = compactIndexArrays(*m_opaqueFaces) || movedIndices;
+  movedIndices = compactIndexArrays(*m_transparentFaces) || movedIndices;
+
+  if (movedIndices)
+  {
+    m_renderRangesValid = false;
+  }
+}
+
+void BrushRenderer::rebaseBrushIndices(
+  const BrushInfo& info, const GLuint oldBase, const GLuint newBase)
+{
+  if (info.edgeIndicesKey != nullptr)
+  {
+    m_edgeIndices->rebaseElementsWithKey(info.edgeIndicesKey, oldBase, newBase);
+  }
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    if (auto* key = info.projectedEdgeIndicesKeys[axis])
+    {
+      m_projectedEdgeIndices[axis]->rebaseElementsWithKey(key, oldBase, newBase);
+    }
+  }
+  for (const auto& [texture, key] : info.opaqueFaceIndicesKeys)
+  {
+    m_opaqueFaces->at(texture)->rebaseElementsWithKey(key, oldBase, newBase);
+  }
+  for (const auto& [texture, key] : info.transparentFaceIndicesKeys)
+  {
+    m_transparentFaces->at(texture)->rebaseElementsWithKey(key, oldBase, newBase);
   }
-  m_edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
 class BrushRenderer::FilterWrapper : public BrushRenderer::Filter
@@ -373,21 +819,134 @@ public:
   }
 };
 
+static inline bool shouldRenderEdge(
+  const BrushRendererBrushCache::CachedEdge& edge,
+  const BrushRenderer::Filter::EdgeRenderPolicy policy)
+{
+  using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
+
+  switch (policy)
+  {
+  case EdgeRenderPolicy::RenderAll:
+    return true;
+  case EdgeRenderPolicy::RenderIfEitherFaceMarked:
+    return (edge.face1 && edge.face1->isMarked())
+           || (edge.face2 && edge.face2->isMarked());
+  case EdgeRenderPolicy::RenderIfBothFacesMarked:
+    return (edge.face1 && edge.face1->isMarked())
+           && (edge.face2 && edge.face2->isMarked());
+  case EdgeRenderPolicy::RenderNone:
+    return false;
+    switchDefault();
+  }
+}
+
+/**
+ * Selects the edges to render in the 2D views along the given axes from the edges of the
+ * given brush that are rendered according to the given policy.
+ */
+static std::array<std::vector<size_t>, 3> selectMarkedProjectedEdges(
+  const Model::BrushNode& brushNode,
+  const BrushRenderer::Filter::EdgeRenderPolicy policy,
+  const std::array<bool, 3>& axes)
+{
+  auto result = std::array<std::vector<size_t>, 3>{};
+  if (
+    policy == BrushRenderer::Filter::EdgeRenderPolicy::RenderNone
+    || std::none_of(axes.begin(), axes.end(), [](const auto axis) { return axis; }))
+  {
+    return result;
+  }
+
+  const auto& brushCache = brushNode.brushRendererBrushCache();
+  const auto& cachedEdges = brushCache.cachedEdges();
+
+  auto markedEdgeIndices = std::vector<size_t>{};
+  auto markedEdges = std::vector<BrushRendererBrushCache::CachedEdge>{};
+  for (size_t i = 0; i < cachedEdges.size(); ++i)
+  {
+    if (shouldRenderEdge(cachedEdges[i], policy))
+    {
+      markedEdgeIndices.push_back(i);
+      markedEdges.push_back(cachedEdges[i]);
+    }
+  }
+
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    if (axes[axis])
+    {
+      for (const auto i :
+           selectProjectedEdges(brushCache.cachedVertices(), markedEdges, axis))
+      {
+        result[axis].push_back(markedEdgeIndices[i]);
+      }
+    }
+  }
+  return result;
+}
+
 void BrushRenderer::validate()
 {
   assert(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  // evaluate the filter serially since it marks the brush faces and may depend on the
+  // editor context. only evaluate the filter once per brush.
+  auto brushesToValidate = std::vector<std::tuple<size_t, Filter::RenderSettings>>{};
+  brushesToValidate.reserve(m_invalidBrushCount);
+  for (const auto slotIndex : m_invalidBrushSlots)
+  {
+    // skip the slots of removed brushes and the duplicates of reused slots
+    auto& slot = m_brushSlots[slotIndex];
+    if (slot.brushNode == nullptr || slot.valid)
+    {
+      continue;
+    }
+    slot.valid = true;
+
+    const auto settings = wrapper.markFaces(*slot.brushNode);
+    const auto [facePolicy, edgePolicy] = settings;
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToValidate.emplace_back(slotIndex, settings);
+    }
+  }
+
+  // building the vertex caches and selecting the edges for the 2D views only touches the
+  // individual brushes, so it can be done in parallel
+  auto projectedEdges = std::vector<ProjectedEdgeIndices>(brushesToValidate.size());
+  kdl::parallel_for(brushesToValidate.size(), [&](const auto i) {
+    const auto& [slotIndex, settings] = brushesToValidate[i];
+    const auto* brushNode = m_brushSlots[slotIndex].brushNode;
+    brushNode->brushRendererBrushCache().validateVertexCache(*brushNode);
+    projectedEdges[i] =
+      selectMarkedProjectedEdges(*brushNode, std::get<1>(settings), m_projectedEdgeAxes);
+  });
+
+  // inserting into the VBOs and index arrays must happen serially
+  for (size_t i = 0; i < brushesToValidate.size(); ++i)
   {
-    validateBrush(*brushNode);
+    const auto& [slotIndex, settings] = brushesToValidate[i];
+    validateBrush(m_brushSlots[slotIndex], settings, projectedEdges[i]);
   }
-  m_invalidBrushes.clear();
+  m_invalidBrushSlots.clear();
+  m_invalidBrushCount = 0;
+  m_renderRangesValid = false;
   assert(valid());
 
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
     FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    m_projectedEdgeRenderers[axis] =
+      IndexedEdgeRenderer{m_vertexArray, m_projectedEdgeIndices[axis]};
+  }
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -409,28 +968,6 @@ static void addTriIndicesForPolygon(
   }
 }
 
-static inline bool shouldRenderEdge(
-  const BrushRendererBrushCache::CachedEdge& edge,
-  const BrushRenderer::Filter::EdgeRenderPolicy policy)
-{
-  using EdgeRenderPolicy = BrushRenderer::Filter::EdgeRenderPolicy;
-
-  switch (policy)
-  {
-  case EdgeRenderPolicy::RenderAll:
-    return true;
-  case EdgeRenderPolicy::RenderIfEitherFaceMarked:
-    return (edge.face1 && edge.face1->isMarked())
-           || (edge.face2 && edge.face2->isMarked());
-  case EdgeRenderPolicy::RenderIfBothFacesMarked:
-    return (edge.face1 && edge.face1->isMarked())
-           && (edge.face2 && edge.face2->isMarked());
-  case EdgeRenderPolicy::RenderNone:
-    return false;
-    switchDefault();
-  }
-}
-
 static size_t countMarkedEdgeIndices(
   const Model::BrushNode& brushNode, const BrushRenderer::Filter::EdgeRenderPolicy policy)
 {
@@ -503,27 +1040,24 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
+void BrushRenderer::validateBrush(
+  BrushSlot& slot,
+  const Filter::RenderSettings& settings,
+  const ProjectedEdgeIndices& projectedEdges)
 {
-  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
-  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
+  assert(slot.brushNode != nullptr);
+  assert(!slot.info);
 
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+  const auto& brushNode = *slot.brushNode;
 
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
   const auto [facePolicy, edgePolicy] = settings;
+  assert(
+    facePolicy != Filter::FaceRenderPolicy::RenderNone
+    || edgePolicy != Filter::EdgeRenderPolicy::RenderNone);
+  unused(facePolicy);
 
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
-  {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
-  }
-
-  BrushInfo& info = m_brushInfo[&brushNode];
+  BrushInfo& info = slot.info.emplace();
+  ++m_vboBrushCount;
 
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
@@ -558,6 +1092,28 @@ void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
     }
   }
 
+  // insert the edge indices for the 2D views
+  const auto& cachedEdges = brushCache.cachedEdges();
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    const auto& edgeIndices = projectedEdges[axis];
+    if (!edgeIndices.empty())
+    {
+      auto& indexArray = *m_projectedEdgeIndices[axis];
+      auto [key, insertDest] =
+        indexArray.getPointerToInsertElementsAt(2 * edgeIndices.size());
+      info.projectedEdgeIndicesKeys[axis] = key;
+      for (const auto i : edgeIndices)
+      {
+        const auto& edge = cachedEdges[i];
+        *(insertDest++) =
+          static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex1RelativeToBrush);
+        *(insertDest++) =
+          static_cast<GLuint>(brushVerticesStartIndex + edge.vertexIndex2RelativeToBrush);
+      }
+    }
+  }
+
   // insert face indices
 
   auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
@@ -671,40 +1227,91 @@ void BrushRenderer::addBrush(const Model::BrushNode* brushNode)
 {
   // i.e. insert the brush as "invalid" if it's not already present.
   // if it is present, its validity is unchanged.
-  if (m_allBrushes.insert(brushNode).second)
+  if (findBrushSlot(*brushNode) != nullptr)
+  {
+    return;
+  }
+
+  auto slotIndex = m_brushSlots.size();
+  if (!m_freeBrushSlots.empty())
   {
-    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
-    assertResult(m_invalidBrushes.insert(brushNode).second);
+    slotIndex = m_freeBrushSlots.back();
+    m_freeBrushSlots.pop_back();
   }
+  else
+  {
+    m_brushSlots.emplace_back();
+  }
+
+  auto& slot = m_brushSlots[slotIndex];
+  assert(slot.brushNode == nullptr);
+  assert(!slot.info);
+  slot.brushNode = brushNode;
+  slot.valid = false;
+  m_invalidBrushSlots.push_back(slotIndex);
+  ++m_invalidBrushCount;
+
+  brushNode->brushRendererBrushCache().setRendererSlot(*this, slotIndex);
 }
 
 void BrushRenderer::removeBrush(const Model::BrushNode* brushNode)
 {
-  // update m_brushValid
-  m_allBrushes.erase(brushNode);
-
-  if (m_invalidBrushes.erase(brushNode) > 0u)
+  auto* slot = findBrushSlot(*brushNode);
+  if (slot == nullptr)
   {
-    // invalid brushes are not in the VBO, so we can return  now.
-    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
     return;
   }
 
-  removeBrushFromVbo(*brushNode);
+  if (slot->valid)
+  {
+    removeBrushFromVbo(*slot);
+  }
+  else
+  {
+    // invalid brushes are not in the VBO, and their index is skipped when validating
+    assert(!slot->info);
+    assert(m_invalidBrushCount > 0u);
+    if (--m_invalidBrushCount == 0u)
+    {
+      m_invalidBrushSlots.clear();
+    }
+  }
+
+  const auto slotIndex = size_t(slot - m_brushSlots.data());
+  if (slotIndex < m_suppressedBrushSlots.size() && m_suppressedBrushSlots[slotIndex])
+  {
+    m_suppressedBrushSlots[slotIndex] = false;
+    --m_suppressedBrushCount;
+    m_renderRangesValid = false;
+  }
+
+  brushNode->brushRendererBrushCache().resetRendererSlot(*this);
+  *slot = BrushSlot{};
+  m_freeBrushSlots.push_back(slotIndex);
 }
 
-void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
+BrushRenderer::BrushSlot* BrushRenderer::findBrushSlot(const Model::BrushNode& brushNode)
 {
-  auto it = m_brushInfo.find(&brushNode);
+  // the slot stored in the brush is stale if this renderer was cleared in the meantime
+  if (const auto slotIndex = brushNode.brushRendererBrushCache().rendererSlot(*this);
+      slotIndex && *slotIndex < m_brushSlots.size()
+      && m_brushSlots[*slotIndex].brushNode == &brushNode)
+  {
+    return &m_brushSlots[*slotIndex];
+  }
+  return nullptr;
+}
 
-  if (it == std::end(m_brushInfo))
+void BrushRenderer::removeBrushFromVbo(BrushSlot& slot)
+{
+  if (!slot.info)
   {
     // This means BrushRenderer::validateBrush skipped rendering the brush, so it was
     // never uploaded to the VBO's
     return;
   }
 
-  const BrushInfo& info = it->second;
+  const BrushInfo& info = *slot.info;
 
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
@@ -712,6 +1319,13 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
   {
     m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
   }
+  for (size_t axis = 0; axis < 3; ++axis)
+  {
+    if (auto* key = info.projectedEdgeIndicesKeys[axis])
+    {
+      m_projectedEdgeIndices[axis]->zeroElementsWithKey(key);
+    }
+  }
 
   for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
@@ -738,7 +1352,9 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
     }
   }
 
-  m_brushInfo.erase(it);
+  slot.info.reset();
+  --m_vboBrushCount;
+  m_renderRangesValid = false;
 }
 } // namespace Renderer
 } // namespace TrenchBroom
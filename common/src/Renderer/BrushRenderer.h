@@ -26,10 +26,12 @@
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
 
+#include <kdl/flat_hash_map.h>
+
+#include <array>
 #include <memory>
+#include <optional>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -100,6 +102,7 @@ public:
     bool visible(const Model::BrushNode& brush) const;
     bool visible(const Model::BrushNode& brush, const Model::BrushFace& face) const;
     bool visible(const Model::BrushNode& brush, const Model::BrushEdge& edge) const;
+    bool hidden(const Model::BrushFace& face) const;
 
     bool editable(const Model::BrushNode& brush) const;
     bool editable(const Model::BrushNode& brush, const Model::BrushFace& face) const;
@@ -123,41 +126,78 @@ private:
 private:
   std::unique_ptr<Filter> m_filter;
 
+  /**
+   * For each axis, the indices of the cached edges of a brush that are rendered in the 2D
+   * views along that axis, see selectProjectedEdges().
+   */
+  using ProjectedEdgeIndices = std::array<std::vector<size_t>, 3>;
+
   struct BrushInfo
   {
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
+    std::array<AllocationTracker::Block*, 3> projectedEdgeIndicesKeys;
     std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>>
       opaqueFaceIndicesKeys;
     std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>>
       transparentFaceIndicesKeys;
   };
+
   /**
-   * Tracks all brushes that are stored in the VBO, with the information necessary to
-   * remove them from the VBO later.
+   * Every brush in this renderer occupies a slot. The index of the slot is stored in the
+   * brush's BrushRendererBrushCache so that it can be found without a lookup by pointer.
+   *
+   * If a brush is in the VBO, it's always valid and its slot has a BrushInfo with the
+   * information necessary to remove it from the VBO later. If a brush is valid, it might
+   * not be in the VBO if it was hidden by the Filter.
    */
-  std::unordered_map<const Model::BrushNode*, BrushInfo> m_brushInfo;
+  struct BrushSlot
+  {
+    const Model::BrushNode* brushNode = nullptr;
+    bool valid = false;
+    std::optional<BrushInfo> info;
+  };
+
+  std::vector<BrushSlot> m_brushSlots;
+  std::vector<size_t> m_freeBrushSlots;
 
   /**
-   * If a brush is in the VBO, it's always valid.
-   * If a brush is valid, it might not be in the VBO if it was hidden by the Filter.
-   *
-   * Do not attempt to use vector_set here, it turns out to be slower.
+   * The indices of the slots that were invalidated since the last call to validate().
+   * Removed brushes are not erased from this list, so it may contain stale or duplicate
+   * indices that are skipped when validating.
+   */
+  std::vector<size_t> m_invalidBrushSlots;
+  size_t m_invalidBrushCount;
+  size_t m_vboBrushCount;
+
+  /**
+   * One bit per slot that indicates whether the brush in the slot is suppressed, see
+   * setBrushSuppressed(). The bits of slots beyond the end of this vector are unset.
    */
-  std::unordered_set<const Model::BrushNode*> m_allBrushes;
-  std::unordered_set<const Model::BrushNode*> m_invalidBrushes;
+  std::vector<bool> m_suppressedBrushSlots;
+  size_t m_suppressedBrushCount;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<BrushIndexArray> m_edgeIndices;
 
+  /**
+   * The edges rendered by the 2D views, one index array per view axis. Edges that don't
+   * show up in a 2D view or that coincide with other edges of the same brush when viewed
+   * along the axis are omitted. An axis' array is only filled once a 2D view along that
+   * axis has been rendered.
+   */
+  std::array<std::shared_ptr<BrushIndexArray>, 3> m_projectedEdgeIndices;
+  std::array<bool, 3> m_projectedEdgeAxes;
+
   using TextureToBrushIndicesMap =
-    std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+    kdl::flat_hash_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
   std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
   std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
 
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
+  std::array<IndexedEdgeRenderer, 3> m_projectedEdgeRenderers;
 
   Color m_faceColor;
   bool m_showEdges;
@@ -172,10 +212,15 @@ private:
 
   bool m_showHiddenBrushes;
 
+  const std::vector<const Model::BrushNode*>* m_visibleBrushes;
+  bool m_renderRangesValid;
+  size_t m_culledBrushCount;
+
 public:
   template <typename FilterT>
   explicit BrushRenderer(const FilterT& filter)
     : m_filter{std::make_unique<FilterT>(filter)}
+    , m_projectedEdgeAxes{false, false, false}
     , m_showEdges{false}
     , m_grayscale{false}
     , m_tint{false}
@@ -183,6 +228,12 @@ public:
     , m_forceTransparent{false}
     , m_transparencyAlpha{1.0f}
     , m_showHiddenBrushes{false}
+    , m_invalidBrushCount{0}
+    , m_vboBrushCount{0}
+    , m_suppressedBrushCount{0}
+    , m_visibleBrushes{nullptr}
+    , m_renderRangesValid{false}
+    , m_culledBrushCount{0}
   {
     clear();
   }
@@ -204,14 +255,24 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
-   * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
-   * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
-   * lingering Texture* pointers.
+   * Additionally, calling `invalidate()` guarantees that no slot has a BrushInfo and that
+   * the m_transparentFaces and m_opaqueFaces maps will be empty, so the BrushRenderer
+   * will not have any lingering Texture* pointers.
    */
   void invalidate();
   void invalidateBrush(const Model::BrushNode* brush);
   bool valid() const;
 
+  /**
+   * Suppresses or shows the given brush. A suppressed brush is not rendered, but unlike a
+   * removed brush, its vertices and indices remain in the arrays. Showing it again
+   * therefore doesn't require validating and uploading it again.
+   *
+   * Brushes that this renderer does not know are ignored. Removing a brush resets its
+   * suppression.
+   */
+  void setBrushSuppressed(const Model::BrushNode* brush, bool suppressed);
+
   /**
    * Sets the color to render untextured faces with.
    */
@@ -279,7 +340,51 @@ public:
    */
   void setShowHiddenBrushes(bool showHiddenBrushes);
 
+  /**
+   * Restricts rendering to the given brushes. Brushes that are not in the given list are
+   * not rendered, and the list may contain brushes which this renderer does not know.
+   * Passing nullptr renders all brushes again.
+   *
+   * The given list must remain valid until this function is called again.
+   */
+  void setVisibleBrushes(const std::vector<const Model::BrushNode*>* visibleBrushes);
+
+  /**
+   * Returns the number of brushes that were not rendered because they were not in the
+   * list of visible brushes. Suppressed brushes are not counted.
+   */
+  size_t culledBrushCount() const;
+
+  struct AllocationStats
+  {
+    size_t vertexCapacity;
+    size_t usedVertices;
+    double vertexFragmentation;
+    size_t indexCapacity;
+    size_t usedIndices;
+  };
+
+  /**
+   * Returns the capacity and usage of the vertex array and of all index arrays combined,
+   * and the fragmentation of the vertex array, see AllocationTracker::fragmentation().
+   */
+  AllocationStats allocationStats() const;
+
+  /**
+   * Returns the number of bytes allocated for the local copies of the vertex array and
+   * of all index arrays.
+   */
+  size_t memoryUsage() const;
+
 public: // rendering
+  /**
+   * Validates the invalid brushes, or performs a bounded number of compaction moves if
+   * all brushes are valid. None of this depends on the camera, so when several views
+   * render the same brushes, only one of them needs to call this per frame. Rendering
+   * validates the brushes itself if necessary, but it never compacts the arrays.
+   */
+  void prepare();
+
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -287,7 +392,21 @@ public: // rendering
 private:
   void renderOpaqueFaces(RenderBatch& renderBatch);
   void renderTransparentFaces(RenderBatch& renderBatch);
-  void renderEdges(RenderBatch& renderBatch);
+  void renderEdges(RenderContext& renderContext, RenderBatch& renderBatch);
+
+  /**
+   * Restricts the index arrays to the ranges of the visible brushes that are not
+   * suppressed.
+   */
+  void validateRenderRanges();
+
+  /**
+   * Performs a bounded number of compaction moves on every fragmented vertex or index
+   * array, so that a long editing session does not keep growing them. Called by
+   * prepare() when no brushes had to be validated.
+   */
+  void compact();
+  void rebaseBrushIndices(const BrushInfo& info, GLuint oldBase, GLuint newBase);
 
 public:
   /**
@@ -298,7 +417,15 @@ public:
 private:
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
-  void validateBrush(const Model::BrushNode& brushNode);
+  /**
+   * Inserts the given brush into the vertex and index arrays. Brushes for which the
+   * filter yields nothing to render must not be passed here; the slots of such brushes
+   * do not get a BrushInfo.
+   */
+  void validateBrush(
+    BrushSlot& slot,
+    const Filter::RenderSettings& settings,
+    const ProjectedEdgeIndices& projectedEdges);
 
 public:
   /**
@@ -313,12 +440,17 @@ public:
 
 private:
   /**
-   * If the given brush is not currently in the VBO, it's silently ignored.
+   * Returns the slot of the given brush, or nullptr if the brush is not in this renderer.
+   */
+  BrushSlot* findBrushSlot(const Model::BrushNode& brushNode);
+
+  /**
+   * If the brush in the given slot is not currently in the VBO, it's silently ignored.
    * Otherwise, it's removed from the VBO (having its indices zeroed out, causing it to no
-   * longer draw). The brush's "valid" state is not touched inside here, but the
-   * m_brushInfo is updated.
+   * longer draw). The brush's "valid" state is not touched inside here, but the slot's
+   * BrushInfo is reset.
    */
-  void removeBrushFromVbo(const Model::BrushNode& brush);
+  void removeBrushFromVbo(BrushSlot& slot);
 
   deleteCopyAndMove(BrushRenderer);
 };
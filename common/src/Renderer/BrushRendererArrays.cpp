@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 
 namespace TrenchBroom
@@ -33,16 +35,19 @@ namespace Renderer
 
 // DirtyRangeTracker
 
+bool DirtyRangeTracker::Range::operator==(const Range& other) const
+{
+  return pos == other.pos && size == other.size;
+}
+
 DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
-  : m_dirtyPos(0)
-  , m_dirtySize(0)
+  : m_ranges()
   , m_capacity(initial_capacity)
 {
 }
 
 DirtyRangeTracker::DirtyRangeTracker()
-  : m_dirtyPos(0)
-  , m_dirtySize(0)
+  : m_ranges()
   , m_capacity(0)
 {
 }
@@ -72,16 +77,67 @@ void DirtyRangeTracker::markDirty(const size_t pos, const size_t size)
     throw std::invalid_argument("markDirty provided range out of bounds");
   }
 
-  const size_t newPos = std::min(pos, m_dirtyPos);
-  const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+  if (size == 0)
+  {
+    return;
+  }
+
+  // find the first range that ends at or after pos, and merge it and all following ranges
+  // that start at or before the end of the new range into the new range
+  auto first = std::lower_bound(
+    m_ranges.begin(), m_ranges.end(), pos, [](const Range& range, const size_t p) {
+      return range.pos + range.size < p;
+    });
 
-  m_dirtyPos = newPos;
-  m_dirtySize = newEnd - newPos;
+  size_t newPos = pos;
+  size_t newEnd = pos + size;
+
+  auto last = first;
+  while (last != m_ranges.end() && last->pos <= newEnd)
+  {
+    newPos = std::min(newPos, last->pos);
+    newEnd = std::max(newEnd, last->pos + last->size);
+    ++last;
+  }
+
+  first = m_ranges.erase(first, last);
+  m_ranges.insert(first, Range{newPos, newEnd - newPos});
+
+  if (m_ranges.size() > MaxRanges)
+  {
+    coalesceClosestRanges();
+  }
 }
 
 bool DirtyRangeTracker::clean() const
 {
-  return m_dirtySize == 0;
+  return m_ranges.empty();
+}
+
+const std::vector<DirtyRangeTracker::Range>& DirtyRangeTracker::ranges() const
+{
+  return m_ranges;
+}
+
+void DirtyRangeTracker::coalesceClosestRanges()
+{
+  assert(m_ranges.size() > 1);
+
+  auto closest = m_ranges.begin();
+  auto smallestGap = std::numeric_limits<size_t>::max();
+  for (auto it = m_ranges.begin(); std::next(it) != m_ranges.end(); ++it)
+  {
+    const auto gap = std::next(it)->pos - (it->pos + it->size);
+    if (gap < smallestGap)
+    {
+      closest = it;
+      smallestGap = gap;
+    }
+  }
+
+  const auto next = std::next(closest);
+  closest->size = next->pos + next->size - closest->pos;
+  m_ranges.erase(next);
 }
 
 // IndexHolder
@@ -111,11 +167,64 @@ void IndexHolder::render(const PrimType primType, const size_t offset, size_t co
   glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
 }
 
+void IndexHolder::render(const PrimType primType, const std::vector<Range>& ranges) const
+{
+  auto renderCounts = std::vector<GLsizei>{};
+  auto renderOffsets = std::vector<const GLvoid*>{};
+  renderCounts.reserve(ranges.size());
+  renderOffsets.reserve(ranges.size());
+
+  for (const auto& range : ranges)
+  {
+    renderCounts.push_back(static_cast<GLsizei>(range.count));
+    renderOffsets.push_back(
+      reinterpret_cast<const GLvoid*>(m_vbo->offset() + sizeof(Index) * range.offset));
+  }
+
+  glAssert(glMultiDrawElements(
+    toGL(primType),
+    renderCounts.data(),
+    glType<Index>(),
+    renderOffsets.data(),
+    static_cast<GLsizei>(ranges.size())));
+}
+
 std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index>& elements)
 {
   return std::make_shared<IndexHolder>(elements);
 }
 
+// IndirectCommandHolder
+
+IndirectCommandHolder::IndirectCommandHolder(std::vector<Command>& commands)
+  : VboHolder<Command>(VboType::DrawIndirectBuffer, commands)
+{
+}
+
+void IndirectCommandHolder::setCommands(const std::vector<Command>& commands)
+{
+  assert(commands.size() == size());
+  Command* dest = getPointerToWriteElementsTo(0, commands.size());
+  std::copy(commands.begin(), commands.end(), dest);
+}
+
+void IndirectCommandHolder::render(const PrimType primType)
+{
+  bindBlock();
+  glAssert(glMultiDrawElementsIndirect(
+    toGL(primType),
+    glType<IndexHolder::Index>(),
+    reinterpret_cast<const GLvoid*>(offset()),
+    static_cast<GLsizei>(size()),
+    0));
+  unbindBlock();
+}
+
+bool IndirectCommandHolder::supported()
+{
+  return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
 VertexArrayInterface::~VertexArrayInterface() {}
 
 // BrushIndexArray
@@ -131,6 +240,22 @@ bool BrushIndexArray::hasValidIndices() const
   return m_allocationTracker.hasAllocations();
 }
 
+bool BrushIndexArray::hasIndicesToRender() const
+{
+  return hasValidIndices() && (!m_renderRanges || !m_renderRanges->empty());
+}
+
+void BrushIndexArray::setRenderRanges(
+  std::optional<std::vector<IndexHolder::Range>> renderRanges)
+{
+  m_renderRanges = std::move(renderRanges);
+  m_renderCommandsIndexOffset = std::nullopt;
+  if (!m_renderRanges)
+  {
+    m_renderCommands.reset();
+  }
+}
+
 std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::
   getPointerToInsertElementsAt(const size_t elementCount)
 {
@@ -164,21 +289,122 @@ void BrushIndexArray::zeroElementsWithKey(AllocationTracker::Block* key)
   m_indexHolder.zeroRange(pos, size);
 }
 
+void BrushIndexArray::rebaseElementsWithKey(
+  AllocationTracker::Block* key, const GLuint oldBase, const GLuint newBase)
+{
+  GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+  for (size_t i = 0; i < key->size; ++i)
+  {
+    dest[i] = dest[i] - oldBase + newBase;
+  }
+}
+
+const AllocationTracker& BrushIndexArray::allocationTracker() const
+{
+  return m_allocationTracker;
+}
+
+size_t BrushIndexArray::compact(const size_t maxMoves)
+{
+  const auto moves = m_allocationTracker.compact(maxMoves);
+  for (const auto& [block, oldPos] : moves)
+  {
+    assert(block->pos < oldPos);
+    m_indexHolder.moveElements(oldPos, block->pos, block->size);
+
+    // the vacated indices are now part of a free block, so they must be degenerate
+    const auto vacatedPos = std::max(oldPos, block->pos + block->size);
+    m_indexHolder.zeroRange(vacatedPos, oldPos + block->size - vacatedPos);
+  }
+  return moves.size();
+}
+
+size_t BrushIndexArray::memoryUsage() const
+{
+  return m_indexHolder.memoryUsage();
+}
+
 void BrushIndexArray::render(const PrimType primType) const
 {
   assert(m_indexHolder.prepared());
-  m_indexHolder.render(primType, 0, m_indexHolder.size());
+  if (m_renderRanges)
+  {
+    if (renderCommandsValid())
+    {
+      m_renderCommands->render(primType);
+    }
+    else
+    {
+      m_indexHolder.render(primType, *m_renderRanges);
+    }
+  }
+  else
+  {
+    m_indexHolder.render(primType, 0, m_indexHolder.size());
+  }
 }
 
 bool BrushIndexArray::prepared() const
 {
-  return m_indexHolder.prepared();
+  return m_indexHolder.prepared()
+         && (m_renderCommands == nullptr || renderCommandsValid());
 }
 
 void BrushIndexArray::prepare(VboManager& vboManager)
 {
   m_indexHolder.prepare(vboManager);
   assert(m_indexHolder.prepared());
+
+  prepareRenderCommands(vboManager);
+}
+
+bool BrushIndexArray::renderCommandsValid() const
+{
+  return m_renderCommands != nullptr
+         && m_renderCommandsIndexOffset == m_indexHolder.offset()
+         && m_renderCommands->prepared();
+}
+
+void BrushIndexArray::prepareRenderCommands(VboManager& vboManager)
+{
+  if (!m_renderRanges || m_renderRanges->empty() || !IndirectCommandHolder::supported())
+  {
+    m_renderCommands.reset();
+    m_renderCommandsIndexOffset = std::nullopt;
+    return;
+  }
+
+  // the commands address the indices from the start of the buffer, so they must be
+  // rebuilt whenever the index holder moves to another region of its VBO
+  const auto indexOffset = m_indexHolder.offset();
+  if (m_renderCommandsIndexOffset != indexOffset)
+  {
+    const auto firstIndex = indexOffset / sizeof(IndexHolder::Index);
+
+    auto commands = std::vector<IndirectCommandHolder::Command>{};
+    commands.reserve(m_renderRanges->size());
+    for (const auto& range : *m_renderRanges)
+    {
+      commands.push_back(
+        {static_cast<GLuint>(range.count),
+         1,
+         static_cast<GLuint>(firstIndex + range.offset),
+         0,
+         0});
+    }
+
+    if (m_renderCommands != nullptr && m_renderCommands->size() == commands.size())
+    {
+      m_renderCommands->setCommands(commands);
+    }
+    else
+    {
+      m_renderCommands = std::make_unique<IndirectCommandHolder>(commands);
+    }
+    m_renderCommandsIndexOffset = indexOffset;
+  }
+
+  m_renderCommands->prepare(vboManager);
 }
 
 void BrushIndexArray::setupIndices()
@@ -233,6 +459,26 @@ void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
   // us to re-use the space later
 }
 
+const AllocationTracker& BrushVertexArray::allocationTracker() const
+{
+  return m_allocationTracker;
+}
+
+std::vector<AllocationTracker::Move> BrushVertexArray::compact(const size_t maxMoves)
+{
+  auto moves = m_allocationTracker.compact(maxMoves);
+  for (const auto& [block, oldPos] : moves)
+  {
+    m_vertexHolder.moveElements(oldPos, block->pos, block->size);
+  }
+  return moves;
+}
+
+size_t BrushVertexArray::memoryUsage() const
+{
+  return m_vertexHolder.memoryUsage();
+}
+
 bool BrushVertexArray::setupVertices()
 {
   return m_vertexHolder.setupVertices();
@@ -30,8 +30,11 @@
 
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -39,10 +42,24 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
+/**
+ * Tracks the modified ranges of a buffer as a sorted list of disjoint ranges, so that
+ * edits at distant positions are uploaded separately. Once there are more than MaxRanges
+ * ranges, the two ranges with the smallest gap between them are coalesced.
+ */
 struct DirtyRangeTracker
 {
-  size_t m_dirtyPos;
-  size_t m_dirtySize;
+  struct Range
+  {
+    size_t pos;
+    size_t size;
+
+    bool operator==(const Range& other) const;
+  };
+
+  static constexpr size_t MaxRanges = 64;
+
+  std::vector<Range> m_ranges;
   size_t m_capacity;
 
   /**
@@ -58,6 +75,10 @@ struct DirtyRangeTracker
   size_t capacity() const;
   void markDirty(size_t pos, size_t size);
   bool clean() const;
+  const std::vector<Range>& ranges() const;
+
+private:
+  void coalesceClosestRanges();
 };
 
 /**
@@ -66,16 +87,22 @@ struct DirtyRangeTracker
  * Non-copyable; meant to be held in a std::shared_ptr.
  * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
  *
- * Currently uses a single range to track the modified region which might upload much more
- * than necessary; it might be worth mapping the VBO and editing it directly.
+ * Tracks the modified ranges of the snapshot and uploads each of them separately.
+ *
+ * If the VBO is persistent, every upload goes to the next region of the VBO's ring, so
+ * the GPU can keep rendering from the previous regions. Since a region has missed all
+ * changes since it was last written to, the holder tracks one stale range per region and
+ * copies it from the snapshot when the region becomes current.
  */
 template <typename T>
 class VboHolder
 {
 protected:
   VboType m_type;
+  VboUsage m_usage;
   std::vector<T> m_snapshot;
   DirtyRangeTracker m_dirtyRange;
+  std::vector<DirtyRangeTracker> m_staleRanges;
   VboManager* m_vboManager;
   Vbo* m_vbo;
 
@@ -101,22 +128,35 @@ private:
     }
     assert(m_vbo == nullptr);
 
-    m_vbo = m_vboManager->allocateVbo(
-      m_type, m_snapshot.size() * sizeof(T), VboUsage::DynamicDraw);
+    m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), m_usage);
     assert(m_vbo != nullptr);
 
     m_vbo->writeElements(0, m_snapshot);
 
+    // all other regions have not been written to yet
+    m_staleRanges = std::vector<DirtyRangeTracker>(
+      m_vbo->regionCount(), DirtyRangeTracker(m_snapshot.size()));
+    for (size_t i = 0; i < m_staleRanges.size(); ++i)
+    {
+      if (i != m_vbo->currentRegion())
+      {
+        m_staleRanges[i].markDirty(0, m_snapshot.size());
+      }
+    }
+
     m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
     assert(m_dirtyRange.clean());
     assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRange.capacity());
   }
 
 public:
-  explicit VboHolder(const VboType type)
+  explicit VboHolder(
+    const VboType type, const VboUsage usage = VboUsage::PersistentDraw)
     : m_type(type)
+    , m_usage(usage)
     , m_snapshot()
     , m_dirtyRange(0)
+    , m_staleRanges()
     , m_vboManager(nullptr)
     , m_vbo(nullptr)
   {
@@ -127,8 +167,10 @@ public:
    */
   VboHolder(const VboType type, std::vector<T>& elements)
     : m_type(type)
+    , m_usage(VboUsage::PersistentDraw)
     , m_snapshot()
     , m_dirtyRange(elements.size())
+    , m_staleRanges()
     , m_vboManager(nullptr)
     , m_vbo(nullptr)
   {
@@ -171,6 +213,20 @@ public:
     return m_snapshot.data() + offsetWithinBlock;
   }
 
+  /**
+   * Moves the given number of elements from one offset to another. The source and
+   * destination ranges may overlap.
+   */
+  void moveElements(const size_t fromOffset, const size_t toOffset, const size_t count)
+  {
+    assert(fromOffset + count <= m_snapshot.size());
+    assert(toOffset + count <= m_snapshot.size());
+
+    std::memmove(
+      m_snapshot.data() + toOffset, m_snapshot.data() + fromOffset, count * sizeof(T));
+    m_dirtyRange.markDirty(toOffset, count);
+  }
+
   bool prepared() const
   {
     // NOTE: this returns true if the capacity is 0
@@ -208,15 +264,24 @@ public:
 
     // otherwise, it's an incremental update of the dirty ranges.
 
-    if (!m_dirtyRange.clean())
+    for (auto& staleRange : m_staleRanges)
     {
-      const size_t pos = m_dirtyRange.m_dirtyPos;
-      const size_t size = m_dirtyRange.m_dirtySize;
+      for (const auto& range : m_dirtyRange.ranges())
+      {
+        staleRange.markDirty(range.pos, range.size);
+      }
+    }
+
+    m_vbo->advanceRegion();
 
-      const size_t bytesFromStart = pos * sizeof(T);
-      m_vbo->writeArray(bytesFromStart, m_snapshot.data() + pos, size);
+    auto& staleRange = m_staleRanges[m_vbo->currentRegion()];
+    for (const auto& range : staleRange.ranges())
+    {
+      const size_t bytesFromStart = range.pos * sizeof(T);
+      m_vbo->writeArray(bytesFromStart, m_snapshot.data() + range.pos, range.size);
     }
 
+    staleRange = DirtyRangeTracker(m_snapshot.size());
     m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
     assert(prepared());
   }
@@ -225,6 +290,16 @@ public:
 
   size_t size() const { return m_snapshot.size(); }
 
+  /**
+   * Returns the number of bytes allocated for the local copy of the elements.
+   */
+  size_t memoryUsage() const { return m_snapshot.capacity() * sizeof(T); }
+
+  /**
+   * Returns the byte offset of the VBO's current region, see Vbo::offset().
+   */
+  size_t offset() const { return m_vbo != nullptr ? m_vbo->offset() : 0; }
+
   void bindBlock() { m_vbo->bind(); }
 
   void unbindBlock() { m_vbo->unbind(); }
@@ -235,6 +310,12 @@ class IndexHolder : public VboHolder<GLuint>
 public:
   using Index = GLuint;
 
+  struct Range
+  {
+    size_t offset;
+    size_t count;
+  };
+
   IndexHolder();
   /**
    * NOTE: This destructively moves the contents of `elements` into the Holder.
@@ -242,10 +323,53 @@ public:
   explicit IndexHolder(std::vector<Index>& elements);
   void zeroRange(size_t offsetWithinBlock, size_t count);
   void render(PrimType primType, size_t offset, size_t count) const;
+  /**
+   * Renders the given ranges of indices with a single draw call.
+   */
+  void render(PrimType primType, const std::vector<Range>& ranges) const;
 
   static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
 };
 
+/**
+ * The layout of a command in an indirect draw buffer, see glMultiDrawElementsIndirect.
+ */
+struct DrawElementsIndirectCommand
+{
+  GLuint count;
+  GLuint instanceCount;
+  GLuint firstIndex;
+  GLint baseVertex;
+  GLuint baseInstance;
+};
+
+/**
+ * Holds the commands for rendering ranges of an IndexHolder with one call to
+ * glMultiDrawElementsIndirect. Requires OpenGL 4.3 or ARB_multi_draw_indirect.
+ */
+class IndirectCommandHolder : public VboHolder<DrawElementsIndirectCommand>
+{
+public:
+  using Command = DrawElementsIndirectCommand;
+
+  /**
+   * NOTE: This destructively moves the contents of `commands` into the Holder.
+   */
+  explicit IndirectCommandHolder(std::vector<Command>& commands);
+
+  /**
+   * Replaces the commands with the given commands, which must have the same size.
+   */
+  void setCommands(const std::vector<Command>& commands);
+
+  /**
+   * Renders the commands. The index holder that the commands refer to must be bound.
+   */
+  void render(PrimType primType);
+
+  static bool supported();
+};
+
 /**
  * VboBlock handle that supports dynamically allocating ranges of indices, grows as
  * needed, and also supports freeing allocations and zeroing the corresponding indicies so
@@ -256,6 +380,18 @@ class BrushIndexArray
 private:
   IndexHolder m_indexHolder;
   AllocationTracker m_allocationTracker;
+  std::optional<std::vector<IndexHolder::Range>> m_renderRanges;
+
+  /**
+   * The render ranges as indirect draw commands if supported, and the region of the index
+   * holder that the commands were built for. Both are reset when the render ranges
+   * change and rebuilt by prepare().
+   */
+  std::unique_ptr<IndirectCommandHolder> m_renderCommands;
+  std::optional<size_t> m_renderCommandsIndexOffset;
+
+  bool renderCommandsValid() const;
+  void prepareRenderCommands(VboManager& vboManager);
 
 public:
   BrushIndexArray();
@@ -266,6 +402,19 @@ public:
    */
   bool hasValidIndices() const;
 
+  /**
+   * Returns true if there are any valid indices and, if render ranges are set, at least
+   * one range to render.
+   */
+  bool hasIndicesToRender() const;
+
+  /**
+   * Restricts rendering to the given ranges of indices. The ranges must refer to
+   * allocations returned by getPointerToInsertElementsAt(). Passing std::nullopt renders
+   * all indices again.
+   */
+  void setRenderRanges(std::optional<std::vector<IndexHolder::Range>> renderRanges);
+
   /**
    * Call this to request writing the given number of indices.
    *
@@ -283,6 +432,26 @@ public:
    */
   void zeroElementsWithKey(AllocationTracker::Block* key);
 
+  /**
+   * Changes the indices of the given allocation after the vertices they refer to have
+   * moved from oldBase to newBase.
+   */
+  void rebaseElementsWithKey(
+    AllocationTracker::Block* key, GLuint oldBase, GLuint newBase);
+
+  const AllocationTracker& allocationTracker() const;
+
+  /**
+   * Performs up to the given number of compaction moves, see AllocationTracker::compact,
+   * and zeroes the indices left behind. Returns the number of moves.
+   */
+  size_t compact(size_t maxMoves);
+
+  /**
+   * Returns the number of bytes allocated for the local copy of the indices.
+   */
+  size_t memoryUsage() const;
+
   void render(const PrimType primType) const;
   bool prepared() const;
   void prepare(VboManager& vboManager);
@@ -352,7 +521,7 @@ public:
 class BrushVertexArray
 {
 private:
-  using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+  using Vertex = Renderer::GLVertexTypes::P3NBT2::Vertex;
 
   VertexHolder<Vertex> m_vertexHolder;
   AllocationTracker m_allocationTracker;
@@ -374,6 +543,19 @@ public:
 
   void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+  const AllocationTracker& allocationTracker() const;
+
+  /**
+   * Performs up to the given number of compaction moves, see AllocationTracker::compact.
+   * The caller must rebase the indices referring to the moved vertices.
+   */
+  std::vector<AllocationTracker::Move> compact(size_t maxMoves);
+
+  /**
+   * Returns the number of bytes allocated for the local copy of the vertices.
+   */
+  size_t memoryUsage() const;
+
   // setting up GL attributes
   bool setupVertices();
   void cleanupVertices();
@@ -382,5 +564,66 @@ public:
   bool prepared() const;
   void prepare(VboManager& vboManager);
 };
+
+/**
+ * Manages blocks of vertices in a shared VertexHolder, which grows as needed. Unlike
+ * BrushVertexArray, freed blocks are zeroed so that their primitives become degenerate,
+ * which allows rendering the entire holder without indices. Since only the changed blocks
+ * are marked dirty, updating a block only uploads that block.
+ */
+template <typename V>
+class VertexBlockArray
+{
+private:
+  std::shared_ptr<VertexHolder<V>> m_vertexHolder;
+  AllocationTracker m_allocationTracker;
+
+public:
+  VertexBlockArray()
+    : m_vertexHolder{std::make_shared<VertexHolder<V>>()}
+    , m_allocationTracker{0}
+  {
+  }
+
+  /**
+   * Allocates a block of the given number of vertices, expanding the holder if needed.
+   *
+   * Returns the block, which must be passed to freeBlock() later, and a pointer where the
+   * caller should write `vertexCount` vertices.
+   */
+  std::pair<AllocationTracker::Block*, V*> allocateBlock(const size_t vertexCount)
+  {
+    auto* block = m_allocationTracker.allocate(vertexCount);
+    if (block == nullptr)
+    {
+      const auto newSize = std::max(
+        2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + vertexCount);
+      m_allocationTracker.expand(newSize);
+      m_vertexHolder->resize(newSize);
+
+      block = m_allocationTracker.allocate(vertexCount);
+      assert(block != nullptr);
+    }
+
+    return {block, m_vertexHolder->getPointerToWriteElementsTo(block->pos, vertexCount)};
+  }
+
+  /**
+   * Zeroes the vertices of the given block and marks it as free.
+   */
+  void freeBlock(AllocationTracker::Block* block)
+  {
+    auto* dest = m_vertexHolder->getPointerToWriteElementsTo(block->pos, block->size);
+    std::fill(dest, dest + block->size, V{});
+    m_allocationTracker.free(block);
+  }
+
+  const AllocationTracker& allocationTracker() const { return m_allocationTracker; }
+
+  /**
+   * Returns the holder of the vertices, which contains all blocks.
+   */
+  const std::shared_ptr<VertexHolder<V>>& vertexHolder() const { return m_vertexHolder; }
+};
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -23,8 +23,11 @@
 #include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/Polyhedron.h"
+#include "Model/TexCoordSystem.h"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 
 namespace TrenchBroom
 {
@@ -80,31 +83,44 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
   m_cachedFacesSortedByTexture.clear();
   m_cachedFacesSortedByTexture.reserve(brush.faceCount());
 
+  m_cachedEdges.clear();
+  m_cachedEdges.reserve(brush.edgeCount());
+
   for (const auto& face : brush.faces())
   {
     const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
+    const auto normal = ByteNormal{vm::vec3f{face.boundary().normal}};
+    const auto textureCoords = face.textureCoordsProjection();
 
     // The boundary is in CCW order, but the renderer expects CW order:
-    auto& boundary = face.geometry()->boundary();
+    const auto& boundary = face.geometry()->boundary();
+    const auto vertexCount = boundary.size();
     for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it)
     {
-      auto* currentHalfEdge = *it;
-      auto* vertex = currentHalfEdge->origin();
+      const auto* currentHalfEdge = *it;
+      const auto* vertex = currentHalfEdge->origin();
 
-      // Set the vertex payload to the index, relative to the brush's first vertex being
-      // 0. This is used below when building the edge cache. NOTE: we'll overwrite the
-      // payload as we visit the same vertex several times while visiting different faces,
-      // this is fine.
+      // Every edge is added by the face of its first half edge, so that both of its
+      // vertices are found among the vertices of that face without having to look them
+      // up. The destination of the current half edge is the previously added vertex.
       const auto currentIndex = m_cachedVertices.size();
-      vertex->setPayload(static_cast<GLuint>(currentIndex));
+      const auto* edge = currentHalfEdge->edge();
+      if (edge->firstEdge() == currentHalfEdge)
+      {
+        const auto destinationIndex =
+          currentIndex == indexOfFirstVertexRelativeToBrush
+            ? indexOfFirstVertexRelativeToBrush + vertexCount - 1
+            : currentIndex - 1;
 
-      const auto& position = vertex->position();
-      m_cachedVertices.emplace_back(
-        vm::vec3f{position},
-        vm::vec3f{face.boundary().normal},
-        face.textureCoords(position));
+        const auto otherFaceIndex = edge->secondFace()->payload();
+        assert(otherFaceIndex);
 
-      currentHalfEdge = currentHalfEdge->previous();
+        m_cachedEdges.emplace_back(
+          &face, &brush.face(*otherFaceIndex), currentIndex, destinationIndex);
+      }
+
+      const auto& position = vertex->position();
+      m_cachedVertices.emplace_back(vm::vec3f{position}, normal, textureCoords(position));
     }
 
     // face cache
@@ -120,27 +136,6 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
     m_cachedFacesSortedByTexture.end(),
     [](const CachedFace& a, const CachedFace& b) { return a.texture < b.texture; });
 
-  // Build edge index cache
-
-  m_cachedEdges.clear();
-  m_cachedEdges.reserve(brush.edgeCount());
-
-  for (const auto* currentEdge : brush.edges())
-  {
-    const auto faceIndex1 = currentEdge->firstFace()->payload();
-    const auto faceIndex2 = currentEdge->secondFace()->payload();
-    assert(faceIndex1 && faceIndex2);
-
-    const auto& face1 = brush.face(*faceIndex1);
-    const auto& face2 = brush.face(*faceIndex2);
-
-    const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-    const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
-
-    m_cachedEdges.emplace_back(
-      &face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
-  }
-
   m_rendererCacheValid = true;
 }
 
@@ -164,5 +159,98 @@ const std::vector<BrushRendererBrushCache::CachedEdge>& BrushRendererBrushCache:
   assert(m_rendererCacheValid);
   return m_cachedEdges;
 }
+
+size_t BrushRendererBrushCache::memoryUsage() const
+{
+  return m_cachedVertices.capacity() * sizeof(Vertex)
+         + m_cachedEdges.capacity() * sizeof(CachedEdge)
+         + m_cachedFacesSortedByTexture.capacity() * sizeof(CachedFace);
+}
+
+std::optional<size_t> BrushRendererBrushCache::rendererSlot(
+  const BrushRenderer& renderer) const
+{
+  for (const auto& [slotRenderer, slot] : m_rendererSlots)
+  {
+    if (slotRenderer == &renderer)
+    {
+      return slot;
+    }
+  }
+  return std::nullopt;
+}
+
+void BrushRendererBrushCache::setRendererSlot(
+  const BrushRenderer& renderer, const size_t slot)
+{
+  for (auto& [slotRenderer, existingSlot] : m_rendererSlots)
+  {
+    if (slotRenderer == &renderer)
+    {
+      existingSlot = slot;
+      return;
+    }
+  }
+  m_rendererSlots.emplace_back(&renderer, slot);
+}
+
+void BrushRendererBrushCache::resetRendererSlot(const BrushRenderer& renderer)
+{
+  m_rendererSlots.erase(
+    std::remove_if(
+      m_rendererSlots.begin(),
+      m_rendererSlots.end(),
+      [&](const auto& rendererSlot) { return rendererSlot.first == &renderer; }),
+    m_rendererSlots.end());
+}
+
+std::vector<size_t> selectProjectedEdges(
+  const std::vector<BrushRendererBrushCache::Vertex>& vertices,
+  const std::vector<BrushRendererBrushCache::CachedEdge>& edges,
+  const size_t axis)
+{
+  using Segment = std::array<float, 4>;
+
+  const auto i = (axis + 1) % 3;
+  const auto j = (axis + 2) % 3;
+
+  auto segments = std::vector<std::pair<Segment, size_t>>{};
+  segments.reserve(edges.size());
+  for (size_t e = 0; e < edges.size(); ++e)
+  {
+    const auto& edge = edges[e];
+    const auto& p1 = getVertexComponent<0>(vertices[edge.vertexIndex1RelativeToBrush]);
+    const auto& p2 = getVertexComponent<0>(vertices[edge.vertexIndex2RelativeToBrush]);
+
+    auto segment = Segment{p1[i], p1[j], p2[i], p2[j]};
+    if (segment[0] == segment[2] && segment[1] == segment[3])
+    {
+      continue;
+    }
+
+    // the direction of an edge doesn't matter
+    if (std::make_pair(segment[2], segment[3]) < std::make_pair(segment[0], segment[1]))
+    {
+      segment = Segment{segment[2], segment[3], segment[0], segment[1]};
+    }
+    segments.emplace_back(segment, e);
+  }
+
+  // the pairs are unique, so sorting them keeps the first edge of each segment in front
+  std::sort(segments.begin(), segments.end());
+
+  auto result = std::vector<size_t>{};
+  result.reserve(segments.size());
+  for (size_t s = 0; s < segments.size(); ++s)
+  {
+    if (s == 0 || segments[s].first != segments[s - 1].first)
+    {
+      result.push_back(segments[s].second);
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -21,6 +21,8 @@
 
 #include "Renderer/GLVertexType.h"
 
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -38,10 +40,12 @@ class BrushFace;
 
 namespace Renderer
 {
+class BrushRenderer;
+
 class BrushRendererBrushCache
 {
 public:
-  using VertexSpec = Renderer::GLVertexTypes::P3NT2;
+  using VertexSpec = Renderer::GLVertexTypes::P3NBT2;
   using Vertex = VertexSpec::Vertex;
 
   struct CachedFace
@@ -75,6 +79,8 @@ private:
   std::vector<CachedFace> m_cachedFacesSortedByTexture;
   bool m_rendererCacheValid;
 
+  std::vector<std::pair<const BrushRenderer*, size_t>> m_rendererSlots;
+
 public:
   BrushRendererBrushCache();
 
@@ -98,6 +104,32 @@ public:
   const std::vector<Vertex>& cachedVertices() const;
   const std::vector<CachedFace>& cachedFacesSortedByTexture() const;
   const std::vector<CachedEdge>& cachedEdges() const;
+
+  /**
+   * Returns the number of bytes allocated for the cached vertices, faces and edges.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Returns the index of the slot that the given renderer last assigned to the brush, if
+   * any. The renderer must check that the slot still belongs to the brush, since clearing
+   * a renderer does not reset the slots stored here.
+   */
+  std::optional<size_t> rendererSlot(const BrushRenderer& renderer) const;
+  void setRendererSlot(const BrushRenderer& renderer, size_t slot);
+  void resetRendererSlot(const BrushRenderer& renderer);
 };
+
+/**
+ * Selects the edges to render when a brush is viewed along the given axis in a 2D view.
+ * Edges that are parallel to the axis project onto a point and are skipped, and of
+ * several edges that project onto the same segment, only the first one is selected.
+ *
+ * Returns the indices of the selected edges in the given edges, in ascending order.
+ */
+std::vector<size_t> selectProjectedEdges(
+  const std::vector<BrushRendererBrushCache::Vertex>& vertices,
+  const std::vector<BrushRendererBrushCache::CachedEdge>& edges,
+  size_t axis);
 } // namespace Renderer
 } // namespace TrenchBroom
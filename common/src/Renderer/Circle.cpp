@@ -102,6 +102,13 @@ void Circle::render()
   m_array.render(m_filled ? PrimType::TriangleFan : PrimType::LineLoop);
 }
 
+void Circle::renderInstanced(const size_t instanceCount)
+{
+  m_array.renderInstanced(
+    m_filled ? PrimType::TriangleFan : PrimType::LineLoop,
+    static_cast<GLsizei>(instanceCount));
+}
+
 void Circle::init2D(
   const float radius,
   const size_t segments,
@@ -55,6 +55,7 @@ public:
   bool prepared() const;
   void prepare(VboManager& vboManager);
   void render();
+  void renderInstanced(size_t instanceCount);
 
 private:
   void init3D(
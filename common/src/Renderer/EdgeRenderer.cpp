@@ -243,7 +243,7 @@ void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(VboManager& vboManag
 
 void IndexedEdgeRenderer::Render::doRender(RenderContext& renderContext)
 {
-  if (m_indexArray->hasValidIndices())
+  if (m_indexArray->hasIndicesToRender())
   {
     renderEdges(renderContext);
   }
@@ -25,6 +25,7 @@
 #include "Renderer/FaceRenderer.h"
 #include "Renderer/Renderable.h"
 
+#include <kdl/flat_hash_map.h>
 #include <kdl/vector_set.h>
 
 #include <memory>
@@ -77,7 +78,7 @@ private:
 
   using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
   using TextureToBrushIndicesMap =
-    std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+    kdl::flat_hash_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
 
   std::shared_ptr<TextureToBrushIndicesMap> m_faces;
   std::shared_ptr<BrushVertexArray> m_vertexArray;
@@ -32,6 +32,7 @@
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 
@@ -46,6 +47,7 @@ EntityLinkRenderer::EntityLinkRenderer(std::weak_ptr<View::MapDocument> document
   : m_document(document)
   , m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f)
   , m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f)
+  , m_linkGraphValid(false)
 {
 }
 
@@ -65,6 +67,146 @@ void EntityLinkRenderer::setSelectedColor(const Color& color)
   invalidate();
 }
 
+void EntityLinkRenderer::clear()
+{
+  m_linkTargets.clear();
+  m_linkSources.clear();
+  m_linkGraphValid = false;
+  invalidate();
+}
+
+void EntityLinkRenderer::updateNode(Model::Node* node)
+{
+  if (!m_linkGraphValid)
+  {
+    return;
+  }
+
+  node->accept(kdl::overload(
+    [&](Model::WorldNode* world) { updateLinkSources(world); },
+    [](Model::LayerNode*) {},
+    [](Model::GroupNode*) {},
+    [&](Model::EntityNode* entity) {
+      updateLinkTargets(entity);
+      updateLinkSources(entity);
+    },
+    [](Model::BrushNode*) {},
+    [](Model::PatchNode*) {}));
+}
+
+void EntityLinkRenderer::removeNode(Model::Node* node)
+{
+  if (!m_linkGraphValid)
+  {
+    return;
+  }
+
+  if (auto* entityNode = dynamic_cast<Model::EntityNode*>(node))
+  {
+    setLinkTargets(entityNode, {});
+    m_linkTargets.erase(entityNode);
+
+    if (const auto it = m_linkSources.find(entityNode); it != m_linkSources.end())
+    {
+      for (const auto* source : it->second)
+      {
+        m_linkTargets[source] = kdl::vec_erase(
+          std::move(m_linkTargets[source]),
+          static_cast<const Model::EntityNodeBase*>(entityNode));
+      }
+      m_linkSources.erase(it);
+    }
+  }
+}
+
+void EntityLinkRenderer::validateLinkGraph()
+{
+  if (m_linkGraphValid)
+  {
+    return;
+  }
+
+  auto document = kdl::mem_lock(m_document);
+  if (document->world() != nullptr)
+  {
+    document->world()->accept(kdl::overload(
+      [](
+        auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+      [](
+        auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+      [](
+        auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+      [&](Model::EntityNode* entity) { updateLinkTargets(entity); },
+      [](Model::BrushNode*) {},
+      [](Model::PatchNode*) {}));
+  }
+
+  m_linkGraphValid = true;
+}
+
+void EntityLinkRenderer::updateLinkTargets(const Model::EntityNode* entityNode)
+{
+  auto targets = std::vector<const Model::EntityNodeBase*>{};
+  targets.reserve(entityNode->linkTargets().size() + entityNode->killTargets().size());
+  targets.insert(
+    targets.end(), entityNode->linkTargets().begin(), entityNode->linkTargets().end());
+  targets.insert(
+    targets.end(), entityNode->killTargets().begin(), entityNode->killTargets().end());
+
+  setLinkTargets(entityNode, std::move(targets));
+}
+
+void EntityLinkRenderer::updateLinkSources(const Model::EntityNodeBase* node)
+{
+  // the sources recorded in the graph may no longer link to the given node, and the
+  // node may have gained new sources
+  auto sources = std::vector<const Model::EntityNode*>{};
+  if (const auto it = m_linkSources.find(node); it != m_linkSources.end())
+  {
+    sources = it->second;
+  }
+
+  for (const auto* source : kdl::vec_concat(node->linkSources(), node->killSources()))
+  {
+    if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(source))
+    {
+      sources.push_back(entityNode);
+    }
+  }
+
+  for (const auto* source : kdl::vec_sort_and_remove_duplicates(std::move(sources)))
+  {
+    updateLinkTargets(source);
+  }
+}
+
+void EntityLinkRenderer::setLinkTargets(
+  const Model::EntityNode* entityNode, std::vector<const Model::EntityNodeBase*> targets)
+{
+  auto& currentTargets = m_linkTargets[entityNode];
+  for (const auto* target : currentTargets)
+  {
+    if (const auto it = m_linkSources.find(target); it != m_linkSources.end())
+    {
+      it->second = kdl::vec_erase(std::move(it->second), entityNode);
+      if (it->second.empty())
+      {
+        m_linkSources.erase(it);
+      }
+    }
+  }
+
+  currentTargets = std::move(targets);
+  for (const auto* target : currentTargets)
+  {
+    auto& sources = m_linkSources[target];
+    if (!kdl::vec_contains(sources, entityNode))
+    {
+      sources.push_back(entityNode);
+    }
+  }
+}
+
 namespace
 {
 class CollectLinksVisitor
@@ -88,10 +230,6 @@ protected:
   {
   }
 
-public:
-  virtual ~CollectLinksVisitor() = default;
-  virtual void visit(Model::EntityNodeBase* node) = 0;
-
 protected:
   void addLink(const Model::EntityNodeBase* source, const Model::EntityNodeBase* target)
   {
@@ -117,23 +255,17 @@ public:
   {
   }
 
-  void visit(Model::EntityNodeBase* node) override
+  void visit(
+    const Model::EntityNode* source,
+    const std::vector<const Model::EntityNodeBase*>& targets)
   {
-    if (m_editorContext.visible(node))
+    if (m_editorContext.visible(source))
     {
-      addTargets(node, node->linkTargets());
-      addTargets(node, node->killTargets());
-    }
-  }
-
-private:
-  void addTargets(
-    Model::EntityNodeBase* source, const std::vector<Model::EntityNodeBase*>& targets)
-  {
-    for (const Model::EntityNodeBase* target : targets)
-    {
-      if (m_editorContext.visible(target))
-        addLink(source, target);
+      for (const Model::EntityNodeBase* target : targets)
+      {
+        if (m_editorContext.visible(target))
+          addLink(source, target);
+      }
     }
   }
 };
@@ -153,7 +285,7 @@ public:
   {
   }
 
-  void visit(Model::EntityNodeBase* node) override
+  void visit(Model::EntityNodeBase* node)
   {
     if (m_editorContext.visible(node))
     {
@@ -208,7 +340,7 @@ public:
   {
   }
 
-  void visit(Model::EntityNodeBase* node) override
+  void visit(Model::EntityNodeBase* node)
   {
     if (node->selected() || node->descendantSelected())
     {
@@ -244,8 +376,9 @@ private:
 };
 } // namespace
 
+template <typename CollectLinks>
 static void collectSelectedLinks(
-  const Model::NodeCollection& selectedNodes, CollectLinksVisitor& collectLinks)
+  const Model::NodeCollection& selectedNodes, CollectLinks& collectLinks)
 {
   for (auto* node : selectedNodes)
   {
@@ -263,6 +396,9 @@ static void collectSelectedLinks(
 
 static void getAllLinks(
   View::MapDocument& document,
+  const std::unordered_map<
+    const Model::EntityNode*,
+    std::vector<const Model::EntityNodeBase*>>& linkTargets,
   const Color& defaultColor,
   const Color& selectedColor,
   std::vector<LinkRenderer::LineVertex>& links)
@@ -270,19 +406,9 @@ static void getAllLinks(
   const Model::EditorContext& editorContext = document.editorContext();
 
   CollectAllLinksVisitor collectLinks(editorContext, defaultColor, selectedColor, links);
-
-  if (document.world() != nullptr)
+  for (const auto& [source, targets] : linkTargets)
   {
-    document.world()->accept(kdl::overload(
-      [](
-        auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
-      [](
-        auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [](
-        auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-      [&](Model::EntityNode* entity) { collectLinks.visit(entity); },
-      [](Model::BrushNode*) {},
-      [](Model::PatchNode*) {}));
+    collectLinks.visit(source, targets);
   }
 }
 
@@ -312,33 +438,27 @@ static void getDirectSelectedLinks(
   collectSelectedLinks(document.selectedNodes(), collectLinks);
 }
 
-static void getLinks(
-  View::MapDocument& document,
-  const Color& defaultColor,
-  const Color& selectedColor,
-  std::vector<LinkRenderer::LineVertex>& links)
+std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
 {
+  auto document = kdl::mem_lock(m_document);
+  auto links = std::vector<LineVertex>{};
+
   const QString entityLinkMode = pref(Preferences::EntityLinkMode);
 
   if (entityLinkMode == Preferences::entityLinkModeAll())
   {
-    getAllLinks(document, defaultColor, selectedColor, links);
+    validateLinkGraph();
+    getAllLinks(*document, m_linkTargets, m_defaultColor, m_selectedColor, links);
   }
   else if (entityLinkMode == Preferences::entityLinkModeTransitive())
   {
-    getTransitiveSelectedLinks(document, defaultColor, selectedColor, links);
+    getTransitiveSelectedLinks(*document, m_defaultColor, m_selectedColor, links);
   }
   else if (entityLinkMode == Preferences::entityLinkModeDirect())
   {
-    getDirectSelectedLinks(document, defaultColor, selectedColor, links);
+    getDirectSelectedLinks(*document, m_defaultColor, m_selectedColor, links);
   }
-}
 
-std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
-{
-  auto document = kdl::mem_lock(m_document);
-  auto links = std::vector<LineVertex>{};
-  Renderer::getLinks(*document, m_defaultColor, m_selectedColor, links);
   return links;
 }
 } // namespace Renderer
@@ -24,10 +24,18 @@
 #include "Renderer/LinkRenderer.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
 {
+namespace Model
+{
+class EntityNode;
+class EntityNodeBase;
+class Node;
+} // namespace Model
+
 namespace View
 {
 class MapDocument; // FIXME: Renderer should not depend on View
@@ -42,13 +50,50 @@ class EntityLinkRenderer : public LinkRenderer
   Color m_defaultColor;
   Color m_selectedColor;
 
+  /**
+   * The link graph that is used to show all links. Maps every entity node to the nodes
+   * it links to or kills, and every node to the entity nodes that link to or kill it.
+   *
+   * The graph is built when it is first needed and then kept up to date by updateNode()
+   * and removeNode(), so that showing all links does not require visiting the entire
+   * map when a node changes.
+   */
+  std::unordered_map<const Model::EntityNode*, std::vector<const Model::EntityNodeBase*>>
+    m_linkTargets;
+  std::unordered_map<const Model::EntityNodeBase*, std::vector<const Model::EntityNode*>>
+    m_linkSources;
+  bool m_linkGraphValid;
+
 public:
   EntityLinkRenderer(std::weak_ptr<View::MapDocument> document);
 
   void setDefaultColor(const Color& color);
   void setSelectedColor(const Color& color);
 
+  /**
+   * Discards the link graph and invalidates this renderer.
+   */
+  void clear();
+
+  /**
+   * Updates the links of the given node and of the entity nodes that link to it or kill
+   * it. Does not invalidate this renderer.
+   */
+  void updateNode(Model::Node* node);
+
+  /**
+   * Removes the links of the given node. Does not invalidate this renderer.
+   */
+  void removeNode(Model::Node* node);
+
 private:
+  void validateLinkGraph();
+  void updateLinkTargets(const Model::EntityNode* entityNode);
+  void updateLinkSources(const Model::EntityNodeBase* node);
+  void setLinkTargets(
+    const Model::EntityNode* entityNode,
+    std::vector<const Model::EntityNodeBase*> targets);
+
   std::vector<LinkRenderer::LineVertex> getLinks() override;
 
   deleteCopy(EntityLinkRenderer);
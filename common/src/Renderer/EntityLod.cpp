@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityLod.h"
+
+#include "Renderer/Camera.h"
+
+#include <vecmath/vec.h>
+
+#include <limits>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+EntityLod::EntityLod() = default;
+
+EntityLod::EntityLod(
+  const Camera& camera,
+  const float minModelSize,
+  const float minBoundsSize,
+  const float minLabelSize)
+  : m_camera{&camera}
+  , m_minModelSize{minModelSize}
+  , m_minBoundsSize{minBoundsSize}
+  , m_minLabelSize{minLabelSize}
+{
+}
+
+bool EntityLod::enabled() const
+{
+  return m_camera != nullptr;
+}
+
+bool EntityLod::showModel(const vm::bbox3& bounds) const
+{
+  return isLargerThan(bounds, m_minModelSize);
+}
+
+bool EntityLod::showBounds(const vm::bbox3& bounds) const
+{
+  return isLargerThan(bounds, m_minBoundsSize);
+}
+
+bool EntityLod::showLabel(const vm::bbox3& bounds) const
+{
+  return isLargerThan(bounds, m_minLabelSize);
+}
+
+bool EntityLod::isLargerThan(const vm::bbox3& bounds, const float minSize) const
+{
+  return !m_camera || minSize <= 0.0f || projectedSize(*m_camera, bounds) >= minSize;
+}
+
+float projectedSize(const Camera& camera, const vm::bbox3& bounds)
+{
+  const auto scalingFactor = camera.perspectiveScalingFactor(vm::vec3f{bounds.center()});
+  if (scalingFactor <= 0.0f)
+  {
+    return std::numeric_limits<float>::max();
+  }
+  return float(vm::length(bounds.size())) / scalingFactor;
+}
+} // namespace Renderer
+} // namespace TrenchBroom
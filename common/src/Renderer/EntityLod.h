@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include <vecmath/bbox.h>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+class Camera;
+
+/**
+ * Decides how much detail is rendered for an entity depending on the size of its bounds
+ * on screen. Models that are too small are replaced by their bounds, bounds that are too
+ * small are replaced by points, and the classname labels of small entities are hidden.
+ *
+ * The sizes are given in pixels. A default constructed LOD renders everything in full
+ * detail.
+ */
+class EntityLod
+{
+private:
+  const Camera* m_camera{nullptr};
+  float m_minModelSize{0.0f};
+  float m_minBoundsSize{0.0f};
+  float m_minLabelSize{0.0f};
+
+public:
+  EntityLod();
+  EntityLod(
+    const Camera& camera, float minModelSize, float minBoundsSize, float minLabelSize);
+
+  bool enabled() const;
+
+  bool showModel(const vm::bbox3& bounds) const;
+  bool showBounds(const vm::bbox3& bounds) const;
+  bool showLabel(const vm::bbox3& bounds) const;
+
+private:
+  bool isLargerThan(const vm::bbox3& bounds, float minSize) const;
+};
+
+/**
+ * Returns the approximate size of the given bounds on screen in pixels, that is, the
+ * length of its diagonal at the distance of its center. Bounds whose center is behind the
+ * camera are considered infinitely large.
+ */
+float projectedSize(const Camera& camera, const vm::bbox3& bounds);
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -32,21 +32,69 @@
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/Camera.h"
+#include "Renderer/GLVertexType.h"
+#include "Renderer/OcclusionCuller.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 #include "Renderer/Transformation.h"
 
 #include <vecmath/mat.h>
 
+#include <array>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+struct InstanceMatrix0Name
+{
+  static inline const auto name = std::string{"InstanceMatrix0"};
+};
+struct InstanceMatrix1Name
+{
+  static inline const auto name = std::string{"InstanceMatrix1"};
+};
+struct InstanceMatrix2Name
+{
+  static inline const auto name = std::string{"InstanceMatrix2"};
+};
+struct InstanceMatrix3Name
+{
+  static inline const auto name = std::string{"InstanceMatrix3"};
+};
+
+// the columns of an instance's model matrix
+using InstanceVertex = GLVertexType<
+  GLVertexAttributeUser<InstanceMatrix0Name, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceMatrix1Name, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceMatrix2Name, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceMatrix3Name, GL_FLOAT, 4, false>>::Vertex;
+
+const auto InstanceAttributeNames = std::array<const std::string*, 4>{
+  &InstanceMatrix0Name::name,
+  &InstanceMatrix1Name::name,
+  &InstanceMatrix2Name::name,
+  &InstanceMatrix3Name::name,
+};
+
+void setInstanceAttributeDivisor(ShaderProgram& program, const GLuint divisor)
+{
+  for (const auto* name : InstanceAttributeNames)
+  {
+    const auto location = program.findAttributeLocation(*name);
+    glAssert(glVertexAttribDivisor(static_cast<GLuint>(location), divisor));
+  }
+}
+} // namespace
+
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
   Assets::EntityModelManager& entityModelManager,
@@ -56,6 +104,7 @@ EntityModelRenderer::EntityModelRenderer(
   , m_editorContext{editorContext}
   , m_applyTinting{false}
   , m_showHiddenEntities{false}
+  , m_useInstancing{false}
 {
 }
 
@@ -118,6 +167,7 @@ void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  m_instanceGroups.clear();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -150,6 +200,16 @@ void EntityModelRenderer::setShowHiddenEntities(const bool showHiddenEntities)
   m_showHiddenEntities = showHiddenEntities;
 }
 
+void EntityModelRenderer::setLod(const EntityLod& lod)
+{
+  m_lod = lod;
+}
+
+void EntityModelRenderer::setOcclusionCuller(const OcclusionCuller* occlusionCuller)
+{
+  m_occlusionCuller = occlusionCuller;
+}
+
 void EntityModelRenderer::render(RenderBatch& renderBatch)
 {
   renderBatch.add(this);
@@ -158,6 +218,58 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
+
+  m_useInstancing = GLEW_VERSION_3_3;
+  if (m_useInstancing)
+  {
+    prepareInstanceGroups(vboManager);
+  }
+}
+
+bool EntityModelRenderer::shouldRender(const Model::EntityNode* entityNode) const
+{
+  const auto& bounds = entityNode->physicalBounds();
+  return (m_showHiddenEntities || m_editorContext.visible(entityNode))
+         && entityNode->entity().model() != nullptr && m_lod.showModel(bounds)
+         && (m_occlusionCuller == nullptr || !m_occlusionCuller->occluded(bounds));
+}
+
+void EntityModelRenderer::prepareInstanceGroups(VboManager& vboManager)
+{
+  // visibility and transformations can change from frame to frame, so the groups are
+  // rebuilt each time; this is cheap compared to issuing a draw call per entity
+  auto groupIndices = std::unordered_map<TexturedRenderer*, size_t>{};
+  auto groupInstances = std::vector<std::vector<InstanceVertex>>{};
+
+  m_instanceGroups.clear();
+  for (const auto& [entityNode, renderer] : m_entities)
+  {
+    if (!shouldRender(entityNode))
+    {
+      continue;
+    }
+
+    const auto* model = entityNode->entity().model();
+
+    const auto [it, inserted] = groupIndices.emplace(renderer, m_instanceGroups.size());
+    if (inserted)
+    {
+      m_instanceGroups.push_back(
+        {renderer, static_cast<int>(model->orientation()), VertexArray{}});
+      groupInstances.emplace_back();
+    }
+
+    const auto transformation = vm::mat4x4f{entityNode->entity().modelTransformation()};
+    groupInstances[it->second].emplace_back(
+      transformation[0], transformation[1], transformation[2], transformation[3]);
+  }
+
+  for (size_t i = 0; i < m_instanceGroups.size(); ++i)
+  {
+    auto& instances = m_instanceGroups[i].instances;
+    instances = VertexArray::move(std::move(groupInstances[i]));
+    instances.prepare(vboManager);
+  }
 }
 
 void EntityModelRenderer::doRender(RenderContext& renderContext)
@@ -188,21 +300,56 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
   shader.set("CameraDirection", renderContext.camera().direction());
   shader.set("CameraRight", renderContext.camera().right());
   shader.set("CameraUp", renderContext.camera().up());
-  shader.set("ViewMatrix", renderContext.camera().viewMatrix());
+  // the model matrix of the render context is not the identity if the entities are
+  // rendered with a transformation, e.g. to preview a transformation of the selection
+  shader.set(
+    "ViewMatrix",
+    renderContext.camera().viewMatrix() * renderContext.transformation().modelMatrix());
 
-  for (const auto& [entityNode, renderer] : m_entities)
+  if (m_useInstancing)
   {
-    if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+    shader.set("UseInstanceMatrix", true);
+    renderInstanceGroups(renderContext, shader);
+  }
+  else
+  {
+    shader.set("UseInstanceMatrix", false);
+    renderEntities(renderContext, shader);
+  }
+}
+
+void EntityModelRenderer::renderInstanceGroups(
+  RenderContext& renderContext, ActiveShader& shader)
+{
+  auto& program = *renderContext.shaderManager().currentProgram();
+
+  for (auto& group : m_instanceGroups)
+  {
+    auto& instances = group.instances;
+    shader.set("Orientation", group.orientation);
+
+    if (instances.setup())
     {
-      continue;
+      setInstanceAttributeDivisor(program, 1);
+      group.renderer->renderInstanced(instances.vertexCount());
+      setInstanceAttributeDivisor(program, 0);
+      instances.cleanup();
     }
+  }
+}
 
-    const auto* model = entityNode->entity().model();
-    if (!model)
+void EntityModelRenderer::renderEntities(
+  RenderContext& renderContext, ActiveShader& shader)
+{
+  for (const auto& [entityNode, renderer] : m_entities)
+  {
+    if (!shouldRender(entityNode))
     {
       continue;
     }
 
+    const auto* model = entityNode->entity().model();
+
     shader.set("Orientation", static_cast<int>(model->orientation()));
 
     const auto transformation = vm::mat4x4f{entityNode->entity().modelTransformation()};
@@ -20,9 +20,12 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/EntityLod.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/VertexArray.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -41,6 +44,8 @@ class EntityNode;
 
 namespace Renderer
 {
+class ActiveShader;
+class OcclusionCuller;
 class RenderBatch;
 class ShaderConfig;
 class TexturedRenderer;
@@ -60,6 +65,24 @@ private:
 
   bool m_showHiddenEntities;
 
+  EntityLod m_lod;
+  const OcclusionCuller* m_occlusionCuller{nullptr};
+
+  /**
+   * The visible entities that share a model frame and skin, and thus a renderer. Their
+   * model matrices are stored in a per instance vertex array so that they can be drawn
+   * with a single instanced draw call.
+   */
+  struct InstanceGroup
+  {
+    TexturedRenderer* renderer;
+    int orientation;
+    VertexArray instances;
+  };
+
+  bool m_useInstancing;
+  std::vector<InstanceGroup> m_instanceGroups;
+
 public:
   EntityModelRenderer(
     Logger& logger,
@@ -107,11 +130,30 @@ public:
   bool showHiddenEntities() const;
   void setShowHiddenEntities(bool showHiddenEntities);
 
+  /**
+   * Sets the LOD that decides which models are too small to be rendered. Since this
+   * renderer is shared by all views, the LOD must be set whenever it is rendered.
+   */
+  void setLod(const EntityLod& lod);
+
+  /**
+   * Sets the culler that decides which models are hidden behind other objects, or
+   * nullptr to render all models. Like the LOD, this must be set whenever this renderer
+   * is rendered.
+   */
+  void setOcclusionCuller(const OcclusionCuller* occlusionCuller);
+
   void render(RenderBatch& renderBatch);
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+
+  bool shouldRender(const Model::EntityNode* entityNode) const;
+
+  void prepareInstanceGroups(VboManager& vboManager);
+  void renderInstanceGroups(RenderContext& renderContext, ActiveShader& shader);
+  void renderEntities(RenderContext& renderContext, ActiveShader& shader);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
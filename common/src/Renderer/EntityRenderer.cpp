@@ -29,6 +29,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/Camera.h"
+#include "Renderer/EntityLod.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/RenderBatch.h"
@@ -42,12 +43,36 @@
 #include <vecmath/scalar.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+// solid bounds are rendered as quads with four vertices per face
+constexpr auto SolidBoundsVertexCount = size_t(24);
+
+// wireframe bounds are rendered as lines with two vertices per edge
+constexpr auto WireframeBoundsVertexCount = size_t(24);
+
+EntityLod makeEntityLod(const RenderContext& renderContext)
+{
+  if (!renderContext.render3D() || !pref(Preferences::EnableEntityLod))
+  {
+    return EntityLod{};
+  }
+
+  return EntityLod{
+    renderContext.camera(),
+    float(pref(Preferences::EntityLodModelSize)),
+    float(pref(Preferences::EntityLodBoundsSize)),
+    float(pref(Preferences::EntityLodLabelSize))};
+}
+} // namespace
+
 class EntityRenderer::EntityClassnameAnchor : public TextAnchor3D
 {
 private:
@@ -86,6 +111,7 @@ EntityRenderer::EntityRenderer(
   , m_showOccludedBounds(false)
   , m_showAngles(false)
   , m_showHiddenEntities(false)
+  , m_occlusionCuller(nullptr)
 {
 }
 
@@ -98,9 +124,8 @@ void EntityRenderer::invalidate()
 void EntityRenderer::clear()
 {
   m_entities.clear();
-  m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer();
-  m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer();
-  m_solidBoundsRenderer = TriangleRenderer();
+  m_invalidEntityBounds.clear();
+  resetBounds();
   m_modelRenderer.clear();
 }
 
@@ -114,7 +139,7 @@ void EntityRenderer::addEntity(const Model::EntityNode* entity)
   if (m_entities.insert(entity).second)
   {
     m_modelRenderer.addEntity(entity);
-    invalidateBounds();
+    invalidateEntityBounds(entity);
   }
 }
 
@@ -124,14 +149,18 @@ void EntityRenderer::removeEntity(const Model::EntityNode* entity)
   {
     m_entities.erase(it);
     m_modelRenderer.removeEntity(entity);
-    invalidateBounds();
+    m_invalidEntityBounds.erase(entity);
+    if (m_boundsValid)
+    {
+      removeEntityBounds(entity);
+    }
   }
 }
 
 void EntityRenderer::invalidateEntity(const Model::EntityNode* entity)
 {
   m_modelRenderer.updateEntity(entity);
-  invalidateBounds();
+  invalidateEntityBounds(entity);
 }
 
 void EntityRenderer::setShowOverlays(const bool showOverlays)
@@ -166,12 +195,25 @@ void EntityRenderer::setTintColor(const Color& tintColor)
 
 void EntityRenderer::setOverrideBoundsColor(const bool overrideBoundsColor)
 {
-  m_overrideBoundsColor = overrideBoundsColor;
+  if (overrideBoundsColor != m_overrideBoundsColor)
+  {
+    // the overriding color also applies to the wireframes of point entities without
+    // models
+    m_overrideBoundsColor = overrideBoundsColor;
+    invalidateBounds();
+  }
 }
 
 void EntityRenderer::setBoundsColor(const Color& boundsColor)
 {
-  m_boundsColor = boundsColor;
+  if (boundsColor != m_boundsColor)
+  {
+    m_boundsColor = boundsColor;
+    if (!m_overrideBoundsColor)
+    {
+      invalidateBounds();
+    }
+  }
 }
 
 void EntityRenderer::setShowOccludedBounds(const bool showOccludedBounds)
@@ -199,21 +241,30 @@ void EntityRenderer::setShowHiddenEntities(const bool showHiddenEntities)
   m_showHiddenEntities = showHiddenEntities;
 }
 
+void EntityRenderer::setOcclusionCuller(const OcclusionCuller* occlusionCuller)
+{
+  m_occlusionCuller = occlusionCuller;
+}
+
 void EntityRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   if (!m_entities.empty())
   {
-    renderBounds(renderContext, renderBatch);
-    renderModels(renderContext, renderBatch);
-    renderClassnames(renderContext, renderBatch);
+    const auto lod = makeEntityLod(renderContext);
+    renderBounds(renderContext, renderBatch, lod);
+    renderModels(renderContext, renderBatch, lod);
+    renderClassnames(renderContext, renderBatch, lod);
     renderAngles(renderContext, renderBatch);
   }
 }
 
-void EntityRenderer::renderBounds(RenderContext& renderContext, RenderBatch& renderBatch)
+void EntityRenderer::renderBounds(
+  RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod)
 {
-  if (!m_boundsValid)
+  if (!m_boundsValid || !m_invalidEntityBounds.empty())
+  {
     validateBounds();
+  }
 
   if (renderContext.showPointEntityBounds())
   {
@@ -225,7 +276,7 @@ void EntityRenderer::renderBounds(RenderContext& renderContext, RenderBatch& ren
   }
 
   if (m_showHiddenEntities || renderContext.showPointEntities())
-    renderSolidBounds(renderBatch);
+    renderSolidBounds(renderContext, renderBatch, lod);
 }
 
 void EntityRenderer::renderPointEntityWireframeBounds(RenderBatch& renderBatch)
@@ -250,19 +301,63 @@ void EntityRenderer::renderBrushEntityWireframeBounds(RenderBatch& renderBatch)
     renderBatch, m_overrideBoundsColor, m_boundsColor);
 }
 
-void EntityRenderer::renderSolidBounds(RenderBatch& renderBatch)
+void EntityRenderer::renderSolidBounds(
+  RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod)
 {
+  // the solid bounds are shared by all views, so only the rendered ranges are chosen
+  // here; consecutive boxes are merged into one range
+  const auto renderModels = shouldRenderModels(renderContext);
+
+  auto indexRanges = IndexRangeMap{};
+  auto quadsIndex = size_t(0);
+  auto quadsCount = size_t(0);
+  for (const auto& solidBounds : m_solidBounds)
+  {
+    const auto* entityNode = solidBounds.entityNode;
+    if (
+      solidBounds.hasModel
+      && (!renderModels || lod.showModel(entityNode->physicalBounds())))
+    {
+      continue;
+    }
+
+    if (lod.showBounds(entityNode->logicalBounds()))
+    {
+      if (quadsIndex + quadsCount != solidBounds.index)
+      {
+        if (quadsCount > 0)
+        {
+          indexRanges.add(PrimType::Quads, quadsIndex, quadsCount);
+        }
+        quadsIndex = solidBounds.index;
+        quadsCount = 0;
+      }
+      quadsCount += SolidBoundsVertexCount;
+    }
+    else
+    {
+      // the corners of one face are enough to mark an entity that is this small
+      indexRanges.add(PrimType::Points, solidBounds.index, 4);
+    }
+  }
+  if (quadsCount > 0)
+  {
+    indexRanges.add(PrimType::Quads, quadsIndex, quadsCount);
+  }
+
+  m_solidBoundsRenderer.setIndexRanges(std::move(indexRanges));
   m_solidBoundsRenderer.setApplyTinting(m_tint);
   m_solidBoundsRenderer.setTintColor(m_tintColor);
   renderBatch.add(&m_solidBoundsRenderer);
 }
 
-void EntityRenderer::renderModels(RenderContext& renderContext, RenderBatch& renderBatch)
+void EntityRenderer::renderModels(
+  RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod)
 {
-  if (
-    m_showHiddenEntities
-    || (renderContext.showPointEntities() && renderContext.showPointEntityModels()))
+  if (shouldRenderModels(renderContext))
   {
+    m_modelRenderer.setLod(lod);
+    m_modelRenderer.setOcclusionCuller(m_occlusionCuller);
     m_modelRenderer.setApplyTinting(m_tint);
     m_modelRenderer.setTintColor(m_tintColor);
     m_modelRenderer.setShowHiddenEntities(m_showHiddenEntities);
@@ -271,7 +366,7 @@ void EntityRenderer::renderModels(RenderContext& renderContext, RenderBatch& ren
 }
 
 void EntityRenderer::renderClassnames(
-  RenderContext& renderContext, RenderBatch& renderBatch)
+  RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod)
 {
   if (m_showOverlays && renderContext.showEntityClassnames())
   {
@@ -281,7 +376,9 @@ void EntityRenderer::renderClassnames(
 
     for (const Model::EntityNode* entity : m_entities)
     {
-      if (m_showHiddenEntities || m_editorContext.visible(entity))
+      if (
+        (m_showHiddenEntities || m_editorContext.visible(entity))
+        && lod.showLabel(entity->logicalBounds()))
       {
         if (
           entity->containingGroup() == nullptr
@@ -356,6 +453,12 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
   }
 }
 
+bool EntityRenderer::shouldRenderModels(const RenderContext& renderContext) const
+{
+  return m_showHiddenEntities
+         || (renderContext.showPointEntities() && renderContext.showPointEntityModels());
+}
+
 std::vector<vm::vec3f> EntityRenderer::arrowHead(
   const float length, const float width) const
 {
@@ -415,124 +518,144 @@ struct EntityRenderer::BuildColoredWireframeBoundsVertices
   }
 };
 
-struct EntityRenderer::BuildWireframeBoundsVertices
+void EntityRenderer::invalidateBounds()
 {
-  std::vector<GLVertexTypes::P3::Vertex>& vertices;
+  m_boundsValid = false;
+  m_invalidEntityBounds.clear();
+}
 
-  explicit BuildWireframeBoundsVertices(
-    std::vector<GLVertexTypes::P3::Vertex>& i_vertices)
-    : vertices(i_vertices)
+void EntityRenderer::invalidateEntityBounds(const Model::EntityNode* entityNode)
+{
+  if (m_boundsValid)
   {
+    m_invalidEntityBounds.insert(entityNode);
   }
+}
 
-  void operator()(const vm::vec3& v1, const vm::vec3& v2)
+void EntityRenderer::validateBounds()
+{
+  if (!m_boundsValid)
   {
-    vertices.emplace_back(vm::vec3f(v1));
-    vertices.emplace_back(vm::vec3f(v2));
+    resetBounds();
+    for (const auto* entityNode : m_entities)
+    {
+      addEntityBounds(entityNode);
+    }
   }
-};
+  else
+  {
+    for (const auto* entityNode : m_invalidEntityBounds)
+    {
+      removeEntityBounds(entityNode);
+      if (m_entities.find(entityNode) != std::end(m_entities))
+      {
+        addEntityBounds(entityNode);
+      }
+    }
+  }
+  m_invalidEntityBounds.clear();
 
-void EntityRenderer::invalidateBounds()
-{
-  m_boundsValid = false;
+  m_solidBounds.clear();
+  for (const auto& [entityNode, entityBounds] : m_entityBounds)
+  {
+    if (entityBounds.solidBlock != nullptr)
+    {
+      const auto hasModel = entityNode->entity().model() != nullptr;
+      m_solidBounds.push_back({entityNode, entityBounds.solidBlock->pos, hasModel});
+    }
+  }
+
+  // sorting the boxes by their position allows merging them into few ranges
+  std::sort(
+    std::begin(m_solidBounds),
+    std::end(m_solidBounds),
+    [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
+
+  // the renderers share the vertex holders, so only the changed blocks are uploaded; the
+  // zeroed vertices of free blocks form degenerate lines
+  m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer(
+    VertexArray::shared(m_pointEntityWireframeBounds->vertexHolder()), PrimType::Lines);
+  m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer(
+    VertexArray::shared(m_brushEntityWireframeBounds->vertexHolder()), PrimType::Lines);
+  m_solidBoundsRenderer = TriangleRenderer(
+    VertexArray::shared(m_solidBoundsVertices->vertexHolder()), PrimType::Quads);
+  m_boundsValid = true;
 }
 
-void EntityRenderer::validateBounds()
+void EntityRenderer::addEntityBounds(const Model::EntityNode* entityNode)
 {
-  std::vector<GLVertexTypes::P3NC4::Vertex> solidVertices;
-  solidVertices.reserve(36 * m_entities.size());
+  if (!m_editorContext.visible(entityNode))
+  {
+    return;
+  }
+
+  const auto pointEntity = !entityNode->hasChildren();
+  auto entityBounds = EntityBounds{pointEntity, nullptr, nullptr};
 
-  if (m_overrideBoundsColor)
+  if (pointEntity)
   {
-    using Vertex = GLVertexTypes::P3::Vertex;
-    std::vector<Vertex> pointEntityWireframeVertices;
-    std::vector<Vertex> brushEntityWireframeVertices;
+    auto vertices = std::vector<SolidBoundsVertex>{};
+    vertices.reserve(SolidBoundsVertexCount);
 
-    pointEntityWireframeVertices.reserve(24 * m_entities.size());
-    brushEntityWireframeVertices.reserve(24 * m_entities.size());
+    auto builder = BuildColoredSolidBoundsVertices{vertices, boundsColor(entityNode)};
+    entityNode->logicalBounds().for_each_face(builder);
 
-    BuildWireframeBoundsVertices pointEntityWireframeBoundsBuilder(
-      pointEntityWireframeVertices);
-    BuildWireframeBoundsVertices brushEntityWireframeBoundsBuilder(
-      brushEntityWireframeVertices);
+    auto [block, dest] = m_solidBoundsVertices->allocateBlock(vertices.size());
+    std::copy(std::begin(vertices), std::end(vertices), dest);
+    entityBounds.solidBlock = block;
+  }
 
-    for (const Model::EntityNode* entityNode : m_entities)
-    {
-      if (m_editorContext.visible(entityNode))
-      {
-        const bool pointEntity = !entityNode->hasChildren();
-        if (pointEntity)
-        {
-          entityNode->logicalBounds().for_each_edge(pointEntityWireframeBoundsBuilder);
-        }
-        else
-        {
-          entityNode->logicalBounds().for_each_edge(brushEntityWireframeBoundsBuilder);
-        }
+  // unless the color is overridden, point entities without models only show solid bounds
+  if (m_overrideBoundsColor || !pointEntity || entityNode->entity().model() != nullptr)
+  {
+    auto vertices = std::vector<WireframeBoundsVertex>{};
+    vertices.reserve(WireframeBoundsVertexCount);
 
-        if (pointEntity && entityNode->entity().model() == nullptr)
-        {
-          BuildColoredSolidBoundsVertices solidBoundsBuilder(
-            solidVertices, boundsColor(entityNode));
-          entityNode->logicalBounds().for_each_face(solidBoundsBuilder);
-        }
-      }
-    }
+    auto builder = BuildColoredWireframeBoundsVertices{vertices, boundsColor(entityNode)};
+    entityNode->logicalBounds().for_each_edge(builder);
 
-    m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(pointEntityWireframeVertices)), PrimType::Lines);
-    m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(brushEntityWireframeVertices)), PrimType::Lines);
+    auto& wireframeBounds =
+      pointEntity ? *m_pointEntityWireframeBounds : *m_brushEntityWireframeBounds;
+    auto [block, dest] = wireframeBounds.allocateBlock(vertices.size());
+    std::copy(std::begin(vertices), std::end(vertices), dest);
+    entityBounds.wireframeBlock = block;
   }
-  else
-  {
-    using Vertex = GLVertexTypes::P3C4::Vertex;
-    std::vector<Vertex> pointEntityWireframeVertices;
-    std::vector<Vertex> brushEntityWireframeVertices;
 
-    pointEntityWireframeVertices.reserve(24 * m_entities.size());
-    brushEntityWireframeVertices.reserve(24 * m_entities.size());
+  m_entityBounds.emplace(entityNode, entityBounds);
+}
 
-    for (const Model::EntityNode* entityNode : m_entities)
+void EntityRenderer::removeEntityBounds(const Model::EntityNode* entityNode)
+{
+  if (auto it = m_entityBounds.find(entityNode); it != std::end(m_entityBounds))
+  {
+    const auto& entityBounds = it->second;
+    if (entityBounds.wireframeBlock != nullptr)
     {
-      if (m_editorContext.visible(entityNode))
-      {
-        const bool pointEntity = !entityNode->hasChildren();
-
-        if (pointEntity && entityNode->entity().model() == nullptr)
-        {
-          BuildColoredSolidBoundsVertices solidBoundsBuilder(
-            solidVertices, boundsColor(entityNode));
-          entityNode->logicalBounds().for_each_face(solidBoundsBuilder);
-        }
-        else
-        {
-          BuildColoredWireframeBoundsVertices pointEntityWireframeBoundsBuilder(
-            pointEntityWireframeVertices, boundsColor(entityNode));
-          BuildColoredWireframeBoundsVertices brushEntityWireframeBoundsBuilder(
-            brushEntityWireframeVertices, boundsColor(entityNode));
-
-          if (pointEntity)
-          {
-            entityNode->logicalBounds().for_each_edge(pointEntityWireframeBoundsBuilder);
-          }
-          else
-          {
-            entityNode->logicalBounds().for_each_edge(brushEntityWireframeBoundsBuilder);
-          }
-        }
-      }
+      auto& wireframeBounds = entityBounds.pointEntity ? *m_pointEntityWireframeBounds
+                                                       : *m_brushEntityWireframeBounds;
+      wireframeBounds.freeBlock(entityBounds.wireframeBlock);
     }
-
-    m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(pointEntityWireframeVertices)), PrimType::Lines);
-    m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(brushEntityWireframeVertices)), PrimType::Lines);
+    if (entityBounds.solidBlock != nullptr)
+    {
+      m_solidBoundsVertices->freeBlock(entityBounds.solidBlock);
+    }
+    m_entityBounds.erase(it);
   }
+}
 
-  m_solidBoundsRenderer =
-    TriangleRenderer(VertexArray::move(std::move(solidVertices)), PrimType::Quads);
-  m_boundsValid = true;
+void EntityRenderer::resetBounds()
+{
+  m_pointEntityWireframeBounds =
+    std::make_unique<VertexBlockArray<WireframeBoundsVertex>>();
+  m_brushEntityWireframeBounds =
+    std::make_unique<VertexBlockArray<WireframeBoundsVertex>>();
+  m_solidBoundsVertices = std::make_unique<VertexBlockArray<SolidBoundsVertex>>();
+  m_entityBounds.clear();
+
+  m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer();
+  m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer();
+  m_solidBoundsRenderer = TriangleRenderer();
+  m_solidBounds.clear();
 }
 
 AttrString EntityRenderer::entityString(const Model::EntityNode* entityNode) const
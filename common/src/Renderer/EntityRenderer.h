@@ -20,8 +20,11 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
+#include "Renderer/BrushRendererArrays.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/EntityModelRenderer.h"
+#include "Renderer/GLVertexType.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/TriangleRenderer.h"
 
@@ -29,6 +32,9 @@
 
 #include <vecmath/forward.h>
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -49,6 +55,7 @@ class EntityNode;
 namespace Renderer
 {
 class AttrString;
+class OcclusionCuller;
 
 class EntityRenderer
 {
@@ -59,10 +66,46 @@ private:
   const Model::EditorContext& m_editorContext;
   kdl::vector_set<const Model::EntityNode*> m_entities;
 
+  using WireframeBoundsVertex = GLVertexTypes::P3C4::Vertex;
+  using SolidBoundsVertex = GLVertexTypes::P3NC4::Vertex;
+
+  /**
+   * The bounds vertices of every entity are stored in blocks of these arrays, so that
+   * changing an entity only rewrites and uploads its own blocks.
+   */
+  std::unique_ptr<VertexBlockArray<WireframeBoundsVertex>> m_pointEntityWireframeBounds;
+  std::unique_ptr<VertexBlockArray<WireframeBoundsVertex>> m_brushEntityWireframeBounds;
+  std::unique_ptr<VertexBlockArray<SolidBoundsVertex>> m_solidBoundsVertices;
+
+  /**
+   * The blocks allocated for an entity's bounds. Either block can be null.
+   */
+  struct EntityBounds
+  {
+    bool pointEntity;
+    AllocationTracker::Block* wireframeBlock;
+    AllocationTracker::Block* solidBlock;
+  };
+
+  std::unordered_map<const Model::EntityNode*, EntityBounds> m_entityBounds;
+  std::unordered_set<const Model::EntityNode*> m_invalidEntityBounds;
+
   DirectEdgeRenderer m_pointEntityWireframeBoundsRenderer;
   DirectEdgeRenderer m_brushEntityWireframeBoundsRenderer;
 
+  /**
+   * An entity whose bounds are rendered as a solid box. The boxes of entities with models
+   * are only rendered if the models are too small, see EntityLod.
+   */
+  struct SolidBounds
+  {
+    const Model::EntityNode* entityNode;
+    size_t index;
+    bool hasModel;
+  };
+
   TriangleRenderer m_solidBoundsRenderer;
+  std::vector<SolidBounds> m_solidBounds;
   EntityModelRenderer m_modelRenderer;
   bool m_boundsValid;
 
@@ -79,6 +122,7 @@ private:
   bool m_showAngles;
   Color m_angleColor;
   bool m_showHiddenEntities;
+  const OcclusionCuller* m_occlusionCuller;
 
 public:
   EntityRenderer(
@@ -130,25 +174,46 @@ public:
 
   void setShowHiddenEntities(bool showHiddenEntities);
 
+  /**
+   * Sets the culler that decides which entity models are hidden behind other objects, or
+   * nullptr to render all models. The culler must remain valid until this function is
+   * called again.
+   */
+  void setOcclusionCuller(const OcclusionCuller* occlusionCuller);
+
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
-  void renderBounds(RenderContext& renderContext, RenderBatch& renderBatch);
+  void renderBounds(
+    RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod);
   void renderPointEntityWireframeBounds(RenderBatch& renderBatch);
   void renderBrushEntityWireframeBounds(RenderBatch& renderBatch);
-  void renderSolidBounds(RenderBatch& renderBatch);
-  void renderModels(RenderContext& renderContext, RenderBatch& renderBatch);
-  void renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch);
+  void renderSolidBounds(
+    RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod);
+  void renderModels(
+    RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod);
+  void renderClassnames(
+    RenderContext& renderContext, RenderBatch& renderBatch, const EntityLod& lod);
   void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
+  bool shouldRenderModels(const RenderContext& renderContext) const;
   std::vector<vm::vec3f> arrowHead(float length, float width) const;
 
   struct BuildColoredSolidBoundsVertices;
   struct BuildColoredWireframeBoundsVertices;
-  struct BuildWireframeBoundsVertices;
 
+  /**
+   * Causes the bounds of all entities to be rebuilt on the next render() call.
+   */
   void invalidateBounds();
+  /**
+   * Causes the bounds of the given entity to be rebuilt on the next render() call.
+   */
+  void invalidateEntityBounds(const Model::EntityNode* entityNode);
   void validateBounds();
+  void addEntityBounds(const Model::EntityNode* entityNode);
+  void removeEntityBounds(const Model::EntityNode* entityNode);
+  void resetBounds();
 
   AttrString entityString(const Model::EntityNode* entityNode) const;
   const Color& boundsColor(const Model::EntityNode* entityNode) const;
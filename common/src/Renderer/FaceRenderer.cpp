@@ -42,26 +42,41 @@ struct FaceRenderer::RenderFunc : public TextureRenderFunc
   bool applyTexture;
   const Color& defaultColor;
 
+  // the uniforms that are set once per texture are looked up only once per render pass
+  GLint applyTextureLocation;
+  GLint colorLocation;
+  GLint gridColorLocation;
+  GLint enableMaskedLocation;
+
   RenderFunc(
     ActiveShader& i_shader, const bool i_applyTexture, const Color& i_defaultColor)
     : shader(i_shader)
     , applyTexture(i_applyTexture)
     , defaultColor(i_defaultColor)
+    , applyTextureLocation(shader.findUniformLocation("ApplyTexture"))
+    , colorLocation(shader.findUniformLocation("Color"))
+    , gridColorLocation(shader.findUniformLocation("GridColor"))
+    , enableMaskedLocation(shader.findUniformLocation("EnableMasked"))
   {
   }
 
   void before(const Assets::Texture* texture) override
   {
+    // set any per-texture uniforms
+    shader.set(gridColorLocation, gridColorForTexture(texture));
+    shader.set(enableMaskedLocation, texture != nullptr && texture->masked());
+
     if (texture != nullptr)
     {
       texture->activate();
-      shader.set("ApplyTexture", applyTexture);
-      shader.set("Color", texture->averageColor());
+      // textures that are not uploaded yet are rendered using their average color
+      shader.set(applyTextureLocation, applyTexture && texture->isPrepared());
+      shader.set(colorLocation, texture->averageColor());
     }
     else
     {
-      shader.set("ApplyTexture", false);
-      shader.set("Color", defaultColor);
+      shader.set(applyTextureLocation, false);
+      shader.set(colorLocation, defaultColor);
     }
   }
 
@@ -210,17 +225,11 @@ void FaceRenderer::doRender(RenderContext& context)
     }
     for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap)
     {
-      if (!brushIndexHolderPtr->hasValidIndices())
+      if (!brushIndexHolderPtr->hasIndicesToRender())
       {
         continue;
       }
 
-      const bool enableMasked = texture != nullptr && texture->masked();
-
-      // set any per-texture uniforms
-      shader.set("GridColor", gridColorForTexture(texture));
-      shader.set("EnableMasked", enableMasked);
-
       func.before(texture);
       brushIndexHolderPtr->setupIndices();
       brushIndexHolderPtr->render(PrimType::Triangles);
@@ -22,11 +22,12 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include <kdl/flat_hash_map.h>
+
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
 #include <memory>
-#include <unordered_map>
 
 namespace TrenchBroom
 {
@@ -47,7 +48,7 @@ private:
   struct RenderFunc;
 
   using TextureToBrushIndicesMap =
-    const std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+    const kdl::flat_hash_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
@@ -19,17 +19,32 @@
 
 #include "FontFactory.h"
 
+#include "IO/FontAtlasCache.h"
 #include "Renderer/TextureFont.h"
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+FontFactory::FontFactory() = default;
+
 FontFactory::~FontFactory() = default;
 
+void FontFactory::setCacheDirectory(const std::filesystem::path& cacheDirectory)
+{
+  m_atlasCache = !cacheDirectory.empty()
+                   ? std::make_unique<IO::FontAtlasCache>(cacheDirectory)
+                   : nullptr;
+}
+
 std::unique_ptr<TextureFont> FontFactory::createFont(const FontDescriptor& fontDescriptor)
 {
   return doCreateFont(fontDescriptor);
 }
+
+const IO::FontAtlasCache* FontFactory::atlasCache() const
+{
+  return m_atlasCache.get();
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -19,10 +19,16 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
 
 namespace TrenchBroom
 {
+namespace IO
+{
+class FontAtlasCache;
+}
+
 namespace Renderer
 {
 class FontDescriptor;
@@ -38,11 +44,24 @@ protected:
     size_t lineHeight;
   };
 
+private:
+  std::unique_ptr<IO::FontAtlasCache> m_atlasCache;
+
 public:
+  FontFactory();
   virtual ~FontFactory();
 
+  /**
+   * Sets the directory where rasterized fonts are cached. An empty path disables the
+   * cache.
+   */
+  void setCacheDirectory(const std::filesystem::path& cacheDirectory);
+
   std::unique_ptr<TextureFont> createFont(const FontDescriptor& fontDescriptor);
 
+protected:
+  const IO::FontAtlasCache* atlasCache() const;
+
 private:
   virtual std::unique_ptr<TextureFont> doCreateFont(
     const FontDescriptor& fontDescriptor) = 0;
@@ -77,6 +77,26 @@ void FontGlyph::appendVertices(
   }
 }
 
+float FontGlyph::x() const
+{
+  return m_x;
+}
+
+float FontGlyph::y() const
+{
+  return m_y;
+}
+
+float FontGlyph::width() const
+{
+  return m_w;
+}
+
+float FontGlyph::height() const
+{
+  return m_h;
+}
+
 int FontGlyph::advance() const
 {
   return m_a;
@@ -45,6 +45,10 @@ public:
     int yOffset,
     size_t textureSize,
     bool clockwise) const;
+  float x() const;
+  float y() const;
+  float width() const;
+  float height() const;
   int advance() const;
 };
 } // namespace Renderer
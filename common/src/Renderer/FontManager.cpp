@@ -36,6 +36,11 @@ FontManager::FontManager()
 
 FontManager::~FontManager() = default;
 
+void FontManager::setCacheDirectory(const std::filesystem::path& cacheDirectory)
+{
+  m_factory->setCacheDirectory(cacheDirectory);
+}
+
 void FontManager::clearCache()
 {
   m_cache.clear();
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -43,6 +44,11 @@ public:
   FontManager();
   ~FontManager();
 
+  /**
+   * Sets the directory where rasterized fonts are cached, see FontFactory.
+   */
+  void setCacheDirectory(const std::filesystem::path& cacheDirectory);
+
   TextureFont& font(const FontDescriptor& fontDescriptor);
   FontDescriptor selectFontSize(
     const FontDescriptor& fontDescriptor,
@@ -47,6 +47,15 @@ FontTexture::FontTexture(
   std::memset(m_buffer, 0, m_size * m_size);
 }
 
+FontTexture::FontTexture(const size_t size, const unsigned char* buffer)
+  : m_size(size)
+  , m_buffer(nullptr)
+  , m_textureId(0)
+{
+  m_buffer = new char[m_size * m_size];
+  std::memcpy(m_buffer, buffer, m_size * m_size);
+}
+
 FontTexture::FontTexture(const FontTexture& other)
   : m_size(other.m_size)
   , m_buffer(nullptr)
@@ -82,6 +91,11 @@ size_t FontTexture::size() const
   return m_size;
 }
 
+const char* FontTexture::buffer() const
+{
+  return m_buffer;
+}
+
 void FontTexture::activate()
 {
   if (m_textureId == 0)
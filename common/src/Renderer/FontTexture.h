@@ -39,12 +39,18 @@ private:
 public:
   FontTexture();
   FontTexture(size_t cellCount, size_t cellSize, size_t margin);
+  FontTexture(size_t size, const unsigned char* buffer);
   FontTexture(const FontTexture& other);
   FontTexture& operator=(FontTexture other);
   ~FontTexture();
 
   size_t size() const;
 
+  /**
+   * Returns the texture's pixels, or nullptr if they were already uploaded.
+   */
+  const char* buffer() const;
+
   void activate();
   void deactivate();
 
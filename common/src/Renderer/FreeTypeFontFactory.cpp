@@ -21,19 +21,25 @@
 
 #include "Error.h"
 #include "Exceptions.h"
+#include "IO/ContentHash.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
+#include "IO/FontAtlasCache.h"
 #include "IO/Reader.h"
 #include "IO/SystemPaths.h"
-#include "Macros.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/FontGlyph.h"
 #include "Renderer/FontGlyphBuilder.h"
 #include "Renderer/FontTexture.h"
 #include "Renderer/TextureFont.h"
 
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
 #include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -59,46 +65,82 @@ FreeTypeFontFactory::~FreeTypeFontFactory()
   }
 }
 
+namespace
+{
+std::string atlasName(const FontDescriptor& fontDescriptor)
+{
+  return fontDescriptor.path().stem().string() + "-"
+         + std::to_string(fontDescriptor.size()) + "-"
+         + std::to_string(fontDescriptor.minChar()) + "-"
+         + std::to_string(fontDescriptor.maxChar());
+}
+
+std::string atlasKey(
+  const IO::BufferedReader& fontReader, const FontDescriptor& fontDescriptor)
+{
+  return std::to_string(IO::hashContents(fontReader.stringView())) + ":"
+         + std::to_string(fontReader.size()) + ":" + atlasName(fontDescriptor);
+}
+
+std::unique_ptr<TextureFont> createFontFromAtlas(
+  const IO::FontAtlas& atlas, const FontDescriptor& fontDescriptor)
+{
+  auto texture = std::make_unique<FontTexture>(atlas.textureSize, atlas.texture.data());
+  auto glyphs = kdl::vec_transform(atlas.glyphs, [](const auto& glyph) {
+    return FontGlyph{glyph.x, glyph.y, glyph.width, glyph.height, glyph.advance};
+  });
+
+  return std::make_unique<TextureFont>(
+    std::move(texture),
+    glyphs,
+    atlas.lineHeight,
+    fontDescriptor.minChar(),
+    fontDescriptor.charCount());
+}
+} // namespace
+
 std::unique_ptr<TextureFont> FreeTypeFontFactory::doCreateFont(
   const FontDescriptor& fontDescriptor)
 {
-  auto [face, bufferedReader] = loadFont(fontDescriptor);
-  auto font = buildFont(face, fontDescriptor.minChar(), fontDescriptor.charCount());
+  const auto reader = readFont(fontDescriptor);
+  const auto* cache = atlasCache();
+  const auto name = atlasName(fontDescriptor);
+  const auto key = cache ? atlasKey(reader, fontDescriptor) : std::string{};
+
+  if (cache)
+  {
+    if (const auto atlas = cache->readAtlas(name, key))
+    {
+      return createFontFromAtlas(*atlas, fontDescriptor);
+    }
+  }
+
+  // the reader must outlive the face because FreeType does not copy the font data
+  auto face = loadFace(reader, fontDescriptor);
+  const auto atlas =
+    buildAtlas(face, fontDescriptor.minChar(), fontDescriptor.charCount());
   FT_Done_Face(face);
 
-  // NOTE: bufferedReader is returned from loadFont() just to keep the buffer from
-  // being deallocated until after we call FT_Done_Face
-  unused(bufferedReader);
+  if (cache)
+  {
+    // the cache is optional, so failing to write to it is not an error
+    cache->writeAtlas(name, key, atlas).or_else([](auto) {
+      return kdl::void_success;
+    });
+  }
 
-  return font;
+  return createFontFromAtlas(atlas, fontDescriptor);
 }
 
-std::pair<FT_Face, IO::BufferedReader> FreeTypeFontFactory::loadFont(
-  const FontDescriptor& fontDescriptor)
+IO::BufferedReader FreeTypeFontFactory::readFont(
+  const FontDescriptor& fontDescriptor) const
 {
   const auto fontPath = fontDescriptor.path().is_absolute()
                           ? fontDescriptor.path()
                           : IO::SystemPaths::findResourceFile(fontDescriptor.path());
 
   return IO::Disk::openFile(fontPath)
-    .and_then([&](auto file) -> Result<std::pair<FT_Face, IO::BufferedReader>> {
-      auto reader = file->reader().buffer();
-
-      auto face = FT_Face{};
-      const auto error = FT_New_Memory_Face(
-        m_library,
-        reinterpret_cast<const FT_Byte*>(reader.begin()),
-        FT_Long(reader.size()),
-        0,
-        &face);
-      if (error)
-      {
-        return Error{"FT_New_Memory_Face returned " + std::to_string(error)};
-      }
-
-      FT_Set_Pixel_Sizes(face, 0, FT_UInt(fontDescriptor.size()));
-      return std::pair{face, std::move(reader)};
-    })
+    .transform([](auto file) { return file->reader().buffer(); })
     .if_error([&](auto e) {
       throw RenderException{
         "Error loading font '" + fontDescriptor.name() + "': " + e.msg};
@@ -106,43 +148,70 @@ std::pair<FT_Face, IO::BufferedReader> FreeTypeFontFactory::loadFont(
     .value();
 }
 
-std::unique_ptr<TextureFont> FreeTypeFontFactory::buildFont(
-  FT_Face face, const unsigned char firstChar, const unsigned char charCount)
+FT_Face FreeTypeFontFactory::loadFace(
+  const IO::BufferedReader& reader, const FontDescriptor& fontDescriptor)
+{
+  auto face = FT_Face{};
+  const auto error = FT_New_Memory_Face(
+    m_library,
+    reinterpret_cast<const FT_Byte*>(reader.begin()),
+    FT_Long(reader.size()),
+    0,
+    &face);
+  if (error)
+  {
+    throw RenderException{
+      "Error loading font '" + fontDescriptor.name()
+      + "': FT_New_Memory_Face returned " + std::to_string(error)};
+  }
+
+  FT_Set_Pixel_Sizes(face, 0, FT_UInt(fontDescriptor.size()));
+  return face;
+}
+
+IO::FontAtlas FreeTypeFontFactory::buildAtlas(
+  FT_Face face, const unsigned char firstChar, const unsigned char charCount) const
 {
   const Metrics metrics = computeMetrics(face, firstChar, charCount);
 
-  std::unique_ptr<FontTexture> texture =
-    std::make_unique<FontTexture>(charCount, metrics.cellSize, metrics.lineHeight);
-  FontGlyphBuilder glyphBuilder(metrics.maxAscend, metrics.cellSize, 3, *texture);
+  FontTexture texture(charCount, metrics.cellSize, metrics.lineHeight);
+  FontGlyphBuilder glyphBuilder(metrics.maxAscend, metrics.cellSize, 3, texture);
 
   FT_GlyphSlot glyph = face->glyph;
-  std::vector<FontGlyph> glyphs;
+  std::vector<IO::FontAtlasGlyph> glyphs;
   for (unsigned char c = firstChar; c < firstChar + charCount; ++c)
   {
     FT_Error error = FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER);
     if (error != 0)
     {
-      glyphs.push_back(FontGlyph(0, 0, 0, 0, 0));
+      glyphs.push_back({0, 0, 0, 0, 0});
     }
     else
     {
-      glyphs.push_back(glyphBuilder.createGlyph(
+      const auto fontGlyph = glyphBuilder.createGlyph(
         static_cast<size_t>(glyph->bitmap_left),
         static_cast<size_t>(glyph->bitmap_top),
         static_cast<size_t>(glyph->bitmap.width),
         static_cast<size_t>(glyph->bitmap.rows),
         static_cast<size_t>(glyph->advance.x >> 6),
         reinterpret_cast<char*>(glyph->bitmap.buffer),
-        static_cast<size_t>(glyph->bitmap.pitch)));
+        static_cast<size_t>(glyph->bitmap.pitch));
+      glyphs.push_back({
+        static_cast<std::uint32_t>(fontGlyph.x()),
+        static_cast<std::uint32_t>(fontGlyph.y()),
+        static_cast<std::uint32_t>(fontGlyph.width()),
+        static_cast<std::uint32_t>(fontGlyph.height()),
+        static_cast<std::uint32_t>(fontGlyph.advance()),
+      });
     }
   }
 
-  return std::make_unique<TextureFont>(
-    std::move(texture),
-    glyphs,
-    static_cast<int>(metrics.lineHeight),
-    firstChar,
-    charCount);
+  const auto* buffer = reinterpret_cast<const unsigned char*>(texture.buffer());
+  return IO::FontAtlas{
+    static_cast<std::uint32_t>(texture.size()),
+    static_cast<std::int32_t>(metrics.lineHeight),
+    std::move(glyphs),
+    std::vector<unsigned char>(buffer, buffer + texture.size() * texture.size())};
 }
 
 FreeTypeFontFactory::Metrics FreeTypeFontFactory::computeMetrics(
@@ -30,6 +30,11 @@
 
 namespace TrenchBroom
 {
+namespace IO
+{
+struct FontAtlas;
+}
+
 namespace Renderer
 {
 class FontDescriptor;
@@ -48,9 +53,10 @@ private:
   std::unique_ptr<TextureFont> doCreateFont(
     const FontDescriptor& fontDescriptor) override;
 
-  std::pair<FT_Face, IO::BufferedReader> loadFont(const FontDescriptor& fontDescriptor);
-  std::unique_ptr<TextureFont> buildFont(
-    FT_Face face, unsigned char firstChar, unsigned char charCount);
+  IO::BufferedReader readFont(const FontDescriptor& fontDescriptor) const;
+  FT_Face loadFace(const IO::BufferedReader& reader, const FontDescriptor& fontDescriptor);
+  IO::FontAtlas buildAtlas(
+    FT_Face face, unsigned char firstChar, unsigned char charCount) const;
 
   Metrics computeMetrics(
     FT_Face face, unsigned char firstChar, unsigned char charCount) const;
@@ -24,6 +24,7 @@
 #include "Renderer/GL.h"
 #include "Renderer/ShaderProgram.h"
 
+#include <vecmath/scalar.h>
 #include <vecmath/vec.h>
 
 namespace TrenchBroom
@@ -155,6 +156,74 @@ public:
   deleteCopyAndMove(GLVertexAttributeNormal);
 };
 
+/**
+ * A normal stored as signed bytes, which OpenGL maps to [-1..1]. The fourth byte is
+ * unused and keeps the following vertex attributes aligned.
+ */
+struct ByteNormal
+{
+  vm::vec<GLbyte, 4> components;
+
+  ByteNormal() = default;
+
+  /**
+   * Creates a byte normal from the given unit vector.
+   */
+  explicit ByteNormal(const vm::vec3f& normal)
+    : components{toByte(normal.x()), toByte(normal.y()), toByte(normal.z()), 0}
+  {
+  }
+
+  /**
+   * Returns the normal that OpenGL reconstructs from this byte normal.
+   */
+  vm::vec3f normal() const
+  {
+    return vm::vec3f{
+      float(components.x()) / 127.0f,
+      float(components.y()) / 127.0f,
+      float(components.z()) / 127.0f};
+  }
+
+private:
+  static GLbyte toByte(const float f)
+  {
+    return static_cast<GLbyte>(vm::round(vm::clamp(f, -1.0f, 1.0f) * 127.0f));
+  }
+};
+
+/**
+ * Vertex normal attribute type that stores the normal as a ByteNormal, which needs a
+ * quarter of the memory of a normal with float components.
+ */
+class GLVertexAttributeByteNormal
+{
+public:
+  using ComponentType = GLbyte;
+  using ElementType = ByteNormal;
+  static const size_t Size = sizeof(ElementType);
+
+  static void setup(
+    ShaderProgram* /* program */,
+    const size_t /* index */,
+    const size_t stride,
+    const size_t offset)
+  {
+    glAssert(glEnableClientState(GL_NORMAL_ARRAY));
+    glAssert(glNormalPointer(
+      GL_BYTE, static_cast<GLsizei>(stride), reinterpret_cast<GLvoid*>(offset)));
+  }
+
+  static void cleanup(ShaderProgram* /* program */, const size_t /* index */)
+  {
+    glAssert(glDisableClientState(GL_NORMAL_ARRAY));
+  }
+
+  // Non-instantiable
+  GLVertexAttributeByteNormal() = delete;
+  deleteCopyAndMove(GLVertexAttributeByteNormal);
+};
+
 /**
  * Vertex color attribute types.
  *
@@ -238,6 +307,7 @@ namespace GLVertexAttributeTypes
 using P2 = GLVertexAttributePosition<GL_FLOAT, 2>;
 using P3 = GLVertexAttributePosition<GL_FLOAT, 3>;
 using N = GLVertexAttributeNormal<GL_FLOAT, 3>;
+using NB = GLVertexAttributeByteNormal;
 using T02 = GLVertexAttributeTexCoord0<GL_FLOAT, 2>;
 using C4 = GLVertexAttributeColor<GL_FLOAT, 4>;
 } // namespace GLVertexAttributeTypes
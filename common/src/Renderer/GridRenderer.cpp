@@ -20,6 +20,7 @@
 #include "GridRenderer.h"
 
 #include "FloatType.h"
+#include "Macros.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
@@ -37,42 +38,24 @@ namespace TrenchBroom
 namespace Renderer
 {
 GridRenderer::GridRenderer(const OrthographicCamera& camera, const vm::bbox3& worldBounds)
-  : m_vertexArray(VertexArray::move(vertices(camera, worldBounds)))
+  : m_camera{camera}
+  , m_worldBounds{worldBounds}
+  , m_vertexArray{VertexArray::move(vertices())}
 {
 }
 
-std::vector<GridRenderer::Vertex> GridRenderer::vertices(
-  const OrthographicCamera& camera, const vm::bbox3& worldBounds)
+void GridRenderer::setWorldBounds(const vm::bbox3& worldBounds)
 {
-  const auto& viewport = camera.zoomedViewport();
-  const auto w = float(viewport.width) / 2.0f;
-  const auto h = float(viewport.height) / 2.0f;
+  m_worldBounds = worldBounds;
+}
 
-  const auto& p = camera.position();
-  switch (vm::find_abs_max_component(camera.direction()))
-  {
-  case vm::axis::x:
-    return {
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() - w, p.z() - h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() - w, p.z() + h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() + w, p.z() + h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() + w, p.z() - h))};
-  case vm::axis::y:
-    return {
-      Vertex(vm::vec3f(p.x() - w, float(worldBounds.max.y()), p.z() - h)),
-      Vertex(vm::vec3f(p.x() - w, float(worldBounds.max.y()), p.z() + h)),
-      Vertex(vm::vec3f(p.x() + w, float(worldBounds.max.y()), p.z() + h)),
-      Vertex(vm::vec3f(p.x() + w, float(worldBounds.max.y()), p.z() - h))};
-  case vm::axis::z:
-    return {
-      Vertex(vm::vec3f(p.x() - w, p.y() - h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() - w, p.y() + h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() + w, p.y() + h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() + w, p.y() - h, float(worldBounds.min.z())))};
-  default:
-    // Should not happen.
-    return {};
-  }
+std::vector<GridRenderer::Vertex> GridRenderer::vertices()
+{
+  return {
+    Vertex{vm::vec2f{-1.0f, -1.0f}},
+    Vertex{vm::vec2f{-1.0f, +1.0f}},
+    Vertex{vm::vec2f{+1.0f, +1.0f}},
+    Vertex{vm::vec2f{+1.0f, -1.0f}}};
 }
 
 void GridRenderer::doPrepareVertices(VboManager& vboManager)
@@ -86,7 +69,38 @@ void GridRenderer::doRender(RenderContext& renderContext)
   {
     const auto& camera = renderContext.camera();
 
+    // the quad spans the viewport and lies at the far side of the world bounds
+    const auto& viewport = m_camera.zoomedViewport();
+    const auto w = float(viewport.width) / 2.0f;
+    const auto h = float(viewport.height) / 2.0f;
+
+    auto center = m_camera.position();
+    auto axisX = vm::vec3f{};
+    auto axisY = vm::vec3f{};
+    switch (vm::find_abs_max_component(m_camera.direction()))
+    {
+    case vm::axis::x:
+      center[0] = float(m_worldBounds.min.x());
+      axisX = vm::vec3f{0.0f, w, 0.0f};
+      axisY = vm::vec3f{0.0f, 0.0f, h};
+      break;
+    case vm::axis::y:
+      center[1] = float(m_worldBounds.max.y());
+      axisX = vm::vec3f{w, 0.0f, 0.0f};
+      axisY = vm::vec3f{0.0f, 0.0f, h};
+      break;
+    case vm::axis::z:
+      center[2] = float(m_worldBounds.min.z());
+      axisX = vm::vec3f{w, 0.0f, 0.0f};
+      axisY = vm::vec3f{0.0f, h, 0.0f};
+      break;
+      switchDefault();
+    }
+
     ActiveShader shader(renderContext.shaderManager(), Shaders::Grid2DShader);
+    shader.set("GridCenter", center);
+    shader.set("GridAxisX", axisX);
+    shader.set("GridAxisY", axisY);
     shader.set("Normal", -camera.direction());
     shader.set("RenderGrid", renderContext.showGrid());
     shader.set("GridSize", static_cast<float>(renderContext.gridSize()));
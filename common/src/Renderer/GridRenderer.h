@@ -24,6 +24,8 @@
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
+#include <vecmath/bbox.h>
+
 #include <vector>
 
 namespace TrenchBroom
@@ -34,18 +36,27 @@ class OrthographicCamera;
 class RenderContext;
 class VboManager;
 
+/**
+ * Renders the grid of a 2D view onto a quad that covers the viewport and lies at the far
+ * side of the world bounds. The quad is uploaded once as a unit square and is placed by
+ * the vertex shader, and the grid lines are computed by the fragment shader, so the
+ * renderer can be kept for the lifetime of its view.
+ */
 class GridRenderer : public DirectRenderable
 {
 private:
-  using Vertex = GLVertexTypes::P3::Vertex;
+  using Vertex = GLVertexTypes::P2::Vertex;
+  const OrthographicCamera& m_camera;
+  vm::bbox3 m_worldBounds;
   VertexArray m_vertexArray;
 
 public:
   GridRenderer(const OrthographicCamera& camera, const vm::bbox3& worldBounds);
 
+  void setWorldBounds(const vm::bbox3& worldBounds);
+
 private:
-  static std::vector<Vertex> vertices(
-    const OrthographicCamera& camera, const vm::bbox3& worldBounds);
+  static std::vector<Vertex> vertices();
 
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
@@ -30,6 +30,7 @@
 #include "Renderer/RenderService.h"
 #include "Renderer/TextAnchor.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace TrenchBroom
@@ -62,6 +63,7 @@ private:
 GroupRenderer::GroupRenderer(const Model::EditorContext& editorContext)
   : m_editorContext(editorContext)
   , m_boundsValid(false)
+  , m_boundsCurrentGroup(nullptr)
   , m_overrideColors(false)
   , m_showOverlays(true)
   , m_showOccludedOverlays(false)
@@ -77,14 +79,15 @@ void GroupRenderer::invalidate()
 void GroupRenderer::clear()
 {
   m_groups.clear();
-  m_boundsRenderer = DirectEdgeRenderer();
+  m_invalidGroupBounds.clear();
+  resetBounds();
 }
 
 void GroupRenderer::addGroup(const Model::GroupNode* group)
 {
   if (m_groups.insert(group).second)
   {
-    invalidate();
+    invalidateGroupBounds(group);
   }
 }
 
@@ -93,13 +96,17 @@ void GroupRenderer::removeGroup(const Model::GroupNode* group)
   if (auto it = m_groups.find(group); it != std::end(m_groups))
   {
     m_groups.erase(it);
-    invalidate();
+    m_invalidGroupBounds.erase(group);
+    if (m_boundsValid)
+    {
+      removeGroupBounds(group);
+    }
   }
 }
 
-void GroupRenderer::invalidateGroup(const Model::GroupNode*)
+void GroupRenderer::invalidateGroup(const Model::GroupNode* group)
 {
-  invalidate();
+  invalidateGroupBounds(group);
 }
 
 void GroupRenderer::setOverrideColors(const bool overrideColors)
@@ -156,7 +163,12 @@ void GroupRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
 
 void GroupRenderer::renderBounds(RenderContext&, RenderBatch& renderBatch)
 {
-  if (!m_boundsValid)
+  if (m_editorContext.currentGroup() != m_boundsCurrentGroup)
+  {
+    invalidateBounds();
+  }
+
+  if (!m_boundsValid || !m_invalidGroupBounds.empty())
   {
     validateBounds();
   }
@@ -208,51 +220,84 @@ void GroupRenderer::renderNames(RenderContext& renderContext, RenderBatch& rende
 void GroupRenderer::invalidateBounds()
 {
   m_boundsValid = false;
+  m_invalidGroupBounds.clear();
 }
 
-void GroupRenderer::validateBounds()
+void GroupRenderer::invalidateGroupBounds(const Model::GroupNode* group)
 {
-  if (m_overrideColors)
+  if (m_boundsValid)
   {
-    std::vector<GLVertexTypes::P3::Vertex> vertices;
-    vertices.reserve(24 * m_groups.size());
+    m_invalidGroupBounds.insert(group);
+  }
+}
 
-    for (const Model::GroupNode* group : m_groups)
+void GroupRenderer::validateBounds()
+{
+  if (!m_boundsValid)
+  {
+    resetBounds();
+    for (const auto* group : m_groups)
     {
-      if (shouldRenderGroup(group))
-      {
-        group->logicalBounds().for_each_edge([&](const vm::vec3& v1, const vm::vec3& v2) {
-          vertices.emplace_back(vm::vec3f(v1));
-          vertices.emplace_back(vm::vec3f(v2));
-        });
-      }
+      addGroupBounds(group);
     }
-
-    m_boundsRenderer =
-      DirectEdgeRenderer(VertexArray::move(std::move(vertices)), PrimType::Lines);
   }
   else
   {
-    std::vector<GLVertexTypes::P3C4::Vertex> vertices;
-    vertices.reserve(24 * m_groups.size());
-
-    for (const Model::GroupNode* group : m_groups)
+    for (const auto* group : m_invalidGroupBounds)
     {
-      if (shouldRenderGroup(group))
+      removeGroupBounds(group);
+      if (m_groups.find(group) != std::end(m_groups))
       {
-        const auto color = groupColor(group);
-        group->logicalBounds().for_each_edge([&](const vm::vec3& v1, const vm::vec3& v2) {
-          vertices.emplace_back(vm::vec3f(v1), color);
-          vertices.emplace_back(vm::vec3f(v2), color);
-        });
+        addGroupBounds(group);
       }
     }
-
-    m_boundsRenderer =
-      DirectEdgeRenderer(VertexArray::move(std::move(vertices)), PrimType::Lines);
   }
+  m_invalidGroupBounds.clear();
 
+  // the renderer shares the vertex holder, so only the changed blocks are uploaded; the
+  // zeroed vertices of free blocks form degenerate lines
+  m_boundsRenderer =
+    DirectEdgeRenderer(VertexArray::shared(m_bounds->vertexHolder()), PrimType::Lines);
   m_boundsValid = true;
+  m_boundsCurrentGroup = m_editorContext.currentGroup();
+}
+
+void GroupRenderer::addGroupBounds(const Model::GroupNode* group)
+{
+  if (!shouldRenderGroup(group))
+  {
+    return;
+  }
+
+  auto vertices = std::vector<BoundsVertex>{};
+  vertices.reserve(24);
+
+  // if the colors are overridden, the edge shader ignores the vertex colors
+  const auto color = groupColor(group);
+  group->logicalBounds().for_each_edge([&](const vm::vec3& v1, const vm::vec3& v2) {
+    vertices.emplace_back(vm::vec3f(v1), color);
+    vertices.emplace_back(vm::vec3f(v2), color);
+  });
+
+  auto [block, dest] = m_bounds->allocateBlock(vertices.size());
+  std::copy(std::begin(vertices), std::end(vertices), dest);
+  m_groupBounds.emplace(group, block);
+}
+
+void GroupRenderer::removeGroupBounds(const Model::GroupNode* group)
+{
+  if (auto it = m_groupBounds.find(group); it != std::end(m_groupBounds))
+  {
+    m_bounds->freeBlock(it->second);
+    m_groupBounds.erase(it);
+  }
+}
+
+void GroupRenderer::resetBounds()
+{
+  m_bounds = std::make_unique<VertexBlockArray<BoundsVertex>>();
+  m_groupBounds.clear();
+  m_boundsRenderer = DirectEdgeRenderer();
 }
 
 bool GroupRenderer::shouldRenderGroup(const Model::GroupNode* group) const
@@ -21,10 +21,16 @@
 
 #include "AttrString.h"
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
+#include "Renderer/BrushRendererArrays.h"
 #include "Renderer/EdgeRenderer.h"
+#include "Renderer/GLVertexType.h"
 
 #include <kdl/vector_set.h>
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -48,8 +54,23 @@ private:
   const Model::EditorContext& m_editorContext;
   kdl::vector_set<const Model::GroupNode*> m_groups;
 
+  using BoundsVertex = GLVertexTypes::P3C4::Vertex;
+
+  /**
+   * The bounds vertices of every rendered group are stored in a block of this array, so
+   * that changing a group only rewrites and uploads its own block.
+   */
+  std::unique_ptr<VertexBlockArray<BoundsVertex>> m_bounds;
+  std::unordered_map<const Model::GroupNode*, AllocationTracker::Block*> m_groupBounds;
+  std::unordered_set<const Model::GroupNode*> m_invalidGroupBounds;
+
   DirectEdgeRenderer m_boundsRenderer;
   bool m_boundsValid;
+  /**
+   * Only the groups in the current group are rendered, so the bounds are rebuilt when it
+   * changes.
+   */
+  const Model::GroupNode* m_boundsCurrentGroup;
 
   bool m_overrideColors;
   bool m_showOverlays;
@@ -106,8 +127,18 @@ private:
   void renderBounds(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderNames(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Causes the bounds of all groups to be rebuilt on the next render() call.
+   */
   void invalidateBounds();
+  /**
+   * Causes the bounds of the given group to be rebuilt on the next render() call.
+   */
+  void invalidateGroupBounds(const Model::GroupNode* group);
   void validateBounds();
+  void addGroupBounds(const Model::GroupNode* group);
+  void removeGroupBounds(const Model::GroupNode* group);
+  void resetBounds();
 
   bool shouldRenderGroup(const Model::GroupNode* group) const;
 
@@ -29,6 +29,15 @@ void IndexArray::BaseHolder::render(
   doRender(primType, offset, count);
 }
 
+void IndexArray::BaseHolder::renderInstanced(
+  const PrimType primType,
+  const size_t offset,
+  const size_t count,
+  const size_t instanceCount) const
+{
+  doRenderInstanced(primType, offset, count, instanceCount);
+}
+
 IndexArray::IndexArray()
   : m_prepared(false)
   , m_setup(false)
@@ -99,6 +108,30 @@ void IndexArray::render(const PrimType primType, const size_t offset, size_t cou
   }
 }
 
+void IndexArray::renderInstanced(
+  const PrimType primType,
+  const size_t offset,
+  const size_t count,
+  const size_t instanceCount)
+{
+  assert(prepared());
+  if (!empty())
+  {
+    if (!m_setup)
+    {
+      if (setup())
+      {
+        m_holder->renderInstanced(primType, offset, count, instanceCount);
+        cleanup();
+      }
+    }
+    else
+    {
+      m_holder->renderInstanced(primType, offset, count, instanceCount);
+    }
+  }
+}
+
 void IndexArray::cleanup()
 {
   assert(m_setup);
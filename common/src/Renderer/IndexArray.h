@@ -60,9 +60,13 @@ private:
 
   public:
     void render(PrimType primType, size_t offset, size_t count) const;
+    void renderInstanced(
+      PrimType primType, size_t offset, size_t count, size_t instanceCount) const;
 
   private:
     virtual void doRender(PrimType primType, size_t offset, size_t count) const = 0;
+    virtual void doRenderInstanced(
+      PrimType primType, size_t offset, size_t count, size_t instanceCount) const = 0;
   };
 
   template <typename Index>
@@ -124,8 +128,22 @@ private:
       glAssert(glDrawElements(
         toGL(primType),
         static_cast<GLsizei>(count),
-        GL_UNSIGNED_INT,
-        reinterpret_cast<void*>(offset * 4u)));
+        GLEnum<Index>::Value,
+        reinterpret_cast<void*>(offset * sizeof(Index))));
+    }
+
+    void doRenderInstanced(
+      PrimType primType,
+      size_t offset,
+      size_t count,
+      size_t instanceCount) const override
+    {
+      glAssert(glDrawElementsInstanced(
+        toGL(primType),
+        static_cast<GLsizei>(count),
+        GLEnum<Index>::Value,
+        reinterpret_cast<void*>(offset * sizeof(Index)),
+        static_cast<GLsizei>(instanceCount)));
     }
 
   private:
@@ -299,6 +317,19 @@ public:
    */
   void render(PrimType primType, size_t offset, size_t count);
 
+  /**
+   * Renders the given number of instances of a range of primitives of the given type
+   * using the indices stored in this index array. Per instance attributes must be set up
+   * by the caller.
+   *
+   * @param primType the type of primitive to render
+   * @param offset the offset of the range of indices to render
+   * @param count the number of indices to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(
+    PrimType primType, size_t offset, size_t count, size_t instanceCount);
+
   void cleanup();
 
 private:
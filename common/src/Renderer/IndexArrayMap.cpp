@@ -111,5 +111,14 @@ void IndexArrayMap::render(IndexArray& indexArray) const
     indexArray.render(primType, range.offset, range.count);
   }
 }
+
+void IndexArrayMap::renderInstanced(
+  IndexArray& indexArray, const size_t instanceCount) const
+{
+  for (const auto& [primType, range] : m_ranges)
+  {
+    indexArray.renderInstanced(primType, range.offset, range.count, instanceCount);
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -160,6 +160,15 @@ public:
    * @param indexArray the index array to render
    */
   void render(IndexArray& indexArray) const;
+
+  /**
+   * Renders the given number of instances of the recorded primitives using the indices
+   * stored in the given index array.
+   *
+   * @param indexArray the index array to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(IndexArray& indexArray, size_t instanceCount) const;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,8 +22,6 @@
 #include "Renderer/PrimType.h"
 #include "Renderer/VertexArray.h"
 
-#include <kdl/vector_utils.h>
-
 namespace TrenchBroom
 {
 namespace Renderer
@@ -98,8 +96,8 @@ void IndexRangeMap::IndicesAndCounts::add(
   const IndicesAndCounts& other, [[maybe_unused]] const bool dynamicGrowth)
 {
   assert(dynamicGrowth || indices.capacity() >= indices.size() + other.indices.size());
-  indices = kdl::vec_concat(std::move(indices), other.indices);
-  counts = kdl::vec_concat(std::move(counts), other.counts);
+  indices.insert(indices.end(), other.indices.begin(), other.indices.end());
+  counts.insert(counts.end(), other.counts.begin(), other.counts.end());
 }
 
 void IndexRangeMap::Size::inc(const PrimType primType, const size_t count)
@@ -185,6 +183,25 @@ void IndexRangeMap::render(VertexArray& vertexArray) const
   }
 }
 
+void IndexRangeMap::renderInstanced(
+  VertexArray& vertexArray, const size_t instanceCount) const
+{
+  for (const auto& primType : PrimTypeValues)
+  {
+    const auto& indicesAndCounts = m_data->get(primType);
+    if (!indicesAndCounts.empty())
+    {
+      const auto primCount = static_cast<GLsizei>(indicesAndCounts.size());
+      vertexArray.renderInstanced(
+        primType,
+        indicesAndCounts.indices,
+        indicesAndCounts.counts,
+        primCount,
+        static_cast<GLsizei>(instanceCount));
+    }
+  }
+}
+
 void IndexRangeMap::forEachPrimitive(
   std::function<void(PrimType, size_t, size_t)> func) const
 {
@@ -27,6 +27,11 @@
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
 
+#include <vecmath/plane.h>
+
+#include <algorithm>
+#include <array>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -60,10 +65,51 @@ void LinkRenderer::doPrepareVertices(VboManager& vboManager)
 void LinkRenderer::doRender(RenderContext& renderContext)
 {
   assert(m_valid);
+  cullLinks(renderContext);
   renderLines(renderContext);
   renderArrows(renderContext);
 }
 
+void LinkRenderer::cullLinks(const RenderContext& renderContext)
+{
+  auto planes = std::array<vm::plane3f, 4>{};
+  renderContext.camera().frustumPlanes(planes[0], planes[1], planes[2], planes[3]);
+
+  // a link is outside of the frustum if both of its end points are above the same plane
+  const auto isVisible = [&](const Link& link) {
+    return std::none_of(planes.begin(), planes.end(), [&](const auto& plane) {
+      return plane.point_distance(link.start) > 0.0f
+             && plane.point_distance(link.end) > 0.0f;
+    });
+  };
+
+  // consecutive visible links are merged into one range
+  m_lineRanges = IndexRangeMap{};
+  m_arrowRanges = IndexRangeMap{};
+  for (size_t first = 0; first < m_links.size();)
+  {
+    if (!isVisible(m_links[first]))
+    {
+      ++first;
+      continue;
+    }
+
+    auto last = first + 1;
+    while (last < m_links.size() && isVisible(m_links[last]))
+    {
+      ++last;
+    }
+
+    const auto& lastLink = m_links[last - 1];
+    const auto arrowIndex = m_links[first].arrowIndex;
+    const auto arrowCount = lastLink.arrowIndex + lastLink.arrowCount - arrowIndex;
+    m_lineRanges.add(PrimType::Lines, 2 * first, 2 * (last - first));
+    m_arrowRanges.add(PrimType::Lines, arrowIndex, arrowCount);
+
+    first = last;
+  }
+}
+
 void LinkRenderer::renderLines(RenderContext& renderContext)
 {
   ActiveShader shader(renderContext.shaderManager(), Shaders::LinkLineShader);
@@ -73,11 +119,11 @@ void LinkRenderer::renderLines(RenderContext& renderContext)
 
   glAssert(glDisable(GL_DEPTH_TEST));
   shader.set("Alpha", 0.4f);
-  m_lines.render(PrimType::Lines);
+  m_lineRanges.render(m_lines);
 
   glAssert(glEnable(GL_DEPTH_TEST));
   shader.set("Alpha", 1.0f);
-  m_lines.render(PrimType::Lines);
+  m_lineRanges.render(m_lines);
 }
 
 void LinkRenderer::renderArrows(RenderContext& renderContext)
@@ -90,11 +136,11 @@ void LinkRenderer::renderArrows(RenderContext& renderContext)
 
   glAssert(glDisable(GL_DEPTH_TEST));
   shader.set("Alpha", 0.4f);
-  m_arrows.render(PrimType::Lines);
+  m_arrowRanges.render(m_arrows);
 
   glAssert(glEnable(GL_DEPTH_TEST));
   shader.set("Alpha", 1.0f);
-  m_arrows.render(PrimType::Lines);
+  m_arrowRanges.render(m_arrows);
 }
 
 static void addArrow(
@@ -110,59 +156,65 @@ static void addArrow(
   arrows.emplace_back(vm::vec3f{0, -3, 0}, color, arrowPosition, lineDir);
 }
 
-static std::vector<LinkRenderer::ArrowVertex> getArrows(
-  const std::vector<LinkRenderer::LineVertex>& links)
+static void addArrows(
+  std::vector<LinkRenderer::ArrowVertex>& arrows,
+  const LinkRenderer::LineVertex& startVertex,
+  const LinkRenderer::LineVertex& endVertex)
 {
-  assert((links.size() % 2) == 0);
-  auto arrows = std::vector<LinkRenderer::ArrowVertex>{};
-  for (size_t i = 0; i < links.size(); i += 2)
-  {
-    const LinkRenderer::LineVertex& startVertex = links[i];
-    const LinkRenderer::LineVertex& endVertex = links[i + 1];
+  const vm::vec3f lineVec =
+    (getVertexComponent<0>(endVertex) - getVertexComponent<0>(startVertex));
+  const float lineLength = length(lineVec);
+  const vm::vec3f lineDir = lineVec / lineLength;
+  const vm::vec4f color = getVertexComponent<1>(startVertex);
 
-    const vm::vec3f lineVec =
-      (getVertexComponent<0>(endVertex) - getVertexComponent<0>(startVertex));
-    const float lineLength = length(lineVec);
-    const vm::vec3f lineDir = lineVec / lineLength;
-    const vm::vec4f color = getVertexComponent<1>(startVertex);
-
-    if (lineLength < 512)
-    {
-      const vm::vec3f arrowPosition =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
-      addArrow(arrows, color, arrowPosition, lineDir);
-    }
-    else if (lineLength < 1024)
-    {
-      const vm::vec3f arrowPosition1 =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.2f);
-      const vm::vec3f arrowPosition2 =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
+  if (lineLength < 512)
+  {
+    const vm::vec3f arrowPosition = getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
+    addArrow(arrows, color, arrowPosition, lineDir);
+  }
+  else if (lineLength < 1024)
+  {
+    const vm::vec3f arrowPosition1 =
+      getVertexComponent<0>(startVertex) + (lineVec * 0.2f);
+    const vm::vec3f arrowPosition2 =
+      getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
 
-      addArrow(arrows, color, arrowPosition1, lineDir);
-      addArrow(arrows, color, arrowPosition2, lineDir);
-    }
-    else
-    {
-      const vm::vec3f arrowPosition1 =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.1f);
-      const vm::vec3f arrowPosition2 =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.4f);
-      const vm::vec3f arrowPosition3 =
-        getVertexComponent<0>(startVertex) + (lineVec * 0.7f);
-
-      addArrow(arrows, color, arrowPosition1, lineDir);
-      addArrow(arrows, color, arrowPosition2, lineDir);
-      addArrow(arrows, color, arrowPosition3, lineDir);
-    }
+    addArrow(arrows, color, arrowPosition1, lineDir);
+    addArrow(arrows, color, arrowPosition2, lineDir);
+  }
+  else
+  {
+    const vm::vec3f arrowPosition1 =
+      getVertexComponent<0>(startVertex) + (lineVec * 0.1f);
+    const vm::vec3f arrowPosition2 =
+      getVertexComponent<0>(startVertex) + (lineVec * 0.4f);
+    const vm::vec3f arrowPosition3 =
+      getVertexComponent<0>(startVertex) + (lineVec * 0.7f);
+
+    addArrow(arrows, color, arrowPosition1, lineDir);
+    addArrow(arrows, color, arrowPosition2, lineDir);
+    addArrow(arrows, color, arrowPosition3, lineDir);
   }
-  return arrows;
 }
 
 void LinkRenderer::validate()
 {
   auto links = getLinks();
-  auto arrows = getArrows(links);
+  assert((links.size() % 2) == 0);
+
+  auto arrows = std::vector<ArrowVertex>{};
+  m_links.clear();
+  m_links.reserve(links.size() / 2);
+  for (size_t i = 0; i < links.size(); i += 2)
+  {
+    const auto arrowIndex = arrows.size();
+    addArrows(arrows, links[i], links[i + 1]);
+    m_links.push_back(Link{
+      getVertexComponent<0>(links[i]),
+      getVertexComponent<0>(links[i + 1]),
+      arrowIndex,
+      arrows.size() - arrowIndex});
+  }
 
   m_lines = VertexArray::move(std::move(links));
   m_arrows = VertexArray::move(std::move(arrows));
@@ -21,9 +21,14 @@
 
 #include "Renderer/GLVertex.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/IndexRangeMap.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
+#include <vecmath/vec.h>
+
+#include <vector>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -53,8 +58,26 @@ public:
     GLVertexAttributeUser<LineDirName, GL_FLOAT, 3, false>>::Vertex; // direction the
                                                                      // arrow is pointing
 private:
+  /**
+   * The end points of a link and the range of its arrow vertices.
+   */
+  struct Link
+  {
+    vm::vec3f start;
+    vm::vec3f end;
+    size_t arrowIndex;
+    size_t arrowCount;
+  };
+
   VertexArray m_lines;
   VertexArray m_arrows;
+  std::vector<Link> m_links;
+
+  /**
+   * The ranges of the links that intersect the view frustum, updated for every frame.
+   */
+  IndexRangeMap m_lineRanges;
+  IndexRangeMap m_arrowRanges;
 
   bool m_valid;
 
@@ -68,6 +91,7 @@ private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 
+  void cullLinks(const RenderContext& renderContext);
   void renderLines(RenderContext& renderContext);
   void renderArrows(RenderContext& renderContext);
 
@@ -27,14 +27,18 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/PatchNode.h"
+#include "Model/TagAttribute.h"
 #include "Model/WorldNode.h"
+#include "Renderer/Camera.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/EntityDecalRenderer.h"
 #include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/EntityLod.h"
 #include "Renderer/GroupLinkRenderer.h"
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
@@ -42,13 +46,23 @@
 #include "Renderer/RenderUtils.h"
 #include "View/MapDocument.h"
 #include "View/Selection.h"
+#include "octree.h"
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/path_utils.h>
 #include <kdl/vector_set.h>
+#include <kdl/vector_utils.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+
+#include <algorithm>
+#include <iterator>
 #include <set>
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -130,10 +144,11 @@ public:
 
     const auto& brush = brushNode.brush();
 
+    // the brush is visible here, so only the face tags decide whether a face is visible
     auto anyFaceVisible = false;
     for (const auto& face : brush.faces())
     {
-      const bool faceVisible = !selected(brushNode, face) && visible(brushNode, face);
+      const bool faceVisible = !selected(brushNode, face) && !hidden(face);
       face.setMarked(faceVisible);
       anyFaceVisible |= faceVisible;
     }
@@ -155,12 +170,12 @@ public:
 
 MapRenderer::MapRenderer(std::weak_ptr<View::MapDocument> document)
   : m_document{std::move(document)}
-  , m_defaultRenderer{createDefaultRenderer(m_document)}
   , m_selectionRenderer{createSelectionRenderer(m_document)}
   , m_lockedRenderer{createLockRenderer(m_document)}
   , m_entityDecalRenderer{createEntityDecalRenderer(m_document)}
   , m_entityLinkRenderer{std::make_unique<EntityLinkRenderer>(m_document)}
   , m_groupLinkRenderer{std::make_unique<GroupLinkRenderer>(m_document)}
+  , m_culledBrushCount{0}
 {
   connectObservers();
   setupRenderers();
@@ -181,6 +196,17 @@ std::unique_ptr<ObjectRenderer> MapRenderer::createDefaultRenderer(
     UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
 }
 
+MapRenderer::LayerRenderer& MapRenderer::layerRenderer(const Model::LayerNode* layer)
+{
+  auto& layerRenderer = m_defaultRenderers[layer];
+  if (!layerRenderer.renderer)
+  {
+    layerRenderer.renderer = createDefaultRenderer(m_document);
+    setupDefaultRenderer(*layerRenderer.renderer);
+  }
+  return layerRenderer;
+}
+
 std::unique_ptr<ObjectRenderer> MapRenderer::createSelectionRenderer(
   std::weak_ptr<View::MapDocument> document)
 {
@@ -209,11 +235,11 @@ std::unique_ptr<EntityDecalRenderer> MapRenderer::createEntityDecalRenderer(
 
 void MapRenderer::clear()
 {
-  m_defaultRenderer->clear();
+  m_defaultRenderers.clear();
   m_selectionRenderer->clear();
   m_lockedRenderer->clear();
   m_entityDecalRenderer->clear();
-  m_entityLinkRenderer->invalidate();
+  m_entityLinkRenderer->clear();
   m_groupLinkRenderer->invalidate();
   m_trackedNodes.clear();
 }
@@ -235,9 +261,21 @@ void MapRenderer::restoreSelectionColors()
   setupSelectionRenderer(*m_selectionRenderer);
 }
 
+void MapRenderer::prepare()
+{
+  commitPendingChanges();
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.renderer->prepare();
+  }
+  m_selectionRenderer->prepare();
+  m_lockedRenderer->prepare();
+}
+
 void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   commitPendingChanges();
+  updateVisibleBrushes(renderContext);
   setupGL(renderBatch);
   renderDefaultOpaque(renderContext, renderBatch);
   renderLockedOpaque(renderContext, renderBatch);
@@ -250,6 +288,29 @@ void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
   renderEntityDecals(renderContext, renderBatch);
   renderEntityLinks(renderContext, renderBatch);
   renderGroupLinks(renderContext, renderBatch);
+
+  m_culledBrushCount =
+    m_lockedRenderer->culledBrushCount() + m_selectionRenderer->culledBrushCount();
+  for (const auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    m_culledBrushCount += layerRenderer.renderer->culledBrushCount();
+  }
+}
+
+size_t MapRenderer::culledBrushCount() const
+{
+  return m_culledBrushCount;
+}
+
+size_t MapRenderer::brushMemoryUsage() const
+{
+  auto result =
+    m_selectionRenderer->brushMemoryUsage() + m_lockedRenderer->brushMemoryUsage();
+  for (const auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    result += layerRenderer.renderer->brushMemoryUsage();
+  }
+  return result;
 }
 
 void MapRenderer::commitPendingChanges()
@@ -258,6 +319,188 @@ void MapRenderer::commitPendingChanges()
   document->commitPendingAssets();
 }
 
+namespace
+{
+bool isOutside(const vm::bbox3& bounds, const std::vector<vm::plane3>& planes)
+{
+  return std::any_of(planes.begin(), planes.end(), [&](const auto& plane) {
+    // the vertex of the bounding box that is furthest below the plane
+    auto vertex = bounds.max;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (plane.normal[i] > 0.0)
+      {
+        vertex[i] = bounds.min[i];
+      }
+    }
+    return plane.point_distance(vertex) > 0.0;
+  });
+}
+
+// only the largest brushes on screen are used as occluders
+constexpr auto MaxOccluderCount = size_t(256);
+constexpr auto MinOccluderSize = 64.0f;
+
+bool shouldCullOccludedObjects(const RenderContext& renderContext)
+{
+  return pref(Preferences::EnableOcclusionCulling) && renderContext.render3D()
+         && renderContext.camera().perspectiveProjection() && renderContext.showFaces();
+}
+
+bool isOccluder(
+  const Model::BrushNode* brushNode, const Model::EditorContext& editorContext)
+{
+  if (
+    brushNode->selected() || brushNode->parentSelected()
+    || !editorContext.visible(brushNode)
+    || brushNode->hasAttribute(Model::TagAttributes::Transparency))
+  {
+    return false;
+  }
+
+  const auto& faces = brushNode->brush().faces();
+  return std::all_of(faces.begin(), faces.end(), [&](const auto& face) {
+    return editorContext.visible(brushNode, face)
+           && !face.hasAttribute(Model::TagAttributes::Transparency);
+  });
+}
+} // namespace
+
+void MapRenderer::updateVisibleBrushes(const RenderContext& renderContext)
+{
+  auto document = kdl::mem_lock(m_document);
+  const auto* world = document->world();
+
+  const std::vector<const Model::BrushNode*>* visibleBrushes = nullptr;
+  if (world != nullptr)
+  {
+    auto topPlane = vm::plane3f{};
+    auto rightPlane = vm::plane3f{};
+    auto bottomPlane = vm::plane3f{};
+    auto leftPlane = vm::plane3f{};
+    renderContext.camera().frustumPlanes(topPlane, rightPlane, bottomPlane, leftPlane);
+
+    const auto planes = std::vector<vm::plane3>{
+      vm::plane3{topPlane},
+      vm::plane3{rightPlane},
+      vm::plane3{bottomPlane},
+      vm::plane3{leftPlane},
+    };
+
+    // the octree only tests the bounds of its nodes, so the candidates are tested again
+    m_potentiallyVisibleNodes.clear();
+    world->nodeTree().find_intersectors(
+      planes, std::back_inserter(m_potentiallyVisibleNodes));
+
+    m_visibleBrushes.clear();
+    for (const auto* node : m_potentiallyVisibleNodes)
+    {
+      node->accept(kdl::overload(
+        [](const Model::WorldNode*) {},
+        [](const Model::LayerNode*) {},
+        [](const Model::GroupNode*) {},
+        [](const Model::EntityNode*) {},
+        [&](const Model::BrushNode* brushNode) {
+          if (!isOutside(brushNode->physicalBounds(), planes))
+          {
+            m_visibleBrushes.push_back(brushNode);
+          }
+        },
+        [](const Model::PatchNode*) {}));
+    }
+
+    visibleBrushes = &m_visibleBrushes;
+  }
+
+  const auto* unoccludedBrushes = visibleBrushes;
+  const OcclusionCuller* occlusionCuller = nullptr;
+  if (visibleBrushes != nullptr && shouldCullOccludedObjects(renderContext))
+  {
+    updateOcclusionCuller(renderContext.camera(), document->editorContext());
+
+    m_unoccludedBrushes.clear();
+    std::copy_if(
+      m_visibleBrushes.begin(),
+      m_visibleBrushes.end(),
+      std::back_inserter(m_unoccludedBrushes),
+      [&](const auto* brushNode) {
+        return !m_occlusionCuller.occluded(brushNode->physicalBounds());
+      });
+
+    unoccludedBrushes = &m_unoccludedBrushes;
+    occlusionCuller = &m_occlusionCuller;
+  }
+
+  // pass each layer renderer only its own brushes
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.visibleBrushes.clear();
+  }
+  if (unoccludedBrushes != nullptr)
+  {
+    for (const auto* brushNode : *unoccludedBrushes)
+    {
+      if (const auto it = m_trackedNodes.find(brushNode);
+          it != m_trackedNodes.end() && it->second.layerRenderer != nullptr)
+      {
+        it->second.layerRenderer->visibleBrushes.push_back(brushNode);
+      }
+    }
+  }
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.renderer->setVisibleBrushes(
+      unoccludedBrushes != nullptr ? &layerRenderer.visibleBrushes : nullptr);
+    layerRenderer.renderer->setOcclusionCuller(occlusionCuller);
+  }
+
+  m_lockedRenderer->setVisibleBrushes(unoccludedBrushes);
+  m_lockedRenderer->setOcclusionCuller(occlusionCuller);
+
+  // the occluded edges of selected objects are shown, so they are never culled; if the
+  // selected objects are rendered with a transformation, then they are not culled at all
+  // because their rendered positions differ from their actual positions
+  m_selectionRenderer->setVisibleBrushes(
+    renderContext.selectionTransformation() ? nullptr : visibleBrushes);
+}
+
+void MapRenderer::updateOcclusionCuller(
+  const Camera& camera, const Model::EditorContext& editorContext)
+{
+  auto occluders = std::vector<std::tuple<float, const Model::BrushNode*>>{};
+  for (const auto* brushNode : m_visibleBrushes)
+  {
+    const auto size = projectedSize(camera, brushNode->physicalBounds());
+    if (size >= MinOccluderSize && isOccluder(brushNode, editorContext))
+    {
+      occluders.emplace_back(size, brushNode);
+    }
+  }
+
+  const auto occluderCount = std::min(occluders.size(), MaxOccluderCount);
+  std::partial_sort(
+    occluders.begin(),
+    std::next(occluders.begin(), static_cast<std::ptrdiff_t>(occluderCount)),
+    occluders.end(),
+    [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) > std::get<0>(rhs); });
+
+  const auto cameraPosition = vm::vec3{camera.position()};
+  m_occlusionCuller.reset(camera);
+  for (size_t i = 0; i < occluderCount; ++i)
+  {
+    const auto* brushNode = std::get<1>(occluders[i]);
+    for (const auto& face : brushNode->brush().faces())
+    {
+      // faces that point away from the camera are hidden by the other faces
+      if (face.boundary().point_status(cameraPosition) == vm::plane_status::above)
+      {
+        m_occlusionCuller.addOccluder(face.vertexPositions());
+      }
+    }
+  }
+  m_occlusionCuller.buildHierarchy();
+}
+
 class SetupGL : public Renderable
 {
 private:
@@ -276,18 +519,51 @@ void MapRenderer::setupGL(RenderBatch& renderBatch)
   renderBatch.addOneShot(new SetupGL{});
 }
 
+class PushModelMatrix : public Renderable
+{
+private:
+  vm::mat4x4f m_modelMatrix;
+
+public:
+  explicit PushModelMatrix(const vm::mat4x4f& modelMatrix)
+    : m_modelMatrix{modelMatrix}
+  {
+  }
+
+private:
+  void doRender(RenderContext& renderContext) override
+  {
+    renderContext.transformation().pushModelMatrix(m_modelMatrix);
+  }
+};
+
+class PopModelMatrix : public Renderable
+{
+private:
+  void doRender(RenderContext& renderContext) override
+  {
+    renderContext.transformation().popModelMatrix();
+  }
+};
+
 void MapRenderer::renderDefaultOpaque(
   RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  m_defaultRenderer->setShowOverlays(renderContext.render3D());
-  m_defaultRenderer->renderOpaque(renderContext, renderBatch);
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.renderer->setShowOverlays(renderContext.render3D());
+    layerRenderer.renderer->renderOpaque(renderContext, renderBatch);
+  }
 }
 
 void MapRenderer::renderDefaultTransparent(
   RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  m_defaultRenderer->setShowOverlays(renderContext.render3D());
-  m_defaultRenderer->renderTransparent(renderContext, renderBatch);
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.renderer->setShowOverlays(renderContext.render3D());
+    layerRenderer.renderer->renderTransparent(renderContext, renderBatch);
+  }
 }
 
 void MapRenderer::renderSelectionOpaque(
@@ -295,7 +571,16 @@ void MapRenderer::renderSelectionOpaque(
 {
   if (!renderContext.hideSelection())
   {
-    m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+    if (const auto& transformation = renderContext.selectionTransformation())
+    {
+      renderBatch.addOneShot(new PushModelMatrix{vm::mat4x4f{*transformation}});
+      m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+      renderBatch.addOneShot(new PopModelMatrix{});
+    }
+    else
+    {
+      m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+    }
   }
 }
 
@@ -304,7 +589,16 @@ void MapRenderer::renderSelectionTransparent(
 {
   if (!renderContext.hideSelection())
   {
-    m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+    if (const auto& transformation = renderContext.selectionTransformation())
+    {
+      renderBatch.addOneShot(new PushModelMatrix{vm::mat4x4f{*transformation}});
+      m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+      renderBatch.addOneShot(new PopModelMatrix{});
+    }
+    else
+    {
+      m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+    }
   }
 }
 
@@ -345,7 +639,10 @@ void MapRenderer::renderGroupLinks(RenderContext& renderContext, RenderBatch& re
 
 void MapRenderer::setupRenderers()
 {
-  setupDefaultRenderer(*m_defaultRenderer);
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    setupDefaultRenderer(*layerRenderer.renderer);
+  }
   setupSelectionRenderer(*m_selectionRenderer);
   setupLockedRenderer(*m_lockedRenderer);
 }
@@ -490,12 +787,45 @@ int MapRenderer::determineDesiredRenderers(Model::Node* node)
  */
 void MapRenderer::updateAndInvalidateNode(Model::Node* node)
 {
-  const auto desiredRenderers = determineDesiredRenderers(node);
-  int currentRenderers = 0;
+  updateAndInvalidateNode(node, determineDesiredRenderers(node));
+}
 
-  if (auto it = m_trackedNodes.find(node); it != m_trackedNodes.end())
+void MapRenderer::updateAndInvalidateNode(Model::Node* node, const int desiredRenderers)
+{
+  auto& trackedNode = m_trackedNodes[node];
+  auto currentRenderers = trackedNode.renderers;
+
+  const auto isDefaultDesired =
+    (desiredRenderers & static_cast<int>(Renderer::Default)) != 0;
+  const auto isSelectionDesired =
+    (desiredRenderers & static_cast<int>(Renderer::Selection)) != 0;
+
+  // A suppressed node is shown again without being invalidated if it was just deselected.
+  // Otherwise it changed while it was selected, and its geometry in the renderer of its
+  // layer is stale.
+  auto updateDefaultRenderer = true;
+  auto suppressNode = false;
+  if (trackedNode.suppressed)
+  {
+    auto& renderer = *trackedNode.layerRenderer->renderer;
+    if (isDefaultDesired)
+    {
+      renderer.setNodeSuppressed(node, false);
+      updateDefaultRenderer = isSelectionDesired;
+    }
+    else
+    {
+      renderer.removeNode(node);
+      currentRenderers &= ~static_cast<int>(Renderer::Default);
+    }
+  }
+  else if (
+    (currentRenderers & static_cast<int>(Renderer::Default)) != 0
+    && desiredRenderers == static_cast<int>(Renderer::Selection))
   {
-    currentRenderers = it->second;
+    // the node was selected
+    suppressNode = trackedNode.layerRenderer->renderer->setNodeSuppressed(node, true);
+    updateDefaultRenderer = !suppressNode;
   }
 
   auto updateForRenderer = [&](const Renderer r, ObjectRenderer* o) {
@@ -516,14 +846,29 @@ void MapRenderer::updateAndInvalidateNode(Model::Node* node)
     }
   };
 
-  updateForRenderer(Renderer::Default, m_defaultRenderer.get());
+  if (isDefaultDesired && trackedNode.layerRenderer == nullptr)
+  {
+    trackedNode.layerRenderer = &layerRenderer(Model::findContainingLayer(node));
+  }
+  if (trackedNode.layerRenderer != nullptr && updateDefaultRenderer)
+  {
+    updateForRenderer(Renderer::Default, trackedNode.layerRenderer->renderer.get());
+  }
   updateForRenderer(Renderer::Selection, m_selectionRenderer.get());
   updateForRenderer(Renderer::Locked, m_lockedRenderer.get());
 
   // Update the metadata to reflect the changes that we made above
-  m_trackedNodes[node] = desiredRenderers;
+  trackedNode.renderers =
+    suppressNode ? desiredRenderers | static_cast<int>(Renderer::Default)
+                 : desiredRenderers;
+  trackedNode.suppressed = suppressNode;
+  if (!isDefaultDesired && !suppressNode)
+  {
+    trackedNode.layerRenderer = nullptr;
+  }
 
   m_entityDecalRenderer->updateNode(node);
+  m_entityLinkRenderer->updateNode(node);
 }
 
 void MapRenderer::updateAndInvalidateNodeRecursive(Model::Node* node)
@@ -552,15 +897,78 @@ void MapRenderer::updateAndInvalidateNodeRecursive(Model::Node* node)
   }
 }
 
+/**
+ * Calls updateAndInvalidateNodeRecursive() on the given nodes, but updates every affected
+ * node only once even if the given nodes contain each other. The desired renderers are
+ * determined in parallel since that only reads the nodes.
+ */
+void MapRenderer::updateAndInvalidateNodesRecursive(
+  const std::vector<Model::Node*>& nodes)
+{
+  const auto nodeSet = std::unordered_set<const Model::Node*>{nodes.begin(), nodes.end()};
+  const auto hasAncestorInSet = [&](const Model::Node* node) {
+    for (const auto* ancestor = node->parent(); ancestor; ancestor = ancestor->parent())
+    {
+      if (nodeSet.count(ancestor) > 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto nodesToUpdate = std::vector<Model::Node*>{};
+  for (auto* node : nodes)
+  {
+    if (hasAncestorInSet(node))
+    {
+      continue;
+    }
+
+    node->accept(kdl::overload(
+      [](auto&& thisLambda, Model::WorldNode* world) {
+        world->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, Model::LayerNode* layer) {
+        layer->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, Model::GroupNode* group) {
+        nodesToUpdate.push_back(group);
+        group->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, Model::EntityNode* entity) {
+        nodesToUpdate.push_back(entity);
+        entity->visitChildren(thisLambda);
+      },
+      [&](Model::BrushNode* brush) { nodesToUpdate.push_back(brush); },
+      [&](Model::PatchNode* patchNode) { nodesToUpdate.push_back(patchNode); }));
+
+    // see updateAndInvalidateNodeRecursive()
+    if (node->parent())
+    {
+      nodesToUpdate.push_back(node->parent());
+    }
+  }
+  nodesToUpdate = kdl::vec_sort_and_remove_duplicates(std::move(nodesToUpdate));
+
+  const auto desiredRenderers = kdl::vec_parallel_transform(
+    nodesToUpdate, [](Model::Node* node) { return determineDesiredRenderers(node); });
+
+  for (size_t i = 0; i < nodesToUpdate.size(); ++i)
+  {
+    updateAndInvalidateNode(nodesToUpdate[i], desiredRenderers[i]);
+  }
+}
+
 void MapRenderer::removeNode(Model::Node* node)
 {
   if (auto it = m_trackedNodes.find(node); it != m_trackedNodes.end())
   {
-    const auto renderers = it->second;
+    const auto renderers = it->second.renderers;
 
     if (renderers & static_cast<int>(Renderer::Default))
     {
-      m_defaultRenderer->removeNode(node);
+      it->second.layerRenderer->renderer->removeNode(node);
     }
     if (renderers & static_cast<int>(Renderer::Selection))
     {
@@ -578,6 +986,7 @@ void MapRenderer::removeNode(Model::Node* node)
     // to `node` anymore, and they won't render it.
 
     m_entityDecalRenderer->removeNode(node);
+    m_entityLinkRenderer->removeNode(node);
   }
 }
 
@@ -615,7 +1024,10 @@ void MapRenderer::invalidateRenderers(const Renderer renderers)
 {
   if (static_cast<int>(renderers) & static_cast<int>(Renderer::Default))
   {
-    m_defaultRenderer->invalidate();
+    for (auto& [layer, layerRenderer] : m_defaultRenderers)
+    {
+      layerRenderer.renderer->invalidate();
+    }
   }
   if (static_cast<int>(renderers) & static_cast<int>(Renderer::Selection))
   {
@@ -644,7 +1056,10 @@ void MapRenderer::invalidateGroupLinkRenderer()
 
 void MapRenderer::reloadEntityModels()
 {
-  m_defaultRenderer->reloadModels();
+  for (auto& [layer, layerRenderer] : m_defaultRenderers)
+  {
+    layerRenderer.renderer->reloadModels();
+  }
   m_selectionRenderer->reloadModels();
   m_lockedRenderer->reloadModels();
 }
@@ -723,6 +1138,15 @@ void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
     // The nodes passed in don't include recursive children, so we need to visit them
     // ourselves. Otherwise deleting a group doesn't delete the brushes within.
     removeNodeRecursive(node);
+
+    // the renderer of a removed layer is empty now
+    node->accept(kdl::overload(
+      [](Model::WorldNode*) {},
+      [&](Model::LayerNode* layer) { m_defaultRenderers.erase(layer); },
+      [](Model::GroupNode*) {},
+      [](Model::EntityNode*) {},
+      [](Model::BrushNode*) {},
+      [](Model::PatchNode*) {}));
   }
   invalidateGroupLinkRenderer();
   invalidateEntityLinkRenderer();
@@ -730,12 +1154,17 @@ void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
 
 void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
 {
-  for (auto* node : nodes)
+  // Only reads the nodes, so it can be done in parallel for large changes. Updating the
+  // renderers must be done serially.
+  const auto desiredRenderers = kdl::vec_parallel_transform(
+    nodes, [](Model::Node* node) { return determineDesiredRenderers(node); });
+
+  for (size_t i = 0; i < nodes.size(); ++i)
   {
     // nodesDidChange() will report ancestors changing, e.g. the world and layer are
     // reported as changing when a brush is dragged. So, don't update recursively here as
     // it would cause the entire map to be invalidated on every change.
-    updateAndInvalidateNode(node);
+    updateAndInvalidateNode(nodes[i], desiredRenderers[i]);
   }
   invalidateEntityLinkRenderer();
   invalidateGroupLinkRenderer();
@@ -743,19 +1172,50 @@ void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
 
 void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>& nodes)
 {
+  // Which renderers a node belongs to does not depend on its visibility. If a layer was
+  // hidden or shown, only the renderer of that layer needs to be rebuilt. The selection
+  // and locked renderers may contain nodes of the layer, too.
+  auto layers = std::vector<Model::LayerNode*>{};
+  auto otherNodes = std::vector<Model::Node*>{};
   for (auto* node : nodes)
   {
-    updateAndInvalidateNodeRecursive(node);
+    node->accept(kdl::overload(
+      [&](Model::WorldNode*) { otherNodes.push_back(node); },
+      [&](Model::LayerNode* layer) { layers.push_back(layer); },
+      [&](Model::GroupNode*) { otherNodes.push_back(node); },
+      [&](Model::EntityNode*) { otherNodes.push_back(node); },
+      [&](Model::BrushNode*) { otherNodes.push_back(node); },
+      [&](Model::PatchNode*) { otherNodes.push_back(node); }));
   }
+
+  if (!layers.empty())
+  {
+    for (auto* layer : layers)
+    {
+      layerRenderer(layer).renderer->invalidate();
+
+      // decals are only created for visible entities
+      layer->accept(kdl::overload(
+        [](Model::WorldNode*) {},
+        [](auto&& thisLambda, Model::LayerNode* l) { l->visitChildren(thisLambda); },
+        [](auto&& thisLambda, Model::GroupNode* g) { g->visitChildren(thisLambda); },
+        [&](Model::EntityNode* entity) { m_entityDecalRenderer->updateNode(entity); },
+        [](Model::BrushNode*) {},
+        [](Model::PatchNode*) {}));
+    }
+
+    m_selectionRenderer->invalidate();
+    m_lockedRenderer->invalidate();
+    invalidateEntityDecalRenderer();
+  }
+
+  updateAndInvalidateNodesRecursive(otherNodes);
   invalidateEntityLinkRenderer();
 }
 
 void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>& nodes)
 {
-  for (auto* node : nodes)
-  {
-    updateAndInvalidateNodeRecursive(node);
-  }
+  updateAndInvalidateNodesRecursive(nodes);
   invalidateEntityLinkRenderer();
 }
 
@@ -781,24 +1241,19 @@ void MapRenderer::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&
 
 void MapRenderer::selectionDidChange(const View::Selection& selection)
 {
+  // These need to be recursive otherwise selecting a Group doesn't render the contents
+  // selected. Every affected node is updated only once, even if many of the nodes share
+  // a parent.
+  auto nodes = kdl::vec_concat(selection.deselectedNodes(), selection.selectedNodes());
   for (const auto& face : selection.deselectedBrushFaces())
   {
-    updateAndInvalidateNode(face.node());
+    nodes.push_back(face.node());
   }
   for (const auto& face : selection.selectedBrushFaces())
   {
-    updateAndInvalidateNode(face.node());
-  }
-  // These need to be recursive otherwise selecting a Group doesn't render the contents
-  // selected
-  for (auto* node : selection.deselectedNodes())
-  {
-    updateAndInvalidateNodeRecursive(node);
-  }
-  for (auto* node : selection.selectedNodes())
-  {
-    updateAndInvalidateNodeRecursive(node);
+    nodes.push_back(face.node());
   }
+  updateAndInvalidateNodesRecursive(nodes);
 
   invalidateEntityLinkRenderer();
   invalidateGroupLinkRenderer();
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "NotifierConnection.h"
+#include "Renderer/OcclusionCuller.h"
 
 #include <filesystem>
 #include <memory>
@@ -42,6 +43,7 @@ namespace Model
 {
 class BrushNode;
 class BrushFaceHandle;
+class EditorContext;
 class GroupNode;
 class LayerNode;
 class Node;
@@ -49,6 +51,7 @@ class Node;
 
 namespace Renderer
 {
+class Camera;
 class EntityDecalRenderer;
 class EntityLinkRenderer;
 class GroupLinkRenderer;
@@ -61,7 +64,18 @@ class MapRenderer
 private:
   std::weak_ptr<View::MapDocument> m_document;
 
-  std::unique_ptr<ObjectRenderer> m_defaultRenderer;
+  /**
+   * Objects that are neither selected nor locked are rendered by one renderer per layer.
+   * Changing the visibility of a layer then only invalidates and uploads the buffers of
+   * that layer, and the index arrays of the other layers are left alone.
+   */
+  struct LayerRenderer
+  {
+    std::unique_ptr<ObjectRenderer> renderer;
+    std::vector<const Model::BrushNode*> visibleBrushes;
+  };
+
+  std::unordered_map<const Model::LayerNode*, LayerRenderer> m_defaultRenderers;
   std::unique_ptr<ObjectRenderer> m_selectionRenderer;
   std::unique_ptr<ObjectRenderer> m_lockedRenderer;
   std::unique_ptr<EntityDecalRenderer> m_entityDecalRenderer;
@@ -76,7 +90,26 @@ private:
     All = Default | Selection | Locked
   };
 
-  std::unordered_map<Model::Node*, int> m_trackedNodes;
+  struct TrackedNode
+  {
+    int renderers;
+    /** The renderer of the layer that contains this node if it is a default node. */
+    LayerRenderer* layerRenderer;
+    /**
+     * Whether this node is suppressed in the renderer of its layer. A selected brush
+     * keeps its geometry in that renderer so that deselecting it doesn't upload it again.
+     * It is still tracked as a default node in that case.
+     */
+    bool suppressed;
+  };
+
+  std::unordered_map<const Model::Node*, TrackedNode> m_trackedNodes;
+
+  std::vector<Model::Node*> m_potentiallyVisibleNodes;
+  std::vector<const Model::BrushNode*> m_visibleBrushes;
+  OcclusionCuller m_occlusionCuller;
+  std::vector<const Model::BrushNode*> m_unoccludedBrushes;
+  size_t m_culledBrushCount;
 
   NotifierConnection m_notifierConnection;
 
@@ -89,6 +122,7 @@ public:
 private:
   static std::unique_ptr<ObjectRenderer> createDefaultRenderer(
     std::weak_ptr<View::MapDocument> document);
+  LayerRenderer& layerRenderer(const Model::LayerNode* layer);
   static std::unique_ptr<ObjectRenderer> createSelectionRenderer(
     std::weak_ptr<View::MapDocument> document);
   static std::unique_ptr<ObjectRenderer> createLockRenderer(
@@ -102,10 +136,33 @@ public: // color config
   void restoreSelectionColors();
 
 public: // rendering
+  /**
+   * Commits pending asset changes, validates the brushes and compacts the arrays that are
+   * shared by all views of the map. This does not depend on the camera, so when the map
+   * is shown in several views, only one of them needs to call this per frame. render()
+   * only validates what is still invalid and then performs the camera dependent steps.
+   */
+  void prepare();
+
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Returns the number of brushes that were not rendered during the last call to render()
+   * because they were outside of the camera frustum or hidden behind other brushes.
+   */
+  size_t culledBrushCount() const;
+
+  /**
+   * Returns the number of bytes allocated for the arrays of the brush renderers of all
+   * layers, the selection and the locked objects, see BrushRenderer::memoryUsage().
+   */
+  size_t brushMemoryUsage() const;
+
 private:
   void commitPendingChanges();
+  void updateVisibleBrushes(const RenderContext& renderContext);
+  void updateOcclusionCuller(
+    const Camera& camera, const Model::EditorContext& editorContext);
   void setupGL(RenderBatch& renderBatch);
   void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -124,7 +181,9 @@ private:
 
   static int determineDesiredRenderers(Model::Node* node);
   void updateAndInvalidateNode(Model::Node* node);
+  void updateAndInvalidateNode(Model::Node* node, int desiredRenderers);
   void updateAndInvalidateNodeRecursive(Model::Node* node);
+  void updateAndInvalidateNodesRecursive(const std::vector<Model::Node*>& nodes);
   void removeNode(Model::Node* node);
   void removeNodeRecursive(Model::Node* node);
   void updateAllNodes();
@@ -81,6 +81,20 @@ void ObjectRenderer::reloadModels()
   m_entityRenderer.reloadModels();
 }
 
+bool ObjectRenderer::setNodeSuppressed(Model::Node* node, const bool suppressed)
+{
+  return node->accept(kdl::overload(
+    [](Model::WorldNode*) { return false; },
+    [](Model::LayerNode*) { return false; },
+    [](Model::GroupNode*) { return false; },
+    [](Model::EntityNode*) { return false; },
+    [&](Model::BrushNode* brush) {
+      m_brushRenderer.setBrushSuppressed(brush, suppressed);
+      return true;
+    },
+    [](Model::PatchNode*) { return false; }));
+}
+
 void ObjectRenderer::setShowOverlays(const bool showOverlays)
 {
   m_groupRenderer.setShowOverlays(showOverlays);
@@ -195,6 +209,22 @@ void ObjectRenderer::setShowHiddenObjects(const bool showHiddenObjects)
   m_brushRenderer.setShowHiddenBrushes(showHiddenObjects);
 }
 
+void ObjectRenderer::setVisibleBrushes(
+  const std::vector<const Model::BrushNode*>* visibleBrushes)
+{
+  m_brushRenderer.setVisibleBrushes(visibleBrushes);
+}
+
+void ObjectRenderer::setOcclusionCuller(const OcclusionCuller* occlusionCuller)
+{
+  m_entityRenderer.setOcclusionCuller(occlusionCuller);
+}
+
+void ObjectRenderer::prepare()
+{
+  m_brushRenderer.prepare();
+}
+
 void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   m_brushRenderer.renderOpaque(renderContext, renderBatch);
@@ -208,5 +238,15 @@ void ObjectRenderer::renderTransparent(
 {
   m_brushRenderer.renderTransparent(renderContext, renderBatch);
 }
+
+size_t ObjectRenderer::culledBrushCount() const
+{
+  return m_brushRenderer.culledBrushCount();
+}
+
+size_t ObjectRenderer::brushMemoryUsage() const
+{
+  return m_brushRenderer.memoryUsage();
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -50,6 +50,7 @@ class PatchNode;
 namespace Renderer
 {
 class FontManager;
+class OcclusionCuller;
 class RenderBatch;
 
 class ObjectRenderer
@@ -82,6 +83,13 @@ public: // object management
   void clear();
   void reloadModels();
 
+  /**
+   * Suppresses or shows the given node without removing its geometry, see
+   * BrushRenderer::setBrushSuppressed(). Only brushes can be suppressed, so for other
+   * nodes, this does nothing and returns false.
+   */
+  bool setNodeSuppressed(Model::Node* node, bool suppressed);
+
 public: // configuration
   void setShowOverlays(bool showOverlays);
   void setEntityOverlayTextColor(const Color& overlayTextColor);
@@ -111,10 +119,26 @@ public: // configuration
 
   void setShowHiddenObjects(bool showHiddenObjects);
 
+  void setVisibleBrushes(const std::vector<const Model::BrushNode*>* visibleBrushes);
+  void setOcclusionCuller(const OcclusionCuller* occlusionCuller);
+
 public: // rendering
+  /**
+   * Brings the camera independent render data up to date, see BrushRenderer::prepare().
+   */
+  void prepare();
+
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  size_t culledBrushCount() const;
+
+  /**
+   * Returns the number of bytes allocated for the arrays of the brush renderer, see
+   * BrushRenderer::memoryUsage().
+   */
+  size_t brushMemoryUsage() const;
+
   deleteCopy(ObjectRenderer);
 };
 } // namespace Renderer
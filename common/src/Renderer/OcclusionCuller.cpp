@@ -0,0 +1,331 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "OcclusionCuller.h"
+
+#include "Renderer/Camera.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+constexpr auto FarDepth = std::numeric_limits<float>::max();
+
+float cross(const vm::vec2f& o, const vm::vec2f& a, const vm::vec2f& b)
+{
+  return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+size_t toTexel(const float f, const size_t size)
+{
+  return size_t(vm::clamp(f, 0.0f, float(size - 1)));
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+  : m_nearPlane{0.0f}
+  , m_hierarchyValid{false}
+{
+}
+
+void OcclusionCuller::reset(const Camera& camera, const size_t width)
+{
+  assert(camera.perspectiveProjection());
+  assert(width > 0);
+
+  const auto& viewport = camera.viewport();
+  const auto aspect =
+    viewport.width > 0 ? float(viewport.height) / float(viewport.width) : 1.0f;
+  const auto height = std::max(size_t(1), size_t(vm::round(float(width) * aspect)));
+
+  m_viewProjection = camera.projectionMatrix() * camera.viewMatrix();
+  m_nearPlane = camera.nearPlane();
+
+  m_levels.resize(1);
+  auto& level = m_levels.front();
+  level.width = width;
+  level.height = height;
+  level.depths.assign(width * height, FarDepth);
+  m_hierarchyValid = false;
+}
+
+size_t OcclusionCuller::width() const
+{
+  return !m_levels.empty() ? m_levels.front().width : 0;
+}
+
+size_t OcclusionCuller::height() const
+{
+  return !m_levels.empty() ? m_levels.front().height : 0;
+}
+
+void OcclusionCuller::addOccluder(const std::vector<vm::vec3>& polygon)
+{
+  assert(!m_levels.empty());
+  assert(!m_hierarchyValid);
+
+  // transform to clip space and clip against the near plane, where w is the distance
+  // along the viewing direction
+  m_clipPolygon.clear();
+  for (size_t i = 0; i < polygon.size(); ++i)
+  {
+    const auto current = m_viewProjection * vm::vec4f{vm::vec3f{polygon[i]}, 1.0f};
+    const auto next =
+      m_viewProjection * vm::vec4f{vm::vec3f{polygon[(i + 1) % polygon.size()]}, 1.0f};
+
+    const auto currentInside = current.w() >= m_nearPlane;
+    if (currentInside)
+    {
+      m_clipPolygon.push_back(current);
+    }
+    if (currentInside != (next.w() >= m_nearPlane))
+    {
+      const auto t = (m_nearPlane - current.w()) / (next.w() - current.w());
+      m_clipPolygon.push_back(vm::mix(current, next, vm::vec4f::fill(t)));
+    }
+  }
+
+  if (m_clipPolygon.size() < 3)
+  {
+    return;
+  }
+
+  auto maxDepth = 0.0f;
+  m_screenPolygon.clear();
+  for (const auto& clipPoint : m_clipPolygon)
+  {
+    maxDepth = std::max(maxDepth, clipPoint.w());
+    m_screenPolygon.push_back(toScreen(clipPoint));
+  }
+
+  // the polygon may have either winding order on screen, and the largest triangle of its
+  // fan is used to interpolate the depth
+  auto area = 0.0f;
+  auto largestTriangle = size_t(1);
+  auto largestTriangleArea = 0.0f;
+  for (size_t i = 1; i + 1 < m_screenPolygon.size(); ++i)
+  {
+    const auto triangleArea =
+      cross(m_screenPolygon[0], m_screenPolygon[i], m_screenPolygon[i + 1]);
+    area += triangleArea;
+    if (std::abs(triangleArea) > std::abs(largestTriangleArea))
+    {
+      largestTriangle = i;
+      largestTriangleArea = triangleArea;
+    }
+  }
+  if (area == 0.0f)
+  {
+    return;
+  }
+  const auto orientation = area > 0.0f ? 1.0f : -1.0f;
+
+  // 1 / depth is an affine function of the screen coordinates on a planar polygon; it is
+  // evaluated at the texel corner where it is smallest so that the depth written for a
+  // texel is the largest depth of the polygon within it
+  auto a = 0.0f;
+  auto b = 0.0f;
+  auto c = 0.0f;
+  const auto interpolate = std::abs(largestTriangleArea) >= 1.0f;
+  if (interpolate)
+  {
+    const auto& s0 = m_screenPolygon[0];
+    const auto d1 = m_screenPolygon[largestTriangle] - s0;
+    const auto d2 = m_screenPolygon[largestTriangle + 1] - s0;
+    const auto i0 = 1.0f / m_clipPolygon[0].w();
+    const auto e1 = 1.0f / m_clipPolygon[largestTriangle].w() - i0;
+    const auto e2 = 1.0f / m_clipPolygon[largestTriangle + 1].w() - i0;
+    a = (e1 * d2.y() - e2 * d1.y()) / largestTriangleArea;
+    b = (d1.x() * e2 - d2.x() * e1) / largestTriangleArea;
+    c = i0 - a * s0.x() - b * s0.y();
+  }
+
+  auto& level = m_levels.front();
+  auto min = m_screenPolygon.front();
+  auto max = m_screenPolygon.front();
+  for (const auto& point : m_screenPolygon)
+  {
+    min = vm::min(min, point);
+    max = vm::max(max, point);
+  }
+
+  if (
+    max.x() < 0.0f || max.y() < 0.0f || min.x() > float(level.width)
+    || min.y() > float(level.height))
+  {
+    return;
+  }
+
+  const auto x0 = toTexel(min.x(), level.width);
+  const auto x1 = toTexel(max.x(), level.width);
+  const auto y0 = toTexel(min.y(), level.height);
+  const auto y1 = toTexel(max.y(), level.height);
+
+  for (auto y = y0; y <= y1; ++y)
+  {
+    for (auto x = x0; x <= x1; ++x)
+    {
+      const auto center = vm::vec2f{float(x) + 0.5f, float(y) + 0.5f};
+
+      auto inside = true;
+      for (size_t i = 0; i < m_screenPolygon.size() && inside; ++i)
+      {
+        const auto& p1 = m_screenPolygon[i];
+        const auto& p2 = m_screenPolygon[(i + 1) % m_screenPolygon.size()];
+        inside = orientation * cross(p1, p2, center) >= 0.0f;
+      }
+
+      if (inside)
+      {
+        auto depth = maxDepth;
+        if (interpolate)
+        {
+          const auto inverseDepth = a * (float(x) + (a < 0.0f ? 1.0f : 0.0f))
+                                    + b * (float(y) + (b < 0.0f ? 1.0f : 0.0f)) + c;
+          if (inverseDepth > 0.0f)
+          {
+            depth = std::min(depth, 1.0f / inverseDepth);
+          }
+        }
+
+        auto& texel = level.depths[y * level.width + x];
+        texel = std::min(texel, depth);
+      }
+    }
+  }
+}
+
+void OcclusionCuller::buildHierarchy()
+{
+  assert(!m_levels.empty());
+
+  m_levels.resize(1);
+  while (m_levels.back().width > 1 || m_levels.back().height > 1)
+  {
+    const auto& fine = m_levels.back();
+
+    auto coarse = Level{(fine.width + 1) / 2, (fine.height + 1) / 2, {}};
+    coarse.depths.resize(coarse.width * coarse.height);
+    for (size_t y = 0; y < coarse.height; ++y)
+    {
+      for (size_t x = 0; x < coarse.width; ++x)
+      {
+        auto depth = 0.0f;
+        for (auto fy = 2 * y; fy < std::min(2 * y + 2, fine.height); ++fy)
+        {
+          for (auto fx = 2 * x; fx < std::min(2 * x + 2, fine.width); ++fx)
+          {
+            depth = std::max(depth, fine.depths[fy * fine.width + fx]);
+          }
+        }
+        coarse.depths[y * coarse.width + x] = depth;
+      }
+    }
+
+    m_levels.push_back(std::move(coarse));
+  }
+
+  m_hierarchyValid = true;
+}
+
+bool OcclusionCuller::occluded(const vm::bbox3& bounds) const
+{
+  assert(m_hierarchyValid);
+
+  auto depth = FarDepth;
+  auto min = vm::vec2f::fill(FarDepth);
+  auto max = vm::vec2f::fill(-FarDepth);
+  for (const auto& corner : vm::bbox3f{bounds}.vertices())
+  {
+    const auto clipPoint = m_viewProjection * vm::vec4f{corner, 1.0f};
+    if (clipPoint.w() < m_nearPlane)
+    {
+      return false;
+    }
+
+    depth = std::min(depth, clipPoint.w());
+
+    const auto point = toScreen(clipPoint);
+    min = vm::min(min, point);
+    max = vm::max(max, point);
+  }
+
+  const auto& finest = m_levels.front();
+  if (
+    max.x() < 0.0f || max.y() < 0.0f || min.x() > float(finest.width)
+    || min.y() > float(finest.height))
+  {
+    // outside of the view, this is left to frustum culling
+    return false;
+  }
+
+  auto x0 = toTexel(min.x(), finest.width);
+  auto x1 = toTexel(max.x(), finest.width);
+  auto y0 = toTexel(min.y(), finest.height);
+  auto y1 = toTexel(max.y(), finest.height);
+
+  // find the first level where the bounds cover at most 2x2 texels
+  auto levelIndex = size_t(0);
+  while (x1 - x0 > 1 || y1 - y0 > 1)
+  {
+    x0 /= 2;
+    x1 /= 2;
+    y0 /= 2;
+    y1 /= 2;
+    ++levelIndex;
+  }
+
+  assert(levelIndex < m_levels.size());
+  const auto& level = m_levels[levelIndex];
+  for (auto y = y0; y <= y1; ++y)
+  {
+    for (auto x = x0; x <= x1; ++x)
+    {
+      if (level.depths[y * level.width + x] >= depth)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+vm::vec2f OcclusionCuller::toScreen(const vm::vec4f& clipPoint) const
+{
+  const auto& level = m_levels.front();
+  return vm::vec2f{
+    (clipPoint.x() / clipPoint.w() * 0.5f + 0.5f) * float(level.width),
+    (clipPoint.y() / clipPoint.w() * 0.5f + 0.5f) * float(level.height)};
+}
+} // namespace Renderer
+} // namespace TrenchBroom
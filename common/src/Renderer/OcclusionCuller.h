@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "FloatType.h"
+
+#include <vecmath/forward.h>
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+class Camera;
+
+/**
+ * Decides whether objects are hidden behind large occluders in a perspective view.
+ *
+ * The occluders are rasterized into a small depth buffer on the CPU, from which a
+ * hierarchy of coarser depth buffers is built. Every texel of a coarser level stores the
+ * largest depth of the four texels below it. An object is occluded if its bounds lie
+ * behind the depth stored in the few texels of the level that cover its bounds on screen.
+ *
+ * The depth of a point is its distance along the viewing direction. Every texel stores
+ * the largest depth of an occluder within it, and the bounds of an object are tested
+ * with the depth of their nearest corner, so an object is never reported as occluded if
+ * any part of it is in front of an occluder. Coverage is sampled at texel centers, so
+ * objects that are only visible through gaps that are smaller than a texel may be
+ * reported as occluded.
+ */
+class OcclusionCuller
+{
+private:
+  struct Level
+  {
+    size_t width;
+    size_t height;
+    std::vector<float> depths;
+  };
+
+  vm::mat4x4f m_viewProjection;
+  float m_nearPlane;
+  std::vector<Level> m_levels;
+  bool m_hierarchyValid;
+
+  std::vector<vm::vec4f> m_clipPolygon;
+  std::vector<vm::vec2f> m_screenPolygon;
+
+public:
+  static constexpr size_t DefaultWidth = 256;
+
+  OcclusionCuller();
+
+  /**
+   * Removes all occluders and sets up the culler for the given perspective camera. The
+   * depth buffer is the given number of texels wide and has the aspect ratio of the
+   * camera's viewport.
+   */
+  void reset(const Camera& camera, size_t width = DefaultWidth);
+
+  size_t width() const;
+  size_t height() const;
+
+  /**
+   * Adds the given convex polygon as an occluder. The parts of the polygon that are in
+   * front of the near plane are ignored.
+   */
+  void addOccluder(const std::vector<vm::vec3>& polygon);
+
+  /**
+   * Builds the coarser levels of the depth buffer. Must be called after the occluders
+   * have been added and before any bounds are tested.
+   */
+  void buildHierarchy();
+
+  /**
+   * Indicates whether the given bounds are hidden by the occluders added since the last
+   * call to reset(). Bounds that intersect the near plane are never occluded.
+   */
+  bool occluded(const vm::bbox3& bounds) const;
+
+private:
+  vm::vec2f toScreen(const vm::vec4f& clipPoint) const;
+};
+} // namespace Renderer
+} // namespace TrenchBroom
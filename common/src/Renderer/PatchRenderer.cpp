@@ -166,16 +166,16 @@ static TexturedIndexArrayRenderer buildMeshRenderer(
   {
     if (editorContext.visible(patchNode))
     {
-      vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
+      const auto& grid = patchNode->renderGrid();
+      vertexCount += grid.pointRowCount * grid.pointColumnCount;
 
       const auto* texture = patchNode->patch().texture();
-      const auto quadCount =
-        patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
+      const auto quadCount = grid.quadRowCount() * grid.quadColumnCount();
       indexArrayMapSize.inc(texture, PrimType::Triangles, 6u * quadCount);
     }
   }
 
-  using Vertex = GLVertexTypes::P3NT2::Vertex;
+  using Vertex = GLVertexTypes::P3NBT2::Vertex;
   auto vertices = std::vector<Vertex>{};
   vertices.reserve(vertexCount);
 
@@ -188,9 +188,10 @@ static TexturedIndexArrayRenderer buildMeshRenderer(
     {
       const auto vertexOffset = vertices.size();
 
-      const auto& grid = patchNode->grid();
+      const auto& grid = patchNode->renderGrid();
       auto gridVertices = kdl::vec_transform(grid.points, [](const auto& p) {
-        return Vertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.texCoords}};
+        return Vertex{
+          vm::vec3f{p.position}, ByteNormal{vm::vec3f{p.normal}}, vm::vec2f{p.texCoords}};
       });
       vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
 
@@ -240,8 +241,8 @@ static DirectEdgeRenderer buildEdgeRenderer(
   {
     if (editorContext.visible(patchNode))
     {
-      vertexCount +=
-        (patchNode->grid().pointRowCount + patchNode->grid().pointColumnCount - 2u) * 2u;
+      const auto& grid = patchNode->renderGrid();
+      vertexCount += (grid.pointRowCount + grid.pointColumnCount - 2u) * 2u;
       indexRangeMapSize.inc(PrimType::LineLoop, vertexCount);
     }
   }
@@ -253,7 +254,7 @@ static DirectEdgeRenderer buildEdgeRenderer(
   {
     if (editorContext.visible(patchNode))
     {
-      const auto& grid = patchNode->grid();
+      const auto& grid = patchNode->renderGrid();
 
       auto edgeLoopVertices = std::vector<GLVertexTypes::P3::Vertex>{};
       edgeLoopVertices.reserve((grid.pointRowCount + grid.pointColumnCount - 2u) * 2u);
@@ -23,8 +23,10 @@
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/Camera.h"
+#include "Renderer/GLVertexType.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/VboManager.h"
 
@@ -32,12 +34,33 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <string>
+#include <vector>
+
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+struct InstancePositionName
+{
+  static inline const auto name = std::string{"InstancePosition"};
+};
+
+using InstanceVertex =
+  GLVertexType<GLVertexAttributeUser<InstancePositionName, GL_FLOAT, 3, false>>::Vertex;
+
+void setInstanceAttributeDivisor(ShaderProgram& program, const GLuint divisor)
+{
+  const auto location = program.findAttributeLocation(InstancePositionName::name);
+  glAssert(glVertexAttribDivisor(static_cast<GLuint>(location), divisor));
+}
+} // namespace
+
 PointHandleRenderer::PointHandleRenderer()
-  : m_handle(pref(Preferences::HandleRadius), 16, true)
+  : m_useInstancing(false)
+  , m_handle(pref(Preferences::HandleRadius), 16, true)
   , m_highlight(2.0f * pref(Preferences::HandleRadius), 16, false)
 {
 }
@@ -56,6 +79,13 @@ void PointHandleRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_handle.prepare(vboManager);
   m_highlight.prepare(vboManager);
+
+  m_useInstancing = GLEW_VERSION_3_3;
+  if (m_useInstancing)
+  {
+    prepareInstances(m_pointHandles, m_pointHandleInstances, vboManager);
+    prepareInstances(m_highlights, m_highlightInstances, vboManager);
+  }
 }
 
 void PointHandleRenderer::doRender(RenderContext& renderContext)
@@ -75,33 +105,62 @@ void PointHandleRenderer::doRender(RenderContext& renderContext)
   if (renderContext.render3D())
   {
     // Un-occluded handles: use depth test, draw fully opaque
-    renderHandles(renderContext, m_pointHandles, m_handle, 1.0f);
-    renderHandles(renderContext, m_highlights, m_highlight, 1.0f);
+    renderHandles(renderContext, m_pointHandles, m_pointHandleInstances, m_handle, 1.0f);
+    renderHandles(renderContext, m_highlights, m_highlightInstances, m_highlight, 1.0f);
 
     // Occluded handles: don't use depth test, but draw translucent
     glAssert(glDisable(GL_DEPTH_TEST));
-    renderHandles(renderContext, m_pointHandles, m_handle, 0.33f);
-    renderHandles(renderContext, m_highlights, m_highlight, 0.33f);
+    renderHandles(renderContext, m_pointHandles, m_pointHandleInstances, m_handle, 0.33f);
+    renderHandles(renderContext, m_highlights, m_highlightInstances, m_highlight, 0.33f);
     glAssert(glEnable(GL_DEPTH_TEST));
   }
   else
   {
     // In 2D views, render fully opaque without depth test
     glAssert(glDisable(GL_DEPTH_TEST));
-    renderHandles(renderContext, m_pointHandles, m_handle, 1.0f);
-    renderHandles(renderContext, m_highlights, m_highlight, 1.0f);
+    renderHandles(renderContext, m_pointHandles, m_pointHandleInstances, m_handle, 1.0f);
+    renderHandles(renderContext, m_highlights, m_highlightInstances, m_highlight, 1.0f);
     glAssert(glEnable(GL_DEPTH_TEST));
   }
 
   clear();
 }
 
+void PointHandleRenderer::prepareInstances(
+  const HandleMap& map, InstanceMap& instances, VboManager& vboManager)
+{
+  for (const auto& [color, positions] : map)
+  {
+    auto instanceVertices = std::vector<InstanceVertex>{};
+    instanceVertices.reserve(positions.size());
+    for (const auto& position : positions)
+    {
+      instanceVertices.emplace_back(position);
+    }
+
+    auto& instanceArray = instances[color];
+    instanceArray = VertexArray::move(std::move(instanceVertices));
+    instanceArray.prepare(vboManager);
+  }
+}
+
 void PointHandleRenderer::renderHandles(
-  RenderContext& renderContext, const HandleMap& map, Circle& circle, const float opacity)
+  RenderContext& renderContext,
+  const HandleMap& map,
+  InstanceMap& instances,
+  Circle& circle,
+  const float opacity)
 {
   const Camera& camera = renderContext.camera();
   ActiveShader shader(renderContext.shaderManager(), Shaders::HandleShader);
 
+  if (m_useInstancing)
+  {
+    renderInstancedHandles(renderContext, shader, instances, circle, opacity);
+    return;
+  }
+
+  shader.set("UseInstancePosition", false);
   for (const auto& [color, positions] : map)
   {
     shader.set("Color", mixAlpha(color, opacity));
@@ -127,10 +186,52 @@ void PointHandleRenderer::renderHandles(
   }
 }
 
+void PointHandleRenderer::renderInstancedHandles(
+  RenderContext& renderContext,
+  ActiveShader& shader,
+  InstanceMap& instances,
+  Circle& circle,
+  const float opacity)
+{
+  const Camera& camera = renderContext.camera();
+  const Camera::Viewport& viewport = camera.viewport();
+
+  // the shader projects the handle positions the same way as Camera::project
+  shader.set("UseInstancePosition", true);
+  shader.set("CameraMatrix", camera.projectionMatrix() * camera.viewMatrix());
+  shader.set(
+    "ViewportSize",
+    vm::vec2f{
+      static_cast<float>(viewport.x + viewport.width),
+      static_cast<float>(viewport.y + viewport.height)});
+  shader.set("CameraPosition", camera.position());
+
+  // In 3D view, nudge towards camera by the handle radius, to prevent lines (brush
+  // edges, etc.) from clipping into the handle
+  shader.set(
+    "NudgeDistance", renderContext.render3D() ? pref(Preferences::HandleRadius) : 0.0f);
+
+  auto& program = *renderContext.shaderManager().currentProgram();
+  for (auto& [color, instanceArray] : instances)
+  {
+    shader.set("Color", mixAlpha(color, opacity));
+
+    if (instanceArray.setup())
+    {
+      setInstanceAttributeDivisor(program, 1);
+      circle.renderInstanced(instanceArray.vertexCount());
+      setInstanceAttributeDivisor(program, 0);
+      instanceArray.cleanup();
+    }
+  }
+}
+
 void PointHandleRenderer::clear()
 {
   m_pointHandles.clear();
   m_highlights.clear();
+  m_pointHandleInstances.clear();
+  m_highlightInstances.clear();
 }
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,6 +22,7 @@
 #include "Color.h"
 #include "Renderer/Circle.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/VertexArray.h"
 
 #include <vecmath/forward.h>
 
@@ -39,10 +40,19 @@ class PointHandleRenderer : public DirectRenderable
 {
 private:
   using HandleMap = std::map<Color, std::vector<vm::vec3f>>;
+  using InstanceMap = std::map<Color, VertexArray>;
 
   HandleMap m_pointHandles;
   HandleMap m_highlights;
 
+  /**
+   * The handle positions of each color, uploaded as per instance vertex arrays so that
+   * all handles of one color can be drawn with a single instanced draw call.
+   */
+  InstanceMap m_pointHandleInstances;
+  InstanceMap m_highlightInstances;
+  bool m_useInstancing;
+
   Circle m_handle;
   Circle m_highlight;
 
@@ -55,8 +65,20 @@ public:
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+  void prepareInstances(
+    const HandleMap& map, InstanceMap& instances, VboManager& vboManager);
   void renderHandles(
-    RenderContext& renderContext, const HandleMap& map, Circle& circle, float opacity);
+    RenderContext& renderContext,
+    const HandleMap& map,
+    InstanceMap& instances,
+    Circle& circle,
+    float opacity);
+  void renderInstancedHandles(
+    RenderContext& renderContext,
+    ActiveShader& shader,
+    InstanceMap& instances,
+    Circle& circle,
+    float opacity);
 
   void clear();
 };
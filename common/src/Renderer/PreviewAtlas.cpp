@@ -0,0 +1,219 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreviewAtlas.h"
+
+#include "Ensure.h"
+
+#include <vecmath/vec.h>
+
+#include <cassert>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+constexpr auto PageSize = size_t(2048);
+} // namespace
+
+bool PreviewAtlas::isSupported()
+{
+  return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+}
+
+PreviewAtlas::PreviewAtlas(const size_t slotWidth, const size_t slotHeight)
+  : m_slotWidth{slotWidth}
+  , m_slotHeight{slotHeight}
+{
+  ensure(m_slotWidth > 0 && m_slotWidth <= PageSize, "invalid slot width");
+  ensure(m_slotHeight > 0 && m_slotHeight <= PageSize, "invalid slot height");
+}
+
+PreviewAtlas::~PreviewAtlas()
+{
+  clear();
+}
+
+size_t PreviewAtlas::slotWidth() const
+{
+  return m_slotWidth;
+}
+
+size_t PreviewAtlas::slotHeight() const
+{
+  return m_slotHeight;
+}
+
+PreviewAtlas::Slot PreviewAtlas::allocateSlot()
+{
+  if (m_slotCount == m_pages.size() * slotsPerPage())
+  {
+    addPage();
+  }
+
+  const auto index = m_slotCount++;
+  const auto indexInPage = index % slotsPerPage();
+  return Slot{
+    index / slotsPerPage(),
+    (indexInPage % slotsPerRow()) * m_slotWidth,
+    (indexInPage / slotsPerRow()) * m_slotHeight};
+}
+
+void PreviewAtlas::render(
+  const Slot& slot,
+  const size_t width,
+  const size_t height,
+  const GLuint defaultFramebufferId,
+  const std::function<void()>& renderFunc)
+{
+  assert(slot.page < m_pages.size());
+  assert(width <= m_slotWidth && height <= m_slotHeight);
+
+  const auto x = static_cast<GLint>(slot.x);
+  const auto y = static_cast<GLint>(slot.y);
+  const auto w = static_cast<GLsizei>(width);
+  const auto h = static_cast<GLsizei>(height);
+
+  glAssert(glBindFramebuffer(GL_FRAMEBUFFER, m_pages[slot.page].framebufferId));
+  glAssert(glPushAttrib(GL_COLOR_BUFFER_BIT | GL_SCISSOR_BIT | GL_VIEWPORT_BIT));
+
+  glAssert(glViewport(x, y, w, h));
+  glAssert(glEnable(GL_SCISSOR_TEST));
+  glAssert(glScissor(x, y, w, h));
+  glAssert(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+  glAssert(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+  renderFunc();
+
+  glAssert(glPopAttrib());
+  glAssert(glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferId));
+}
+
+std::vector<vm::vec2f> PreviewAtlas::texCoords(
+  const Slot& slot, const size_t width, const size_t height) const
+{
+  // texture coordinates start at the bottom left corner of the page
+  const auto pageSize = static_cast<float>(PageSize);
+  const auto left = static_cast<float>(slot.x) / pageSize;
+  const auto right = static_cast<float>(slot.x + width) / pageSize;
+  const auto bottom = static_cast<float>(slot.y) / pageSize;
+  const auto top = static_cast<float>(slot.y + height) / pageSize;
+
+  return {{left, top}, {left, bottom}, {right, bottom}, {right, top}};
+}
+
+void PreviewAtlas::activate(const size_t page) const
+{
+  assert(page < m_pages.size());
+  glAssert(glBindTexture(GL_TEXTURE_2D, m_pages[page].textureId));
+}
+
+void PreviewAtlas::deactivate() const
+{
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+void PreviewAtlas::freeSlots()
+{
+  m_slotCount = 0;
+}
+
+void PreviewAtlas::clear()
+{
+  for (auto& page : m_pages)
+  {
+    glAssert(glDeleteFramebuffers(1, &page.framebufferId));
+    glAssert(glDeleteTextures(1, &page.textureId));
+  }
+  m_pages.clear();
+
+  if (m_depthBufferId != 0)
+  {
+    glAssert(glDeleteRenderbuffers(1, &m_depthBufferId));
+    m_depthBufferId = 0;
+  }
+
+  m_slotCount = 0;
+}
+
+size_t PreviewAtlas::slotsPerRow() const
+{
+  return PageSize / m_slotWidth;
+}
+
+size_t PreviewAtlas::slotsPerPage() const
+{
+  return slotsPerRow() * (PageSize / m_slotHeight);
+}
+
+void PreviewAtlas::addPage()
+{
+  const auto pageSize = static_cast<GLsizei>(PageSize);
+
+  if (m_depthBufferId == 0)
+  {
+    // all pages share one depth buffer since it is cleared whenever a slot is rendered
+    glAssert(glGenRenderbuffers(1, &m_depthBufferId));
+    glAssert(glBindRenderbuffer(GL_RENDERBUFFER, m_depthBufferId));
+    glAssert(glRenderbufferStorage(
+      GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, pageSize, pageSize));
+    glAssert(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+  }
+
+  auto page = Page{0, 0};
+
+  // previews are drawn at their original size, so they are not filtered
+  glAssert(glGenTextures(1, &page.textureId));
+  glAssert(glBindTexture(GL_TEXTURE_2D, page.textureId));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+  glAssert(glTexImage2D(
+    GL_TEXTURE_2D,
+    0,
+    GL_RGBA,
+    pageSize,
+    pageSize,
+    0,
+    GL_RGBA,
+    GL_UNSIGNED_BYTE,
+    nullptr));
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+
+  GLint previousFramebufferId = 0;
+  glAssert(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebufferId));
+
+  glAssert(glGenFramebuffers(1, &page.framebufferId));
+  glAssert(glBindFramebuffer(GL_FRAMEBUFFER, page.framebufferId));
+  glAssert(glFramebufferTexture2D(
+    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, page.textureId, 0));
+  glAssert(glFramebufferRenderbuffer(
+    GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBufferId));
+  ensure(
+    glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+    "preview atlas framebuffer is incomplete");
+  glAssert(glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebufferId)));
+
+  m_pages.push_back(page);
+}
+} // namespace Renderer
+} // namespace TrenchBroom
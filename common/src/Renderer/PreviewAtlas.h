@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include <vecmath/forward.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+/**
+ * A set of offscreen textures that are divided into slots of equal size. Previews that
+ * are expensive to render can be rendered into a slot once and then be drawn as textured
+ * quads.
+ *
+ * The textures are allocated lazily when slots are allocated. All functions must be
+ * called while the GL context is current.
+ */
+class PreviewAtlas
+{
+public:
+  struct Slot
+  {
+    size_t page;
+    size_t x;
+    size_t y;
+  };
+
+private:
+  struct Page
+  {
+    GLuint textureId;
+    GLuint framebufferId;
+  };
+
+  size_t m_slotWidth;
+  size_t m_slotHeight;
+  std::vector<Page> m_pages;
+  GLuint m_depthBufferId = 0;
+  size_t m_slotCount = 0;
+
+public:
+  /**
+   * Indicates whether the GL implementation supports rendering into textures.
+   */
+  static bool isSupported();
+
+  PreviewAtlas(size_t slotWidth, size_t slotHeight);
+  ~PreviewAtlas();
+
+  PreviewAtlas(const PreviewAtlas&) = delete;
+  PreviewAtlas& operator=(const PreviewAtlas&) = delete;
+
+  size_t slotWidth() const;
+  size_t slotHeight() const;
+
+  /**
+   * Returns a new slot, adding a page if all slots of the existing pages are taken.
+   */
+  Slot allocateSlot();
+
+  /**
+   * Clears the given area of the given slot and calls the given function to render into
+   * it. The viewport is set to the area while the function is called. Afterwards, the
+   * given framebuffer is bound again.
+   */
+  void render(
+    const Slot& slot,
+    size_t width,
+    size_t height,
+    GLuint defaultFramebufferId,
+    const std::function<void()>& renderFunc);
+
+  /**
+   * Returns the texture coordinates of the corners of the given area of the given slot,
+   * in the order top left, bottom left, bottom right, top right.
+   */
+  std::vector<vm::vec2f> texCoords(const Slot& slot, size_t width, size_t height) const;
+
+  void activate(size_t page) const;
+  void deactivate() const;
+
+  /**
+   * Forgets all slots, but keeps the pages so that they can be reused. Unlike clear(),
+   * this can be called while the GL context is not current.
+   */
+  void freeSlots();
+
+  /**
+   * Deletes all pages and forgets all slots.
+   */
+  void clear();
+
+private:
+  size_t slotsPerRow() const;
+  size_t slotsPerPage() const;
+  void addPage();
+};
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -155,6 +155,11 @@ public:
     PrimitiveRendererOcclusionPolicy occlusionPolicy,
     PrimitiveRendererCullingPolicy cullingPolicy,
     const std::vector<vm::vec3f>& positions);
+  void renderFilledTriangles(
+    const Color& color,
+    PrimitiveRendererOcclusionPolicy occlusionPolicy,
+    PrimitiveRendererCullingPolicy cullingPolicy,
+    const std::vector<vm::vec3f>& positions);
 
   void renderCylinder(
     const Color& color,
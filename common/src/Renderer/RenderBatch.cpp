@@ -20,7 +20,10 @@
 #include "RenderBatch.h"
 
 #include "Ensure.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/ShaderManager.h"
 #include "Renderer/VboManager.h"
 
 #include <kdl/vector_utils.h>
@@ -41,6 +44,8 @@ public:
     ensure(m_wrappee != nullptr, "wrappee is null");
   }
 
+  const IndexedRenderable& wrappee() const { return *m_wrappee; }
+
 private:
   void prepareVerticesAndIndices(VboManager& vboManager) override
   {
@@ -105,7 +110,16 @@ void RenderBatch::addOneShot(IndexedRenderable* renderable)
 
 void RenderBatch::render(RenderContext& renderContext)
 {
-  prepareRenderables();
+  if (auto* profiler = renderContext.profiler())
+  {
+    profiler->beginStep("(prepare vertices)");
+    prepareRenderables();
+    profiler->endStep();
+  }
+  else
+  {
+    prepareRenderables();
+  }
   renderRenderables(renderContext);
 }
 
@@ -129,10 +143,36 @@ void RenderBatch::prepareRenderables()
 
 void RenderBatch::renderRenderables(RenderContext& renderContext)
 {
-  for (auto* renderable : m_batch)
+  // the renderables must keep their order, but consecutive renderables often use the
+  // same shader program, which then does not have to be bound again
+  auto& shaderManager = renderContext.shaderManager();
+  shaderManager.beginDeferredDeactivation();
+  if (auto* profiler = renderContext.profiler())
+  {
+    for (auto* renderable : m_batch)
+    {
+      profiler->beginStep(renderableType(*renderable));
+      renderable->render(renderContext);
+      profiler->endStep();
+    }
+  }
+  else
+  {
+    for (auto* renderable : m_batch)
+    {
+      renderable->render(renderContext);
+    }
+  }
+  shaderManager.endDeferredDeactivation();
+}
+
+const std::type_info& RenderBatch::renderableType(const Renderable& renderable)
+{
+  if (const auto* wrapper = dynamic_cast<const IndexedRenderableWrapper*>(&renderable))
   {
-    renderable->render(renderContext);
+    return typeid(wrapper->wrappee());
   }
+  return typeid(renderable);
 }
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <typeinfo>
 #include <vector>
 
 namespace TrenchBroom
@@ -72,6 +73,12 @@ private:
   void prepareRenderables();
 
   void renderRenderables(RenderContext& renderContext);
+
+  /**
+   * Returns the type of the given renderable, or of the wrapped renderable if the given
+   * renderable is a wrapper.
+   */
+  static const std::type_info& renderableType(const Renderable& renderable);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
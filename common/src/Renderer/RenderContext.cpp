@@ -35,6 +35,7 @@ RenderContext::RenderContext(
   , m_transformation(m_camera.projectionMatrix(), m_camera.viewMatrix())
   , m_fontManager(fontManager)
   , m_shaderManager(shaderManager)
+  , m_profiler(nullptr)
   , m_showTextures(true)
   , m_showFaces(true)
   , m_showEdges(true)
@@ -85,6 +86,16 @@ ShaderManager& RenderContext::shaderManager()
   return m_shaderManager;
 }
 
+RenderProfiler* RenderContext::profiler()
+{
+  return m_profiler;
+}
+
+void RenderContext::setProfiler(RenderProfiler* profiler)
+{
+  m_profiler = profiler;
+}
+
 bool RenderContext::showTextures() const
 {
   return m_showTextures;
@@ -281,6 +292,16 @@ void RenderContext::setForceHideSelectionGuide()
   setShowSelectionGuide(ShowSelectionGuide::ForceHide);
 }
 
+const std::optional<vm::mat4x4>& RenderContext::selectionTransformation() const
+{
+  return m_selectionTransformation;
+}
+
+void RenderContext::setSelectionTransformation(const vm::mat4x4& selectionTransformation)
+{
+  m_selectionTransformation = selectionTransformation;
+}
+
 void RenderContext::setShowSelectionGuide(const ShowSelectionGuide showSelectionGuide)
 {
   switch (showSelectionGuide)
@@ -23,6 +23,9 @@
 #include "Renderer/Transformation.h"
 
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+
+#include <optional>
 
 namespace TrenchBroom
 {
@@ -30,6 +33,7 @@ namespace Renderer
 {
 class Camera;
 class FontManager;
+class RenderProfiler;
 class ShaderManager;
 
 enum class RenderMode
@@ -55,6 +59,7 @@ private:
   Transformation m_transformation;
   FontManager& m_fontManager;
   ShaderManager& m_shaderManager;
+  RenderProfiler* m_profiler;
 
   // settings for any map rendering view
   bool m_showTextures;
@@ -80,6 +85,7 @@ private:
   bool m_tintSelection;
 
   ShowSelectionGuide m_showSelectionGuide;
+  std::optional<vm::mat4x4> m_selectionTransformation;
   vm::bbox3f m_sofMapBounds;
 
 public:
@@ -97,6 +103,13 @@ public:
   FontManager& fontManager();
   ShaderManager& shaderManager();
 
+  /**
+   * Returns the profiler that measures the rendering time, or null if rendering is not
+   * profiled.
+   */
+  RenderProfiler* profiler();
+  void setProfiler(RenderProfiler* profiler);
+
   bool showTextures() const;
   void setShowTextures(bool showTextures);
 
@@ -154,6 +167,14 @@ public:
   void setForceShowSelectionGuide();
   void setForceHideSelectionGuide();
 
+  /**
+   * Returns the transformation that is applied to the selected objects when they are
+   * rendered, or an empty optional if the selected objects are rendered as they are. This
+   * allows tools to preview a transformation without applying it to the selected objects.
+   */
+  const std::optional<vm::mat4x4>& selectionTransformation() const;
+  void setSelectionTransformation(const vm::mat4x4& selectionTransformation);
+
 private:
   void setShowSelectionGuide(ShowSelectionGuide showSelectionGuide);
 
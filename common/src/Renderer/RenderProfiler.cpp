@@ -0,0 +1,254 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderProfiler.h"
+
+#include <kdl/string_compare.h>
+#include <kdl/string_utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <ostream>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+// if query results take longer than this, the profiler waits for them
+constexpr auto MaxPendingFrames = size_t(4);
+
+double toMilliseconds(const std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+} // namespace
+
+RenderProfiler::RenderProfiler()
+  : m_useTimerQueries{GLEW_VERSION_3_3 || GLEW_ARB_timer_query}
+{
+}
+
+RenderProfiler::~RenderProfiler()
+{
+  auto queries = std::move(m_freeQueries);
+  for (const auto& [index, query] : m_currentFrame)
+  {
+    queries.push_back(query);
+  }
+  for (const auto& frame : m_pendingFrames)
+  {
+    for (const auto& [index, query] : frame)
+    {
+      queries.push_back(query);
+    }
+  }
+
+  if (!queries.empty())
+  {
+    glAssert(glDeleteQueries(GLsizei(queries.size()), queries.data()));
+  }
+}
+
+void RenderProfiler::beginFrame()
+{
+  assert(m_currentFrame.empty());
+  collectQueryResults(m_pendingFrames.size() >= MaxPendingFrames);
+}
+
+void RenderProfiler::endFrame()
+{
+  ++m_frameCount;
+  if (m_useTimerQueries)
+  {
+    m_pendingFrames.push_back(std::move(m_currentFrame));
+    m_currentFrame.clear();
+  }
+}
+
+void RenderProfiler::beginStep(const std::string& name)
+{
+  const auto [it, inserted] = m_totalsByName.try_emplace(name, m_totals.size());
+  if (inserted)
+  {
+    m_totals.push_back(Totals{name});
+  }
+  beginStep(it->second);
+}
+
+void RenderProfiler::beginStep(const std::type_info& type)
+{
+  const auto [it, inserted] = m_totalsByType.try_emplace(type, m_totals.size());
+  if (inserted)
+  {
+    m_totals.push_back(Totals{renderStepName(type)});
+  }
+  beginStep(it->second);
+}
+
+void RenderProfiler::beginStep(const size_t index)
+{
+  m_currentStep = index;
+
+  if (m_useTimerQueries)
+  {
+    auto query = GLuint(0);
+    if (m_freeQueries.empty())
+    {
+      glAssert(glGenQueries(1, &query));
+    }
+    else
+    {
+      query = m_freeQueries.back();
+      m_freeQueries.pop_back();
+    }
+
+    glAssert(glBeginQuery(GL_TIME_ELAPSED, query));
+    m_currentFrame.emplace_back(index, query);
+  }
+
+  m_currentStepStart = Clock::now();
+}
+
+void RenderProfiler::endStep()
+{
+  auto& totals = m_totals[m_currentStep];
+  totals.cpuTime += Clock::now() - m_currentStepStart;
+  ++totals.count;
+
+  if (m_useTimerQueries)
+  {
+    glAssert(glEndQuery(GL_TIME_ELAPSED));
+  }
+}
+
+std::vector<RenderProfiler::Sample> RenderProfiler::takeSamples()
+{
+  auto result = std::vector<Sample>{};
+  for (auto& totals : m_totals)
+  {
+    if (totals.count > 0)
+    {
+      const auto frames = double(std::max(m_frameCount, size_t(1)));
+      const auto gpuFrames = double(std::max(m_gpuFrameCount, size_t(1)));
+      result.push_back(Sample{
+        totals.name,
+        double(totals.count) / frames,
+        toMilliseconds(totals.cpuTime) / frames,
+        double(totals.gpuNanoseconds) / 1000000.0 / gpuFrames});
+    }
+
+    totals.count = 0;
+    totals.cpuTime = Clock::duration{0};
+    totals.gpuNanoseconds = 0;
+  }
+
+  m_frameCount = 0;
+  m_gpuFrameCount = 0;
+
+  std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.cpuTime > rhs.cpuTime;
+  });
+  return result;
+}
+
+void RenderProfiler::collectQueryResults(bool wait)
+{
+  while (!m_pendingFrames.empty())
+  {
+    const auto& frame = m_pendingFrames.front();
+    if (!wait && !frame.empty())
+    {
+      // the queries of a frame finish in order, so checking the last one suffices
+      auto available = GLuint(0);
+      glAssert(
+        glGetQueryObjectuiv(frame.back().second, GL_QUERY_RESULT_AVAILABLE, &available));
+      if (available == 0)
+      {
+        break;
+      }
+    }
+
+    for (const auto& [index, query] : frame)
+    {
+      auto nanoseconds = GLuint64(0);
+      glAssert(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds));
+      m_totals[index].gpuNanoseconds += nanoseconds;
+      m_freeQueries.push_back(query);
+    }
+
+    m_pendingFrames.pop_front();
+    ++m_gpuFrameCount;
+    wait = false;
+  }
+}
+
+std::string renderStepName(const std::type_info& type)
+{
+#if defined(__GNUG__)
+  auto status = 0;
+  auto* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+  auto name = std::string{status == 0 ? demangled : type.name()};
+  std::free(demangled);
+#else
+  // MSVC returns readable names, but prefixes them with the kind of type
+  auto name = std::string{type.name()};
+  for (const auto* prefix : {"class ", "struct "})
+  {
+    if (kdl::cs::str_is_prefix(name, prefix))
+    {
+      name = name.substr(std::string{prefix}.size());
+    }
+  }
+#endif
+
+  for (const auto* ns :
+       {"TrenchBroom::Renderer::", "TrenchBroom::View::", "TrenchBroom::"})
+  {
+    name = kdl::str_replace_every(name, ns, "");
+  }
+  return name;
+}
+
+void writeRenderProfileCsv(
+  std::ostream& str,
+  const double timeStamp,
+  const std::vector<RenderProfiler::Sample>& samples,
+  const bool writeHeader)
+{
+  if (writeHeader)
+  {
+    str << "time,step,count,cpu_ms,gpu_ms\n";
+  }
+
+  for (const auto& sample : samples)
+  {
+    // names of template instances may contain commas
+    str << timeStamp << ",\"" << sample.name << "\"," << sample.count << ","
+        << sample.cpuTime << "," << sample.gpuTime << "\n";
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,131 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+/**
+ * Measures the time spent in each step of rendering a frame, such as preparing the
+ * vertices or rendering a renderable. Steps are grouped by name, and renderables are
+ * named after their type.
+ *
+ * CPU times are measured directly. GPU times are measured with timer queries if they are
+ * supported. Their results are only read once they are available, which is usually a
+ * few frames later, so that profiling does not stall the pipeline.
+ *
+ * Since query objects are not shared between GL contexts, every view needs its own
+ * profiler, and it must be destroyed while its context is current.
+ */
+class RenderProfiler
+{
+public:
+  struct Sample
+  {
+    std::string name;
+    // the average number of steps and the average time in milliseconds per frame
+    double count;
+    double cpuTime;
+    double gpuTime;
+  };
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Totals
+  {
+    std::string name;
+    size_t count{0};
+    Clock::duration cpuTime{0};
+    uint64_t gpuNanoseconds{0};
+  };
+
+  using PendingQuery = std::pair<size_t, GLuint>;
+
+  bool m_useTimerQueries;
+  std::vector<Totals> m_totals;
+  std::unordered_map<std::type_index, size_t> m_totalsByType;
+  std::unordered_map<std::string, size_t> m_totalsByName;
+
+  size_t m_frameCount{0};
+  size_t m_gpuFrameCount{0};
+
+  std::vector<GLuint> m_freeQueries;
+  std::vector<PendingQuery> m_currentFrame;
+  std::deque<std::vector<PendingQuery>> m_pendingFrames;
+
+  size_t m_currentStep{0};
+  Clock::time_point m_currentStepStart;
+
+public:
+  RenderProfiler();
+  ~RenderProfiler();
+
+  RenderProfiler(const RenderProfiler&) = delete;
+  RenderProfiler& operator=(const RenderProfiler&) = delete;
+
+  void beginFrame();
+  void endFrame();
+
+  void beginStep(const std::string& name);
+  void beginStep(const std::type_info& type);
+  void endStep();
+
+  /**
+   * Returns the average count and times of every step per frame since the last call, and
+   * starts over. The samples are sorted by descending CPU time.
+   */
+  std::vector<Sample> takeSamples();
+
+private:
+  void beginStep(size_t index);
+  void collectQueryResults(bool wait);
+};
+
+/**
+ * Returns a readable name for the given type, without the TrenchBroom namespaces.
+ */
+std::string renderStepName(const std::type_info& type);
+
+/**
+ * Writes the given samples as CSV rows with the given time stamp in seconds. If
+ * writeHeader is true, a header row is written first.
+ */
+void writeRenderProfileCsv(
+  std::ostream& str,
+  double timeStamp,
+  const std::vector<RenderProfiler::Sample>& samples,
+  bool writeHeader);
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -21,6 +21,8 @@
 
 #include "Ensure.h"
 #include "Error.h"
+#include "IO/DiskIO.h"
+#include "IO/ShaderProgramCache.h"
 #include "IO/SystemPaths.h"
 #include "Renderer/ShaderConfig.h"
 
@@ -30,18 +32,34 @@
 
 #include <cassert>
 #include <filesystem>
+#include <sstream>
 #include <string>
 
 namespace TrenchBroom::Renderer
 {
 
+ShaderManager::ShaderManager() = default;
+
+ShaderManager::~ShaderManager() = default;
+
+void ShaderManager::setCacheDirectory(const std::filesystem::path& cacheDirectory)
+{
+  m_programCache = !cacheDirectory.empty()
+                     ? std::make_unique<IO::ShaderProgramCache>(cacheDirectory)
+                     : nullptr;
+}
+
 Result<void> ShaderManager::loadProgram(const ShaderConfig& config)
 {
+  const auto startTime = std::chrono::steady_clock::now();
   return createProgram(config).and_then([&](auto program) -> Result<void> {
     if (!m_programs.emplace(config.name(), std::move(program)).second)
     {
       return Error{"Shader program '" + config.name() + "' already loaded"};
     }
+
+    ++m_loadStats.loadedPrograms;
+    m_loadStats.loadTime += std::chrono::steady_clock::now() - startTime;
     return kdl::void_success;
   });
 }
@@ -58,14 +76,110 @@ ShaderProgram* ShaderManager::currentProgram()
   return m_currentProgram;
 }
 
+void ShaderManager::beginDeferredDeactivation()
+{
+  m_deferDeactivation = true;
+}
+
+void ShaderManager::endDeferredDeactivation()
+{
+  m_deferDeactivation = false;
+  if (m_currentProgram == nullptr)
+  {
+    bindProgram(nullptr);
+  }
+}
+
+ShaderManager::Stats ShaderManager::stats() const
+{
+  auto result = Stats{m_programSwitches, m_skippedProgramSwitches, 0, 0};
+  for (const auto& [name, program] : m_programs)
+  {
+    result.uniformUpdates += program.m_uniformUpdates;
+    result.skippedUniformUpdates += program.m_skippedUniformUpdates;
+  }
+  return result;
+}
+
+void ShaderManager::resetStats()
+{
+  m_programSwitches = 0;
+  m_skippedProgramSwitches = 0;
+  for (auto& [name, program] : m_programs)
+  {
+    program.m_uniformUpdates = 0;
+    program.m_skippedUniformUpdates = 0;
+  }
+}
+
+const ShaderManager::LoadStats& ShaderManager::loadStats() const
+{
+  return m_loadStats;
+}
+
 void ShaderManager::setCurrentProgram(ShaderProgram* program)
 {
   m_currentProgram = program;
 }
 
+void ShaderManager::bindProgram(ShaderProgram* program)
+{
+  if (program == m_boundProgram)
+  {
+    ++m_skippedProgramSwitches;
+    return;
+  }
+
+  glAssert(glUseProgram(program != nullptr ? program->m_programId : 0));
+  m_boundProgram = program;
+  ++m_programSwitches;
+}
+
 Result<ShaderProgram> ShaderManager::createProgram(const ShaderConfig& config)
+{
+  const auto cacheKey = programCacheKey(config);
+  if (cacheKey)
+  {
+    if (const auto binary = m_programCache->readProgram(config.name(), *cacheKey))
+    {
+      auto program = createShaderProgram(config.name()).and_then([&](auto p) {
+        return p.loadBinary(*binary).transform([&]() { return std::move(p); });
+      });
+
+      // the driver rejects the binary if it has changed, then the program is compiled
+      if (program.is_success())
+      {
+        ++m_loadStats.cachedPrograms;
+        return program;
+      }
+    }
+  }
+
+  return compileProgram(config, cacheKey.has_value()).transform([&](auto program) {
+    if (cacheKey)
+    {
+      // the cache is optional, so failing to write to it is not an error
+      program.binary()
+        .and_then([&](const auto& binary) {
+          return m_programCache->writeProgram(config.name(), *cacheKey, binary);
+        })
+        .or_else([](auto) { return kdl::void_success; });
+    }
+    return program;
+  });
+}
+
+Result<ShaderProgram> ShaderManager::compileProgram(
+  const ShaderConfig& config, const bool retrievable)
 {
   return createShaderProgram(config.name())
+    .transform([&](auto program) {
+      if (retrievable)
+      {
+        program.setBinaryRetrievable();
+      }
+      return program;
+    })
     .and_then([&](auto program) {
       return kdl::fold_results(
                kdl::vec_transform(
@@ -92,6 +206,44 @@ Result<ShaderProgram> ShaderManager::createProgram(const ShaderConfig& config)
     });
 }
 
+std::optional<std::string> ShaderManager::programCacheKey(
+  const ShaderConfig& config) const
+{
+  if (!m_programCache || !GLEW_ARB_get_program_binary)
+  {
+    return std::nullopt;
+  }
+
+  // program binaries depend on the driver and on the shader sources
+  auto key = std::stringstream{};
+  key << glGetString(GL_VENDOR) << '\n'
+      << glGetString(GL_RENDERER) << '\n'
+      << glGetString(GL_VERSION) << '\n';
+
+  const auto appendSources = [&](const auto& names) {
+    for (const auto& name : names)
+    {
+      const auto path =
+        IO::SystemPaths::findResourceFile(std::filesystem::path{"shader"} / name);
+      const auto result = IO::Disk::withInputStream(path, [&](auto& stream) {
+        key << name << '\n' << stream.rdbuf() << '\n';
+      });
+      if (result.is_error())
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (!appendSources(config.vertexShaders()) || !appendSources(config.fragmentShaders()))
+  {
+    return std::nullopt;
+  }
+
+  return key.str();
+}
+
 Result<std::reference_wrapper<Shader>> ShaderManager::loadShader(
   const std::string& name, const GLenum type)
 {
@@ -24,15 +24,40 @@
 #include "Renderer/ShaderProgram.h"
 #include "Result.h"
 
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
+namespace TrenchBroom::IO
+{
+class ShaderProgramCache;
+}
+
 namespace TrenchBroom::Renderer
 {
 class ShaderConfig;
 
 class ShaderManager
 {
+public:
+  struct Stats
+  {
+    size_t programSwitches{0};
+    size_t skippedProgramSwitches{0};
+    size_t uniformUpdates{0};
+    size_t skippedUniformUpdates{0};
+  };
+
+  struct LoadStats
+  {
+    size_t loadedPrograms{0};
+    size_t cachedPrograms{0};
+    std::chrono::steady_clock::duration loadTime{};
+  };
+
 private:
   friend class ShaderProgram;
   using ShaderCache = std::unordered_map<std::string, Shader>;
@@ -42,14 +67,63 @@ private:
   ShaderProgramCache m_programs;
   ShaderProgram* m_currentProgram{nullptr};
 
+  /**
+   * The program that is bound in GL. Differs from the current program while a program is
+   * kept bound after it was deactivated.
+   */
+  ShaderProgram* m_boundProgram{nullptr};
+  bool m_deferDeactivation{false};
+
+  size_t m_programSwitches{0};
+  size_t m_skippedProgramSwitches{0};
+
+  std::unique_ptr<IO::ShaderProgramCache> m_programCache;
+  LoadStats m_loadStats;
+
 public:
+  ShaderManager();
+  ~ShaderManager();
+
+  /**
+   * Sets the directory where linked programs are cached, so that they need not be
+   * compiled again when they are loaded the next time. Passing an empty path disables
+   * the cache. Programs are only cached if the driver supports
+   * GL_ARB_get_program_binary.
+   */
+  void setCacheDirectory(const std::filesystem::path& cacheDirectory);
+
   Result<void> loadProgram(const ShaderConfig& config);
   ShaderProgram& program(const ShaderConfig& config);
   ShaderProgram* currentProgram();
 
+  /**
+   * While deactivation is deferred, a deactivated program is kept bound so that binding
+   * it again can be skipped if it is the next program to be activated. This is the case
+   * for many renderables that are rendered one after another. Ending the deferral unbinds
+   * the program. Nothing may be drawn without an active program in between.
+   */
+  void beginDeferredDeactivation();
+  void endDeferredDeactivation();
+
+  /**
+   * Returns the number of program switches and uniform updates that were made or skipped
+   * since the last call to resetStats().
+   */
+  Stats stats() const;
+  void resetStats();
+
+  /**
+   * Returns how many programs were loaded, how many of them were loaded from the cache,
+   * and how long loading them took in total.
+   */
+  const LoadStats& loadStats() const;
+
 private:
   void setCurrentProgram(ShaderProgram* program);
+  void bindProgram(ShaderProgram* program);
   Result<ShaderProgram> createProgram(const ShaderConfig& config);
+  Result<ShaderProgram> compileProgram(const ShaderConfig& config, bool retrievable);
+  std::optional<std::string> programCacheKey(const ShaderConfig& config) const;
   Result<std::reference_wrapper<Shader>> loadShader(const std::string& name, GLenum type);
 };
 } // namespace TrenchBroom::Renderer
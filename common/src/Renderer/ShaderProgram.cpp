@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Error.h"
+#include "IO/ShaderProgramCache.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderManager.h"
 
@@ -33,6 +34,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom::Renderer
 {
@@ -109,11 +111,52 @@ Result<void> ShaderProgram::link()
   return kdl::void_success;
 }
 
+void ShaderProgram::setBinaryRetrievable()
+{
+  glAssert(glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+}
+
+Result<IO::ProgramBinary> ShaderProgram::binary() const
+{
+  auto length = GLint(0);
+  glAssert(glGetProgramiv(m_programId, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (length <= 0)
+  {
+    return Error{"Could not get binary of shader program '" + m_name + "'"};
+  }
+
+  auto format = GLenum(0);
+  auto data = std::vector<unsigned char>(size_t(length));
+  glAssert(glGetProgramBinary(m_programId, length, &length, &format, data.data()));
+  data.resize(size_t(length));
+
+  return IO::ProgramBinary{std::uint32_t(format), std::move(data)};
+}
+
+Result<void> ShaderProgram::loadBinary(const IO::ProgramBinary& binary)
+{
+  glAssert(glProgramBinary(
+    m_programId,
+    GLenum(binary.format),
+    binary.data.data(),
+    GLsizei(binary.data.size())));
+
+  auto linkStatus = GLint(0);
+  glAssert(glGetProgramiv(m_programId, GL_LINK_STATUS, &linkStatus));
+
+  if (linkStatus == 0)
+  {
+    return Error{"Could not load binary of shader program '" + m_name + "'"};
+  }
+
+  return kdl::void_success;
+}
+
 void ShaderProgram::activate(ShaderManager& shaderManager)
 {
   assert(m_programId != 0);
 
-  glAssert(glUseProgram(m_programId));
+  shaderManager.bindProgram(this);
   assert(checkActive());
 
   shaderManager.setCurrentProgram(this);
@@ -121,78 +164,160 @@ void ShaderProgram::activate(ShaderManager& shaderManager)
 
 void ShaderProgram::deactivate(ShaderManager& shaderManager)
 {
-  glAssert(glUseProgram(0));
-
   shaderManager.setCurrentProgram(nullptr);
+  if (!shaderManager.m_deferDeactivation)
+  {
+    shaderManager.bindProgram(nullptr);
+  }
 }
 
 void ShaderProgram::set(const std::string& name, const bool value)
 {
-  return set(name, int(value));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const int value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), value));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const size_t value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), int(value)));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const float value)
 {
-  assert(checkActive());
-  glAssert(glUniform1f(findUniformLocation(name), value));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const double value)
 {
-  assert(checkActive());
-  glAssert(glUniform1d(findUniformLocation(name), value));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniform2f(findUniformLocation(name), value.x(), value.y()));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec3f& value)
 {
-  assert(checkActive());
-  glAssert(glUniform3f(findUniformLocation(name), value.x(), value.y(), value.z()));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec4f& value)
 {
-  assert(checkActive());
-  glAssert(
-    glUniform4f(findUniformLocation(name), value.x(), value.y(), value.z(), value.w()));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat2x2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix2fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat3x3f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix3fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  set(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
+{
+  set(findUniformLocation(name), value);
+}
+
+void ShaderProgram::set(const GLint location, const bool value)
+{
+  return set(location, int(value));
+}
+
+void ShaderProgram::set(const GLint location, const int value)
 {
   assert(checkActive());
-  glAssert(glUniformMatrix4fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform1i(location, value));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const size_t value)
+{
+  return set(location, int(value));
+}
+
+void ShaderProgram::set(const GLint location, const float value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform1f(location, value));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const double value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform1d(location, value));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::vec2f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform2f(location, value.x(), value.y()));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::vec3f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform3f(location, value.x(), value.y(), value.z()));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::vec4f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniform4f(location, value.x(), value.y(), value.z(), value.w()));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::mat2x2f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniformMatrix2fv(
+      location, 1, false, reinterpret_cast<const float*>(value.v)));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::mat3x3f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniformMatrix3fv(
+      location, 1, false, reinterpret_cast<const float*>(value.v)));
+  }
+}
+
+void ShaderProgram::set(const GLint location, const vm::mat4x4f& value)
+{
+  assert(checkActive());
+  if (updateUniformValue(location, value))
+  {
+    glAssert(glUniformMatrix4fv(
+      location, 1, false, reinterpret_cast<const float*>(value.v)));
+  }
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
@@ -229,6 +354,23 @@ GLint ShaderProgram::findUniformLocation(const std::string& name) const
   return it->second;
 }
 
+bool ShaderProgram::updateUniformValue(const GLint location, UniformValue value)
+{
+  const auto [it, inserted] = m_uniformValues.try_emplace(location, value);
+  if (!inserted)
+  {
+    if (it->second == value)
+    {
+      ++m_skippedUniformUpdates;
+      return false;
+    }
+    it->second = std::move(value);
+  }
+
+  ++m_uniformUpdates;
+  return true;
+}
+
 bool ShaderProgram::checkActive() const
 {
   auto currentProgramId = GLint(-1);
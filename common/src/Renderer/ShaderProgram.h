@@ -24,9 +24,17 @@
 #include "Result.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
 
 #include <string>
 #include <unordered_map>
+#include <variant>
+
+namespace TrenchBroom::IO
+{
+struct ProgramBinary;
+}
 
 namespace TrenchBroom::Renderer
 {
@@ -39,6 +47,17 @@ class ShaderProgram
 private:
   using UniformVariableCache = std::unordered_map<std::string, GLint>;
   using AttributeLocationCache = std::unordered_map<std::string, GLint>;
+  using UniformValue = std::variant<
+    int,
+    float,
+    double,
+    vm::vec2f,
+    vm::vec3f,
+    vm::vec4f,
+    vm::mat2x2f,
+    vm::mat3x3f,
+    vm::mat4x4f>;
+  using UniformValueCache = std::unordered_map<GLint, UniformValue>;
 
   std::string m_name;
 
@@ -47,6 +66,14 @@ private:
   mutable UniformVariableCache m_variableCache;
   mutable AttributeLocationCache m_attributeCache;
 
+  /**
+   * The values of the uniforms are part of the program object, so setting a uniform to
+   * the value it already has can be skipped.
+   */
+  UniformValueCache m_uniformValues;
+  size_t m_uniformUpdates{0};
+  size_t m_skippedUniformUpdates{0};
+
 public:
   ShaderProgram(std::string name, GLuint programId);
 
@@ -60,6 +87,23 @@ public:
   void attach(Shader& shader) const;
   Result<void> link();
 
+  /**
+   * Allows retrieving the binary of this program once it is linked. Must be called
+   * before linking. This and the following functions require GL_ARB_get_program_binary.
+   */
+  void setBinaryRetrievable();
+
+  /**
+   * Returns the binary of this linked program.
+   */
+  Result<IO::ProgramBinary> binary() const;
+
+  /**
+   * Loads a binary that was returned by binary() instead of linking shaders. Fails if the
+   * driver does not accept the binary, e.g. because it was updated since.
+   */
+  Result<void> loadBinary(const IO::ProgramBinary& binary);
+
   void activate(ShaderManager& shaderManager);
   void deactivate(ShaderManager& shaderManager);
 
@@ -75,10 +119,34 @@ public:
   void set(const std::string& name, const vm::mat3x3f& value);
   void set(const std::string& name, const vm::mat4x4f& value);
 
+  /**
+   * Returns the location of the uniform with the given name. Uniforms that are set many
+   * times per frame, e.g. once per texture, can be set by location to skip the lookup.
+   */
+  GLint findUniformLocation(const std::string& name) const;
+
+  void set(GLint location, bool value);
+  void set(GLint location, int value);
+  void set(GLint location, size_t value);
+  void set(GLint location, float value);
+  void set(GLint location, double value);
+  void set(GLint location, const vm::vec2f& value);
+  void set(GLint location, const vm::vec3f& value);
+  void set(GLint location, const vm::vec4f& value);
+  void set(GLint location, const vm::mat2x2f& value);
+  void set(GLint location, const vm::mat3x3f& value);
+  void set(GLint location, const vm::mat4x4f& value);
+
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
-  GLint findUniformLocation(const std::string& name) const;
+  friend class ShaderManager;
+
+  /**
+   * Records the given value for the uniform at the given location. Returns false if the
+   * uniform already has that value.
+   */
+  bool updateUniformValue(GLint location, UniformValue value);
   bool checkActive() const;
 };
 
@@ -46,18 +46,15 @@ const size_t TextRenderer::RectCornerSegments = 3;
 const float TextRenderer::RectCornerRadius = 3.0f;
 
 TextRenderer::Entry::Entry(
-  std::vector<vm::vec2f>& i_vertices,
-  const vm::vec2f& i_size,
+  std::shared_ptr<const TextLayout> i_layout,
   const vm::vec3f& i_offset,
   const Color& i_textColor,
   const Color& i_backgroundColor)
-  : size(i_size)
+  : layout(std::move(i_layout))
   , offset(i_offset)
   , textColor(i_textColor)
   , backgroundColor(i_backgroundColor)
 {
-  using std::swap;
-  swap(vertices, i_vertices);
 }
 
 TextRenderer::EntryCollection::EntryCollection()
@@ -112,40 +109,29 @@ void TextRenderer::renderString(
   if (distance <= 0.0f)
     return;
 
-  if (!isVisible(renderContext, string, position, distance, onTop))
-    return;
-
   FontManager& fontManager = renderContext.fontManager();
   TextureFont& font = fontManager.font(m_fontDescriptor);
 
-  std::vector<vm::vec2f> vertices = font.quads(string, true);
-  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-  const vm::vec2f size = font.measure(string);
-  const vm::vec3f offset = position.offset(camera, size);
+  // the layout is cached by the font, so unchanged strings are not laid out again
+  auto layout = font.layout(string);
+  if (!isVisible(renderContext, round(layout->size), position, distance, onTop))
+    return;
 
-  if (onTop)
-    addEntry(
-      m_entriesOnTop,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
-  else
-    addEntry(
-      m_entries,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
+  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+  const vm::vec3f offset = position.offset(camera, layout->size);
+
+  addEntry(
+    onTop ? m_entriesOnTop : m_entries,
+    Entry(
+      std::move(layout),
+      offset,
+      Color(textColor, alphaFactor * textColor.a()),
+      Color(backgroundColor, alphaFactor * backgroundColor.a())));
 }
 
 bool TextRenderer::isVisible(
   RenderContext& renderContext,
-  const AttrString& string,
+  const vm::vec2f& size,
   const TextAnchor& position,
   const float distance,
   const bool onTop) const
@@ -161,7 +147,6 @@ bool TextRenderer::isVisible(
   const Camera& camera = renderContext.camera();
   const Camera::Viewport& viewport = camera.viewport();
 
-  const vm::vec2f size = stringSize(renderContext, string);
   const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
   const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -191,19 +176,11 @@ float TextRenderer::computeAlphaFactor(
   }
 }
 
-void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry)
+void TextRenderer::addEntry(EntryCollection& collection, Entry entry)
 {
-  collection.entries.push_back(entry);
-  collection.textVertexCount += entry.vertices.size();
+  collection.textVertexCount += entry.layout->vertices.size() / 2;
   collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
-}
-
-vm::vec2f TextRenderer::stringSize(
-  RenderContext& renderContext, const AttrString& string) const
-{
-  FontManager& fontManager = renderContext.fontManager();
-  TextureFont& font = fontManager.font(m_fontDescriptor);
-  return round(font.measure(string));
+  collection.entries.push_back(std::move(entry));
 }
 
 void TextRenderer::doPrepareVertices(VboManager& vboManager)
@@ -239,8 +216,8 @@ void TextRenderer::addEntry(
   std::vector<TextVertex>& textVertices,
   std::vector<RectVertex>& rectVertices)
 {
-  const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-  const vm::vec2f& stringSize = entry.size;
+  const std::vector<vm::vec2f>& stringVertices = entry.layout->vertices;
+  const vm::vec2f& stringSize = entry.layout->size;
 
   const vm::vec3f& offset = entry.offset;
 
@@ -28,6 +28,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom
@@ -37,6 +38,7 @@ namespace Renderer
 class AttrString;
 class RenderContext;
 class TextAnchor;
+struct TextLayout;
 
 class TextRenderer : public DirectRenderable
 {
@@ -49,15 +51,13 @@ private:
 
   struct Entry
   {
-    std::vector<vm::vec2f> vertices;
-    vm::vec2f size;
+    std::shared_ptr<const TextLayout> layout;
     vm::vec3f offset;
     Color textColor;
     Color backgroundColor;
 
     Entry(
-      std::vector<vm::vec2f>& i_vertices,
-      const vm::vec2f& i_size,
+      std::shared_ptr<const TextLayout> i_layout,
       const vm::vec3f& i_offset,
       const Color& i_textColor,
       const Color& i_backgroundColor);
@@ -119,15 +119,13 @@ private:
 
   bool isVisible(
     RenderContext& renderContext,
-    const AttrString& string,
+    const vm::vec2f& stringSize,
     const TextAnchor& position,
     float distance,
     bool onTop) const;
   float computeAlphaFactor(
     const RenderContext& renderContext, float distance, bool onTop) const;
-  void addEntry(EntryCollection& collection, const Entry& entry);
-
-  vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+  void addEntry(EntryCollection& collection, Entry entry);
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
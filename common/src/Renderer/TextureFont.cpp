@@ -34,6 +34,12 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+// labels such as sizes and angles change continuously, so the cache must be bounded
+constexpr auto MaxCachedLayouts = size_t(4096);
+} // namespace
+
 TextureFont::TextureFont(
   std::unique_ptr<FontTexture> texture,
   const std::vector<FontGlyph>& glyphs,
@@ -186,6 +192,24 @@ vm::vec2f TextureFont::measure(const AttrString& string) const
   return measureString.size();
 }
 
+std::shared_ptr<const TextLayout> TextureFont::layout(const AttrString& string) const
+{
+  if (const auto it = m_layoutCache.find(string); it != m_layoutCache.end())
+  {
+    return it->second;
+  }
+
+  if (m_layoutCache.size() >= MaxCachedLayouts)
+  {
+    m_layoutCache.clear();
+  }
+
+  auto layout =
+    std::make_shared<const TextLayout>(TextLayout{quads(string, true), measure(string)});
+  m_layoutCache.emplace(string, layout);
+  return layout;
+}
+
 std::vector<vm::vec2f> TextureFont::quads(
   const std::string& string, const bool clockwise, const vm::vec2f& offset) const
 {
@@ -20,10 +20,12 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,10 +34,18 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-class AttrString;
 class FontGlyph;
 class FontTexture;
 
+/**
+ * The clockwise glyph quads and the size of a string.
+ */
+struct TextLayout
+{
+  std::vector<vm::vec2f> vertices;
+  vm::vec2f size;
+};
+
 class TextureFont
 {
 private:
@@ -46,6 +56,8 @@ private:
   unsigned char m_firstChar;
   unsigned char m_charCount;
 
+  mutable std::map<AttrString, std::shared_ptr<const TextLayout>> m_layoutCache;
+
 public:
   TextureFont(
     std::unique_ptr<FontTexture> texture,
@@ -63,6 +75,13 @@ public:
     const vm::vec2f& offset = vm::vec2f::zero()) const;
   vm::vec2f measure(const AttrString& string) const;
 
+  /**
+   * Returns the clockwise quads and the size of the given string. Layouts are cached, so
+   * laying out a string that was laid out before does not measure it or create its quads
+   * again.
+   */
+  std::shared_ptr<const TextLayout> layout(const AttrString& string) const;
+
   std::vector<vm::vec2f> quads(
     const std::string& string,
     bool clockwise,
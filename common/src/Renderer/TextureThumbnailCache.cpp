@@ -0,0 +1,240 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnailCache.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+
+#include <algorithm>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+constexpr auto MaxThumbnailsPerBatch = size_t(32);
+constexpr auto ReleaseInterval = std::chrono::seconds{5};
+constexpr auto UnusedThumbnailLifetime = std::chrono::seconds{30};
+
+void uploadThumbnail(const GLuint textureId, const Assets::TextureThumbnail& thumbnail)
+{
+  glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+  glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+  const auto* data = reinterpret_cast<const GLvoid*>(thumbnail.buffer.data());
+  if (Assets::isCompressedFormat(thumbnail.format))
+  {
+    glAssert(glCompressedTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      thumbnail.format,
+      static_cast<GLsizei>(thumbnail.width),
+      static_cast<GLsizei>(thumbnail.height),
+      0,
+      static_cast<GLsizei>(thumbnail.buffer.size()),
+      data));
+  }
+  else
+  {
+    glAssert(glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      GL_RGBA,
+      static_cast<GLsizei>(thumbnail.width),
+      static_cast<GLsizei>(thumbnail.height),
+      0,
+      thumbnail.format,
+      GL_UNSIGNED_BYTE,
+      data));
+  }
+
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+} // namespace
+
+TextureThumbnailCache::TextureThumbnailCache(const size_t thumbnailSize)
+  : m_thumbnailSize{thumbnailSize}
+{
+}
+
+TextureThumbnailCache::~TextureThumbnailCache()
+{
+  clear();
+  deleteTextures();
+}
+
+void TextureThumbnailCache::setThumbnailSize(const size_t thumbnailSize)
+{
+  if (thumbnailSize != m_thumbnailSize)
+  {
+    clear();
+    m_thumbnailSize = thumbnailSize;
+  }
+}
+
+bool TextureThumbnailCache::activate(const Assets::Texture& texture)
+{
+  const auto [it, inserted] = m_thumbnails.try_emplace(&texture);
+  auto& thumbnail = it->second;
+  thumbnail.lastActivated = std::chrono::steady_clock::now();
+
+  if (thumbnail.textureId != 0)
+  {
+    glAssert(glBindTexture(GL_TEXTURE_2D, thumbnail.textureId));
+    return true;
+  }
+
+  if (inserted && !texture.buffersIfUnprepared().empty())
+  {
+    m_requested.push_back(&texture);
+  }
+  return false;
+}
+
+void TextureThumbnailCache::deactivate()
+{
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+void TextureThumbnailCache::commitChanges()
+{
+  deleteTextures();
+  uploadFinishedThumbnails();
+  startCreatingThumbnails();
+  releaseUnusedThumbnails();
+}
+
+bool TextureThumbnailCache::hasPendingChanges() const
+{
+  return !m_requested.empty() || m_pendingThumbnails;
+}
+
+void TextureThumbnailCache::clear()
+{
+  for (const auto& [texture, thumbnail] : m_thumbnails)
+  {
+    if (thumbnail.textureId != 0)
+    {
+      m_toDelete.push_back(thumbnail.textureId);
+    }
+  }
+
+  m_thumbnails.clear();
+  m_requested.clear();
+  m_pendingThumbnails = std::nullopt;
+}
+
+void TextureThumbnailCache::startCreatingThumbnails()
+{
+  if (m_pendingThumbnails || m_requested.empty())
+  {
+    return;
+  }
+
+  // only the selected mipmap level is copied here, downsampling it further happens on a
+  // background thread
+  const auto count = std::min(MaxThumbnailsPerBatch, m_requested.size());
+  auto images = PendingThumbnails{};
+  images.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto* texture = m_requested[i];
+    images.emplace_back(
+      texture, Assets::copyThumbnailMipLevel(*texture, m_thumbnailSize));
+  }
+  m_requested.erase(m_requested.begin(), std::next(m_requested.begin(), long(count)));
+
+  m_pendingThumbnails = std::async(
+    std::launch::async,
+    [images = std::move(images), thumbnailSize = m_thumbnailSize]() mutable {
+      for (auto& [texture, image] : images)
+      {
+        image = Assets::makeTextureThumbnail(std::move(image), thumbnailSize);
+      }
+      return std::move(images);
+    });
+}
+
+void TextureThumbnailCache::uploadFinishedThumbnails()
+{
+  using namespace std::chrono_literals;
+
+  if (
+    !m_pendingThumbnails
+    || m_pendingThumbnails->wait_for(0s) != std::future_status::ready)
+  {
+    return;
+  }
+
+  const auto thumbnails = m_pendingThumbnails->get();
+  m_pendingThumbnails = std::nullopt;
+
+  for (const auto& [texture, image] : thumbnails)
+  {
+    if (auto it = m_thumbnails.find(texture); it != m_thumbnails.end())
+    {
+      auto& thumbnail = it->second;
+      glAssert(glGenTextures(1, &thumbnail.textureId));
+      uploadThumbnail(thumbnail.textureId, image);
+    }
+  }
+}
+
+void TextureThumbnailCache::releaseUnusedThumbnails()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastRelease < ReleaseInterval)
+  {
+    return;
+  }
+  m_lastRelease = now;
+
+  for (auto it = m_thumbnails.begin(); it != m_thumbnails.end();)
+  {
+    const auto& thumbnail = it->second;
+    if (
+      thumbnail.textureId != 0
+      && thumbnail.lastActivated < now - UnusedThumbnailLifetime)
+    {
+      m_toDelete.push_back(thumbnail.textureId);
+      it = m_thumbnails.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void TextureThumbnailCache::deleteTextures()
+{
+  if (!m_toDelete.empty())
+  {
+    glAssert(glDeleteTextures(GLsizei(m_toDelete.size()), m_toDelete.data()));
+    m_toDelete.clear();
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
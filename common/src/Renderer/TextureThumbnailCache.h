@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/TextureThumbnail.h"
+#include "Renderer/GL.h"
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Assets
+{
+class Texture;
+}
+
+namespace Renderer
+{
+/**
+ * Keeps small GL textures that browsers render instead of the full size textures.
+ *
+ * Thumbnails are created from the smallest suitable mipmap level of a texture when the
+ * texture is first activated. The mipmap level is copied on the calling thread, but it is
+ * downsampled further on a background thread. Finished thumbnails are uploaded by
+ * commitChanges(), and thumbnails that have not been activated for a while are released.
+ *
+ * Since textures are identified by their addresses, the cache must be cleared whenever
+ * the textures it was used with are destroyed.
+ */
+class TextureThumbnailCache
+{
+private:
+  using PendingThumbnails =
+    std::vector<std::pair<const Assets::Texture*, Assets::TextureThumbnail>>;
+
+  struct Thumbnail
+  {
+    GLuint textureId = 0;
+    std::chrono::steady_clock::time_point lastActivated;
+  };
+
+  size_t m_thumbnailSize;
+  std::unordered_map<const Assets::Texture*, Thumbnail> m_thumbnails;
+  std::vector<const Assets::Texture*> m_requested;
+  std::optional<std::future<PendingThumbnails>> m_pendingThumbnails;
+  std::vector<GLuint> m_toDelete;
+  std::chrono::steady_clock::time_point m_lastRelease;
+
+public:
+  explicit TextureThumbnailCache(size_t thumbnailSize);
+  ~TextureThumbnailCache();
+
+  TextureThumbnailCache(const TextureThumbnailCache&) = delete;
+  TextureThumbnailCache& operator=(const TextureThumbnailCache&) = delete;
+
+  /**
+   * Sets the size that the larger dimension of the thumbnails should have at least. If
+   * the size changes, the cache is cleared.
+   */
+  void setThumbnailSize(size_t thumbnailSize);
+
+  /**
+   * Binds the thumbnail of the given texture. If the thumbnail has not been uploaded yet,
+   * it is requested, nothing is bound and false is returned.
+   */
+  bool activate(const Assets::Texture& texture);
+  void deactivate();
+
+  /**
+   * Starts creating the requested thumbnails, uploads the finished ones and releases
+   * thumbnails that have not been activated for a while. Must be called while the GL
+   * context is current.
+   *
+   * @see hasPendingChanges()
+   */
+  void commitChanges();
+
+  /**
+   * Indicates whether there are requested thumbnails that have not been uploaded yet.
+   */
+  bool hasPendingChanges() const;
+
+  /**
+   * Forgets all thumbnails. Their GL textures are deleted by the next call to
+   * commitChanges().
+   */
+  void clear();
+
+private:
+  void startCreatingThumbnails();
+  void uploadFinishedThumbnails();
+  void releaseUnusedThumbnails();
+  void deleteTextures();
+};
+} // namespace Renderer
+} // namespace TrenchBroom
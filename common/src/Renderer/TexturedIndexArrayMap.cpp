@@ -102,5 +102,17 @@ void TexturedIndexArrayMap::render(IndexArray& indexArray, TextureRenderFunc& fu
     func.after(texture);
   }
 }
+
+void TexturedIndexArrayMap::renderInstanced(
+  IndexArray& indexArray, const size_t instanceCount)
+{
+  auto func = DefaultTextureRenderFunc{};
+  for (const auto& [texture, indexRange] : m_ranges)
+  {
+    func.before(texture);
+    indexRange.renderInstanced(indexArray, instanceCount);
+    func.after(texture);
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -155,6 +155,16 @@ public:
    * @param func the texture callbacks
    */
   void render(IndexArray& indexArray, TextureRenderFunc& func);
+
+  /**
+   * Renders the given number of instances of the recorded primitives using the indices
+   * stored in the given index array. The primitives are batched by their associated
+   * textures.
+   *
+   * @param indexArray the index array to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(IndexArray& indexArray, size_t instanceCount);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
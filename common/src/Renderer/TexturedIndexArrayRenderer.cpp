@@ -69,5 +69,18 @@ void TexturedIndexArrayRenderer::render(TextureRenderFunc& func)
     m_vertexArray.cleanup();
   }
 }
+
+void TexturedIndexArrayRenderer::renderInstanced(const size_t instanceCount)
+{
+  if (m_vertexArray.setup())
+  {
+    if (m_indexArray.setup())
+    {
+      m_indexRanges.renderInstanced(m_indexArray, instanceCount);
+      m_indexArray.cleanup();
+    }
+    m_vertexArray.cleanup();
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -21,14 +21,51 @@
 
 #include "Renderer/RenderUtils.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+/**
+ * Returns the position of the entry for the given texture in the given vector, which is
+ * sorted by texture, or the position where such an entry must be inserted.
+ */
+template <typename T>
+auto lowerBound(
+  std::vector<std::pair<const Assets::Texture*, T>>& entries,
+  const Assets::Texture* texture)
+{
+  const auto cmp = std::less<const Assets::Texture*>{};
+  return std::lower_bound(
+    entries.begin(), entries.end(), texture, [&](const auto& entry, const auto* key) {
+      return cmp(entry.first, key);
+    });
+}
+
+/**
+ * Returns the index of the entry for the given texture in the given vector, which is
+ * sorted by texture. If there is no such entry, a default constructed one is inserted.
+ */
+template <typename T>
+size_t findOrInsert(
+  std::vector<std::pair<const Assets::Texture*, T>>& entries,
+  const Assets::Texture* texture)
+{
+  auto it = lowerBound(entries, texture);
+  if (it == entries.end() || it->first != texture)
+  {
+    it = entries.emplace(it, texture, T{});
+  }
+  return size_t(std::distance(entries.begin(), it));
+}
+} // namespace
+
 TexturedIndexRangeMap::Size::Size()
-  : m_current(std::end(m_sizes))
+  : m_current(0)
 {
 }
 
@@ -52,41 +89,35 @@ IndexRangeMap::Size& TexturedIndexRangeMap::Size::findCurrent(const Texture* tex
 {
   if (!isCurrent(texture))
   {
-    const auto result = m_sizes.try_emplace(texture);
-    m_current = result.first;
+    m_current = findOrInsert(m_sizes, texture);
   }
-  return m_current->second;
+  return m_sizes[m_current].second;
 }
 
 bool TexturedIndexRangeMap::Size::isCurrent(const Texture* texture) const
 {
-  if (m_current == std::end(m_sizes))
-  {
-    return false;
-  }
-
-  const auto& cmp = m_sizes.key_comp();
-  const auto* currentTexture = m_current->first;
-  return !cmp(texture, currentTexture) && !cmp(currentTexture, texture);
+  return m_current < m_sizes.size() && m_sizes[m_current].first == texture;
 }
 
 void TexturedIndexRangeMap::Size::initialize(TextureToIndexRangeMap& data) const
 {
+  // the sizes are sorted by texture already
+  data.reserve(m_sizes.size());
   for (const auto& [texture, size] : m_sizes)
   {
-    data.insert(std::make_pair(texture, IndexRangeMap(size)));
+    data.emplace_back(texture, IndexRangeMap(size));
   }
 }
 
 TexturedIndexRangeMap::TexturedIndexRangeMap()
   : m_data(new TextureToIndexRangeMap())
-  , m_current(m_data->end())
+  , m_current(0)
 {
 }
 
 TexturedIndexRangeMap::TexturedIndexRangeMap(const Size& size)
   : m_data(new TextureToIndexRangeMap())
-  , m_current(m_data->end())
+  , m_current(0)
 {
   size.initialize(*m_data);
 }
@@ -94,7 +125,7 @@ TexturedIndexRangeMap::TexturedIndexRangeMap(const Size& size)
 TexturedIndexRangeMap::TexturedIndexRangeMap(
   const Texture* texture, IndexRangeMap primitives)
   : m_data(new TextureToIndexRangeMap())
-  , m_current(m_data->end())
+  , m_current(0)
 {
   add(texture, std::move(primitives));
 }
@@ -105,9 +136,9 @@ TexturedIndexRangeMap::TexturedIndexRangeMap(
   const size_t index,
   const size_t vertexCount)
   : m_data(new TextureToIndexRangeMap())
-  , m_current(m_data->end())
+  , m_current(0)
 {
-  m_data->insert(std::make_pair(texture, IndexRangeMap(primType, index, vertexCount)));
+  m_data->emplace_back(texture, IndexRangeMap(primType, index, vertexCount));
 }
 
 void TexturedIndexRangeMap::add(
@@ -122,7 +153,11 @@ void TexturedIndexRangeMap::add(
 
 void TexturedIndexRangeMap::add(const Texture* texture, IndexRangeMap primitives)
 {
-  m_data->insert(std::make_pair(texture, std::move(primitives)));
+  const auto it = lowerBound(*m_data, texture);
+  if (it == m_data->end() || it->first != texture)
+  {
+    m_data->emplace(it, texture, std::move(primitives));
+  }
 }
 
 void TexturedIndexRangeMap::add(const TexturedIndexRangeMap& other)
@@ -150,6 +185,18 @@ void TexturedIndexRangeMap::render(VertexArray& vertexArray, TextureRenderFunc&
   }
 }
 
+void TexturedIndexRangeMap::renderInstanced(
+  VertexArray& vertexArray, const size_t instanceCount)
+{
+  DefaultTextureRenderFunc func;
+  for (const auto& [texture, indexArray] : *m_data)
+  {
+    func.before(texture);
+    indexArray.renderInstanced(vertexArray, instanceCount);
+    func.after(texture);
+  }
+}
+
 void TexturedIndexRangeMap::forEachPrimitive(
   std::function<void(const Texture*, PrimType, size_t, size_t)> func) const
 {
@@ -169,22 +216,14 @@ IndexRangeMap& TexturedIndexRangeMap::findCurrent(const Texture* texture)
 {
   if (!isCurrent(texture))
   {
-    m_current = m_data->find(texture);
+    m_current = findOrInsert(*m_data, texture);
   }
-  assert(m_current != m_data->end());
-  return m_current->second;
+  return (*m_data)[m_current].second;
 }
 
 bool TexturedIndexRangeMap::isCurrent(const Texture* texture) const
 {
-  if (m_current == m_data->end())
-  {
-    return false;
-  }
-
-  const auto& cmp = m_data->key_comp();
-  const auto* currentTexture = m_current->first;
-  return !cmp(texture, currentTexture) && !cmp(currentTexture, texture);
+  return m_current < m_data->size() && (*m_data)[m_current].first == texture;
 }
 } // namespace Renderer
 } // namespace TrenchBroom
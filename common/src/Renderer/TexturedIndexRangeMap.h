@@ -21,7 +21,10 @@
 
 #include "Renderer/IndexRangeMap.h"
 
-#include <map>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -42,7 +45,8 @@ class VertexArray;
  * is rendered using the vertices in the array at the range recorded here.
  *
  * The primitives are grouped per texture to avoid costly texture switches during
- * rendering.
+ * rendering. The groups are stored in a flat vector that is sorted by texture, so a map
+ * initialized from a size allocates its groups at once.
  */
 class TexturedIndexRangeMap
 {
@@ -50,7 +54,7 @@ public:
   using Texture = Assets::Texture;
 
 private:
-  using TextureToIndexRangeMap = std::map<const Texture*, IndexRangeMap>;
+  using TextureToIndexRangeMap = std::vector<std::pair<const Texture*, IndexRangeMap>>;
   using TextureToIndexRangeMapPtr = std::shared_ptr<TextureToIndexRangeMap>;
 
 public:
@@ -67,9 +71,9 @@ public:
   private:
     friend class TexturedIndexRangeMap;
 
-    using TextureToSize = std::map<const Texture*, IndexRangeMap::Size>;
+    using TextureToSize = std::vector<std::pair<const Texture*, IndexRangeMap::Size>>;
     TextureToSize m_sizes;
-    TextureToSize::iterator m_current;
+    size_t m_current;
 
   public:
     /**
@@ -102,7 +106,7 @@ public:
 
 private:
   TextureToIndexRangeMapPtr m_data;
-  TextureToIndexRangeMap::iterator m_current;
+  size_t m_current;
 
 public:
   /**
@@ -184,6 +188,16 @@ public:
    */
   void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+  /**
+   * Renders the given number of instances of the primitives stored in this index range
+   * map using the vertices in the given vertex array. The primitives are batched by their
+   * associated textures.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(VertexArray& vertexArray, size_t instanceCount);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
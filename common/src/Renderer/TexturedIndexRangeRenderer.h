@@ -47,6 +47,12 @@ public:
   virtual void prepare(VboManager& vboManager) = 0;
   virtual void render() = 0;
   virtual void render(TextureRenderFunc& func) = 0;
+
+  /**
+   * Renders the given number of instances. The caller must set up the per instance
+   * attributes.
+   */
+  virtual void renderInstanced(size_t instanceCount) = 0;
 };
 
 class TexturedIndexRangeRenderer : public TexturedRenderer
@@ -70,16 +76,17 @@ public:
   void prepare(VboManager& vboManager) override;
   void render() override;
   void render(TextureRenderFunc& func) override;
+  void renderInstanced(size_t instanceCount) override;
 };
 
 class MultiTexturedIndexRangeRenderer : public TexturedRenderer
 {
 private:
-  std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> m_renderers;
+  std::vector<std::unique_ptr<TexturedRenderer>> m_renderers;
 
 public:
   MultiTexturedIndexRangeRenderer(
-    std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> renderers);
+    std::vector<std::unique_ptr<TexturedRenderer>> renderers);
   ~MultiTexturedIndexRangeRenderer() override;
 
   bool empty() const override;
@@ -87,6 +94,7 @@ public:
   void prepare(VboManager& vboManager) override;
   void render() override;
   void render(TextureRenderFunc& func) override;
+  void renderInstanced(size_t instanceCount) override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -25,6 +25,8 @@
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
 
+#include <utility>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -73,6 +75,11 @@ void TriangleRenderer::setTintColor(const Color& tintColor)
   m_tintColor = tintColor;
 }
 
+void TriangleRenderer::setIndexRanges(IndexRangeMap indexArray)
+{
+  m_indexArray = std::move(indexArray);
+}
+
 void TriangleRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_vertexArray.prepare(vboManager);
@@ -54,6 +54,12 @@ public:
   void setApplyTinting(bool applyTinting);
   void setTintColor(const Color& tintColor);
 
+  /**
+   * Replaces the ranges of the vertex array that are rendered, e.g. to skip some of the
+   * primitives without uploading the vertices again.
+   */
+  void setIndexRanges(IndexRangeMap indexArray);
+
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& context) override;
@@ -30,21 +30,81 @@ namespace Renderer
 Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage)
   : m_type(type)
   , m_capacity(capacity)
+  , m_regionCount(1)
+  , m_currentRegion(0)
+  , m_mappedPtr(nullptr)
 {
-  assert(m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER);
+  assert(
+    m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER
+    || m_type == GL_DRAW_INDIRECT_BUFFER);
 
   glAssert(glGenBuffers(1, &m_bufferId));
   glAssert(glBindBuffer(m_type, m_bufferId));
   glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
 }
 
+Vbo::Vbo(GLenum type, const size_t capacity, const size_t regionCount)
+  : m_type(type)
+  , m_capacity(capacity)
+  , m_regionCount(regionCount)
+  , m_currentRegion(0)
+  , m_mappedPtr(nullptr)
+  , m_fences(regionCount, nullptr)
+{
+  assert(
+    m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER
+    || m_type == GL_DRAW_INDIRECT_BUFFER);
+  assert(m_regionCount > 0);
+
+  const auto size = static_cast<GLsizeiptr>(m_capacity * m_regionCount);
+  const auto flags =
+    GLbitfield(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+  glAssert(glGenBuffers(1, &m_bufferId));
+  glAssert(glBindBuffer(m_type, m_bufferId));
+  glAssert(glBufferStorage(m_type, size, nullptr, flags));
+  glAssert(m_mappedPtr = glMapBufferRange(m_type, 0, size, flags));
+  ensure(m_mappedPtr != nullptr, "persistent buffer is mapped");
+}
+
 void Vbo::free()
 {
   assert(m_bufferId != 0);
+  for (auto& fence : m_fences)
+  {
+    if (fence != nullptr)
+    {
+      glAssert(glDeleteSync(fence));
+      fence = nullptr;
+    }
+  }
+  if (m_mappedPtr != nullptr)
+  {
+    glAssert(glBindBuffer(m_type, m_bufferId));
+    glAssert(glUnmapBuffer(m_type));
+    m_mappedPtr = nullptr;
+  }
   glAssert(glDeleteBuffers(1, &m_bufferId));
   m_bufferId = 0;
 }
 
+void Vbo::waitForFence(const size_t region)
+{
+  auto& fence = m_fences[region];
+  if (fence != nullptr)
+  {
+    static constexpr auto Timeout = GLuint64(1000000000); // 1s in nanoseconds
+
+    auto status = GLenum(GL_TIMEOUT_EXPIRED);
+    while (status == GL_TIMEOUT_EXPIRED)
+    {
+      glAssert(status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, Timeout));
+    }
+    glAssert(glDeleteSync(fence));
+    fence = nullptr;
+  }
+}
+
 Vbo::~Vbo()
 {
   assert(m_bufferId == 0);
@@ -52,7 +112,7 @@ Vbo::~Vbo()
 
 size_t Vbo::offset() const
 {
-  return 0;
+  return m_currentRegion * m_capacity;
 }
 
 size_t Vbo::capacity() const
@@ -60,6 +120,34 @@ size_t Vbo::capacity() const
   return m_capacity;
 }
 
+bool Vbo::persistent() const
+{
+  return m_mappedPtr != nullptr;
+}
+
+size_t Vbo::regionCount() const
+{
+  return m_regionCount;
+}
+
+size_t Vbo::currentRegion() const
+{
+  return m_currentRegion;
+}
+
+void Vbo::advanceRegion()
+{
+  if (persistent())
+  {
+    assert(m_fences[m_currentRegion] == nullptr);
+    glAssert(
+      m_fences[m_currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    m_currentRegion = (m_currentRegion + 1) % m_regionCount;
+    waitForFence(m_currentRegion);
+  }
+}
+
 void Vbo::bind()
 {
   assert(m_bufferId != 0);
@@ -22,6 +22,7 @@
 #include "Renderer/VboManager.h"
 
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 #include <vector>
 
@@ -31,6 +32,12 @@ namespace Renderer
 {
 /**
  * Wrapper around an OpenGL buffer
+ *
+ * A persistent buffer consists of a ring of regions of the given capacity each, and it
+ * stays mapped for its entire lifetime. Only the current region is written to and
+ * rendered from. Advancing to the next region fences the current region and waits until
+ * the GPU has finished reading the next region, so that writing to it never stalls the
+ * pipeline.
  */
 class Vbo
 {
@@ -38,17 +45,29 @@ private:
   friend class VboManager;
 
   /**
-   * e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+   * e.g. GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER or GL_DRAW_INDIRECT_BUFFER
    */
   GLenum m_type;
   size_t m_capacity;
   GLuint m_bufferId;
 
+  size_t m_regionCount;
+  size_t m_currentRegion;
+  GLvoid* m_mappedPtr;
+  std::vector<GLsync> m_fences;
+
   /**
    * Immediately creates and binds to a buffer of the given type and capacity.
    * The contents are initially unspecified.
    */
   Vbo(GLenum type, size_t capacity, GLenum usage);
+
+  /**
+   * Immediately creates, binds to and persistently maps a buffer of the given type with
+   * the given number of regions of the given capacity each. Requires OpenGL 4.4 or
+   * ARB_buffer_storage. The contents are initially unspecified.
+   */
+  Vbo(GLenum type, size_t capacity, size_t regionCount);
   ~Vbo();
 
   /**
@@ -58,13 +77,30 @@ private:
    */
   void free();
 
+  void waitForFence(size_t region);
+
 public:
   /**
-   * Deprecated, always returns 0.
+   * Returns the byte offset of the current region within the buffer. Always returns 0 for
+   * buffers that are not persistent.
    */
   size_t offset() const;
+
+  /**
+   * Returns the capacity of a single region.
+   */
   size_t capacity() const;
 
+  bool persistent() const;
+  size_t regionCount() const;
+  size_t currentRegion() const;
+
+  /**
+   * Fences the current region and makes the next region current, waiting until the GPU
+   * has finished rendering from it. Does nothing if this buffer is not persistent.
+   */
+  void advanceRegion();
+
   void bind();
   void unbind();
 
@@ -81,7 +117,8 @@ public:
   }
 
   /**
-   * Writes a C array to the VBO block.
+   * Writes a C array to the VBO block. For persistent buffers, the array is copied to the
+   * current region.
    *
    * @tparam T        element type
    * @param address   byte offset from the start of the block to write at
@@ -98,6 +135,13 @@ public:
     static_assert(std::is_trivially_copyable<T>::value);
     static_assert(std::is_standard_layout<T>::value);
 
+    if (persistent())
+    {
+      auto* dest = static_cast<unsigned char*>(m_mappedPtr) + offset() + address;
+      std::memcpy(dest, array, size);
+      return size;
+    }
+
     const GLvoid* ptr = static_cast<const GLvoid*>(array);
     const GLintptr offset = static_cast<GLintptr>(address);
     const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
@@ -40,6 +40,8 @@ static GLenum typeToOpenGL(const VboType type)
     return GL_ARRAY_BUFFER;
   case VboType::ElementArrayBuffer:
     return GL_ELEMENT_ARRAY_BUFFER;
+  case VboType::DrawIndirectBuffer:
+    return GL_DRAW_INDIRECT_BUFFER;
     switchDefault();
   }
 }
@@ -51,11 +53,23 @@ static GLenum usageToOpenGL(const VboUsage usage)
   case VboUsage::StaticDraw:
     return GL_STATIC_DRAW;
   case VboUsage::DynamicDraw:
+  case VboUsage::PersistentDraw:
     return GL_DYNAMIC_DRAW;
     switchDefault();
   }
 }
 
+static bool supportsBufferStorage()
+{
+  return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+/**
+ * The number of regions of a persistent buffer. With three regions, the GPU can still
+ * render from the two previously written regions while the current one is written to.
+ */
+static constexpr size_t PersistentRegionCount = 3;
+
 // VboManager
 
 VboManager::VboManager(ShaderManager* shaderManager)
@@ -68,9 +82,11 @@ VboManager::VboManager(ShaderManager* shaderManager)
 
 Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage)
 {
-  auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+  auto* result = usage == VboUsage::PersistentDraw && supportsBufferStorage()
+                   ? new Vbo(typeToOpenGL(type), capacity, PersistentRegionCount)
+                   : new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
 
-  m_currentVboSize += capacity;
+  m_currentVboSize += result->capacity() * result->regionCount();
   m_currentVboCount++;
   m_peakVboCount = std::max(m_peakVboCount, m_currentVboCount);
 
@@ -79,7 +95,7 @@ Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage
 
 void VboManager::destroyVbo(Vbo* vbo)
 {
-  m_currentVboSize -= vbo->capacity();
+  m_currentVboSize -= vbo->capacity() * vbo->regionCount();
   m_currentVboCount--;
 
   vbo->free();
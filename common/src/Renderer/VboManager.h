@@ -33,13 +33,19 @@ class ShaderManager;
 enum class VboType
 {
   ArrayBuffer,
-  ElementArrayBuffer
+  ElementArrayBuffer,
+  DrawIndirectBuffer
 };
 
 enum class VboUsage
 {
   StaticDraw,
-  DynamicDraw
+  DynamicDraw,
+  /**
+   * A persistently mapped ring of buffer regions, see Vbo. Falls back to DynamicDraw if
+   * buffer storage is not supported.
+   */
+  PersistentDraw
 };
 
 class VboManager
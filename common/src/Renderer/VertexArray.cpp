@@ -132,6 +132,45 @@ void VertexArray::render(
   }
 }
 
+void VertexArray::renderInstanced(const PrimType primType, const GLsizei instanceCount)
+{
+  assert(prepared());
+  const auto wasSetup = m_setup;
+  if (wasSetup || setup())
+  {
+    glAssert(glDrawArraysInstanced(
+      toGL(primType), 0, static_cast<GLsizei>(vertexCount()), instanceCount));
+    if (!wasSetup)
+    {
+      cleanup();
+    }
+  }
+}
+
+void VertexArray::renderInstanced(
+  const PrimType primType,
+  const GLIndices& indices,
+  const GLCounts& counts,
+  const GLint primCount,
+  const GLsizei instanceCount)
+{
+  assert(prepared());
+  const auto wasSetup = m_setup;
+  if (wasSetup || setup())
+  {
+    // there is no instanced variant of glMultiDrawArrays
+    for (size_t i = 0; i < static_cast<size_t>(primCount); ++i)
+    {
+      glAssert(
+        glDrawArraysInstanced(toGL(primType), indices[i], counts[i], instanceCount));
+    }
+    if (!wasSetup)
+    {
+      cleanup();
+    }
+  }
+}
+
 void VertexArray::render(
   const PrimType primType, const GLIndices& indices, const GLsizei count)
 {
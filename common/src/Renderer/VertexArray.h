@@ -20,12 +20,14 @@
 #pragma once
 
 #include "Ensure.h"
+#include "Renderer/BrushRendererArrays.h"
 #include "Renderer/GL.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Vbo.h"
 #include "Renderer/VboManager.h"
+#include "Renderer/VertexBufferPool.h"
 
 #include <kdl/vector_utils.h>
 
@@ -176,6 +178,91 @@ private:
     const VertexList& doGetVertices() const override { return m_vertices; }
   };
 
+  template <typename VertexSpec>
+  class PooledHolder : public BaseHolder
+  {
+  private:
+    using VertexList = std::vector<typename VertexSpec::Vertex>;
+
+  private:
+    VertexBufferPool& m_pool;
+    const VertexList& m_vertices;
+    VboManager* m_vboManager;
+    AllocationTracker::Block* m_block;
+
+  public:
+    PooledHolder(VertexBufferPool& pool, const VertexList& vertices)
+      : m_pool(pool)
+      , m_vertices(vertices)
+      , m_vboManager(nullptr)
+      , m_block(nullptr)
+    {
+    }
+
+    ~PooledHolder() override
+    {
+      if (m_block != nullptr)
+      {
+        m_pool.free(m_block);
+        m_block = nullptr;
+      }
+    }
+
+    size_t vertexCount() const override { return m_vertices.size(); }
+
+    size_t sizeInBytes() const override { return VertexSpec::Size * m_vertices.size(); }
+
+    void prepare(VboManager& vboManager) override
+    {
+      if (!m_vertices.empty() && m_block == nullptr)
+      {
+        m_vboManager = &vboManager;
+        m_block = m_pool.allocate(m_vertices);
+      }
+      m_pool.prepare(vboManager);
+    }
+
+    void setup() override
+    {
+      ensure(m_block != nullptr, "block is null");
+      m_pool.bind();
+      VertexSpec::setup(
+        m_vboManager->shaderManager().currentProgram(), m_pool.offset(m_block));
+    }
+
+    void cleanup() override
+    {
+      VertexSpec::cleanup(m_vboManager->shaderManager().currentProgram());
+      m_pool.unbind();
+    }
+  };
+
+  template <typename VertexSpec>
+  class SharedHolder : public BaseHolder
+  {
+  private:
+    using Vertex = typename VertexSpec::Vertex;
+
+  private:
+    std::shared_ptr<VertexHolder<Vertex>> m_vertices;
+
+  public:
+    explicit SharedHolder(std::shared_ptr<VertexHolder<Vertex>> vertices)
+      : m_vertices(std::move(vertices))
+    {
+    }
+
+    size_t vertexCount() const override { return m_vertices->size(); }
+
+    size_t sizeInBytes() const override { return VertexSpec::Size * m_vertices->size(); }
+
+    void prepare(VboManager& vboManager) override { m_vertices->prepare(vboManager); }
+
+    void setup() override { m_vertices->setupVertices(); }
+
+    void cleanup() override { m_vertices->cleanupVertices(); }
+  };
+
 private:
   std::shared_ptr<BaseHolder> m_holder;
   bool m_prepared;
@@ -236,6 +323,44 @@ public:
       std::make_shared<ByRefHolder<typename GLVertex<Attrs...>::Type>>(vertices));
   }
 
+  /**
+   * Creates a new vertex array by referencing the contents of the given vertices like
+   * ref() does, but when the vertex array is prepared, the vertices are copied into the
+   * given pool instead of a vertex buffer object of their own.
+   *
+   * A caller must ensure that this vertex array does not outlive the given vector of
+   * vertices or the given pool.
+   *
+   * @tparam Attrs the vertex attribute types
+   * @param pool the pool to allocate the vertices from
+   * @param vertices the vertices to reference
+   * @return the vertex array
+   */
+  template <typename... Attrs>
+  static VertexArray pooled(
+    VertexBufferPool& pool, const std::vector<GLVertex<Attrs...>>& vertices)
+  {
+    return VertexArray(
+      std::make_shared<PooledHolder<typename GLVertex<Attrs...>::Type>>(pool, vertices));
+  }
+
+  /**
+   * Creates a new vertex array that renders the vertices of the given holder. The holder
+   * is shared and may be modified after this operation; when the vertex array is
+   * prepared, only the modified ranges of the holder are uploaded. The vertex count is
+   * that of the holder at the time the vertex array is rendered.
+   *
+   * @tparam Attrs the vertex attribute types
+   * @param vertices the holder of the vertices to share
+   * @return the vertex array
+   */
+  template <typename... Attrs>
+  static VertexArray shared(std::shared_ptr<VertexHolder<GLVertex<Attrs...>>> vertices)
+  {
+    return VertexArray(std::make_shared<SharedHolder<typename GLVertex<Attrs...>::Type>>(
+      std::move(vertices)));
+  }
+
   /**
    * Indicates whether this vertex array is empty.
    *
@@ -319,6 +444,33 @@ public:
   void render(
     PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
 
+  /**
+   * Renders the given number of instances of this vertex array as a range of primitives
+   * of the given type. Per instance attributes must be set up by the caller.
+   *
+   * @param primType the primitive type to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(PrimType primType, GLsizei instanceCount);
+
+  /**
+   * Renders the given number of instances of a number of sub ranges of this vertex array.
+   * The ranges are given the same way as for the render method above. Per instance
+   * attributes must be set up by the caller.
+   *
+   * @param primType the primitive type to render
+   * @param indices the start indices of the ranges to render
+   * @param counts the lengths of the ranges to render
+   * @param primCount the number of ranges to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(
+    PrimType primType,
+    const GLIndices& indices,
+    const GLCounts& counts,
+    GLint primCount,
+    GLsizei instanceCount);
+
   /**
    * Renders a number of primitives of the given type, the vertices of which are indicates
    * by the given index array.
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "VertexBufferPool.h"
+
+#include <algorithm>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+VertexBufferPool::VertexBufferPool()
+  : m_buffer(VboType::ArrayBuffer, VboUsage::StaticDraw)
+  , m_allocationTracker(0)
+{
+}
+
+void VertexBufferPool::free(AllocationTracker::Block* block)
+{
+  // there's no need to clear the freed vertices since nothing renders them anymore
+  m_allocationTracker.free(block);
+}
+
+const AllocationTracker& VertexBufferPool::allocationTracker() const
+{
+  return m_allocationTracker;
+}
+
+bool VertexBufferPool::prepared() const
+{
+  return m_buffer.prepared();
+}
+
+void VertexBufferPool::prepare(VboManager& vboManager)
+{
+  m_buffer.prepare(vboManager);
+  assert(m_buffer.prepared());
+}
+
+size_t VertexBufferPool::offset(const AllocationTracker::Block* block) const
+{
+  return m_buffer.offset() + block->pos;
+}
+
+void VertexBufferPool::bind()
+{
+  m_buffer.bindBlock();
+}
+
+void VertexBufferPool::unbind()
+{
+  m_buffer.unbindBlock();
+}
+
+AllocationTracker::Block* VertexBufferPool::allocateBlock(const size_t size)
+{
+  if (auto* block = m_allocationTracker.allocate(size))
+  {
+    return block;
+  }
+
+  const auto newSize =
+    std::max(2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + size);
+  m_allocationTracker.expand(newSize);
+  m_buffer.resize(newSize);
+
+  auto* block = m_allocationTracker.allocate(size);
+  assert(block != nullptr);
+  return block;
+}
+} // namespace Renderer
+} // namespace TrenchBroom
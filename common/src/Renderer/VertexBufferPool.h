@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/AllocationTracker.h"
+#include "Renderer/BrushRendererArrays.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+class VboManager;
+
+/**
+ * A vertex buffer that many vertex arrays allocate their vertices from, so that they can
+ * all be rendered from a single buffer object instead of each uploading a small buffer of
+ * its own. See VertexArray::pooled.
+ *
+ * The pool grows as needed. Freed allocations are reused by later allocations, but the
+ * pool never shrinks.
+ */
+class VertexBufferPool
+{
+private:
+  VboHolder<unsigned char> m_buffer;
+  AllocationTracker m_allocationTracker;
+
+public:
+  VertexBufferPool();
+
+  /**
+   * Copies the given vertices into this pool.
+   *
+   * Returns the allocation that holds the vertices, which must be passed to free() once
+   * the vertices are no longer needed.
+   */
+  template <typename T>
+  AllocationTracker::Block* allocate(const std::vector<T>& vertices)
+  {
+    const auto size = vertices.size() * sizeof(T);
+
+    // keeps every allocation aligned for the vertex attributes
+    assert(size % 4 == 0);
+
+    auto* block = allocateBlock(size);
+    auto* dest = m_buffer.getPointerToWriteElementsTo(block->pos, size);
+    std::memcpy(dest, vertices.data(), size);
+    return block;
+  }
+
+  void free(AllocationTracker::Block* block);
+
+  const AllocationTracker& allocationTracker() const;
+
+  bool prepared() const;
+  void prepare(VboManager& vboManager);
+
+  /**
+   * Returns the byte offset of the given allocation within the buffer object.
+   */
+  size_t offset(const AllocationTracker::Block* block) const;
+
+  void bind();
+  void unbind();
+
+private:
+  AllocationTracker::Block* allocateBlock(size_t size);
+};
+} // namespace Renderer
+} // namespace TrenchBroom
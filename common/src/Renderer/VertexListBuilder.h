@@ -181,7 +181,7 @@ private:
 
     const size_t index = currentIndex();
     const size_t count = vertices.size();
-    m_vertices = kdl::vec_concat(std::move(m_vertices), vertices);
+    m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
 
     return Range(index, count);
   }
@@ -0,0 +1,195 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Trace.h"
+
+#include "IO/DiskIO.h"
+
+#include <kdl/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+
+namespace TrenchBroom
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct TraceState
+{
+  std::mutex mutex;
+  std::filesystem::path path;
+  std::vector<TraceEvent> events;
+  Clock::time_point start;
+};
+
+std::atomic<bool> tracing{false};
+
+TraceState& traceState()
+{
+  static auto state = TraceState{};
+  return state;
+}
+
+size_t currentThreadId()
+{
+  static auto nextThreadId = std::atomic<size_t>{0};
+  thread_local const auto threadId = nextThreadId++;
+  return threadId;
+}
+
+void recordEvent(
+  std::string name, const Clock::time_point start, const Clock::time_point end)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  const auto threadId = currentThreadId();
+
+  auto& state = traceState();
+  const auto lock = std::lock_guard{state.mutex};
+  if (tracing)
+  {
+    state.events.push_back(TraceEvent{
+      std::move(name),
+      threadId,
+      duration_cast<microseconds>(start - state.start).count(),
+      duration_cast<microseconds>(end - start).count()});
+  }
+}
+
+void traceParallelChunk(const bool started)
+{
+  // chunks can be nested if parallel_for is called from a parallel_for lambda
+  thread_local auto chunkStarts = std::vector<Clock::time_point>{};
+
+  if (started)
+  {
+    chunkStarts.push_back(Clock::now());
+  }
+  else if (!chunkStarts.empty())
+  {
+    const auto start = chunkStarts.back();
+    chunkStarts.pop_back();
+    recordEvent("parallel_for chunk", start, Clock::now());
+  }
+}
+
+void writeJsonString(std::ostream& str, const std::string& string)
+{
+  str << '"';
+  for (const auto c : string)
+  {
+    if (c == '"' || c == '\\')
+    {
+      str << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      str << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+    }
+    else
+    {
+      str << c;
+    }
+  }
+  str << '"';
+}
+} // namespace
+
+void startTracing(const std::filesystem::path& path)
+{
+  auto& state = traceState();
+  {
+    const auto lock = std::lock_guard{state.mutex};
+    state.path = path;
+    state.events.clear();
+    state.start = Clock::now();
+    tracing = true;
+  }
+
+  kdl::set_parallel_chunk_observer(traceParallelChunk);
+}
+
+bool isTracing()
+{
+  return tracing;
+}
+
+Result<void> stopTracing()
+{
+  if (!tracing)
+  {
+    return kdl::void_success;
+  }
+
+  kdl::set_parallel_chunk_observer(nullptr);
+
+  auto& state = traceState();
+  auto events = std::vector<TraceEvent>{};
+  auto path = std::filesystem::path{};
+  {
+    const auto lock = std::lock_guard{state.mutex};
+    tracing = false;
+    events = std::move(state.events);
+    path = std::move(state.path);
+    state.events.clear();
+  }
+
+  std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.start < rhs.start;
+  });
+
+  return IO::Disk::withOutputStream(
+    path, [&](auto& stream) { writeTraceJson(stream, events); });
+}
+
+void writeTraceJson(std::ostream& str, const std::vector<TraceEvent>& events)
+{
+  str << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const auto& event = events[i];
+    str << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    writeJsonString(str, event.name);
+    str << ",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration
+        << ",\"pid\":1,\"tid\":" << event.threadId << "}";
+  }
+  str << "\n]}\n";
+}
+
+TraceZone::TraceZone(std::string name)
+  : m_name{std::move(name)}
+  , m_active{tracing}
+  , m_start{m_active ? Clock::now() : Clock::time_point{}}
+{
+}
+
+TraceZone::~TraceZone()
+{
+  if (m_active)
+  {
+    recordEvent(std::move(m_name), m_start, Clock::now());
+  }
+}
+} // namespace TrenchBroom
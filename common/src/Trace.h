@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+/**
+ * A zone that was recorded while tracing. Times are in microseconds since tracing was
+ * started. Zones that are nested on the same thread are shown nested in the trace viewer.
+ */
+struct TraceEvent
+{
+  std::string name;
+  size_t threadId;
+  int64_t start;
+  int64_t duration;
+};
+
+/**
+ * Starts recording zones. The zones are written to the given file when tracing is
+ * stopped.
+ */
+void startTracing(const std::filesystem::path& path);
+
+bool isTracing();
+
+/**
+ * Stops recording zones and writes the recorded zones to the file that was passed to
+ * startTracing. Does nothing if tracing was not started.
+ */
+Result<void> stopTracing();
+
+/**
+ * Writes the given events in the Chrome trace event format, which can be opened in
+ * chrome://tracing or in Perfetto.
+ */
+void writeTraceJson(std::ostream& str, const std::vector<TraceEvent>& events);
+
+/**
+ * Records the time between its construction and its destruction as a zone if tracing has
+ * been started. Use the traceZone macro instead of creating zones directly so that they
+ * are compiled out unless TB_ENABLE_TRACING is defined.
+ */
+class TraceZone
+{
+private:
+  std::string m_name;
+  bool m_active;
+  std::chrono::steady_clock::time_point m_start;
+
+public:
+  explicit TraceZone(std::string name);
+  ~TraceZone();
+
+  TraceZone(const TraceZone&) = delete;
+  TraceZone& operator=(const TraceZone&) = delete;
+};
+} // namespace TrenchBroom
+
+#define traceZoneConcat2(a, b) a##b
+#define traceZoneConcat(a, b) traceZoneConcat2(a, b)
+
+#ifdef TB_ENABLE_TRACING
+#define traceZone(name)                                                                  \
+  const auto traceZoneConcat(traceZone_, __LINE__) = TrenchBroom::TraceZone{name}
+#else
+#define traceZone(name)                                                                  \
+  do                                                                                     \
+  {                                                                                      \
+  } while (0)
+#endif
@@ -30,6 +30,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Result.h"
+#include "Trace.h"
 #include "TrenchBroomStackWalker.h"
 #include "View/AboutDialog.h"
 #include "View/Actions.h"
@@ -100,6 +101,44 @@ std::shared_ptr<MapDocument> topDocument()
   }
   return {};
 }
+
+bool reportGameFactoryInitialization(Result<std::vector<std::string>> result)
+{
+  const auto& gameFactory = Model::GameFactory::instance();
+  return std::move(result)
+    .transform([&](auto errors) {
+      const auto& loadStats = gameFactory.loadStats();
+      qDebug().noquote() << QString::fromStdString(fmt::format(
+        "Loaded {} game configurations in {}ms (file system: {}ms, configurations: {}ms)",
+        loadStats.gameConfigs,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+          loadStats.fileSystemTime + loadStats.gameConfigsTime)
+          .count(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(loadStats.fileSystemTime)
+          .count(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(loadStats.gameConfigsTime)
+          .count()));
+
+      if (!errors.empty())
+      {
+        const auto msg = fmt::format(
+          R"(Some game configurations could not be loaded. The following errors occurred:
+
+{})",
+          kdl::str_join(errors, "\n\n"));
+
+        QMessageBox::critical(
+          nullptr, "TrenchBroom", QString::fromStdString(msg), QMessageBox::Ok);
+      }
+    })
+    .if_error([](auto e) {
+      qCritical() << QString::fromStdString(e.msg);
+      QMessageBox::critical(
+        nullptr, "TrenchBroom", QString::fromStdString(e.msg), QMessageBox::Ok);
+      QCoreApplication::exit(1);
+    })
+    .is_success();
+}
 } // namespace
 
 TrenchBroomApp& TrenchBroomApp::instance()
@@ -115,6 +154,7 @@ LONG WINAPI TrenchBroomUnhandledExceptionFilter(PEXCEPTION_POINTERS pExceptionPt
 
 TrenchBroomApp::TrenchBroomApp(int& argc, char** argv)
   : QApplication{argc, argv}
+  , m_startTime{std::chrono::steady_clock::now()}
 {
   using namespace std::chrono_literals;
 
@@ -144,11 +184,9 @@ TrenchBroomApp::TrenchBroomApp(int& argc, char** argv)
   setOrganizationName("");
   setOrganizationDomain("io.github.trenchbroom");
 
-  if (!initializeGameFactory())
-  {
-    QCoreApplication::exit(1);
-    return;
-  }
+  // the game configurations are only needed once a document is created or opened, so
+  // they are loaded while the welcome window is shown
+  startGameFactoryInitialization();
 
   loadStyleSheets();
   loadStyle();
@@ -168,7 +206,9 @@ TrenchBroomApp::TrenchBroomApp(int& argc, char** argv)
     &RecentDocuments::didChange,
     this,
     &TrenchBroomApp::recentDocumentsDidChange);
-  m_recentDocuments->reload();
+  // checking whether the recent documents still exist can be slow, so defer it until
+  // the event loop is running
+  QTimer::singleShot(0, m_recentDocuments.get(), &RecentDocuments::reload);
   m_recentDocumentsReloadTimer = new QTimer{};
   connect(
     m_recentDocumentsReloadTimer,
@@ -209,6 +249,9 @@ TrenchBroomApp::TrenchBroomApp(int& argc, char** argv)
 
 TrenchBroomApp::~TrenchBroomApp()
 {
+  stopTracing().transform_error([](auto e) {
+    qCritical() << "Could not write trace:" << QString::fromStdString(e.msg);
+  });
   PreferenceManager::destroyInstance();
 }
 
@@ -216,7 +259,18 @@ void TrenchBroomApp::parseCommandLineAndShowFrame()
 {
   auto parser = QCommandLineParser{};
   parser.addOption(QCommandLineOption("portable"));
+#ifdef TB_ENABLE_TRACING
+  parser.addOption(QCommandLineOption{"trace", "Write a trace to <file>.", "file"});
+#endif
   parser.process(*this);
+
+#ifdef TB_ENABLE_TRACING
+  if (parser.isSet("trace"))
+  {
+    startTracing(IO::pathFromQString(parser.value("trace")));
+  }
+#endif
+
   openFilesOrWelcomeFrame(parser.positionalArguments());
 }
 
@@ -356,6 +410,11 @@ void TrenchBroomApp::updateRecentDocument(const std::filesystem::path& path)
 
 bool TrenchBroomApp::openDocument(const std::filesystem::path& path)
 {
+  if (!initializeGameFactory())
+  {
+    return false;
+  }
+
   const auto checkFileExists = [&]() {
     return IO::Disk::pathInfo(path) == IO::PathInfo::File
              ? Result<void>{}
@@ -422,6 +481,11 @@ bool TrenchBroomApp::openDocument(const std::filesystem::path& path)
 
 void TrenchBroomApp::openPreferences()
 {
+  if (!initializeGameFactory())
+  {
+    return;
+  }
+
   auto dialog = PreferenceDialog{topDocument()};
   dialog.exec();
 }
@@ -431,33 +495,38 @@ void TrenchBroomApp::openAbout()
   AboutDialog::showAboutDialog();
 }
 
-bool TrenchBroomApp::initializeGameFactory()
+void TrenchBroomApp::startGameFactoryInitialization()
 {
-  const auto gamePathConfig = Model::GamePathConfig{
+  // the search paths are determined here because QStandardPaths must not be used from
+  // another thread
+  auto gamePathConfig = Model::GamePathConfig{
     IO::SystemPaths::findResourceDirectories("games"),
     IO::SystemPaths::userDataDirectory() / "games",
   };
-  auto& gameFactory = Model::GameFactory::instance();
-  return gameFactory.initialize(gamePathConfig)
-    .transform([](auto errors) {
-      if (!errors.empty())
-      {
-        const auto msg = fmt::format(
-          R"(Some game configurations could not be loaded. The following errors occurred:
 
-{})",
-          kdl::str_join(errors, "\n\n"));
+  m_gameFactoryInitialization = std::async(
+    std::launch::async, [gamePathConfig = std::move(gamePathConfig)]() {
+      return Model::GameFactory::instance().initialize(gamePathConfig);
+    });
+}
 
-        QMessageBox::critical(
-          nullptr, "TrenchBroom", QString::fromStdString(msg), QMessageBox::Ok);
-      }
-    })
-    .if_error([](auto e) { qCritical() << QString::fromStdString(e.msg); })
-    .is_success();
+bool TrenchBroomApp::initializeGameFactory()
+{
+  if (!m_gameFactoryInitialized)
+  {
+    m_gameFactoryInitialized =
+      reportGameFactoryInitialization(m_gameFactoryInitialization.get());
+  }
+  return *m_gameFactoryInitialized;
 }
 
 bool TrenchBroomApp::newDocument()
 {
+  if (!initializeGameFactory())
+  {
+    return false;
+  }
+
   auto* frame = static_cast<MapFrame*>(nullptr);
   try
   {
@@ -629,8 +698,18 @@ void TrenchBroomApp::showWelcomeWindow()
   {
     // must be initialized after m_recentDocuments!
     m_welcomeWindow = std::make_unique<WelcomeWindow>();
+    m_welcomeWindow->show();
+
+    qDebug().noquote() << QString::fromStdString(fmt::format(
+      "Showed welcome window {}ms after startup",
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_startTime)
+        .count()));
+  }
+  else
+  {
+    m_welcomeWindow->show();
   }
-  m_welcomeWindow->show();
 }
 
 void TrenchBroomApp::closeWelcomeWindow()
@@ -22,9 +22,13 @@
 #include <QApplication>
 
 #include "Notifier.h"
+#include "Result.h"
 
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -52,6 +56,10 @@ private:
   std::unique_ptr<WelcomeWindow> m_welcomeWindow;
   QTimer* m_recentDocumentsReloadTimer;
 
+  std::chrono::steady_clock::time_point m_startTime;
+  std::future<Result<std::vector<std::string>>> m_gameFactoryInitialization;
+  std::optional<bool> m_gameFactoryInitialized;
+
 public:
   static TrenchBroomApp& instance();
 
@@ -64,6 +72,7 @@ public:
   FrameManager* frameManager();
 
 private:
+  void startGameFactoryInitialization();
   static QPalette darkPalette();
   bool loadStyleSheets();
   void loadStyle();
@@ -77,6 +86,14 @@ public:
   bool openDocument(const std::filesystem::path& path);
   void openPreferences();
   void openAbout();
+
+  /**
+   * Waits until the game configurations, which are loaded in the background when the
+   * application starts, are available and reports any errors that occurred while loading
+   * them. Must be called before the game factory is used.
+   *
+   * @return true if the game factory was initialized successfully
+   */
   bool initializeGameFactory();
 
   bool newDocument();
@@ -1979,6 +1979,12 @@ void ActionManager::createDebugMenu()
     0,
     [](ActionExecutionContext& context) { context.frame()->debugShowPalette(); },
     [](ActionExecutionContext& context) { return context.hasDocument(); }));
+  debugMenu.addItem(createMenuAction(
+    std::filesystem::path{"Menu/Debug/Show Memory Usage..."},
+    QObject::tr("Show Memory Usage..."),
+    0,
+    [](ActionExecutionContext& context) { context.frame()->debugShowMemoryUsage(); },
+    [](ActionExecutionContext& context) { return context.hasDocument(); }));
 #endif
 }
 
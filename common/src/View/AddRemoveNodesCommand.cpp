@@ -22,6 +22,7 @@
 #include "Ensure.h"
 #include "Error.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -135,5 +136,12 @@ void AddRemoveNodesCommand::undoAction(MapDocumentCommandFacade* document)
   using std::swap;
   swap(m_nodesToAdd, m_nodesToRemove);
 }
+
+size_t AddRemoveNodesCommand::memorySize() const
+{
+  // the nodes to add are owned by this command
+  return UpdateLinkedGroupsCommandBase::memorySize()
+         + Model::estimateMemorySize(Model::collectChildren(m_nodesToAdd));
+}
 } // namespace View
 } // namespace TrenchBroom
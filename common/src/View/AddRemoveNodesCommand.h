@@ -60,6 +60,8 @@ public:
     Action action, const std::map<Model::Node*, std::vector<Model::Node*>>& nodes);
   ~AddRemoveNodesCommand() override;
 
+  size_t memorySize() const override;
+
 private:
   static std::string makeName(Action action);
 
@@ -40,6 +40,7 @@
 #include <cassert>
 #include <limits>
 #include <memory>
+#include <sstream>
 
 namespace TrenchBroom::View
 {
@@ -73,6 +74,16 @@ Autosaver::Autosaver(
 
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (m_pendingAutosave)
+  {
+    using namespace std::chrono_literals;
+    if (m_pendingAutosave->backup.wait_for(0s) != std::future_status::ready)
+    {
+      return;
+    }
+    reportPendingAutosave(logger);
+  }
+
   if (!kdl::mem_expired(m_document))
   {
     auto document = kdl::mem_lock(m_document);
@@ -85,18 +96,68 @@ void Autosaver::triggerAutosave(Logger& logger)
   }
 }
 
+void Autosaver::finishPendingAutosave(Logger& logger)
+{
+  if (m_pendingAutosave)
+  {
+    reportPendingAutosave(logger);
+  }
+}
+
 void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
 {
   const auto& mapPath = document->path();
   assert(IO::Disk::pathInfo(mapPath) == IO::PathInfo::File);
 
-  const auto mapFilename = mapPath.filename();
+  // serializing the document is fast and must happen on this thread, but the file system
+  // operations are slow and only need the serialized snapshot
+  auto stream = std::ostringstream{};
+  document->saveDocumentTo(stream);
+
+  m_pendingAutosave = PendingAutosave{
+    std::async(
+      std::launch::async,
+      [this, mapPath = mapPath, mapContents = stream.str()]() {
+        return writeBackup(mapPath, mapContents);
+      }),
+    document->modificationCount()};
+
+  logger.debug() << "Writing autosave backup for " << mapPath;
+}
+
+void Autosaver::reportPendingAutosave(Logger& logger)
+{
+  assert(m_pendingAutosave);
+
+  auto pendingAutosave = std::move(*m_pendingAutosave);
+  m_pendingAutosave = std::nullopt;
+
+  pendingAutosave.backup.get()
+    .transform([&](const auto& backup) {
+      for (const auto& deletedBackup : backup.deletedBackups)
+      {
+        logger.debug() << "Deleted autosave backup " << deletedBackup;
+      }
+
+      m_lastSaveTime = Clock::now();
+      m_lastModificationCount = pendingAutosave.modificationCount;
+
+      logger.info() << "Created autosave backup at " << backup.path;
+    })
+    .transform_error([&](auto e) { logger.error() << "Aborting autosave: " << e.msg; });
+}
+
+Result<Autosaver::Backup> Autosaver::writeBackup(
+  const std::filesystem::path& mapPath, const std::string& mapContents) const
+{
   const auto mapBasename = mapPath.stem();
+  auto deletedBackups = std::vector<std::filesystem::path>{};
 
-  createBackupFileSystem(mapPath)
+  return createBackupFileSystem(mapPath)
     .and_then([&](auto fs) {
       return collectBackups(fs, mapBasename)
-        .and_then([&](auto backups) { return thinBackups(logger, fs, backups); })
+        .and_then(
+          [&](auto backups) { return thinBackups(fs, backups, deletedBackups); })
         .and_then([&](auto remainingBackups) {
           return cleanBackups(fs, remainingBackups, mapBasename).and_then([&]() {
             assert(remainingBackups.size() < m_maxBackups);
@@ -105,14 +166,13 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
           });
         });
     })
-    .transform([&](const auto& backupFilePath) {
-      m_lastSaveTime = Clock::now();
-      m_lastModificationCount = document->modificationCount();
-      document->saveDocumentTo(backupFilePath);
-
-      logger.info() << "Created autosave backup at " << backupFilePath;
-    })
-    .transform_error([&](auto e) { logger.error() << "Aborting autosave: " << e.msg; });
+    .and_then([&](auto backupFilePath) {
+      return IO::Disk::withOutputStream(
+               backupFilePath, [&](auto& stream) { stream << mapContents; })
+        .transform([&]() {
+          return Backup{std::move(backupFilePath), std::move(deletedBackups)};
+        });
+    });
 }
 
 Result<IO::WritableDiskFileSystem> Autosaver::createBackupFileSystem(
@@ -134,9 +194,9 @@ Result<std::vector<std::filesystem::path>> Autosaver::collectBackups(
 }
 
 Result<std::vector<std::filesystem::path>> Autosaver::thinBackups(
-  Logger& logger,
   IO::WritableDiskFileSystem& fs,
-  const std::vector<std::filesystem::path>& backups) const
+  const std::vector<std::filesystem::path>& backups,
+  std::vector<std::filesystem::path>& deletedBackups) const
 {
   if (backups.size() < m_maxBackups)
   {
@@ -151,7 +211,7 @@ Result<std::vector<std::filesystem::path>> Autosaver::thinBackups(
                return fs.deleteFile(filename).transform([&](const auto deleted) {
                  if (deleted)
                  {
-                   logger.debug() << "Deleted autosave backup " << filename;
+                   deletedBackups.push_back(filename);
                  }
                });
              }))
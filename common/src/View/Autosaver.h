@@ -19,12 +19,19 @@
 
 #pragma once
 
+#include "Error.h"
 #include "IO/FileSystem.h"
 #include "Result.h"
 
+#include <kdl/result.h>
+
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -72,24 +79,58 @@ private:
    */
   size_t m_lastModificationCount;
 
+  struct Backup
+  {
+    std::filesystem::path path;
+    std::vector<std::filesystem::path> deletedBackups;
+  };
+
+  struct PendingAutosave
+  {
+    std::future<Result<Backup>> backup;
+    size_t modificationCount;
+  };
+
+  /**
+   * The autosave that is currently being written on a background thread, if any. The
+   * background thread uses this object, so this must be the last member to be destroyed
+   * first; destroying the future waits for the thread to finish.
+   */
+  std::optional<PendingAutosave> m_pendingAutosave;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
 
+  /**
+   * Creates a backup if the document was modified and the save interval has elapsed.
+   *
+   * The document is serialized on the calling thread, but the backup is written on a
+   * background thread. While a backup is being written, no other backup is created.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Waits until the backup that is currently being written, if any, is finished and logs
+   * the result.
+   */
+  void finishPendingAutosave(Logger& logger);
+
 private:
   void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+  void reportPendingAutosave(Logger& logger);
+  Result<Backup> writeBackup(
+    const std::filesystem::path& mapPath, const std::string& mapContents) const;
   Result<IO::WritableDiskFileSystem> createBackupFileSystem(
     const std::filesystem::path& mapPath) const;
   Result<std::vector<std::filesystem::path>> collectBackups(
     const IO::FileSystem& fs, const std::filesystem::path& mapBasename) const;
   Result<std::vector<std::filesystem::path>> thinBackups(
-    Logger& logger,
     IO::WritableDiskFileSystem& fs,
-    const std::vector<std::filesystem::path>& backups) const;
+    const std::vector<std::filesystem::path>& backups,
+    std::vector<std::filesystem::path>& deletedBackups) const;
   Result<void> cleanBackups(
     IO::WritableDiskFileSystem& fs,
     std::vector<std::filesystem::path>& backups,
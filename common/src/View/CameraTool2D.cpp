@@ -116,6 +116,8 @@ public:
 
   void end(const InputState&) override {}
   void cancel() override {}
+
+  bool usesPickResult() const override { return false; }
 };
 
 class ZoomDragTracker : public DragTracker
@@ -141,6 +143,8 @@ public:
 
   void end(const InputState&) override {}
   void cancel() override {}
+
+  bool usesPickResult() const override { return false; }
 };
 } // namespace
 
@@ -231,6 +231,8 @@ public:
 
   void end(const InputState&) override {}
   void cancel() override {}
+
+  bool usesPickResult() const override { return false; }
 };
 
 class LookDragTracker : public DragTracker
@@ -275,6 +277,8 @@ public:
 
   void end(const InputState&) override {}
   void cancel() override {}
+
+  bool usesPickResult() const override { return false; }
 };
 
 class PanDragTracker : public DragTracker
@@ -316,6 +320,8 @@ public:
 
   void end(const InputState&) override {}
   void cancel() override {}
+
+  bool usesPickResult() const override { return false; }
 };
 } // namespace
 
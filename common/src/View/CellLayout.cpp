@@ -445,35 +445,33 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
   return m_rows;
 }
 
-size_t LayoutGroup::indexOfRowAt(const float y) const
+LayoutRange<LayoutRow> LayoutGroup::rowsIntersectingY(
+  const float y, const float height) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
-  {
-    const LayoutRow& row = m_rows[i];
-    const LayoutBounds& rowBounds = row.bounds();
-    if (y < rowBounds.bottom())
-    {
-      return i;
-    }
-  }
+  const auto first = std::lower_bound(
+    m_rows.begin(), m_rows.end(), y, [](const LayoutRow& row, const float rangeTop) {
+      return row.bounds().bottom() < rangeTop;
+    });
+  const auto last = std::upper_bound(
+    first, m_rows.end(), y + height, [](const float rangeBottom, const LayoutRow& row) {
+      return rangeBottom < row.bounds().top();
+    });
+  return {first, last};
+}
 
-  return m_rows.size();
+size_t LayoutGroup::indexOfRowAt(const float y) const
+{
+  const auto it = std::upper_bound(
+    m_rows.begin(), m_rows.end(), y, [](const float rowY, const LayoutRow& row) {
+      return rowY < row.bounds().bottom();
+    });
+  return static_cast<size_t>(std::distance(m_rows.begin(), it));
 }
 
 const LayoutCell* LayoutGroup::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
+  for (const LayoutRow& row : rowsIntersectingY(y, 0.0f))
   {
-    const LayoutRow& row = m_rows[i];
-    const LayoutBounds& rowBounds = row.bounds();
-    if (y > rowBounds.bottom())
-    {
-      continue;
-    }
-    else if (y < rowBounds.top())
-    {
-      break;
-    }
     if (const LayoutCell* cell = row.cellAt(x, y))
     {
       return cell;
@@ -812,25 +810,35 @@ const std::vector<LayoutGroup>& CellLayout::groups()
   return m_groups;
 }
 
-const LayoutCell* CellLayout::cellAt(const float x, const float y)
+LayoutRange<LayoutGroup> CellLayout::groupsIntersectingY(
+  const float y, const float height)
 {
   if (!m_valid)
   {
     validate();
   }
 
-  for (size_t i = 0; i < m_groups.size(); ++i)
+  const auto first = std::lower_bound(
+    m_groups.begin(),
+    m_groups.end(),
+    y,
+    [](const LayoutGroup& group, const float rangeTop) {
+      return group.bounds().bottom() < rangeTop;
+    });
+  const auto last = std::upper_bound(
+    first,
+    m_groups.end(),
+    y + height,
+    [](const float rangeBottom, const LayoutGroup& group) {
+      return rangeBottom < group.bounds().top();
+    });
+  return {first, last};
+}
+
+const LayoutCell* CellLayout::cellAt(const float x, const float y)
+{
+  for (const LayoutGroup& group : groupsIntersectingY(y, 0.0f))
   {
-    const LayoutGroup& group = m_groups[i];
-    const LayoutBounds groupBounds = group.bounds();
-    if (y > groupBounds.bottom())
-    {
-      continue;
-    }
-    else if (y < groupBounds.top())
-    {
-      break;
-    }
     if (const LayoutCell* cell = group.cellAt(x, y))
     {
       return cell;
@@ -931,27 +939,23 @@ void CellLayout::validate()
   m_valid = true;
   if (!m_groups.empty())
   {
-    auto copy = m_groups;
+    // move the items into the new layout, copying them can be expensive
+    auto groups = std::move(m_groups);
     m_groups.clear();
 
-    for (LayoutGroup& group : copy)
+    for (LayoutGroup& group : groups)
     {
-      addGroup(group.item(), group.titleBounds().height);
-      for (const LayoutRow& row : group.rows())
+      addGroup(std::move(group.m_item), group.titleBounds().height);
+      for (LayoutRow& row : group.m_rows)
       {
-        for (const LayoutCell& cell : row.cells())
+        for (LayoutCell& cell : row.m_cells)
         {
-          const LayoutBounds& itemBounds = cell.itemBounds();
-          const LayoutBounds& titleBounds = cell.titleBounds();
-          float scale = cell.scale();
-          float itemWidth = itemBounds.width / scale;
-          float itemHeight = itemBounds.height / scale;
           addItem(
-            std::move(cell.item()),
-            itemWidth,
-            itemHeight,
-            titleBounds.width,
-            titleBounds.height);
+            std::move(cell.m_item),
+            cell.m_itemWidth,
+            cell.m_itemHeight,
+            cell.m_titleWidth,
+            cell.m_titleHeight);
         }
       }
     }
@@ -30,6 +30,8 @@ namespace TrenchBroom
 {
 namespace View
 {
+class CellLayout;
+
 struct LayoutBounds
 {
   float x;
@@ -46,9 +48,35 @@ struct LayoutBounds
   bool intersectsY(float rangeY, float rangeHeight) const;
 };
 
+/**
+ * A contiguous range of the rows of a group or of the groups of a layout.
+ */
+template <typename T>
+class LayoutRange
+{
+private:
+  using Iterator = typename std::vector<T>::const_iterator;
+
+  Iterator m_begin;
+  Iterator m_end;
+
+public:
+  LayoutRange(Iterator begin, Iterator end)
+    : m_begin{begin}
+    , m_end{end}
+  {
+  }
+
+  Iterator begin() const { return m_begin; }
+  Iterator end() const { return m_end; }
+  bool empty() const { return m_begin == m_end; }
+};
+
 class LayoutCell
 {
 private:
+  friend class CellLayout;
+
   std::any m_item;
   float m_x;
   float m_y;
@@ -112,6 +140,8 @@ private:
 class LayoutRow
 {
 private:
+  friend class CellLayout;
+
   float m_cellMargin;
   float m_titleMargin;
   float m_maxWidth;
@@ -162,6 +192,8 @@ private:
 class LayoutGroup
 {
 private:
+  friend class CellLayout;
+
   std::string m_item;
   float m_cellMargin;
   float m_titleMargin;
@@ -216,6 +248,12 @@ public:
   LayoutBounds bounds() const;
 
   const std::vector<LayoutRow>& rows() const;
+
+  /**
+   * Returns the rows that intersect the given vertical range. Since the rows are sorted
+   * by their vertical position, this does not visit the other rows.
+   */
+  LayoutRange<LayoutRow> rowsIntersectingY(float y, float height) const;
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
 
@@ -291,6 +329,12 @@ public:
   void setWidth(float width);
 
   const std::vector<LayoutGroup>& groups();
+
+  /**
+   * Returns the groups that intersect the given vertical range. Since the groups are
+   * sorted by their vertical position, this does not visit the other groups.
+   */
+  LayoutRange<LayoutGroup> groupsIntersectingY(float y, float height);
   const LayoutCell* cellAt(float x, float y);
 
   void addGroup(std::string groupItem, float titleHeight);
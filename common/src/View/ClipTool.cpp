@@ -22,11 +22,13 @@
 #include "Error.h"
 #include "FloatType.h"
 #include "Macros.h"
+#include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/Hit.h"
 #include "Model/HitFilter.h"
+#include "Model/MapFormat.h"
 #include "Model/PickResult.h"
 #include "Model/Polyhedron.h"
 #include "Model/WorldNode.h"
@@ -35,12 +37,13 @@
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/Camera.h"
 #include "Renderer/RenderService.h"
+#include "Result.h"
 #include "View/MapDocument.h"
 #include "View/Selection.h"
 
-#include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
-#include <kdl/overload.h>
+#include <kdl/parallel.h>
+#include <kdl/result.h>
 #include <kdl/set_temp.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
@@ -50,8 +53,13 @@
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <map>
 #include <optional>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
@@ -649,11 +657,168 @@ private:
   }
 };
 
+namespace
+{
+void setFaceAttributes(
+  const std::vector<Model::BrushFace>& faces, Model::BrushFace& toSet)
+{
+  ensure(!faces.empty(), "no faces");
+
+  auto faceIt = std::begin(faces);
+  auto faceEnd = std::end(faces);
+  auto bestMatch = faceIt++;
+
+  while (faceIt != faceEnd)
+  {
+    const auto& face = *faceIt;
+
+    const auto bestDiff = bestMatch->boundary().normal - toSet.boundary().normal;
+    const auto curDiff = face.boundary().normal - toSet.boundary().normal;
+    if (vm::squared_length(curDiff) < vm::squared_length(bestDiff))
+    {
+      bestMatch = faceIt;
+    }
+
+    ++faceIt;
+  }
+
+  toSet.setAttributes(*bestMatch);
+}
+
+/**
+ * Clips the given brush by the plane through the given points. Only accesses its
+ * arguments, so it is safe to call on a worker thread.
+ */
+Result<Model::Brush> clipBrush(
+  Model::Brush brush,
+  const vm::vec3& point1,
+  const vm::vec3& point2,
+  const vm::vec3& point3,
+  const Model::BrushFaceAttributes& attributes,
+  const Model::MapFormat mapFormat,
+  const vm::bbox3& worldBounds)
+{
+  return Model::BrushFace::create(point1, point2, point3, attributes, mapFormat)
+    .and_then([&](Model::BrushFace&& clipFace) {
+      setFaceAttributes(brush.faces(), clipFace);
+      return brush.clip(worldBounds, std::move(clipFace));
+    })
+    .transform([&]() { return std::move(brush); });
+}
+
+/**
+ * Replaces the given clipped brush node with a node for the given brush, unless the
+ * node already contains an identical brush. Only replaced nodes are updated in the
+ * given renderer.
+ */
+void updateClippedBrush(
+  std::unique_ptr<Model::BrushNode>& node,
+  std::optional<Model::Brush> brush,
+  Renderer::BrushRenderer& renderer)
+{
+  if (node && brush && node->brush() == *brush)
+  {
+    return;
+  }
+
+  if (node)
+  {
+    renderer.removeBrush(node.get());
+    node.reset();
+  }
+
+  if (brush)
+  {
+    node = std::make_unique<Model::BrushNode>(std::move(*brush));
+    renderer.addBrush(node.get());
+  }
+}
+} // namespace
+
+struct ClipTool::ClipResult
+{
+  std::optional<Model::Brush> front;
+  std::optional<Model::Brush> back;
+  std::vector<std::string> errors;
+};
+
+/**
+ * Clips copies of the selected brushes. The inputs are copied when the task is created,
+ * so the clipping itself does not access the document and can run on any thread. Brushes
+ * are clipped in parallel.
+ */
+struct ClipTool::ClipTask
+{
+  std::vector<Model::BrushNode*> sourceNodes;
+  bool hasClipPlane = false;
+  std::atomic<bool> cancelled = false;
+  std::future<std::vector<ClipResult>> results;
+
+  ClipTask(const MapDocument& document, const ClipStrategy* strategy, std::launch policy)
+    : sourceNodes{document.selectedNodes().brushes()}
+  {
+    auto brushes =
+      kdl::vec_transform(sourceNodes, [](const auto* node) { return node->brush(); });
+
+    auto points = std::optional<std::tuple<vm::vec3, vm::vec3, vm::vec3>>{};
+    if (strategy != nullptr && strategy->canClip())
+    {
+      vm::vec3 point1, point2, point3;
+      const auto numPoints = strategy->getPoints(point1, point2, point3);
+      ensure(numPoints == 3, "invalid number of points");
+      points = {point1, point2, point3};
+    }
+    hasClipPlane = points.has_value();
+
+    results = std::async(
+      policy,
+      [&cancelled = cancelled,
+       brushes = std::move(brushes),
+       points,
+       attributes = Model::BrushFaceAttributes{document.currentTextureName()},
+       mapFormat = document.world()->mapFormat(),
+       worldBounds = document.worldBounds()]() mutable {
+        return kdl::vec_parallel_transform(std::move(brushes), [&](Model::Brush brush) {
+          auto result = ClipResult{};
+          if (cancelled)
+          {
+            return result;
+          }
+
+          if (!points)
+          {
+            result.front = std::move(brush);
+            return result;
+          }
+
+          const auto& [point1, point2, point3] = *points;
+          const auto clip = [&](const auto& p1, const auto& p2, const auto& p3) {
+            return clipBrush(brush, p1, p2, p3, attributes, mapFormat, worldBounds)
+              .transform([](Model::Brush&& clippedBrush) {
+                return std::optional{std::move(clippedBrush)};
+              })
+              .transform_error([&](auto e) {
+                result.errors.push_back(std::move(e.msg));
+                return std::optional<Model::Brush>{};
+              })
+              .value();
+          };
+
+          result.front = clip(point1, point2, point3);
+          result.back = clip(point1, point3, point2);
+          return result;
+        });
+      });
+  }
+};
+
 ClipTool::ClipTool(std::weak_ptr<MapDocument> document)
   : Tool(false)
   , m_document(std::move(document))
   , m_clipSide(ClipSide_Front)
   , m_strategy(nullptr)
+  , m_hasClipPlane(false)
+  , m_clipTaskOutdated(false)
   , m_remainingBrushRenderer(std::make_unique<Renderer::BrushRenderer>())
   , m_clippedBrushRenderer(std::make_unique<Renderer::BrushRenderer>())
   , m_ignoreNotifications(false)
@@ -663,8 +828,7 @@ ClipTool::ClipTool(std::weak_ptr<MapDocument> document)
 
 ClipTool::~ClipTool()
 {
-  kdl::map_clear_and_delete(m_frontBrushes);
-  kdl::map_clear_and_delete(m_backBrushes);
+  cancelClipTask();
 }
 
 const Grid& ClipTool::grid() const
@@ -706,6 +870,7 @@ void ClipTool::render(
   Renderer::RenderBatch& renderBatch,
   const Model::PickResult& pickResult)
 {
+  finishClipTask();
   renderBrushes(renderContext, renderBatch);
   renderStrategy(renderContext, renderBatch, pickResult);
 }
@@ -795,29 +960,25 @@ void ClipTool::performClip()
 std::map<Model::Node*, std::vector<Model::Node*>> ClipTool::clipBrushes()
 {
   std::map<Model::Node*, std::vector<Model::Node*>> result;
-  if (!m_frontBrushes.empty())
+  if (keepFrontBrushes())
   {
-    if (keepFrontBrushes())
-    {
-      result = kdl::map_merge(result, m_frontBrushes);
-      m_frontBrushes.clear();
-    }
-    else
+    for (auto& clippedBrush : m_clippedBrushes)
     {
-      kdl::map_clear_and_delete(m_frontBrushes);
+      if (clippedBrush.front)
+      {
+        result[clippedBrush.source->parent()].push_back(clippedBrush.front.release());
+      }
     }
   }
 
-  if (!m_backBrushes.empty())
+  if (keepBackBrushes())
   {
-    if (keepBackBrushes())
+    for (auto& clippedBrush : m_clippedBrushes)
     {
-      result = kdl::map_merge(result, m_backBrushes);
-      m_backBrushes.clear();
-    }
-    else
-    {
-      kdl::map_clear_and_delete(m_backBrushes);
+      if (clippedBrush.back)
+      {
+        result[clippedBrush.source->parent()].push_back(clippedBrush.back.release());
+      }
     }
   }
 
@@ -908,7 +1069,7 @@ bool ClipTool::dragPoint(
   }
   else
   {
-    update();
+    updateAsync();
     return true;
   }
 }
@@ -919,7 +1080,7 @@ void ClipTool::endDragPoint()
   ensure(m_strategy != nullptr, "strategy is null");
   m_strategy->endDragPoint();
   m_dragging = false;
-  refreshViews();
+  update();
 }
 
 void ClipTool::cancelDragPoint()
@@ -928,7 +1089,7 @@ void ClipTool::cancelDragPoint()
   ensure(m_strategy != nullptr, "strategy is null");
   m_strategy->cancelDragPoint();
   m_dragging = false;
-  refreshViews();
+  update();
 }
 
 void ClipTool::setFace(const Model::BrushFaceHandle& faceHandle)
@@ -959,94 +1120,120 @@ void ClipTool::resetStrategy()
 
 void ClipTool::update()
 {
+  cancelClipTask();
+
   clearRenderers();
   clearBrushes();
-
   updateBrushes();
-  updateRenderers();
 
   refreshViews();
 }
 
-void ClipTool::clearBrushes()
+void ClipTool::updateAsync()
 {
-  kdl::map_clear_and_delete(m_frontBrushes);
-  kdl::map_clear_and_delete(m_backBrushes);
+  if (m_clipTask)
+  {
+    m_clipTask->cancelled = true;
+    m_clipTaskOutdated = true;
+  }
+  else
+  {
+    startClipTask();
+  }
+
+  refreshViews();
 }
 
-void ClipTool::updateBrushes()
+void ClipTool::startClipTask()
 {
   auto document = kdl::mem_lock(m_document);
+  m_clipTask =
+    std::make_unique<ClipTask>(*document, m_strategy.get(), std::launch::async);
+  m_clipTaskOutdated = false;
+}
 
-  const auto& brushNodes = document->selectedNodes().brushes();
-  const auto& worldBounds = document->worldBounds();
-
-  const auto clip =
-    [&](auto* node, const auto& p1, const auto& p2, const auto& p3, auto& brushMap) {
-      auto brush = node->brush();
-      Model::BrushFace::create(
-        p1,
-        p2,
-        p3,
-        Model::BrushFaceAttributes(document->currentTextureName()),
-        document->world()->mapFormat())
-        .and_then([&](Model::BrushFace&& clipFace) {
-          setFaceAttributes(brush.faces(), clipFace);
-          return brush.clip(worldBounds, std::move(clipFace));
-        })
-        .transform([&]() {
-          brushMap[node->parent()].push_back(new Model::BrushNode(std::move(brush)));
-        })
-        .transform_error(
-          [&](auto e) { document->error() << "Could not clip brush: " << e.msg; });
-    };
+void ClipTool::finishClipTask()
+{
+  using namespace std::chrono_literals;
 
-  if (canClip())
+  if (!m_clipTask)
   {
-    vm::vec3 point1, point2, point3;
-    const auto numPoints = m_strategy->getPoints(point1, point2, point3);
-    ensure(numPoints == 3, "invalid number of points");
+    return;
+  }
 
-    for (auto* brushNode : brushNodes)
+  if (m_clipTask->results.wait_for(0s) == std::future_status::ready)
+  {
+    auto task = std::move(m_clipTask);
+    if (m_clipTaskOutdated)
     {
-      clip(brushNode, point1, point2, point3, m_frontBrushes);
-      clip(brushNode, point1, point3, point2, m_backBrushes);
+      // the clip plane has changed since the task was started, drop its results
+      startClipTask();
     }
-  }
-  else
-  {
-    for (auto* brushNode : brushNodes)
+    else
     {
-      auto* parent = brushNode->parent();
-      m_frontBrushes[parent].push_back(new Model::BrushNode(brushNode->brush()));
+      applyClipResults(*task);
     }
   }
+
+  // keep polling until the current clip plane has been applied
+  refreshViews();
+}
+
+void ClipTool::cancelClipTask()
+{
+  if (m_clipTask)
+  {
+    m_clipTask->cancelled = true;
+    m_clipTask.reset();
+  }
+  m_clipTaskOutdated = false;
 }
 
-void ClipTool::setFaceAttributes(
-  const std::vector<Model::BrushFace>& faces, Model::BrushFace& toSet) const
+void ClipTool::clearBrushes()
 {
-  ensure(!faces.empty(), "no faces");
+  m_clippedBrushes.clear();
+}
 
-  auto faceIt = std::begin(faces);
-  auto faceEnd = std::end(faces);
-  auto bestMatch = faceIt++;
+void ClipTool::updateBrushes()
+{
+  auto document = kdl::mem_lock(m_document);
+  auto task = ClipTask{*document, m_strategy.get(), std::launch::deferred};
+  applyClipResults(task);
+}
 
-  while (faceIt != faceEnd)
+void ClipTool::applyClipResults(ClipTask& task)
+{
+  auto document = kdl::mem_lock(m_document);
+  auto results = task.results.get();
+
+  // reuse the existing nodes only if they were created for the same brushes and were
+  // added to the same renderers
+  if (
+    task.hasClipPlane != m_hasClipPlane
+    || task.sourceNodes
+         != kdl::vec_transform(m_clippedBrushes, [](const auto& c) { return c.source; }))
   {
-    const auto& face = *faceIt;
+    clearRenderers();
+    clearBrushes();
+  }
 
-    const auto bestDiff = bestMatch->boundary().normal - toSet.boundary().normal;
-    const auto curDiff = face.boundary().normal - toSet.boundary().normal;
-    if (vm::squared_length(curDiff) < vm::squared_length(bestDiff))
+  m_hasClipPlane = task.hasClipPlane;
+  m_clippedBrushes.resize(task.sourceNodes.size());
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    auto& clippedBrush = m_clippedBrushes[i];
+    auto& result = results[i];
+
+    clippedBrush.source = task.sourceNodes[i];
+    updateClippedBrush(clippedBrush.front, std::move(result.front), frontBrushRenderer());
+    updateClippedBrush(clippedBrush.back, std::move(result.back), backBrushRenderer());
+
+    for (const auto& error : result.errors)
     {
-      bestMatch = faceIt;
+      document->error() << "Could not clip brush: " << error;
     }
-
-    ++faceIt;
   }
-
-  toSet.setAttributes(*bestMatch);
 }
 
 void ClipTool::clearRenderers()
@@ -1055,52 +1242,16 @@ void ClipTool::clearRenderers()
   m_clippedBrushRenderer->clear();
 }
 
-void ClipTool::updateRenderers()
+Renderer::BrushRenderer& ClipTool::frontBrushRenderer()
 {
-  if (canClip())
-  {
-    if (keepFrontBrushes())
-    {
-      addBrushesToRenderer(m_frontBrushes, *m_remainingBrushRenderer);
-    }
-    else
-    {
-      addBrushesToRenderer(m_frontBrushes, *m_clippedBrushRenderer);
-    }
-
-    if (keepBackBrushes())
-    {
-      addBrushesToRenderer(m_backBrushes, *m_remainingBrushRenderer);
-    }
-    else
-    {
-      addBrushesToRenderer(m_backBrushes, *m_clippedBrushRenderer);
-    }
-  }
-  else
-  {
-    addBrushesToRenderer(m_frontBrushes, *m_remainingBrushRenderer);
-    addBrushesToRenderer(m_backBrushes, *m_remainingBrushRenderer);
-  }
+  return !m_hasClipPlane || keepFrontBrushes() ? *m_remainingBrushRenderer
+                                               : *m_clippedBrushRenderer;
 }
 
-void ClipTool::addBrushesToRenderer(
-  const std::map<Model::Node*, std::vector<Model::Node*>>& map,
-  Renderer::BrushRenderer& renderer)
+Renderer::BrushRenderer& ClipTool::backBrushRenderer()
 {
-  for (const auto& [parent, nodes] : map)
-  {
-    for (auto* node : nodes)
-    {
-      node->accept(kdl::overload(
-        [](const Model::WorldNode*) {},
-        [](const Model::LayerNode*) {},
-        [](const Model::GroupNode*) {},
-        [](const Model::EntityNode*) {},
-        [&](Model::BrushNode* brush) { renderer.addBrush(brush); },
-        [](Model::PatchNode*) {}));
-    }
-  }
+  return !m_hasClipPlane || keepBackBrushes() ? *m_remainingBrushRenderer
+                                              : *m_clippedBrushRenderer;
 }
 
 bool ClipTool::keepFrontBrushes() const
@@ -1132,6 +1283,7 @@ bool ClipTool::doDeactivate()
 {
   m_notifierConnection.disconnect();
 
+  cancelClipTask();
   m_strategy.reset();
   clearRenderers();
   clearBrushes();
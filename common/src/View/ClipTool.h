@@ -33,8 +33,10 @@ namespace TrenchBroom
 {
 namespace Model
 {
+class Brush;
 class BrushFace;
 class BrushFaceHandle;
+class BrushNode;
 class Node;
 class PickResult;
 } // namespace Model
@@ -153,8 +155,32 @@ private:
   ClipSide m_clipSide;
   std::unique_ptr<ClipStrategy> m_strategy;
 
-  std::map<Model::Node*, std::vector<Model::Node*>> m_frontBrushes;
-  std::map<Model::Node*, std::vector<Model::Node*>> m_backBrushes;
+  /**
+   * The parts of a selected brush that lie in front of and behind the clip plane. A part
+   * is null if the brush lies entirely on the other side of the clip plane. If no clip
+   * plane is set, the front part is a copy of the selected brush.
+   */
+  struct ClippedBrush
+  {
+    Model::BrushNode* source;
+    std::unique_ptr<Model::BrushNode> front;
+    std::unique_ptr<Model::BrushNode> back;
+  };
+
+  struct ClipResult;
+  struct ClipTask;
+
+  std::vector<ClippedBrush> m_clippedBrushes;
+  bool m_hasClipPlane;
+
+  /**
+   * While a clip point is dragged, the brushes are clipped by this task on worker
+   * threads. If the clip plane changes while the task is running, the task is cancelled
+   * and marked as outdated; its results are then dropped and a new task is started once
+   * it finishes.
+   */
+  std::unique_ptr<ClipTask> m_clipTask;
+  bool m_clipTaskOutdated;
 
   std::unique_ptr<Renderer::BrushRenderer> m_remainingBrushRenderer;
   std::unique_ptr<Renderer::BrushRenderer> m_clippedBrushRenderer;
@@ -226,18 +252,19 @@ public:
 private:
   void resetStrategy();
   void update();
+  void updateAsync();
+
+  void startClipTask();
+  void finishClipTask();
+  void cancelClipTask();
 
   void clearBrushes();
   void updateBrushes();
-
-  void setFaceAttributes(
-    const std::vector<Model::BrushFace>& faces, Model::BrushFace& toSet) const;
+  void applyClipResults(ClipTask& task);
 
   void clearRenderers();
-  void updateRenderers();
-  void addBrushesToRenderer(
-    const std::map<Model::Node*, std::vector<Model::Node*>>& map,
-    Renderer::BrushRenderer& renderer);
+  Renderer::BrushRenderer& frontBrushRenderer();
+  Renderer::BrushRenderer& backBrushRenderer();
 
   bool keepFrontBrushes() const;
   bool keepBackBrushes() const;
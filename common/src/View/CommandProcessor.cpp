@@ -23,6 +23,7 @@
 
 #include "Exceptions.h"
 #include "Notifier.h"
+#include "Trace.h"
 #include "View/Command.h"
 #include "View/TransactionScope.h"
 #include "View/UndoableCommand.h"
@@ -32,6 +33,7 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <limits>
 
 namespace TrenchBroom
 {
@@ -59,6 +61,18 @@ struct CommandProcessor::TransactionState
   }
 };
 
+struct CommandProcessor::StoredCommand
+{
+  std::unique_ptr<UndoableCommand> command;
+  size_t memorySize;
+
+  explicit StoredCommand(std::unique_ptr<UndoableCommand> i_command)
+    : command{std::move(i_command)}
+    , memorySize{command->memorySize()}
+  {
+  }
+};
+
 struct CommandProcessor::SubmitAndStoreResult
 {
   std::unique_ptr<CommandResult> commandResult;
@@ -99,6 +113,16 @@ public:
   {
   }
 
+  size_t memorySize() const override
+  {
+    auto result = UndoableCommand::memorySize();
+    for (const auto& command : m_commands)
+    {
+      result += command->memorySize();
+    }
+    return result;
+  }
+
 private:
   std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override
   {
@@ -163,6 +187,8 @@ CommandProcessor::CommandProcessor(
   MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval)
   : m_document{document}
   , m_collationInterval{collationInterval}
+  , m_undoStackMemorySize{0}
+  , m_memoryBudget{std::numeric_limits<size_t>::max()}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -187,7 +213,7 @@ const std::string& CommandProcessor::undoCommandName() const
   }
   else
   {
-    return m_undoStack.back()->name();
+    return m_undoStack.back().command->name();
   }
 }
 
@@ -203,6 +229,17 @@ const std::string& CommandProcessor::redoCommandName() const
   }
 }
 
+size_t CommandProcessor::undoStackMemorySize() const
+{
+  return m_undoStackMemorySize;
+}
+
+void CommandProcessor::setMemoryBudget(const size_t memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  enforceMemoryBudget();
+}
+
 void CommandProcessor::startTransaction(std::string name, const TransactionScope scope)
 {
   m_transactionStack.emplace_back(std::move(name), scope);
@@ -244,12 +281,18 @@ bool CommandProcessor::isCurrentDocumentStateObservable() const
               == TransactionScope::LongRunning;
 }
 
+bool CommandProcessor::isTransactionRunning() const
+{
+  return !m_transactionStack.empty();
+}
+
 std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command> command)
 {
   auto result = executeCommand(*command);
   if (result->success())
   {
     m_undoStack.clear();
+    m_undoStackMemorySize = 0;
     m_redoStack.clear();
   }
   return result;
@@ -312,6 +355,7 @@ void CommandProcessor::clear()
   assert(m_transactionStack.empty());
 
   m_undoStack.clear();
+  m_undoStackMemorySize = 0;
   m_redoStack.clear();
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
@@ -332,6 +376,8 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
 
 std::unique_ptr<CommandResult> CommandProcessor::executeCommand(Command& command)
 {
+  traceZone("Execute " + command.name());
+
   notifyCommandIfNotType<TransactionCommand>(commandDoNotifier, command);
   auto result = command.performDo(m_document);
   if (result->success())
@@ -351,6 +397,8 @@ std::unique_ptr<CommandResult> CommandProcessor::executeCommand(Command& command
 
 std::unique_ptr<CommandResult> CommandProcessor::undoCommand(UndoableCommand& command)
 {
+  traceZone("Undo " + command.name());
+
   notifyCommandIfNotType<TransactionCommand>(commandUndoNotifier, command);
   auto result = command.performUndo(m_document);
   if (result->success())
@@ -443,13 +491,20 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
-    if (lastCommand->collateWith(*command))
+    if (lastCommand.command->collateWith(*command))
     {
+      // the collated command may have grown, so its memory size must be recomputed
+      m_undoStackMemorySize -= lastCommand.memorySize;
+      lastCommand.memorySize = lastCommand.command->memorySize();
+      m_undoStackMemorySize += lastCommand.memorySize;
+      enforceMemoryBudget();
       return false;
     }
   }
 
-  m_undoStack.push_back(std::move(command));
+  m_undoStack.emplace_back(std::move(command));
+  m_undoStackMemorySize += m_undoStack.back().memorySize;
+  enforceMemoryBudget();
   return true;
 }
 
@@ -458,7 +513,25 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   assert(m_transactionStack.empty());
   assert(!m_undoStack.empty());
 
-  return kdl::vec_pop_back(m_undoStack);
+  auto storedCommand = kdl::vec_pop_back(m_undoStack);
+  m_undoStackMemorySize -= storedCommand.memorySize;
+  return std::move(storedCommand.command);
+}
+
+void CommandProcessor::enforceMemoryBudget()
+{
+  auto count = size_t(0);
+  while (m_undoStack.size() - count > 1 && m_undoStackMemorySize > m_memoryBudget)
+  {
+    m_undoStackMemorySize -= m_undoStack[count].memorySize;
+    ++count;
+  }
+
+  if (count > 0)
+  {
+    m_undoStack.erase(
+      m_undoStack.begin(), m_undoStack.begin() + static_cast<std::ptrdiff_t>(count));
+  }
 }
 
 bool CommandProcessor::collatable(
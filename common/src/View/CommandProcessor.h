@@ -53,6 +53,11 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory used by the undo stack can be limited by setting a memory budget. The
+ * memory used by each command is estimated when it is stored, and when the undo stack
+ * exceeds the budget, the oldest commands are discarded until it fits again. The most
+ * recently executed command is always kept.
  */
 class CommandProcessor
 {
@@ -67,11 +72,23 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  struct StoredCommand;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
    */
-  std::vector<std::unique_ptr<UndoableCommand>> m_undoStack;
+  std::vector<StoredCommand> m_undoStack;
+
+  /**
+   * The estimated number of bytes of memory used by the commands on the undo stack.
+   */
+  size_t m_undoStackMemorySize;
+
+  /**
+   * The maximum number of bytes of memory that the commands on the undo stack may use.
+   */
+  size_t m_memoryBudget;
 
   /**
    * Holds the commands that were undone, with the most recently undone command at the
@@ -168,6 +185,19 @@ public:
    */
   const std::string& redoCommandName() const;
 
+  /**
+   * Returns the estimated number of bytes of memory used by the commands on the undo
+   * stack.
+   */
+  size_t undoStackMemorySize() const;
+
+  /**
+   * Sets the maximum number of bytes of memory that the commands on the undo stack may
+   * use. If the undo stack exceeds the given budget, the oldest commands are discarded
+   * immediately.
+   */
+  void setMemoryBudget(size_t memoryBudget);
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -209,6 +239,11 @@ public:
    */
   bool isCurrentDocumentStateObservable() const;
 
+  /**
+   * Indicates whether a transaction is currently executing.
+   */
+  bool isTransactionRunning() const;
+
   /**
    * Executes the given command by calling its `performDo` method without storing it for
    * later undo. If the command is executed successfully, both the undo and the redo
@@ -374,6 +409,12 @@ private:
    */
   std::unique_ptr<UndoableCommand> popFromUndoStack();
 
+  /**
+   * Discards the oldest commands on the undo stack until its estimated memory use does
+   * not exceed the memory budget anymore. The topmost command is never discarded.
+   */
+  void enforceMemoryBudget();
+
   bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
   /**
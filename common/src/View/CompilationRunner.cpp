@@ -27,7 +27,6 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
-#include "IO/ExportOptions.h"
 #include "IO/PathInfo.h"
 #include "IO/PathMatcher.h"
 #include "IO/PathQt.h"
@@ -45,6 +44,7 @@
 #include <kdl/vector_utils.h>
 
 #include <filesystem>
+#include <sstream>
 #include <string>
 
 namespace TrenchBroom::View
@@ -98,17 +98,25 @@ void CompilationExportMapTaskRunner::doExecute()
 
   if (!m_context.test())
   {
-    IO::Disk::createDirectory(targetPath.parent_path())
-      .and_then([&](auto) {
-        const auto options = IO::MapExportOptions{targetPath};
-        const auto document = m_context.document();
-        return document->exportDocumentAs(options);
-      })
-      .transform([&]() { emit end(); })
-      .transform_error([&](auto e) {
-        m_context << "#### Could not export map file '" << IO::pathAsQString(targetPath)
-                  << "': " << QString::fromStdString(e.msg) << "\n";
-        emit error();
+    // serializing the document must happen on this thread, but writing the file only
+    // needs the serialized map, so it is done on a worker thread to keep the UI
+    // responsive while large maps are written
+    auto stream = std::ostringstream{};
+    m_context.document()->exportDocumentTo(stream);
+
+    m_pendingExport = std::async(
+      std::launch::async,
+      [this, targetPath, mapContents = stream.str()]() {
+        auto result =
+          IO::Disk::createDirectory(targetPath.parent_path()).and_then([&](auto) {
+            return IO::Disk::withOutputStream(
+              targetPath, [&](auto& targetStream) { targetStream << mapContents; });
+          });
+
+        // the queued call is discarded if this runner is destroyed in the meantime
+        QMetaObject::invokeMethod(
+          this, [this, targetPath]() { finishExport(targetPath); }, Qt::QueuedConnection);
+        return result;
       });
   }
   else
@@ -119,6 +127,17 @@ void CompilationExportMapTaskRunner::doExecute()
 
 void CompilationExportMapTaskRunner::doTerminate() {}
 
+void CompilationExportMapTaskRunner::finishExport(const std::filesystem::path& targetPath)
+{
+  m_pendingExport.get()
+    .transform([&]() { emit end(); })
+    .transform_error([&](auto e) {
+      m_context << "#### Could not export map file '" << IO::pathAsQString(targetPath)
+                << "': " << QString::fromStdString(e.msg) << "\n";
+      emit error();
+    });
+}
+
 CompilationCopyFilesTaskRunner::CompilationCopyFilesTaskRunner(
   CompilationContext& context, Model::CompilationCopyFiles task)
   : CompilationTaskRunner{context}
@@ -23,9 +23,12 @@
 #include <QProcess> // for QProcess::ProcessError
 
 #include "Macros.h"
+#include "Result.h"
 #include "Model/CompilationTask.h"
 #include "View/CompilationContext.h"
 
+#include <filesystem>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -73,6 +76,11 @@ class CompilationExportMapTaskRunner : public CompilationTaskRunner
   Q_OBJECT
 private:
   Model::CompilationExportMap m_task;
+  /**
+   * Writes the serialized map to the target file on a worker thread. Destroying the
+   * future waits for the thread to finish.
+   */
+  std::future<Result<void>> m_pendingExport;
 
 public:
   CompilationExportMapTaskRunner(
@@ -83,6 +91,8 @@ private:
   void doExecute() override;
   void doTerminate() override;
 
+  void finishExport(const std::filesystem::path& targetPath);
+
   deleteCopyAndMove(CompilationExportMapTaskRunner);
 };
 
@@ -22,11 +22,13 @@
 #include <QDebug>
 #include <QScrollBar>
 #include <QTextEdit>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include "FileLogger.h"
 #include "View/ViewConstants.h"
 
+#include <array>
 #include <string>
 
 namespace TrenchBroom
@@ -39,6 +41,7 @@ Console::Console(QWidget* parent)
   m_textView = new QTextEdit();
   m_textView->setReadOnly(true);
   m_textView->setWordWrapMode(QTextOption::NoWrap);
+  m_textView->document()->setMaximumBlockCount(MaxLineCount);
 
   QVBoxLayout* sizer = new QVBoxLayout();
   sizer->setContentsMargins(0, 0, 0, 0);
@@ -67,6 +70,44 @@ void Console::logToDebugOut(const LogLevel /* level */, const QString& message)
 }
 
 void Console::logToConsole(const LogLevel level, const QString& message)
+{
+  // Messages are appended to the text view once per event loop iteration, so that many
+  // messages logged at once, e.g. parser warnings, don't each cause a document update.
+  if (m_pendingMessages.empty())
+  {
+    QTimer::singleShot(0, this, [this]() { appendPendingMessages(); });
+  }
+  m_pendingMessages.push_back({level, message});
+}
+
+void Console::appendPendingMessages()
+{
+  if (m_pendingMessages.empty())
+  {
+    return;
+  }
+
+  const auto formats = std::array<QTextCharFormat, 4>{
+    format(LogLevel::Debug),
+    format(LogLevel::Info),
+    format(LogLevel::Warn),
+    format(LogLevel::Error)};
+
+  QTextCursor cursor(m_textView->document());
+  cursor.movePosition(QTextCursor::MoveOperation::End);
+  cursor.beginEditBlock();
+  for (const auto& [level, message] : m_pendingMessages)
+  {
+    cursor.insertText(message, formats[static_cast<size_t>(level)]);
+    cursor.insertText("\n");
+  }
+  cursor.endEditBlock();
+  m_pendingMessages.clear();
+
+  m_textView->moveCursor(QTextCursor::MoveOperation::End);
+}
+
+QTextCharFormat Console::format(const LogLevel level) const
 {
   // NOTE: QPalette::Text is the correct color role for contrast against QPalette::Base
   // which is the background of text entry widgets
@@ -88,13 +129,7 @@ void Console::logToConsole(const LogLevel level, const QString& message)
     break;
   }
   format.setFont(Fonts::fixedWidthFont());
-
-  QTextCursor cursor(m_textView->document());
-  cursor.movePosition(QTextCursor::MoveOperation::End);
-  cursor.insertText(message, format);
-  cursor.insertText("\n");
-
-  m_textView->moveCursor(QTextCursor::MoveOperation::End);
+  return format;
 }
 } // namespace View
 } // namespace TrenchBroom
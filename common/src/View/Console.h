@@ -22,10 +22,13 @@
 #include "Logger.h"
 #include "View/TabBook.h"
 
+#include <QString>
+
 #include <string>
+#include <vector>
 
+class QTextCharFormat;
 class QTextEdit;
-class QString;
 class QWidget;
 
 namespace TrenchBroom
@@ -34,8 +37,21 @@ namespace View
 {
 class Console : public TabBookPage, public Logger
 {
+public:
+  /**
+   * The maximum number of lines kept in the console, older lines are removed.
+   */
+  static constexpr int MaxLineCount = 10000;
+
 private:
+  struct PendingMessage
+  {
+    LogLevel level;
+    QString message;
+  };
+
   QTextEdit* m_textView;
+  std::vector<PendingMessage> m_pendingMessages;
 
 public:
   explicit Console(QWidget* parent = nullptr);
@@ -45,6 +61,8 @@ private:
   void doLog(LogLevel level, const QString& message) override;
   void logToDebugOut(LogLevel level, const QString& message);
   void logToConsole(LogLevel level, const QString& message);
+  void appendPendingMessages();
+  QTextCharFormat format(LogLevel level) const;
 };
 } // namespace View
 } // namespace TrenchBroom
@@ -281,10 +281,13 @@ void ControlListBox::reload()
   const auto count = itemCount();
   if (count > 0)
   {
+    // don't lay out and repaint the list after every added item
+    m_listWidget->setUpdatesEnabled(false);
     for (size_t i = 0; i < count; ++i)
     {
       addItemRenderer(createItemRenderer(m_listWidget, i));
     }
+    m_listWidget->setUpdatesEnabled(true);
     m_listWidget->show();
     m_emptyTextContainer->hide();
   }
@@ -357,13 +360,8 @@ void ControlListBox::addItemRenderer(ControlListBoxItemRenderer* renderer)
     this,
     &ControlListBox::doubleClicked);
 
+  // constructing the item with the list widget as its parent already appends it
   auto* widgetItem = new QListWidgetItem(m_listWidget);
-  m_listWidget->addItem(widgetItem);
-
-  if (m_listWidget->itemWidget(widgetItem) != nullptr)
-  {
-    m_listWidget->removeItemWidget(widgetItem);
-  }
 
   auto* wrapper = new ControlListBoxItemRendererWrapper(renderer, m_showSeparator);
 
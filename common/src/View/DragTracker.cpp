@@ -36,6 +36,11 @@ void DragTracker::modifierKeyChange(const InputState&) {}
 
 void DragTracker::mouseScroll(const InputState&) {}
 
+bool DragTracker::usesPickResult() const
+{
+  return true;
+}
+
 void DragTracker::setRenderOptions(const InputState&, Renderer::RenderContext&) const {}
 
 void DragTracker::render(
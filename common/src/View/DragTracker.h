@@ -50,6 +50,12 @@ public:
    */
   virtual void mouseScroll(const InputState& inputState);
 
+  /**
+   * Returns whether this tracker inspects the pick result while dragging. If it does not,
+   * the pick result is not updated until the drag ends.
+   */
+  virtual bool usesPickResult() const;
+
   /**
    * Called when a drag took place. This does not always have to correspond to a mouse
    * movement; sometimes these events are synthesized.
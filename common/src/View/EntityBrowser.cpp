@@ -68,8 +68,7 @@ void EntityBrowser::reload()
     m_view->setDefaultModelScaleExpression(
       document->world()->entityPropertyConfig().defaultModelScaleExpression);
 
-    m_view->invalidate();
-    m_view->update();
+    m_view->reload();
   }
 }
 
@@ -160,8 +159,10 @@ void EntityBrowser::connectObservers()
     document->modsDidChangeNotifier.connect(this, &EntityBrowser::modsDidChange);
   m_notifierConnection += document->entityDefinitionsDidChangeNotifier.connect(
     this, &EntityBrowser::entityDefinitionsDidChange);
-  m_notifierConnection +=
-    document->nodesDidChangeNotifier.connect(this, &EntityBrowser::nodesDidChange);
+  m_notifierConnection += document->entityModelsDidChangeNotifier.connect(
+    this, &EntityBrowser::entityModelsDidChange);
+  m_notifierConnection += document->changeSetDidCommitNotifier.connect(
+    this, &EntityBrowser::changeSetDidCommit);
 
   PreferenceManager& prefs = PreferenceManager::instance();
   m_notifierConnection +=
@@ -183,10 +184,20 @@ void EntityBrowser::modsDidChange()
   reload();
 }
 
-void EntityBrowser::nodesDidChange(const std::vector<Model::Node*>&)
+void EntityBrowser::changeSetDidCommit(const DocumentChangeSet& changeSet)
 {
-  // to handle definition usage count changes
-  reload();
+  if (changeSet.changedNodes.empty())
+  {
+    return;
+  }
+
+  // to handle definition usage count changes, the models are unchanged so the rendered
+  // previews are kept
+  if (m_view != nullptr)
+  {
+    m_view->invalidate();
+    m_view->update();
+  }
 }
 
 void EntityBrowser::entityDefinitionsDidChange()
@@ -194,6 +205,11 @@ void EntityBrowser::entityDefinitionsDidChange()
   reload();
 }
 
+void EntityBrowser::entityModelsDidChange()
+{
+  reload();
+}
+
 void EntityBrowser::preferenceDidChange(const std::filesystem::path& path)
 {
   auto document = kdl::mem_lock(m_document);
@@ -34,13 +34,9 @@ class QScrollBar;
 
 namespace TrenchBroom
 {
-namespace Model
-{
-class Node;
-}
-
 namespace View
 {
+struct DocumentChangeSet;
 class EntityBrowserView;
 class GLContextManager;
 class MapDocument;
@@ -76,8 +72,9 @@ private:
   void documentWasLoaded(MapDocument* document);
 
   void modsDidChange();
-  void nodesDidChange(const std::vector<Model::Node*>& nodes);
+  void changeSetDidCommit(const DocumentChangeSet& changeSet);
   void entityDefinitionsDidChange();
+  void entityModelsDidChange();
   void preferenceDidChange(const std::filesystem::path& path);
 };
 } // namespace View
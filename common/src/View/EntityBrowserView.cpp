@@ -56,6 +56,7 @@
 #include <vecmath/quat.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -83,6 +84,9 @@ EntityBrowserView::EntityBrowserView(
 EntityBrowserView::~EntityBrowserView()
 {
   clear();
+
+  // deleting the preview atlas accesses its GL textures, so we need to be current
+  makeCurrent();
 }
 
 void EntityBrowserView::setDefaultModelScaleExpression(
@@ -131,6 +135,17 @@ void EntityBrowserView::setFilterText(const std::string& filterText)
   }
 }
 
+void EntityBrowserView::reload()
+{
+  m_previews.clear();
+  if (m_previewAtlas)
+  {
+    m_previewAtlas->freeSlots();
+  }
+  invalidate();
+  update();
+}
+
 void EntityBrowserView::doInitLayout(Layout& layout)
 {
   layout.setOuterMargin(5.0f);
@@ -315,30 +330,24 @@ void EntityBrowserView::renderBounds(Layout& layout, const float y, const float
   using BoundsVertex = Renderer::GLVertexTypes::P3C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto* definition = cellData(cell).entityDefinition;
+        auto* modelRenderer = cellData(cell).modelRenderer;
+
+        if (modelRenderer == nullptr)
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto* definition = cellData(cell).entityDefinition;
-            auto* modelRenderer = cellData(cell).modelRenderer;
-
-            if (modelRenderer == nullptr)
-            {
-              const auto itemTrans = itemTransformation(cell, y, height, false);
-              const auto& color = definition->color();
-              vm::bbox3f{definition->bounds()}.for_each_edge(
-                [&](const vm::vec3f& v1, const vm::vec3f& v2) {
-                  vertices.emplace_back(itemTrans * v1, color);
-                  vertices.emplace_back(itemTrans * v2, color);
-                });
-            }
-          }
+          const auto itemTrans = itemTransformation(cell, y, height, false);
+          const auto& color = definition->color();
+          vm::bbox3f{definition->bounds()}.for_each_edge(
+            [&](const vm::vec3f& v1, const vm::vec3f& v2) {
+              vertices.emplace_back(itemTrans * v1, color);
+              vertices.emplace_back(itemTrans * v2, color);
+            });
         }
       }
     }
@@ -362,40 +371,120 @@ void EntityBrowserView::renderModels(
 
   m_entityModelManager.prepare(vboManager());
 
+  if (!Renderer::PreviewAtlas::isSupported())
+  {
+    renderModelsDirectly(layout, y, height, transformation);
+    return;
+  }
+
+  updateModelPreviews(layout, y, height, transformation);
+  renderModelPreviews(layout, y, height);
+}
+
+void EntityBrowserView::renderModelsDirectly(
+  Layout& layout,
+  const float y,
+  const float height,
+  Renderer::Transformation& transformation)
+{
   auto shader =
     Renderer::ActiveShader{shaderManager(), Renderer::Shaders::EntityModelShader};
-  shader.set("ApplyTinting", false);
-  shader.set("Brightness", pref(Preferences::Brightness));
-  shader.set("GrayScale", false);
+  setupModelShader(shader, transformation, pref(Preferences::Brightness));
 
-  shader.set("CameraPosition", CameraPosition);
-  shader.set("CameraDirection", CameraDirection);
-  shader.set("CameraRight", vm::cross(CameraDirection, CameraUp));
-  shader.set("CameraUp", CameraUp);
-  shader.set("ViewMatrix", transformation.viewMatrix());
+  for (const auto& group : layout.groupsIntersectingY(y, height))
+  {
+    for (const auto& row : group.rowsIntersectingY(y, height))
+    {
+      for (const auto& cell : row.cells())
+      {
+        if (auto* modelRenderer = cellData(cell).modelRenderer)
+        {
+          shader.set("Orientation", static_cast<int>(cellData(cell).modelOrientation));
+
+          const auto itemTrans = itemTransformation(cell, y, height, true);
+          shader.set("ModelMatrix", itemTrans);
 
-  for (const auto& group : layout.groups())
+          const auto multMatrix =
+            Renderer::MultiplyModelMatrix{transformation, itemTrans};
+          modelRenderer->render();
+        }
+      }
+    }
+  }
+}
+
+void EntityBrowserView::updateModelPreviews(
+  Layout& layout,
+  const float y,
+  const float height,
+  Renderer::Transformation& transformation)
+{
+  const auto dpiScale = static_cast<float>(devicePixelRatioF());
+  const auto slotWidth = static_cast<size_t>(vm::ceil(layout.maxCellWidth() * dpiScale));
+  const auto slotHeight =
+    static_cast<size_t>(vm::ceil(layout.maxCellHeight() * dpiScale));
+
+  if (
+    !m_previewAtlas || m_previewAtlas->slotWidth() != slotWidth
+    || m_previewAtlas->slotHeight() != slotHeight)
+  {
+    m_previews.clear();
+    m_previewAtlas = std::make_unique<Renderer::PreviewAtlas>(slotWidth, slotHeight);
+  }
+
+  // the previews are rendered without brightness, it is applied when they are drawn
+  auto shader =
+    Renderer::ActiveShader{shaderManager(), Renderer::Shaders::EntityModelShader};
+  setupModelShader(shader, transformation, 1.0f);
+
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto& cellData = this->cellData(cell);
+        if (auto* modelRenderer = cellData.modelRenderer)
         {
-          for (const auto& cell : row.cells())
+          const auto& bounds = cell.itemBounds();
+          const auto previewWidth = std::min(
+            static_cast<size_t>(vm::round(bounds.width * dpiScale)), slotWidth);
+          const auto previewHeight = std::min(
+            static_cast<size_t>(vm::round(bounds.height * dpiScale)), slotHeight);
+
+          auto [it, inserted] = m_previews.try_emplace(
+            cellData.entityDefinition, EntityPreview{{}, nullptr, 0, 0});
+          auto& preview = it->second;
+          if (inserted)
+          {
+            preview.slot = m_previewAtlas->allocateSlot();
+          }
+
+          if (
+            preview.modelRenderer != modelRenderer || preview.width != previewWidth
+            || preview.height != previewHeight)
           {
-            if (auto* modelRenderer = cellData(cell).modelRenderer)
-            {
-              shader.set(
-                "Orientation", static_cast<int>(cellData(cell).modelOrientation));
-
-              const auto itemTrans = itemTransformation(cell, y, height, true);
-              shader.set("ModelMatrix", itemTrans);
-
-              const auto multMatrix =
-                Renderer::MultiplyModelMatrix{transformation, itemTrans};
-              modelRenderer->render();
-            }
+            const auto projection = vm::ortho_matrix(
+              -1024.0f, 1024.0f, 0.0f, bounds.height, bounds.width, 0.0f);
+            const auto modelTrans = modelTransformation(cell, true);
+
+            m_previewAtlas->render(
+              preview.slot,
+              previewWidth,
+              previewHeight,
+              defaultFramebufferObject(),
+              [&]() {
+                shader.set("Orientation", static_cast<int>(cellData.modelOrientation));
+                shader.set("ModelMatrix", modelTrans);
+
+                const auto replaceTransformation = Renderer::ReplaceTransformation{
+                  transformation, projection, transformation.viewMatrix(), modelTrans};
+                modelRenderer->render();
+              });
+
+            preview.modelRenderer = modelRenderer;
+            preview.width = previewWidth;
+            preview.height = previewHeight;
           }
         }
       }
@@ -403,6 +492,81 @@ void EntityBrowserView::renderModels(
   }
 }
 
+void EntityBrowserView::renderModelPreviews(
+  Layout& layout, const float y, const float height)
+{
+  using PreviewVertex = Renderer::GLVertexTypes::P2T2::Vertex;
+  auto verticesByPage = std::map<size_t, std::vector<PreviewVertex>>{};
+
+  for (const auto& group : layout.groupsIntersectingY(y, height))
+  {
+    for (const auto& row : group.rowsIntersectingY(y, height))
+    {
+      for (const auto& cell : row.cells())
+      {
+        const auto it = m_previews.find(cellData(cell).entityDefinition);
+        if (it != m_previews.end())
+        {
+          const auto& preview = it->second;
+          const auto& bounds = cell.itemBounds();
+          const auto texCoords =
+            m_previewAtlas->texCoords(preview.slot, preview.width, preview.height);
+
+          auto& vertices = verticesByPage[preview.slot.page];
+          vertices.emplace_back(
+            vm::vec2f{bounds.left(), height - (bounds.top() - y)}, texCoords[0]);
+          vertices.emplace_back(
+            vm::vec2f{bounds.left(), height - (bounds.bottom() - y)}, texCoords[1]);
+          vertices.emplace_back(
+            vm::vec2f{bounds.right(), height - (bounds.bottom() - y)}, texCoords[2]);
+          vertices.emplace_back(
+            vm::vec2f{bounds.right(), height - (bounds.top() - y)}, texCoords[3]);
+        }
+      }
+    }
+  }
+
+  glAssert(glDisable(GL_DEPTH_TEST));
+  glAssert(glFrontFace(GL_CCW));
+
+  auto shader =
+    Renderer::ActiveShader{shaderManager(), Renderer::Shaders::TextureBrowserShader};
+  shader.set("ApplyTinting", false);
+  shader.set("Texture", 0);
+  shader.set("Brightness", pref(Preferences::Brightness));
+  shader.set("GrayScale", false);
+
+  for (auto& [page, vertices] : verticesByPage)
+  {
+    auto vertexArray = Renderer::VertexArray::move(std::move(vertices));
+
+    m_previewAtlas->activate(page);
+    vertexArray.prepare(vboManager());
+    vertexArray.render(Renderer::PrimType::Quads);
+    m_previewAtlas->deactivate();
+  }
+
+  glAssert(glFrontFace(GL_CW));
+  glAssert(glEnable(GL_DEPTH_TEST));
+}
+
+void EntityBrowserView::setupModelShader(
+  Renderer::ActiveShader& shader,
+  const Renderer::Transformation& transformation,
+  const float brightness) const
+{
+  shader.set("ApplyTinting", false);
+  shader.set("Brightness", brightness);
+  shader.set("GrayScale", false);
+  shader.set("UseInstanceMatrix", false);
+
+  shader.set("CameraPosition", CameraPosition);
+  shader.set("CameraDirection", CameraDirection);
+  shader.set("CameraRight", vm::cross(CameraDirection, CameraUp));
+  shader.set("CameraUp", CameraUp);
+  shader.set("ViewMatrix", transformation.viewMatrix());
+}
+
 void EntityBrowserView::renderNames(
   Layout& layout, const float y, const float height, const vm::mat4x4f& projection)
 {
@@ -424,20 +588,17 @@ void EntityBrowserView::renderGroupTitleBackgrounds(
   using Vertex = Renderer::GLVertexTypes::P2::Vertex;
   auto vertices = std::vector<Vertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
-    {
-      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.left(), height - (titleBounds.top() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.left(), height - (titleBounds.bottom() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.right(), height - (titleBounds.bottom() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.right(), height - (titleBounds.top() - y)});
-    }
+    const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.left(), height - (titleBounds.top() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.left(), height - (titleBounds.bottom() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.right(), height - (titleBounds.bottom() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.right(), height - (titleBounds.top() - y)});
   }
 
   auto vertexArray = Renderer::VertexArray::move(std::move(vertices));
@@ -486,53 +647,45 @@ EntityBrowserView::StringMap EntityBrowserView::collectStringVertices(
   const auto textColor = std::vector<Color>{pref(Preferences::BrowserTextColor)};
 
   auto stringVertices = StringMap{};
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto& title = group.item();
+    if (!title.empty())
+    {
+      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+      const auto offset = vm::vec2f{
+        titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height};
+
+      auto& font = fontManager().font(defaultDescriptor);
+      const auto quads = font.quads(title, false, offset);
+      const auto titleVertices = TextVertex::toList(
+        quads.size() / 2,
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
+        kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
+      auto& allTitleVertices = stringVertices[defaultDescriptor];
+      allTitleVertices = kdl::vec_concat(std::move(allTitleVertices), titleVertices);
+    }
+
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      const auto& title = group.item();
-      if (!title.empty())
+      for (const auto& cell : row.cells())
       {
-        const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+        const auto titleBounds = cell.titleBounds();
         const auto offset = vm::vec2f{
-          titleBounds.left() + 2.0f,
-          height - (titleBounds.top() - y) - titleBounds.height};
+          titleBounds.left(), height - (titleBounds.top() - y) - titleBounds.height};
 
-        auto& font = fontManager().font(defaultDescriptor);
-        const auto quads = font.quads(title, false, offset);
+        auto& font = fontManager().font(cellData(cell).fontDescriptor);
+        const auto quads =
+          font.quads(cellData(cell).entityDefinition->name(), false, offset);
         const auto titleVertices = TextVertex::toList(
           quads.size() / 2,
           kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
           kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
           kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-        auto& allTitleVertices = stringVertices[defaultDescriptor];
+        auto& allTitleVertices = stringVertices[cellData(cell).fontDescriptor];
         allTitleVertices = kdl::vec_concat(std::move(allTitleVertices), titleVertices);
       }
-
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto titleBounds = cell.titleBounds();
-            const auto offset = vm::vec2f{
-              titleBounds.left(), height - (titleBounds.top() - y) - titleBounds.height};
-
-            auto& font = fontManager().font(cellData(cell).fontDescriptor);
-            const auto quads =
-              font.quads(cellData(cell).entityDefinition->name(), false, offset);
-            const auto titleVertices = TextVertex::toList(
-              quads.size() / 2,
-              kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
-              kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
-              kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-            auto& allTitleVertices = stringVertices[cellData(cell).fontDescriptor];
-            allTitleVertices =
-              kdl::vec_concat(std::move(allTitleVertices), titleVertices);
-          }
-        }
-      }
     }
   }
 
@@ -541,12 +694,18 @@ EntityBrowserView::StringMap EntityBrowserView::collectStringVertices(
 
 vm::mat4x4f EntityBrowserView::itemTransformation(
   const Cell& cell, const float y, const float height, const bool applyModelScale) const
+{
+  const auto offset =
+    vm::vec3f{0.0f, cell.itemBounds().left(), height - (cell.itemBounds().bottom() - y)};
+  return vm::translation_matrix(offset) * modelTransformation(cell, applyModelScale);
+}
+
+vm::mat4x4f EntityBrowserView::modelTransformation(
+  const Cell& cell, const bool applyModelScale) const
 {
   const auto& cellData = this->cellData(cell);
   const auto* definition = cellData.entityDefinition;
 
-  const auto offset =
-    vm::vec3f{0.0f, cell.itemBounds().left(), height - (cell.itemBounds().bottom() - y)};
   const auto scaling = cell.scale();
   const auto& rotatedBounds = cellData.bounds;
   const auto modelScale = applyModelScale ? cellData.modelScale : vm::vec3f{1, 1, 1};
@@ -556,7 +715,7 @@ vm::mat4x4f EntityBrowserView::itemTransformation(
   const auto boundsCenter = vm::vec3f{definition->bounds().center()};
   const auto scaledBoundsCenter = scalingMatrix * boundsCenter;
 
-  return vm::translation_matrix(offset) * vm::scaling_matrix(vm::vec3f::fill(scaling))
+  return vm::scaling_matrix(vm::vec3f::fill(scaling))
          * vm::translation_matrix(rotationOffset)
          * vm::translation_matrix(scaledBoundsCenter) * vm::rotation_matrix(m_rotation)
          * scalingMatrix * vm::translation_matrix(-boundsCenter);
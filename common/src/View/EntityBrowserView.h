@@ -23,14 +23,17 @@
 #include "NotifierConnection.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/PreviewAtlas.h"
 #include "View/CellView.h"
 
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/quat.h>
 
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -50,6 +53,7 @@ class PointEntityDefinition;
 
 namespace TrenchBroom::Renderer
 {
+class ActiveShader;
 class FontDescriptor;
 class TexturedRenderer;
 class Transformation;
@@ -95,6 +99,21 @@ private:
   Assets::EntityDefinitionSortOrder m_sortOrder;
   std::string m_filterText;
 
+  struct EntityPreview
+  {
+    Renderer::PreviewAtlas::Slot slot;
+    const EntityRenderer* modelRenderer;
+    size_t width;
+    size_t height;
+  };
+
+  /**
+   * The models are rendered into an atlas once and then drawn as textured quads. A model
+   * is rendered again when its renderer or the size of its cell changes.
+   */
+  std::unique_ptr<Renderer::PreviewAtlas> m_previewAtlas;
+  std::unordered_map<const Assets::PointEntityDefinition*, EntityPreview> m_previews;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -115,6 +134,12 @@ public:
   void setHideUnused(bool hideUnused);
   void setFilterText(const std::string& filterText);
 
+  /**
+   * Discards the rendered model previews and lays out the entities again. Must be called
+   * when the entity definitions or models change.
+   */
+  void reload();
+
 private:
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
@@ -141,6 +166,15 @@ private:
   class MeshFunc;
   void renderModels(
     Layout& layout, float y, float height, Renderer::Transformation& transformation);
+  void renderModelsDirectly(
+    Layout& layout, float y, float height, Renderer::Transformation& transformation);
+  void updateModelPreviews(
+    Layout& layout, float y, float height, Renderer::Transformation& transformation);
+  void renderModelPreviews(Layout& layout, float y, float height);
+  void setupModelShader(
+    Renderer::ActiveShader& shader,
+    const Renderer::Transformation& transformation,
+    float brightness) const;
 
   void renderNames(Layout& layout, float y, float height, const vm::mat4x4f& projection);
   void renderGroupTitleBackgrounds(Layout& layout, float y, float height);
@@ -149,6 +183,7 @@ private:
 
   vm::mat4x4f itemTransformation(
     const Cell& cell, float y, float height, bool applyModelScale) const;
+  vm::mat4x4f modelTransformation(const Cell& cell, bool applyModelScale) const;
 
   QString tooltip(const Cell& cell) override;
 
@@ -29,7 +29,6 @@
 #include <QShortcut>
 #include <QSortFilterProxyModel>
 #include <QTableView>
-#include <QTimer>
 #include <QToolButton>
 
 #include "Macros.h"
@@ -40,6 +39,7 @@
 #include "View/EntityPropertyTable.h"
 #include "View/MapDocument.h"
 #include "View/QtUtils.h"
+#include "View/SignalDelayer.h"
 #include "View/ViewConstants.h"
 
 #include <kdl/memory_utils.h>
@@ -59,7 +59,14 @@ EntityPropertyGrid::EntityPropertyGrid(
   std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
   , m_document{std::move(document)}
+  , m_updateControlsSignalDelayer{new SignalDelayer{this}}
 {
+  connect(
+    m_updateControlsSignalDelayer,
+    &SignalDelayer::processSignal,
+    this,
+    &EntityPropertyGrid::updateModel);
+
   createGui(m_document);
   connectObservers();
 }
@@ -423,22 +430,27 @@ void EntityPropertyGrid::updateControls()
   // where worldspawn is selected. If we call this directly, it'll cause the table to be
   // rebuilt based on that intermediate state. Everything is fine except you lose the
   // selected row in the table, unless it's a key name that exists in worldspawn. To avoid
-  // that problem, make a delayed call to update the table.
-  QTimer::singleShot(0, this, [&]() {
-    m_model->updateFromMapDocument();
+  // that problem, make a delayed call to update the table. This also merges the updates
+  // for several notifications sent by a single edit, so that the rows are only rebuilt
+  // once.
+  m_updateControlsSignalDelayer->queueSignal();
+  updateControlsEnabled();
+}
 
-    if (m_table->selectionModel()->selectedIndexes().empty())
-    {
-      restoreSelection();
-    }
-    ensureSelectionVisible();
+void EntityPropertyGrid::updateModel()
+{
+  m_model->updateFromMapDocument();
 
-    const auto shouldShowProtectedProperties = m_model->shouldShowProtectedProperties();
-    m_table->setColumnHidden(
-      EntityPropertyModel::ColumnProtected, !shouldShowProtectedProperties);
-    m_addProtectedPropertyButton->setHidden(!shouldShowProtectedProperties);
-  });
-  updateControlsEnabled();
+  if (m_table->selectionModel()->selectedIndexes().empty())
+  {
+    restoreSelection();
+  }
+  ensureSelectionVisible();
+
+  const auto shouldShowProtectedProperties = m_model->shouldShowProtectedProperties();
+  m_table->setColumnHidden(
+    EntityPropertyModel::ColumnProtected, !shouldShowProtectedProperties);
+  m_addProtectedPropertyButton->setHidden(!shouldShowProtectedProperties);
 }
 
 void EntityPropertyGrid::ensureSelectionVisible()
@@ -47,6 +47,7 @@ class EntityPropertyModel;
 class EntityPropertyTable;
 class MapDocument;
 class Selection;
+class SignalDelayer;
 
 struct PropertyGridSelection
 {
@@ -73,6 +74,7 @@ private:
   QToolButton* m_setDefaultPropertiesButton;
   QCheckBox* m_showDefaultPropertiesCheckBox;
   std::vector<PropertyGridSelection> m_selectionBackup;
+  SignalDelayer* m_updateControlsSignalDelayer;
 
   NotifierConnection m_notifierConnection;
 
@@ -106,6 +108,7 @@ private:
 private:
   void ensureSelectionVisible();
   void updateControls();
+  void updateModel();
   void updateControlsEnabled();
 
 public:
@@ -109,17 +109,22 @@ static bool isPropertyValueMutable(const Model::Entity& entity, const std::strin
   return true;
 }
 
-static bool isPropertyProtectable(
-  const Model::EntityNodeBase& entityNode, const std::string& key)
+static bool isInLinkedGroup(const Model::EntityNodeBase& entityNode)
 {
-  return Model::findContainingLinkedGroup(entityNode) != nullptr
-         && key != Model::EntityPropertyKeys::Origin;
+  return Model::findContainingLinkedGroup(entityNode) != nullptr;
+}
+
+static bool isPropertyProtectable(const bool inLinkedGroup, const std::string& key)
+{
+  return inLinkedGroup && key != Model::EntityPropertyKeys::Origin;
 }
 
 static PropertyProtection isPropertyProtected(
-  const Model::EntityNodeBase& entityNode, const std::string& key)
+  const Model::EntityNodeBase& entityNode,
+  const bool inLinkedGroup,
+  const std::string& key)
 {
-  if (isPropertyProtectable(entityNode, key))
+  if (isPropertyProtectable(inLinkedGroup, key))
   {
     for (const auto& protectedKey : entityNode.entity().protectedProperties())
     {
@@ -174,6 +179,12 @@ PropertyRow::PropertyRow()
 }
 
 PropertyRow::PropertyRow(std::string key, const Model::EntityNodeBase* node)
+  : PropertyRow{std::move(key), node, isInLinkedGroup(*node)}
+{
+}
+
+PropertyRow::PropertyRow(
+  std::string key, const Model::EntityNodeBase* node, const bool inLinkedGroup)
   : m_key{std::move(key)}
 {
   const auto* definition = Model::propertyDefinition(node, m_key);
@@ -196,7 +207,7 @@ PropertyRow::PropertyRow(std::string key, const Model::EntityNodeBase* node)
 
   m_keyMutable = isPropertyKeyMutable(node->entity(), m_key);
   m_valueMutable = isPropertyValueMutable(node->entity(), m_key);
-  m_protected = isPropertyProtected(*node, m_key);
+  m_protected = isPropertyProtected(*node, inLinkedGroup, m_key);
   m_tooltip = (definition != nullptr ? definition->shortDescription() : "");
   if (m_tooltip.empty())
   {
@@ -205,6 +216,11 @@ PropertyRow::PropertyRow(std::string key, const Model::EntityNodeBase* node)
 }
 
 void PropertyRow::merge(const Model::EntityNodeBase* other)
+{
+  merge(other, isInLinkedGroup(*other));
+}
+
+void PropertyRow::merge(const Model::EntityNodeBase* other, const bool inLinkedGroup)
 {
   const auto* otherValue = other->entity().property(m_key);
 
@@ -239,7 +255,7 @@ void PropertyRow::merge(const Model::EntityNodeBase* other)
   m_keyMutable = (m_keyMutable && isPropertyKeyMutable(other->entity(), m_key));
   m_valueMutable = (m_valueMutable && isPropertyValueMutable(other->entity(), m_key));
 
-  const auto otherProtected = isPropertyProtected(*other, m_key);
+  const auto otherProtected = isPropertyProtected(*other, inLinkedGroup, m_key);
   if (m_protected != otherProtected)
   {
     if (
@@ -365,10 +381,30 @@ std::map<std::string, PropertyRow> PropertyRow::rowsForEntityNodes(
   const bool showProtectedProperties)
 {
   auto result = std::map<std::string, PropertyRow>{};
+  if (nodes.empty())
+  {
+    return result;
+  }
+
+  // merge node by node so that the properties of each node are looked up while they are
+  // hot in the cache, and so that the containing linked group is only found once per node
+  const auto* firstNode = nodes.front();
+  const auto firstInLinkedGroup = isInLinkedGroup(*firstNode);
   for (const auto& key : allKeys(nodes, showDefaultRows, showProtectedProperties))
   {
-    result[key] = rowForEntityNodes(key, nodes);
+    result.emplace_hint(
+      result.end(), key, PropertyRow{key, firstNode, firstInLinkedGroup});
   }
+
+  for (auto it = std::next(nodes.begin()); it != nodes.end(); ++it)
+  {
+    const auto inLinkedGroup = isInLinkedGroup(**it);
+    for (auto& [key, row] : result)
+    {
+      row.merge(*it, inLinkedGroup);
+    }
+  }
+
   return result;
 }
 
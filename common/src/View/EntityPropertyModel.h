@@ -95,6 +95,12 @@ public:
 
   void merge(const Model::EntityNodeBase* other);
 
+private:
+  PropertyRow(std::string key, const Model::EntityNodeBase* node, bool inLinkedGroup);
+  void merge(const Model::EntityNodeBase* other, bool inLinkedGroup);
+
+public:
+
   const std::string& key() const;
   std::string value() const;
   bool keyMutable() const;
@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameTelemetry.h"
+
+#include "Macros.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+
+namespace TrenchBroom::View
+{
+namespace
+{
+double percentile(const std::vector<double>& sortedValues, const double p)
+{
+  const auto rank = static_cast<size_t>(
+    std::ceil(p / 100.0 * static_cast<double>(sortedValues.size())));
+  return sortedValues[std::clamp(rank, size_t(1), sortedValues.size()) - 1u];
+}
+
+double toMilliseconds(const FrameTelemetry::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+} // namespace
+
+FrameTelemetry::FrameTelemetry(const size_t maxSampleCount)
+  : m_maxSampleCount{maxSampleCount}
+{
+  assert(m_maxSampleCount > 0);
+}
+
+void FrameTelemetry::eventReceived(const Clock::time_point time)
+{
+  if (!m_firstPendingEvent)
+  {
+    m_firstPendingEvent = time;
+  }
+}
+
+void FrameTelemetry::frameRendered(
+  const Clock::time_point start, const Clock::time_point end)
+{
+  addSample(Metric::FrameTime, end - start);
+  if (m_firstPendingEvent)
+  {
+    addSample(Metric::InputLatency, end - *m_firstPendingEvent);
+    m_firstPendingEvent = std::nullopt;
+  }
+}
+
+void FrameTelemetry::addSample(const Metric metric, const Clock::duration duration)
+{
+  auto& samples = m_samples[static_cast<size_t>(metric)];
+  if (samples.values.size() < m_maxSampleCount)
+  {
+    samples.values.push_back(toMilliseconds(duration));
+  }
+  else
+  {
+    samples.values[samples.next] = toMilliseconds(duration);
+    samples.next = (samples.next + 1u) % m_maxSampleCount;
+  }
+}
+
+FrameTelemetry::Percentiles FrameTelemetry::percentiles(const Metric metric) const
+{
+  auto values = m_samples[static_cast<size_t>(metric)].values;
+  if (values.empty())
+  {
+    return {0.0, 0.0, 0.0, 0};
+  }
+
+  std::sort(values.begin(), values.end());
+  return {
+    percentile(values, 50.0),
+    percentile(values, 95.0),
+    percentile(values, 99.0),
+    values.size(),
+  };
+}
+
+void FrameTelemetry::clear()
+{
+  m_samples = {};
+  m_firstPendingEvent = std::nullopt;
+}
+
+std::ostream& operator<<(std::ostream& lhs, const FrameTelemetry::Metric rhs)
+{
+  switch (rhs)
+  {
+  case FrameTelemetry::Metric::FrameTime:
+    lhs << "Frame time";
+    break;
+  case FrameTelemetry::Metric::InputLatency:
+    lhs << "Input latency";
+    break;
+  case FrameTelemetry::Metric::ToolControllers:
+    lhs << "Tool controllers";
+    break;
+  case FrameTelemetry::Metric::Picking:
+    lhs << "Picking";
+    break;
+  case FrameTelemetry::Metric::RenderPreparation:
+    lhs << "Render preparation";
+    break;
+    switchDefault();
+  }
+  return lhs;
+}
+
+} // namespace TrenchBroom::View
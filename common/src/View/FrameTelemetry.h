@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom::View
+{
+
+/**
+ * Collects the frame times and input latencies of a view, along with the time spent in
+ * its tool controllers, picking and render preparation per frame. Only the most recent
+ * samples of every metric are kept, so that their percentiles reflect the current state
+ * of the map.
+ *
+ * The latency of an input event is measured from the moment the view received it until
+ * the next frame has been rendered. The time of the buffer swap is not known to the view
+ * and is therefore not included.
+ */
+class FrameTelemetry
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Metric
+  {
+    FrameTime,
+    InputLatency,
+    ToolControllers,
+    Picking,
+    RenderPreparation,
+  };
+
+  static constexpr auto Metrics = std::array<Metric, 5>{
+    Metric::FrameTime,
+    Metric::InputLatency,
+    Metric::ToolControllers,
+    Metric::Picking,
+    Metric::RenderPreparation,
+  };
+
+  struct Percentiles
+  {
+    // in milliseconds
+    double p50;
+    double p95;
+    double p99;
+    size_t sampleCount;
+  };
+
+private:
+  struct Samples
+  {
+    std::vector<double> values;
+    size_t next{0};
+  };
+
+  size_t m_maxSampleCount;
+  std::array<Samples, Metrics.size()> m_samples;
+  std::optional<Clock::time_point> m_firstPendingEvent;
+
+public:
+  explicit FrameTelemetry(size_t maxSampleCount = 1000);
+
+  /**
+   * Records that an input event was received at the given time. The latency of the next
+   * frame is measured from the first event received since the previous frame.
+   */
+  void eventReceived(Clock::time_point time);
+
+  /**
+   * Records a frame that was rendered between the given times. If an input event was
+   * received since the previous frame, the latency of the first such event is recorded.
+   */
+  void frameRendered(Clock::time_point start, Clock::time_point end);
+
+  void addSample(Metric metric, Clock::duration duration);
+
+  /**
+   * Returns the 50th, 95th and 99th percentile of the samples of the given metric, using
+   * the nearest rank method. All percentiles are 0 if there are no samples.
+   */
+  Percentiles percentiles(Metric metric) const;
+
+  void clear();
+};
+
+std::ostream& operator<<(std::ostream& lhs, FrameTelemetry::Metric rhs);
+
+} // namespace TrenchBroom::View
@@ -21,6 +21,8 @@
 
 #include "Error.h"
 #include "Exceptions.h"
+#include "IO/SystemPaths.h"
+#include "Renderer/BackgroundUploader.h"
 #include "Renderer/FontManager.h"
 #include "Renderer/GL.h"
 #include "Renderer/Shader.h"
@@ -33,6 +35,24 @@
 #include "kdl/vector_utils.h"
 #include <kdl/result.h>
 
+// see RenderView.cpp for why this warning is silenced
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcpp"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcpp"
+#endif
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
 #include <sstream>
 #include <string>
 
@@ -52,7 +72,11 @@ GLContextManager::GLContextManager()
 {
 }
 
-GLContextManager::~GLContextManager() = default;
+GLContextManager::~GLContextManager()
+{
+  // join the worker thread before the context and surface are destroyed
+  m_backgroundUploader.reset();
+}
 
 bool GLContextManager::initialized() const
 {
@@ -85,6 +109,9 @@ bool GLContextManager::initialize()
     GLRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
     GLVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
+    m_shaderManager->setCacheDirectory(
+      IO::SystemPaths::userDataDirectory() / "ShaderCache");
+    m_fontManager->setCacheDirectory(IO::SystemPaths::userDataDirectory() / "FontCache");
     kdl::fold_results(kdl::vec_transform(
                         std::vector<Renderer::ShaderConfig>{
                           Grid2DShader,
@@ -114,6 +141,8 @@ bool GLContextManager::initialize()
                         }))
       .transform_error([&](const auto& e) { throw RenderException{e.msg}; });
 
+    createBackgroundUploader();
+
     return true;
   }
   return false;
@@ -133,5 +162,46 @@ Renderer::ShaderManager& GLContextManager::shaderManager()
 {
   return *m_shaderManager;
 }
+
+Renderer::BackgroundUploader* GLContextManager::backgroundUploader()
+{
+  return m_backgroundUploader.get();
+}
+
+void GLContextManager::createBackgroundUploader()
+{
+  auto* shareContext = QOpenGLContext::globalShareContext();
+  if (
+    !shareContext || !QOpenGLContext::supportsThreadedOpenGL()
+    || !(GLEW_VERSION_3_2 || GLEW_ARB_sync))
+  {
+    return;
+  }
+
+  // the surface must be created on the GUI thread, but the context must be created on the
+  // thread that makes it current
+  m_backgroundSurface = std::make_unique<QOffscreenSurface>();
+  m_backgroundSurface->setFormat(shareContext->format());
+  m_backgroundSurface->create();
+
+  m_backgroundUploader = std::make_unique<Renderer::BackgroundUploader>(
+    [&, shareContext]() {
+      m_backgroundContext = std::make_unique<QOpenGLContext>();
+      m_backgroundContext->setFormat(shareContext->format());
+      m_backgroundContext->setShareContext(shareContext);
+      if (
+        !m_backgroundContext->create()
+        || !m_backgroundContext->makeCurrent(m_backgroundSurface.get()))
+      {
+        m_backgroundContext.reset();
+        return false;
+      }
+      return true;
+    },
+    [&]() {
+      m_backgroundContext->doneCurrent();
+      m_backgroundContext.reset();
+    });
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -24,10 +24,14 @@
 #include <memory>
 #include <string>
 
+class QOffscreenSurface;
+class QOpenGLContext;
+
 namespace TrenchBroom
 {
 namespace Renderer
 {
+class BackgroundUploader;
 class FontManager;
 class ShaderManager;
 class VboManager;
@@ -53,6 +57,11 @@ private:
   std::unique_ptr<Renderer::VboManager> m_vboManager;
   std::unique_ptr<Renderer::FontManager> m_fontManager;
 
+  // the uploader must be destroyed first because its worker thread uses the context
+  std::unique_ptr<QOffscreenSurface> m_backgroundSurface;
+  std::unique_ptr<QOpenGLContext> m_backgroundContext;
+  std::unique_ptr<Renderer::BackgroundUploader> m_backgroundUploader;
+
 public:
   GLContextManager();
   ~GLContextManager();
@@ -64,6 +73,16 @@ public:
   Renderer::FontManager& fontManager();
   Renderer::ShaderManager& shaderManager();
 
+  /**
+   * Returns the uploader that uploads data using a background GL context that shares its
+   * objects with the render contexts, or nullptr if the platform does not support this.
+   * Only available after initialize() was called.
+   */
+  Renderer::BackgroundUploader* backgroundUploader();
+
+private:
+  void createBackgroundUploader();
+
   deleteCopyAndMove(GLContextManager);
 };
 } // namespace View
@@ -24,6 +24,7 @@
 #include <QItemSelectionModel>
 #include <QMenu>
 #include <QTableView>
+#include <QTimer>
 
 #include "Ensure.h"
 #include "Model/BrushNode.h"
@@ -39,22 +40,61 @@
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
-#include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
+#include <chrono>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+// delays validation so that rapid successive edits are validated only once
+constexpr auto ValidationDelay = std::chrono::milliseconds{100};
+
+// how long to validate before returning control to the event loop
+constexpr auto ValidationTimeSlice = std::chrono::milliseconds{10};
+
+std::vector<Model::Node*> collectNodes(Model::WorldNode& world)
+{
+  auto result = std::vector<Model::Node*>{};
+  world.accept(kdl::overload(
+    [&](auto&& thisLambda, Model::WorldNode* worldNode) {
+      result.push_back(worldNode);
+      worldNode->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::LayerNode* layer) {
+      result.push_back(layer);
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::GroupNode* group) {
+      result.push_back(group);
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::EntityNode* entity) {
+      result.push_back(entity);
+      entity->visitChildren(thisLambda);
+    },
+    [&](Model::BrushNode* brush) { result.push_back(brush); },
+    [&](Model::PatchNode* patch) { result.push_back(patch); }));
+  return result;
+}
+} // namespace
+
 IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
   , m_document{std::move(document)}
   , m_hiddenIssueTypes{0}
   , m_showHiddenIssues{false}
   , m_valid{false}
+  , m_validating{false}
+  , m_validationTimer{new QTimer{this}}
 {
+  m_validationTimer->setSingleShot(true);
+  connect(m_validationTimer, &QTimer::timeout, this, &IssueBrowserView::validate);
+
   createGui();
   bindEvents();
 }
@@ -71,7 +111,12 @@ void IssueBrowserView::createGui()
   m_tableView->horizontalHeader()->setSectionsClickable(false);
   m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
 
-  autoResizeRows(m_tableView);
+  // Issues are single lines of text, so all rows have the same height. Resizing the rows
+  // to their contents would measure every row whenever the issues change, which takes
+  // far too long for maps with many issues.
+  m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  m_tableView->verticalHeader()->setDefaultSectionSize(
+    m_tableView->verticalHeader()->minimumSectionSize());
 
   auto* layout = new QHBoxLayout{};
   layout->setContentsMargins(0, 0, 0, 0);
@@ -130,53 +175,6 @@ void IssueBrowserView::updateSelection()
   document->selectNodes(nodes);
 }
 
-void IssueBrowserView::updateIssues()
-{
-  auto document = kdl::mem_lock(m_document);
-  if (document->world() != nullptr)
-  {
-    const auto validators = document->world()->registeredValidators();
-
-    auto issues = std::vector<const Model::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, Model::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](Model::BrushNode* brush) { collectIssues(brush); },
-      [&](Model::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
-    });
-    m_tableModel->setIssues(std::move(issues));
-  }
-}
-
 void IssueBrowserView::applyQuickFix(const Model::IssueQuickFix& quickFix)
 {
   auto document = kdl::mem_lock(m_document);
@@ -192,20 +190,20 @@ void IssueBrowserView::applyQuickFix(const Model::IssueQuickFix& quickFix)
 std::vector<const Model::Issue*> IssueBrowserView::collectIssues(
   const QList<QModelIndex>& indices) const
 {
-  // Use a vector_set to filter out duplicates.
-  // The QModelIndex list returned by getSelection() contains duplicates
-  // (not sure why, current row and selected row?)
-  auto result = kdl::vector_set<const Model::Issue*>{};
+  // The QModelIndex list returned by getSelection() contains one index per selected cell,
+  // so every issue appears once per column. Remove the duplicates at once rather than
+  // inserting into a sorted set one by one, which is quadratic for large selections.
+  auto result = std::vector<const Model::Issue*>{};
   result.reserve(static_cast<size_t>(indices.size()));
   for (const auto& index : indices)
   {
     if (index.isValid())
     {
       const auto row = static_cast<size_t>(index.row());
-      result.insert(m_tableModel->issues().at(row));
+      result.push_back(m_tableModel->issues().at(row));
     }
   }
-  return result.release_data();
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
 std::vector<const Model::IssueQuickFix*> IssueBrowserView::collectQuickFixes(
@@ -326,19 +324,70 @@ void IssueBrowserView::hideIssues()
 
 void IssueBrowserView::invalidate()
 {
+  // the pending nodes and issues may have been changed or deleted
   m_valid = false;
+  m_validating = false;
+  m_nodesToValidate.clear();
+  m_validatedIssues.clear();
   m_tableModel->setIssues({});
 
-  QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+  m_validationTimer->start(ValidationDelay);
 }
 
 void IssueBrowserView::validate()
 {
-  if (!m_valid)
+  if (m_valid)
+  {
+    return;
+  }
+
+  auto document = kdl::mem_lock(m_document);
+  auto* world = document->world();
+  if (world == nullptr)
   {
-    updateIssues();
     m_valid = true;
+    return;
+  }
+
+  if (!m_validating)
+  {
+    m_nodesToValidate = collectNodes(*world);
+    m_validating = true;
+  }
+
+  const auto validators = world->registeredValidators();
+  const auto deadline = std::chrono::steady_clock::now() + ValidationTimeSlice;
+  while (!m_nodesToValidate.empty() && std::chrono::steady_clock::now() < deadline)
+  {
+    auto* node = m_nodesToValidate.back();
+    m_nodesToValidate.pop_back();
+
+    for (auto* issue : node->issues(validators))
+    {
+      if (
+        m_showHiddenIssues
+        || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
+      {
+        m_validatedIssues.push_back(issue);
+      }
+    }
+  }
+
+  if (!m_nodesToValidate.empty())
+  {
+    // continue with the remaining nodes once pending events have been processed
+    m_validationTimer->start(0);
+    return;
   }
+
+  auto issues = kdl::vec_sort(
+    std::move(m_validatedIssues),
+    [](const auto* lhs, const auto* rhs) { return lhs->seqId() > rhs->seqId(); });
+  m_validatedIssues.clear();
+  m_tableModel->setIssues(std::move(issues));
+
+  m_validating = false;
+  m_valid = true;
 }
 
 // IssueBrowserModel
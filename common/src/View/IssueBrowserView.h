@@ -29,6 +29,7 @@
 
 class QWidget;
 class QTableView;
+class QTimer;
 
 namespace TrenchBroom
 {
@@ -36,6 +37,7 @@ namespace Model
 {
 class Issue;
 class IssueQuickFix;
+class Node;
 } // namespace Model
 
 namespace View
@@ -53,6 +55,12 @@ private:
   bool m_showHiddenIssues;
 
   bool m_valid;
+  bool m_validating;
+  QTimer* m_validationTimer;
+
+  // the nodes that remain to be validated and the issues found so far
+  std::vector<Model::Node*> m_nodesToValidate;
+  std::vector<const Model::Issue*> m_validatedIssues;
 
   QTableView* m_tableView;
   IssueBrowserModel* m_tableModel;
@@ -72,8 +80,6 @@ public:
   void deselectAll();
 
 private:
-  void updateIssues();
-
   std::vector<const Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
   std::vector<const Model::IssueQuickFix*> collectQuickFixes(
     const QList<QModelIndex>& indices) const;
@@ -93,7 +99,11 @@ private:
 
 private:
   void invalidate();
-public slots:
+
+  /**
+   * Validates the document's nodes in time slices so that large edits do not block the
+   * UI. Reschedules itself until all nodes are validated, then publishes the issues.
+   */
   void validate();
 };
 
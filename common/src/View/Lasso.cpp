@@ -28,6 +28,10 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
 #include <vecmath/segment.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
 
 namespace TrenchBroom
 {
@@ -40,43 +44,58 @@ Lasso::Lasso(
   , m_start{point}
   , m_cur{point}
 {
+  updateCache();
 }
 
 void Lasso::update(const vm::vec3& point)
 {
   m_cur = point;
+  updateCache();
 }
 
-bool Lasso::selects(
-  const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const
+bool Lasso::selects(const vm::vec3& point) const
 {
-  const auto projected = project(point, plane);
-  return !vm::is_nan(projected) && box.contains(vm::vec2{projected});
+  const auto projected = project(point);
+  return !vm::is_nan(projected) && m_box.contains(vm::vec2{projected});
 }
 
-bool Lasso::selects(
-  const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const
+bool Lasso::selects(const vm::segment3& edge) const
 {
-  return selects(edge.center(), plane, box);
+  return selects(edge.center());
 }
 
-bool Lasso::selects(
-  const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const
+bool Lasso::selects(const vm::polygon3& polygon) const
 {
-  return selects(polygon.center(), plane, box);
+  return selects(polygon.center());
 }
 
-vm::vec3 Lasso::project(const vm::vec3& point, const vm::plane3& plane) const
+bool Lasso::mayIntersect(const vm::bbox3& bounds) const
+{
+  return std::none_of(m_boundary.begin(), m_boundary.end(), [&](const auto& plane) {
+    // the vertex of the bounds that is furthest above the plane
+    auto vertex = bounds.min;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (plane.normal[i] > 0.0)
+      {
+        vertex[i] = bounds.max[i];
+      }
+    }
+    return plane.point_distance(vertex) < -vm::C::almost_zero();
+  });
+}
+
+vm::vec3 Lasso::project(const vm::vec3& point) const
 {
   const auto ray = vm::ray3{m_camera.pickRay(vm::vec3f{point})};
-  const auto hitDistance = vm::intersect_ray_plane(ray, plane);
+  const auto hitDistance = vm::intersect_ray_plane(ray, m_plane);
   if (vm::is_nan(hitDistance))
   {
     return vm::vec3::nan();
   }
 
   const auto hitPoint = vm::point_at_distance(ray, hitDistance);
-  return getTransform() * hitPoint;
+  return m_transform * hitPoint;
 }
 
 void Lasso::render(
@@ -104,6 +123,14 @@ void Lasso::render(
   renderService.renderFilledPolygon(polygon);
 }
 
+void Lasso::updateCache()
+{
+  m_transform = getTransform();
+  m_plane = getPlane();
+  m_box = getBox(m_transform);
+  m_boundary = getBoundary(m_transform, m_box);
+}
+
 vm::plane3 Lasso::getPlane() const
 {
   return vm::plane3{
@@ -129,5 +156,42 @@ vm::bbox2 Lasso::getBox(const vm::mat4x4& transform) const
   const auto max = vm::max(start, cur);
   return vm::bbox2{vm::vec2{min}, vm::vec2{max}};
 }
+
+/**
+ * Returns the planes that bound the region of all points whose pick rays hit the given
+ * lasso box. Each plane contains an edge of the lasso box and the pick rays through that
+ * edge, and its normal points into the region.
+ */
+std::array<vm::plane3, 4> Lasso::getBoundary(
+  const vm::mat4x4& transform, const vm::bbox2& box) const
+{
+  const auto [invertible, inverseTransform] = vm::invert(transform);
+  assert(invertible);
+  unused(invertible);
+
+  const auto corners = std::array<vm::vec3, 4>{
+    inverseTransform * vm::vec3{box.min.x(), box.min.y(), 0.0},
+    inverseTransform * vm::vec3{box.min.x(), box.max.y(), 0.0},
+    inverseTransform * vm::vec3{box.max.x(), box.max.y(), 0.0},
+    inverseTransform * vm::vec3{box.max.x(), box.min.y(), 0.0},
+  };
+  const auto center = inverseTransform * vm::vec3{box.center(), 0.0};
+
+  auto boundary = std::array<vm::plane3, 4>{};
+  for (size_t i = 0; i < corners.size(); ++i)
+  {
+    const auto& start = corners[i];
+    const auto& end = corners[(i + 1) % corners.size()];
+    const auto rayDirection = vm::vec3{m_camera.pickRay(vm::vec3f{start}).direction};
+
+    auto normal = vm::normalize(vm::cross(end - start, rayDirection));
+    if (vm::dot(normal, center - start) < 0.0)
+    {
+      normal = -normal;
+    }
+    boundary[i] = vm::plane3{start, normal};
+  }
+  return boundary;
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -22,8 +22,11 @@
 #include "FloatType.h"
 
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
 #include <vecmath/plane.h>
 
+#include <array>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -43,6 +46,12 @@ private:
   const vm::vec3 m_start;
   vm::vec3 m_cur;
 
+  // cached when the lasso is updated so that they are not recomputed for every handle
+  vm::mat4x4 m_transform;
+  vm::plane3 m_plane;
+  vm::bbox2 m_box;
+  std::array<vm::plane3, 4> m_boundary;
+
 public:
   Lasso(const Renderer::Camera& camera, FloatType distance, const vm::vec3& point);
 
@@ -51,11 +60,9 @@ public:
   template <typename I, typename O>
   void selected(I cur, I end, O out) const
   {
-    const auto plane = getPlane();
-    const auto box = getBox(getTransform());
     while (cur != end)
     {
-      if (selects(*cur, plane, box))
+      if (selects(*cur))
       {
         out = *cur;
       }
@@ -63,23 +70,31 @@ public:
     }
   }
 
+  /**
+   * Indicates whether this lasso may select any handle within the given bounds. This
+   * test is conservative: it returns false only if no handle within the given bounds can
+   * be selected.
+   */
+  bool mayIntersect(const vm::bbox3& bounds) const;
+
 private:
-  bool selects(
-    const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
-  bool selects(
-    const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
-  bool selects(
-    const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const;
-  vm::vec3 project(const vm::vec3& point, const vm::plane3& plane) const;
+  bool selects(const vm::vec3& point) const;
+  bool selects(const vm::segment3& edge) const;
+  bool selects(const vm::polygon3& polygon) const;
+  vm::vec3 project(const vm::vec3& point) const;
 
 public:
   void render(
     Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const;
 
 private:
+  void updateCache();
+
   vm::plane3 getPlane() const;
   vm::mat4x4 getTransform() const;
   vm::bbox2 getBox(const vm::mat4x4& transform) const;
+  std::array<vm::plane3, 4> getBoundary(
+    const vm::mat4x4& transform, const vm::bbox2& box) const;
 };
 } // namespace View
 } // namespace TrenchBroom
@@ -27,13 +27,22 @@
 #include <QToolButton>
 #include <QtGlobal>
 
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/ModelUtils.h"
+#include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 #include "View/QtUtils.h"
 #include "View/ViewConstants.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/overload.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
 
 namespace TrenchBroom
 {
@@ -225,7 +234,43 @@ void LayerListBox::documentDidChange(MapDocument*)
   reload();
 }
 
-void LayerListBox::nodesDidChange(const std::vector<Model::Node*>&)
+void LayerListBox::nodesDidChange(const std::vector<Model::Node*>& nodes)
+{
+  auto changedLayers = std::vector<Model::LayerNode*>{};
+  for (auto* node : nodes)
+  {
+    const auto isWorldOrLayer = node->accept(kdl::overload(
+      [](const Model::WorldNode*) { return true; },
+      [](const Model::LayerNode*) { return true; },
+      [](const Model::GroupNode*) { return false; },
+      [](const Model::EntityNode*) { return false; },
+      [](const Model::BrushNode*) { return false; },
+      [](const Model::PatchNode*) { return false; }));
+    if (isWorldOrLayer)
+    {
+      // layers may have been added, removed or reordered
+      updateAllLayers();
+      return;
+    }
+
+    if (auto* layer = Model::findContainingLayer(node))
+    {
+      changedLayers.push_back(layer);
+    }
+  }
+
+  // only the rows of the layers that contain the changed nodes need to be updated
+  changedLayers = kdl::vec_sort_and_remove_duplicates(std::move(changedLayers));
+  for (int i = 0; i < count(); ++i)
+  {
+    if (std::binary_search(changedLayers.begin(), changedLayers.end(), layerForRow(i)))
+    {
+      renderer(i)->updateItem();
+    }
+  }
+}
+
+void LayerListBox::updateAllLayers()
 {
   const auto documentLayers = kdl::mem_lock(m_document)->world()->allLayersUserSorted();
 
@@ -105,6 +105,7 @@ private:
 
   void documentDidChange(MapDocument* document);
   void nodesDidChange(const std::vector<Model::Node*>& nodes);
+  void updateAllLayers();
   void currentLayerDidChange(const Model::LayerNode* layer);
 
   const LayerListBoxWidget* widgetAtRow(int row) const;
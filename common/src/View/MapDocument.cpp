@@ -83,6 +83,7 @@
 #include "Model/WorldNode.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Trace.h"
 #include "Uuid.h"
 #include "View/Actions.h"
 #include "View/AddRemoveNodesCommand.h"
@@ -120,12 +121,14 @@
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdlib> // for std::abs
 #include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -295,7 +298,8 @@ static bool applyAndSwap(
  * - bool operator()(Model::BrushFace&);
  *
  * The given node contents should be modified in place and the lambda should return true
- * if it was applied successfully and false otherwise.
+ * if it was applied successfully and false otherwise. The brushes are processed in
+ * parallel, so the lambda may be called concurrently for faces of different brushes.
  *
  * For each linked group in the given list of linked groups, its changes are distributed
  * to the connected members of its link set.
@@ -316,29 +320,52 @@ static bool applyAndSwap(
     return true;
   }
 
-  auto brushes = std::unordered_map<Model::BrushNode*, Model::Brush>{};
-
-  bool success = true;
-  std::for_each(std::begin(faces), std::end(faces), [&](const auto& faceHandle) {
-    auto* brushNode = faceHandle.node();
-    auto it = brushes.find(brushNode);
-    if (it == std::end(brushes))
+  // group the face indices by brush, keeping the brushes in the order they first appear
+  auto brushIndices = std::unordered_map<Model::BrushNode*, size_t>{};
+  auto faceIndicesByBrush =
+    std::vector<std::pair<Model::BrushNode*, std::vector<size_t>>>{};
+  for (const auto& faceHandle : faces)
+  {
+    const auto [it, inserted] =
+      brushIndices.emplace(faceHandle.node(), faceIndicesByBrush.size());
+    if (inserted)
     {
-      it = brushes.emplace(brushNode, brushNode->brush()).first;
+      faceIndicesByBrush.emplace_back(faceHandle.node(), std::vector<size_t>{});
     }
+    faceIndicesByBrush[it->second].second.push_back(faceHandle.faceIndex());
+  }
+
+  // each brush is copied and modified independently, so the brushes can be processed in
+  // parallel
+  auto newBrushes = kdl::vec_parallel_transform(
+    std::move(faceIndicesByBrush),
+    [&](auto&& brushAndFaceIndices)
+      -> std::optional<std::pair<Model::Node*, Model::NodeContents>> {
+      const auto& [brushNode, faceIndices] = brushAndFaceIndices;
+      auto brush = brushNode->brush();
+      const auto success =
+        std::all_of(std::begin(faceIndices), std::end(faceIndices), [&](const auto i) {
+          return lambda(brush.face(i));
+        });
+      return success ? std::make_optional(std::make_pair(
+                         static_cast<Model::Node*>(brushNode),
+                         Model::NodeContents(std::move(brush))))
+                     : std::nullopt;
+    });
 
-    auto& brush = it->second;
-    success = success && lambda(brush.face(faceHandle.faceIndex()));
-  });
+  const auto success =
+    std::all_of(std::begin(newBrushes), std::end(newBrushes), [](const auto& brush) {
+      return brush.has_value();
+    });
 
   if (success)
   {
     auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
-    newNodes.reserve(brushes.size());
+    newNodes.reserve(newBrushes.size());
 
-    for (auto& [brushNode, brush] : brushes)
+    for (auto& brush : newBrushes)
     {
-      newNodes.emplace_back(brushNode, Model::NodeContents(std::move(brush)));
+      newNodes.push_back(std::move(*brush));
     }
 
     auto changedLinkedGroups = findContainingLinkedGroups(
@@ -354,6 +381,18 @@ static bool applyAndSwap(
 const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
 const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
+bool DocumentChangeSet::empty() const
+{
+  return addedNodes.empty() && changedNodes.empty() && !nodesWereRemoved
+         && !selectionDidChange;
+}
+
+static size_t entityModelMemoryBudget()
+{
+  const auto budgetInMiB = std::max(pref(Preferences::EntityModelMemoryBudget), 0);
+  return size_t(budgetInMiB) * 1024u * 1024u;
+}
+
 MapDocument::MapDocument()
   : m_worldBounds(DefaultWorldBounds)
   , m_world(nullptr)
@@ -374,7 +413,14 @@ MapDocument::MapDocument()
   , m_selectionBoundsValid(true)
   , m_viewEffectsService(nullptr)
   , m_repeatStack(std::make_unique<RepeatStack>())
-{
+  , m_pendingNodesWereRemoved(false)
+  , m_pendingSelectionDidChange(false)
+{
+  m_entityModelManager->setAsyncLoading(true);
+  m_entityModelManager->setMemoryBudget(entityModelMemoryBudget());
+  m_textureManager->setCacheDirectory(pref(Preferences::TextureCacheDirectory()));
+  m_textureManager->setCompressTextures(pref(Preferences::CompressTextures));
+  m_textureManager->setGenerateMipmaps(pref(Preferences::GenerateMipmaps));
   connectObservers();
 }
 
@@ -587,6 +633,8 @@ Result<void> MapDocument::loadDocument(
   std::shared_ptr<Model::Game> game,
   const std::filesystem::path& path)
 {
+  traceZone("MapDocument::loadDocument");
+
   info("Loading document from " + path.string());
 
   clearRepeatableCommands();
@@ -599,6 +647,10 @@ Result<void> MapDocument::loadDocument(
     registerSmartTags();
     createTagActions();
 
+    // check the entire map at once so that the issue browser finds all issues cached
+    Model::Node::validateIssues(
+      Model::collectNodes({m_world.get()}), m_world->registeredValidators());
+
     documentWasLoadedNotifier(this);
   });
 }
@@ -615,6 +667,8 @@ void MapDocument::saveDocumentAs(const std::filesystem::path& path)
 
 void MapDocument::saveDocumentTo(const std::filesystem::path& path)
 {
+  traceZone("MapDocument::saveDocumentTo");
+
   ensure(m_game.get() != nullptr, "game is null");
   ensure(m_world, "world is null");
   m_game->writeMap(*m_world, path).transform_error([&](const auto& e) {
@@ -622,11 +676,23 @@ void MapDocument::saveDocumentTo(const std::filesystem::path& path)
   });
 }
 
+void MapDocument::saveDocumentTo(std::ostream& stream)
+{
+  ensure(m_game.get() != nullptr, "game is null");
+  ensure(m_world, "world is null");
+  m_game->writeMap(*m_world, stream);
+}
+
 Result<void> MapDocument::exportDocumentAs(const IO::ExportOptions& options)
 {
   return m_game->exportMap(*m_world, options);
 }
 
+void MapDocument::exportDocumentTo(std::ostream& stream)
+{
+  m_game->exportMap(*m_world, stream);
+}
+
 void MapDocument::doSaveDocument(const std::filesystem::path& path)
 {
   saveDocumentTo(path);
@@ -647,6 +713,7 @@ void MapDocument::clearDocument()
     clearTagActions();
     clearWorld();
     clearModificationCount();
+    clearChangeSet();
 
     documentWasClearedNotifier(this);
   }
@@ -661,7 +728,20 @@ std::string MapDocument::serializeSelectedNodes()
 {
   std::stringstream stream;
   m_game->writeNodesToStream(*m_world, m_selectedNodes.nodes(), stream);
-  return stream.str();
+
+  // keep clones of the copied nodes so that pasting them again does not have to parse
+  // the text
+  auto copiedNodes = kdl::vec_parallel_transform(
+    m_selectedNodes.nodes(),
+    [&](const auto* node) { return node->cloneRecursively(m_worldBounds); });
+  unsetEntityModels(copiedNodes);
+  unsetEntityDefinitions(copiedNodes);
+  unsetTextures(copiedNodes);
+
+  m_copiedNodesText = stream.str();
+  m_copiedNodes = kdl::vec_transform(
+    std::move(copiedNodes), [](auto* node) { return std::unique_ptr<Model::Node>{node}; });
+  return m_copiedNodesText;
 }
 
 std::string MapDocument::serializeSelectedBrushFaces()
@@ -704,10 +784,69 @@ static auto getLinkedGroupIdsRecursively(const std::vector<Model::Node*>& nodes)
   return kdl::vec_sort_and_remove_duplicates(std::move(linkedGroupIds));
 }
 
+/**
+ * Unlinks the linked groups among the given nodes and their descendants whose linked
+ * group ID occurs only once and is not among the given IDs of the linked groups to keep.
+ * This is what the map reader does when the nodes are parsed.
+ */
+static void unlinkOrphanedLinkedGroups(
+  const std::vector<Model::Node*>& nodes,
+  const std::vector<std::string>& linkedGroupsToKeep,
+  Logger& logger)
+{
+  auto linkedGroupIds = std::vector<std::string>{};
+  getLinkedGroupIdsRecursively(nodes, std::back_inserter(linkedGroupIds));
+  std::sort(linkedGroupIds.begin(), linkedGroupIds.end());
+
+  const auto isOrphaned = [&](const auto& linkedGroupId) {
+    const auto [first, last] =
+      std::equal_range(linkedGroupIds.begin(), linkedGroupIds.end(), linkedGroupId);
+    return std::distance(first, last) == 1
+           && !std::binary_search(
+             linkedGroupsToKeep.begin(), linkedGroupsToKeep.end(), linkedGroupId);
+  };
+
+  Model::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [](auto&& thisLambda, Model::WorldNode* worldNode) {
+        worldNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, Model::LayerNode* layerNode) {
+        layerNode->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, Model::GroupNode* groupNode) {
+        if (const auto linkedGroupId = groupNode->group().linkedGroupId();
+            linkedGroupId && isOrphaned(*linkedGroupId))
+        {
+          logger.error() << "Unlinking orphaned linked group with ID '" << *linkedGroupId
+                         << "'";
+          auto group = groupNode->group();
+          group.resetLinkedGroupId();
+          groupNode->setGroup(std::move(group));
+        }
+        groupNode->visitChildren(thisLambda);
+      },
+      [](Model::EntityNode*) {},
+      [](Model::BrushNode*) {},
+      [](Model::PatchNode*) {}));
+}
+
 PasteType MapDocument::paste(const std::string& str)
 {
   const auto linkedGroupIds = getLinkedGroupIdsRecursively({m_world.get()});
 
+  if (!m_copiedNodes.empty() && str == m_copiedNodesText)
+  {
+    // the text was copied from this document, so clone the copied nodes instead of
+    // parsing it
+    auto nodes = kdl::vec_parallel_transform(
+      kdl::vec_transform(m_copiedNodes, [](const auto& node) { return node.get(); }),
+      [&](const auto* node) { return node->cloneRecursively(m_worldBounds); });
+    unlinkOrphanedLinkedGroups(nodes, linkedGroupIds, logger());
+    return pasteNodes(nodes) ? PasteType::Node : PasteType::Failed;
+  }
+
   // Try parsing as entities, then as brushes, in all compatible formats
   const std::vector<Model::Node*> nodes = m_game->parseNodes(
     str, m_world->mapFormat(), m_worldBounds, linkedGroupIds, logger());
@@ -1061,6 +1200,11 @@ std::vector<Model::EntityNodeBase*> MapDocument::allSelectedEntityNodes() const
 
 std::vector<Model::BrushNode*> MapDocument::allSelectedBrushNodes() const
 {
+  if (m_selectedNodes.hasOnlyBrushes())
+  {
+    return m_selectedNodes.brushes();
+  }
+
   auto brushes = std::vector<Model::BrushNode*>{};
   for (auto* node : m_selectedNodes.nodes())
   {
@@ -1084,6 +1228,11 @@ bool MapDocument::hasAnySelectedBrushNodes() const
 {
   // This is just an optimization of `!allSelectedBrushNodes().empty()`
   // that stops after finding the first brush
+  if (m_selectedNodes.hasBrushes())
+  {
+    return true;
+  }
+
   const auto visitChildrenAndExitEarly = [](auto&& thisLambda, const auto* node) {
     for (const auto* child : node->children())
     {
@@ -1482,6 +1631,26 @@ void MapDocument::invalidateSelectionBounds()
   m_selectionBoundsValid = false;
 }
 
+void MapDocument::addToSelectionBounds(const std::vector<Model::Node*>& nodes)
+{
+  if (m_selectionBoundsValid && !nodes.empty())
+  {
+    m_selectionBounds = vm::merge(m_selectionBounds, computeLogicalBounds(nodes));
+  }
+}
+
+void MapDocument::removeFromSelectionBounds(const std::vector<Model::Node*>& nodes)
+{
+  // the remaining selection bounds are unchanged if none of the removed nodes touched
+  // the boundary of the selection bounds
+  if (
+    !m_selectionBoundsValid || !hasSelectedNodes()
+    || !m_selectionBounds.encloses(computeLogicalBounds(nodes, m_selectionBounds)))
+  {
+    invalidateSelectionBounds();
+  }
+}
+
 void MapDocument::validateSelectionBounds() const
 {
   m_selectionBounds = computeLogicalBounds(m_selectedNodes.nodes());
@@ -1774,10 +1943,19 @@ void MapDocument::duplicateObjects()
   auto nodesToSelect = std::vector<Model::Node*>{};
   auto newParentMap = std::map<Model::Node*, Model::Node*>{};
 
-  for (Model::Node* original : selectedNodes().nodes())
+  const auto& originals = selectedNodes().nodes();
+
+  // the selected nodes are cloned independently of each other, so clone them in parallel
+  const auto clones =
+    kdl::vec_parallel_transform(originals, [&](const Model::Node* original) {
+      return original->cloneRecursively(m_worldBounds);
+    });
+
+  for (size_t i = 0; i < originals.size(); ++i)
   {
+    Model::Node* original = originals[i];
     Model::Node* suggestedParent = parentForNodes(std::vector<Model::Node*>{original});
-    Model::Node* clone = original->cloneRecursively(m_worldBounds);
+    Model::Node* clone = clones[i];
 
     if (shouldCloneParentWhenCloningNode(original))
     {
@@ -3028,6 +3206,70 @@ bool MapDocument::createBrush(const std::vector<vm::vec3>& points)
     .is_success();
 }
 
+/**
+ * Returns the given points without some of the points that cannot be vertices of their
+ * convex hull.
+ *
+ * For large inputs, the points lying strictly inside of the hull of the extreme points in a
+ * few fixed directions are discarded in parallel, so that the convex hull is only computed
+ * for the remaining points. The order of the remaining points is preserved because the
+ * convex hull algorithm is sensitive to it.
+ */
+static std::vector<vm::vec3> discardInteriorPoints(std::vector<vm::vec3> points)
+{
+  static constexpr auto MinPointCountForFiltering = size_t(256);
+
+  if (points.size() < MinPointCountForFiltering)
+  {
+    return points;
+  }
+
+  // the coordinate axes and the diagonals of the unit cube
+  const auto directions = std::array<vm::vec3, 7>{
+    vm::vec3{1, 0, 0},
+    vm::vec3{0, 1, 0},
+    vm::vec3{0, 0, 1},
+    vm::vec3{1, 1, 1},
+    vm::vec3{1, 1, -1},
+    vm::vec3{1, -1, 1},
+    vm::vec3{-1, 1, 1},
+  };
+
+  auto extremePoints = std::vector<vm::vec3>{};
+  for (const auto& direction : directions)
+  {
+    const auto [min, max] = std::minmax_element(
+      points.begin(), points.end(), [&](const auto& lhs, const auto& rhs) {
+        return vm::dot(lhs, direction) < vm::dot(rhs, direction);
+      });
+    extremePoints.push_back(*min);
+    extremePoints.push_back(*max);
+  }
+
+  const auto core = Model::Polyhedron3{std::move(extremePoints)};
+  if (!core.polyhedron() || !core.closed())
+  {
+    return points;
+  }
+
+  auto planes = std::vector<vm::plane3>{};
+  for (const auto* face : core.faces())
+  {
+    planes.push_back(face->plane());
+  }
+
+  // std::vector<bool> cannot be written to concurrently
+  auto interior = std::vector<char>(points.size(), 0);
+  kdl::parallel_for(points.size(), [&](const size_t i) {
+    interior[i] = std::all_of(planes.begin(), planes.end(), [&](const auto& plane) {
+      return plane.point_status(points[i]) == vm::plane_status::below;
+    });
+  });
+
+  return kdl::vec_filter(
+    std::move(points), [&](const auto&, const size_t i) { return !interior[i]; });
+}
+
 bool MapDocument::csgConvexMerge()
 {
   if (!hasSelectedBrushFaces() && !selectedNodes().hasOnlyBrushes())
@@ -3058,7 +3300,7 @@ bool MapDocument::csgConvexMerge()
     }
   }
 
-  auto polyhedron = Model::Polyhedron3{std::move(points)};
+  auto polyhedron = Model::Polyhedron3{discardInteriorPoints(std::move(points))};
   if (!polyhedron.polyhedron() || !polyhedron.closed())
   {
     return false;
@@ -3128,17 +3370,24 @@ bool MapDocument::csgSubtract()
   auto toRemove =
     std::vector<Model::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
+  // the minuends are independent of each other, so they are subtracted from in parallel
+  const auto mapFormat = m_world->mapFormat();
+  const auto& textureName = currentTextureName();
+  auto subtractionResults =
+    kdl::vec_parallel_transform(minuendNodes, [&](auto* minuendNode) {
+      return std::make_pair(
+        minuendNode,
+        minuendNode->brush().subtract(mapFormat, m_worldBounds, textureName, subtrahends));
+    });
+
   return kdl::fold_results(
            kdl::vec_transform(
-             minuendNodes,
-             [&](auto* minuendNode) {
-               const auto& minuend = minuendNode->brush();
-               auto currentSubtractionResults = minuend.subtract(
-                 m_world->mapFormat(), m_worldBounds, currentTextureName(), subtrahends);
-
+             std::move(subtractionResults),
+             [&](auto&& subtractionResult) {
+               auto* minuendNode = subtractionResult.first;
                return kdl::fold_results(kdl::vec_filter(
-                                          std::move(currentSubtractionResults),
-                                          [](const auto r) { return r.is_success(); }))
+                                          std::move(subtractionResult.second),
+                                          [](const auto& r) { return r.is_success(); }))
                  .transform([&](auto currentBrushes) {
                    if (!currentBrushes.empty())
                    {
@@ -3617,34 +3866,57 @@ void MapDocument::setDefaultProperties(const Model::SetDefaultPropertyMode mode)
 bool MapDocument::extrudeBrushes(
   const std::vector<vm::polygon3>& faces, const vm::vec3& delta)
 {
-  const auto nodes = m_selectedNodes.nodes();
-  return applyAndSwap(
-    *this,
-    "Resize Brushes",
-    nodes,
-    findContainingLinkedGroups(*m_world, nodes),
-    kdl::overload(
-      [](Model::Layer&) { return true; },
-      [](Model::Group&) { return true; },
-      [](Model::Entity&) { return true; },
-      [&](Model::Brush& brush) {
-        const auto faceIndex = brush.findFace(faces);
-        if (!faceIndex)
+  const auto& brushNodes = m_selectedNodes.brushes();
+  const auto lockTextures = pref(Preferences::TextureLock);
+
+  // each brush is resized independently, so the brushes can be resized in parallel; an
+  // empty optional indicates that the brush does not have any of the given faces
+  auto resizedBrushes = kdl::vec_parallel_transform(
+    brushNodes, [&](Model::BrushNode* brushNode) -> Result<std::optional<Model::Brush>> {
+      const auto faceIndex = brushNode->brush().findFace(faces);
+      if (!faceIndex)
+      {
+        // we allow resizing only some of the brushes
+        return std::nullopt;
+      }
+
+      auto brush = brushNode->brush();
+      return brush.moveBoundary(m_worldBounds, *faceIndex, delta, lockTextures)
+        .transform([&]() { return std::make_optional(std::move(brush)); });
+    });
+
+  return kdl::fold_results(std::move(resizedBrushes))
+    .transform([&](auto brushes) {
+      auto nodesToUpdate = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+      for (size_t i = 0; i < brushNodes.size(); ++i)
+      {
+        if (auto& brush = brushes[i])
         {
-          // we allow resizing only some of the brushes
-          return true;
+          if (!m_worldBounds.contains(brush->bounds()))
+          {
+            return false;
+          }
+          nodesToUpdate.emplace_back(
+            brushNodes[i], Model::NodeContents{std::move(*brush)});
         }
+      }
 
-        return brush
-          .moveBoundary(m_worldBounds, *faceIndex, delta, pref(Preferences::TextureLock))
-          .transform([&]() { return m_worldBounds.contains(brush.bounds()); })
-          .transform_error([&](auto e) {
-            error() << "Could not resize brush: " << e.msg;
-            return false;
-          })
-          .value();
-      },
-      [](Model::BezierPatch&) { return true; }));
+      if (nodesToUpdate.empty())
+      {
+        return true;
+      }
+
+      auto changedLinkedGroups = findContainingLinkedGroups(
+        *m_world,
+        kdl::vec_transform(nodesToUpdate, [](const auto& p) { return p.first; }));
+      return swapNodeContents(
+        "Resize Brushes", std::move(nodesToUpdate), std::move(changedLinkedGroups));
+    })
+    .transform_error([&](auto e) {
+      error() << "Could not resize brush: " << e.msg;
+      return false;
+    })
+    .value();
 }
 
 bool MapDocument::setFaceAttributes(const Model::BrushFaceAttributes& attributes)
@@ -4184,6 +4456,11 @@ const std::string& MapDocument::redoCommandName() const
   return doGetRedoCommandName();
 }
 
+size_t MapDocument::undoMemorySize() const
+{
+  return doGetUndoMemorySize();
+}
+
 void MapDocument::undoCommand()
 {
   doUndoCommand();
@@ -4218,6 +4495,9 @@ void MapDocument::startTransaction(std::string name, const TransactionScope scop
   debug("Starting transaction '" + name + "'");
   doStartTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
+
+  // the node tree is updated once when the transaction ends
+  m_world->deferNodeTreeUpdates();
 }
 
 void MapDocument::rollbackTransaction()
@@ -4234,11 +4514,13 @@ bool MapDocument::commitTransaction()
   if (!updateLinkedGroups())
   {
     rollbackTransaction();
+    m_world->applyDeferredNodeTreeUpdates();
     return false;
   }
 
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  m_world->applyDeferredNodeTreeUpdates();
   return true;
 }
 
@@ -4249,6 +4531,13 @@ void MapDocument::cancelTransaction()
   m_repeatStack->rollbackTransaction();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  m_world->applyDeferredNodeTreeUpdates();
+
+  // the document was restored to its state before the transaction was started
+  if (!isTransactionRunning())
+  {
+    clearChangeSet();
+  }
 }
 
 std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command)
@@ -4265,6 +4554,12 @@ std::unique_ptr<CommandResult> MapDocument::executeAndStore(
 void MapDocument::commitPendingAssets()
 {
   m_textureManager->commitChanges();
+  commitEntityModels();
+}
+
+bool MapDocument::hasPendingAssets() const
+{
+  return m_textureManager->hasPendingChanges() || m_entityModelManager->hasPendingModels();
 }
 
 void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const
@@ -4275,6 +4570,17 @@ void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) c
   }
 }
 
+void MapDocument::pickNearest(
+  const vm::ray3& pickRay,
+  const Model::HitFilter& filter,
+  Model::PickResult& pickResult) const
+{
+  if (m_world)
+  {
+    m_world->pickNearest(*m_editorContext, pickRay, filter, pickResult);
+  }
+}
+
 std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const
 {
   auto result = std::vector<Model::Node*>{};
@@ -4307,6 +4613,8 @@ Result<void> MapDocument::loadWorld(
   std::shared_ptr<Model::Game> game,
   const std::filesystem::path& path)
 {
+  traceZone("MapDocument::loadWorld");
+
   return game->loadMap(mapFormat, m_worldBounds, path, logger())
     .transform([&](auto world) {
       m_worldBounds = worldBounds;
@@ -4321,6 +4629,8 @@ Result<void> MapDocument::loadWorld(
 
 void MapDocument::clearWorld()
 {
+  m_copiedNodesText.clear();
+  m_copiedNodes.clear();
   m_world.reset();
   m_currentLayer = nullptr;
 }
@@ -4372,6 +4682,7 @@ void MapDocument::reloadTextureCollections()
     textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
 
   info("Reloading texture collections");
+  m_game->refreshFileSystem();
   reloadTextures();
   setTextures();
   initializeAllNodeTags(this);
@@ -4386,10 +4697,13 @@ void MapDocument::reloadEntityDefinitions()
     entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
 
   info("Reloading entity definitions");
+  m_game->refreshFileSystem();
 }
 
 void MapDocument::loadAssets()
 {
+  traceZone("MapDocument::loadAssets");
+
   loadEntityDefinitions();
   setEntityDefinitions();
   loadEntityModels();
@@ -4438,6 +4752,8 @@ void MapDocument::unloadEntityDefinitions()
 
 void MapDocument::loadEntityModels()
 {
+  traceZone("MapDocument::loadEntityModels");
+
   m_entityModelManager->setLoader(m_game.get());
   setEntityModels();
 }
@@ -4458,6 +4774,8 @@ void MapDocument::reloadTextures()
 
 void MapDocument::loadTextures()
 {
+  traceZone("MapDocument::loadTextures");
+
   try
   {
     if (const auto* wadStr = m_world->entity().property(Model::EntityPropertyKeys::Wad))
@@ -4481,58 +4799,116 @@ void MapDocument::unloadTextures()
   m_textureManager->clear();
 }
 
-static auto makeSetTexturesVisitor(Assets::TextureManager& manager)
+/**
+ * Returns the brushes and patches among the given nodes and their descendants.
+ */
+static std::tuple<std::vector<Model::BrushNode*>, std::vector<Model::PatchNode*>>
+collectTexturedNodes(const std::vector<Model::Node*>& nodes)
 {
-  return kdl::overload(
-    [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::EntityNode* entity) {
-      entity->visitChildren(thisLambda);
-    },
-    [&](Model::BrushNode* brushNode) {
-      const Model::Brush& brush = brushNode->brush();
+  auto brushNodes = std::vector<Model::BrushNode*>{};
+  auto patchNodes = std::vector<Model::PatchNode*>{};
+  Model::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+      [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+      [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+      [](auto&& thisLambda, Model::EntityNode* entity) {
+        entity->visitChildren(thisLambda);
+      },
+      [&](Model::BrushNode* brushNode) { brushNodes.push_back(brushNode); },
+      [&](Model::PatchNode* patchNode) { patchNodes.push_back(patchNode); }));
+
+  // the given nodes may contain both a node and one of its ancestors
+  brushNodes = kdl::vec_sort_and_remove_duplicates(std::move(brushNodes));
+
+  return {std::move(brushNodes), std::move(patchNodes)};
+}
+
+/**
+ * Calls the given functions for the given brushes and patches. Every brush face holds its
+ * own reference to its texture, and the usage counts of the textures are atomic, so the
+ * brushes are processed in parallel.
+ */
+template <typename UpdateBrushNode, typename UpdatePatchNode>
+static void updateTextures(
+  const std::vector<Model::BrushNode*>& brushNodes,
+  const std::vector<Model::PatchNode*>& patchNodes,
+  const UpdateBrushNode& updateBrushNode,
+  const UpdatePatchNode& updatePatchNode)
+{
+  kdl::parallel_for(
+    brushNodes.size(), [&](const size_t i) { updateBrushNode(*brushNodes[i]); });
+
+  for (auto* patchNode : patchNodes)
+  {
+    updatePatchNode(*patchNode);
+  }
+}
+
+static void setNodeTextures(
+  const std::vector<Model::Node*>& nodes, Assets::TextureManager& manager)
+{
+  const auto [brushNodes, patchNodes] = collectTexturedNodes(nodes);
+
+  // Face texture names are interned, so every distinct name is looked up in the texture
+  // manager only once and the faces find their textures by the address of their name.
+  auto texturesByName = std::unordered_map<const std::string*, Assets::Texture*>{};
+  for (const auto* brushNode : brushNodes)
+  {
+    for (const auto& face : brushNode->brush().faces())
+    {
+      texturesByName.try_emplace(&face.attributes().textureName(), nullptr);
+    }
+  }
+  for (auto& [textureName, texture] : texturesByName)
+  {
+    texture = manager.texture(*textureName);
+  }
+
+  updateTextures(
+    brushNodes,
+    patchNodes,
+    [&](Model::BrushNode& brushNode) {
+      const Model::Brush& brush = brushNode.brush();
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
         const Model::BrushFace& face = brush.face(i);
-        Assets::Texture* texture = manager.texture(face.attributes().textureName());
-        brushNode->setFaceTexture(i, texture);
+        auto* texture = texturesByName.at(&face.attributes().textureName());
+        brushNode.setFaceTexture(i, texture);
       }
     },
-    [&](Model::PatchNode* patchNode) {
-      auto* texture = manager.texture(patchNode->patch().textureName());
-      patchNode->setTexture(texture);
+    [&](Model::PatchNode& patchNode) {
+      auto* texture = manager.texture(patchNode.patch().textureName());
+      patchNode.setTexture(texture);
     });
 }
 
-static auto makeUnsetTexturesVisitor()
+static void unsetNodeTextures(const std::vector<Model::Node*>& nodes)
 {
-  return kdl::overload(
-    [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-    [](auto&& thisLambda, Model::EntityNode* entity) {
-      entity->visitChildren(thisLambda);
-    },
-    [](Model::BrushNode* brushNode) {
-      const Model::Brush& brush = brushNode->brush();
+  const auto [brushNodes, patchNodes] = collectTexturedNodes(nodes);
+  updateTextures(
+    brushNodes,
+    patchNodes,
+    [](Model::BrushNode& brushNode) {
+      const Model::Brush& brush = brushNode.brush();
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
-        brushNode->setFaceTexture(i, nullptr);
+        brushNode.setFaceTexture(i, nullptr);
       }
     },
-    [](Model::PatchNode* patchNode) { patchNode->setTexture(nullptr); });
+    [](Model::PatchNode& patchNode) { patchNode.setTexture(nullptr); });
 }
 
 void MapDocument::setTextures()
 {
-  m_world->accept(makeSetTexturesVisitor(*m_textureManager));
+  setNodeTextures({m_world.get()}, *m_textureManager);
   textureUsageCountsDidChangeNotifier();
 }
 
 void MapDocument::setTextures(const std::vector<Model::Node*>& nodes)
 {
-  Model::Node::visitAll(nodes, makeSetTexturesVisitor(*m_textureManager));
+  setNodeTextures(nodes, *m_textureManager);
   textureUsageCountsDidChangeNotifier();
 }
 
@@ -4550,13 +4926,13 @@ void MapDocument::setTextures(const std::vector<Model::BrushFaceHandle>& faceHan
 
 void MapDocument::unsetTextures()
 {
-  m_world->accept(makeUnsetTexturesVisitor());
+  unsetNodeTextures({m_world.get()});
   textureUsageCountsDidChangeNotifier();
 }
 
 void MapDocument::unsetTextures(const std::vector<Model::Node*>& nodes)
 {
-  Model::Node::visitAll(nodes, makeUnsetTexturesVisitor());
+  unsetNodeTextures(nodes);
   textureUsageCountsDidChangeNotifier();
 }
 
@@ -4660,6 +5036,67 @@ static auto makeUnsetEntityModelsVisitor()
     [](Model::PatchNode*) {});
 }
 
+static std::filesystem::path entityModelPath(const Model::EntityNode& entityNode)
+{
+  // errors were already reported when the entity's model was set
+  auto logger = NullLogger{};
+  return Assets::safeGetModelSpecification(
+           logger,
+           entityNode.entity().classname(),
+           [&]() { return entityNode.entity().modelSpecification(); })
+    .path;
+}
+
+static std::vector<Model::EntityNode*> collectEntityNodes(Model::WorldNode& world)
+{
+  auto result = std::vector<Model::EntityNode*>{};
+  world.accept(kdl::overload(
+    [](auto&& thisLambda, Model::WorldNode* worldNode) {
+      worldNode->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](Model::EntityNode* entityNode) { result.push_back(entityNode); },
+    [](Model::BrushNode*) {},
+    [](Model::PatchNode*) {}));
+  return result;
+}
+
+void MapDocument::commitEntityModels()
+{
+  const auto loadedModels = m_entityModelManager->commitLoadedModels();
+  if (!loadedModels.empty() && m_world)
+  {
+    // entities that use the loaded models have no model frame yet
+    const auto loadedModelSet = kdl::vector_set<std::filesystem::path>(loadedModels);
+    const auto nodes = kdl::vec_element_cast<Model::Node*>(kdl::vec_filter(
+      collectEntityNodes(*m_world), [&](const auto* entityNode) {
+        return loadedModelSet.count(entityModelPath(*entityNode)) > 0;
+      }));
+
+    if (!nodes.empty())
+    {
+      NotifyBeforeAndAfter notifyNodes(
+        nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+      setEntityModels(nodes);
+    }
+  }
+
+  auto evictedModels = std::vector<std::filesystem::path>{};
+  if (m_entityModelManager->shouldEvictModels() && m_world)
+  {
+    const auto usedModels = kdl::vec_transform(
+      collectEntityNodes(*m_world),
+      [](const auto* entityNode) { return entityModelPath(*entityNode); });
+    evictedModels = m_entityModelManager->evictUnusedModels(usedModels);
+  }
+
+  if (!loadedModels.empty() || !evictedModels.empty())
+  {
+    entityModelsDidChangeNotifier();
+  }
+}
+
 void MapDocument::setEntityModels()
 {
   m_world->accept(makeSetEntityModelsVisitor(*this, *m_entityModelManager));
@@ -4915,19 +5352,21 @@ void MapDocument::clearNodeTags(const std::vector<Model::Node*>& nodes)
 
 void MapDocument::updateNodeTags(const std::vector<Model::Node*>& nodes)
 {
-  for (auto* node : nodes)
-  {
-    node->updateTags(*m_tagManager);
-  }
+  // updating the tags of a node only modifies the node itself and its faces, so distinct
+  // nodes can be updated in parallel
+  const auto uniqueNodes = kdl::vec_sort_and_remove_duplicates(nodes);
+  kdl::parallel_for(uniqueNodes.size(), [&](const size_t i) {
+    uniqueNodes[i]->updateTags(*m_tagManager);
+  });
 }
 
 void MapDocument::updateFaceTags(const std::vector<Model::BrushFaceHandle>& faceHandles)
 {
-  for (const auto& faceHandle : faceHandles)
-  {
+  kdl::parallel_for(faceHandles.size(), [&](const size_t i) {
+    const auto& faceHandle = faceHandles[i];
     Model::BrushNode* node = faceHandle.node();
     node->updateFaceTags(faceHandle.faceIndex(), *m_tagManager);
-  }
+  });
 }
 
 void MapDocument::updateAllFaceTags()
@@ -5019,6 +5458,16 @@ void MapDocument::connectObservers()
   m_notifierConnection +=
     transactionUndoneNotifier.connect(this, &MapDocument::transactionUndone);
 
+  // change set
+  m_notifierConnection +=
+    nodesWereAddedNotifier.connect(this, &MapDocument::nodesWereAddedToChangeSet);
+  m_notifierConnection += nodesWillBeRemovedNotifier.connect(
+    this, &MapDocument::nodesWillBeRemovedFromChangeSet);
+  m_notifierConnection +=
+    nodesDidChangeNotifier.connect(this, &MapDocument::nodesDidChangeInChangeSet);
+  m_notifierConnection += selectionDidChangeNotifier.connect(
+    this, &MapDocument::selectionDidChangeInChangeSet);
+
   // tag management
   m_notifierConnection +=
     documentWasNewedNotifier.connect(this, &MapDocument::initializeAllNodeTags);
@@ -5082,9 +5531,11 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
   {
     const Model::GameFactory& gameFactory = Model::GameFactory::instance();
     const std::filesystem::path newGamePath = gameFactory.gamePath(m_game->gameName());
-    m_game->setGamePath(newGamePath, logger());
 
+    // models may be loading in the background, so they must be cleared before the game's
+    // file system changes
     clearEntityModels();
+    m_game->setGamePath(newGamePath, logger());
     setEntityModels();
 
     reloadTextures();
@@ -5099,6 +5550,26 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
     m_textureManager->setTextureMode(
       pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
   }
+  else if (path == Preferences::EntityModelMemoryBudget.path())
+  {
+    m_entityModelManager->setMemoryBudget(entityModelMemoryBudget());
+  }
+  else if (path == Preferences::TextureCacheDirectory().path())
+  {
+    m_textureManager->setCacheDirectory(pref(Preferences::TextureCacheDirectory()));
+  }
+  else if (path == Preferences::CompressTextures.path())
+  {
+    m_textureManager->setCompressTextures(pref(Preferences::CompressTextures));
+  }
+  else if (path == Preferences::GenerateMipmaps.path())
+  {
+    m_textureManager->setGenerateMipmaps(pref(Preferences::GenerateMipmaps));
+  }
+  else if (path == Preferences::UndoMemoryBudget.path())
+  {
+    doUpdateUndoMemoryBudget();
+  }
 }
 
 void MapDocument::commandDone(Command& command)
@@ -5114,11 +5585,77 @@ void MapDocument::commandUndone(UndoableCommand& command)
 void MapDocument::transactionDone(const std::string& name)
 {
   debug() << "Transaction '" << name << "' executed";
+  commitChangeSet();
 }
 
 void MapDocument::transactionUndone(const std::string& name)
 {
   debug() << "Transaction '" << name << "' undone";
+  commitChangeSet();
+}
+
+void MapDocument::nodesWereAddedToChangeSet(const std::vector<Model::Node*>& nodes)
+{
+  m_pendingAddedNodes.insert(nodes.begin(), nodes.end());
+}
+
+static void eraseSubtree(std::unordered_set<Model::Node*>& nodes, Model::Node* node)
+{
+  nodes.erase(node);
+  for (auto* child : node->children())
+  {
+    eraseSubtree(nodes, child);
+  }
+}
+
+void MapDocument::nodesWillBeRemovedFromChangeSet(const std::vector<Model::Node*>& nodes)
+{
+  // removed nodes may be deleted before the change set is committed
+  for (auto* node : nodes)
+  {
+    eraseSubtree(m_pendingAddedNodes, node);
+    eraseSubtree(m_pendingChangedNodes, node);
+  }
+  m_pendingNodesWereRemoved = true;
+}
+
+void MapDocument::nodesDidChangeInChangeSet(const std::vector<Model::Node*>& nodes)
+{
+  m_pendingChangedNodes.insert(nodes.begin(), nodes.end());
+}
+
+void MapDocument::selectionDidChangeInChangeSet(const Selection&)
+{
+  m_pendingSelectionDidChange = true;
+}
+
+void MapDocument::commitChangeSet()
+{
+  if (isTransactionRunning())
+  {
+    return;
+  }
+
+  auto changeSet = DocumentChangeSet{
+    {m_pendingAddedNodes.begin(), m_pendingAddedNodes.end()},
+    {m_pendingChangedNodes.begin(), m_pendingChangedNodes.end()},
+    m_pendingNodesWereRemoved,
+    m_pendingSelectionDidChange,
+  };
+  clearChangeSet();
+
+  if (!changeSet.empty())
+  {
+    changeSetDidCommitNotifier(changeSet);
+  }
+}
+
+void MapDocument::clearChangeSet()
+{
+  m_pendingAddedNodes.clear();
+  m_pendingChangedNodes.clear();
+  m_pendingNodesWereRemoved = false;
+  m_pendingSelectionDidChange = false;
 }
 
 Transaction::Transaction(std::weak_ptr<MapDocument> document, std::string name)
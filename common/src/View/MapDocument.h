@@ -21,6 +21,7 @@
 
 #include "FloatType.h"
 #include "Model/Game.h"
+#include "Model/HitFilter.h"
 #include "Model/MapFacade.h"
 #include "Model/NodeCollection.h"
 #include "Model/NodeContents.h"
@@ -36,10 +37,12 @@
 #include <vecmath/util.h>
 
 #include <filesystem>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -105,6 +108,21 @@ struct PortalFile
   std::filesystem::path path;
 };
 
+/**
+ * Summarizes the node and selection changes made by an outermost transaction (or an
+ * undo / redo). Nodes that were added and removed again within the same transaction are
+ * not contained.
+ */
+struct DocumentChangeSet
+{
+  std::vector<Model::Node*> addedNodes;
+  std::vector<Model::Node*> changedNodes;
+  bool nodesWereRemoved = false;
+  bool selectionDidChange = false;
+
+  bool empty() const;
+};
+
 class MapDocument : public Model::MapFacade, public CachingLogger
 {
 public:
@@ -146,6 +164,14 @@ protected:
 
   ViewEffectsService* m_viewEffectsService;
 
+  /**
+   * Clones of the most recently copied nodes and the text they were serialized to. If
+   * the text is pasted into this document again, the clones are cloned instead of
+   * parsing the text. The clones do not reference any textures or entity definitions.
+   */
+  std::string m_copiedNodesText;
+  std::vector<std::unique_ptr<Model::Node>> m_copiedNodes;
+
   /*
    * All actions pushed to this stack can be repeated later. The stack must be
    * primed to be cleared whenever the selection changes. The effect is that
@@ -155,6 +181,14 @@ protected:
    */
   std::unique_ptr<RepeatStack> m_repeatStack;
 
+  /*
+   * Collects the changes of the currently executing transaction until it is committed.
+   */
+  std::unordered_set<Model::Node*> m_pendingAddedNodes;
+  std::unordered_set<Model::Node*> m_pendingChangedNodes;
+  bool m_pendingNodesWereRemoved;
+  bool m_pendingSelectionDidChange;
+
 public: // notification
   Notifier<Command&> commandDoNotifier;
   Notifier<Command&> commandDoneNotifier;
@@ -201,6 +235,8 @@ public: // notification
   Notifier<> entityDefinitionsWillChangeNotifier;
   Notifier<> entityDefinitionsDidChangeNotifier;
 
+  Notifier<> entityModelsDidChangeNotifier;
+
   Notifier<> modsWillChangeNotifier;
   Notifier<> modsDidChangeNotifier;
 
@@ -210,6 +246,13 @@ public: // notification
   Notifier<> portalFileWasLoadedNotifier;
   Notifier<> portalFileWasUnloadedNotifier;
 
+  /**
+   * Notified once after the outermost transaction was committed, undone or redone.
+   * Observers that don't need to react to intermediate states should prefer this over
+   * the fine grained node notifiers.
+   */
+  Notifier<const DocumentChangeSet&> changeSetDidCommitNotifier;
+
 private:
   NotifierConnection m_notifierConnection;
 
@@ -307,7 +350,9 @@ public: // new, load, save document
   void saveDocument();
   void saveDocumentAs(const std::filesystem::path& path);
   void saveDocumentTo(const std::filesystem::path& path);
+  void saveDocumentTo(std::ostream& stream);
   Result<void> exportDocumentAs(const IO::ExportOptions& options);
+  void exportDocumentTo(std::ostream& stream);
 
 private:
   void doSaveDocument(const std::filesystem::path& path);
@@ -412,6 +457,8 @@ public: // selection
 protected:
   void updateLastSelectionBounds();
   void invalidateSelectionBounds();
+  void addToSelectionBounds(const std::vector<Model::Node*>& nodes);
+  void removeFromSelectionBounds(const std::vector<Model::Node*>& nodes);
 
 private:
   void validateSelectionBounds() const;
@@ -641,6 +688,7 @@ public: // command processing
   bool canRedoCommand() const;
   const std::string& undoCommandName() const;
   const std::string& redoCommandName() const;
+  size_t undoMemorySize() const;
   void undoCommand();
   void redoCommand();
   bool canRepeatCommands() const;
@@ -654,6 +702,7 @@ public: // transactions
   void cancelTransaction();
 
   virtual bool isCurrentDocumentStateObservable() const = 0;
+  virtual bool isTransactionRunning() const = 0;
 
 private:
   std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
@@ -665,6 +714,8 @@ private: // subclassing interface for command processing
   virtual bool doCanRedoCommand() const = 0;
   virtual const std::string& doGetUndoCommandName() const = 0;
   virtual const std::string& doGetRedoCommandName() const = 0;
+  virtual size_t doGetUndoMemorySize() const = 0;
+  virtual void doUpdateUndoMemoryBudget() = 0;
   virtual void doUndoCommand() = 0;
   virtual void doRedoCommand() = 0;
 
@@ -679,9 +730,14 @@ private: // subclassing interface for command processing
 
 public: // asset state management
   void commitPendingAssets();
+  bool hasPendingAssets() const;
 
 public: // picking
   void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+  void pickNearest(
+    const vm::ray3& pickRay,
+    const Model::HitFilter& filter,
+    Model::PickResult& pickResult) const;
   std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
 
 private: // world management
@@ -735,6 +791,7 @@ protected:
   void reloadEntityDefinitionsInternal();
 
   void clearEntityModels();
+  void commitEntityModels();
 
   void setEntityModels();
   void setEntityModels(const std::vector<Model::Node*>& nodes);
@@ -809,6 +866,13 @@ private: // observers
   void commandUndone(UndoableCommand& command);
   void transactionDone(const std::string& name);
   void transactionUndone(const std::string& name);
+
+  void nodesWereAddedToChangeSet(const std::vector<Model::Node*>& nodes);
+  void nodesWillBeRemovedFromChangeSet(const std::vector<Model::Node*>& nodes);
+  void nodesDidChangeInChangeSet(const std::vector<Model::Node*>& nodes);
+  void selectionDidChangeInChangeSet(const Selection& selection);
+  void commitChangeSet();
+  void clearChangeSet();
 };
 
 class Transaction
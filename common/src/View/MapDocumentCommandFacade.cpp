@@ -54,6 +54,7 @@
 #include <vecmath/polygon.h>
 #include <vecmath/segment.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -69,9 +70,16 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument()
   return std::shared_ptr<MapDocument>(new MapDocumentCommandFacade());
 }
 
+static size_t undoMemoryBudget()
+{
+  const auto budgetInMiB = std::max(pref(Preferences::UndoMemoryBudget), 0);
+  return size_t(budgetInMiB) * 1024u * 1024u;
+}
+
 MapDocumentCommandFacade::MapDocumentCommandFacade()
   : m_commandProcessor(std::make_unique<CommandProcessor>(this))
 {
+  m_commandProcessor->setMemoryBudget(undoMemoryBudget());
   connectObservers();
 }
 
@@ -101,13 +109,21 @@ void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& no
     }
   }
 
+  const auto hadSelectedNodes = hasSelectedNodes();
   m_selectedNodes.addNodes(selected);
 
   Selection selection;
   selection.addSelectedNodes(selected);
 
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
+  if (hadSelectedNodes)
+  {
+    addToSelectionBounds(selected);
+  }
+  else
+  {
+    invalidateSelectionBounds();
+  }
 }
 
 void MapDocumentCommandFacade::performSelect(
@@ -188,13 +204,21 @@ void MapDocumentCommandFacade::performDeselect(const std::vector<Model::Node*>&
     }
   }
 
-  m_selectedNodes.removeNodes(deselected);
+  if (deselected.size() == m_selectedNodes.nodeCount())
+  {
+    // avoid searching the selected nodes if everything gets deselected
+    m_selectedNodes.clear();
+  }
+  else
+  {
+    m_selectedNodes.removeNodes(deselected);
+  }
 
   Selection selection;
   selection.addDeselectedNodes(deselected);
 
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
+  removeFromSelectionBounds(deselected);
 }
 
 void MapDocumentCommandFacade::performDeselect(
@@ -220,7 +244,11 @@ void MapDocumentCommandFacade::performDeselect(
     }
   }
 
-  m_selectedBrushFaces = kdl::vec_erase_all(std::move(m_selectedBrushFaces), deselected);
+  const auto deselectedSet = kdl::vector_set<Model::BrushFaceHandle>{deselected};
+  m_selectedBrushFaces =
+    kdl::vec_filter(std::move(m_selectedBrushFaces), [&](const auto& handle) {
+      return deselectedSet.count(handle) == 0u;
+    });
 
   Selection selection;
   selection.addDeselectedBrushFaces(deselected);
@@ -269,6 +297,10 @@ void MapDocumentCommandFacade::performAddNodes(
   NotifyBeforeAndAfter notifyParents(
     nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
 
+  // add the nodes to the node tree all at once, which is much faster when pasting many
+  // nodes
+  m_world->disableNodeTreeUpdates();
+
   std::vector<Model::Node*> addedNodes;
   for (const auto& [parent, children] : nodes)
   {
@@ -276,6 +308,10 @@ void MapDocumentCommandFacade::performAddNodes(
     addedNodes = kdl::vec_concat(std::move(addedNodes), children);
   }
 
+  m_world->enableNodeTreeUpdates();
+  m_world->addToNodeTree(kdl::vec_filter(
+    addedNodes, [&](const auto* node) { return node->isDescendantOf(m_world.get()); }));
+
   setEntityDefinitions(addedNodes);
   setEntityModels(addedNodes);
   setTextures(addedNodes);
@@ -631,6 +667,11 @@ bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
   return m_commandProcessor->isCurrentDocumentStateObservable();
 }
 
+bool MapDocumentCommandFacade::isTransactionRunning() const
+{
+  return m_commandProcessor->isTransactionRunning();
+}
+
 bool MapDocumentCommandFacade::doCanUndoCommand() const
 {
   return m_commandProcessor->canUndo();
@@ -651,6 +692,16 @@ const std::string& MapDocumentCommandFacade::doGetRedoCommandName() const
   return m_commandProcessor->redoCommandName();
 }
 
+size_t MapDocumentCommandFacade::doGetUndoMemorySize() const
+{
+  return m_commandProcessor->undoStackMemorySize();
+}
+
+void MapDocumentCommandFacade::doUpdateUndoMemoryBudget()
+{
+  m_commandProcessor->setMemoryBudget(undoMemoryBudget());
+}
+
 void MapDocumentCommandFacade::doUndoCommand()
 {
   m_commandProcessor->undo();
@@ -122,11 +122,14 @@ private: // notification
 
 private: // implement MapDocument interface
   bool isCurrentDocumentStateObservable() const override;
+  bool isTransactionRunning() const override;
 
   bool doCanUndoCommand() const override;
   bool doCanRedoCommand() const override;
   const std::string& doGetUndoCommandName() const override;
   const std::string& doGetRedoCommandName() const override;
+  size_t doGetUndoMemorySize() const override;
+  void doUpdateUndoMemoryBudget() override;
   void doUndoCommand() override;
   void doRedoCommand() override;
 
@@ -24,6 +24,7 @@
 #include <QClipboard>
 #include <QComboBox>
 #include <QFileDialog>
+#include <QHeaderView>
 #include <QInputDialog>
 #include <QLabel>
 #include <QMessageBox>
@@ -38,10 +39,12 @@
 #include <QVBoxLayout>
 #include <QtGlobal>
 
+#include "Assets/TextureManager.h"
 #include "Console.h"
 #include "Error.h"
 #include "Exceptions.h"
 #include "FileLogger.h"
+#include "IO/DiskIO.h"
 #include "IO/ExportOptions.h"
 #include "IO/PathQt.h"
 #include "Model/BrushNode.h"
@@ -96,6 +99,8 @@
 #include <kdl/overload.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
+#include <kdl/vector_set.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
@@ -200,9 +205,13 @@ MapFrame::~MapFrame()
 
   // let's trigger a final autosave before releasing the document
   NullLogger logger;
+  m_autosaver->finishPendingAutosave(logger);
   m_autosaver->triggerAutosave(logger);
+  m_autosaver->finishPendingAutosave(logger);
 
   m_document->setViewEffectsService(nullptr);
+  // the background uploader is owned by the context manager
+  m_document->textureManager().setBackgroundUploader(nullptr);
   m_document.reset();
 
   // FIXME: m_contextManager is deleted via smart pointer; it may release openGL resources
@@ -759,6 +768,9 @@ static QString describeSelection(const MapDocument* document)
                                  hiddenDescriptors, ", ", ", and ", " and ")));
   }
 
+  const auto undoMemorySize = double(document->undoMemorySize()) / (1024.0 * 1024.0);
+  pipeSeparatedSections << QObject::tr("Undo: %1 MiB").arg(undoMemorySize, 0, 'f', 1);
+
   return QString::fromLatin1("   ")
          + pipeSeparatedSections.join(QLatin1String("   |   "));
 }
@@ -858,6 +870,7 @@ void MapFrame::transactionDone(const std::string& /* name */)
     // before it's pushed onto the undo stack, but we need to read the undo stack in
     // updateUndoRedoActions(), so this QTimer::singleShot is needed for now.
     updateUndoRedoActions();
+    updateStatusBarDelayed();
   });
 }
 
@@ -866,6 +879,7 @@ void MapFrame::transactionUndone(const std::string& /* name */)
   QTimer::singleShot(0, this, [this]() {
     // FIXME: see MapFrame::transactionDone
     updateUndoRedoActions();
+    updateStatusBarDelayed();
   });
 }
 
@@ -2192,11 +2206,11 @@ void MapFrame::showLaunchEngineDialog()
 
 static const Assets::Texture* textureToReveal(std::shared_ptr<MapDocument> document)
 {
-  kdl::vector_set<const Assets::Texture*> selectedTextures;
-  for (const Model::BrushFaceHandle& face : document->allSelectedBrushFaces())
-  {
-    selectedTextures.insert(face.face().texture());
-  }
+  auto textures = kdl::vec_transform(
+    document->allSelectedBrushFaces(),
+    [](const auto& face) -> const Assets::Texture* { return face.face().texture(); });
+  const auto selectedTextures =
+    kdl::vector_set<const Assets::Texture*>{std::move(textures)};
   if (selectedTextures.size() == 1)
   {
     return *selectedTextures.begin();
@@ -2348,6 +2362,17 @@ void MapFrame::debugShowPalette()
   showModelessDialog(window);
 }
 
+void MapFrame::debugShowMemoryUsage()
+{
+  auto* window = new DebugMemoryUsageWindow{
+    [&]() {
+      return collectMemoryUsage(
+        *m_document, m_mapView->mapRenderer(), m_contextManager->vboManager());
+    },
+    this};
+  showModelessDialog(window);
+}
+
 void MapFrame::focusChange(QWidget* /* oldFocus */, QWidget* newFocus)
 {
   if (auto* newMapView = dynamic_cast<MapViewBase*>(newFocus))
@@ -2606,5 +2631,72 @@ DebugPaletteWindow::DebugPaletteWindow(QWidget* parent)
 }
 
 DebugPaletteWindow::~DebugPaletteWindow() = default;
+
+DebugMemoryUsageWindow::DebugMemoryUsageWindow(
+  std::function<std::vector<MemoryUsageEntry>()> collect, QWidget* parent)
+  : QDialog{parent}
+  , m_collect{std::move(collect)}
+{
+  setWindowTitle(tr("Memory Usage"));
+
+  m_table = new QTableWidget{0, 2};
+  m_table->setHorizontalHeaderLabels({tr("Subsystem"), tr("Size (KiB)")});
+  m_table->verticalHeader()->setVisible(false);
+  m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+  auto* saveButton = new QPushButton{tr("Save as JSON...")};
+  connect(saveButton, &QPushButton::clicked, this, [&]() { saveAsJson(); });
+
+  auto* layout = new QVBoxLayout{};
+  layout->addWidget(m_table, 1);
+  layout->addWidget(saveButton);
+  setLayout(layout);
+
+  auto* timer = new QTimer{this};
+  connect(timer, &QTimer::timeout, this, [&]() { refresh(); });
+  timer->start(1000);
+
+  refresh();
+}
+
+DebugMemoryUsageWindow::~DebugMemoryUsageWindow() = default;
+
+void DebugMemoryUsageWindow::refresh()
+{
+  m_entries = m_collect();
+
+  auto total = size_t(0);
+  m_table->setRowCount(static_cast<int>(m_entries.size() + 1));
+  for (size_t i = 0; i < m_entries.size(); ++i)
+  {
+    const auto& entry = m_entries[i];
+    const auto row = static_cast<int>(i);
+    m_table->setItem(row, 0, new QTableWidgetItem{QString::fromStdString(entry.name)});
+    m_table->setItem(row, 1, new QTableWidgetItem{QString::number(entry.bytes / 1024)});
+    total += entry.bytes;
+  }
+
+  const auto totalRow = static_cast<int>(m_entries.size());
+  m_table->setItem(totalRow, 0, new QTableWidgetItem{tr("Total")});
+  m_table->setItem(totalRow, 1, new QTableWidgetItem{QString::number(total / 1024)});
+}
+
+void DebugMemoryUsageWindow::saveAsJson()
+{
+  const auto fileName = QFileDialog::getSaveFileName(
+    this, tr("Save Memory Usage"), "", "JSON files (*.json)");
+  if (fileName.isEmpty())
+  {
+    return;
+  }
+
+  const auto json = memoryUsageToJson(m_entries);
+  IO::Disk::withOutputStream(IO::pathFromQString(fileName), [&](auto& stream) {
+    stream << json;
+  }).transform_error([&](auto e) {
+    QMessageBox::critical(
+      this, tr("Error"), tr("Could not save memory usage: %1").arg(e.msg.c_str()));
+  });
+}
 } // namespace View
 } // namespace TrenchBroom
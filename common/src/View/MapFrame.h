@@ -27,13 +27,16 @@
 #include "Model/MapFormat.h"
 #include "NotifierConnection.h"
 #include "Result.h"
+#include "View/MemoryUsage.h"
 #include "View/Selection.h"
 
 #include <chrono>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 class QAction;
 class QComboBox;
@@ -42,6 +45,7 @@ class QDropEvent;
 class QMenuBar;
 class QLabel;
 class QSplitter;
+class QTableWidget;
 class QTimer;
 class QToolBar;
 
@@ -401,6 +405,7 @@ public:
   void debugThrowExceptionDuringCommand();
   void debugSetWindowSize();
   void debugShowPalette();
+  void debugShowMemoryUsage();
 
   void focusChange(QWidget* oldFocus, QWidget* newFocus);
 
@@ -432,5 +437,23 @@ public:
   DebugPaletteWindow(QWidget* parent = nullptr);
   virtual ~DebugPaletteWindow();
 };
+
+class DebugMemoryUsageWindow : public QDialog
+{
+  Q_OBJECT
+private:
+  std::function<std::vector<MemoryUsageEntry>()> m_collect;
+  std::vector<MemoryUsageEntry> m_entries;
+  QTableWidget* m_table{nullptr};
+
+public:
+  explicit DebugMemoryUsageWindow(
+    std::function<std::vector<MemoryUsageEntry>()> collect, QWidget* parent = nullptr);
+  ~DebugMemoryUsageWindow() override;
+
+private:
+  void refresh();
+  void saveAsJson();
+};
 } // namespace View
 } // namespace TrenchBroom
@@ -105,6 +105,13 @@ MapView2D::MapView2D(
   mapViewBaseVirtualInit();
 }
 
+MapView2D::~MapView2D()
+{
+  // the grid renderer's VBO must be deleted while our context is current
+  makeCurrent();
+  m_gridRenderer.reset();
+}
+
 void MapView2D::initializeCamera(const ViewPlane viewPlane)
 {
   auto document = kdl::mem_lock(m_document);
@@ -409,7 +416,16 @@ Renderer::Camera& MapView2D::doGetCamera()
 void MapView2D::doRenderGrid(Renderer::RenderContext&, Renderer::RenderBatch& renderBatch)
 {
   auto document = kdl::mem_lock(m_document);
-  renderBatch.addOneShot(new Renderer::GridRenderer(*m_camera, document->worldBounds()));
+  if (!m_gridRenderer)
+  {
+    m_gridRenderer =
+      std::make_unique<Renderer::GridRenderer>(*m_camera, document->worldBounds());
+  }
+  else
+  {
+    m_gridRenderer->setWorldBounds(document->worldBounds());
+  }
+  renderBatch.add(m_gridRenderer.get());
 }
 
 void MapView2D::doRenderMap(
@@ -422,7 +438,10 @@ void MapView2D::doRenderMap(
   auto document = kdl::mem_lock(m_document);
   if (renderContext.showSelectionGuide() && document->hasSelectedNodes())
   {
-    const vm::bbox3& bounds = document->selectionBounds();
+    const auto& transformation = renderContext.selectionTransformation();
+    const auto bounds = transformation
+                          ? document->selectionBounds().transform(*transformation)
+                          : document->selectionBounds();
     Renderer::SelectionBoundsRenderer boundsRenderer(bounds);
     boundsRenderer.render(renderContext, renderBatch);
   }
@@ -37,6 +37,7 @@ class PickResult;
 
 namespace Renderer
 {
+class GridRenderer;
 class MapRenderer;
 class OrthographicCamera;
 class RenderBatch;
@@ -59,6 +60,7 @@ public:
 
 private:
   std::unique_ptr<Renderer::OrthographicCamera> m_camera;
+  std::unique_ptr<Renderer::GridRenderer> m_gridRenderer;
 
   NotifierConnection m_notifierConnection;
 
@@ -70,6 +72,7 @@ public:
     GLContextManager& contextManager,
     ViewPlane viewPlane,
     Logger* logger);
+  ~MapView2D() override;
 
 private:
   void initializeCamera(ViewPlane viewPlane);
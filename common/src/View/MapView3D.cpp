@@ -167,7 +167,13 @@ void MapView3D::keyPressEvent(QKeyEvent* event)
 
 void MapView3D::keyReleaseEvent(QKeyEvent* event)
 {
+  const auto wasFlying = m_flyModeHelper->anyKeyDown();
   m_flyModeHelper->keyUp(event);
+  if (wasFlying && !m_flyModeHelper->anyKeyDown())
+  {
+    // hover picking is skipped while flying
+    updatePickResult();
+  }
 
   MapViewBase::keyReleaseEvent(event);
 }
@@ -225,6 +231,11 @@ Model::PickResult MapView3D::doPick(const vm::ray3& pickRay) const
   return pickResult;
 }
 
+bool MapView3D::doIsCameraMoving() const
+{
+  return m_flyModeHelper->anyKeyDown();
+}
+
 void MapView3D::doUpdateViewport(
   const int x, const int y, const int width, const int height)
 {
@@ -244,12 +255,13 @@ vm::vec3 MapView3D::doGetPasteObjectsDelta(
   {
     const auto pickRay = vm::ray3(m_camera->pickRay(
       static_cast<float>(clientCoords.x()), static_cast<float>(clientCoords.y())));
-    auto pickResult = Model::PickResult::byDistance();
+    using namespace Model::HitFilters;
+    const auto filter = type(Model::BrushNode::BrushHitType);
 
-    document->pick(pickRay, pickResult);
+    auto pickResult = Model::PickResult::byDistance();
+    document->pickNearest(pickRay, filter, pickResult);
 
-    using namespace Model::HitFilters;
-    const auto& hit = pickResult.first(type(Model::BrushNode::BrushHitType));
+    const auto& hit = pickResult.first(filter);
     if (const auto faceHandle = Model::hitToFaceHandle(hit))
     {
       const auto& face = faceHandle->face();
@@ -569,7 +581,10 @@ void MapView3D::doRenderMap(
   auto document = kdl::mem_lock(m_document);
   if (renderContext.showSelectionGuide() && document->hasSelectedNodes())
   {
-    const vm::bbox3& bounds = document->selectionBounds();
+    const auto& transformation = renderContext.selectionTransformation();
+    const auto bounds = transformation
+                          ? document->selectionBounds().transform(*transformation)
+                          : document->selectionBounds();
     Renderer::SelectionBoundsRenderer boundsRenderer(bounds);
     boundsRenderer.render(renderContext, renderBatch);
 
@@ -90,6 +90,7 @@ private: // other events
 private: // implement ToolBoxConnector interface
   PickRequest doGetPickRequest(float x, float y) const override;
   Model::PickResult doPick(const vm::ray3& pickRay) const override;
+  bool doIsCameraMoving() const override;
 
 private: // implement RenderView interface
   void doUpdateViewport(int x, int y, int width, int height) override;
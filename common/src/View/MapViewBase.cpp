@@ -29,7 +29,10 @@
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityDefinitionGroup.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Assets/TextureManager.h"
 #include "FloatType.h"
+#include "IO/DiskIO.h"
+#include "IO/PathInfo.h"
 #include "Logger.h"
 #include "Model/BezierPatch.h"
 #include "Model/BrushFace.h"
@@ -51,6 +54,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/Camera.h"
+#include "Renderer/AttrString.h"
 #include "Renderer/Compass.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/FontManager.h"
@@ -58,7 +62,9 @@
 #include "Renderer/PrimitiveRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderService.h"
+#include "Renderer/ShaderManager.h"
 #include "View/Actions.h"
 #include "View/Animation.h"
 #include "View/EnableDisableTagCallback.h"
@@ -76,12 +82,16 @@
 #include <kdl/memory_utils.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
+#include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/polygon.h>
 #include <vecmath/util.h>
 
+#include <chrono>
+#include <iomanip>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -106,6 +116,8 @@ MapViewBase::MapViewBase(
   , m_portalFileRenderer{nullptr}
   , m_isCurrent{false}
   , m_updateActionStatesSignalDelayer{new SignalDelayer{this}}
+  , m_updatePickResultSignalDelayer{new SignalDelayer{this}}
+  , m_pickResultOutdated{false}
 {
   setToolBox(toolBox);
   bindEvents();
@@ -129,6 +141,7 @@ MapViewBase::~MapViewBase()
   // Deleting m_compass will access the VBO so we need to be current
   // see: http://doc.qt.io/qt-5/qopenglwidget.html#resource-initialization-and-cleanup
   makeCurrent();
+  m_renderProfiler.reset();
 }
 
 void MapViewBase::setIsCurrent(const bool isCurrent)
@@ -148,6 +161,11 @@ void MapViewBase::bindEvents()
     &SignalDelayer::processSignal,
     this,
     &MapViewBase::updateActionStates);
+  connect(
+    m_updatePickResultSignalDelayer,
+    &SignalDelayer::processSignal,
+    this,
+    &MapViewBase::updateOutdatedPickResult);
 }
 
 void MapViewBase::connectObservers()
@@ -216,15 +234,34 @@ void MapViewBase::createActionsAndUpdatePicking()
   updatePickResult();
 }
 
+/**
+ * A single edit sends several notifications to every map view. Picking is deferred so
+ * that it happens once per view instead of once per notification.
+ */
+void MapViewBase::updatePickResultDelayed()
+{
+  m_pickResultOutdated = true;
+  m_updatePickResultSignalDelayer->queueSignal();
+}
+
+void MapViewBase::updateOutdatedPickResult()
+{
+  if (m_pickResultOutdated)
+  {
+    m_pickResultOutdated = false;
+    updatePickResult();
+  }
+}
+
 void MapViewBase::nodesDidChange(const std::vector<Model::Node*>&)
 {
-  updatePickResult();
+  updatePickResultDelayed();
   update();
 }
 
 void MapViewBase::toolChanged(Tool&)
 {
-  updatePickResult();
+  updatePickResultDelayed();
   updateActionStates();
   update();
 }
@@ -232,14 +269,14 @@ void MapViewBase::toolChanged(Tool&)
 void MapViewBase::commandDone(Command&)
 {
   updateActionStatesDelayed();
-  updatePickResult();
+  updatePickResultDelayed();
   update();
 }
 
 void MapViewBase::commandUndone(UndoableCommand&)
 {
   updateActionStatesDelayed();
-  updatePickResult();
+  updatePickResultDelayed();
   update();
 }
 
@@ -702,6 +739,7 @@ Assets::EntityDefinition* MapViewBase::findEntityDefinition(
 void MapViewBase::createPointEntity(const Assets::PointEntityDefinition* definition)
 {
   ensure(definition != nullptr, "definition is null");
+  updateOutdatedPickResult();
 
   auto document = kdl::mem_lock(m_document);
   const auto delta = doComputePointEntityPosition(definition->bounds());
@@ -995,7 +1033,18 @@ void MapViewBase::initializeGL()
     m_logger->info() << "Depth buffer bits: " << depthBits();
     m_logger->info() << "Multisampling "
                      << kdl::str_select(multisample(), "enabled", "disabled");
+
+    const auto& loadStats = shaderManager().loadStats();
+    m_logger->info() << "Loaded " << loadStats.loadedPrograms << " shader programs ("
+                     << loadStats.cachedPrograms << " from cache) in "
+                     << std::chrono::duration_cast<std::chrono::milliseconds>(
+                          loadStats.loadTime)
+                          .count()
+                     << "ms";
   }
+
+  // the context may have been initialized by another view, e.g. the texture browser
+  kdl::mem_lock(m_document)->textureManager().setBackgroundUploader(backgroundUploader());
 }
 
 bool MapViewBase::doShouldRenderFocusIndicator() const
@@ -1005,6 +1054,9 @@ bool MapViewBase::doShouldRenderFocusIndicator() const
 
 void MapViewBase::doRender()
 {
+  updateOutdatedPickResult();
+
+  const auto renderPreparationStart = std::chrono::steady_clock::now();
   doPreRender();
 
   const auto& fontPath = pref(Preferences::RendererFontPath());
@@ -1040,6 +1092,27 @@ void MapViewBase::doRender()
   setupGL(renderContext);
   setRenderOptions(renderContext);
 
+  if (m_isCurrent)
+  {
+    // all panes share the renderer, so only the current one keeps its arrays compact
+    m_renderer.prepare();
+  }
+
+  if (pref(Preferences::ShowRenderProfile))
+  {
+    if (!m_renderProfiler)
+    {
+      m_renderProfiler = std::make_unique<Renderer::RenderProfiler>();
+      m_lastRenderProfile = std::chrono::steady_clock::now();
+    }
+    renderContext.setProfiler(m_renderProfiler.get());
+  }
+  else
+  {
+    m_renderProfiler.reset();
+    m_renderProfileLines.clear();
+  }
+
   auto renderBatch = Renderer::RenderBatch{vboManager()};
 
   doRenderGrid(renderContext, renderBatch);
@@ -1054,7 +1127,45 @@ void MapViewBase::doRender()
   renderCompass(renderBatch);
   renderFPS(renderContext, renderBatch);
 
-  renderBatch.render(renderContext);
+  m_frameTelemetry.addSample(
+    FrameTelemetry::Metric::RenderPreparation,
+    std::chrono::steady_clock::now() - renderPreparationStart);
+
+  shaderManager().resetStats();
+  if (m_renderProfiler)
+  {
+    m_renderProfiler->beginFrame();
+    renderBatch.render(renderContext);
+    m_renderProfiler->endFrame();
+    updateRenderProfile();
+  }
+  else
+  {
+    renderBatch.render(renderContext);
+  }
+
+  if (pref(Preferences::ShowFPS))
+  {
+    const auto stats = shaderManager().stats();
+    m_shaderStats = std::to_string(stats.programSwitches) + " shader switches ("
+                    + std::to_string(stats.skippedProgramSwitches) + " skipped), "
+                    + std::to_string(stats.uniformUpdates) + " uniform updates ("
+                    + std::to_string(stats.skippedUniformUpdates) + " skipped)";
+  }
+
+  const auto pickTime = totalPickTime();
+  m_frameTelemetry.addSample(
+    FrameTelemetry::Metric::Picking, pickTime - m_lastTotalPickTime);
+  m_frameTelemetry.addSample(
+    FrameTelemetry::Metric::ToolControllers, std::exchange(m_toolControllerTime, {}));
+  m_lastTotalPickTime = pickTime;
+  updateFrameTelemetry();
+
+  if (document->hasPendingAssets())
+  {
+    // textures are requested while rendering, so keep rendering until they are uploaded
+    update();
+  }
 }
 
 void MapViewBase::setupGL(Renderer::RenderContext& context)
@@ -1136,21 +1247,38 @@ void MapViewBase::validatePortalFileRenderer(Renderer::RenderContext&)
   auto* portalFile = document->portalFile();
   if (portalFile != nullptr)
   {
+    // Triangulate all portals into one triangle mesh and one line mesh, so that they are
+    // drawn with one call each instead of one call per portal.
+    auto triangles = std::vector<vm::vec3f>{};
+    auto lines = std::vector<vm::vec3f>{};
     for (const auto& poly : portalFile->portals())
     {
-      m_portalFileRenderer->renderFilledPolygon(
-        pref(Preferences::PortalFileFillColor),
-        Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-        Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
-        poly.vertices());
-
-      const auto lineWidth = 4.0f;
-      m_portalFileRenderer->renderPolygon(
-        pref(Preferences::PortalFileBorderColor),
-        lineWidth,
-        Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-        poly.vertices());
+      const auto& vertices = poly.vertices();
+      for (size_t i = 1; i + 1 < vertices.size(); ++i)
+      {
+        triangles.push_back(vertices[0]);
+        triangles.push_back(vertices[i]);
+        triangles.push_back(vertices[i + 1]);
+      }
+      for (size_t i = 0; i < vertices.size(); ++i)
+      {
+        lines.push_back(vertices[i]);
+        lines.push_back(vertices[(i + 1) % vertices.size()]);
+      }
     }
+
+    m_portalFileRenderer->renderFilledTriangles(
+      pref(Preferences::PortalFileFillColor),
+      Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+      Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
+      triangles);
+
+    const auto lineWidth = 4.0f;
+    m_portalFileRenderer->renderLines(
+      pref(Preferences::PortalFileBorderColor),
+      lineWidth,
+      Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+      lines);
   }
 }
 
@@ -1165,26 +1293,154 @@ void MapViewBase::renderCompass(Renderer::RenderBatch& renderBatch)
 void MapViewBase::renderFPS(
   Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch)
 {
+  if (
+    !pref(Preferences::ShowFPS) && m_renderProfileLines.empty()
+    && m_frameTelemetryLines.empty())
+  {
+    return;
+  }
+
+  auto string = Renderer::AttrString{};
   if (pref(Preferences::ShowFPS))
   {
-    auto renderService = Renderer::RenderService{renderContext, renderBatch};
-    renderService.renderHeadsUp(m_currentFPS);
+    string.appendLeftJustified(
+      m_currentFPS + ", " + std::to_string(m_renderer.culledBrushCount())
+      + " brushes culled, " + m_shaderStats);
+  }
+  for (const auto& line : m_renderProfileLines)
+  {
+    string.appendLeftJustified(line);
+  }
+  for (const auto& line : m_frameTelemetryLines)
+  {
+    string.appendLeftJustified(line);
+  }
+
+  auto renderService = Renderer::RenderService{renderContext, renderBatch};
+  renderService.renderHeadsUp(string);
+}
+
+void MapViewBase::updateRenderProfile()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastRenderProfile < std::chrono::seconds{1})
+  {
+    return;
+  }
+  m_lastRenderProfile = now;
+
+  const auto samples = m_renderProfiler->takeSamples();
+
+  m_renderProfileLines.clear();
+  for (const auto& sample : samples)
+  {
+    auto str = std::stringstream{};
+    str << std::fixed << std::setprecision(2) << sample.name << ": " << sample.count
+        << "x, " << sample.cpuTime << " ms CPU, " << sample.gpuTime << " ms GPU";
+    m_renderProfileLines.push_back(str.str());
+  }
+
+  const auto& path = pref(Preferences::RenderProfileFile());
+  if (!path.empty())
+  {
+    const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    const auto timeStamp = std::chrono::duration<double>{sinceEpoch}.count();
+    const auto writeHeader = IO::Disk::pathInfo(path) != IO::PathInfo::File;
+
+    IO::Disk::withOutputStream(path, std::ios::out | std::ios::app, [&](auto& stream) {
+      Renderer::writeRenderProfileCsv(stream, timeStamp, samples, writeHeader);
+    }).transform_error([&](auto e) {
+      m_logger->error() << "Could not write render profile: " << e.msg;
+    });
+  }
+}
+
+void MapViewBase::updateFrameTelemetry()
+{
+  const auto show = pref(Preferences::ShowFrameTelemetry);
+  const auto log = pref(Preferences::LogFrameTelemetry);
+  if (!show)
+  {
+    m_frameTelemetryLines.clear();
+  }
+  if (!show && !log)
+  {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastFrameTelemetry < std::chrono::seconds{1})
+  {
+    return;
+  }
+  m_lastFrameTelemetry = now;
+
+  auto lines = std::vector<std::string>{};
+  for (const auto metric : FrameTelemetry::Metrics)
+  {
+    const auto percentiles = m_frameTelemetry.percentiles(metric);
+    auto str = std::stringstream{};
+    str << std::fixed << std::setprecision(2) << metric << ": p50 " << percentiles.p50
+        << " ms, p95 " << percentiles.p95 << " ms, p99 " << percentiles.p99 << " ms ("
+        << percentiles.sampleCount << " samples)";
+    lines.push_back(str.str());
   }
+
+  if (log)
+  {
+    // include the map size so that regressions can be correlated with it
+    auto document = kdl::mem_lock(m_document);
+    const auto* world = document->world();
+    const auto nodeCount = world ? world->descendantCount() : size_t(0);
+    m_logger->info() << "Frame telemetry (" << nodeCount
+                     << " nodes): " << kdl::str_join(lines, "; ");
+  }
+
+  if (show)
+  {
+    m_frameTelemetryLines = std::move(lines);
+  }
+}
+
+void MapViewBase::addToolControllerTime(
+  const std::chrono::steady_clock::time_point start,
+  const std::chrono::steady_clock::duration totalPickTimeAtStart)
+{
+  const auto pickTime = totalPickTime() - totalPickTimeAtStart;
+  m_toolControllerTime += std::chrono::steady_clock::now() - start - pickTime;
 }
 
 void MapViewBase::processEvent(const KeyEvent& event)
 {
+  const auto start = std::chrono::steady_clock::now();
+  const auto totalPickTimeAtStart = totalPickTime();
+
+  updateOutdatedPickResult();
   ToolBoxConnector::processEvent(event);
+
+  addToolControllerTime(start, totalPickTimeAtStart);
 }
 
 void MapViewBase::processEvent(const MouseEvent& event)
 {
+  const auto start = std::chrono::steady_clock::now();
+  const auto totalPickTimeAtStart = totalPickTime();
+
+  updateOutdatedPickResult();
   ToolBoxConnector::processEvent(event);
+
+  addToolControllerTime(start, totalPickTimeAtStart);
 }
 
 void MapViewBase::processEvent(const CancelEvent& event)
 {
+  const auto start = std::chrono::steady_clock::now();
+  const auto totalPickTimeAtStart = totalPickTime();
+
+  updateOutdatedPickResult();
   ToolBoxConnector::processEvent(event);
+
+  addToolControllerTime(start, totalPickTimeAtStart);
 }
 
 void MapViewBase::doShowPopupMenu()
@@ -1196,6 +1452,8 @@ void MapViewBase::doShowPopupMenu()
 
 void MapViewBase::showPopupMenuLater()
 {
+  updateOutdatedPickResult();
+
   if (!doBeforePopupMenu())
   {
     return;
@@ -1398,6 +1656,7 @@ void MapViewBase::dragEnterEvent(QDragEnterEvent* dragEnterEvent)
 
 void MapViewBase::dragLeaveEvent(QDragLeaveEvent*)
 {
+  updateOutdatedPickResult();
   dragLeave();
 }
 
@@ -1485,6 +1744,8 @@ QMenu* MapViewBase::makeEntityGroupsMenu(const Assets::EntityDefinitionType type
 
 void MapViewBase::addSelectedObjectsToGroup()
 {
+  updateOutdatedPickResult();
+
   auto document = kdl::mem_lock(m_document);
   const auto nodes = document->selectedNodes().nodes();
   auto* newGroup = findNewGroupForObjects(nodes);
@@ -1579,6 +1840,8 @@ bool MapViewBase::canReparentNode(
 
 void MapViewBase::moveSelectedBrushesToEntity()
 {
+  updateOutdatedPickResult();
+
   auto document = kdl::mem_lock(m_document);
   const auto nodes = document->selectedNodes().nodes();
   auto* newParent = findNewParentEntityForBrushes(nodes);
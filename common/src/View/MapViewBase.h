@@ -26,8 +26,10 @@
 #include "View/RenderView.h"
 #include "View/ToolBoxConnector.h"
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -65,6 +67,7 @@ class PrimitiveRenderer;
 class RenderBatch;
 class RenderContext;
 enum class RenderMode;
+class RenderProfiler;
 } // namespace Renderer
 
 namespace View
@@ -107,6 +110,34 @@ private:
   bool m_isCurrent;
 
   SignalDelayer* m_updateActionStatesSignalDelayer;
+  SignalDelayer* m_updatePickResultSignalDelayer;
+
+  /**
+   * Indicates that a delayed update of the pick result is pending. The pick result is
+   * also updated before input events are processed and before the view is rendered, so
+   * that it never refers to nodes that were removed in the meantime.
+   */
+  bool m_pickResultOutdated;
+
+  /**
+   * The shader program switches and uniform updates of the last frame, shown with the
+   * FPS counter.
+   */
+  std::string m_shaderStats;
+
+  /**
+   * Profiles the rendering of this view if the render profile is shown. The profiler
+   * uses GL query objects, so it must be destroyed while the context is current.
+   */
+  std::unique_ptr<Renderer::RenderProfiler> m_renderProfiler;
+  std::chrono::steady_clock::time_point m_lastRenderProfile;
+  std::vector<std::string> m_renderProfileLines;
+
+  // the time spent in tool controllers since the last frame, excluding picking
+  std::chrono::steady_clock::duration m_toolControllerTime{0};
+  std::chrono::steady_clock::duration m_lastTotalPickTime{0};
+  std::chrono::steady_clock::time_point m_lastFrameTelemetry;
+  std::vector<std::string> m_frameTelemetryLines;
 
   NotifierConnection m_notifierConnection;
 
@@ -149,6 +180,8 @@ private:
   void connectObservers();
 
   void createActionsAndUpdatePicking();
+  void updatePickResultDelayed();
+  void updateOutdatedPickResult();
 
   void nodesDidChange(const std::vector<Model::Node*>& nodes);
   void toolChanged(Tool& tool);
@@ -340,6 +373,11 @@ private: // implement RenderView interface
   void renderCompass(Renderer::RenderBatch& renderBatch);
   void renderFPS(
     Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
+  void updateRenderProfile();
+  void updateFrameTelemetry();
+  void addToolControllerTime(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::duration totalPickTimeAtStart);
 
 public: // implement InputEventProcessor interface
   void processEvent(const KeyEvent& event) override;
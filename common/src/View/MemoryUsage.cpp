@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryUsage.h"
+
+#include "Assets/EntityModelManager.h"
+#include "Assets/TextureManager.h"
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/MapRenderer.h"
+#include "Renderer/VboManager.h"
+#include "View/MapDocument.h"
+
+#include <kdl/overload.h>
+#include <kdl/reflection_impl.h>
+
+#include <sstream>
+
+namespace TrenchBroom::View
+{
+
+kdl_reflect_impl(MemoryUsageEntry);
+
+std::vector<MemoryUsageEntry> collectMemoryUsage(
+  MapDocument& document,
+  const Renderer::MapRenderer& mapRenderer,
+  const Renderer::VboManager& vboManager)
+{
+  auto brushGeometry = size_t(0);
+  auto brushRendererCaches = size_t(0);
+  if (auto* world = document.world())
+  {
+    world->accept(kdl::overload(
+      [](auto&& thisLambda, Model::WorldNode* worldNode) {
+        worldNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, Model::LayerNode* layerNode) {
+        layerNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, Model::GroupNode* groupNode) {
+        groupNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, Model::EntityNode* entityNode) {
+        entityNode->visitChildren(thisLambda);
+      },
+      [&](Model::BrushNode* brushNode) {
+        brushGeometry += brushNode->brush().geometryMemoryUsage();
+        brushRendererCaches += brushNode->brushRendererBrushCache().memoryUsage();
+      },
+      [](Model::PatchNode*) {}));
+  }
+
+  return {
+    {"Brush geometry", brushGeometry},
+    {"Brush renderer caches", brushRendererCaches},
+    {"Brush renderer arrays", mapRenderer.brushMemoryUsage()},
+    {"Textures", document.textureManager().memoryUsage()},
+    {"Entity models", document.entityModelManager().memoryUsage()},
+    {"Undo stack", document.undoMemorySize()},
+    {"VBOs", vboManager.currentVboSize()},
+  };
+}
+
+std::string memoryUsageToJson(const std::vector<MemoryUsageEntry>& entries)
+{
+  auto str = std::stringstream{};
+  str << "{";
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    str << (i == 0 ? "\n" : ",\n");
+    str << "  \"" << entries[i].name << "\": " << entries[i].bytes;
+  }
+  str << "\n}\n";
+  return str.str();
+}
+
+} // namespace TrenchBroom::View
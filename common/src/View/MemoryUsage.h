@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <kdl/reflection_decl.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+class MapRenderer;
+class VboManager;
+} // namespace TrenchBroom::Renderer
+
+namespace TrenchBroom::View
+{
+class MapDocument;
+
+/**
+ * The approximate number of bytes used by a subsystem. The sizes are computed from the
+ * element counts and types of the subsystem's containers, so they do not include any
+ * allocator overhead.
+ */
+struct MemoryUsageEntry
+{
+  std::string name;
+  size_t bytes;
+
+  kdl_reflect_decl(MemoryUsageEntry, name, bytes);
+};
+
+/**
+ * Collects the memory used by the brushes, textures, entity models and undo stack of the
+ * given document and by the given renderer and VBO manager.
+ */
+std::vector<MemoryUsageEntry> collectMemoryUsage(
+  MapDocument& document,
+  const Renderer::MapRenderer& mapRenderer,
+  const Renderer::VboManager& vboManager);
+
+/**
+ * Returns a JSON object that maps the names of the given entries to their sizes in bytes.
+ */
+std::string memoryUsageToJson(const std::vector<MemoryUsageEntry>& entries);
+
+} // namespace TrenchBroom::View
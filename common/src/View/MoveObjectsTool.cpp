@@ -21,6 +21,8 @@
 
 #include "FloatType.h"
 #include "Model/BrushNode.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "View/Grid.h"
 #include "View/InputState.h"
 #include "View/MapDocument.h"
@@ -30,6 +32,7 @@
 #include <kdl/memory_utils.h>
 
 #include <vecmath/bbox.h>
+#include <vecmath/mat_ext.h>
 
 #include <cassert>
 
@@ -62,6 +65,13 @@ bool MoveObjectsTool::startMove(const InputState& inputState)
     duplicateObjects(inputState) ? "Duplicate Objects" : "Move Objects",
     TransactionScope::LongRunning);
   m_duplicateObjects = duplicateObjects(inputState);
+
+  // Rendering the selected objects with a translation matrix moves their textures along
+  // with them, so the move can only be previewed like this if texture lock is enabled.
+  if (pref(Preferences::TextureLock))
+  {
+    m_previewDelta = vm::vec3::zero();
+  }
   return true;
 }
 
@@ -71,7 +81,8 @@ MoveObjectsTool::MoveResult MoveObjectsTool::move(
   auto document = kdl::mem_lock(m_document);
   const auto& worldBounds = document->worldBounds();
   const auto bounds = document->selectionBounds();
-  if (!worldBounds.contains(bounds.translate(delta)))
+  const auto totalDelta = m_previewDelta ? *m_previewDelta + delta : delta;
+  if (!worldBounds.contains(bounds.translate(totalDelta)))
   {
     return MR_Deny;
   }
@@ -82,6 +93,13 @@ MoveObjectsTool::MoveResult MoveObjectsTool::move(
     document->duplicateObjects();
   }
 
+  if (m_previewDelta)
+  {
+    m_previewDelta = totalDelta;
+    refreshViews();
+    return MR_Continue;
+  }
+
   if (!document->translateObjects(delta))
   {
     return MR_Deny;
@@ -95,13 +113,30 @@ MoveObjectsTool::MoveResult MoveObjectsTool::move(
 void MoveObjectsTool::endMove(const InputState&)
 {
   auto document = kdl::mem_lock(m_document);
+  if (m_previewDelta)
+  {
+    if (!vm::is_zero(*m_previewDelta, vm::C::almost_zero()))
+    {
+      document->translateObjects(*m_previewDelta);
+    }
+    m_previewDelta = std::nullopt;
+  }
   document->commitTransaction();
+  refreshViews();
 }
 
 void MoveObjectsTool::cancelMove()
 {
   auto document = kdl::mem_lock(m_document);
   document->cancelTransaction();
+  m_previewDelta = std::nullopt;
+  refreshViews();
+}
+
+std::optional<vm::mat4x4> MoveObjectsTool::previewTransformation() const
+{
+  return m_previewDelta ? std::make_optional(vm::translation_matrix(*m_previewDelta))
+                        : std::nullopt;
 }
 
 bool MoveObjectsTool::duplicateObjects(const InputState& inputState) const
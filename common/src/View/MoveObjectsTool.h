@@ -22,7 +22,11 @@
 #include "FloatType.h"
 #include "View/Tool.h"
 
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
 #include <memory>
+#include <optional>
 
 namespace TrenchBroom
 {
@@ -45,6 +49,7 @@ public:
 private:
   std::weak_ptr<MapDocument> m_document;
   bool m_duplicateObjects;
+  std::optional<vm::vec3> m_previewDelta;
 
 public:
   explicit MoveObjectsTool(std::weak_ptr<MapDocument> document);
@@ -57,6 +62,14 @@ public:
   void endMove(const InputState& inputState);
   void cancelMove();
 
+  /**
+   * Returns the translation that the selected objects should be rendered with while they
+   * are being moved, or an empty optional if the moves are applied to the selected
+   * objects directly. The previewed translation is only applied to the selected objects
+   * when the move ends.
+   */
+  std::optional<vm::mat4x4> previewTransformation() const;
+
 private:
   bool duplicateObjects(const InputState& inputState) const;
 
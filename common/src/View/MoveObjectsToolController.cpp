@@ -92,6 +92,10 @@ public:
     const InputState&, Renderer::RenderContext& renderContext) const override
   {
     renderContext.setForceShowSelectionGuide();
+    if (const auto& transformation = m_tool.previewTransformation())
+    {
+      renderContext.setSelectionTransformation(*transformation);
+    }
   }
 
   DragHandleSnapper makeDragHandleSnapper(
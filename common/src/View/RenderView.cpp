@@ -127,13 +127,13 @@ RenderView::~RenderView() = default;
 void RenderView::keyPressEvent(QKeyEvent* event)
 {
   m_eventRecorder.recordEvent(*event);
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::keyReleaseEvent(QKeyEvent* event)
 {
   m_eventRecorder.recordEvent(*event);
-  update();
+  inputEventRecorded();
 }
 
 static auto mouseEventWithFullPrecisionLocalPos(
@@ -158,31 +158,31 @@ static auto mouseEventWithFullPrecisionLocalPos(
 void RenderView::mouseDoubleClickEvent(QMouseEvent* event)
 {
   m_eventRecorder.recordEvent(mouseEventWithFullPrecisionLocalPos(this, event));
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::mouseMoveEvent(QMouseEvent* event)
 {
   m_eventRecorder.recordEvent(mouseEventWithFullPrecisionLocalPos(this, event));
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::mousePressEvent(QMouseEvent* event)
 {
   m_eventRecorder.recordEvent(mouseEventWithFullPrecisionLocalPos(this, event));
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::mouseReleaseEvent(QMouseEvent* event)
 {
   m_eventRecorder.recordEvent(mouseEventWithFullPrecisionLocalPos(this, event));
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::wheelEvent(QWheelEvent* event)
 {
   m_eventRecorder.recordEvent(*event);
-  update();
+  inputEventRecorded();
 }
 
 void RenderView::paintGL()
@@ -190,7 +190,9 @@ void RenderView::paintGL()
   if (TrenchBroom::View::isReportingCrash())
     return;
 
+  const auto frameStart = FrameTelemetry::Clock::now();
   render();
+  m_frameTelemetry.frameRendered(frameStart, FrameTelemetry::Clock::now());
 
   // Update stats
   m_framesRendered++;
@@ -208,6 +210,12 @@ void RenderView::paintGL()
   }
 }
 
+void RenderView::inputEventRecorded()
+{
+  m_frameTelemetry.eventReceived(FrameTelemetry::Clock::now());
+  update();
+}
+
 Renderer::VboManager& RenderView::vboManager()
 {
   return m_glContext->vboManager();
@@ -223,6 +231,11 @@ Renderer::ShaderManager& RenderView::shaderManager()
   return m_glContext->shaderManager();
 }
 
+Renderer::BackgroundUploader* RenderView::backgroundUploader()
+{
+  return m_glContext->backgroundUploader();
+}
+
 int RenderView::depthBits() const
 {
   const auto format = this->context()->format();
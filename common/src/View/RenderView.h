@@ -26,6 +26,7 @@
 
 #include "Color.h"
 #include "Renderer/GL.h"
+#include "View/FrameTelemetry.h"
 #include "View/InputEvent.h"
 
 #include <string>
@@ -38,6 +39,7 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
+class BackgroundUploader;
 class FontManager;
 class ShaderManager;
 class VboManager;
@@ -65,6 +67,7 @@ private: // FPS counter
 
 protected:
   std::string m_currentFPS;
+  FrameTelemetry m_frameTelemetry;
 
 protected:
   explicit RenderView(GLContextManager& contextManager, QWidget* parent = nullptr);
@@ -85,6 +88,7 @@ protected:
   Renderer::VboManager& vboManager();
   Renderer::FontManager& fontManager();
   Renderer::ShaderManager& shaderManager();
+  Renderer::BackgroundUploader* backgroundUploader();
 
   int depthBits() const;
   bool multisample() const;
@@ -95,6 +99,7 @@ protected: // QOpenGLWidget overrides
   void resizeGL(int w, int h) override;
 
 private:
+  void inputEventRecorded();
   void render();
   void processInput();
   void clearBackground();
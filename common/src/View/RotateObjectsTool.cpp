@@ -20,6 +20,8 @@
 #include "RotateObjectsTool.h"
 
 #include "Model/Hit.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "View/Grid.h"
 #include "View/MapDocument.h"
 #include "View/RotateObjectsHandle.h"
@@ -29,6 +31,7 @@
 #include <kdl/memory_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/mat_ext.h>
 #include <vecmath/scalar.h>
 
 namespace TrenchBroom
@@ -115,19 +118,34 @@ void RotateObjectsTool::beginRotation()
 {
   auto document = kdl::mem_lock(m_document);
   document->startTransaction("Rotate Objects", TransactionScope::LongRunning);
+
+  // Rendering the selected objects with a rotation matrix moves their textures along with
+  // them, so the rotation can only be previewed like this if texture lock is enabled.
+  if (pref(Preferences::TextureLock))
+  {
+    m_previewTransformation = vm::mat4x4::identity();
+  }
 }
 
 void RotateObjectsTool::commitRotation()
 {
   auto document = kdl::mem_lock(m_document);
+  if (m_previewTransformation)
+  {
+    document->transformObjects("Rotate Objects", *m_previewTransformation);
+    m_previewTransformation = std::nullopt;
+  }
   document->commitTransaction();
   updateRecentlyUsedCenters(rotationCenter());
+  refreshViews();
 }
 
 void RotateObjectsTool::cancelRotation()
 {
   auto document = kdl::mem_lock(m_document);
   document->cancelTransaction();
+  m_previewTransformation = std::nullopt;
+  refreshViews();
 }
 
 FloatType RotateObjectsTool::snapRotationAngle(const FloatType angle) const
@@ -139,9 +157,24 @@ FloatType RotateObjectsTool::snapRotationAngle(const FloatType angle) const
 void RotateObjectsTool::applyRotation(
   const vm::vec3& center, const vm::vec3& axis, const FloatType angle)
 {
-  auto document = kdl::mem_lock(m_document);
-  document->rollbackTransaction();
-  document->rotateObjects(center, axis, angle);
+  if (m_previewTransformation)
+  {
+    m_previewTransformation = vm::translation_matrix(center)
+                              * vm::rotation_matrix(axis, angle)
+                              * vm::translation_matrix(-center);
+    refreshViews();
+  }
+  else
+  {
+    auto document = kdl::mem_lock(m_document);
+    document->rollbackTransaction();
+    document->rotateObjects(center, axis, angle);
+  }
+}
+
+const std::optional<vm::mat4x4>& RotateObjectsTool::previewTransformation() const
+{
+  return m_previewTransformation;
 }
 
 Model::Hit RotateObjectsTool::pick2D(
@@ -24,8 +24,10 @@
 #include "View/Tool.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/mat.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom
@@ -51,6 +53,7 @@ private:
   RotateObjectsHandle m_handle;
   double m_angle;
   std::vector<vm::vec3> m_recentlyUsedCenters;
+  std::optional<vm::mat4x4> m_previewTransformation;
 
 public:
   explicit RotateObjectsTool(std::weak_ptr<MapDocument> document);
@@ -78,6 +81,14 @@ public:
   FloatType snapRotationAngle(FloatType angle) const;
   void applyRotation(const vm::vec3& center, const vm::vec3& axis, FloatType angle);
 
+  /**
+   * Returns the rotation that the selected objects should be rendered with while they are
+   * being rotated, or an empty optional if the rotation is applied to the selected
+   * objects directly. The previewed rotation is only applied to the selected objects when
+   * the rotation is committed.
+   */
+  const std::optional<vm::mat4x4>& previewTransformation() const;
+
   Model::Hit pick2D(const vm::ray3& pickRay, const Renderer::Camera& camera);
   Model::Hit pick3D(const vm::ray3& pickRay, const Renderer::Camera& camera);
 
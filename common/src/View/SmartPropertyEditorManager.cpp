@@ -37,6 +37,7 @@
 #include <kdl/functional.h>
 #include <kdl/memory_utils.h>
 #include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
 
 namespace TrenchBroom::View
 {
@@ -80,11 +81,12 @@ SmartPropertyEditorMatcher makeSmartPropertyEditorKeyMatcher(
   std::vector<std::string> patterns)
 {
   return
-    [patterns = std::move(patterns)](
+    [patterns = kdl::vec_transform(
+       patterns, [](const auto& pattern) { return kdl::cs::glob_matcher{pattern}; })](
       const std::string& propertyKey, const std::vector<Model::EntityNodeBase*>& nodes) {
       return !nodes.empty()
              && std::any_of(patterns.begin(), patterns.end(), [&](const auto& pattern) {
-                  return kdl::cs::str_matches_glob(propertyKey, pattern);
+                  return pattern.matches(propertyKey);
                 });
     };
 }
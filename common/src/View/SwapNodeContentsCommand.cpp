@@ -21,6 +21,7 @@
 
 #include "Model/Brush.h"
 #include "Model/Entity.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -72,5 +73,15 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
 
   return false;
 }
+
+size_t SwapNodeContentsCommand::memorySize() const
+{
+  auto result = UpdateLinkedGroupsCommandBase::memorySize();
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += Model::estimateMemorySize(contents);
+  }
+  return result;
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -86,6 +86,11 @@ bool SwitchableMapViewContainer::active() const
   return m_activationTracker->active();
 }
 
+const Renderer::MapRenderer& SwitchableMapViewContainer::mapRenderer() const
+{
+  return *m_mapRenderer;
+}
+
 void SwitchableMapViewContainer::switchToMapView(const MapViewLayout viewId)
 {
   m_activationTracker->clear();
@@ -84,6 +84,7 @@ public:
   void windowActivationStateChanged(bool active);
 
   bool active() const;
+  const Renderer::MapRenderer& mapRenderer() const;
   void switchToMapView(MapViewLayout viewId);
 
   bool anyToolActive() const;
@@ -23,10 +23,12 @@
 #include <QScrollBar>
 #include <QString>
 #include <QTextEdit>
+#include <QTimer>
 
 #include "Ensure.h"
 
 #include <string>
+#include <utility>
 
 namespace TrenchBroom
 {
@@ -35,19 +37,56 @@ namespace View
 TextOutputAdapter::TextOutputAdapter(QTextEdit* textEdit)
 {
   ensure(textEdit != nullptr, "textEdit is null");
-  m_textEdit = textEdit;
 
   // Create our own private cursor, separate from the UI cursor
   // so user selections don't interfere with our text insertions
-  m_insertionCursor = QTextCursor(m_textEdit->document());
-  m_insertionCursor.movePosition(QTextCursor::End);
+  auto insertionCursor = QTextCursor(textEdit->document());
+  insertionCursor.movePosition(QTextCursor::End);
+
+  m_state = std::make_shared<State>(State{textEdit, std::move(insertionCursor), {}, {}});
 }
 
 void TextOutputAdapter::appendString(const QString& string)
 {
-  QScrollBar* scrollBar = m_textEdit->verticalScrollBar();
+  m_state->pendingString += string;
+  if (m_state->flushScheduled)
+  {
+    return;
+  }
+
+  if (std::chrono::steady_clock::now() - m_state->lastFlush >= FlushInterval)
+  {
+    flush(*m_state);
+  }
+  else
+  {
+    // the text widget is the context object so that the flush is skipped if it is
+    // destroyed in the meantime
+    m_state->flushScheduled = true;
+    QTimer::singleShot(
+      FlushInterval, m_state->textEdit, [state = m_state]() { flush(*state); });
+  }
+}
+
+void TextOutputAdapter::flush(State& state)
+{
+  state.flushScheduled = false;
+  state.lastFlush = std::chrono::steady_clock::now();
+
+  const auto string = std::exchange(state.pendingString, QString{});
+  if (string.isEmpty())
+  {
+    return;
+  }
+
+  auto& insertionCursor = state.insertionCursor;
+
+  QScrollBar* scrollBar = state.textEdit->verticalScrollBar();
   const bool wasAtBottom = (scrollBar->value() >= scrollBar->maximum());
 
+  // lay out the document once for all insertions
+  insertionCursor.beginEditBlock();
+
   const int size = string.size();
   for (int i = 0; i < size; ++i)
   {
@@ -62,14 +101,14 @@ void TextOutputAdapter::appendString(const QString& string)
     // Handle LF
     if (c == '\n')
     {
-      m_insertionCursor.movePosition(QTextCursor::End);
-      m_insertionCursor.insertBlock();
+      insertionCursor.movePosition(QTextCursor::End);
+      insertionCursor.insertBlock();
       continue;
     }
     // Handle CR, next character not LF
     if (c == '\r')
     {
-      m_insertionCursor.movePosition(QTextCursor::StartOfLine);
+      insertionCursor.movePosition(QTextCursor::StartOfLine);
       continue;
     }
 
@@ -87,21 +126,23 @@ void TextOutputAdapter::appendString(const QString& string)
     }
     const int insertionSize = lastToInsert - i + 1;
     const QString substring = string.mid(i, insertionSize);
-    if (!m_insertionCursor.atEnd())
+    if (!insertionCursor.atEnd())
     {
       // This means a CR was previously used. We need to select
       // the same number of characters as we're inserting, so the
       // text is overwritten.
-      m_insertionCursor.movePosition(
+      insertionCursor.movePosition(
         QTextCursor::NextCharacter, QTextCursor::KeepAnchor, insertionSize);
     }
-    m_insertionCursor.insertText(substring);
+    insertionCursor.insertText(substring);
     i = lastToInsert;
   }
 
+  insertionCursor.endEditBlock();
+
   if (wasAtBottom)
   {
-    m_textEdit->verticalScrollBar()->setValue(m_textEdit->verticalScrollBar()->maximum());
+    scrollBar->setValue(scrollBar->maximum());
   }
 }
 } // namespace View
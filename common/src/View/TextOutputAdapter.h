@@ -23,6 +23,9 @@
 #include <QTextCursor>
 #include <QTextStream>
 
+#include <chrono>
+#include <memory>
+
 class QTextEdit;
 
 namespace TrenchBroom
@@ -34,12 +37,28 @@ namespace View
  *
  * - Interprets CR and LF control characters.
  * - Scroll bar follows output, unless it's manually raised.
+ * - Output that arrives in quick succession is collected and appended to the text widget
+ *   at most once per flush interval, so that tools which produce a lot of output don't
+ *   block the UI.
+ *
+ * Copies of an adapter share their state and append to the same text widget.
  */
 class TextOutputAdapter
 {
+public:
+  static constexpr auto FlushInterval = std::chrono::milliseconds{50};
+
 private:
-  QTextEdit* m_textEdit;
-  QTextCursor m_insertionCursor;
+  struct State
+  {
+    QTextEdit* textEdit;
+    QTextCursor insertionCursor;
+    QString pendingString;
+    std::chrono::steady_clock::time_point lastFlush;
+    bool flushScheduled = false;
+  };
+
+  std::shared_ptr<State> m_state;
 
 public:
   explicit TextOutputAdapter(QTextEdit* textEdit);
@@ -60,6 +79,7 @@ public:
 
 private:
   void appendString(const QString& string);
+  static void flush(State& state);
 };
 } // namespace View
 } // namespace TrenchBroom
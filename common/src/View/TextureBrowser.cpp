@@ -193,14 +193,8 @@ void TextureBrowser::connectObservers()
     document->documentWasNewedNotifier.connect(this, &TextureBrowser::documentWasNewed);
   m_notifierConnection +=
     document->documentWasLoadedNotifier.connect(this, &TextureBrowser::documentWasLoaded);
-  m_notifierConnection +=
-    document->nodesWereAddedNotifier.connect(this, &TextureBrowser::nodesWereAdded);
-  m_notifierConnection +=
-    document->nodesWereRemovedNotifier.connect(this, &TextureBrowser::nodesWereRemoved);
-  m_notifierConnection +=
-    document->nodesDidChangeNotifier.connect(this, &TextureBrowser::nodesDidChange);
-  m_notifierConnection += document->brushFacesDidChangeNotifier.connect(
-    this, &TextureBrowser::brushFacesDidChange);
+  m_notifierConnection += document->changeSetDidCommitNotifier.connect(
+    this, &TextureBrowser::changeSetDidCommit);
   m_notifierConnection += document->textureCollectionsDidChangeNotifier.connect(
     this, &TextureBrowser::textureCollectionsDidChange);
   m_notifierConnection += document->currentTextureNameDidChangeNotifier.connect(
@@ -221,24 +215,15 @@ void TextureBrowser::documentWasLoaded(MapDocument*)
   reload();
 }
 
-void TextureBrowser::nodesWereAdded(const std::vector<Model::Node*>&)
-{
-  reload();
-}
-
-void TextureBrowser::nodesWereRemoved(const std::vector<Model::Node*>&)
-{
-  reload();
-}
-
-void TextureBrowser::nodesDidChange(const std::vector<Model::Node*>&)
+void TextureBrowser::changeSetDidCommit(const DocumentChangeSet& changeSet)
 {
-  reload();
-}
-
-void TextureBrowser::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&)
-{
-  reload();
+  // texture usage counts can only change if nodes were added, removed or changed
+  if (
+    !changeSet.addedNodes.empty() || !changeSet.changedNodes.empty()
+    || changeSet.nodesWereRemoved)
+  {
+    reload();
+  }
 }
 
 void TextureBrowser::textureCollectionsDidChange()
@@ -271,8 +256,7 @@ void TextureBrowser::reload()
   if (m_view != nullptr)
   {
     updateSelectedTexture();
-    m_view->invalidate();
-    m_view->update();
+    m_view->reload();
   }
 }
 
@@ -40,14 +40,9 @@ namespace Assets
 class Texture;
 }
 
-namespace Model
-{
-class BrushFaceHandle;
-class Node;
-} // namespace Model
-
 namespace View
 {
+struct DocumentChangeSet;
 class GLContextManager;
 class MapDocument;
 class TextureBrowserView;
@@ -92,10 +87,7 @@ private:
 
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
-  void nodesWereAdded(const std::vector<Model::Node*>& nodes);
-  void nodesWereRemoved(const std::vector<Model::Node*>& nodes);
-  void nodesDidChange(const std::vector<Model::Node*>& nodes);
-  void brushFacesDidChange(const std::vector<Model::BrushFaceHandle>& faces);
+  void changeSetDidCommit(const DocumentChangeSet& changeSet);
   void textureCollectionsDidChange();
   void currentTextureNameDidChange(const std::string& textureName);
   void preferenceDidChange(const std::filesystem::path& path);
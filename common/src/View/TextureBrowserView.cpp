@@ -48,11 +48,120 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom::View
 {
+namespace
+{
+/**
+ * The properties of a texture that are needed to filter and sort it. These are copied so
+ * that the textures are not accessed while they are filtered on a background thread.
+ */
+struct TextureInfo
+{
+  const Assets::Texture* texture;
+  std::string name;
+  size_t usageCount;
+};
+
+struct TextureGroupInfo
+{
+  std::string name;
+  std::vector<TextureInfo> textures;
+};
+
+template <typename T, typename GetTexture>
+std::vector<TextureInfo> getTextureInfos(
+  const std::vector<T>& textures, const GetTexture& getTexture)
+{
+  return kdl::vec_transform(textures, [&](const auto& t) {
+    const Assets::Texture* texture = getTexture(t);
+    return TextureInfo{texture, texture->name(), texture->usageCount()};
+  });
+}
+
+std::vector<TextureGroupInfo> getTextureGroupInfos(
+  const Assets::TextureManager& textureManager, const bool group)
+{
+  if (group)
+  {
+    return kdl::vec_transform(textureManager.collections(), [](const auto& collection) {
+      return TextureGroupInfo{
+        collection.name(),
+        getTextureInfos(collection.textures(), [](const auto& t) { return &t; })};
+    });
+  }
+
+  return {TextureGroupInfo{
+    "", getTextureInfos(textureManager.textures(), [](const auto* t) { return t; })}};
+}
+
+/**
+ * Filters and sorts the textures of the given groups. Returns an empty vector as soon as
+ * the given flag is set.
+ */
+std::vector<TextureGroup> filterAndSortTextures(
+  const std::vector<TextureGroupInfo>& groups,
+  const bool hideUnused,
+  const TextureSortOrder sortOrder,
+  const std::string& filterText,
+  const std::atomic<bool>& cancelled)
+{
+  const auto patterns = kdl::str_split(filterText, " ");
+  const auto compareNames = [](const auto* lhs, const auto* rhs) {
+    return kdl::ci::string_less{}(lhs->name, rhs->name);
+  };
+
+  auto result = std::vector<TextureGroup>{};
+  result.reserve(groups.size());
+
+  for (const auto& group : groups)
+  {
+    auto textures = std::vector<const TextureInfo*>{};
+    for (const auto& texture : group.textures)
+    {
+      if (cancelled)
+      {
+        return {};
+      }
+
+      if (
+        (!hideUnused || texture.usageCount > 0)
+        && kdl::all_of(patterns, [&](const auto& pattern) {
+             return kdl::ci::str_contains(texture.name, pattern);
+           }))
+      {
+        textures.push_back(&texture);
+      }
+    }
+
+    switch (sortOrder)
+    {
+    case TextureSortOrder::Name:
+      std::sort(textures.begin(), textures.end(), compareNames);
+      break;
+    case TextureSortOrder::Usage:
+      std::sort(textures.begin(), textures.end(), [&](const auto* lhs, const auto* rhs) {
+        return lhs->usageCount < rhs->usageCount   ? false
+               : lhs->usageCount > rhs->usageCount ? true
+                                                   : compareNames(lhs, rhs);
+      });
+      break;
+      switchDefault();
+    }
+
+    result.push_back(TextureGroup{
+      group.name,
+      kdl::vec_transform(textures, [](const auto* info) { return info->texture; })});
+  }
+
+  return result;
+}
+} // namespace
 
 TextureBrowserView::TextureBrowserView(
   QScrollBar* scrollBar,
@@ -60,6 +169,7 @@ TextureBrowserView::TextureBrowserView(
   std::weak_ptr<MapDocument> document_)
   : CellView{contextManager, scrollBar}
   , m_document{std::move(document_)}
+  , m_thumbnails{thumbnailSize()}
 {
   auto document = kdl::mem_lock(m_document);
   m_notifierConnection += document->textureUsageCountsDidChangeNotifier.connect(
@@ -68,7 +178,11 @@ TextureBrowserView::TextureBrowserView(
 
 TextureBrowserView::~TextureBrowserView()
 {
+  cancelFilteringTextures();
   clear();
+
+  // deleting the thumbnails accesses their GL textures, so we need to be current
+  makeCurrent();
 }
 
 void TextureBrowserView::setSortOrder(const TextureSortOrder sortOrder)
@@ -76,7 +190,7 @@ void TextureBrowserView::setSortOrder(const TextureSortOrder sortOrder)
   if (sortOrder != m_sortOrder)
   {
     m_sortOrder = sortOrder;
-    invalidate();
+    filterTexturesInBackground();
     update();
   }
 }
@@ -86,8 +200,7 @@ void TextureBrowserView::setGroup(const bool group)
   if (group != m_group)
   {
     m_group = group;
-    invalidate();
-    update();
+    reload();
   }
 }
 
@@ -96,7 +209,7 @@ void TextureBrowserView::setHideUnused(const bool hideUnused)
   if (hideUnused != m_hideUnused)
   {
     m_hideUnused = hideUnused;
-    invalidate();
+    filterTexturesInBackground();
     update();
   }
 }
@@ -106,7 +219,7 @@ void TextureBrowserView::setFilterText(const std::string& filterText)
   if (filterText != m_filterText)
   {
     m_filterText = filterText;
-    invalidate();
+    filterTexturesInBackground();
     update();
   }
 }
@@ -133,12 +246,26 @@ void TextureBrowserView::revealTexture(const Assets::Texture* texture)
   });
 }
 
-void TextureBrowserView::usageCountDidChange()
+void TextureBrowserView::reload()
 {
+  cancelFilteringTextures();
+  m_filteredTextureGroups = std::nullopt;
+  m_thumbnails.clear();
   invalidate();
   update();
 }
 
+void TextureBrowserView::usageCountDidChange()
+{
+  // the usage counts only affect the filtered textures if unused textures are hidden or
+  // if the textures are sorted by usage, otherwise they are only read when rendering
+  if (m_hideUnused || m_sortOrder == TextureSortOrder::Usage)
+  {
+    filterTexturesInBackground();
+  }
+  update();
+}
+
 void TextureBrowserView::doInitLayout(Layout& layout)
 {
   const auto scaleFactor = pref(Preferences::TextureBrowserIconSize);
@@ -160,17 +287,24 @@ void TextureBrowserView::doReloadLayout(Layout& layout)
 
   const auto font = Renderer::FontDescriptor{fontPath, static_cast<size_t>(fontSize)};
 
-  if (m_group)
+  auto textureGroups = std::vector<TextureGroup>{};
+  if (m_filteredTextureGroups)
   {
-    for (const auto& collection : getCollections())
-    {
-      layout.addGroup(collection.name(), static_cast<float>(fontSize) + 2.0f);
-      addTexturesToLayout(layout, getTextures(collection), collection.name(), font);
-    }
+    textureGroups = std::move(*m_filteredTextureGroups);
+    m_filteredTextureGroups = std::nullopt;
   }
   else
   {
-    addTexturesToLayout(layout, getTextures(), "", font);
+    textureGroups = getTextureGroups();
+  }
+
+  for (const auto& textureGroup : textureGroups)
+  {
+    if (m_group)
+    {
+      layout.addGroup(textureGroup.name, static_cast<float>(fontSize) + 2.0f);
+    }
+    addTexturesToLayout(layout, textureGroup.textures, textureGroup.name, font);
   }
 }
 
@@ -180,9 +314,14 @@ void TextureBrowserView::addTexturesToLayout(
   const std::string& groupName,
   const Renderer::FontDescriptor& font)
 {
+  // the group name is the same for all textures, so it only needs to be measured once
+  const auto maxCellWidth = layout.maxCellWidth();
+  const auto groupFont = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
+  const auto groupNameSize = fontManager().font(groupFont).measure(groupName);
+
   for (const auto* texture : textures)
   {
-    addTextureToLayout(layout, texture, groupName, font);
+    addTextureToLayout(layout, texture, groupName, font, groupFont, groupNameSize);
   }
 }
 
@@ -190,7 +329,9 @@ void TextureBrowserView::addTextureToLayout(
   Layout& layout,
   const Assets::Texture* texture,
   const std::string& groupName,
-  const Renderer::FontDescriptor& font)
+  const Renderer::FontDescriptor& font,
+  const Renderer::FontDescriptor& groupFont,
+  const vm::vec2f& groupNameSize)
 {
   const auto maxCellWidth = layout.maxCellWidth();
 
@@ -198,12 +339,10 @@ void TextureBrowserView::addTextureToLayout(
 
   const auto textureFont =
     fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-  const auto groupFont = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
 
   const auto defaultTextHeight =
     fontManager().font(font).measure(groupName + textureName).y();
   const auto textureNameSize = fontManager().font(textureFont).measure(textureName);
-  const auto groupNameSize = fontManager().font(groupFont).measure(groupName);
 
   const auto totalSize = vm::vec2f(
     vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
@@ -231,63 +370,60 @@ void TextureBrowserView::addTextureToLayout(
     totalSize.y());
 }
 
-const std::vector<Assets::TextureCollection>& TextureBrowserView::getCollections() const
+std::vector<TextureGroup> TextureBrowserView::getTextureGroups() const
 {
   auto document = kdl::mem_lock(m_document);
-  return document->textureManager().collections();
+  const auto cancelled = std::atomic<bool>{false};
+  return filterAndSortTextures(
+    getTextureGroupInfos(document->textureManager(), m_group),
+    m_hideUnused,
+    m_sortOrder,
+    m_filterText,
+    cancelled);
 }
 
-std::vector<const Assets::Texture*> TextureBrowserView::getTextures(
-  const Assets::TextureCollection& collection) const
+void TextureBrowserView::filterTexturesInBackground()
 {
-  return sortTextures(filterTextures(
-    kdl::vec_transform(collection.textures(), [](const auto& t) { return &t; })));
-}
+  cancelFilteringTextures();
 
-std::vector<const Assets::Texture*> TextureBrowserView::getTextures() const
-{
-  auto doc = kdl::mem_lock(m_document);
-  return sortTextures(filterTextures(doc->textureManager().textures()));
+  auto document = kdl::mem_lock(m_document);
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  auto textureGroups = std::async(
+    std::launch::async,
+    [groups = getTextureGroupInfos(document->textureManager(), m_group),
+     hideUnused = m_hideUnused,
+     sortOrder = m_sortOrder,
+     filterText = m_filterText,
+     cancelled]() {
+      return filterAndSortTextures(groups, hideUnused, sortOrder, filterText, *cancelled);
+    });
+
+  m_pendingTextureGroups =
+    PendingTextureGroups{std::move(cancelled), std::move(textureGroups)};
 }
 
-std::vector<const Assets::Texture*> TextureBrowserView::filterTextures(
-  std::vector<const Assets::Texture*> textures) const
+void TextureBrowserView::cancelFilteringTextures()
 {
-  if (m_hideUnused)
+  if (m_pendingTextureGroups)
   {
-    textures = kdl::vec_erase_if(std::move(textures), [](const auto* texture) {
-      return texture->usageCount() == 0;
-    });
-  }
-  if (!m_filterText.empty())
-  {
-    textures = kdl::vec_erase_if(std::move(textures), [&](const auto* texture) {
-      return !kdl::all_of(kdl::str_split(m_filterText, " "), [&](const auto& pattern) {
-        return kdl::ci::str_contains(texture->name(), pattern);
-      });
-    });
+    // this waits for the background thread, which stops once it sees the flag
+    *m_pendingTextureGroups->cancelled = true;
+    m_pendingTextureGroups = std::nullopt;
   }
-  return textures;
 }
 
-std::vector<const Assets::Texture*> TextureBrowserView::sortTextures(
-  std::vector<const Assets::Texture*> textures) const
+void TextureBrowserView::commitFilteredTextures()
 {
-  const auto compareNames = [](const auto& lhs, const auto& rhs) {
-    return kdl::ci::string_less{}(lhs->name(), rhs->name());
-  };
-
-  switch (m_sortOrder)
+  using namespace std::chrono_literals;
+  if (
+    m_pendingTextureGroups
+    && m_pendingTextureGroups->textureGroups.wait_for(0s) == std::future_status::ready)
   {
-  case TextureSortOrder::Name:
-    return kdl::vec_sort(std::move(textures), compareNames);
-  case TextureSortOrder::Usage:
-    return kdl::vec_sort(std::move(textures), [&](const auto* lhs, const auto* rhs) {
-      return lhs->usageCount() < rhs->usageCount()   ? false
-             : lhs->usageCount() > rhs->usageCount() ? true
-                                                     : compareNames(lhs, rhs);
-    });
-    switchDefault();
+    m_filteredTextureGroups = m_pendingTextureGroups->textureGroups.get();
+    m_pendingTextureGroups = std::nullopt;
+
+    // the filtered textures are laid out when the layout is validated
+    invalidate();
   }
 }
 
@@ -297,6 +433,8 @@ void TextureBrowserView::doRender(Layout& layout, const float y, const float hei
 {
   auto document = kdl::mem_lock(m_document);
   document->textureManager().commitChanges();
+  m_thumbnails.setThumbnailSize(thumbnailSize());
+  m_thumbnails.commitChanges();
 
   const auto viewLeft = static_cast<float>(0);
   const auto viewTop = static_cast<float>(size().height());
@@ -314,6 +452,18 @@ void TextureBrowserView::doRender(Layout& layout, const float y, const float hei
   renderBounds(layout, y, height);
   renderTextures(layout, y, height);
   renderNames(layout, y, height);
+
+  commitFilteredTextures();
+
+  // textures are requested when they are rendered, so this must be checked afterwards
+  if (
+    m_thumbnails.hasPendingChanges() || m_pendingTextureGroups
+    || m_filteredTextureGroups)
+  {
+    // keep rendering until all visible thumbnails are uploaded and the filtered textures
+    // are laid out
+    update();
+  }
 }
 
 bool TextureBrowserView::doShouldRenderFocusIndicator() const
@@ -331,32 +481,23 @@ void TextureBrowserView::renderBounds(Layout& layout, const float y, const float
   using BoundsVertex = Renderer::GLVertexTypes::P2C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto* texture = cellData(cell).texture;
-            const auto& color = textureColor(*texture);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
-              color);
-          }
-        }
+        const auto& bounds = cell.itemBounds();
+        const auto* texture = cellData(cell).texture;
+        const auto& color = textureColor(*texture);
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)}, color);
       }
     }
   }
@@ -382,6 +523,14 @@ const Color& TextureBrowserView::textureColor(const Assets::Texture& texture) co
   return pref(Preferences::TextureBrowserDefaultColor);
 }
 
+size_t TextureBrowserView::thumbnailSize() const
+{
+  // textures are scaled so that their larger dimension is at most the maximum cell height
+  const auto scaleFactor = pref(Preferences::TextureBrowserIconSize);
+  const auto dpiScale = static_cast<float>(devicePixelRatioF());
+  return static_cast<size_t>(vm::ceil(scaleFactor * 128.0f * dpiScale));
+}
+
 void TextureBrowserView::renderTextures(Layout& layout, const float y, const float height)
 {
   using TextureVertex = Renderer::GLVertexTypes::P2T2::Vertex;
@@ -392,34 +541,30 @@ void TextureBrowserView::renderTextures(Layout& layout, const float y, const flo
   shader.set("Texture", 0);
   shader.set("Brightness", pref(Preferences::Brightness));
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto& bounds = cell.itemBounds();
+        const auto* texture = cellData(cell).texture;
+
+        if (m_thumbnails.activate(*texture))
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto* texture = cellData(cell).texture;
-
-            auto vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>{
-              TextureVertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
-              TextureVertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
-              TextureVertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
-              TextureVertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
-            });
-
-            shader.set("GrayScale", texture->overridden());
-            texture->activate();
-
-            vertexArray.prepare(vboManager());
-            vertexArray.render(Renderer::PrimType::Quads);
-
-            texture->deactivate();
-          }
+          auto vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>{
+            TextureVertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
+            TextureVertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
+            TextureVertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
+            TextureVertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
+          });
+
+          shader.set("GrayScale", texture->overridden());
+
+          vertexArray.prepare(vboManager());
+          vertexArray.render(Renderer::PrimType::Quads);
+
+          m_thumbnails.deactivate();
         }
       }
     }
@@ -438,20 +583,17 @@ void TextureBrowserView::renderGroupTitleBackgrounds(
   using Vertex = Renderer::GLVertexTypes::P2::Vertex;
   auto vertices = std::vector<Vertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
-    {
-      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.left(), height - (titleBounds.top() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.left(), height - (titleBounds.bottom() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.right(), height - (titleBounds.bottom() - y)});
-      vertices.emplace_back(
-        vm::vec2f{titleBounds.right(), height - (titleBounds.top() - y)});
-    }
+    const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.left(), height - (titleBounds.top() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.left(), height - (titleBounds.bottom() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.right(), height - (titleBounds.bottom() - y)});
+    vertices.emplace_back(
+      vm::vec2f{titleBounds.right(), height - (titleBounds.top() - y)});
   }
 
   auto shader =
@@ -498,80 +640,72 @@ TextureBrowserView::StringMap TextureBrowserView::collectStringVertices(
   const auto subTextColor = std::vector<Color>{pref(Preferences::BrowserSubTextColor)};
 
   auto stringVertices = StringMap{};
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto& title = group.item();
+    if (!title.empty())
+    {
+      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+      const auto offset = vm::vec2f(
+        titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height);
+
+      auto& font = fontManager().font(defaultDescriptor);
+      const auto quads = font.quads(title, false, offset);
+      const auto titleVertices = TextVertex::toList(
+        quads.size() / 2,
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
+        kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
+      auto& vertices = stringVertices[defaultDescriptor];
+      vertices.insert(
+        std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
+    }
+
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      const auto& title = group.item();
-      if (!title.empty())
+      for (const auto& cell : row.cells())
       {
-        const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-        const auto offset = vm::vec2f(
-          titleBounds.left() + 2.0f,
-          height - (titleBounds.top() - y) - titleBounds.height);
-
-        auto& font = fontManager().font(defaultDescriptor);
-        const auto quads = font.quads(title, false, offset);
-        const auto titleVertices = TextVertex::toList(
-          quads.size() / 2,
-          kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
-          kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
+        const auto titleBounds = cell.titleBounds();
+        const auto& textureFont = fontManager().font(cellData(cell).mainTitleFont);
+        const auto& groupFont = fontManager().font(cellData(cell).subTitleFont);
+
+        // y is relative to top, but OpenGL coords are relative to bottom, so invert
+        const auto titleOffset =
+          vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
+
+        const auto textureNameOffset = titleOffset + cellData(cell).mainTitleOffset;
+        const auto groupNameOffset = titleOffset + cellData(cell).subTitleOffset;
+
+        const auto& textureName = cellData(cell).mainTitle;
+        const auto& groupName = cellData(cell).subTitle;
+
+        const auto textureNameQuads =
+          textureFont.quads(textureName, false, textureNameOffset);
+        const auto groupNameQuads = groupFont.quads(groupName, false, groupNameOffset);
+
+        const auto textureNameVertices = TextVertex::toList(
+          textureNameQuads.size() / 2,
+          kdl::skip_iterator{
+            std::begin(textureNameQuads), std::end(textureNameQuads), 0, 2},
+          kdl::skip_iterator{
+            std::begin(textureNameQuads), std::end(textureNameQuads), 1, 2},
           kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-        auto& vertices = stringVertices[defaultDescriptor];
-        vertices.insert(
-          std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
-      }
 
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto titleBounds = cell.titleBounds();
-            const auto& textureFont = fontManager().font(cellData(cell).mainTitleFont);
-            const auto& groupFont = fontManager().font(cellData(cell).subTitleFont);
-
-            // y is relative to top, but OpenGL coords are relative to bottom, so invert
-            const auto titleOffset =
-              vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
-
-            const auto textureNameOffset = titleOffset + cellData(cell).mainTitleOffset;
-            const auto groupNameOffset = titleOffset + cellData(cell).subTitleOffset;
-
-            const auto& textureName = cellData(cell).mainTitle;
-            const auto& groupName = cellData(cell).subTitle;
-
-            const auto textureNameQuads =
-              textureFont.quads(textureName, false, textureNameOffset);
-            const auto groupNameQuads =
-              groupFont.quads(groupName, false, groupNameOffset);
-
-            const auto textureNameVertices = TextVertex::toList(
-              textureNameQuads.size() / 2,
-              kdl::skip_iterator{
-                std::begin(textureNameQuads), std::end(textureNameQuads), 0, 2},
-              kdl::skip_iterator{
-                std::begin(textureNameQuads), std::end(textureNameQuads), 1, 2},
-              kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-
-            const auto groupNameVertices = TextVertex::toList(
-              groupNameQuads.size() / 2,
-              kdl::skip_iterator{
-                std::begin(groupNameQuads), std::end(groupNameQuads), 0, 2},
-              kdl::skip_iterator{
-                std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2},
-              kdl::skip_iterator{std::begin(subTextColor), std::end(subTextColor), 0, 0});
-
-            auto& mainTitleVertices = stringVertices[cellData(cell).mainTitleFont];
-            mainTitleVertices =
-              kdl::vec_concat(std::move(mainTitleVertices), textureNameVertices);
-
-            auto& subTitleVertices = stringVertices[cellData(cell).subTitleFont];
-            subTitleVertices =
-              kdl::vec_concat(std::move(subTitleVertices), groupNameVertices);
-          }
-        }
+        const auto groupNameVertices = TextVertex::toList(
+          groupNameQuads.size() / 2,
+          kdl::skip_iterator{
+            std::begin(groupNameQuads), std::end(groupNameQuads), 0, 2},
+          kdl::skip_iterator{
+            std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2},
+          kdl::skip_iterator{std::begin(subTextColor), std::end(subTextColor), 0, 0});
+
+        auto& mainTitleVertices = stringVertices[cellData(cell).mainTitleFont];
+        mainTitleVertices =
+          kdl::vec_concat(std::move(mainTitleVertices), textureNameVertices);
+
+        auto& subTitleVertices = stringVertices[cellData(cell).subTitleFont];
+        subTitleVertices =
+          kdl::vec_concat(std::move(subTitleVertices), groupNameVertices);
       }
     }
   }
@@ -604,6 +738,10 @@ QString TextureBrowserView::tooltip(const Cell& cell)
   auto ss = QTextStream{&tooltip};
   ss << QString::fromStdString(cellData(cell).texture->name()) << "\n";
   ss << cellData(cell).texture->width() << "x" << cellData(cell).texture->height();
+  if (const auto savings = cellData(cell).texture->compressionSavings(); savings > 0)
+  {
+    ss << "\nCompressed, saves " << savings / 1024 << " KiB";
+  }
   return tooltip;
 }
 
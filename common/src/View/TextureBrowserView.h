@@ -22,10 +22,14 @@
 #include "NotifierConnection.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/TextureThumbnailCache.h"
 #include "View/CellView.h"
 
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -34,7 +38,6 @@ class QScrollBar;
 namespace TrenchBroom::Assets
 {
 class Texture;
-class TextureCollection;
 } // namespace TrenchBroom::Assets
 
 namespace TrenchBroom::View
@@ -61,6 +64,12 @@ enum class TextureSortOrder
   Usage
 };
 
+struct TextureGroup
+{
+  std::string name;
+  std::vector<const Assets::Texture*> textures;
+};
+
 class TextureBrowserView : public CellView
 {
   Q_OBJECT
@@ -76,6 +85,25 @@ private:
 
   const Assets::Texture* m_selectedTexture = nullptr;
 
+  struct PendingTextureGroups
+  {
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    std::future<std::vector<TextureGroup>> textureGroups;
+  };
+
+  /**
+   * The textures are filtered and sorted on a background thread when the filter or sort
+   * order change. Until the new texture groups are ready, the previous layout is shown.
+   */
+  std::optional<PendingTextureGroups> m_pendingTextureGroups;
+  std::optional<std::vector<TextureGroup>> m_filteredTextureGroups;
+
+  /**
+   * The textures are rendered using downsampled copies so that browsing large textures
+   * does not upload them at full size.
+   */
+  Renderer::TextureThumbnailCache m_thumbnails;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -95,6 +123,12 @@ public:
 
   void revealTexture(const Assets::Texture* texture);
 
+  /**
+   * Discards any textures that are being filtered in the background and lays out the
+   * textures again. Must be called when the texture collections change.
+   */
+  void reload();
+
 private:
   void usageCountDidChange();
 
@@ -110,17 +144,14 @@ private:
     Layout& layout,
     const Assets::Texture* texture,
     const std::string& groupName,
-    const Renderer::FontDescriptor& font);
-
-  const std::vector<Assets::TextureCollection>& getCollections() const;
-  std::vector<const Assets::Texture*> getTextures(
-    const Assets::TextureCollection& collection) const;
-  std::vector<const Assets::Texture*> getTextures() const;
+    const Renderer::FontDescriptor& font,
+    const Renderer::FontDescriptor& groupFont,
+    const vm::vec2f& groupNameSize);
 
-  std::vector<const Assets::Texture*> filterTextures(
-    std::vector<const Assets::Texture*> textures) const;
-  std::vector<const Assets::Texture*> sortTextures(
-    std::vector<const Assets::Texture*> textures) const;
+  std::vector<TextureGroup> getTextureGroups() const;
+  void filterTexturesInBackground();
+  void cancelFilteringTextures();
+  void commitFilteredTextures();
 
   void doClear() override;
   void doRender(Layout& layout, float y, float height) override;
@@ -129,6 +160,7 @@ private:
 
   void renderBounds(Layout& layout, float y, float height);
   const Color& textureColor(const Assets::Texture& texture) const;
+  size_t thumbnailSize() const;
   void renderTextures(Layout& layout, float y, float height);
   void renderNames(Layout& layout, float y, float height);
   void renderGroupTitleBackgrounds(Layout& layout, float y, float height);
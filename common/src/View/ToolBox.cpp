@@ -176,6 +176,11 @@ bool ToolBox::dragging() const
   return m_dragTracker != nullptr;
 }
 
+bool ToolBox::needsPickResult() const
+{
+  return !m_dragTracker || m_dragTracker->usesPickResult();
+}
+
 void ToolBox::startMouseDrag(ToolChain* chain, const InputState& inputState)
 {
   if (!m_enabled)
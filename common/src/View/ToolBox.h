@@ -102,6 +102,7 @@ public: // event handling
   void mouseMove(ToolChain* chain, const InputState& inputState);
 
   bool dragging() const;
+  bool needsPickResult() const;
   void startMouseDrag(ToolChain* chain, const InputState& inputState);
   bool mouseDrag(const InputState& inputState);
   void endMouseDrag(const InputState& inputState);
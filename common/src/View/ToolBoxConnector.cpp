@@ -62,11 +62,20 @@ void ToolBoxConnector::updatePickResult()
 {
   ensure(m_toolBox != nullptr, "toolBox is null");
 
+  const auto start = std::chrono::steady_clock::now();
+
   m_inputState.setPickRequest(
     doGetPickRequest(m_inputState.mouseX(), m_inputState.mouseY()));
   Model::PickResult pickResult = doPick(m_inputState.pickRay());
   m_toolBox->pick(m_toolChain, m_inputState, pickResult);
   m_inputState.setPickResult(std::move(pickResult));
+
+  m_totalPickTime += std::chrono::steady_clock::now() - start;
+}
+
+std::chrono::steady_clock::duration ToolBoxConnector::totalPickTime() const
+{
+  return m_totalPickTime;
 }
 
 void ToolBoxConnector::setToolBox(ToolBox& toolBox)
@@ -305,7 +314,12 @@ void ToolBoxConnector::processMouseDoubleClick(const MouseEvent& event)
 void ToolBoxConnector::processMouseMotion(const MouseEvent& event)
 {
   mouseMoved(event.posX, event.posY);
-  updatePickResult();
+  // hover feedback is not useful while the camera is moving on its own, so don't pick
+  // on every mouse move then
+  if (!doIsCameraMoving())
+  {
+    updatePickResult();
+  }
   m_toolBox->mouseMove(m_toolChain, m_inputState);
 }
 
@@ -340,7 +354,10 @@ void ToolBoxConnector::processDragStart(const MouseEvent& event)
 void ToolBoxConnector::processDrag(const MouseEvent& event)
 {
   mouseMoved(event.posX, event.posY);
-  updatePickResult();
+  if (m_toolBox->needsPickResult())
+  {
+    updatePickResult();
+  }
   if (m_toolBox->dragging())
   {
     if (!m_toolBox->mouseDrag(m_inputState))
@@ -399,5 +416,10 @@ bool ToolBoxConnector::cancelDrag()
 }
 
 void ToolBoxConnector::doShowPopupMenu() {}
+
+bool ToolBoxConnector::doIsCameraMoving() const
+{
+  return false;
+}
 } // namespace View
 } // namespace TrenchBroom
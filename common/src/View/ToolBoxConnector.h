@@ -23,6 +23,7 @@
 #include "View/InputEvent.h"
 #include "View/InputState.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -59,6 +60,8 @@ private:
   float m_lastMouseY;
   bool m_ignoreNextDrag;
 
+  std::chrono::steady_clock::duration m_totalPickTime{0};
+
 public:
   ToolBoxConnector();
   ~ToolBoxConnector() override;
@@ -69,6 +72,11 @@ public:
 
   void updatePickResult();
 
+  /**
+   * Returns the total time spent in updatePickResult().
+   */
+  std::chrono::steady_clock::duration totalPickTime() const;
+
 protected:
   void setToolBox(ToolBox& toolBox);
   void addTool(std::unique_ptr<ToolController> tool);
@@ -124,6 +132,7 @@ private:
   virtual PickRequest doGetPickRequest(float x, float y) const = 0;
   virtual Model::PickResult doPick(const vm::ray3& pickRay) const = 0;
   virtual void doShowPopupMenu();
+  virtual bool doIsCameraMoving() const;
 
   deleteCopyAndMove(ToolBoxConnector);
 };
@@ -104,6 +104,8 @@ public:
 
   void end(const InputState&) {}
   void cancel() {}
+
+  bool usesPickResult() const { return false; }
 };
 } // namespace
 
@@ -50,6 +50,7 @@
 #include "View/UVShearTool.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/vector_utils.h>
 
 #include <cassert>
 #include <memory>
@@ -204,6 +205,11 @@ void UVView::doRender()
     renderTextureAxes(renderContext, renderBatch);
 
     renderBatch.render(renderContext);
+
+    if (document->hasPendingAssets())
+    {
+      update();
+    }
   }
 }
 
@@ -302,7 +308,7 @@ private:
 
     Renderer::ActiveShader shader(
       renderContext.shaderManager(), Renderer::Shaders::UVViewShader);
-    shader.set("ApplyTexture", true);
+    shader.set("ApplyTexture", texture->isPrepared());
     shader.set("Color", texture->averageColor());
     shader.set("Brightness", pref(Preferences::Brightness));
     shader.set("RenderGrid", true);
@@ -337,22 +343,22 @@ void UVView::renderFace(Renderer::RenderContext&, Renderer::RenderBatch& renderB
 {
   assert(m_helper.valid());
 
-  const auto faceVertices = m_helper.face()->vertices();
-
-  using Vertex = Renderer::GLVertexTypes::P3::Vertex;
-  std::vector<Vertex> edgeVertices;
-  edgeVertices.reserve(faceVertices.size());
-
-  for (const auto* vertex : faceVertices)
+  auto faceVertexPositions = m_helper.face()->vertexPositions();
+  if (faceVertexPositions != m_faceVertexPositions)
   {
-    edgeVertices.push_back(Vertex(vm::vec3f(vertex->position())));
+    using Vertex = Renderer::GLVertexTypes::P3::Vertex;
+    auto edgeVertices =
+      kdl::vec_transform(faceVertexPositions, [](const auto& position) {
+        return Vertex{vm::vec3f{position}};
+      });
+
+    m_faceEdgeRenderer = Renderer::DirectEdgeRenderer{
+      Renderer::VertexArray::move(std::move(edgeVertices)), Renderer::PrimType::LineLoop};
+    m_faceVertexPositions = std::move(faceVertexPositions);
   }
 
   const Color edgeColor(1.0f, 1.0f, 1.0f, 1.0f); // TODO: make this a preference
-
-  Renderer::DirectEdgeRenderer edgeRenderer(
-    Renderer::VertexArray::move(std::move(edgeVertices)), Renderer::PrimType::LineLoop);
-  edgeRenderer.renderOnTop(renderBatch, edgeColor, 2.5f);
+  m_faceEdgeRenderer.renderOnTop(renderBatch, edgeColor, 2.5f);
 }
 
 void UVView::renderTextureAxes(
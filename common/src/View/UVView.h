@@ -23,12 +23,15 @@
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
 #include "NotifierConnection.h"
+#include "Renderer/EdgeRenderer.h"
 #include "Renderer/OrthographicCamera.h"
 #include "View/RenderView.h"
 #include "View/ToolBox.h"
 #include "View/ToolBoxConnector.h"
 #include "View/UVViewHelper.h"
 
+#include <vecmath/vec.h>
+
 #include <filesystem>
 #include <memory>
 #include <vector>
@@ -80,6 +83,13 @@ private:
 
   ToolBox m_toolBox;
 
+  /**
+   * The outline of the face is only rebuilt when the face's vertices change, and not when
+   * only its attributes change while dragging.
+   */
+  std::vector<vm::vec3> m_faceVertexPositions;
+  Renderer::DirectEdgeRenderer m_faceEdgeRenderer;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -80,6 +80,11 @@ bool UndoableCommand::doCollateWith(UndoableCommand&)
   return false;
 }
 
+size_t UndoableCommand::memorySize() const
+{
+  return sizeof(UndoableCommand) + name().capacity();
+}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade* document)
 {
   if (document && m_modificationCount)
@@ -47,6 +47,12 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes of memory used by this command, including
+   * the state it keeps to undo or redo itself.
+   */
+  virtual size_t memorySize() const;
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade* document) = 0;
@@ -107,5 +107,10 @@ bool UpdateLinkedGroupsCommandBase::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UpdateLinkedGroupsCommandBase::memorySize() const
+{
+  return UndoableCommand::memorySize() + m_updateLinkedGroupsHelper.memorySize();
+}
+
 } // namespace View
 } // namespace TrenchBroom
@@ -51,6 +51,8 @@ public:
 
   bool collateWith(UndoableCommand& command) override;
 
+  size_t memorySize() const override;
+
 private:
   deleteCopyAndMove(UpdateLinkedGroupsCommandBase);
 };
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace TrenchBroom::View
@@ -65,18 +66,29 @@ Result<void> UpdateLinkedGroupsHelper::applyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
   return computeLinkedGroupUpdates(document).transform(
-    [&]() { doApplyOrUndoLinkedGroupUpdates(document); });
+    [&]() { doApplyLinkedGroupUpdates(document); });
 }
 
 void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(MapDocumentCommandFacade& document)
 {
-  doApplyOrUndoLinkedGroupUpdates(document);
+  doUndoLinkedGroupUpdates(document);
+}
+
+static bool hasAncestorIn(
+  const Model::Node& node,
+  const std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>&
+    childrenToReplace)
+{
+  return std::any_of(
+    std::begin(childrenToReplace), std::end(childrenToReplace), [&](const auto& p) {
+      return p.first->isAncestorOf(&node);
+    });
 }
 
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
+  // childrenToReplace contains pairs p where
   // - p.first is the group node to update
   // - p.second is a vector containing the group node's original children
   //
@@ -87,24 +99,75 @@ void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
   // is not an update for a linked group node that was updated by this helper, then we
   // will add p_o to our updates and remove it from the other helper's updates to prevent
   // the replaced node to be deleted with the other helper.
+  //
+  // Likewise, contentsToSwap contains the original contents of the nodes whose contents
+  // were swapped. We keep our original contents if we swapped the same node, and we
+  // discard the other helper's contents if the node is a descendant of a group whose
+  // children we replaced, since undoing our replacement already restores the original
+  // node. The other helper may have replaced the children of a group that contains nodes
+  // whose contents we swapped. This is handled by undoing replacements before swapping
+  // contents back.
 
   auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
   auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
 
-  for (auto& [theirGroupNodeToUpdate, theirOldChildren] : theirLinkedGroupUpdates)
+  auto& myChildrenToReplace = myLinkedGroupUpdates.childrenToReplace;
+  for (auto& [theirGroupNodeToUpdate, theirOldChildren] :
+       theirLinkedGroupUpdates.childrenToReplace)
   {
     const auto myIt = std::find_if(
-      std::begin(myLinkedGroupUpdates),
-      std::end(myLinkedGroupUpdates),
+      std::begin(myChildrenToReplace),
+      std::end(myChildrenToReplace),
       [theirGroupNodeToUpdate = theirGroupNodeToUpdate](const auto& p) {
         return p.first == theirGroupNodeToUpdate;
       });
-    if (myIt == std::end(myLinkedGroupUpdates))
+    if (myIt == std::end(myChildrenToReplace))
     {
-      myLinkedGroupUpdates.emplace_back(
+      myChildrenToReplace.emplace_back(
         theirGroupNodeToUpdate, std::move(theirOldChildren));
     }
   }
+
+  auto& myContentsToSwap = myLinkedGroupUpdates.contentsToSwap;
+  auto mySwappedNodes = std::unordered_set<const Model::Node*>{};
+  for (const auto& [node, oldContents] : myContentsToSwap)
+  {
+    mySwappedNodes.insert(node);
+  }
+
+  for (auto& [theirNodeToUpdate, theirOldContents] :
+       theirLinkedGroupUpdates.contentsToSwap)
+  {
+    if (
+      mySwappedNodes.count(theirNodeToUpdate) == 0
+      && !hasAncestorIn(*theirNodeToUpdate, myChildrenToReplace))
+    {
+      myContentsToSwap.emplace_back(theirNodeToUpdate, std::move(theirOldContents));
+    }
+  }
+}
+
+size_t UpdateLinkedGroupsHelper::memorySize() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups& changedLinkedGroups) {
+        return changedLinkedGroups.size() * sizeof(Model::GroupNode*);
+      },
+      [](const LinkedGroupUpdates& linkedGroupUpdates) {
+        auto result = size_t(0);
+        for (const auto& [groupNode, children] : linkedGroupUpdates.childrenToReplace)
+        {
+          result += Model::estimateMemorySize(kdl::vec_transform(
+            children, [](const auto& child) { return child.get(); }));
+        }
+        for (const auto& [node, contents] : linkedGroupUpdates.contentsToSwap)
+        {
+          result += Model::estimateMemorySize(contents);
+        }
+        return result;
+      }),
+    m_state);
 }
 
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
@@ -141,23 +204,92 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
                    *document.world(), *groupNode->group().linkedGroupId()),
                  groupNode);
 
-               return Model::updateLinkedGroups(
-                 *groupNode, groupNodesToUpdate, worldBounds);
+               return Model::updateLinkedGroupContents(
+                        *groupNode, groupNodesToUpdate, worldBounds)
+                 .and_then([&](auto&& contentsResult) {
+                   return Model::updateLinkedGroups(
+                            *groupNode, contentsResult.groupNodesToReplace, worldBounds)
+                     .transform([&](auto&& childrenToReplace) {
+                       return LinkedGroupUpdates{
+                         std::move(childrenToReplace),
+                         kdl::vec_flatten(kdl::vec_transform(
+                           std::move(contentsResult.contentsToSwap),
+                           [](auto&& p) { return std::move(p.second); }))};
+                     });
+                 });
              }))
-    .and_then([&](auto&& nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-      return kdl::vec_flatten(std::move(nestedUpdateLists));
+    .transform([](auto&& updateLists) {
+      auto result = LinkedGroupUpdates{};
+      for (auto& updates : updateLists)
+      {
+        result.childrenToReplace = kdl::vec_concat(
+          std::move(result.childrenToReplace), std::move(updates.childrenToReplace));
+      }
+
+      // Groups are ordered so that descendants are updated before their ancestors. If a
+      // node is updated by several groups, the update of the outermost group wins, and
+      // if it is within a group whose children are replaced, the replacement wins.
+      auto nodeIndices = std::unordered_map<const Model::Node*, size_t>{};
+      for (auto& updates : updateLists)
+      {
+        for (auto& [node, newContents] : updates.contentsToSwap)
+        {
+          if (hasAncestorIn(*node, result.childrenToReplace))
+          {
+            continue;
+          }
+
+          if (const auto it = nodeIndices.find(node); it != std::end(nodeIndices))
+          {
+            result.contentsToSwap[it->second].second = std::move(newContents);
+          }
+          else
+          {
+            nodeIndices.emplace(node, result.contentsToSwap.size());
+            result.contentsToSwap.emplace_back(node, std::move(newContents));
+          }
+        }
+      }
+
+      return result;
     });
 }
 
-void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(
+void UpdateLinkedGroupsHelper::doApplyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
-  std::visit(
-    kdl::overload(
-      [](const ChangedLinkedGroups&) {},
-      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
-        m_state = document.performReplaceChildren(std::move(linkedGroupUpdates));
-      }),
-    std::move(m_state));
+  swapContents(document);
+  replaceChildren(document);
+}
+
+void UpdateLinkedGroupsHelper::doUndoLinkedGroupUpdates(
+  MapDocumentCommandFacade& document)
+{
+  // undo in reverse order, see collateWith
+  replaceChildren(document);
+  swapContents(document);
+}
+
+void UpdateLinkedGroupsHelper::swapContents(MapDocumentCommandFacade& document)
+{
+  if (auto* linkedGroupUpdates = std::get_if<LinkedGroupUpdates>(&m_state))
+  {
+    if (!linkedGroupUpdates->contentsToSwap.empty())
+    {
+      document.performSwapNodeContents(linkedGroupUpdates->contentsToSwap);
+    }
+  }
+}
+
+void UpdateLinkedGroupsHelper::replaceChildren(MapDocumentCommandFacade& document)
+{
+  if (auto* linkedGroupUpdates = std::get_if<LinkedGroupUpdates>(&m_state))
+  {
+    if (!linkedGroupUpdates->childrenToReplace.empty())
+    {
+      linkedGroupUpdates->childrenToReplace =
+        document.performReplaceChildren(std::move(linkedGroupUpdates->childrenToReplace));
+    }
+  }
 }
 } // namespace TrenchBroom::View
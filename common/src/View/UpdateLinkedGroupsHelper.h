@@ -20,6 +20,7 @@
 #pragma once
 
 #include "FloatType.h"
+#include "Model/NodeContents.h"
 #include "Result.h"
 
 #include <memory>
@@ -50,17 +51,24 @@ bool checkLinkedGroupsToUpdate(const std::vector<Model::GroupNode*>& changedLink
  *
  * The class is initialized with a vector of group nodes whose changes should be
  * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * is first called, the changes to the linked groups are computed and applied.
+ *
+ * If a linked group has the same structure as the changed group, then only the contents
+ * of those of its descendants which actually change are swapped with their new contents.
+ * Otherwise, the children of the linked group are replaced with new children. Calling
+ * undoLinkedGroupUpdates swaps the old contents and children back in, effectively undoing
+ * the change.
  */
 class UpdateLinkedGroupsHelper
 {
 private:
   using ChangedLinkedGroups = std::vector<Model::GroupNode*>;
-  using LinkedGroupUpdates =
-    std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>;
+  struct LinkedGroupUpdates
+  {
+    std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>
+      childrenToReplace;
+    std::vector<std::pair<Model::Node*, Model::NodeContents>> contentsToSwap;
+  };
   std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
 
 public:
@@ -71,11 +79,20 @@ public:
   void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void collateWith(UpdateLinkedGroupsHelper& other);
 
+  /**
+   * Returns an estimate of the memory used by the old children and contents stored by
+   * this helper.
+   */
+  size_t memorySize() const;
+
 private:
   Result<void> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
     const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document);
 
-  void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void doApplyLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void doUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void swapContents(MapDocumentCommandFacade& document);
+  void replaceChildren(MapDocumentCommandFacade& document);
 };
 } // namespace TrenchBroom::View
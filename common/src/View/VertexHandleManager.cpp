@@ -25,18 +25,47 @@
 #include "Preferences.h"
 #include "View/Grid.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/distance.h>
 #include <vecmath/intersection.h>
 #include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace TrenchBroom
 {
 namespace View
 {
 VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
+/**
+ * Indicates whether the given pick ray can hit any handle within the given bounds. Since
+ * handles are picked by testing the ray against a sphere whose radius depends on the
+ * distance of the handle to the camera, the bounds are expanded by the largest radius
+ * that any handle within them can have.
+ */
+static bool mayPickHandles(
+  const vm::ray3& pickRay,
+  const Renderer::Camera& camera,
+  const FloatType handleRadius,
+  const vm::bbox3& bounds)
+{
+  auto maxScaling = FloatType(0);
+  for (const auto& vertex : bounds.vertices())
+  {
+    const auto scaling =
+      static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f{vertex}));
+    maxScaling = std::max(maxScaling, std::abs(scaling));
+  }
+
+  const auto pickBounds = bounds.expand(FloatType(2) * handleRadius * maxScaling);
+  return pickBounds.contains(pickRay.origin)
+         || !vm::is_nan(vm::intersect_ray_bbox(pickRay, pickBounds));
+}
+
 const Model::HitType::Type VertexHandleManager::HandleHitType =
   Model::HitType::freeType();
 
@@ -45,17 +74,20 @@ void VertexHandleManager::pick(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto distance = camera.pickPointHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(distance))
-    {
-      const auto hitPoint = vm::point_at_distance(pickRay, distance);
-      const auto error = vm::squared_distance(pickRay, position).distance;
-      pickResult.addHit(Model::Hit(HandleHitType, distance, hitPoint, position, error));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandle(
+    [&](const vm::bbox3& bounds) {
+      return mayPickHandles(pickRay, camera, handleRadius, bounds);
+    },
+    [&](const Handle& position) {
+      const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
+      if (!vm::is_nan(distance))
+      {
+        const auto hitPoint = vm::point_at_distance(pickRay, distance);
+        const auto error = vm::squared_distance(pickRay, position).distance;
+        pickResult.addHit(Model::Hit(HandleHitType, distance, hitPoint, position, error));
+      }
+    });
 }
 
 void VertexHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -96,24 +128,28 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const FloatType edgeDist = camera.pickLineSegmentHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(edgeDist))
-    {
-      const vm::vec3 pointHandle =
-        grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-      const FloatType pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-      if (!vm::is_nan(pointDist))
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandle(
+    [&](const vm::bbox3& bounds) {
+      return mayPickHandles(pickRay, camera, handleRadius, bounds);
+    },
+    [&](const Handle& position) {
+      const FloatType edgeDist =
+        camera.pickLineSegmentHandle(pickRay, position, handleRadius);
+      if (!vm::is_nan(edgeDist))
       {
-        const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
-        pickResult.addHit(
-          Model::Hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        const vm::vec3 pointHandle =
+          grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
+        const FloatType pointDist =
+          camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+        if (!vm::is_nan(pointDist))
+        {
+          const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
+          pickResult.addHit(Model::Hit(
+            HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        }
       }
-    }
-  }
+    });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -121,18 +157,22 @@ void EdgeHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const vm::vec3 pointHandle = position.center();
-
-    const FloatType pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(pointDist))
-    {
-      const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
-      pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandle(
+    [&](const vm::bbox3& bounds) {
+      return mayPickHandles(pickRay, camera, handleRadius, bounds);
+    },
+    [&](const Handle& position) {
+      const vm::vec3 pointHandle = position.center();
+
+      const FloatType pointDist =
+        camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+      if (!vm::is_nan(pointDist))
+      {
+        const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
+        pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
+      }
+    });
 }
 
 void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -174,30 +214,35 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
-    if (!valid)
-    {
-      continue;
-    }
-
-    const auto distance =
-      vm::intersect_ray_polygon(pickRay, plane, std::begin(position), std::end(position));
-    if (!vm::is_nan(distance))
-    {
-      const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
-
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-      if (!vm::is_nan(pointDist))
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandle(
+    [&](const vm::bbox3& bounds) {
+      return mayPickHandles(pickRay, camera, handleRadius, bounds);
+    },
+    [&](const Handle& position) {
+      const auto [valid, plane] =
+        vm::from_points(std::begin(position), std::end(position));
+      if (!valid)
       {
-        const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
-        pickResult.addHit(
-          Model::Hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        return;
       }
-    }
-  }
+
+      const auto distance = vm::intersect_ray_polygon(
+        pickRay, plane, std::begin(position), std::end(position));
+      if (!vm::is_nan(distance))
+      {
+        const auto pointHandle =
+          grid.snap(vm::point_at_distance(pickRay, distance), plane);
+
+        const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+        if (!vm::is_nan(pointDist))
+        {
+          const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
+          pickResult.addHit(Model::Hit(
+            HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        }
+      }
+    });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -205,18 +250,21 @@ void FaceHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto pointHandle = position.center();
-
-    const auto pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(pointDist))
-    {
-      const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
-      pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandle(
+    [&](const vm::bbox3& bounds) {
+      return mayPickHandles(pickRay, camera, handleRadius, bounds);
+    },
+    [&](const Handle& position) {
+      const auto pointHandle = position.center();
+
+      const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+      if (!vm::is_nan(pointDist))
+      {
+        const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
+        pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
+      }
+    });
 }
 
 void FaceHandleManager::addHandles(const Model::BrushNode* brushNode)
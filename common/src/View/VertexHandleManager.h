@@ -28,8 +28,13 @@
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/polygon.h>
 #include <vecmath/segment.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -45,6 +50,31 @@ namespace View
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given vertex handle.
+ */
+inline vm::bbox3 handleBounds(const vm::vec3& handle)
+{
+  return vm::bbox3{handle, handle};
+}
+
+/**
+ * Returns the bounds of the given edge handle.
+ */
+inline vm::bbox3 handleBounds(const vm::segment3& handle)
+{
+  return vm::bbox3{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+/**
+ * Returns the bounds of the given face handle.
+ */
+inline vm::bbox3 handleBounds(const vm::polygon3& handle)
+{
+  return vm::bbox3::merge_all(std::begin(handle), std::end(handle));
+}
+
 class VertexHandleManagerBase
 {
 public:
@@ -173,11 +203,36 @@ protected:
   using HandleMap = std::map<H, HandleInfo>;
   using HandleEntry = typename HandleMap::value_type;
 
+  /**
+   * A cell of the spatial hash that indexes the handles by their positions. Every handle
+   * is stored in the cell that contains the center of its bounds, and the bounds of a
+   * cell are the union of the bounds of its handles.
+   */
+  struct HandleCell
+  {
+    vm::bbox3 bounds;
+    std::vector<H> handles;
+  };
+
+  using CellKey = vm::vec<int, 3>;
+  using CellMap = std::map<CellKey, HandleCell>;
+
+  /**
+   * The edge length of the cells of the spatial hash.
+   */
+  static constexpr auto CellSize = FloatType(256);
+
   /**
    * Maps a handle position to its info.
    */
   HandleMap m_handles;
 
+  /**
+   * Maps the key of a cell of the spatial hash to the cell. Only non-empty cells are
+   * stored.
+   */
+  CellMap m_cells;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -266,6 +321,23 @@ public:
     return result;
   }
 
+  /**
+   * Returns the handles in all cells of the spatial hash whose bounds pass the given
+   * test. The test should be conservative, and the returned handles may still fail the
+   * query that the test approximates.
+   *
+   * @tparam T the type of the cell test, which must be a unary predicate on vm::bbox3
+   * @param cellTest the cell test to apply
+   * @return a list containing the handles in all cells that pass the test
+   */
+  template <typename T>
+  HandleList findHandles(const T& cellTest) const
+  {
+    HandleList result;
+    forEachHandle(cellTest, [&](const Handle& handle) { result.push_back(handle); });
+    return result;
+  }
+
 private:
   template <typename T, typename O>
   void collectHandles(const T& test, O out) const
@@ -279,6 +351,31 @@ private:
     }
   }
 
+protected:
+  /**
+   * Applies the given function to the handles in all cells of the spatial hash whose
+   * bounds pass the given test.
+   *
+   * @tparam T the type of the cell test, which must be a unary predicate on vm::bbox3
+   * @tparam F the type of the function to apply to the handles
+   * @param cellTest the cell test to apply
+   * @param fun the function to apply
+   */
+  template <typename T, typename F>
+  void forEachHandle(const T& cellTest, F fun) const
+  {
+    for (const auto& [key, cell] : m_cells)
+    {
+      if (cellTest(cell.bounds))
+      {
+        for (const auto& handle : cell.handles)
+        {
+          fun(handle);
+        }
+      }
+    }
+  }
+
 public:
   /**
    * Indicates whether the given handle is contained in this manager.
@@ -324,8 +421,14 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    auto& info = m_handles[handle];
+    if (info.count == 0)
+    {
+      addToCell(handle);
+    }
+    info.inc();
   }
 
   /**
@@ -346,6 +449,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        removeFromCell(handle);
         m_handles.erase(it);
       }
       return true;
@@ -360,6 +464,7 @@ public:
   void clear()
   {
     m_handles.clear();
+    m_cells.clear();
     m_selectedHandleCount = 0;
   }
 
@@ -462,17 +567,83 @@ public:
   }
 
 private:
+  static CellKey cellKey(const vm::vec3& point)
+  {
+    return CellKey{
+      static_cast<int>(std::floor(point.x() / CellSize)),
+      static_cast<int>(std::floor(point.y() / CellSize)),
+      static_cast<int>(std::floor(point.z() / CellSize))};
+  }
+
+  void addToCell(const Handle& handle)
+  {
+    const auto bounds = handleBounds(handle);
+    auto& cell = m_cells[cellKey(bounds.center())];
+    cell.bounds = cell.handles.empty() ? bounds : vm::merge(cell.bounds, bounds);
+    cell.handles.push_back(handle);
+  }
+
+  void removeFromCell(const Handle& handle)
+  {
+    const auto it = m_cells.find(cellKey(handleBounds(handle).center()));
+    assert(it != std::end(m_cells));
+
+    auto& cell = it->second;
+    cell.handles.erase(
+      std::remove(std::begin(cell.handles), std::end(cell.handles), handle),
+      std::end(cell.handles));
+
+    if (cell.handles.empty())
+    {
+      m_cells.erase(it);
+    }
+    else
+    {
+      cell.bounds = handleBounds(cell.handles.front());
+      for (const auto& cellHandle : cell.handles)
+      {
+        cell.bounds = vm::merge(cell.bounds, handleBounds(cellHandle));
+      }
+    }
+  }
+
   template <typename F>
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+
+    // close handles are stored in the same cell or in a neighbouring cell if they are
+    // near a cell boundary
+    const auto center = handleBounds(otherHandle).center();
+    const auto minKey = cellKey(center - vm::vec3::fill(0.001));
+    const auto maxKey = cellKey(center + vm::vec3::fill(0.001));
+
+    auto closeHandles = std::vector<H>{};
+    for (auto x = minKey.x(); x <= maxKey.x(); ++x)
     {
-      if (compare(otherHandle, handle, epsilon) == 0)
+      for (auto y = minKey.y(); y <= maxKey.y(); ++y)
       {
-        fun(info);
+        for (auto z = minKey.z(); z <= maxKey.z(); ++z)
+        {
+          const auto it = m_cells.find(CellKey{x, y, z});
+          if (it != std::end(m_cells))
+          {
+            for (const auto& handle : it->second.handles)
+            {
+              if (compare(otherHandle, handle, epsilon) == 0)
+              {
+                closeHandles.push_back(handle);
+              }
+            }
+          }
+        }
       }
     }
+
+    for (const auto& handle : closeHandles)
+    {
+      fun(m_handles[handle]);
+    }
   }
 
   void select(HandleInfo& info)
@@ -545,9 +716,9 @@ public:
   std::vector<Model::BrushNode*> findIncidentBrushes(
     const Handle& handle, I begin, I end) const
   {
-    kdl::vector_set<Model::BrushNode*> result;
-    findIncidentBrushes(handle, begin, end, std::inserter(result, result.end()));
-    return result.release_data();
+    auto result = std::vector<Model::BrushNode*>{};
+    findIncidentBrushes(handle, begin, end, std::back_inserter(result));
+    return kdl::vector_set<Model::BrushNode*>{std::move(result)}.release_data();
   }
 
   /**
@@ -566,13 +737,13 @@ public:
   std::vector<Model::BrushNode*> findIncidentBrushes(
     I1 hBegin, I1 hEnd, I2 bBegin, I2 bEnd) const
   {
-    kdl::vector_set<Model::BrushNode*> result;
-    auto out = std::inserter(result, std::end(result));
+    auto result = std::vector<Model::BrushNode*>{};
+    auto out = std::back_inserter(result);
     for (auto hCur = hBegin; hCur != hEnd; ++hCur)
     {
       findIncidentBrushes(*hCur, bBegin, bEnd, out);
     }
-    return result.release_data();
+    return kdl::vector_set<Model::BrushNode*>{std::move(result)}.release_data();
   }
 
   /**
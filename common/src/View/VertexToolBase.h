@@ -147,13 +147,12 @@ public:
     return manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes));
   }
 
-  // FIXME: use vector_set
   template <typename M, typename I>
   std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, I cur, I end) const
   {
     const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
-    kdl::vector_set<Model::BrushNode*> result;
-    auto out = std::inserter(result, std::end(result));
+    auto result = std::vector<Model::BrushNode*>{};
+    auto out = std::back_inserter(result);
 
     while (cur != end)
     {
@@ -162,7 +161,7 @@ public:
       ++cur;
     }
 
-    return result.release_data();
+    return kdl::vector_set<Model::BrushNode*>{std::move(result)}.release_data();
   }
 
   virtual void pick(
@@ -215,11 +214,14 @@ public: // Handle selection
   {
     using HandleList = std::vector<H>;
 
-    const HandleList allHandles = handleManager().allHandles();
+    const HandleList candidateHandles = handleManager().findHandles(
+      [&](const vm::bbox3& bounds) { return lasso.mayIntersect(bounds); });
     HandleList selectedHandles;
 
     lasso.selected(
-      std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+      std::begin(candidateHandles),
+      std::end(candidateHandles),
+      std::back_inserter(selectedHandles));
     if (!modifySelection)
     {
       handleManager().deselectAll();
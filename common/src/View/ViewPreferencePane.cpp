@@ -161,6 +161,27 @@ QWidget* ViewPreferencePane::createViewPreferences()
   m_enableMsaa = new QCheckBox{};
   m_enableMsaa->setToolTip("Enable multisampling");
 
+  m_enableEntityLod = new QCheckBox{};
+  m_enableEntityLod->setToolTip(
+    "Render small entities with less detail in the 3D editing view.");
+  m_entityLodModelSizeSlider = new SliderWithLabel{0, 64};
+  m_entityLodModelSizeSlider->setMaximumWidth(400);
+  m_entityLodModelSizeSlider->setToolTip(
+    "Entity models smaller than this many pixels are rendered as boxes.");
+  m_entityLodBoundsSizeSlider = new SliderWithLabel{0, 16};
+  m_entityLodBoundsSizeSlider->setMaximumWidth(400);
+  m_entityLodBoundsSizeSlider->setToolTip(
+    "Entity boxes smaller than this many pixels are rendered as points.");
+  m_entityLodLabelSizeSlider = new SliderWithLabel{0, 128};
+  m_entityLodLabelSizeSlider->setMaximumWidth(400);
+  m_entityLodLabelSizeSlider->setToolTip(
+    "Entities smaller than this many pixels are rendered without their classname.");
+
+  m_enableOcclusionCulling = new QCheckBox{};
+  m_enableOcclusionCulling->setToolTip(
+    "Skip brushes and entity models that are hidden behind large brushes in the 3D "
+    "editing view.");
+
   m_textureBrowserIconSizeCombo = new QComboBox{};
   m_textureBrowserIconSizeCombo->addItem("25%");
   m_textureBrowserIconSizeCombo->addItem("50%");
@@ -197,6 +218,11 @@ QWidget* ViewPreferencePane::createViewPreferences()
   layout->addRow("Show axes", m_showAxes);
   layout->addRow("Texture mode", m_textureModeCombo);
   layout->addRow("Enable multisampling", m_enableMsaa);
+  layout->addRow("Entity LOD", m_enableEntityLod);
+  layout->addRow("Model LOD size", m_entityLodModelSizeSlider);
+  layout->addRow("Bounds LOD size", m_entityLodBoundsSizeSlider);
+  layout->addRow("Label LOD size", m_entityLodLabelSizeSlider);
+  layout->addRow("Occlusion culling", m_enableOcclusionCulling);
 
   layout->addSection("Texture Browser");
   layout->addRow("Icon size", m_textureBrowserIconSizeCombo);
@@ -238,6 +264,31 @@ void ViewPreferencePane::bindEvents()
     m_showAxes, &QCheckBox::stateChanged, this, &ViewPreferencePane::showAxesChanged);
   connect(
     m_enableMsaa, &QCheckBox::stateChanged, this, &ViewPreferencePane::enableMsaaChanged);
+  connect(
+    m_enableEntityLod,
+    &QCheckBox::stateChanged,
+    this,
+    &ViewPreferencePane::enableEntityLodChanged);
+  connect(
+    m_entityLodModelSizeSlider,
+    &SliderWithLabel::valueChanged,
+    this,
+    &ViewPreferencePane::entityLodModelSizeChanged);
+  connect(
+    m_entityLodBoundsSizeSlider,
+    &SliderWithLabel::valueChanged,
+    this,
+    &ViewPreferencePane::entityLodBoundsSizeChanged);
+  connect(
+    m_entityLodLabelSizeSlider,
+    &SliderWithLabel::valueChanged,
+    this,
+    &ViewPreferencePane::entityLodLabelSizeChanged);
+  connect(
+    m_enableOcclusionCulling,
+    &QCheckBox::stateChanged,
+    this,
+    &ViewPreferencePane::enableOcclusionCullingChanged);
   connect(
     m_themeCombo,
     QOverload<int>::of(&QComboBox::activated),
@@ -275,6 +326,11 @@ void ViewPreferencePane::doResetToDefaults()
   prefs.resetToDefault(Preferences::CameraFov);
   prefs.resetToDefault(Preferences::ShowAxes);
   prefs.resetToDefault(Preferences::EnableMSAA);
+  prefs.resetToDefault(Preferences::EnableEntityLod);
+  prefs.resetToDefault(Preferences::EntityLodModelSize);
+  prefs.resetToDefault(Preferences::EntityLodBoundsSize);
+  prefs.resetToDefault(Preferences::EntityLodLabelSize);
+  prefs.resetToDefault(Preferences::EnableOcclusionCulling);
   prefs.resetToDefault(Preferences::TextureMinFilter);
   prefs.resetToDefault(Preferences::TextureMagFilter);
   prefs.resetToDefault(Preferences::Theme);
@@ -296,6 +352,14 @@ void ViewPreferencePane::doUpdateControls()
 
   m_showAxes->setChecked(pref(Preferences::ShowAxes));
   m_enableMsaa->setChecked(pref(Preferences::EnableMSAA));
+  m_enableEntityLod->setChecked(pref(Preferences::EnableEntityLod));
+  m_entityLodModelSizeSlider->setValue(pref(Preferences::EntityLodModelSize));
+  m_entityLodBoundsSizeSlider->setValue(pref(Preferences::EntityLodBoundsSize));
+  m_entityLodLabelSizeSlider->setValue(pref(Preferences::EntityLodLabelSize));
+  m_entityLodModelSizeSlider->setEnabled(pref(Preferences::EnableEntityLod));
+  m_entityLodBoundsSizeSlider->setEnabled(pref(Preferences::EnableEntityLod));
+  m_entityLodLabelSizeSlider->setEnabled(pref(Preferences::EnableEntityLod));
+  m_enableOcclusionCulling->setChecked(pref(Preferences::EnableOcclusionCulling));
   m_themeCombo->setCurrentIndex(findThemeIndex(pref(Preferences::Theme)));
 
   const auto textureBrowserIconSize = pref(Preferences::TextureBrowserIconSize);
@@ -409,6 +473,42 @@ void ViewPreferencePane::enableMsaaChanged(const int state)
   prefs.set(Preferences::EnableMSAA, value);
 }
 
+void ViewPreferencePane::enableEntityLodChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::EnableEntityLod, value);
+
+  m_entityLodModelSizeSlider->setEnabled(value);
+  m_entityLodBoundsSizeSlider->setEnabled(value);
+  m_entityLodLabelSizeSlider->setEnabled(value);
+}
+
+void ViewPreferencePane::entityLodModelSizeChanged(const int value)
+{
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::EntityLodModelSize, value);
+}
+
+void ViewPreferencePane::entityLodBoundsSizeChanged(const int value)
+{
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::EntityLodBoundsSize, value);
+}
+
+void ViewPreferencePane::entityLodLabelSizeChanged(const int value)
+{
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::EntityLodLabelSize, value);
+}
+
+void ViewPreferencePane::enableOcclusionCullingChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::EnableOcclusionCulling, value);
+}
+
 void ViewPreferencePane::textureModeChanged(const int value)
 {
   const auto index = static_cast<size_t>(value);
@@ -40,6 +40,11 @@ private:
   QCheckBox* m_showAxes = nullptr;
   QComboBox* m_textureModeCombo = nullptr;
   QCheckBox* m_enableMsaa = nullptr;
+  QCheckBox* m_enableEntityLod = nullptr;
+  SliderWithLabel* m_entityLodModelSizeSlider = nullptr;
+  SliderWithLabel* m_entityLodBoundsSizeSlider = nullptr;
+  SliderWithLabel* m_entityLodLabelSizeSlider = nullptr;
+  QCheckBox* m_enableOcclusionCulling = nullptr;
   QComboBox* m_themeCombo = nullptr;
   QComboBox* m_textureBrowserIconSizeCombo = nullptr;
   QComboBox* m_rendererFontSizeCombo = nullptr;
@@ -68,6 +73,11 @@ private slots:
   void fovChanged(int value);
   void showAxesChanged(int state);
   void enableMsaaChanged(int state);
+  void enableEntityLodChanged(int state);
+  void entityLodModelSizeChanged(int value);
+  void entityLodBoundsSizeChanged(int value);
+  void entityLodLabelSizeChanged(int value);
+  void enableOcclusionCullingChanged(int state);
   void textureModeChanged(int index);
   void themeChanged(int index);
   void textureBrowserIconSizeChanged(int index);
@@ -86,14 +86,15 @@ std::optional<size_t> get_quadrant(const node_address& outer, const node_address
   }
 
   const auto half = outer.max() / 2 + outer.min() / 2;
-  const auto sum_of_signs = vm::sign(inner.min() - half) + vm::sign(inner.max() - half);
+  const auto inner_max = inner.max();
+  const auto sum_of_signs = vm::sign(inner.min() - half) + vm::sign(inner_max - half);
   if (sum_of_signs.x() == 0 || sum_of_signs.y() == 0 || sum_of_signs.z() == 0)
   {
     return std::nullopt;
   }
 
-  return (inner.max().x() <= half.x() ? 0 : 1) | (inner.max().y() <= half.y() ? 0 : 2)
-         | (inner.max().z() <= half.z() ? 0 : 4);
+  return (inner_max.x() <= half.x() ? 0 : 1) | (inner_max.y() <= half.y() ? 0 : 2)
+         | (inner_max.z() <= half.z() ? 0 : 4);
 }
 
 node_address get_child(const node_address& a, const size_t quadrant)
@@ -30,14 +30,19 @@
 #include <vecmath/bbox.h>
 #include <vecmath/bbox_io.h>
 #include <vecmath/intersection.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/scalar.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <optional>
 #include <ostream>
+#include <queue>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -119,11 +124,87 @@ node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
   return min_address;
 }
 
+/**
+ * Returns the address of the node that a loose octree stores the given bounds in. This is
+ * the smallest node that is at least as large as the bounds in every dimension and that
+ * contains the center of the bounds. The loose bounds of the node, which enlarge it by
+ * half of its size on every side, then contain the given bounds.
+ */
+template <typename T>
+node_address get_loose_container(const vm::bbox<T, 3>& bounds, const T min_size)
+{
+  const auto extent = vm::get_max_component(bounds.size()) / min_size;
+
+  auto address = get_address(bounds.center(), min_size);
+  while (T(1 << address.size) < extent)
+  {
+    address = get_parent(address);
+  }
+
+  return address;
+}
+
+/**
+ * The bounds of the eight children of an inner node in structure-of-arrays form, so that
+ * a query can test all children at once. min[i][j] and max[i][j] are the i-th components
+ * of the minimum and maximum corners of the j-th child.
+ */
+template <typename T>
+struct child_bounds
+{
+  std::array<std::array<T, 8>, 3> min;
+  std::array<std::array<T, 8>, 3> max;
+
+  void set(const size_t quadrant, const node_address& address)
+  {
+    const auto address_min = address.min();
+    const auto address_max = address.max();
+    for (size_t i = 0; i < 3; ++i)
+    {
+      min[i][quadrant] = T(address_min[i]);
+      max[i][quadrant] = T(address_max[i]);
+    }
+  }
+
+  /**
+   * Returns these bounds scaled by the given factor. If loose is true, every box is
+   * enlarged by half of its size on every side.
+   */
+  template <typename S>
+  child_bounds<S> scale(const S factor, const bool loose = false) const
+  {
+    auto result = child_bounds<S>{};
+    for (size_t i = 0; i < 3; ++i)
+    {
+      for (size_t j = 0; j < 8; ++j)
+      {
+        auto child_min = S(min[i][j]);
+        auto child_max = S(max[i][j]);
+        if (loose)
+        {
+          const auto half_size = (child_max - child_min) / S(2);
+          child_min -= half_size;
+          child_max += half_size;
+        }
+        result.min[i][j] = child_min * factor;
+        result.max[i][j] = child_max * factor;
+      }
+    }
+    return result;
+  }
+};
+
 } // namespace detail
 
 /**
  * An octree that allows for quick ray intersection queries.
  *
+ * In a loose octree, the bounds of every node are enlarged by half of its size on every
+ * side, and data items are stored in the smallest node whose enlarged bounds contain
+ * them, see detail::get_loose_container. Since the node of an item only depends on the
+ * center and the size of its bounds, small movements rarely move an item to a different
+ * node. Queries may return more items in a loose octree since the node bounds overlap.
+ *
  * @tparam T the floating point type
  * @tparam S the number of dimensions for vector types
  * @tparam U the node data to store in the nodes
@@ -156,6 +237,9 @@ public:
     std::vector<U> data;
     std::vector<node> children;
 
+    // the bounds of the children in units of the tree's minimum node size
+    detail::child_bounds<int> children_bounds;
+
     inner_node(
       const detail::node_address i_address,
       std::vector<U> i_data,
@@ -164,6 +248,11 @@ public:
       , data{std::move(i_data)}
       , children{std::move(i_children)}
     {
+      assert(children.size() == 8u);
+      for (size_t quadrant = 0; quadrant < 8u; ++quadrant)
+      {
+        update_child_bounds(quadrant);
+      }
     }
 
     inner_node(const detail::node_address i_address, std::vector<U> i_data)
@@ -188,6 +277,14 @@ public:
     inner_node& operator=(const inner_node&) = delete;
     inner_node& operator=(inner_node&&) noexcept = default;
 
+    /**
+     * Must be called whenever the address of the child in the given quadrant changes.
+     */
+    void update_child_bounds(const size_t quadrant)
+    {
+      children_bounds.set(quadrant, get_address(children[quadrant]));
+    }
+
     kdl_reflect_inline(inner_node, address, children);
   };
 
@@ -237,23 +334,43 @@ private:
       node);
   }
 
-  template <typename Predicate, typename Visitor>
-  static void visit_node_if(
-    const node& node, const Visitor& visitor, const Predicate& predicate)
+  /**
+   * Appends the data of the given node and of those of its descendants that pass the
+   * given test to the given output iterator. The test is passed the bounds of the children
+   * of an inner node, all at once, and returns for each child whether to visit it.
+   */
+  template <typename ChildrenTest, typename O>
+  void collect_data_if(const node& node, const ChildrenTest& children_test, O& out) const
   {
-    if (predicate(node))
+    const auto& data = get_data(node);
+    out = std::copy(data.begin(), data.end(), out);
+
+    if (const auto* inner = std::get_if<inner_node>(&node))
     {
-      visitor(node);
-      std::visit(
-        kdl::overload(
-          [&](const inner_node& inner_node) {
-            for (const auto& child : inner_node.children)
-            {
-              visit_node_if(child, visitor, predicate);
-            }
-          },
-          [&](const leaf_node&) {}),
-        node);
+      const auto visit_child =
+        children_test(inner->children_bounds.scale(m_min_size, m_loose));
+      for (size_t i = 0; i < 8u; ++i)
+      {
+        if (visit_child[i])
+        {
+          collect_data_if(inner->children[i], children_test, out);
+        }
+      }
+    }
+  }
+
+  /**
+   * Appends the data of the nodes that pass the given tests to the given output iterator.
+   * The root node is tested with the given root test and the children of the inner nodes
+   * are tested with the given children test, see collect_data_if.
+   */
+  template <typename RootTest, typename ChildrenTest, typename O>
+  void find_data_if(
+    const RootTest& root_test, const ChildrenTest& children_test, O& out) const
+  {
+    if (m_root && root_test(node_bounds(get_address(*m_root))))
+    {
+      collect_data_if(*m_root, children_test, out);
     }
   }
 
@@ -282,6 +399,7 @@ private:
 
       auto container_node = inner_node{container_address, {}};
       container_node.children[*container_quadrant] = std::move(node);
+      container_node.update_child_bounds(*container_quadrant);
       node = std::move(container_node);
     }
 
@@ -292,6 +410,7 @@ private:
         kdl::overload(
           [&](inner_node& i) {
             insert_into_node(i.children[*quadrant], address, std::move(data));
+            i.update_child_bounds(*quadrant);
           },
           [&](leaf_node& l) {
             if (l.data.empty())
@@ -313,6 +432,105 @@ private:
     }
   }
 
+  /**
+   * Builds a node with the given address containing the given data items. Items whose
+   * address is not contained in any quadrant of the given address are stored in the node
+   * itself, the others are partitioned by quadrant and stored in child nodes. Each child
+   * node gets the smallest address that contains all of its items, so that no unnecessary
+   * inner nodes are created.
+   *
+   * The addresses of the data items are recorded in the given map.
+   *
+   * @throws NodeTreeException if any data item occurs more than once
+   */
+  static node build_node(
+    const detail::node_address& address,
+    std::vector<std::tuple<detail::node_address, U>> items,
+    std::unordered_map<U, detail::node_address>& node_address_for_data)
+  {
+    auto data = std::vector<U>{};
+    auto child_items = std::array<std::vector<std::tuple<detail::node_address, U>>, 8>{};
+
+    for (auto& [item_address, item_data] : items)
+    {
+      if (const auto quadrant = get_quadrant(address, item_address))
+      {
+        child_items[*quadrant].emplace_back(item_address, std::move(item_data));
+      }
+      else
+      {
+        if (!node_address_for_data.emplace(item_data, address).second)
+        {
+          throw NodeTreeException("Data already in tree");
+        }
+        data.push_back(std::move(item_data));
+      }
+    }
+
+    if (std::all_of(child_items.begin(), child_items.end(), [](const auto& c) {
+          return c.empty();
+        }))
+    {
+      return leaf_node{address, std::move(data)};
+    }
+
+    auto children = std::vector<node>{};
+    children.reserve(8);
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      auto& items_in_quadrant = child_items[quadrant];
+      if (items_in_quadrant.empty())
+      {
+        children.emplace_back(leaf_node{get_child(address, quadrant), {}});
+      }
+      else
+      {
+        auto child_address = std::get<0>(items_in_quadrant.front());
+        for (const auto& [item_address, item_data] : items_in_quadrant)
+        {
+          child_address = get_container(child_address, item_address);
+        }
+        children.push_back(build_node(
+          child_address, std::move(items_in_quadrant), node_address_for_data));
+      }
+    }
+
+    return inner_node{address, std::move(data), std::move(children)};
+  }
+
+  /**
+   * Replaces the contents of this tree with the given data items, stored at the given
+   * addresses.
+   *
+   * @throws NodeTreeException if any data item occurs more than once
+   */
+  void rebuild(std::vector<std::tuple<detail::node_address, U>> all_items)
+  {
+    if (all_items.empty())
+    {
+      clear();
+      return;
+    }
+
+    // find the smallest root address that contains all items
+    auto root_address = std::optional<detail::node_address>{};
+    for (const auto& [address, data] : all_items)
+    {
+      if (!root_address || !root_address->contains(address))
+      {
+        const auto item_root_address = is_root(address) ? address : get_root(address);
+        assert(!root_address || item_root_address.contains(*root_address));
+        root_address = item_root_address;
+      }
+    }
+
+    auto node_address_for_data = std::unordered_map<U, detail::node_address>{};
+    node_address_for_data.reserve(all_items.size());
+
+    m_root = build_node(*root_address, std::move(all_items), node_address_for_data);
+    m_node_address_for_data = std::move(node_address_for_data);
+  }
+
   void remove_from_node(node& node, const detail::node_address& address, const U& data)
   {
     std::visit(
@@ -321,6 +539,7 @@ private:
           if (const auto quadrant = get_quadrant(i.address, address))
           {
             remove_from_node(i.children[*quadrant], address, data);
+            i.update_child_bounds(*quadrant);
           }
           else
           {
@@ -359,20 +578,48 @@ private:
       node);
   }
 
+  /**
+   * Returns the address of the node to store a data item with the given bounds in.
+   */
+  detail::node_address container_address(const vm::bbox<T, 3>& bounds) const
+  {
+    return m_loose ? detail::get_loose_container(bounds, m_min_size)
+                   : detail::get_container(bounds, m_min_size);
+  }
+
+  /**
+   * Returns the bounds of the node with the given address, enlarged if this is a loose
+   * octree.
+   */
+  vm::bbox<T, 3> node_bounds(const detail::node_address& address) const
+  {
+    const auto bounds = address.template to_bounds<T>(m_min_size);
+    if (!m_loose)
+    {
+      return bounds;
+    }
+
+    const auto half_size = vm::vec<T, 3>::fill(T(1 << address.size) * m_min_size / T(2));
+    return {bounds.min - half_size, bounds.max + half_size};
+  }
+
 private:
   std::optional<node> m_root;
   T m_min_size;
+  bool m_loose;
   std::unordered_map<U, detail::node_address> m_node_address_for_data;
 
 public:
-  explicit octree(const T min_size)
+  explicit octree(const T min_size, const bool loose = false)
     : m_min_size{min_size}
+    , m_loose{loose}
   {
   }
 
   octree(const T min_size, node root)
     : m_root{std::move(root)}
     , m_min_size{min_size}
+    , m_loose{false}
   {
     auto visitor = kdl::overload(
       [&](auto&& self, const inner_node& node) -> void {
@@ -415,7 +662,7 @@ public:
       throw NodeTreeException("Data already in tree");
     }
 
-    const auto address = detail::get_container(bounds, m_min_size);
+    const auto address = container_address(bounds);
     if (is_root(address))
     {
       if (!m_root)
@@ -446,6 +693,51 @@ public:
     }
   }
 
+  /**
+   * Inserts the given data items with their bounds into this tree.
+   *
+   * If this tree is empty or if there are at least as many items to insert as there are
+   * items in this tree, the tree is rebuilt from the top down: all items are partitioned
+   * by quadrant once, which is much faster than inserting them one by one. Otherwise, the
+   * items are inserted one by one.
+   *
+   * @param items the bounds and data to insert
+   *
+   * @throws NodeTreeException if any of the given bounds is invalid or if any of the
+   * given data items is already in this tree or occurs more than once
+   */
+  void insert(std::vector<std::tuple<vm::bbox<T, 3>, U>> items)
+  {
+    if (items.size() < m_node_address_for_data.size())
+    {
+      for (auto& [bounds, data] : items)
+      {
+        insert(bounds, std::move(data));
+      }
+      return;
+    }
+
+    auto all_items = std::vector<std::tuple<detail::node_address, U>>{};
+    all_items.reserve(m_node_address_for_data.size() + items.size());
+
+    for (const auto& [data, address] : m_node_address_for_data)
+    {
+      all_items.emplace_back(address, data);
+    }
+
+    for (auto& [bounds, data] : items)
+    {
+      check(bounds);
+      if (contains(data))
+      {
+        throw NodeTreeException("Data already in tree");
+      }
+      all_items.emplace_back(container_address(bounds), std::move(data));
+    }
+
+    rebuild(std::move(all_items));
+  }
+
 
   /**
    * Removes the node with the given data from this tree.
@@ -484,11 +776,81 @@ public:
   {
     check(newBounds);
 
-    if (!remove(data))
+    const auto i_address = m_node_address_for_data.find(data);
+    if (i_address == m_node_address_for_data.end())
     {
       throw NodeTreeException("node not found");
     }
-    insert(newBounds, data);
+
+    if (container_address(newBounds) != i_address->second)
+    {
+      remove(data);
+      insert(newBounds, data);
+    }
+  }
+
+  /**
+   * Updates the nodes with the given data with the given new bounds.
+   *
+   * Items whose node address does not change are left in place. If many items move to a
+   * different node, the tree is rebuilt once, otherwise the moved items are removed and
+   * inserted one by one.
+   *
+   * @param items the new bounds and data of the nodes to update
+   *
+   * @return the number of items that were moved to a different node
+   *
+   * @throws NodeTreeException if any of the given bounds is invalid or if any of the given
+   * data items cannot be found in this tree
+   */
+  size_t update(std::vector<std::tuple<vm::bbox<T, 3>, U>> items)
+  {
+    auto moved_items = std::vector<std::tuple<vm::bbox<T, 3>, detail::node_address, U>>{};
+    moved_items.reserve(items.size());
+
+    for (auto& [bounds, data] : items)
+    {
+      check(bounds);
+
+      const auto i_address = m_node_address_for_data.find(data);
+      if (i_address == m_node_address_for_data.end())
+      {
+        throw NodeTreeException("node not found");
+      }
+
+      const auto address = container_address(bounds);
+      if (address != i_address->second)
+      {
+        moved_items.emplace_back(bounds, address, std::move(data));
+      }
+    }
+
+    if (moved_items.size() * 2u < m_node_address_for_data.size())
+    {
+      for (auto& [bounds, address, data] : moved_items)
+      {
+        remove(data);
+        insert(bounds, std::move(data));
+      }
+      return moved_items.size();
+    }
+
+    auto all_items = std::vector<std::tuple<detail::node_address, U>>{};
+    all_items.reserve(m_node_address_for_data.size());
+
+    for (auto& [bounds, address, data] : moved_items)
+    {
+      m_node_address_for_data.erase(data);
+      all_items.emplace_back(address, std::move(data));
+    }
+
+    for (const auto& [data, address] : m_node_address_for_data)
+    {
+      all_items.emplace_back(address, data);
+    }
+
+    rebuild(std::move(all_items));
+    return moved_items.size();
   }
 
   /**
@@ -532,19 +894,90 @@ public:
   template <typename O>
   void find_intersectors(const vm::ray<T, 3>& ray, O out) const
   {
-    if (m_root)
+    find_data_if(
+      [&](const auto& bounds) {
+        return bounds.contains(ray.origin)
+               || !vm::is_nan(vm::intersect_ray_bbox(ray, bounds));
+      },
+      [&](const auto& children_bounds) {
+        const auto distances =
+          vm::intersect_ray_bboxes(ray, children_bounds.min, children_bounds.max);
+        auto result = std::array<bool, 8>{};
+        for (size_t j = 0; j < 8u; ++j)
+        {
+          result[j] = !vm::is_nan(distances[j]);
+        }
+        return result;
+      },
+      out);
+  }
+
+  /**
+   * Passes every data item in this tree whose bounding box intersects with the given ray
+   * to the given visitor, nearest first.
+   *
+   * The tree nodes are visited in the order of the distances at which the ray enters them,
+   * and the data items of each node are passed to the visitor in turn. The visitor returns
+   * the distance beyond which it is not interested in any more data items, so the
+   * traversal stops once every remaining node is entered farther away than the smallest
+   * distance returned so far. The visitor must account for the fact that a data item may
+   * be entered closer than its node: only nodes, but not data items are ordered.
+   *
+   * @tparam F the visitor type, a function that takes a data item and returns a distance
+   * @param ray the ray to test
+   * @param visitor the visitor to pass the data items to
+   */
+  template <typename F>
+  void visit_intersectors_nearest_first(const vm::ray<T, 3>& ray, const F& visitor) const
+  {
+    if (!m_root)
     {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          const auto bounds = get_address(node).to_bounds(m_min_size);
-          return bounds.contains(ray.origin)
-                 || !vm::is_nan(vm::intersect_ray_bbox(ray, bounds));
-        });
+      return;
+    }
+
+    const auto root_bounds = node_bounds(get_address(*m_root));
+    const auto root_distance = root_bounds.contains(ray.origin)
+                                 ? T(0)
+                                 : vm::intersect_ray_bbox(ray, root_bounds);
+    if (vm::is_nan(root_distance))
+    {
+      return;
+    }
+
+    using entry = std::tuple<T, const node*>;
+    const auto farther = [](const entry& lhs, const entry& rhs) {
+      return std::get<0>(lhs) > std::get<0>(rhs);
+    };
+    auto queue = std::priority_queue<entry, std::vector<entry>, decltype(farther)>{farther};
+    queue.emplace(root_distance, &*m_root);
+
+    auto max_distance = std::numeric_limits<T>::infinity();
+    while (!queue.empty() && std::get<0>(queue.top()) <= max_distance)
+    {
+      const auto* node = std::get<1>(queue.top());
+      queue.pop();
+
+      for (const auto& data : get_data(*node))
+      {
+        max_distance = vm::min(max_distance, visitor(data));
+      }
+
+      if (const auto* inner = std::get_if<inner_node>(node))
+      {
+        const auto children_bounds = inner->children_bounds.scale(m_min_size, m_loose);
+        const auto distances =
+          vm::intersect_ray_bboxes(ray, children_bounds.min, children_bounds.max);
+        for (size_t j = 0; j < 8u; ++j)
+        {
+          if (!vm::is_nan(distances[j]))
+          {
+            // intersect_ray_bboxes returns the exit distance if the origin is inside
+            const auto entry_distance =
+              contains(children_bounds, j, ray.origin) ? T(0) : distances[j];
+            queue.emplace(entry_distance, &inner->children[j]);
+          }
+        }
+      }
     }
   }
 
@@ -573,19 +1006,77 @@ public:
   template <typename O>
   void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
   {
-    if (m_root)
-    {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          const auto bounds = get_address(node).to_bounds(m_min_size);
-          return bbox.intersects(bounds);
+    find_data_if(
+      [&](const auto& bounds) { return bbox.intersects(bounds); },
+      [&](const auto& children_bounds) {
+        auto result = std::array<bool, 8>{};
+        result.fill(true);
+        for (size_t i = 0; i < 3u; ++i)
+        {
+          for (size_t j = 0; j < 8u; ++j)
+          {
+            result[j] = result[j] && bbox.max[i] >= children_bounds.min[i][j]
+                        && bbox.min[i] <= children_bounds.max[i][j];
+          }
+        }
+        return result;
+      },
+      out);
+  }
+
+  /**
+   * Finds every data item in this tree that may intersect with the convex volume bounded
+   * by the given planes and returns a list of those items. The normals of the planes must
+   * point out of the volume.
+   *
+   * Only the bounds of the tree nodes are tested, so the result may contain items whose
+   * bounds do not intersect with the volume.
+   *
+   * @param planes the planes bounding the volume to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const std::vector<vm::plane<T, 3>>& planes) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(planes, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree that may intersect with the convex volume bounded
+   * by the given planes and appends it to the given output iterator. The normals of the
+   * planes must point out of the volume.
+   *
+   * Only the bounds of the tree nodes are tested, so the result may contain items whose
+   * bounds do not intersect with the volume.
+   *
+   * @tparam O the output iterator type
+   * @param planes the planes bounding the volume to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const std::vector<vm::plane<T, 3>>& planes, O out) const
+  {
+    find_data_if(
+      [&](const auto& bounds) {
+        return std::none_of(planes.begin(), planes.end(), [&](const auto& plane) {
+          return is_above(bounds, plane);
         });
-    }
+      },
+      [&](const auto& children_bounds) {
+        auto result = std::array<bool, 8>{};
+        result.fill(true);
+        for (const auto& plane : planes)
+        {
+          const auto above = is_above(children_bounds, plane);
+          for (size_t j = 0; j < 8u; ++j)
+          {
+            result[j] = result[j] && !above[j];
+          }
+        }
+        return result;
+      },
+      out);
   }
 
   /**
@@ -613,23 +1104,86 @@ public:
   template <typename O>
   void find_containers(const vm::vec<T, 3>& point, O out) const
   {
-    if (m_root)
+    find_data_if(
+      [&](const auto& bounds) { return bounds.contains(point); },
+      [&](const auto& children_bounds) {
+        auto result = std::array<bool, 8>{};
+        result.fill(true);
+        for (size_t i = 0; i < 3u; ++i)
+        {
+          for (size_t j = 0; j < 8u; ++j)
+          {
+            result[j] = result[j] && point[i] >= children_bounds.min[i][j]
+                        && point[i] <= children_bounds.max[i][j];
+          }
+        }
+        return result;
+      },
+      out);
+  }
+
+  kdl_reflect_inline(octree, m_root, m_min_size, m_loose, m_node_address_for_data);
+
+private:
+  /**
+   * Indicates whether the given bounding box is entirely above the given plane.
+   */
+  static bool is_above(const vm::bbox<T, 3>& bounds, const vm::plane<T, 3>& plane)
+  {
+    // the vertex of the bounding box that is furthest below the plane
+    auto vertex = bounds.max;
+    for (size_t i = 0; i < 3; ++i)
     {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          return get_address(node).to_bounds(m_min_size).contains(point);
-        });
+      if (plane.normal[i] > T(0))
+      {
+        vertex[i] = bounds.min[i];
+      }
     }
+    return plane.point_distance(vertex) > T(0);
   }
 
-  kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
+  /**
+   * Indicates whether the j-th of the given bounding boxes contains the given point.
+   */
+  static bool contains(
+    const detail::child_bounds<T>& bounds, const size_t j, const vm::vec<T, 3>& point)
+  {
+    for (size_t i = 0; i < 3u; ++i)
+    {
+      if (point[i] < bounds.min[i][j] || point[i] > bounds.max[i][j])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Indicates for each of the given bounding boxes whether it is entirely above the given
+   * plane.
+   */
+  static std::array<bool, 8> is_above(
+    const detail::child_bounds<T>& bounds, const vm::plane<T, 3>& plane)
+  {
+    auto dots = std::array<T, 8>{};
+    for (size_t i = 0; i < 3u; ++i)
+    {
+      // the vertices of the bounding boxes that are furthest below the plane
+      const auto& vertices = plane.normal[i] > T(0) ? bounds.min[i] : bounds.max[i];
+      for (size_t j = 0; j < 8u; ++j)
+      {
+        dots[j] += plane.normal[i] * vertices[j];
+      }
+    }
+
+    auto result = std::array<bool, 8>{};
+    for (size_t j = 0; j < 8u; ++j)
+    {
+      result[j] = dots[j] - plane.distance > T(0);
+    }
+    return result;
+  }
 
-private:
   void check(const vm::bbox<T, 3>& bounds) const
   {
     if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
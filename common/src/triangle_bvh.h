@@ -0,0 +1,281 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace TrenchBroom
+{
+
+/**
+ * A bounding volume hierarchy over a fixed set of triangles that can be intersected with
+ * rays.
+ *
+ * The hierarchy is stored in a single array of nodes in depth first order, so the first
+ * child of a node immediately follows it. The triangles are reordered so that the
+ * triangles of each leaf are stored contiguously.
+ *
+ * @tparam T the component type
+ */
+template <typename T>
+class triangle_bvh
+{
+public:
+  using vec_type = vm::vec<T, 3>;
+  using box_type = vm::bbox<T, 3>;
+  using ray_type = vm::ray<T, 3>;
+
+private:
+  static constexpr std::size_t max_leaf_size = 4;
+
+  /**
+   * The maximum depth of the hierarchy. Since every split halves the triangles, this is
+   * only reached with more than 2^max_depth triangles. The traversal stack holds at most
+   * one node per level.
+   */
+  static constexpr std::size_t max_depth = 32;
+
+  struct node
+  {
+    box_type bounds;
+
+    /**
+     * For a leaf, the index of its first triangle. For an inner node, the index of its
+     * second child.
+     */
+    std::uint32_t offset;
+
+    /**
+     * For a leaf, the number of its triangles. For an inner node, 0.
+     */
+    std::uint32_t count;
+  };
+
+  std::vector<node> m_nodes;
+  std::vector<vec_type> m_points;
+
+public:
+  /**
+   * Creates an empty hierarchy.
+   */
+  triangle_bvh() = default;
+
+  /**
+   * Creates a hierarchy over the given triangles.
+   *
+   * @param points the triangle corners, three per triangle
+   */
+  explicit triangle_bvh(const std::vector<vec_type>& points)
+  {
+    assert(points.size() % 3 == 0);
+
+    const auto triangle_count = points.size() / 3;
+    if (triangle_count == 0)
+    {
+      return;
+    }
+
+    auto centers = std::vector<vec_type>{};
+    centers.reserve(triangle_count);
+    for (std::size_t i = 0; i < triangle_count; ++i)
+    {
+      centers.push_back((points[3 * i] + points[3 * i + 1] + points[3 * i + 2]) / T(3));
+    }
+
+    auto order = std::vector<std::uint32_t>(triangle_count);
+    std::iota(order.begin(), order.end(), std::uint32_t(0));
+
+    m_nodes.reserve(2 * triangle_count / max_leaf_size + 1);
+    build(points, centers, order, 0, triangle_count, 0);
+
+    m_points.reserve(points.size());
+    for (const auto i : order)
+    {
+      m_points.push_back(points[3 * i]);
+      m_points.push_back(points[3 * i + 1]);
+      m_points.push_back(points[3 * i + 2]);
+    }
+  }
+
+  /**
+   * Indicates whether this hierarchy contains no triangles.
+   */
+  bool empty() const { return m_nodes.empty(); }
+
+  /**
+   * Returns the number of triangles in this hierarchy.
+   */
+  std::size_t triangle_count() const { return m_points.size() / 3; }
+
+  /**
+   * Returns the number of nodes in this hierarchy.
+   */
+  std::size_t node_count() const { return m_nodes.size(); }
+
+  /**
+   * Returns the number of bytes occupied by this hierarchy.
+   */
+  std::size_t memory_usage() const
+  {
+    return m_nodes.capacity() * sizeof(node) + m_points.capacity() * sizeof(vec_type);
+  }
+
+  /**
+   * Intersects the given ray with the triangles in this hierarchy.
+   *
+   * @return the distance to the closest intersection, or NaN if the ray does not hit any
+   * triangle
+   */
+  T intersect(const ray_type& ray) const
+  {
+    auto closest = vm::nan<T>();
+    if (m_nodes.empty())
+    {
+      return closest;
+    }
+
+    // a node may be skipped if the ray enters it behind the closest hit found so far,
+    // unless the ray's origin is inside of it, in which case the distance is that of the
+    // exit point
+    const auto can_skip = [&](const node& node, const T distance) {
+      return vm::is_nan(distance)
+             || (distance > closest && !node.bounds.contains(ray.origin));
+    };
+
+    struct entry
+    {
+      std::uint32_t node_index;
+      T distance;
+    };
+
+    auto stack = std::array<entry, max_depth + 1>{};
+    auto stack_size = std::size_t(0);
+    stack[stack_size++] = entry{
+      0, vm::intersect_ray_bboxes(ray, std::array<box_type, 1>{m_nodes[0].bounds})[0]};
+
+    while (stack_size > 0)
+    {
+      const auto [node_index, distance] = stack[--stack_size];
+      const auto& node = m_nodes[node_index];
+      if (can_skip(node, distance))
+      {
+        continue;
+      }
+
+      if (node.count > 0)
+      {
+        for (auto i = node.offset; i < node.offset + node.count; ++i)
+        {
+          closest = vm::safe_min(
+            closest,
+            vm::intersect_ray_triangle(
+              ray, m_points[3 * i], m_points[3 * i + 1], m_points[3 * i + 2]));
+        }
+      }
+      else
+      {
+        // test both children at once and visit the closer one first
+        const auto first = node_index + 1;
+        const auto second = node.offset;
+        const auto distances = vm::intersect_ray_bboxes(
+          ray, std::array<box_type, 2>{m_nodes[first].bounds, m_nodes[second].bounds});
+
+        assert(stack_size + 2 <= stack.size());
+        if (distances[1] < distances[0])
+        {
+          stack[stack_size++] = entry{first, distances[0]};
+          stack[stack_size++] = entry{second, distances[1]};
+        }
+        else
+        {
+          stack[stack_size++] = entry{second, distances[1]};
+          stack[stack_size++] = entry{first, distances[0]};
+        }
+      }
+    }
+
+    return closest;
+  }
+
+private:
+  std::uint32_t build(
+    const std::vector<vec_type>& points,
+    const std::vector<vec_type>& centers,
+    std::vector<std::uint32_t>& order,
+    const std::size_t first,
+    const std::size_t count,
+    const std::size_t depth)
+  {
+    auto bounds = typename box_type::builder{};
+    auto center_bounds = typename box_type::builder{};
+    for (auto i = first; i < first + count; ++i)
+    {
+      const auto t = order[i];
+      bounds.add(points[3 * t]);
+      bounds.add(points[3 * t + 1]);
+      bounds.add(points[3 * t + 2]);
+      center_bounds.add(centers[t]);
+    }
+
+    const auto node_index = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.push_back(node{bounds.bounds(), 0, 0});
+
+    if (count <= max_leaf_size || depth == max_depth)
+    {
+      m_nodes[node_index].offset = static_cast<std::uint32_t>(first);
+      m_nodes[node_index].count = static_cast<std::uint32_t>(count);
+      return node_index;
+    }
+
+    // split at the median of the triangle centers along the longest axis
+    const auto axis = vm::find_max_component(center_bounds.bounds().size());
+    const auto middle = first + count / 2;
+    const auto at = [&](const auto i) {
+      return std::next(order.begin(), static_cast<std::ptrdiff_t>(i));
+    };
+    std::nth_element(
+      at(first),
+      at(middle),
+      at(first + count),
+      [&](const auto lhs, const auto rhs) {
+        return centers[lhs][axis] < centers[rhs][axis];
+      });
+
+    build(points, centers, order, first, middle - first, depth + 1);
+    m_nodes[node_index].offset =
+      build(points, centers, order, middle, first + count - middle, depth + 1);
+    return node_index;
+  }
+};
+
+} // namespace TrenchBroom
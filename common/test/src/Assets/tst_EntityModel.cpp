@@ -26,6 +26,7 @@
 #include "Model/GameImpl.h"
 #include "Renderer/IndexRangeMapBuilder.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/VertexBufferPool.h"
 #include "TestLogger.h"
 #include "TestUtils.h"
 
@@ -137,13 +138,65 @@ TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
 
   // even though the model has 2 skins, we should get a valid renderer even if we request
   // to use skin 3
-  const auto renderer0 = model.buildRenderer(0, 0);
-  const auto renderer1 = model.buildRenderer(1, 0);
-  const auto renderer2 = model.buildRenderer(2, 0);
+  auto vertexBufferPool = Renderer::VertexBufferPool{};
+  const auto renderer0 = model.buildRenderer(0, 0, vertexBufferPool);
+  const auto renderer1 = model.buildRenderer(1, 0, vertexBufferPool);
+  const auto renderer2 = model.buildRenderer(2, 0, vertexBufferPool);
 
   CHECK(renderer0 != nullptr);
   CHECK(renderer1 != nullptr);
   CHECK(renderer2 != nullptr);
 }
+
+TEST_CASE("EntityModelTest.addElementMesh")
+{
+  auto model = EntityModel{"test", PitchType::Normal, Orientation::Oriented};
+  model.addFrame();
+  auto& frame = model.loadFrame(0, "test", vm::bbox3f{0, 8});
+
+  auto& surface = model.addSurface("surface");
+
+  auto textures = std::vector<Texture>{};
+  textures.push_back(makeDummyTexture("skin"));
+  surface.setSkins(std::move(textures));
+
+  const auto skinSize = size_t(4);
+
+  SECTION("Triangles share vertices")
+  {
+    // a quad in the XY plane made of two triangles
+    auto vertices = std::vector<EntityModelVertex>{
+      EntityModelVertex{vm::vec3f{0, 0, 0}, vm::vec2f{0, 0}},
+      EntityModelVertex{vm::vec3f{8, 0, 0}, vm::vec2f{1, 0}},
+      EntityModelVertex{vm::vec3f{8, 8, 0}, vm::vec2f{1, 1}},
+      EntityModelVertex{vm::vec3f{0, 8, 0}, vm::vec2f{0, 1}},
+    };
+    surface.addElementMesh(frame, std::move(vertices), {0, 1, 2, 2, 3, 0});
+
+    CHECK(
+      surface.memoryUsage()
+      == skinSize + 4 * sizeof(EntityModelVertex) + 6 * sizeof(uint16_t));
+    auto vertexBufferPool = Renderer::VertexBufferPool{};
+    CHECK(model.buildRenderer(0, 0, vertexBufferPool) != nullptr);
+
+    CHECK(
+      frame.intersect(vm::ray3f{vm::vec3f{2, 6, 8}, vm::vec3f::neg_z()})
+      == Approx(8.0f));
+    CHECK(
+      frame.intersect(vm::ray3f{vm::vec3f{6, 2, 8}, vm::vec3f::neg_z()})
+      == Approx(8.0f));
+    CHECK(vm::is_nan(frame.intersect(vm::ray3f{vm::vec3f{9, 2, 8}, vm::vec3f::neg_z()})));
+  }
+
+  SECTION("Large meshes use 32 bit indices")
+  {
+    auto vertices = std::vector<EntityModelVertex>(70000);
+    surface.addElementMesh(frame, std::move(vertices), {0, 1, 69999});
+
+    CHECK(
+      surface.memoryUsage()
+      == skinSize + 70000 * sizeof(EntityModelVertex) + 3 * sizeof(uint32_t));
+  }
+}
 } // namespace Assets
 } // namespace TrenchBroom
@@ -18,9 +18,13 @@
  */
 
 #include "Assets/Palette.h"
+#include "Assets/TextureBuffer.h"
+#include "Color.h"
 #include "Error.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
 #include "Result.h"
 
 #include <kdl/result.h>
@@ -215,4 +219,55 @@ TEST_CASE("loadPalette")
 
   CHECK(loadPalette(*file, filePath) == expectedPalette);
 }
+
+TEST_CASE("Palette.indexedToRgba")
+{
+  const auto palette =
+    makePalette({0x10, 0x20, 0x30, 0x40, 0x50, 0x60}, PaletteColorFormat::Rgb).value();
+
+  const auto indices = std::vector<char>{0, 1, 1, 0, 1, 1};
+  auto reader = IO::Reader::from(indices.data(), indices.data() + indices.size());
+
+  auto rgbaImage = TextureBuffer{indices.size() * 4};
+  auto averageColor = Color{};
+
+  SECTION("Opaque")
+  {
+    CHECK_FALSE(palette.indexedToRgba(
+      reader, indices.size(), rgbaImage, PaletteTransparency::Opaque, averageColor));
+
+    CHECK(
+      std::vector<unsigned char>(rgbaImage.data(), rgbaImage.data() + rgbaImage.size())
+      == std::vector<unsigned char>{
+        0x10, 0x20, 0x30, 0xFF, 0x40, 0x50, 0x60, 0xFF, 0x40, 0x50, 0x60, 0xFF,
+        0x10, 0x20, 0x30, 0xFF, 0x40, 0x50, 0x60, 0xFF, 0x40, 0x50, 0x60, 0xFF,
+      });
+    CHECK(averageColor.r() == Approx(float(0x10 + 2 * 0x40) / 3.0f / 255.0f));
+    CHECK(averageColor.g() == Approx(float(0x20 + 2 * 0x50) / 3.0f / 255.0f));
+    CHECK(averageColor.b() == Approx(float(0x30 + 2 * 0x60) / 3.0f / 255.0f));
+  }
+
+  SECTION("Index 255 transparent")
+  {
+    // the last color of the palette is the transparent one
+    CHECK(palette.indexedToRgba(
+      reader,
+      indices.size(),
+      rgbaImage,
+      PaletteTransparency::Index255Transparent,
+      averageColor));
+    CHECK(rgbaImage.data()[3] == 0xFF);
+    CHECK(rgbaImage.data()[7] == 0x00);
+  }
+
+  SECTION("Throws if the reader is too short")
+  {
+    auto shortReader = IO::Reader::from(indices.data(), indices.data() + 2);
+    CHECK_THROWS_AS(
+      palette.indexedToRgba(
+        shortReader, indices.size(), rgbaImage, PaletteTransparency::Opaque, averageColor),
+      IO::ReaderException);
+  }
+}
+
 } // namespace TrenchBroom::Assets
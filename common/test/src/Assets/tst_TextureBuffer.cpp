@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/TextureBuffer.h"
+
+#include <utility>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+
+TEST_CASE("TextureBuffer")
+{
+  clearTextureBufferPool();
+
+  SECTION("Destroyed buffers return their memory to the pool")
+  {
+    {
+      auto buffer = TextureBuffer{64 * 64 * 4};
+      CHECK(buffer.size() == 64u * 64u * 4u);
+      CHECK(pooledTextureBufferMemory() == 0u);
+    }
+    CHECK(pooledTextureBufferMemory() == 64u * 64u * 4u);
+
+    {
+      auto buffer = TextureBuffer{64 * 64 * 4};
+      CHECK(buffer.data() != nullptr);
+      CHECK(pooledTextureBufferMemory() == 0u);
+    }
+    CHECK(pooledTextureBufferMemory() == 64u * 64u * 4u);
+  }
+
+  SECTION("Buffers of similar size share pooled memory")
+  {
+    {
+      auto buffer = TextureBuffer{1000};
+    }
+    const auto pooled = pooledTextureBufferMemory();
+    CHECK(pooled >= 1000u);
+    CHECK(pooled < 1250u);
+
+    auto buffer = TextureBuffer{990};
+    CHECK(pooledTextureBufferMemory() == 0u);
+  }
+
+  SECTION("Moved buffers are only returned once")
+  {
+    {
+      auto buffer = TextureBuffer{256};
+      auto other = std::move(buffer);
+      CHECK(other.size() == 256u);
+      CHECK(buffer.size() == 0u);
+      CHECK(buffer.data() == nullptr);
+    }
+    CHECK(pooledTextureBufferMemory() == 256u);
+  }
+
+  SECTION("Empty buffers do not use the pool")
+  {
+    {
+      auto buffer = TextureBuffer{};
+    }
+    CHECK(pooledTextureBufferMemory() == 0u);
+  }
+
+  clearTextureBufferPool();
+}
+
+} // namespace TrenchBroom::Assets
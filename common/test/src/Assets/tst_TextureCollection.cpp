@@ -0,0 +1,179 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureCollection.h"
+#include "Color.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+Texture makeTexture(
+  const size_t width,
+  const size_t height,
+  const size_t mipmapCount,
+  const GLenum format = GL_RGBA,
+  const TextureType type = TextureType::Opaque)
+{
+  auto buffers = TextureBufferList{};
+  for (size_t i = 0; i < mipmapCount; ++i)
+  {
+    const auto size = sizeAtMipLevel(width, height, i);
+    buffers.emplace_back(size.x() * size.y() * 4u);
+  }
+  return Texture{"texture", width, height, Color{}, std::move(buffers), format, type};
+}
+} // namespace
+
+TEST_CASE("findTextureArrayGroups")
+{
+  SECTION("Empty list")
+  {
+    CHECK(findTextureArrayGroups({}).empty());
+  }
+
+  SECTION("Groups textures by size")
+  {
+    auto textures = std::vector<Texture>{};
+    textures.push_back(makeTexture(64, 64, 4));
+    textures.push_back(makeTexture(32, 32, 4));
+    textures.push_back(makeTexture(64, 64, 4));
+    textures.push_back(makeTexture(32, 32, 4));
+    textures.push_back(makeTexture(16, 16, 4));
+
+    const auto groups = findTextureArrayGroups(textures);
+    CHECK_THAT(
+      groups,
+      Catch::Matchers::UnorderedEquals(
+        std::vector<std::vector<size_t>>{{0, 2}, {1, 3}}));
+  }
+
+  SECTION("Groups textures by format, type and mipmap count")
+  {
+    auto textures = std::vector<Texture>{};
+    textures.push_back(makeTexture(64, 64, 4, GL_RGBA));
+    textures.push_back(makeTexture(64, 64, 4, GL_BGRA));
+    textures.push_back(makeTexture(64, 64, 3, GL_RGBA));
+    textures.push_back(makeTexture(64, 64, 4, GL_RGBA, TextureType::Masked));
+    textures.push_back(makeTexture(64, 64, 4, GL_RGBA));
+
+    CHECK(findTextureArrayGroups(textures) == std::vector<std::vector<size_t>>{{0, 4}});
+  }
+
+  SECTION("Masked textures are grouped regardless of their mipmap count")
+  {
+    auto textures = std::vector<Texture>{};
+    textures.push_back(makeTexture(64, 64, 1, GL_RGBA, TextureType::Masked));
+    textures.push_back(makeTexture(64, 64, 4, GL_RGBA, TextureType::Masked));
+
+    CHECK(findTextureArrayGroups(textures) == std::vector<std::vector<size_t>>{{0, 1}});
+  }
+
+  SECTION("Skips textures that cannot be packed")
+  {
+    auto textures = std::vector<Texture>{};
+    // single buffer opaque textures generate their mipmaps
+    textures.push_back(makeTexture(64, 64, 1));
+    textures.push_back(makeTexture(64, 64, 1));
+    // compressed textures
+    textures.push_back(makeTexture(64, 64, 4, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT));
+    textures.push_back(makeTexture(64, 64, 4, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT));
+    // textures without image data
+    textures.emplace_back("texture", 64, 64);
+    textures.emplace_back("texture", 64, 64);
+
+    CHECK(findTextureArrayGroups(textures).empty());
+  }
+
+  SECTION("Splits groups exceeding the maximum layer count")
+  {
+    auto textures = std::vector<Texture>{};
+    for (size_t i = 0; i < MaxTextureArrayLayers + 1; ++i)
+    {
+      textures.push_back(makeTexture(8, 8, 2));
+    }
+    textures.push_back(makeTexture(16, 16, 2));
+
+    const auto groups = findTextureArrayGroups(textures);
+    REQUIRE(groups.size() == 1u);
+    CHECK(groups[0].size() == MaxTextureArrayLayers);
+    CHECK(groups[0].front() == 0u);
+  }
+}
+
+TEST_CASE("TextureCollection.hasRequestedTextures")
+{
+  auto textures = std::vector<Texture>{};
+  textures.push_back(makeTexture(64, 64, 4));
+  textures.push_back(makeTexture(64, 64, 4));
+  // textures without image data cannot be uploaded, so they are never requested
+  textures.emplace_back("texture", 64, 64);
+
+  auto collection = TextureCollection{"textures", std::move(textures)};
+  CHECK_FALSE(collection.hasRequestedTextures());
+  CHECK_FALSE(collection.prepared());
+
+  collection.textures()[2].activate();
+  CHECK_FALSE(collection.textures()[2].uploadRequested());
+  CHECK_FALSE(collection.hasRequestedTextures());
+
+  collection.textures()[1].activate();
+  CHECK(collection.textures()[1].uploadRequested());
+  CHECK_FALSE(collection.textures()[0].uploadRequested());
+  CHECK(collection.hasRequestedTextures());
+}
+
+TEST_CASE("Texture.discardMipmaps")
+{
+  SECTION("Keeps the first mip level of uncompressed textures")
+  {
+    auto texture = makeTexture(64, 64, 4);
+    CHECK(texture.discardMipmaps());
+    CHECK(texture.buffersIfUnprepared().size() == 1u);
+    CHECK(texture.buffersIfUnprepared().front().size() == 64u * 64u * 4u);
+
+    // the texture relies on the driver to generate its mipmaps now
+    auto textures = std::vector<Texture>{};
+    textures.push_back(makeTexture(64, 64, 1));
+    textures.push_back(std::move(texture));
+    CHECK(findTextureArrayGroups(textures).empty());
+  }
+
+  SECTION("Does nothing if the texture has a single mip level")
+  {
+    auto texture = makeTexture(64, 64, 1);
+    CHECK_FALSE(texture.discardMipmaps());
+    CHECK(texture.buffersIfUnprepared().size() == 1u);
+  }
+
+  SECTION("Keeps the mip levels of compressed textures")
+  {
+    auto texture = makeTexture(64, 64, 4, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK_FALSE(texture.discardMipmaps());
+    CHECK(texture.buffersIfUnprepared().size() == 4u);
+  }
+}
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,163 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureCompression.h"
+#include "Color.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+TextureBuffer makeBuffer(
+  const size_t width,
+  const size_t height,
+  const unsigned char r,
+  const unsigned char g,
+  const unsigned char b,
+  const unsigned char a)
+{
+  auto buffer = TextureBuffer{width * height * 4};
+  for (size_t i = 0; i < width * height; ++i)
+  {
+    buffer.data()[i * 4 + 0] = r;
+    buffer.data()[i * 4 + 1] = g;
+    buffer.data()[i * 4 + 2] = b;
+    buffer.data()[i * 4 + 3] = a;
+  }
+  return buffer;
+}
+
+TextureBufferList makeBuffers(TextureBuffer buffer)
+{
+  auto buffers = TextureBufferList{};
+  buffers.push_back(std::move(buffer));
+  return buffers;
+}
+} // namespace
+
+TEST_CASE("canCompressTexture")
+{
+  CHECK(canCompressTexture(GL_RGBA, 128, 128));
+  CHECK(canCompressTexture(GL_BGRA, 256, 128));
+  CHECK_FALSE(canCompressTexture(GL_RGB, 128, 128));
+  CHECK_FALSE(canCompressTexture(GL_RGBA, 64, 128));
+  CHECK_FALSE(canCompressTexture(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 128, 128));
+}
+
+TEST_CASE("compressTextureBuffers")
+{
+  SECTION("Opaque texture is compressed to DXT1 with generated mipmaps")
+  {
+    const auto compressed = compressTextureBuffers(
+      makeBuffers(makeBuffer(128, 128, 255, 0, 0, 255)), 128, 128, GL_RGBA, false);
+
+    CHECK(compressed.format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    REQUIRE(compressed.buffers.size() == 8u);
+    CHECK(compressed.buffers[0].size() == 32u * 32u * 8u);
+    CHECK(compressed.buffers[7].size() == 8u);
+
+    // a uniform red block encodes red as its first endpoint
+    const auto* block = compressed.buffers[0].data();
+    CHECK(block[0] == 0x00);
+    CHECK(block[1] == 0xF8);
+  }
+
+  SECTION("Translucent texture is compressed to DXT5")
+  {
+    const auto compressed = compressTextureBuffers(
+      makeBuffers(makeBuffer(128, 128, 0, 0, 255, 128)), 128, 128, GL_BGRA, false);
+
+    CHECK(compressed.format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    REQUIRE(!compressed.buffers.empty());
+    CHECK(compressed.buffers[0].size() == 32u * 32u * 16u);
+
+    const auto* block = compressed.buffers[0].data();
+    CHECK(block[0] == 128);
+    CHECK(block[1] == 128);
+
+    // BGRA input with blue = 255 is red
+    CHECK(block[8] == 0x00);
+    CHECK(block[9] == 0xF8);
+  }
+
+  SECTION("Masked texture only compresses its first mip level")
+  {
+    const auto compressed = compressTextureBuffers(
+      makeBuffers(makeBuffer(128, 128, 0, 0, 0, 255)), 128, 128, GL_RGBA, true);
+
+    CHECK(compressed.format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    CHECK(compressed.buffers.size() == 1u);
+    CHECK(compressed.uncompressedSize == 128u * 128u * 4u);
+  }
+
+  SECTION("Sizes that are not a multiple of the block size are rounded up")
+  {
+    const auto compressed = compressTextureBuffers(
+      makeBuffers(makeBuffer(130, 129, 0, 0, 0, 255)), 130, 129, GL_RGBA, true);
+
+    REQUIRE(compressed.buffers.size() == 1u);
+    CHECK(compressed.buffers[0].size() == 33u * 33u * 16u);
+  }
+}
+
+TEST_CASE("Texture.compress")
+{
+  SECTION("Compresses large RGBA textures")
+  {
+    auto texture = Texture{
+      "texture",
+      128,
+      128,
+      Color{},
+      makeBuffer(128, 128, 0, 255, 0, 255),
+      GL_RGBA,
+      TextureType::Opaque};
+
+    CHECK(texture.compress());
+    CHECK(texture.compressed());
+    CHECK(texture.format() == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK(texture.compressionSavings() > 0u);
+  }
+
+  SECTION("Leaves small textures alone")
+  {
+    auto texture = Texture{
+      "texture",
+      64,
+      64,
+      Color{},
+      makeBuffer(64, 64, 0, 255, 0, 255),
+      GL_RGBA,
+      TextureType::Opaque};
+
+    CHECK_FALSE(texture.compress());
+    CHECK_FALSE(texture.compressed());
+    CHECK(texture.format() == GL_RGBA);
+    CHECK(texture.compressionSavings() == 0u);
+  }
+}
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureThumbnail.h"
+#include "Color.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+TextureBuffer makeBuffer(const size_t width, const size_t height, const GLenum format)
+{
+  const auto bytesPerPixel = bytesPerPixelForFormat(format);
+  auto buffer = TextureBuffer{width * height * bytesPerPixel};
+  for (size_t i = 0; i < width * height * bytesPerPixel; ++i)
+  {
+    buffer.data()[i] = static_cast<unsigned char>(i % 256);
+  }
+  return buffer;
+}
+
+std::vector<unsigned char> bytes(const TextureBuffer& buffer)
+{
+  return std::vector<unsigned char>(buffer.data(), buffer.data() + buffer.size());
+}
+} // namespace
+
+TEST_CASE("selectThumbnailMipLevel")
+{
+  CHECK(selectThumbnailMipLevel(64, 64, 4, 128) == 0u);
+  CHECK(selectThumbnailMipLevel(128, 128, 4, 128) == 0u);
+  CHECK(selectThumbnailMipLevel(256, 256, 4, 128) == 1u);
+  CHECK(selectThumbnailMipLevel(256, 64, 4, 100) == 1u);
+  CHECK(selectThumbnailMipLevel(2048, 2048, 4, 128) == 3u);
+  CHECK(selectThumbnailMipLevel(2048, 2048, 1, 128) == 0u);
+}
+
+TEST_CASE("copyThumbnailMipLevel")
+{
+  auto buffers = TextureBufferList{};
+  setMipBufferSize(buffers, 4, 64, 32, GL_RGBA);
+  for (size_t i = 0; i < buffers.size(); ++i)
+  {
+    buffers[i].data()[0] = static_cast<unsigned char>(i);
+  }
+
+  const auto texture =
+    Texture{"texture", 64, 32, Color{}, std::move(buffers), GL_RGBA, TextureType::Opaque};
+
+  const auto thumbnail = copyThumbnailMipLevel(texture, 16);
+  CHECK(thumbnail.width == 16u);
+  CHECK(thumbnail.height == 8u);
+  CHECK(thumbnail.format == GL_RGBA);
+  CHECK(bytes(thumbnail.buffer) == bytes(texture.buffersIfUnprepared()[2]));
+}
+
+TEST_CASE("makeTextureThumbnail")
+{
+  SECTION("Small images are not changed")
+  {
+    const auto thumbnail =
+      makeTextureThumbnail(TextureThumbnail{8, 4, GL_RGB, makeBuffer(8, 4, GL_RGB)}, 8);
+    CHECK(thumbnail.width == 8u);
+    CHECK(thumbnail.height == 4u);
+    CHECK(bytes(thumbnail.buffer) == bytes(makeBuffer(8, 4, GL_RGB)));
+  }
+
+  SECTION("Large images are halved until they match the thumbnail size")
+  {
+    const auto thumbnail = makeTextureThumbnail(
+      TextureThumbnail{256, 64, GL_RGBA, makeBuffer(256, 64, GL_RGBA)}, 48);
+    CHECK(thumbnail.width == 64u);
+    CHECK(thumbnail.height == 16u);
+    CHECK(thumbnail.format == GL_RGBA);
+    CHECK(thumbnail.buffer.size() == 64u * 16u * 4u);
+  }
+
+  SECTION("Pixels are averaged")
+  {
+    auto buffer = TextureBuffer{2 * 2 * 3};
+    const auto pixels = std::vector<unsigned char>{
+      0, 10, 100, 4, 20, 100, 8, 30, 200, 12, 40, 200};
+    std::copy(pixels.begin(), pixels.end(), buffer.data());
+
+    const auto thumbnail =
+      makeTextureThumbnail(TextureThumbnail{2, 2, GL_BGR, std::move(buffer)}, 1);
+    CHECK(thumbnail.width == 1u);
+    CHECK(thumbnail.height == 1u);
+    CHECK(bytes(thumbnail.buffer) == std::vector<unsigned char>{6, 25, 150});
+  }
+
+  SECTION("Odd sizes are rounded down")
+  {
+    const auto thumbnail =
+      makeTextureThumbnail(TextureThumbnail{5, 3, GL_RGB, makeBuffer(5, 3, GL_RGB)}, 2);
+    CHECK(thumbnail.width == 2u);
+    CHECK(thumbnail.height == 1u);
+    CHECK(thumbnail.buffer.size() == 2u * 1u * 3u);
+  }
+
+  SECTION("Compressed images are not changed")
+  {
+    const auto thumbnail = makeTextureThumbnail(
+      TextureThumbnail{
+        256, 256, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, TextureBuffer{64 * 64 * 8}},
+      16);
+    CHECK(thumbnail.width == 256u);
+    CHECK(thumbnail.height == 256u);
+  }
+}
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,243 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EL/CompiledExpression.h"
+#include "EL/ELExceptions.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace EL
+{
+namespace
+{
+template <typename Evaluate>
+std::optional<Value> evaluateOrNullopt(const Evaluate& evaluate)
+{
+  try
+  {
+    return evaluate();
+  }
+  catch (const Exception&)
+  {
+    return std::nullopt;
+  }
+}
+} // namespace
+
+TEST_CASE("CompiledExpressionTest.evaluate")
+{
+  using T = std::tuple<std::string, MapType>;
+
+  const auto variables = MapType{
+    {"n", Value{3}},
+    {"m", Value{-2.5}},
+    {"b", Value{true}},
+    {"s", Value{"7"}},
+    {"t", Value{"test"}},
+    {"a", Value{ArrayType{Value{1}, Value{2}, Value{3}}}},
+    {"o", Value{MapType{{"k", Value{"v"}}}}},
+    {"z", Value::Null},
+  };
+
+  // clang-format off
+  const auto
+  [expression,                             extraVariables] = GENERATE_COPY(values<T>({
+  {"n + m * 2 - n / 4 % 2",                {}},
+  {"n + s",                                {}},
+  {"t + s",                                {}},
+  {"b + n",                                {}},
+  {"n + t",                                {}},
+  {"a + [4]",                              {}},
+  {"o + {l: 1}",                           {}},
+  {"u + 1",                                {}},
+  {"-n + +m - -b",                         {}},
+  {"-s",                                   {}},
+  {"-t",                                   {}},
+  {"!b",                                   {}},
+  {"!n",                                   {}},
+  {"~n",                                   {}},
+  {"~b",                                   {}},
+  {"(n + 1) * 2",                          {}},
+  {"n & 1 | 4 ^ 6",                        {}},
+  {"s & 3",                                {}},
+  {"n << 2 >> 1",                          {}},
+  {"n < m",                                {}},
+  {"n <= 3 && m >= -2.5",                  {}},
+  {"n == b",                               {}},
+  {"b != false",                           {}},
+  {"n == s",                               {}},
+  {"t == 'test'",                          {}},
+  {"a == [1, 2, 3]",                       {}},
+  {"n == z",                               {}},
+  {"a == n",                               {}},
+  {"b && n > 2",                           {}},
+  {"b && n",                               {}},
+  {"n && b",                               {}},
+  {"false && 1 + []",                      {}},
+  {"z && 1 + []",                          {}},
+  {"u && false",                           {}},
+  {"true || 1 + []",                       {}},
+  {"z || b",                               {}},
+  {"false || u",                           {}},
+  {"b -> n + 1",                           {}},
+  {"!b -> 1 + []",                         {}},
+  {"u -> 1",                               {}},
+  {"a -> 1",                               {}},
+  {"s -> t",                               {}},
+  {"{{ n == 2 -> 'two', n == 3 -> 'three', 'other' }}", {}},
+  {"{{ n > 5 -> 'big', u }}",              {}},
+  {"{{ spawnflags & 1 -> 'a.mdl', spawnflags & 2 -> 'b.mdl', 'c.mdl' }}",
+                                           {{"spawnflags", Value{"2"}}}},
+  {"{{ spawnflags & 1 -> 'a.mdl', spawnflags & 2 -> 'b.mdl', 'c.mdl' }}",
+                                           {{"spawnflags", Value{3}}}},
+  {"{{ spawnflags & 1 -> 'a.mdl', spawnflags & 2 -> 'b.mdl', 'c.mdl' }}",
+                                           {}},
+  {"{ path: model, skin: skin, frame: frame + 1 }",
+                                           {{"model", Value{"m.mdl"}}}},
+  {"[n, 1..n, a, u]",                      {}},
+  {"[n..1, -1]",                           {}},
+  {"a[0]",                                 {}},
+  {"a[-1]",                                {}},
+  {"a[1..]",                               {}},
+  {"a[..1]",                               {}},
+  {"a[0, 2..]",                            {}},
+  {"t[1..]",                               {}},
+  {"[a, [4, 5]][1][..0]",                  {}},
+  {"o['k']",                               {}},
+  {"o[n]",                                 {}},
+  {"__AutoRangeParameter",                 {{"__AutoRangeParameter", Value{1}}}},
+  {"n[0]",                                 {}},
+  {"z[0]",                                 {}},
+  }));
+  // clang-format on
+
+  CAPTURE(expression, extraVariables);
+
+  auto allVariables = extraVariables;
+  allVariables.insert(variables.begin(), variables.end());
+
+  const auto context = EvaluationContext{VariableTable{allVariables}};
+
+  auto expressions = std::vector<Expression>{IO::ELParser::parseStrict(expression)};
+  try
+  {
+    expressions.push_back(expressions.front().optimize());
+  }
+  catch (const Exception&)
+  {
+    // optimizing evaluates constant subexpressions, which can fail
+  }
+
+  for (const auto& treeExpression : expressions)
+  {
+    CAPTURE(treeExpression);
+
+    const auto compiledExpression = CompiledExpression{treeExpression};
+    const auto expected =
+      evaluateOrNullopt([&]() { return treeExpression.evaluate(context); });
+    const auto actual =
+      evaluateOrNullopt([&]() { return compiledExpression.evaluate(context); });
+
+    CHECK(actual == expected);
+
+    // evaluating the same compiled expression again yields the same result
+    CHECK(
+      evaluateOrNullopt([&]() { return compiledExpression.evaluate(context); })
+      == actual);
+  }
+}
+
+TEST_CASE("CompiledExpressionTest.instructions")
+{
+  using Opcode = CompiledExpression::Opcode;
+
+  const auto opcodes = [](const std::string& expression) {
+    auto result = std::vector<Opcode>{};
+    const auto compiledExpression =
+      CompiledExpression{IO::ELParser::parseStrict(expression)};
+    for (const auto& instruction : compiledExpression.instructions())
+    {
+      result.push_back(instruction.opcode);
+    }
+    return result;
+  };
+
+  CHECK(
+    opcodes("x + 1")
+    == std::vector<Opcode>{Opcode::LoadVariable, Opcode::LoadConstant, Opcode::Binary});
+  CHECK(
+    opcodes("x -> y")
+    == std::vector<Opcode>{
+      Opcode::LoadVariable, Opcode::ShortCircuitCase, Opcode::LoadVariable});
+  CHECK(
+    opcodes("x[0]")
+    == std::vector<Opcode>{
+      Opcode::LoadVariable, Opcode::Nop, Opcode::LoadConstant, Opcode::Subscript});
+  CHECK(
+    opcodes("x[1..]")
+    == std::vector<Opcode>{
+      Opcode::LoadVariable,
+      Opcode::AutoRange,
+      Opcode::LoadConstant,
+      Opcode::Move,
+      Opcode::Binary,
+      Opcode::Subscript});
+  CHECK(opcodes("(x)") == std::vector<Opcode>{Opcode::LoadVariable});
+
+  // subexpressions without variables are evaluated when compiling
+  CHECK(opcodes("1 + 2 * 3") == std::vector<Opcode>{Opcode::LoadConstant});
+  CHECK(
+    opcodes("{ path: 'a.mdl', skin: 1 + 1 }")
+    == std::vector<Opcode>{Opcode::LoadConstant});
+  CHECK(
+    opcodes("[1, x, 2 + 3]")
+    == std::vector<Opcode>{
+      Opcode::LoadConstant,
+      Opcode::LoadVariable,
+      Opcode::LoadConstant,
+      Opcode::MakeArray});
+
+  // unless evaluating them fails
+  CHECK(
+    opcodes("1 + []")
+    == std::vector<Opcode>{Opcode::LoadConstant, Opcode::MakeArray, Opcode::Binary});
+}
+
+TEST_CASE("CompiledExpressionTest.resultExpression")
+{
+  const auto expression = IO::ELParser::parseStrict("1 + 2");
+  const auto compiledExpression = CompiledExpression{expression};
+
+  const auto value = compiledExpression.evaluate(EvaluationContext{});
+  CHECK(value == Value{3});
+  CHECK(value.expression() == expression);
+}
+} // namespace EL
+} // namespace TrenchBroom
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/EntityModel.h"
+#include "Assets/Palette.h"
+#include "Error.h"
+#include "IO/Bsp29Parser.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "Logger.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/bbox_io.h>
+#include <vecmath/intersection.h>
+#include <vecmath/ray.h>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+TEST_CASE("Bsp29ParserTest.loadFrames")
+{
+  auto logger = NullLogger{};
+
+  const auto palettePath = "fixture/test/palette.lmp";
+  auto fs = DiskFileSystem{std::filesystem::current_path()};
+  auto paletteFile = fs.openFile("fixture/test/palette.lmp").value();
+  const auto palette = Assets::loadPalette(*paletteFile, palettePath).value();
+
+  const auto bspPath =
+    std::filesystem::current_path() / "fixture/test/Model/Game/Quake/id1/cube.bsp";
+  const auto bspFile = Disk::openFile(bspPath).value();
+
+  auto reader = bspFile->reader().buffer();
+  auto parser = Bsp29Parser{"cube", reader, palette, fs};
+  auto model = parser.initializeModel(logger);
+
+  CHECK(model != nullptr);
+  CHECK(model->surfaceCount() == 1u);
+  CHECK(model->frameCount() >= 1u);
+  CHECK_FALSE(model->frames().front()->loaded());
+
+  const auto frameIndices = std::vector<size_t>{0};
+  parser.loadFrames(frameIndices, *model, logger);
+
+  const auto* frame = model->frames().front();
+  CHECK(frame->loaded());
+
+  const auto box = vm::bbox3f{vm::vec3f::fill(-32), vm::vec3f::fill(32)};
+  CHECK(frame->bounds() == box);
+
+  const auto ray = vm::ray3f{vm::vec3f{0, 0, 64}, vm::vec3f::neg_z()};
+  CHECK(frame->intersect(ray) == Approx(32.0f));
+}
+} // namespace IO
+} // namespace TrenchBroom
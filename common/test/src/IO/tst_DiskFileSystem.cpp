@@ -220,6 +220,97 @@ TEST_CASE("DiskFileSystemTest")
   }
 }
 
+TEST_CASE("CachedDiskFileSystemTest")
+{
+  auto env = makeTestEnvironment();
+
+  auto fs = CachedDiskFileSystem{env.dir()};
+
+  SECTION("pathInfo")
+  {
+#if defined _WIN32
+    CHECK(fs.pathInfo("c:\\") == PathInfo::Directory);
+#else
+    CHECK(fs.pathInfo("/") == PathInfo::Directory);
+#endif
+    CHECK(fs.pathInfo("..") == PathInfo::Unknown);
+
+    CHECK(fs.pathInfo(".") == PathInfo::Directory);
+    CHECK(fs.pathInfo("anotherDir") == PathInfo::Directory);
+    CHECK(fs.pathInfo("anotherDir/./subDirTest/..") == PathInfo::Directory);
+    CHECK(fs.pathInfo("ANOTHerDir") == PathInfo::Directory);
+    CHECK(fs.pathInfo("fasdf") == PathInfo::Unknown);
+
+    CHECK(fs.pathInfo("./test.txt") == PathInfo::File);
+    CHECK(
+      fs.pathInfo("anotherDir/./subDirTest/../subDirTest/test2.map") == PathInfo::File);
+    CHECK(fs.pathInfo("ANOtherDir/test3.MAP") == PathInfo::File);
+    CHECK(fs.pathInfo("test.txt/test3.map") == PathInfo::Unknown);
+    CHECK(fs.pathInfo("anotherDir/whatever.txt") == PathInfo::Unknown);
+  }
+
+  SECTION("find")
+  {
+    CHECK(
+      fs.find("asdf/bleh", TraversalMode::Flat)
+      == Result<std::vector<std::filesystem::path>>{
+        Error{"Path does not denote a directory: 'asdf/bleh'"}});
+
+    CHECK_THAT(
+      fs.find(".", TraversalMode::Flat),
+      MatchesPathsResult({
+        "anotherDir",
+        "dir1",
+        "dir2",
+        "test.txt",
+        "test2.map",
+      }));
+
+    CHECK_THAT(
+      fs.find("ANOTHERDIR", TraversalMode::Flat),
+      MatchesPathsResult({
+        "anotherDir/subDirTest",
+        "anotherDir/test3.map",
+      }));
+
+    CHECK_THAT(
+      fs.find(".", TraversalMode::Recursive),
+      MatchesPathsResult({
+        "anotherDir",
+        "anotherDir/subDirTest",
+        "anotherDir/subDirTest/test2.map",
+        "anotherDir/test3.map",
+        "dir1",
+        "dir2",
+        "test.txt",
+        "test2.map",
+      }));
+  }
+
+  SECTION("openFile")
+  {
+    CHECK(
+      fs.openFile("anotherDir")
+      == Result<std::shared_ptr<File>>{Error{"'anotherDir' not found"}});
+
+    const auto file = fs.openFile("ANOTHERDIR/TEST3.MAP").value();
+    CHECK(file->reader().readString(file->size()) == "//yet another test file\n{}");
+  }
+
+  SECTION("refresh")
+  {
+    CHECK(fs.pathInfo("dir1/new.txt") == PathInfo::Unknown);
+
+    env.createFile("dir1/new.txt", "new");
+    CHECK(fs.pathInfo("dir1/new.txt") == PathInfo::Unknown);
+
+    fs.refresh();
+    CHECK(fs.pathInfo("dir1/new.txt") == PathInfo::File);
+    CHECK_THAT(
+      fs.find("dir1", TraversalMode::Flat), MatchesPathsResult({"dir1/new.txt"}));
+  }
+}
+
 TEST_CASE("WritableDiskFileSystemTest")
 {
   SECTION("createWritableDiskFileSystem")
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <string>
 
 #include "Catch2.h"
 
@@ -224,6 +225,43 @@ TEST_CASE("DiskIO")
     CHECK(file.is_success());
   }
 
+  SECTION("mapFile")
+  {
+    CHECK(
+      Disk::mapFile(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<MappedFile>>{Error{
+        "Failed to open '" + (env.dir() / "does_not_exist.txt").string()
+        + "': path does not denote a file"}});
+
+    const auto file = Disk::mapFile(env.dir() / "test.txt").value();
+    CHECK(file->size() == 12u);
+    CHECK(std::string{file->begin(), file->end()} == "some content");
+
+    auto reader = file->reader().buffer();
+    CHECK(reader.stringView() == "some content");
+    CHECK(reader.stringView().data() == file->begin());
+  }
+
+  SECTION("openFileForReading")
+  {
+    CHECK(
+      Disk::openFileForReading(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<File>>{Error{
+        "Failed to open '" + (env.dir() / "does_not_exist.txt").string()
+        + "': path does not denote a file"}});
+
+    const auto smallFile = Disk::openFileForReading(env.dir() / "test.txt").value();
+    CHECK(dynamic_cast<CFile*>(smallFile.get()) != nullptr);
+    CHECK(smallFile->reader().buffer().stringView() == "some content");
+
+    const auto largeContent = std::string(Disk::MinMappedFileSize, 'x');
+    env.createFile("large.txt", largeContent);
+
+    const auto largeFile = Disk::openFileForReading(env.dir() / "large.txt").value();
+    CHECK(dynamic_cast<MappedFile*>(largeFile.get()) != nullptr);
+    CHECK(largeFile->reader().buffer().stringView() == largeContent);
+  }
+
   SECTION("withStream")
   {
     SECTION("withInputStream")
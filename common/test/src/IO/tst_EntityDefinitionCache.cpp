@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/EntityDefinitionCache.h"
+#include "IO/FgdParser.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+
+#include <kdl/vector_utils.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+const auto MainFgd = std::string{R"(
+@include "base.fgd"
+@include "missing.fgd"
+@PointClass base(Base) = info_player_start : "Player start" []
+)"};
+
+const auto BaseFgd = std::string{R"(
+@BaseClass size(-16 -16 -24, 16 16 32) color(0 255 0) = Base []
+)"};
+
+std::vector<std::string> classNames(const std::vector<EntityDefinitionClassInfo>& infos)
+{
+  return kdl::vec_transform(infos, [](const auto& info) { return info.name; });
+}
+} // namespace
+
+TEST_CASE("EntityDefinitionCacheTest.getAndPut")
+{
+  auto env = TestEnvironment{};
+  env.createFile("base.fgd", BaseFgd);
+  env.createFile("main.fgd", MainFgd);
+
+  const auto path = env.dir() / "main.fgd";
+  auto parser = FgdParser{MainFgd, Color{1.0f, 1.0f, 1.0f, 1.0f}, path};
+  auto status = TestParserStatus{};
+  auto classInfos = parser.parseResolvedClassInfos(status);
+  REQUIRE(classNames(classInfos) == std::vector<std::string>{"info_player_start"});
+
+  const auto includedPaths = parser.includedPaths();
+  CHECK(
+    includedPaths
+    == std::vector<std::filesystem::path>{
+      env.dir() / "base.fgd", env.dir() / "missing.fgd"});
+
+  auto cache = EntityDefinitionCache{};
+  CHECK_FALSE(cache.get(path, MainFgd));
+
+  cache.put(path, MainFgd, includedPaths, classInfos);
+
+  SECTION("Getting unchanged files")
+  {
+    const auto cachedClassInfos = cache.get(path, MainFgd);
+    REQUIRE(cachedClassInfos);
+    CHECK(*cachedClassInfos == classInfos);
+  }
+
+  SECTION("Getting a changed file")
+  {
+    CHECK_FALSE(cache.get(path, MainFgd + "\n"));
+  }
+
+  SECTION("Getting a file whose included file has changed")
+  {
+    env.createFile("base.fgd", BaseFgd + "\n");
+    CHECK_FALSE(cache.get(path, MainFgd));
+  }
+
+  SECTION("Getting a file whose missing included file was created")
+  {
+    env.createFile("missing.fgd", "");
+    CHECK_FALSE(cache.get(path, MainFgd));
+  }
+
+  SECTION("Getting a file after clearing the cache")
+  {
+    cache.clear();
+    CHECK_FALSE(cache.get(path, MainFgd));
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
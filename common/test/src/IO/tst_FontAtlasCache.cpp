@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/FontAtlasCache.h"
+#include "IO/TestEnvironment.h"
+
+#include <kdl/result.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+TEST_CASE("FontAtlasCache.readAndWrite")
+{
+  auto env = TestEnvironment{};
+  const auto cache = FontAtlasCache{env.dir() / "cache"};
+
+  const auto key = std::string{"1234:5678:Font-16-32-126"};
+  const auto atlas = FontAtlas{
+    2,
+    12,
+    {{3, 3, 8, 8, 7}, {14, 3, 8, 8, 6}},
+    {1, 2, 3, 4},
+  };
+  REQUIRE(cache.writeAtlas("Font-16-32-126", key, atlas).is_success());
+
+  SECTION("Reading an up to date atlas")
+  {
+    const auto cachedAtlas = cache.readAtlas("Font-16-32-126", key);
+    REQUIRE(cachedAtlas);
+    CHECK(cachedAtlas->textureSize == atlas.textureSize);
+    CHECK(cachedAtlas->lineHeight == atlas.lineHeight);
+    REQUIRE(cachedAtlas->glyphs.size() == atlas.glyphs.size());
+    for (size_t i = 0; i < atlas.glyphs.size(); ++i)
+    {
+      CHECK(cachedAtlas->glyphs[i].x == atlas.glyphs[i].x);
+      CHECK(cachedAtlas->glyphs[i].y == atlas.glyphs[i].y);
+      CHECK(cachedAtlas->glyphs[i].width == atlas.glyphs[i].width);
+      CHECK(cachedAtlas->glyphs[i].height == atlas.glyphs[i].height);
+      CHECK(cachedAtlas->glyphs[i].advance == atlas.glyphs[i].advance);
+    }
+    CHECK(cachedAtlas->texture == atlas.texture);
+  }
+
+  SECTION("Reading an atlas for a different key")
+  {
+    CHECK_FALSE(cache.readAtlas("Font-16-32-126", key + "x"));
+  }
+
+  SECTION("Reading a damaged atlas")
+  {
+    env.createFile(cache.cachePath("Font-16-32-126"), "TBFA garbage");
+    CHECK_FALSE(cache.readAtlas("Font-16-32-126", key));
+  }
+
+  SECTION("Reading a missing atlas")
+  {
+    CHECK_FALSE(cache.readAtlas("Missing", key));
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -962,5 +962,29 @@ TEST_CASE("Flat ImageFileSystems")
     CHECK(contents == cr8_czg_03_contents);
   }
 }
+
+TEST_CASE("ZipFileSystem caches extracted files")
+{
+  const auto fsTestPath = std::filesystem::current_path() / "fixture/test/IO/";
+  clearZipFileCache();
+
+  {
+    auto fs = openFS<ZipFileSystem>(fsTestPath / "Zip/zip.zip");
+
+    const auto file1 = fs->openFile("pics/tag1.pcx").value();
+    CHECK(zipFileCacheSize() == file1->size());
+    CHECK(fs->openFile("PICS/TAG1.pcx").value() == file1);
+
+    const auto file2 = fs->openFile("pics/tag2.pcx").value();
+    CHECK(file2 != file1);
+    CHECK(zipFileCacheSize() == file1->size() + file2->size());
+
+    auto otherFs = openFS<ZipFileSystem>(fsTestPath / "Zip/zip.zip");
+    CHECK(otherFs->openFile("pics/tag1.pcx").value() != file1);
+  }
+
+  // destroying a file system evicts its cached files
+  CHECK(zipFileCacheSize() == 0u);
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -0,0 +1,233 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/MapCache.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+const auto MapData = R"(
+{
+"classname" "worldspawn"
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) __TB_empty 0 0 0 1 1
+}
+{
+( 0 0 0 ) ( 0 1 0 ) ( 0 0 1 ) __TB_empty 0 0 0 1 1
+( 0 0 0 ) ( 0 0 1 ) ( 1 0 0 ) __TB_empty 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) __TB_empty 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) __TB_empty 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) __TB_empty 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) __TB_empty 0 0 0 1 1
+}
+}
+)";
+
+std::unique_ptr<Model::WorldNode> readWorld(
+  const std::string& data, const vm::bbox3& worldBounds, const MapCache* mapCache)
+{
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+  return reader.read(worldBounds, status, mapCache);
+}
+
+std::vector<const Model::Brush*> brushes(const Model::WorldNode& world)
+{
+  auto result = std::vector<const Model::Brush*>{};
+  for (const auto* child : world.defaultLayer()->children())
+  {
+    if (const auto* brushNode = dynamic_cast<const Model::BrushNode*>(child))
+    {
+      result.push_back(&brushNode->brush());
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("MapCache.create")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto world = readWorld(MapData, worldBounds, nullptr);
+
+  const auto mapCache = MapCache::create(*world);
+  CHECK(mapCache.mapFormat() == Model::MapFormat::Standard);
+
+  const auto& brushGeometries = mapCache.brushGeometries();
+  REQUIRE(brushGeometries.size() == 2u);
+  CHECK(brushGeometries[0].lineNumber == 4u);
+  CHECK(brushGeometries[0].vertices.size() == 8u);
+  CHECK(brushGeometries[0].faces.size() == 6u);
+  CHECK(brushGeometries[1].lineNumber == 12u);
+  CHECK(brushGeometries[1].vertices.size() == 8u);
+  CHECK(brushGeometries[1].faces.size() == 6u);
+}
+
+TEST_CASE("MapCache.createBrush")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto world = readWorld(MapData, worldBounds, nullptr);
+  const auto expectedBrushes = brushes(*world);
+  REQUIRE(expectedBrushes.size() == 2u);
+
+  const auto mapCache = MapCache::create(*world);
+  auto faces = expectedBrushes[0]->faces();
+
+  SECTION("Using a matching cache entry")
+  {
+    const auto brush = mapCache.createBrush(4, faces);
+    REQUIRE(brush.has_value());
+    CHECK(*brush == *expectedBrushes[0]);
+    CHECK(brush->bounds() == expectedBrushes[0]->bounds());
+  }
+
+  SECTION("Using a mismatching cache entry")
+  {
+    CHECK(mapCache.createBrush(12, faces) == std::nullopt);
+    CHECK(faces == expectedBrushes[0]->faces());
+  }
+
+  SECTION("Using a missing cache entry")
+  {
+    CHECK(mapCache.createBrush(5, faces) == std::nullopt);
+    CHECK(faces == expectedBrushes[0]->faces());
+  }
+}
+
+TEST_CASE("MapCache.readAndWrite")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto world = readWorld(MapData, worldBounds, nullptr);
+  const auto mapCache = MapCache::create(*world);
+
+  auto env = TestEnvironment{};
+  const auto path = env.dir() / "test.map.tbcache";
+  REQUIRE(writeMapCache(path, mapCache, MapData, worldBounds).is_success());
+
+  SECTION("Reading an up to date cache")
+  {
+    const auto readCache = readMapCache(path, MapData, worldBounds);
+    REQUIRE(readCache.is_success());
+    CHECK(readCache.value().mapFormat() == mapCache.mapFormat());
+
+    const auto& expected = mapCache.brushGeometries();
+    const auto& actual = readCache.value().brushGeometries();
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i)
+    {
+      CHECK(actual[i].lineNumber == expected[i].lineNumber);
+      CHECK(actual[i].vertices == expected[i].vertices);
+      REQUIRE(actual[i].faces.size() == expected[i].faces.size());
+      for (size_t j = 0; j < actual[i].faces.size(); ++j)
+      {
+        CHECK(actual[i].faces[j].points == expected[i].faces[j].points);
+        CHECK(actual[i].faces[j].plane == expected[i].faces[j].plane);
+        CHECK(actual[i].faces[j].vertexIndices == expected[i].faces[j].vertexIndices);
+      }
+    }
+  }
+
+  SECTION("Reading a cache for different map file contents")
+  {
+    CHECK(readMapCache(path, std::string{MapData} + "\n", worldBounds).is_error());
+  }
+
+  SECTION("Reading a cache for different world bounds")
+  {
+    CHECK(readMapCache(path, MapData, vm::bbox3{4096.0}).is_error());
+  }
+
+  SECTION("Reading a damaged cache")
+  {
+    env.createFile("test.map.tbcache", "TBMC garbage");
+    CHECK(readMapCache(path, MapData, worldBounds).is_error());
+  }
+
+  SECTION("Reading a missing cache")
+  {
+    CHECK(readMapCache(env.dir() / "missing.tbcache", MapData, worldBounds).is_error());
+  }
+}
+
+TEST_CASE("MapCache.readWorldWithCache")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto expectedWorld = readWorld(MapData, worldBounds, nullptr);
+  const auto expectedBrushes = brushes(*expectedWorld);
+  REQUIRE(expectedBrushes.size() == 2u);
+
+  SECTION("Brushes are created from an up to date cache")
+  {
+    const auto mapCache = MapCache::create(*expectedWorld);
+    const auto world = readWorld(MapData, worldBounds, &mapCache);
+    const auto actualBrushes = brushes(*world);
+    REQUIRE(actualBrushes.size() == 2u);
+    for (size_t i = 0; i < actualBrushes.size(); ++i)
+    {
+      CHECK(*actualBrushes[i] == *expectedBrushes[i]);
+      CHECK(actualBrushes[i]->bounds() == expectedBrushes[i]->bounds());
+      CHECK_THAT(
+        actualBrushes[i]->vertexPositions(),
+        Catch::UnorderedEquals(expectedBrushes[i]->vertexPositions()));
+    }
+  }
+
+  SECTION("Mismatching cache entries are ignored")
+  {
+    // swap the geometries of both brushes
+    auto brushGeometries = MapCache::create(*expectedWorld).brushGeometries();
+    std::swap(brushGeometries[0].lineNumber, brushGeometries[1].lineNumber);
+    const auto mapCache = MapCache{Model::MapFormat::Standard, std::move(brushGeometries)};
+
+    const auto world = readWorld(MapData, worldBounds, &mapCache);
+    const auto actualBrushes = brushes(*world);
+    REQUIRE(actualBrushes.size() == 2u);
+    for (size_t i = 0; i < actualBrushes.size(); ++i)
+    {
+      CHECK(actualBrushes[i]->bounds() == expectedBrushes[i]->bounds());
+    }
+  }
+}
+
+} // namespace IO
+} // namespace TrenchBroom
@@ -31,9 +31,11 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -95,5 +97,57 @@ TEST_CASE("Md3ParserTest.loadValidMd3")
   const auto* skin2 = surface2->skin("models/weapons2/bfg/LDAbfg_z");
   CHECK(skin2 != nullptr);
 }
+
+TEST_CASE("Md3ParserTest.loadFrames")
+{
+  auto logger = NullLogger{};
+  const auto shaderSearchPath = "scripts";
+  const auto textureSearchPaths = std::vector<std::filesystem::path>{"models"};
+  auto fs = VirtualFileSystem{};
+  fs.mount(
+    "",
+    std::make_unique<DiskFileSystem>(
+      std::filesystem::current_path() / "fixture/test/IO/Md3/armor"));
+  fs.mount(
+    "",
+    createImageFileSystem<Quake3ShaderFileSystem>(
+      fs, shaderSearchPath, textureSearchPaths, logger)
+      .value());
+
+  const auto md3Path = "models/armor_red.md3";
+  const auto md3File = fs.openFile(md3Path).value();
+
+  auto reader = md3File->reader().buffer();
+  auto parser = Md3Parser{"armor_red", reader, fs};
+
+  auto expectedModel = parser.initializeModel(logger);
+  for (size_t i = 0; i < expectedModel->frameCount(); ++i)
+  {
+    parser.loadFrame(i, *expectedModel, logger);
+  }
+
+  auto model = parser.initializeModel(logger);
+  const auto frameIndices = std::vector<size_t>{0, 3, 7, 11, 19, 29};
+  parser.loadFrames(frameIndices, *model, logger);
+
+  CHECK(model->frameCount() == 30u);
+  for (size_t i = 0; i < model->frameCount(); ++i)
+  {
+    const auto* frame = model->frame(i);
+    const auto* expectedFrame = expectedModel->frame(i);
+    REQUIRE(frame != nullptr);
+
+    if (std::find(frameIndices.begin(), frameIndices.end(), i) != frameIndices.end())
+    {
+      CHECK(frame->loaded());
+      CHECK(frame->name() == expectedFrame->name());
+      CHECK(frame->bounds() == expectedFrame->bounds());
+    }
+    else
+    {
+      CHECK_FALSE(frame->loaded());
+    }
+  }
+}
 } // namespace IO
 } // namespace TrenchBroom
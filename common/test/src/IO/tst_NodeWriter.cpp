@@ -308,6 +308,94 @@ TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInDefaultLayer")
   CHECK(actual == expected);
 }
 
+TEST_CASE("NodeWriterTest.reuseSerializedBrushes")
+{
+  const vm::bbox3 worldBounds(8192.0);
+
+  Model::WorldNode map({}, {}, Model::MapFormat::Standard);
+
+  Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+  Model::BrushNode* brushNode =
+    new Model::BrushNode(builder.createCube(64.0, "none").value());
+  map.defaultLayer()->addChild(brushNode);
+
+  const auto writeMap = [&]() {
+    std::stringstream str;
+    NodeWriter writer(map, str);
+    writer.writeMap();
+    return str.str();
+  };
+
+  const std::string expected =
+    R"(// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( -16 -16 -16 ) ( -16 -15 -16 ) ( -16 -16 -15 ) none 0 0 0 1 1
+( -16 -16 -16 ) ( -16 -16 -15 ) ( -15 -16 -16 ) none 0 0 0 1 1
+( -16 -16 -16 ) ( -15 -16 -16 ) ( -16 -15 -16 ) none 0 0 0 1 1
+( 16 16 16 ) ( 16 17 16 ) ( 17 16 16 ) none 0 0 0 1 1
+( 16 16 16 ) ( 17 16 16 ) ( 16 16 17 ) none 0 0 0 1 1
+( 16 16 16 ) ( 16 16 17 ) ( 16 17 16 ) none 0 0 0 1 1
+}
+}
+)";
+
+  const auto original = writeMap();
+  CHECK(brushNode->serializedText(Model::MapFormat::Standard) != nullptr);
+  CHECK(brushNode->serializedText(Model::MapFormat::Valve) == nullptr);
+  CHECK(writeMap() == original);
+
+  brushNode->setBrush(builder.createCube(32.0, "none").value());
+  CHECK(brushNode->serializedText(Model::MapFormat::Standard) == nullptr);
+  CHECK(writeMap() == expected);
+  CHECK(writeMap() == expected);
+}
+
+TEST_CASE("NodeWriterTest.writeManyBrushes")
+{
+  const vm::bbox3 worldBounds(8192.0);
+
+  Model::WorldNode map({}, {}, Model::MapFormat::Standard);
+
+  // enough brushes to be serialized in several chunks
+  Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+  auto brushNodes = std::vector<Model::BrushNode*>{};
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    auto* brushNode = new Model::BrushNode(
+      builder.createCuboid(vm::vec3{16.0, 16.0, double(i % 64 + 1)}, "none").value());
+    map.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto writeMap = [&]() {
+    std::stringstream str;
+    NodeWriter writer(map, str);
+    writer.writeMap();
+    return str.str();
+  };
+
+  const auto original = writeMap();
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    CAPTURE(i);
+    CHECK(brushNodes[i]->serializedText(Model::MapFormat::Standard) != nullptr);
+    CHECK(brushNodes[i]->lineNumber() == 5 + 9 * i);
+    CHECK(brushNodes[i]->containsLine(5 + 9 * i + 7));
+    CHECK_FALSE(brushNodes[i]->containsLine(5 + 9 * i + 8));
+  }
+
+  CHECK(writeMap() == original);
+
+  for (size_t i = 0; i < brushNodes.size(); i += 3)
+  {
+    brushNodes[i]->invalidateSerializedText();
+  }
+  CHECK(writeMap() == original);
+}
+
 TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInCustomLayer")
 {
   const vm::bbox3 worldBounds(8192.0);
@@ -40,6 +40,8 @@
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -114,6 +116,70 @@ f  8/4/6  5/3/6  6/2/6  7/1/6
 )");
 }
 
+TEST_CASE("ObjSerializer.writeManyBrushes")
+{
+  // enough brushes for the output to be formatted in several chunks
+  constexpr auto BrushCount = size_t(1500);
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    const auto min = vm::vec3{double(i % 64) * 64.0, double(i / 64) * 64.0, 0.0};
+    map.defaultLayer()->addChild(new Model::BrushNode{
+      builder.createCuboid(vm::bbox3{min, min + vm::vec3::fill(32.0)}, "some_texture")
+        .value()});
+  }
+
+  auto objStream = std::ostringstream{};
+  auto mtlStream = std::ostringstream{};
+  const auto mtlFilename = "some_file_name.mtl";
+  const auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+
+  auto writer = NodeWriter{
+    map, std::make_unique<ObjSerializer>(objStream, mtlStream, mtlFilename, objOptions)};
+  writer.writeMap();
+
+  auto vertexLines = std::vector<std::string>{};
+  auto objectLines = std::vector<std::string>{};
+  auto faceLineCount = size_t(0);
+
+  auto lines = std::istringstream{objStream.str()};
+  for (auto line = std::string{}; std::getline(lines, line);)
+  {
+    if (line.rfind("v ", 0) == 0)
+    {
+      vertexLines.push_back(line);
+    }
+    else if (line.rfind("o ", 0) == 0)
+    {
+      objectLines.push_back(line);
+    }
+    else if (line.rfind("f ", 0) == 0)
+    {
+      ++faceLineCount;
+    }
+  }
+
+  REQUIRE(vertexLines.size() == BrushCount * 8u);
+  CHECK_THAT(
+    std::vector<std::string>(vertexLines.end() - 8, vertexLines.end()),
+    Catch::Matchers::VectorContains(std::string{"v 1728 0 -1472"})
+      && Catch::Matchers::VectorContains(std::string{"v 1760 32 -1504"}));
+
+  REQUIRE(objectLines.size() == BrushCount);
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    CHECK(objectLines[i] == fmt::format("o entity0_brush{}", i));
+  }
+
+  CHECK(faceLineCount == BrushCount * 6u);
+}
+
 TEST_CASE("ObjSerializer.writePatch")
 {
   const auto worldBounds = vm::bbox3{8192.0};
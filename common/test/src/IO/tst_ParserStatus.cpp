@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "IO/BufferedParserStatus.h"
+#include "IO/SimpleParserStatus.h"
+#include "Logger.h"
+
+#include <QString>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+class RecordingLogger : public Logger
+{
+public:
+  std::vector<std::string> messages;
+
+private:
+  void doLog(const LogLevel, const std::string& message) override
+  {
+    messages.push_back(message);
+  }
+
+  void doLog(const LogLevel, const QString& message) override
+  {
+    messages.push_back(message.toStdString());
+  }
+};
+
+class ProgressCountingParserStatus : public ParserStatus
+{
+public:
+  std::vector<double> reportedProgress;
+
+  explicit ProgressCountingParserStatus(Logger& logger)
+    : ParserStatus{logger, ""}
+  {
+  }
+
+private:
+  void doProgress(const double progress) override
+  {
+    reportedProgress.push_back(progress);
+  }
+};
+} // namespace
+
+TEST_CASE("ParserStatus.progress")
+{
+  auto logger = NullLogger{};
+  auto status = ProgressCountingParserStatus{logger};
+
+  status.progress(0.1);
+  status.progress(0.2);
+  status.progress(0.3);
+  CHECK(status.reportedProgress == std::vector<double>{0.1});
+
+  std::this_thread::sleep_for(ParserStatus::ProgressInterval);
+  status.progress(0.4);
+  status.progress(1.0);
+  CHECK(status.reportedProgress == std::vector<double>{0.1, 0.4, 1.0});
+}
+
+TEST_CASE("SimpleParserStatus.repeatedMessages")
+{
+  auto logger = RecordingLogger{};
+
+  {
+    auto status = SimpleParserStatus{logger, "prefix"};
+    for (size_t i = 0; i < SimpleParserStatus::MaxRepeatedMessages + 5; ++i)
+    {
+      status.warn(i, "some warning");
+      status.error(i, "some error");
+    }
+    status.warn(3, 7, "other warning");
+
+    CHECK(logger.messages.size() == 2 * SimpleParserStatus::MaxRepeatedMessages + 6);
+    CHECK(logger.messages.back() == "prefix: other warning (line 3, column 7)");
+  }
+
+  CHECK(logger.messages.size() == 2 * SimpleParserStatus::MaxRepeatedMessages + 7);
+  CHECK(logger.messages.back() == "prefix: some warning (5 more like this)");
+}
+
+TEST_CASE("BufferedParserStatus.repeatedMessages")
+{
+  auto logger = RecordingLogger{};
+  auto target = SimpleParserStatus{logger};
+
+  auto status = BufferedParserStatus{target};
+  for (size_t i = 0; i < SimpleParserStatus::MaxRepeatedMessages + 2; ++i)
+  {
+    status.info(i, "some message");
+  }
+  CHECK(logger.messages.empty());
+
+  status.flush();
+  CHECK(logger.messages.size() == SimpleParserStatus::MaxRepeatedMessages + 1);
+  CHECK(logger.messages.back() == "some message (2 more like this)");
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "IO/ShaderProgramCache.h"
+#include "IO/TestEnvironment.h"
+
+#include <kdl/result.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+TEST_CASE("ShaderProgramCache.readAndWrite")
+{
+  auto env = TestEnvironment{};
+  const auto cache = ShaderProgramCache{env.dir() / "cache"};
+
+  const auto key = std::string{"driver\nvertex shader\nfragment shader"};
+  const auto binary = ProgramBinary{0x1234, {1, 2, 3, 4, 5}};
+  REQUIRE(cache.writeProgram("Program", key, binary).is_success());
+
+  SECTION("Reading an up to date program")
+  {
+    const auto cachedBinary = cache.readProgram("Program", key);
+    REQUIRE(cachedBinary);
+    CHECK(cachedBinary->format == binary.format);
+    CHECK(cachedBinary->data == binary.data);
+  }
+
+  SECTION("Reading a program for a different key")
+  {
+    CHECK_FALSE(cache.readProgram("Program", key + "x"));
+  }
+
+  SECTION("Reading a damaged program")
+  {
+    env.createFile(cache.cachePath("Program"), "TBSP garbage");
+    CHECK_FALSE(cache.readProgram("Program", key));
+  }
+
+  SECTION("Reading a missing program")
+  {
+    CHECK_FALSE(cache.readProgram("Missing", key));
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureCache.h"
+
+#include <kdl/result.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+Assets::Texture makeTexture()
+{
+  auto buffers = Assets::TextureBufferList{};
+  auto& mip0 = buffers.emplace_back(2 * 2 * 4);
+  auto& mip1 = buffers.emplace_back(1 * 1 * 4);
+  for (size_t i = 0; i < mip0.size(); ++i)
+  {
+    mip0.data()[i] = static_cast<unsigned char>(i);
+  }
+  for (size_t i = 0; i < mip1.size(); ++i)
+  {
+    mip1.data()[i] = static_cast<unsigned char>(255 - i);
+  }
+
+  return Assets::Texture{
+    "texture",
+    2,
+    2,
+    Color{0.25f, 0.5f, 0.75f, 1.0f},
+    std::move(buffers),
+    GL_RGBA,
+    Assets::TextureType::Masked};
+}
+} // namespace
+
+TEST_CASE("TextureCache.readAndWrite")
+{
+  auto env = TestEnvironment{};
+  const auto cache = TextureCache{env.dir() / "cache"};
+
+  const auto sourcePath = std::filesystem::path{"textures/base/texture.png"};
+  const auto sourceContents = std::string{"encoded texture data"};
+
+  const auto texture = makeTexture();
+  REQUIRE(cache.writeTexture(texture, sourcePath, sourceContents).is_success());
+
+  SECTION("Reading an up to date texture")
+  {
+    const auto cachedTexture = cache.readTexture("name", sourcePath, sourceContents);
+    REQUIRE(cachedTexture);
+    CHECK(cachedTexture->name() == "name");
+    CHECK(cachedTexture->width() == texture.width());
+    CHECK(cachedTexture->height() == texture.height());
+    CHECK(cachedTexture->averageColor() == texture.averageColor());
+    CHECK(cachedTexture->format() == texture.format());
+    CHECK(cachedTexture->type() == texture.type());
+
+    const auto& expected = texture.buffersIfUnprepared();
+    const auto& actual = cachedTexture->buffersIfUnprepared();
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i)
+    {
+      CHECK(
+        std::vector<unsigned char>(actual[i].data(), actual[i].data() + actual[i].size())
+        == std::vector<unsigned char>(
+          expected[i].data(), expected[i].data() + expected[i].size()));
+    }
+  }
+
+  SECTION("Reading a texture for different source contents")
+  {
+    CHECK_FALSE(cache.readTexture("name", sourcePath, sourceContents + "x"));
+  }
+
+  SECTION("Reading a damaged texture")
+  {
+    env.createFile(cache.cachePath(sourcePath), "TBTC garbage");
+    CHECK_FALSE(cache.readTexture("name", sourcePath, sourceContents));
+  }
+
+  SECTION("Reading a missing texture")
+  {
+    CHECK_FALSE(cache.readTexture("name", "textures/base/missing.png", sourceContents));
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
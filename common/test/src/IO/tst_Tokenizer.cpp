@@ -273,5 +273,166 @@ TEST_CASE("TokenizerTest.simpleLanguageBlockWithNegativeDecimalAttribute")
   CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
   CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
 }
+
+TEST_CASE("TokenizerTest.simpleLanguagePeekTokenWithSkipTokens")
+{
+  const std::string testString(
+    "{\n"
+    "  attribute = 1;\n"
+    "}");
+
+  SimpleTokenizer tokenizer(testString);
+  SimpleTokenizer::Token token;
+  CHECK((token = tokenizer.peekToken(SimpleToken::OBrace)).type() == SimpleToken::String);
+  CHECK((token = tokenizer.peekToken()).type() == SimpleToken::OBrace);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::OBrace);
+
+  CHECK((token = tokenizer.peekToken()).type() == SimpleToken::String);
+  CHECK((token = tokenizer.nextToken(SimpleToken::String)).type() == SimpleToken::Equals);
+  CHECK(token.line() == 2u);
+  CHECK(token.column() == 13u);
+
+  CHECK((token = tokenizer.peekToken()).type() == SimpleToken::Integer);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Integer);
+  CHECK(token.data() == "1");
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Semicolon);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
+  CHECK(tokenizer.peekToken().type() == SimpleToken::Eof);
+  CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
+}
+
+TEST_CASE("TokenizerTest.simpleLanguageNumberConversion")
+{
+  const std::string testString("+12 -7 +1.5e2 -.25 1e400 abc");
+
+  SimpleTokenizer tokenizer(testString);
+  SimpleTokenizer::Token token;
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Integer);
+  CHECK(token.toInteger<int>() == 12);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Integer);
+  CHECK(token.toInteger<int>() == -7);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Decimal);
+  CHECK(token.toFloat<double>() == vm::approx(150.0));
+  CHECK(token.toInteger<int>() == 1);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Decimal);
+  CHECK(token.toFloat<double>() == vm::approx(-0.25));
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::Decimal);
+  CHECK(token.toFloat<double>() == 0.0);
+  CHECK((token = tokenizer.nextToken()).type() == SimpleToken::String);
+  CHECK(token.toFloat<double>() == 0.0);
+  CHECK(token.toInteger<int>() == 0);
+}
+
+namespace WordToken
+{
+using Type = unsigned int;
+static const Type Word = 1 << 0;         // word
+static const Type QuotedString = 1 << 1; // quoted string
+static const Type Eof = 1 << 2;          // end of file
+} // namespace WordToken
+
+class WordTokenizer : public Tokenizer<WordToken::Type>
+{
+public:
+  using Token = Tokenizer<WordToken::Type>::Token;
+
+private:
+  Token emitToken() override
+  {
+    while (!eof())
+    {
+      discardWhile(Whitespace());
+      if (eof())
+      {
+        break;
+      }
+
+      size_t startLine = line();
+      size_t startColumn = column();
+      const char* c = curPos();
+      if (*c == '/' && lookAhead() == '/')
+      {
+        discardUntil("\n\r");
+      }
+      else if (*c == '"')
+      {
+        advance();
+        c = curPos();
+        const char* e = readQuotedString();
+        return Token(WordToken::QuotedString, c, e, offset(c), startLine, startColumn);
+      }
+      else
+      {
+        const char* e = readUntil(Whitespace());
+        return Token(WordToken::Word, c, e, offset(c), startLine, startColumn);
+      }
+    }
+    return Token(WordToken::Eof, nullptr, nullptr, length(), line(), column());
+  }
+
+public:
+  WordTokenizer(std::string_view str)
+    : Tokenizer<WordToken::Type>(std::move(str), "\"\\", '\\')
+  {
+  }
+};
+
+TEST_CASE("TokenizerTest.longRunsOfWhitespaceAndComments")
+{
+  const std::string testString(
+    "                                        first\r\n"
+    "// a comment that is longer than several blocks of sixteen characters\n"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t second_word_that_is_quite_long\n"
+    "\n\r\n\n  third");
+
+  WordTokenizer tokenizer(testString);
+  WordTokenizer::Token token;
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::Word);
+  CHECK(token.data() == "first");
+  CHECK(token.line() == 1u);
+  CHECK(token.column() == 41u);
+
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::Word);
+  CHECK(token.data() == "second_word_that_is_quite_long");
+  CHECK(token.line() == 3u);
+  CHECK(token.column() == 22u);
+
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::Word);
+  CHECK(token.data() == "third");
+  CHECK(token.line() == 7u);
+  CHECK(token.column() == 3u);
+
+  CHECK(tokenizer.nextToken().type() == WordToken::Eof);
+}
+
+TEST_CASE("TokenizerTest.longQuotedStringsWithEscapes")
+{
+  const std::string testString(
+    R"("a quoted string that spans \"several\" blocks of characters\\" )"
+    R"("ends with escaped backslashes \\\\\\\\" )"
+    "\"spans\nlines\" after");
+
+  WordTokenizer tokenizer(testString);
+  WordTokenizer::Token token;
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::QuotedString);
+  CHECK(
+    token.data() == R"(a quoted string that spans \"several\" blocks of characters\\)");
+  CHECK(token.column() == 1u);
+
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::QuotedString);
+  CHECK(token.data() == R"(ends with escaped backslashes \\\\\\\\)");
+  CHECK(token.column() == 65u);
+
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::QuotedString);
+  CHECK(token.data() == "spans\nlines");
+  CHECK(token.line() == 1u);
+
+  CHECK((token = tokenizer.nextToken()).type() == WordToken::Word);
+  CHECK(token.data() == "after");
+  CHECK(token.line() == 2u);
+  CHECK(token.column() == 8u);
+
+  CHECK(tokenizer.nextToken().type() == WordToken::Eof);
+}
 } // namespace IO
 } // namespace TrenchBroom
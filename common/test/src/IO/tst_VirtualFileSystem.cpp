@@ -19,9 +19,12 @@
 
 #include "Error.h"
 #include "IO/File.h"
+#include "IO/IdPakFileSystem.h"
+#include "IO/PathInfo.h"
 #include "IO/TestFileSystem.h"
 #include "IO/TraversalMode.h"
 #include "IO/VirtualFileSystem.h"
+#include "TestUtils.h"
 
 #include <kdl/overload.h>
 #include <kdl/reflection_impl.h>
@@ -519,5 +522,59 @@ TEST_CASE("VirtualFileSystem")
   }
 }
 
+TEST_CASE("VirtualFileSystem with image file systems")
+{
+  const auto fsTestPath = std::filesystem::current_path() / "fixture/test/IO/";
+
+  auto vfs = VirtualFileSystem{};
+  const auto pakId = vfs.mount("", openFS<IdPakFileSystem>(fsTestPath / "Pak/idpak.pak"));
+
+  SECTION("pathInfo")
+  {
+    CHECK(vfs.pathInfo("pics") == PathInfo::Directory);
+    CHECK(vfs.pathInfo("PICS/") == PathInfo::Directory);
+    CHECK(vfs.pathInfo("pics/tag1.pcx") == PathInfo::File);
+    CHECK(vfs.pathInfo("PICS/TAG1.pcX") == PathInfo::File);
+    CHECK(vfs.pathInfo("does_not_exist") == PathInfo::Unknown);
+  }
+
+  SECTION("openFile")
+  {
+    CHECK(vfs.openFile("pics/tag1.pcx").is_success());
+    CHECK(vfs.openFile("PICS/TAG1.pcX").is_success());
+  }
+
+  SECTION("later mounts take precedence")
+  {
+    auto tag1 = std::make_shared<ObjectFile<Object>>(Object{1});
+    vfs.mount(
+      "",
+      std::make_unique<TestFileSystem>(Entry{DirectoryEntry{
+        "",
+        {
+          DirectoryEntry{
+            "pics",
+            {
+              FileEntry{"tag1.pcx", tag1},
+            }},
+        }}}));
+
+    CHECK(vfs.openFile("pics/tag1.pcx") == Result<std::shared_ptr<File>>{tag1});
+    CHECK(vfs.openFile("pics/tag2.pcx").is_success());
+
+    vfs.mount("", openFS<IdPakFileSystem>(fsTestPath / "Pak/idpak.pak"));
+    CHECK(vfs.openFile("pics/tag1.pcx") != Result<std::shared_ptr<File>>{tag1});
+  }
+
+  SECTION("unmount")
+  {
+    CHECK(vfs.unmount(pakId));
+    CHECK(vfs.pathInfo("pics/tag1.pcx") == PathInfo::Unknown);
+    CHECK(
+      vfs.openFile("pics/tag1.pcx")
+      == Result<std::shared_ptr<File>>{Error{"'pics/tag1.pcx' not found"}});
+  }
+}
+
 } // namespace IO
 } // namespace TrenchBroom
@@ -19,6 +19,7 @@
 
 #include "IO/DiskIO.h"
 #include "IO/File.h"
+#include "IO/StandardMapParser.h"
 #include "IO/TestParserStatus.h"
 #include "IO/WorldReader.h"
 #include "Model/BezierPatch.h"
@@ -34,6 +35,8 @@
 #include "Model/WorldNode.h"
 #include "TestUtils.h"
 
+#include <kdl/string_utils.h>
+
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
@@ -42,6 +45,8 @@
 
 #include <filesystem>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -380,6 +385,36 @@ TEST_CASE("WorldReaderTest.parseBrushWithCurlyBraceInTextureName")
     != nullptr);
 }
 
+TEST_CASE("WorldReaderTest.convertStandardBrushToValve")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+})";
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto status = TestParserStatus{};
+  auto reader =
+    WorldReader{data, Model::MapFormat::Standard, Model::MapFormat::Valve, {}};
+
+  auto world = reader.read(worldBounds, status);
+  CHECK(world->mapFormat() == Model::MapFormat::Valve);
+
+  auto* defaultLayer = world->children().front();
+  REQUIRE(defaultLayer->childCount() == 1u);
+  auto* brushNode = static_cast<Model::BrushNode*>(defaultLayer->children().front());
+  checkBrushTexCoordSystem(brushNode, true);
+  CHECK(brushNode->brush().faces().size() == 6u);
+}
+
 TEST_CASE("WorldReaderTest.parseValveBrush")
 {
   const auto data = R"(
@@ -1931,6 +1966,73 @@ TEST_CASE("WorldReaderTest.parseProtectedEntityProperties")
   }
 }
 
+TEST_CASE("WorldReaderTest.parseLargeMapInChunks")
+{
+  // large enough to be split into several chunks of entities and parsed in parallel
+  const auto entityCount = size_t(5000);
+  const auto duplicatePropertyEntity = size_t(4000);
+
+  auto data = std::string{R"(// Game: Quake
+// Format: Standard
+{
+"classname" "worldspawn"
+}
+)"};
+
+  for (size_t i = 0; i < entityCount; ++i)
+  {
+    data += fmt::format(
+      R"(// entity {}
+{{
+"classname" "func_door"
+{}{{
+( -16 -16 -16 ) ( -16 -15 -16 ) ( -16 -16 -15 ) {{fence 0 0 0 1 1
+( -16 -16 -16 ) ( -16 -16 -15 ) ( -15 -16 -16 ) none 0 0 0 1 1
+( -16 -16 -16 ) ( -15 -16 -16 ) ( -16 -15 -16 ) none 0 0 0 1 1
+( 16 16 16 ) ( 16 17 16 ) ( 17 16 16 ) none 0 0 0 1 1
+( 16 16 16 ) ( 17 16 16 ) ( 16 16 17 ) none 0 0 0 1 1
+( 16 16 16 ) ( 16 16 17 ) ( 16 17 16 ) none 0 0 0 1 1
+}}
+}}
+)",
+      i,
+      i == duplicatePropertyEntity ? "\"classname\" \"duplicate\"\n" : "");
+  }
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+
+  auto world = reader.read(worldBounds, status);
+  REQUIRE(world != nullptr);
+
+  const auto& entityNodes = world->defaultLayer()->children();
+  REQUIRE(entityNodes.size() == entityCount);
+
+  // the worldspawn entity takes 5 lines and every entity takes 12 lines, except for the
+  // one with the duplicate property
+  const auto entityLine = [&](const size_t i) {
+    return 7 + i * 12 + (i > duplicatePropertyEntity ? 1 : 0);
+  };
+
+  for (const auto i : {size_t(0), size_t(1234), duplicatePropertyEntity, entityCount - 1})
+  {
+    const auto* entityNode = entityNodes[i];
+    CHECK(entityNode->lineNumber() == entityLine(i));
+    REQUIRE(entityNode->childCount() == 1u);
+
+    const auto brushLine = entityLine(i) + (i == duplicatePropertyEntity ? 3 : 2);
+    CHECK(entityNode->children().front()->lineNumber() == brushLine);
+  }
+
+  CHECK(
+    status.messages(LogLevel::Warn)
+    == std::vector<std::string>{fmt::format(
+      "Ignoring duplicate entity property 'classname' (line {}, column 1)",
+      entityLine(duplicatePropertyEntity) + 2)});
+}
+
 TEST_CASE("WorldReaderTest.parseUnknownFormatEmptyMap")
 {
   const auto data = R"(
@@ -1947,5 +2049,114 @@ TEST_CASE("WorldReaderTest.parseUnknownFormatEmptyMap")
   REQUIRE(world != nullptr);
   CHECK(world->mapFormat() == Model::MapFormat::Standard);
 }
+TEST_CASE("WorldReaderTest.detectMapFormats")
+{
+  using namespace Model;
+
+  const auto allFormats = std::vector<MapFormat>{
+    MapFormat::Standard,
+    MapFormat::Quake2,
+    MapFormat::Quake2_Valve,
+    MapFormat::Valve,
+    MapFormat::Hexen2,
+    MapFormat::Daikatana,
+    MapFormat::Quake3_Legacy,
+    MapFormat::Quake3_Valve,
+    MapFormat::Quake3,
+  };
+
+  const auto quakeFace = "( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex 0 0 0 1 1";
+  const auto quake2Face = "( 0 0 0 ) ( 0 0 1 ) ( 0 1 0 ) tex 0 0 0 1 1 0 0 0";
+  const auto hexen2Face = "( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex 0 0 0 1 1 0";
+  const auto valveFace =
+    "( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1";
+  const auto primitive =
+    "brushDef\n{\n( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) ( ( 1 0 0 ) ( 0 1 0 ) ) tex 0 0 0\n}";
+  const auto invalidFace = "( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex 0 0";
+
+  using T = std::tuple<std::vector<std::string>, std::vector<MapFormat>>;
+
+  // a face that no format can parse keeps all formats so that parsing reports the error
+  const auto [brushContents, expectedFormats] = GENERATE_COPY(values<T>({
+    {std::vector<std::string>{}, allFormats},
+    {{quakeFace},
+     {MapFormat::Standard,
+      MapFormat::Quake2,
+      MapFormat::Hexen2,
+      MapFormat::Daikatana,
+      MapFormat::Quake3_Legacy,
+      MapFormat::Quake3}},
+    {{quakeFace, quake2Face},
+     {MapFormat::Quake2,
+      MapFormat::Daikatana,
+      MapFormat::Quake3_Legacy,
+      MapFormat::Quake3}},
+    {{hexen2Face}, {MapFormat::Hexen2}},
+    {{valveFace}, {MapFormat::Quake2_Valve, MapFormat::Valve, MapFormat::Quake3_Valve}},
+    {{primitive}, {MapFormat::Quake3}},
+    {{invalidFace}, allFormats},
+  }));
+
+  const auto data =
+    brushContents.empty()
+      ? std::string{R"({ "classname" "worldspawn" })"}
+      : fmt::format(
+        R"({{
+"classname" "worldspawn"
+{{
+{}
+}}
+}})",
+        kdl::str_join(brushContents, "\n"));
+
+  CAPTURE(data);
+
+  CHECK(detectMapFormats(data, allFormats) == expectedFormats);
+}
+
+TEST_CASE("WorldReaderTest.detectMapFormatsIgnoresTruncatedFace")
+{
+  auto data = std::string{R"({
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+}
+}
+)"};
+
+  // the detector only inspects the beginning of the string
+  data += std::string(size_t(1) << 16, ' ');
+  data += "( 0 0 0 ) ( 0 1 0 ) ( 1 0 0 ) tex 0 0 0 1 1";
+
+  CHECK(
+    detectMapFormats(data, {Model::MapFormat::Standard, Model::MapFormat::Valve})
+    == std::vector<Model::MapFormat>{Model::MapFormat::Valve});
+}
+
+TEST_CASE("WorldReaderTest.parseUnknownFormatValveMap")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) __TB_empty [ -1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) __TB_empty [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+}
+}
+            )";
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto status = TestParserStatus{};
+  auto world = WorldReader::tryRead(
+    data, {Model::MapFormat::Standard, Model::MapFormat::Valve}, worldBounds, {}, status);
+  REQUIRE(world != nullptr);
+  CHECK(world->mapFormat() == Model::MapFormat::Valve);
+  CHECK(world->defaultLayer()->childCount() == 1u);
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -159,12 +159,25 @@ Result<void> TestGame::doWriteMap(
   });
 }
 
+void TestGame::doWriteMap(WorldNode& world, std::ostream& stream) const
+{
+  IO::NodeWriter writer(world, stream);
+  writer.writeMap();
+}
+
 Result<void> TestGame::doExportMap(
   WorldNode& /* world */, const IO::ExportOptions& /* options */) const
 {
   return kdl::void_success;
 }
 
+void TestGame::doExportMap(WorldNode& world, std::ostream& stream) const
+{
+  IO::NodeWriter writer(world, stream);
+  writer.setExporting(true);
+  writer.writeMap();
+}
+
 std::vector<Node*> TestGame::doParseNodes(
   const std::string& str,
   const MapFormat mapFormat,
@@ -244,6 +257,8 @@ Result<void> TestGame::doReloadShaders()
   ;
 }
 
+void TestGame::doRefreshFileSystem() {}
+
 bool TestGame::doIsEntityDefinitionFile(const std::filesystem::path& /* path */) const
 {
   return false;
@@ -316,9 +331,9 @@ std::unique_ptr<Assets::EntityModel> TestGame::doInitializeModel(
 {
   return nullptr;
 }
-void TestGame::doLoadFrame(
+void TestGame::doLoadFrames(
   const std::filesystem::path& /* path */,
-  size_t /* frameIndex */,
+  const std::vector<size_t>& /* frameIndices */,
   Assets::EntityModel& /* model */,
   Logger& /* logger */) const
 {
@@ -25,6 +25,7 @@
 #include "Result.h"
 
 #include <filesystem>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -85,8 +86,10 @@ private:
     Logger& logger) const override;
   Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path) const override;
+  void doWriteMap(WorldNode& world, std::ostream& stream) const override;
   Result<void> doExportMap(
     WorldNode& world, const IO::ExportOptions& options) const override;
+  void doExportMap(WorldNode& world, std::ostream& stream) const override;
 
   std::vector<Node*> doParseNodes(
     const std::string& str,
@@ -116,6 +119,7 @@ private:
     const std::vector<std::filesystem::path>& wadPaths,
     Logger& logger) override;
   Result<void> doReloadShaders() override;
+  void doRefreshFileSystem() override;
 
   bool doIsEntityDefinitionFile(const std::filesystem::path& path) const override;
   std::vector<Assets::EntityDefinitionFileSpec> doAllEntityDefinitionFiles()
@@ -139,9 +143,9 @@ private:
     IO::ParserStatus& status, const std::filesystem::path& path) const override;
   std::unique_ptr<Assets::EntityModel> doInitializeModel(
     const std::filesystem::path& path, Logger& logger) const override;
-  void doLoadFrame(
+  void doLoadFrames(
     const std::filesystem::path& path,
-    size_t frameIndex,
+    const std::vector<size_t>& frameIndices,
     Assets::EntityModel& model,
     Logger& logger) const override;
 };
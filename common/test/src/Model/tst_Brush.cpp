@@ -123,6 +123,42 @@ TEST_CASE("BrushTest.constructBrushWithRedundantFaces")
           .is_error());
 }
 
+TEST_CASE("BrushTest.copySharesGeometry")
+{
+  const vm::bbox3 worldBounds(8192.0);
+  const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+  const auto original =
+    builder
+      .createCuboid(vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)), "texture")
+      .value();
+
+  auto copy = original;
+  for (size_t i = 0; i < original.faceCount(); ++i)
+  {
+    CHECK(copy.face(i).geometry() == original.face(i).geometry());
+  }
+
+  SECTION("Changing face attributes keeps sharing the geometry")
+  {
+    auto attributes = copy.face(0).attributes();
+    attributes.setTextureName("other");
+    copy.face(0).setAttributes(attributes);
+
+    CHECK(copy.face(0).geometry() == original.face(0).geometry());
+    CHECK(original.face(0).attributes().textureName() == "texture");
+  }
+
+  SECTION("Changing the geometry of a copy does not affect the original")
+  {
+    REQUIRE(copy.expand(worldBounds, 6, true).is_success());
+
+    CHECK(copy.face(0).geometry() != original.face(0).geometry());
+    CHECK(copy.bounds() == vm::bbox3(vm::vec3(-70, -70, -70), vm::vec3(70, 70, 70)));
+    CHECK(original.bounds() == vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)));
+  }
+}
+
 TEST_CASE("BrushTest.clip")
 {
   const vm::bbox3 worldBounds(4096.0);
@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BrushFaceAttributes.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+TEST_CASE("BrushFaceAttributesTest.sharing")
+{
+  auto attributes = BrushFaceAttributes{"some_texture"};
+  auto other = BrushFaceAttributes{"some_texture"};
+
+  // equal attributes share their data, even if they were created separately
+  CHECK(attributes == other);
+  CHECK(&attributes.textureName() == &other.textureName());
+  CHECK(&attributes.offset() == &other.offset());
+
+  SECTION("Modifying attributes does not affect other attributes")
+  {
+    CHECK(attributes.setXOffset(16.0f));
+    CHECK(attributes.offset() == vm::vec2f{16.0f, 0.0f});
+    CHECK(other.offset() == vm::vec2f{0.0f, 0.0f});
+    CHECK(attributes != other);
+
+    CHECK(other.setXOffset(16.0f));
+    CHECK(attributes == other);
+    CHECK(&attributes.offset() == &other.offset());
+  }
+
+  SECTION("Setting an unchanged value")
+  {
+    CHECK_FALSE(attributes.setXOffset(0.0f));
+    CHECK(&attributes.offset() == &other.offset());
+  }
+
+  SECTION("Texture names are interned")
+  {
+    auto renamed = BrushFaceAttributes{"other_texture", attributes};
+    CHECK(renamed.textureName() == "other_texture");
+    CHECK(renamed != attributes);
+
+    CHECK(renamed.setTextureName("some_texture"));
+    CHECK(renamed == attributes);
+    CHECK(&renamed.textureName() == &attributes.textureName());
+  }
+}
+} // namespace TrenchBroom::Model
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushGeometryStore.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+TEST_CASE("BrushGeometryStoreTest.addAndRemoveBrushes")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  auto builder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto cube = BrushNode{builder.createCube(64.0, "texture").value()};
+  auto cuboid =
+    BrushNode{builder.createCuboid(vm::vec3{32.0, 32.0, 16.0}, "texture").value()};
+
+  // a cube with one corner cut off has 10 vertices and 7 faces
+  auto cutCube = BrushNode{builder
+                             .createBrush(
+                               {
+                                 {-32.0, -32.0, -32.0},
+                                 {-32.0, -32.0, +32.0},
+                                 {-32.0, +32.0, -32.0},
+                                 {-32.0, +32.0, +32.0},
+                                 {+32.0, -32.0, -32.0},
+                                 {+32.0, -32.0, +32.0},
+                                 {+32.0, +32.0, -32.0},
+                                 {+16.0, +32.0, +32.0},
+                                 {+32.0, +16.0, +32.0},
+                                 {+32.0, +32.0, +16.0},
+                               },
+                               "texture")
+                             .value()};
+
+  auto store = BrushGeometryStore{};
+  store.addBrush(cube);
+  store.addBrush(cuboid);
+  store.addBrush(cutCube);
+
+  REQUIRE(store.brushCount() == 3u);
+  CHECK(store.brushIndex(cutCube) == 2u);
+  CHECK(store.vertices(0).size() == 26u);
+  CHECK(store.planeDistances().size() == 19u);
+  CHECK(store.boundsMax(2) == std::vector<FloatType>{32.0, 8.0, 32.0});
+
+  const auto& cutCubeFaces = store.faceRanges()[2];
+  CHECK(cutCubeFaces.offset == 12u);
+  CHECK(cutCubeFaces.count == 7u);
+
+  SECTION("Removing a brush moves the last brush into its slot")
+  {
+    store.removeBrush(cube);
+
+    CHECK_FALSE(store.contains(cube));
+    CHECK(store.brushNodes() == std::vector<const BrushNode*>{&cutCube, &cuboid});
+    CHECK(store.brushIndex(cutCube) == 0u);
+    CHECK(store.boundsMax(2) == std::vector<FloatType>{32.0, 8.0});
+    CHECK(store.unusedVertexCount() == 8u);
+    CHECK(store.unusedFaceCount() == 6u);
+
+    store.compact();
+
+    CHECK(store.unusedVertexCount() == 0u);
+    CHECK(store.unusedFaceCount() == 0u);
+    CHECK(store.faceRanges()[0].offset == 0u);
+    CHECK(store.faceRanges()[0].count == 7u);
+    CHECK(store.faceRanges()[1].offset == 7u);
+  }
+
+  SECTION("Updating a brush that no longer fits into its range moves it to the end")
+  {
+    cube.setBrush(cutCube.brush());
+    store.updateBrush(cube);
+
+    CHECK(store.vertexRanges()[0].offset == 26u);
+    CHECK(store.vertexRanges()[0].count == 10u);
+    CHECK(store.unusedVertexCount() == 8u);
+    CHECK(store.faceRanges()[0].offset == 19u);
+    CHECK(store.unusedFaceCount() == 6u);
+  }
+
+  SECTION("Fragmented arrays are compacted")
+  {
+    store.removeBrush(cutCube);
+    store.removeBrush(cuboid);
+
+    CHECK(store.unusedVertexCount() == 0u);
+    CHECK(store.vertices(0).size() == 8u);
+  }
+}
+} // namespace TrenchBroom::Model
@@ -20,6 +20,8 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "Model/BezierPatch.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushBuilder.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
@@ -30,6 +32,7 @@
 #include "Model/LockState.h"
 #include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
+#include "Model/Tag.h"
 #include "Model/VisibilityState.h"
 #include "Model/WorldNode.h"
 #include "PreferenceManager.h"
@@ -1208,5 +1211,37 @@ TEST_CASE_METHOD(EditorContextTest, "EditorContextTest.testGroupedNodes")
     CHECK(context.selectable(entityNode) == selectable);
   }
 }
+
+TEST_CASE_METHOD(EditorContextTest, "EditorContextTest.testHiddenTags")
+{
+  auto tag = Tag{"tag", {}};
+  tag.setIndex(0);
+
+  BrushBuilder builder(worldNode.mapFormat(), worldBounds);
+  auto brush = builder.createCube(32.0, "sometex").value();
+  brush.face(0).addTag(tag);
+
+  auto* brushNode = new BrushNode{std::move(brush)};
+  worldNode.defaultLayer()->addChild(brushNode);
+
+  const auto& taggedFace = brushNode->brush().face(0);
+  const auto& untaggedFace = brushNode->brush().face(1);
+
+  CHECK(context.visible(brushNode));
+  CHECK_FALSE(context.hidden(taggedFace));
+  CHECK(context.visible(brushNode, taggedFace));
+
+  context.setHiddenTags(tag.type());
+
+  CHECK(context.visible(brushNode));
+  CHECK(context.hidden(taggedFace));
+  CHECK_FALSE(context.hidden(untaggedFace));
+  CHECK_FALSE(context.visible(brushNode, taggedFace));
+  CHECK(context.visible(brushNode, untaggedFace));
+
+  brushNode->addTag(tag);
+  CHECK_FALSE(context.visible(brushNode));
+  CHECK_FALSE(context.visible(brushNode, untaggedFace));
+}
 } // namespace Model
 } // namespace TrenchBroom
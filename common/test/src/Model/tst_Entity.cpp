@@ -190,6 +190,37 @@ TEST_CASE("EntityTest")
     CHECK(
       entity.modelSpecification()
       == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    SECTION("Cached specification is updated when referenced properties change")
+    {
+      entity.addOrUpdateProperty({}, "target", "some_target");
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.renameProperty({}, EntityPropertyKeys::Spawnflags, "flags");
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.renameProperty({}, "flags", EntityPropertyKeys::Spawnflags);
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.removeProperty({}, EntityPropertyKeys::Spawnflags);
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.setProperties({}, {{EntityPropertyKeys::Spawnflags, "2"}});
+      CHECK(
+        entity.modelSpecification()
+        == Assets::ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+
+      entity.unsetEntityDefinitionAndModel();
+      CHECK(entity.modelSpecification() == Assets::ModelSpecification{});
+    }
   }
 
   SECTION("decalSpecification")
@@ -272,6 +303,24 @@ TEST_CASE("EntityTest")
       entity.addOrUpdateProperty(config, "something", "else");
       CHECK(entity.modelTransformation() == vm::scaling_matrix(vm::vec3{2, 2, 2}));
     }
+
+    SECTION("Updates cached rotation")
+    {
+      entity.addOrUpdateProperty({}, EntityPropertyKeys::Classname, "some_name");
+      entity.addOrUpdateProperty({}, EntityPropertyKeys::Angle, "90");
+      const auto rotation = vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(90.0));
+      REQUIRE(entity.rotation() == vm::approx{rotation});
+
+      entity.addOrUpdateProperty({}, "something", "else");
+      CHECK(entity.rotation() == vm::approx{rotation});
+
+      entity.addOrUpdateProperty({}, EntityPropertyKeys::Angle, "0");
+      CHECK(entity.rotation() == vm::approx{vm::mat4x4::identity()});
+
+      entity.addOrUpdateProperty({}, EntityPropertyKeys::Angle, "90");
+      entity.removeProperty({}, EntityPropertyKeys::Angle);
+      CHECK(entity.rotation() == vm::approx{vm::mat4x4::identity()});
+    }
   }
 
   SECTION("renameProperty")
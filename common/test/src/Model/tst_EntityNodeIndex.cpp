@@ -174,6 +174,59 @@ TEST_CASE("EntityNodeIndexTest.addNumberedEntityProperty")
   delete entity1;
 }
 
+TEST_CASE("EntityNodeIndexTest.findNumberedProperty")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 =
+    new EntityNode({}, {{"target", "somevalue"}, {"target12", "othervalue"}});
+  EntityNode* entity2 =
+    new EntityNode({}, {{"targetname", "somevalue"}, {"target_x", "othervalue"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK(
+    findNumberedExact(index, "target", "somevalue")
+    == std::vector<EntityNodeBase*>{entity1});
+  CHECK(
+    findNumberedExact(index, "target", "othervalue")
+    == std::vector<EntityNodeBase*>{entity1});
+  CHECK(findNumberedExact(index, "targetname", "othervalue").empty());
+
+  CHECK_THAT(
+    index.findEntityNodes(EntityNodeIndexQuery::prefix("target"), "othervalue"),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2}));
+
+  delete entity1;
+  delete entity2;
+}
+
+TEST_CASE("EntityNodeIndexTest.findPropertyWithSpecialCharacters")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"te*t", "some*value"}});
+  EntityNode* entity2 = new EntityNode({}, {{"test", "somevalue"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK(
+    findExactExact(index, "te*t", "some*value")
+    == std::vector<EntityNodeBase*>{entity1});
+  CHECK(findExactExact(index, "test", "some*value").empty());
+  CHECK(findExactExact(index, "te*t", "somevalue").empty());
+  CHECK(findExactExact(index, "test", "some%value").empty());
+
+  CHECK(
+    index.allValuesForKeys(EntityNodeIndexQuery::exact("te*t"))
+    == std::vector<std::string>{"some*value"});
+
+  delete entity1;
+  delete entity2;
+}
+
 TEST_CASE("EntityNodeIndexTest.addRemoveFloatProperty")
 {
   EntityNodeIndex index;
@@ -0,0 +1,77 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/EntityProperties.h"
+
+#include <kdl/vector_utils.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+TEST_CASE("EntityPropertiesTest.internedKeys")
+{
+  const auto property1 = EntityProperty{"some_key", "some_value"};
+  const auto property2 = EntityProperty{std::string{"some_"} + "key", "other_value"};
+  const auto property3 = EntityProperty{EntityPropertyKeys::Classname, "worldspawn"};
+
+  CHECK(&property1.key() == &property2.key());
+  CHECK(&property3.key() == &EntityPropertyKeys::Classname);
+
+  auto property4 = EntityProperty{"other_key", "some_value"};
+  CHECK(&property4.key() != &property1.key());
+
+  property4.setKey("some_key");
+  CHECK(&property4.key() == &property1.key());
+  CHECK(property4 == property1);
+}
+
+TEST_CASE("EntityPropertiesTest.compare")
+{
+  const auto a1 = EntityProperty{"a", "1"};
+  const auto a2 = EntityProperty{"a", "2"};
+  const auto b1 = EntityProperty{"b", "1"};
+
+  CHECK(a1 == EntityProperty{"a", "1"});
+  CHECK(a1 != a2);
+  CHECK(a1 != b1);
+
+  CHECK(a1 < a2);
+  CHECK(a2 < b1);
+  CHECK(a1 <= a1);
+  CHECK(b1 > a2);
+  CHECK(b1 >= b1);
+
+  // properties are ordered by their key strings, not by the addresses of the keys
+  CHECK(
+    kdl::vec_sort(std::vector<EntityProperty>{b1, a2, a1})
+    == std::vector<EntityProperty>{a1, a2, b1});
+}
+
+TEST_CASE("EntityPropertiesTest.streamOperator")
+{
+  auto str = std::stringstream{};
+  str << EntityProperty{"some_key", "some_value"};
+  CHECK(str.str() == "EntityProperty{m_key: some_key, m_value: some_value}");
+}
+} // namespace TrenchBroom::Model
@@ -196,7 +196,11 @@ TEST_CASE("GameFactory")
         "Quake 3",
       });
 
+    CHECK(gameFactory.loadStats().gameConfigs == 3);
+    CHECK(gameFactory.loadStats().loadedProfiles == 0);
+
     const auto& quakeConfig = gameFactory.gameConfig("Quake");
+    CHECK(gameFactory.loadStats().loadedProfiles == 1);
     CHECK(quakeConfig.name == "Quake");
     CHECK(quakeConfig.compilationConfig.profiles.size() == 1);
     CHECK(quakeConfig.gameEngineConfig.profiles.size() == 1);
@@ -205,6 +209,24 @@ TEST_CASE("GameFactory")
     CHECK(quake3Config.name == "Quake 3");
     CHECK(quake3Config.compilationConfig.profiles.empty());
     CHECK(quake3Config.gameEngineConfig.profiles.empty());
+    CHECK(quake3Config.compilationConfigParseFailed);
+    CHECK(quake3Config.gameEngineConfigParseFailed);
+    CHECK(gameFactory.loadStats().loadedProfiles == 2);
+  }
+
+  SECTION("metadata does not load profiles")
+  {
+    REQUIRE(gameFactory.initialize({{env.dir() / gamesPath}, env.dir() / userPath})
+              .is_success());
+
+    CHECK(gameFactory.fileFormats("Quake") == std::vector<std::string>{"Valve"});
+    CHECK(!gameFactory.experimental("Quake"));
+    CHECK(!gameFactory.iconPath("Quake").empty());
+    CHECK(gameFactory.loadStats().loadedProfiles == 0);
+
+    gameFactory.gameConfig("Quake");
+    gameFactory.gameConfig("Quake");
+    CHECK(gameFactory.loadStats().loadedProfiles == 1);
   }
 
   SECTION("saveCompilationConfig")
@@ -239,6 +239,66 @@ TEST_CASE("GroupNodeTest.updateLinkedGroups")
   }
 }
 
+TEST_CASE("GroupNodeTest.updateLinkedGroupContents")
+{
+  const auto worldBounds = vm::bbox3(8192.0);
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* entityNode1 = new EntityNode{Entity{}};
+  auto* entityNode2 = new EntityNode{Entity{}};
+  groupNode.addChild(entityNode1);
+  groupNode.addChild(entityNode2);
+
+  auto groupNodeClone = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+  transformNode(
+    *groupNodeClone, vm::translation_matrix(vm::vec3(0.0, 2.0, 0.0)), worldBounds);
+
+  SECTION("Nothing changed")
+  {
+    updateLinkedGroupContents(groupNode, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const UpdateLinkedGroupContentsResult& r) {
+        CHECK(r.contentsToSwap.empty());
+        CHECK(r.groupNodesToReplace.empty());
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Only changed nodes are updated")
+  {
+    transformNode(
+      *entityNode2, vm::translation_matrix(vm::vec3(0.0, 0.0, 3.0)), worldBounds);
+
+    updateLinkedGroupContents(groupNode, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const UpdateLinkedGroupContentsResult& r) {
+        CHECK(r.groupNodesToReplace.empty());
+        REQUIRE(r.contentsToSwap.size() == 1u);
+
+        const auto& [groupNodeToUpdate, contentsToSwap] = r.contentsToSwap.front();
+        CHECK(groupNodeToUpdate == groupNodeClone.get());
+        REQUIRE(contentsToSwap.size() == 1u);
+
+        const auto& [nodeToUpdate, newContents] = contentsToSwap.front();
+        CHECK(nodeToUpdate == groupNodeClone->children().back());
+        CHECK(
+          std::get<Entity>(newContents.get()).origin() == vm::vec3(0.0, 2.0, 3.0));
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Target groups with a different structure are replaced")
+  {
+    groupNodeClone->addChild(new EntityNode{Entity{}});
+
+    updateLinkedGroupContents(groupNode, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const UpdateLinkedGroupContentsResult& r) {
+        CHECK(r.contentsToSwap.empty());
+        CHECK(r.groupNodesToReplace == std::vector<GroupNode*>{groupNodeClone.get()});
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+}
+
 TEST_CASE("GroupNodeTest.updateNestedLinkedGroups")
 {
   const auto worldBounds = vm::bbox3(8192.0);
@@ -401,6 +401,72 @@ TEST_CASE("ModelUtils.collectNodes")
       patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectNodesByType")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto* layerNode = new LayerNode{Layer{"layer"}};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode1 = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+  auto* brushNode2 = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+  // clang-format off
+  auto* patchNode = new PatchNode{BezierPatch{3, 3, {
+    {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+    {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+    {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "texture"}};
+  // clang-format on
+
+  entityNode->addChild(brushNode1);
+  groupNode->addChildren({entityNode, brushNode2, patchNode});
+  layerNode->addChild(groupNode);
+  worldNode.addChild(layerNode);
+
+  /*
+  worldNode
+  + defaultLayer
+  + layerNode
+    + groupNode
+      + entityNode
+        + brushNode1
+      + brushNode2
+      + patchNode
+  */
+
+  const auto nodesByType = collectNodesByType({&worldNode});
+  CHECK_THAT(
+    nodesByType.nodes(),
+    Catch::Equals(std::vector<Node*>{
+      worldNode.defaultLayer(),
+      layerNode,
+      groupNode,
+      entityNode,
+      brushNode1,
+      brushNode2,
+      patchNode}));
+  CHECK_THAT(
+    nodesByType.layers(),
+    Catch::Equals(std::vector<LayerNode*>{worldNode.defaultLayer(), layerNode}));
+  CHECK_THAT(nodesByType.groups(), Catch::Equals(std::vector<GroupNode*>{groupNode}));
+  CHECK_THAT(
+    nodesByType.entities(), Catch::Equals(std::vector<EntityNode*>{entityNode}));
+  CHECK_THAT(
+    nodesByType.brushes(),
+    Catch::Equals(std::vector<BrushNode*>{brushNode1, brushNode2}));
+  CHECK_THAT(nodesByType.patches(), Catch::Equals(std::vector<PatchNode*>{patchNode}));
+
+  CHECK_THAT(
+    collectNodesByType({entityNode, patchNode}).nodes(),
+    Catch::Equals(std::vector<Node*>{entityNode, brushNode1, patchNode}));
+  CHECK(collectNodesByType({}).empty());
+}
+
 TEST_CASE("ModelUtils.collectTouchingNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
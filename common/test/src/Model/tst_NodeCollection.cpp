@@ -476,6 +476,50 @@ TEST_CASE("NodeCollection.removeNode")
   }
 }
 
+TEST_CASE("NodeCollection.removeNodes")
+{
+  EntityNode entityNodes[] = {
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+    EntityNode{Entity{}},
+  };
+
+  auto groupNode = GroupNode{Group{"group"}};
+
+  auto nodeCollection = NodeCollection{};
+  nodeCollection.addNode(&groupNode);
+  for (auto& entityNode : entityNodes)
+  {
+    nodeCollection.addNode(&entityNode);
+  }
+
+  nodeCollection.removeNodes(
+    {&entityNodes[6], &groupNode, &entityNodes[1], &entityNodes[2], &entityNodes[6]});
+
+  CHECK(
+    nodeCollection.nodes()
+    == std::vector<Node*>{
+      &entityNodes[0],
+      &entityNodes[3],
+      &entityNodes[4],
+      &entityNodes[5],
+      &entityNodes[7]});
+  CHECK(nodeCollection.groups() == std::vector<GroupNode*>{});
+  CHECK(
+    nodeCollection.entities()
+    == std::vector<EntityNode*>{
+      &entityNodes[0],
+      &entityNodes[3],
+      &entityNodes[4],
+      &entityNodes[5],
+      &entityNodes[7]});
+}
+
 TEST_CASE("NodeCollection.clear")
 {
   const auto mapFormat = MapFormat::Quake3;
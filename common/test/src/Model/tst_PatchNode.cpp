@@ -167,6 +167,65 @@ TEST_CASE("PatchNode.makePatchGrid")
     == kdl::vec_transform(expectedPoints, [](const auto& p) { return vm::approx{p}; }));
 }
 
+TEST_CASE("PatchNode.computeRenderSubdivisionsPerSurface")
+{
+  using CP = BezierPatch::Point;
+
+  // clang-format off
+  const auto flatPatch = BezierPatch{3, 3, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}},
+    "texture"};
+
+  const auto hillPatch = BezierPatch{3, 3, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 4.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}},
+    "texture"};
+
+  const auto warpedTexturePatch = BezierPatch{3, 3, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.9, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.9, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.9, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}},
+    "texture"};
+  // clang-format on
+
+  CHECK(computeRenderSubdivisionsPerSurface(flatPatch, 3u) == 0u);
+  CHECK(computeRenderSubdivisionsPerSurface(hillPatch, 3u) == 2u);
+  CHECK(computeRenderSubdivisionsPerSurface(hillPatch, 1u) == 1u);
+  CHECK(computeRenderSubdivisionsPerSurface(warpedTexturePatch, 3u) == 3u);
+}
+
+TEST_CASE("PatchNode.coarsenPatchGrid")
+{
+  using CP = BezierPatch::Point;
+
+  // clang-format off
+  const auto patch = BezierPatch{3, 5, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.25, 0.0}, CP{2.0, 2.0, 0.0, 0.5, 0.0}, CP{3.0, 2.0, 2.0, 0.75, 0.0}, CP{4.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 4.0, 0.25, 0.5}, CP{2.0, 1.0, 0.0, 0.5, 0.5}, CP{3.0, 1.0, 2.0, 0.75, 0.5}, CP{4.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.25, 1.0}, CP{2.0, 0.0, 0.0, 0.5, 1.0}, CP{3.0, 0.0, 2.0, 0.75, 1.0}, CP{4.0, 0.0, 0.0, 1.0, 1.0}},
+    "texture"};
+  // clang-format on
+
+  const auto fineGrid = makePatchGrid(patch, 3u);
+  const auto expectedGrid = makePatchGrid(patch, 1u);
+  const auto coarseGrid = coarsenPatchGrid(fineGrid, 4u);
+
+  CHECK(coarseGrid.pointRowCount == expectedGrid.pointRowCount);
+  CHECK(coarseGrid.pointColumnCount == expectedGrid.pointColumnCount);
+  CHECK(coarseGrid.bounds == fineGrid.bounds);
+
+  for (size_t i = 0u; i < expectedGrid.points.size(); ++i)
+  {
+    CHECK(coarseGrid.points[i].position == vm::approx{expectedGrid.points[i].position});
+    CHECK(coarseGrid.points[i].texCoords == vm::approx{expectedGrid.points[i].texCoords});
+  }
+
+  CHECK(coarsenPatchGrid(fineGrid, 1u) == fineGrid);
+}
+
 TEST_CASE("PatchNode.pickFlatPatch")
 {
   using P = BezierPatch::Point;
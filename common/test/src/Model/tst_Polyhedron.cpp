@@ -28,7 +28,10 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <optional>
 #include <set>
 #include <tuple>
 
@@ -507,6 +510,17 @@ TEST_CASE("PolyhedronTest.swap")
   CHECK(rhs.bounds() == original.bounds());
 }
 
+TEST_CASE("PolyhedronTest.memoryUsage")
+{
+  CHECK(Polyhedron3d{}.memoryUsage() == sizeof(Polyhedron3d));
+
+  const auto cube = Polyhedron3d{vm::bbox3d{-8.0, 8.0}};
+  CHECK(
+    cube.memoryUsage()
+    == sizeof(Polyhedron3d) + 8u * sizeof(PVertex) + 12u * sizeof(PEdge)
+         + 24u * sizeof(PHalfEdge) + 6u * sizeof(PFace));
+}
+
 TEST_CASE("PolyhedronTest.clipCubeWithHorizontalPlane")
 {
   const vm::vec3d p1(-64.0, -64.0, -64.0);
@@ -1746,5 +1760,80 @@ TEST_CASE("PolyhedronTest.intersection_polygon_polyhedron_any_orientation")
     },
     cube));
 }
+
+TEST_CASE("PolyhedronTest.withoutVertex")
+{
+  const auto p1 = vm::vec3d{-32, -32, -32};
+  const auto p2 = vm::vec3d{-32, -32, +32};
+  const auto p3 = vm::vec3d{-32, +32, -32};
+  const auto p4 = vm::vec3d{-32, +32, +32};
+  const auto p5 = vm::vec3d{+32, -32, -32};
+  const auto p6 = vm::vec3d{+32, -32, +32};
+  const auto p7 = vm::vec3d{+32, +32, -32};
+  const auto p8 = vm::vec3d{+32, +32, +32};
+  const auto p9 = vm::vec3d{0, 0, 64};
+
+  SECTION("Removing a cube corner")
+  {
+    const auto cube = Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8};
+    CHECK(cube.withoutVertex(p8) == Polyhedron3d{p1, p2, p3, p4, p5, p6, p7});
+  }
+
+  SECTION("Removing the apex of a pyramid on top of a cube")
+  {
+    const auto house = Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8, p9};
+    CHECK(house.withoutVertex(p9) == Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8});
+  }
+
+  SECTION("Removing a vertex of a pyramid on top of a cube")
+  {
+    const auto house = Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8, p9};
+    CHECK(house.withoutVertex(p8) == Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p9});
+  }
+
+  SECTION("Removing a vertex that does not exist")
+  {
+    const auto cube = Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8};
+    CHECK(cube.withoutVertex(p9) == std::nullopt);
+  }
+
+  SECTION("Removing a vertex of a tetrahedron")
+  {
+    const auto tetrahedron = Polyhedron3d{p1, p2, p3, p5};
+    CHECK(tetrahedron.withoutVertex(p5) == std::nullopt);
+  }
+}
+
+TEST_CASE("PolyhedronTest.withMovedVertex")
+{
+  // a prism with 16 sides
+  auto points = std::vector<vm::vec3d>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    const auto angle = vm::Cd::two_pi() * double(i) / 16.0;
+    const auto x = std::round(std::cos(angle) * 256.0);
+    const auto y = std::round(std::sin(angle) * 256.0);
+    points.emplace_back(x, y, -64.0);
+    points.emplace_back(x, y, +64.0);
+  }
+
+  const auto prism = Polyhedron3d{points};
+  REQUIRE(prism.polyhedron());
+
+  const auto position = prism.vertices().front()->position();
+  const auto delta = GENERATE(
+    vm::vec3d{0, 0, 16},
+    vm::vec3d{0, 0, -16},
+    vm::vec3d{16, 16, 16},
+    vm::vec3d{-128, -128, 0},
+    vm::vec3d{512, 0, 512});
+
+  const auto newPosition = position + delta;
+  auto movedPoints = prism.vertexPositions();
+  std::replace(std::begin(movedPoints), std::end(movedPoints), position, newPosition);
+
+  CAPTURE(position, newPosition);
+  CHECK(prism.withMovedVertex(position, newPosition) == Polyhedron3d{movedPoints});
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -23,8 +23,13 @@
 
 #include <vecmath/polygon.h>
 
+#include <fmt/format.h>
+
 #include <filesystem>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -104,5 +109,35 @@ TEST_CASE("PortalFileTest.parsePRT2")
       .portals()
     == ExpectedPortals);
 }
+TEST_CASE("PortalFileTest.parseManyPortals")
+{
+  constexpr auto PortalCount = size_t(10000);
+
+  auto str = std::string{"PRT1\n1\n"} + std::to_string(PortalCount) + "\n";
+  auto expectedPortals = std::vector<vm::polygon3f>{};
+  for (size_t i = 0; i < PortalCount; ++i)
+  {
+    const auto x = float(i);
+    str += fmt::format("3 {} {} ({} 0 0 ) ({} 16 0 ) ({} 0 16.5 ) \n", i, i + 1, x, x, x);
+    expectedPortals.push_back(vm::polygon3f{{x, 0, 0}, {x, 16, 0}, {x, 0, 16.5f}});
+  }
+
+  auto stream = std::istringstream{str};
+  const auto portalFile = loadPortalFile(stream);
+  REQUIRE(portalFile.is_success());
+  CHECK(portalFile.value().portals() == expectedPortals);
+}
+
+TEST_CASE("PortalFileTest.parseInvalidCoordinate")
+{
+  auto stream = std::istringstream{"PRT1\n1\n1\n3 0 1 (0 0 0 ) (0 a 0 ) (0 0 1 ) \n"};
+  CHECK(loadPortalFile(stream).is_error());
+}
+
+TEST_CASE("PortalFileTest.parseMissingPortal")
+{
+  auto stream = std::istringstream{"PRT1\n1\n2\n3 0 1 (0 0 0 ) (0 1 0 ) (0 0 1 ) \n"};
+  CHECK(loadPortalFile(stream).is_error());
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -19,16 +19,21 @@
 
 #include "Error.h"
 #include "Exceptions.h"
+#include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/Tag.h"
 #include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/result.h>
 
+#include <memory>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -67,5 +72,55 @@ TEST_CASE("TaggingTest.testTagBrush")
   CHECK_FALSE(brushNode->hasTag(tag1));
   CHECK_FALSE(brushNode->hasTag(tag2));
 }
+
+TEST_CASE("TaggingTest.updateFaceTags")
+{
+  const vm::bbox3 worldBounds{4096.0};
+
+  auto tagManager = TagManager{};
+  tagManager.registerSmartTags({SmartTag{
+    "texture", {}, std::make_unique<TextureNameTagMatcher>("some_texture")}});
+  const auto& tag = tagManager.smartTag("texture");
+
+  auto brush = BrushBuilder{MapFormat::Standard, worldBounds}
+                 .createCube(64.0, "some_texture")
+                 .value();
+  auto& face = brush.face(0);
+  face.initializeTags(tagManager);
+  REQUIRE(face.hasTag(tag));
+
+  SECTION("Tags are updated when the texture name changes")
+  {
+    auto attributes = face.attributes();
+    attributes.setTextureName("other_texture");
+    face.setAttributes(attributes);
+
+    face.updateTags(tagManager);
+    CHECK_FALSE(face.hasTag(tag));
+  }
+
+  SECTION("Tags are updated when they were changed directly")
+  {
+    face.removeTag(tag);
+    face.updateTags(tagManager);
+    CHECK(face.hasTag(tag));
+  }
+
+  SECTION("Tags are updated when the smart tags change")
+  {
+    tagManager.registerSmartTags({SmartTag{
+      "texture", {}, std::make_unique<TextureNameTagMatcher>("other_texture")}});
+
+    face.updateTags(tagManager);
+    CHECK_FALSE(face.hasTag(tagManager.smartTag("texture")));
+  }
+
+  SECTION("Copies keep their tags")
+  {
+    auto copy = face;
+    copy.updateTags(tagManager);
+    CHECK(copy.hasTag(tag));
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -25,6 +25,8 @@
 
 #include <vecmath/vec.h>
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -57,5 +59,33 @@ TEST_CASE("TexCoordSystemTest.testSnapshotTypeSafety")
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+
+TEST_CASE("TexCoordSystemTest.texCoordProjection")
+{
+  auto attribs = BrushFaceAttributes{""};
+  attribs.setOffset(vm::vec2f{16.0f, -8.0f});
+  attribs.setScale(vm::vec2f{0.5f, 2.0f});
+  attribs.setRotation(30.0f);
+
+  const auto textureSize = vm::vec2f{64.0f, 32.0f};
+  const auto points = std::vector<vm::vec3>{
+    vm::vec3{0, 0, 0},
+    vm::vec3{32, -16, 8},
+    vm::vec3{-128, 64, 256},
+    vm::vec3{0.5, 1024.25, -3}};
+
+  auto paraxial = ParaxialTexCoordSystem{vm::vec3::pos_z(), attribs};
+  auto parallel = ParallelTexCoordSystem{vm::vec3{1, 2, 3}, vm::vec3{-2, 1, 0}};
+
+  for (const TexCoordSystem* texCoordSystem :
+       std::vector<const TexCoordSystem*>{&paraxial, &parallel})
+  {
+    const auto projection = texCoordSystem->texCoordProjection(attribs, textureSize);
+    for (const auto& point : points)
+    {
+      CHECK(projection(point) == texCoordSystem->getTexCoords(point, attribs, textureSize));
+    }
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -19,15 +19,20 @@
 
 #include "Model/BezierPatch.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushGeometryStore.h"
 #include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
+#include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/WorldNode.h"
 #include "TestUtils.h"
 #include "octree.h"
@@ -36,6 +41,7 @@
 #include <kdl/result_io.h>
 #include <kdl/string_utils.h>
 
+#include <vecmath/approx.h>
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/mat_io.h>
@@ -223,15 +229,15 @@ TEST_CASE("WorldNodeTest.nodeTreeUpdates")
       nodeTree.find_containers(vm::vec3d::zero()),
       Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode, patchNode}));
     REQUIRE_THAT(
-      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      nodeTree.find_containers(vm::vec3d{768, 768, 768}),
       Catch::UnorderedEquals(std::vector<Node*>{}));
 
     transformNode(
-      *entityNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+      *entityNode, vm::translation_matrix(vm::vec3d(768, 768, 768)), worldBounds);
     transformNode(
-      *brushNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+      *brushNode, vm::translation_matrix(vm::vec3d(768, 768, 768)), worldBounds);
     transformNode(
-      *patchNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+      *patchNode, vm::translation_matrix(vm::vec3d(768, 768, 768)), worldBounds);
 
     CHECK(nodeTree.contains(entityNode));
     CHECK(nodeTree.contains(brushNode));
@@ -240,7 +246,7 @@ TEST_CASE("WorldNodeTest.nodeTreeUpdates")
       nodeTree.find_containers(vm::vec3d::zero()),
       Catch::UnorderedEquals(std::vector<Node*>{}));
     CHECK_THAT(
-      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      nodeTree.find_containers(vm::vec3d{768, 768, 768}),
       Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode, patchNode}));
   }
 }
@@ -286,6 +292,139 @@ TEST_CASE("WorldNodeTest.rebuildNodeTree")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.deferNodeTreeUpdates")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto* brushNode1 = new BrushNode{builder.createCube(64.0, "texture").value()};
+  auto* brushNode2 = new BrushNode{builder.createCube(64.0, "texture").value()};
+  worldNode.defaultLayer()->addChild(brushNode1);
+  worldNode.defaultLayer()->addChild(brushNode2);
+
+  worldNode.deferNodeTreeUpdates();
+  worldNode.deferNodeTreeUpdates();
+
+  transformNode(
+    *brushNode1, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+  transformNode(
+    *brushNode2, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+
+  SECTION("Deferred updates are applied when the last deferral ends")
+  {
+    worldNode.applyDeferredNodeTreeUpdates();
+    worldNode.applyDeferredNodeTreeUpdates();
+  }
+
+  SECTION("Deferred updates are applied before querying the node tree")
+  {
+    worldNode.applyDeferredNodeTreeUpdates();
+  }
+
+  SECTION("Removed nodes are not updated")
+  {
+    worldNode.defaultLayer()->removeChild(brushNode2);
+    delete brushNode2;
+    brushNode2 = nullptr;
+  }
+
+  const auto& nodeTree = worldNode.nodeTree();
+  CHECK_THAT(
+    nodeTree.find_containers(vm::vec3d::zero()),
+    Catch::UnorderedEquals(std::vector<Node*>{}));
+
+  if (brushNode2)
+  {
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{brushNode1, brushNode2}));
+  }
+  else
+  {
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{brushNode1}));
+  }
+}
+
+TEST_CASE("WorldNodeTest.pickNearest")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < 8; ++i)
+  {
+    auto* brushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+    transformNode(
+      *brushNode,
+      vm::translation_matrix(vm::vec3{double(i) * 512.0 + 128.0, 128, 128}),
+      worldBounds);
+    worldNode.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto editorContext = EditorContext{};
+  const auto ray = vm::ray3{{-256, 128, 128}, {1, 0, 0}};
+  const auto filter = HitFilters::type(BrushNode::BrushHitType);
+
+  auto allHits = PickResult::byDistance();
+  worldNode.pick(editorContext, ray, allHits);
+  REQUIRE(allHits.size() == brushNodes.size());
+
+  auto nearestHits = PickResult::byDistance();
+  worldNode.pickNearest(editorContext, ray, filter, nearestHits);
+
+  const auto& hit = nearestHits.first(filter);
+  REQUIRE(hit.isMatch());
+  CHECK(hitToNode(hit) == brushNodes.front());
+  CHECK(hit.distance() == vm::approx{allHits.first(filter).distance()});
+  CHECK(nearestHits.size() < allHits.size());
+}
+
+TEST_CASE("WorldNodeTest.findNodesContaining")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* entityBrushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+  auto* groupBrushNode = new BrushNode{builder.createCube(32.0, "texture").value()};
+  auto* otherBrushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+  transformNode(
+    *otherBrushNode, vm::translation_matrix(vm::vec3{256, 0, 0}), worldBounds);
+
+  entityNode->addChild(entityBrushNode);
+  groupNode->addChild(entityNode);
+  groupNode->addChild(groupBrushNode);
+  worldNode.defaultLayer()->addChild(groupNode);
+  worldNode.defaultLayer()->addChild(otherBrushNode);
+
+  auto result = std::vector<Node*>{};
+  worldNode.findNodesContaining(vm::vec3{0, 0, 0}, result);
+  CHECK_THAT(
+    result,
+    Catch::UnorderedEquals(std::vector<Node*>{entityBrushNode, groupBrushNode}));
+
+  result.clear();
+  worldNode.findNodesContaining(vm::vec3{24, 0, 0}, result);
+  CHECK(result == std::vector<Node*>{entityBrushNode});
+
+  result.clear();
+  worldNode.findNodesContaining(vm::vec3{128, 0, 0}, result);
+  CHECK(result.empty());
+}
+
 TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -323,6 +462,64 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.brushGeometryStore")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto* brushNode1 = new BrushNode{builder.createCube(64.0, "texture").value()};
+  worldNode.defaultLayer()->addChild(brushNode1);
+
+  // the store is created on first access
+  const auto& store = worldNode.brushGeometryStore();
+  REQUIRE(store.brushCount() == 1u);
+  CHECK(store.brushNodes() == std::vector<const BrushNode*>{brushNode1});
+  CHECK(store.boundsMin(0) == std::vector<FloatType>{-32.0});
+  CHECK(store.boundsMax(2) == std::vector<FloatType>{32.0});
+  CHECK(store.vertexRanges()[0].count == 8u);
+  CHECK(store.faceRanges()[0].count == 6u);
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode2 = new BrushNode{builder.createCube(32.0, "texture").value()};
+  entityNode->addChild(brushNode2);
+  groupNode->addChild(entityNode);
+
+  SECTION("Adding a subtree adds its brushes")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    CHECK(store.brushCount() == 2u);
+    CHECK(store.contains(*brushNode2));
+  }
+
+  SECTION("Removing a subtree removes its brushes")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    worldNode.defaultLayer()->removeChild(groupNode);
+    CHECK(store.brushNodes() == std::vector<const BrushNode*>{brushNode1});
+    delete groupNode;
+  }
+
+  SECTION("Changing a brush updates its geometry")
+  {
+    transformNode(
+      *brushNode1, vm::translation_matrix(vm::vec3d{64.0, 0.0, 0.0}), worldBounds);
+
+    CHECK(store.boundsMin(0) == std::vector<FloatType>{32.0});
+    CHECK(store.boundsMax(0) == std::vector<FloatType>{96.0});
+
+    const auto& range = store.vertexRanges()[0];
+    for (size_t i = range.offset; i < range.offset + range.count; ++i)
+    {
+      CHECK(store.vertices(0)[i] >= 32.0);
+    }
+    delete groupNode;
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
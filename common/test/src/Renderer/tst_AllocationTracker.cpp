@@ -277,6 +277,93 @@ TEST_CASE("AllocationTrackerTest.expandWithUsedSpaceAtEnd")
   }
 }
 
+TEST_CASE("AllocationTrackerTest.usedSizeAndFragmentation")
+{
+  AllocationTracker t(100);
+  CHECK(t.usedSize() == 0u);
+  CHECK(t.fragmentation() == 0.0);
+
+  AllocationTracker::Block* b0 = t.allocate(10);
+  AllocationTracker::Block* b1 = t.allocate(10);
+  AllocationTracker::Block* b2 = t.allocate(10);
+  REQUIRE(b0 != nullptr);
+  REQUIRE(b1 != nullptr);
+  REQUIRE(b2 != nullptr);
+  CHECK(t.usedSize() == 30u);
+  CHECK(t.fragmentation() == 0.0);
+
+  // free space: [0, 10) and [30, 100)
+  t.free(b0);
+  CHECK(t.usedSize() == 20u);
+  CHECK(t.fragmentation() == Approx(1.0 - 70.0 / 80.0));
+
+  t.free(b1);
+  t.free(b2);
+  CHECK(t.usedSize() == 0u);
+  CHECK(t.fragmentation() == 0.0);
+}
+
+TEST_CASE("AllocationTrackerTest.compact")
+{
+  AllocationTracker t(100);
+
+  AllocationTracker::Block* b0 = t.allocate(10);
+  AllocationTracker::Block* b1 = t.allocate(20);
+  AllocationTracker::Block* b2 = t.allocate(10);
+  AllocationTracker::Block* b3 = t.allocate(30);
+  AllocationTracker::Block* b4 = t.allocate(10);
+
+  t.free(b0);
+  t.free(b2);
+  t.free(b4);
+  REQUIRE(
+    t.freeBlocks()
+    == (std::vector<AllocationTracker::Range>{{0, 10}, {30, 10}, {70, 30}}));
+
+  SECTION("no moves in a compact tracker")
+  {
+    auto c = AllocationTracker(100);
+    c.allocate(10);
+    CHECK(c.compact(10).empty());
+  }
+
+  SECTION("limited number of moves")
+  {
+    const auto moves = t.compact(1);
+    REQUIRE(moves.size() == 1u);
+    CHECK(moves[0].block == b1);
+    CHECK(moves[0].oldPos == 10u);
+    CHECK(b1->pos == 0u);
+
+    CHECK(
+      t.freeBlocks() == (std::vector<AllocationTracker::Range>{{20, 20}, {70, 30}}));
+    CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 20}, {40, 30}}));
+  }
+
+  SECTION("all moves")
+  {
+    const auto moves = t.compact(10);
+    REQUIRE(moves.size() == 2u);
+    CHECK(moves[0].block == b1);
+    CHECK(moves[0].oldPos == 10u);
+    CHECK(moves[1].block == b3);
+    CHECK(moves[1].oldPos == 40u);
+    CHECK(b1->pos == 0u);
+    CHECK(b3->pos == 20u);
+
+    CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{50, 50}}));
+    CHECK(t.usedBlocks() == (std::vector<AllocationTracker::Range>{{0, 20}, {20, 30}}));
+    CHECK(t.usedSize() == 50u);
+    CHECK(t.fragmentation() == 0.0);
+    CHECK(t.compact(10).empty());
+
+    // the moved blocks can still be freed
+    t.free(b1);
+    t.free(b3);
+    CHECK(t.freeBlocks() == (std::vector<AllocationTracker::Range>{{0, 100}}));
+  }
+}
+
 static constexpr size_t NumBrushes = 64'000;
 
 // between 12 and 140, inclusive.
@@ -324,6 +411,60 @@ TEST_CASE("AllocationTrackerTest.testShuffle")
   CHECK(ints == (std::vector<int>{8, 0, 7, 6, 4, 3, 5, 1, 2, 9}));
 }
 
+TEST_CASE("AllocationTrackerTest.compactRandomAllocations")
+{
+  std::mt19937 randEngine;
+
+  constexpr size_t Count = 1'000;
+  AllocationTracker t(140 * Count);
+
+  // fill each allocation with its index to check that the moves preserve the data
+  std::vector<size_t> data(t.capacity(), Count);
+  std::vector<std::pair<AllocationTracker::Block*, size_t>> allocations;
+  for (size_t i = 0; i < Count; ++i)
+  {
+    auto* block = t.allocate(getBrushSizeFromRandEngine(randEngine));
+    REQUIRE(block != nullptr);
+    std::fill_n(data.begin() + long(block->pos), block->size, i);
+    allocations.emplace_back(block, i);
+  }
+
+  shuffle(allocations, randEngine);
+  for (size_t i = 0; i < Count / 2; ++i)
+  {
+    t.free(allocations[i].first);
+  }
+  allocations.erase(allocations.begin(), allocations.begin() + long(Count / 2));
+
+  const auto usedSize = t.usedSize();
+  REQUIRE(t.fragmentation() > 0.0);
+
+  for (auto moves = t.compact(16); !moves.empty(); moves = t.compact(16))
+  {
+    for (const auto& move : moves)
+    {
+      // the data is moved to a lower position, so copying forward is safe
+      std::copy_n(
+        data.begin() + long(move.oldPos),
+        move.block->size,
+        data.begin() + long(move.block->pos));
+    }
+  }
+
+  CHECK(t.usedSize() == usedSize);
+  CHECK(t.fragmentation() == 0.0);
+  CHECK(
+    t.freeBlocks()
+    == (std::vector<AllocationTracker::Range>{{usedSize, t.capacity() - usedSize}}));
+
+  for (const auto& [block, index] : allocations)
+  {
+    const auto first = data.begin() + long(block->pos);
+    CHECK(std::all_of(
+      first, first + long(block->size), [&](const auto v) { return v == index; }));
+  }
+}
+
 TEST_CASE("AllocationTrackerTest.benchmarkAllocOnly")
 {
   std::mt19937 randEngine;
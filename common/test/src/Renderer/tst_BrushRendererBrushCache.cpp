@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Renderer/BrushRendererBrushCache.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+TEST_CASE("BrushRendererBrushCacheTest.cachedEdges")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+  auto brush = GENERATE_COPY(
+    builder.createCube(64.0, "texture").value(),
+    builder
+      .createBrush(
+        std::vector<vm::vec3d>{
+          {0, 0, 0}, {64, 0, 0}, {0, 64, 0}, {0, 0, 64}, {64, 64, 32}},
+        "texture")
+      .value());
+
+  const auto brushNode = Model::BrushNode{std::move(brush)};
+  auto& cache = brushNode.brushRendererBrushCache();
+  cache.validateVertexCache(brushNode);
+
+  const auto& vertices = cache.cachedVertices();
+  const auto& edges = cache.cachedEdges();
+
+  using Segment = std::tuple<vm::vec3f, vm::vec3f>;
+  const auto sorted = [](auto segments) {
+    std::sort(segments.begin(), segments.end());
+    return segments;
+  };
+
+  auto expectedSegments = std::vector<Segment>{};
+  for (const auto* edge : brushNode.brush().edges())
+  {
+    expectedSegments.emplace_back(
+      vm::vec3f{edge->firstVertex()->position()},
+      vm::vec3f{edge->secondVertex()->position()});
+  }
+
+  auto actualSegments = std::vector<Segment>{};
+  for (const auto& edge : edges)
+  {
+    const auto& p1 = getVertexComponent<0>(vertices[edge.vertexIndex1RelativeToBrush]);
+    const auto& p2 = getVertexComponent<0>(vertices[edge.vertexIndex2RelativeToBrush]);
+    actualSegments.emplace_back(p1, p2);
+
+    // the edge lies on the boundaries of both of its faces
+    CHECK(edge.face1 != edge.face2);
+    for (const auto* face : {edge.face1, edge.face2})
+    {
+      CHECK(face->boundary().point_status(vm::vec3{p1}) == vm::plane_status::inside);
+      CHECK(face->boundary().point_status(vm::vec3{p2}) == vm::plane_status::inside);
+    }
+  }
+
+  CHECK(sorted(actualSegments) == sorted(expectedSegments));
+}
+
+TEST_CASE("BrushRendererBrushCacheTest.selectProjectedEdges")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+  const auto brushNode = Model::BrushNode{builder.createCube(64.0, "texture").value()};
+  auto& cache = brushNode.brushRendererBrushCache();
+  cache.validateVertexCache(brushNode);
+
+  const auto& vertices = cache.cachedVertices();
+  const auto& edges = cache.cachedEdges();
+  REQUIRE(edges.size() == 12u);
+
+  const auto axis = GENERATE(size_t(0), size_t(1), size_t(2));
+  const auto edgeIndices = selectProjectedEdges(vertices, edges, axis);
+
+  // the four edges parallel to the axis are dropped, the remaining eight edges coincide
+  // in pairs
+  CHECK(edgeIndices.size() == 4u);
+  CHECK(std::is_sorted(edgeIndices.begin(), edgeIndices.end()));
+
+  using Segment = std::tuple<vm::vec2f, vm::vec2f>;
+  const auto project = [&](const auto i) {
+    const auto& p = getVertexComponent<0>(vertices[i]);
+    return vm::vec2f{p[(axis + 1) % 3], p[(axis + 2) % 3]};
+  };
+
+  auto projectedSegments = std::vector<Segment>{};
+  for (const auto edgeIndex : edgeIndices)
+  {
+    const auto& edge = edges[edgeIndex];
+    const auto p1 = project(edge.vertexIndex1RelativeToBrush);
+    const auto p2 = project(edge.vertexIndex2RelativeToBrush);
+    CHECK(p1 != p2);
+    projectedSegments.emplace_back(std::min(p1, p2), std::max(p1, p2));
+  }
+
+  std::sort(projectedSegments.begin(), projectedSegments.end());
+  CHECK(
+    std::adjacent_find(projectedSegments.begin(), projectedSegments.end())
+    == projectedSegments.end());
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/BrushRendererArrays.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+using Range = DirtyRangeTracker::Range;
+
+TEST_CASE("DirtyRangeTrackerTest.constructor")
+{
+  auto t = DirtyRangeTracker{100};
+  CHECK(t.capacity() == 100u);
+  CHECK(t.clean());
+  CHECK(t.ranges().empty());
+}
+
+TEST_CASE("DirtyRangeTrackerTest.markDirty")
+{
+  auto t = DirtyRangeTracker{100};
+
+  SECTION("empty range")
+  {
+    t.markDirty(10, 0);
+    CHECK(t.clean());
+  }
+
+  SECTION("disjoint ranges")
+  {
+    t.markDirty(90, 5);
+    t.markDirty(10, 5);
+    t.markDirty(50, 5);
+    CHECK_FALSE(t.clean());
+    CHECK(t.ranges() == std::vector<Range>{{10, 5}, {50, 5}, {90, 5}});
+  }
+
+  SECTION("overlapping ranges")
+  {
+    t.markDirty(10, 10);
+    t.markDirty(15, 10);
+    t.markDirty(5, 10);
+    CHECK(t.ranges() == std::vector<Range>{{5, 20}});
+  }
+
+  SECTION("adjacent ranges")
+  {
+    t.markDirty(10, 10);
+    t.markDirty(20, 10);
+    t.markDirty(5, 5);
+    CHECK(t.ranges() == std::vector<Range>{{5, 25}});
+  }
+
+  SECTION("range spanning several ranges")
+  {
+    t.markDirty(10, 5);
+    t.markDirty(30, 5);
+    t.markDirty(50, 5);
+    t.markDirty(80, 5);
+    t.markDirty(12, 40);
+    CHECK(t.ranges() == std::vector<Range>{{10, 45}, {80, 5}});
+  }
+
+  SECTION("out of bounds")
+  {
+    CHECK_THROWS(t.markDirty(95, 10));
+  }
+}
+
+TEST_CASE("DirtyRangeTrackerTest.coalesceClosestRanges")
+{
+  auto t = DirtyRangeTracker{DirtyRangeTracker::MaxRanges * 10};
+  for (size_t i = 0; i < DirtyRangeTracker::MaxRanges; ++i)
+  {
+    t.markDirty(i * 10, 1);
+  }
+  REQUIRE(t.ranges().size() == DirtyRangeTracker::MaxRanges);
+
+  // the new range has the smallest gap to the range at 20
+  t.markDirty(23, 1);
+  CHECK(t.ranges().size() == DirtyRangeTracker::MaxRanges);
+  CHECK(t.ranges()[1] == Range{10, 1});
+  CHECK(t.ranges()[2] == Range{20, 4});
+  CHECK(t.ranges()[3] == Range{30, 1});
+}
+
+TEST_CASE("DirtyRangeTrackerTest.expand")
+{
+  auto t = DirtyRangeTracker{10};
+  t.markDirty(2, 2);
+  t.expand(20);
+  CHECK(t.capacity() == 20u);
+  CHECK(t.ranges() == std::vector<Range>{{2, 2}, {10, 10}});
+
+  CHECK_THROWS(t.expand(20));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/EntityLod.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <vecmath/approx.h>
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <limits>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+vm::bbox3 boundsAt(const vm::vec3& center)
+{
+  return vm::bbox3{center - vm::vec3{8, 8, 8}, center + vm::vec3{8, 8, 8}};
+}
+
+PerspectiveCamera makeCamera()
+{
+  // the viewport frustum distance is 300 units, so one unit is one pixel at that distance
+  return PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 600},
+    vm::vec3f::zero(),
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+}
+} // namespace
+
+TEST_CASE("EntityLodTest.projectedSize")
+{
+  const auto camera = makeCamera();
+  const auto diagonal = float(vm::length(vm::vec3{16, 16, 16}));
+
+  CHECK(projectedSize(camera, boundsAt({300, 0, 0})) == vm::approx{diagonal});
+  CHECK(projectedSize(camera, boundsAt({3000, 0, 0})) == vm::approx{diagonal / 10.0f});
+  CHECK(
+    projectedSize(camera, boundsAt({-300, 0, 0})) == std::numeric_limits<float>::max());
+
+  auto orthographicCamera = OrthographicCamera{};
+  orthographicCamera.zoom(2.0f);
+  CHECK(
+    projectedSize(orthographicCamera, boundsAt({3000, 0, 0}))
+    == vm::approx{2.0f * diagonal});
+}
+
+TEST_CASE("EntityLodTest.disabled")
+{
+  const auto lod = EntityLod{};
+  CHECK_FALSE(lod.enabled());
+  CHECK(lod.showModel(boundsAt({10000, 0, 0})));
+  CHECK(lod.showBounds(boundsAt({10000, 0, 0})));
+  CHECK(lod.showLabel(boundsAt({10000, 0, 0})));
+}
+
+TEST_CASE("EntityLodTest.thresholds")
+{
+  const auto camera = makeCamera();
+  const auto lod = EntityLod{camera, 8.0f, 2.0f, 16.0f};
+  CHECK(lod.enabled());
+
+  // about 27 pixels
+  const auto near = boundsAt({300, 0, 0});
+  CHECK(lod.showModel(near));
+  CHECK(lod.showBounds(near));
+  CHECK(lod.showLabel(near));
+
+  // about 9 pixels
+  const auto middle = boundsAt({900, 0, 0});
+  CHECK(lod.showModel(middle));
+  CHECK(lod.showBounds(middle));
+  CHECK_FALSE(lod.showLabel(middle));
+
+  // about 5 pixels
+  const auto far = boundsAt({1500, 0, 0});
+  CHECK_FALSE(lod.showModel(far));
+  CHECK(lod.showBounds(far));
+  CHECK_FALSE(lod.showLabel(far));
+
+  // about 1 pixel
+  const auto veryFar = boundsAt({8000, 0, 0});
+  CHECK_FALSE(lod.showModel(veryFar));
+  CHECK_FALSE(lod.showBounds(veryFar));
+  CHECK_FALSE(lod.showLabel(veryFar));
+
+  const auto noModelLod = EntityLod{camera, 0.0f, 2.0f, 16.0f};
+  CHECK(noModelLod.showModel(veryFar));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
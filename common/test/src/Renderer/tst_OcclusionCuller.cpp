@@ -0,0 +1,160 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+PerspectiveCamera makeCamera()
+{
+  return PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 600},
+    vm::vec3f::zero(),
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+}
+
+vm::bbox3 boundsAt(const vm::vec3& center)
+{
+  return vm::bbox3{center - vm::vec3{8, 8, 8}, center + vm::vec3{8, 8, 8}};
+}
+
+// a square facing the camera at the given distance
+std::vector<vm::vec3> wall(const double distance, const double halfSize)
+{
+  return {
+    {distance, -halfSize, -halfSize},
+    {distance, halfSize, -halfSize},
+    {distance, halfSize, halfSize},
+    {distance, -halfSize, halfSize}};
+}
+} // namespace
+
+TEST_CASE("OcclusionCullerTest.reset")
+{
+  const auto camera = makeCamera();
+
+  auto culler = OcclusionCuller{};
+  culler.reset(camera, 64);
+  CHECK(culler.width() == 64);
+  CHECK(culler.height() == 48);
+
+  culler.buildHierarchy();
+  CHECK_FALSE(culler.occluded(boundsAt({256, 0, 0})));
+}
+
+TEST_CASE("OcclusionCullerTest.occludedByWall")
+{
+  const auto camera = makeCamera();
+
+  auto culler = OcclusionCuller{};
+  culler.reset(camera);
+  culler.addOccluder(wall(128.0, 64.0));
+  culler.buildHierarchy();
+
+  // behind the wall
+  CHECK(culler.occluded(boundsAt({256, 0, 0})));
+  CHECK(culler.occluded(boundsAt({1024, 64, 64})));
+
+  // in front of the wall
+  CHECK_FALSE(culler.occluded(boundsAt({64, 0, 0})));
+
+  // intersecting the wall
+  CHECK_FALSE(culler.occluded(boundsAt({128, 0, 0})));
+
+  // behind the wall, but visible next to it
+  CHECK_FALSE(culler.occluded(boundsAt({256, 140, 0})));
+  CHECK_FALSE(culler.occluded(boundsAt({2048, 0, 0}).expand(1024.0)));
+
+  // intersecting the near plane
+  CHECK_FALSE(culler.occluded(boundsAt({0, 0, 0})));
+
+  // behind the camera
+  CHECK_FALSE(culler.occluded(boundsAt({-256, 0, 0})));
+}
+
+TEST_CASE("OcclusionCullerTest.occludedByClippedFloor")
+{
+  const auto camera = makeCamera();
+
+  // the floor extends behind the camera and must be clipped at the near plane
+  auto culler = OcclusionCuller{};
+  culler.reset(camera);
+  culler.addOccluder(
+    {{-1024, -1024, -64}, {1024, -1024, -64}, {1024, 1024, -64}, {-1024, 1024, -64}});
+  culler.buildHierarchy();
+
+  // below the floor
+  CHECK(culler.occluded(boundsAt({256, 0, -128})));
+
+  // above the floor
+  CHECK_FALSE(culler.occluded(boundsAt({256, 0, 0})));
+
+  // below the floor, but seen past its far edge
+  CHECK_FALSE(culler.occluded(boundsAt({2048, 0, -96})));
+  CHECK(culler.occluded(boundsAt({2048, 0, -512})));
+}
+
+TEST_CASE("OcclusionCullerTest.windingOrder")
+{
+  const auto camera = makeCamera();
+
+  auto polygon = wall(128.0, 64.0);
+  const auto reversed = std::vector<vm::vec3>{polygon.rbegin(), polygon.rend()};
+
+  auto culler = OcclusionCuller{};
+  culler.reset(camera);
+  culler.addOccluder(reversed);
+  culler.buildHierarchy();
+
+  CHECK(culler.occluded(boundsAt({256, 0, 0})));
+}
+
+TEST_CASE("OcclusionCullerTest.adjacentOccluders")
+{
+  const auto camera = makeCamera();
+
+  // two halves of a wall must not leave a gap between them
+  auto culler = OcclusionCuller{};
+  culler.reset(camera);
+  culler.addOccluder({{128, -64, -64}, {128, 0, -64}, {128, 0, 64}, {128, -64, 64}});
+  culler.addOccluder({{128, 0, -64}, {128, 64, -64}, {128, 64, 64}, {128, 0, 64}});
+  culler.buildHierarchy();
+
+  CHECK(culler.occluded(boundsAt({256, 0, 0})));
+  CHECK(culler.occluded(boundsAt({512, 0, 32})));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/RenderProfiler.h"
+
+#include <sstream>
+#include <typeinfo>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+TEST_CASE("RenderProfilerTest.renderStepName")
+{
+  CHECK(renderStepName(typeid(RenderProfiler)) == "RenderProfiler");
+  CHECK(renderStepName(typeid(int)) == "int");
+}
+
+TEST_CASE("RenderProfilerTest.writeRenderProfileCsv")
+{
+  const auto samples = std::vector<RenderProfiler::Sample>{
+    {"BrushRenderer", 2.0, 1.5, 0.5},
+    {"a, b", 1.0, 0.25, 0.0},
+  };
+
+  SECTION("With header")
+  {
+    auto str = std::stringstream{};
+    writeRenderProfileCsv(str, 10.0, samples, true);
+    CHECK(
+      str.str()
+      == R"(time,step,count,cpu_ms,gpu_ms
+10,"BrushRenderer",2,1.5,0.5
+10,"a, b",1,0.25,0
+)");
+  }
+
+  SECTION("Without header")
+  {
+    auto str = std::stringstream{};
+    writeRenderProfileCsv(str, 10.0, samples, false);
+    CHECK(
+      str.str()
+      == R"(10,"BrushRenderer",2,1.5,0.5
+10,"a, b",1,0.25,0
+)");
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
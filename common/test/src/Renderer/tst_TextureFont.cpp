@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Renderer/AttrString.h"
+#include "Renderer/FontGlyph.h"
+#include "Renderer/FontTexture.h"
+#include "Renderer/TextureFont.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+TextureFont makeFont()
+{
+  auto glyphs = std::vector<FontGlyph>{};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    glyphs.emplace_back(i * 8, 0, 6, 8, 7);
+  }
+  return TextureFont{std::make_unique<FontTexture>(4, 8, 1), glyphs, 8, 'a', 4};
+}
+} // namespace
+
+TEST_CASE("TextureFontTest.layout")
+{
+  const auto font = makeFont();
+
+  const auto string = AttrString{"abcd"};
+  const auto layout = font.layout(string);
+  CHECK(layout->vertices == font.quads(string, true));
+  CHECK(layout->size == font.measure(string));
+
+  CHECK(font.layout(AttrString{"abcd"}) == layout);
+  CHECK(font.layout(AttrString{"dcba"}) != layout);
+}
+} // namespace Renderer
+} // namespace TrenchBroom
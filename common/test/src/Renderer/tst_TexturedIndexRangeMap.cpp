@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Renderer/TexturedIndexRangeMap.h"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+using Primitive = std::tuple<const Assets::Texture*, PrimType, size_t, size_t>;
+
+std::vector<Primitive> primitives(const TexturedIndexRangeMap& map)
+{
+  auto result = std::vector<Primitive>{};
+  map.forEachPrimitive(
+    [&](const auto* texture, const auto primType, const auto index, const auto count) {
+      result.emplace_back(texture, primType, index, count);
+    });
+  return result;
+}
+} // namespace
+
+TEST_CASE("TexturedIndexRangeMapTest.addWithSize")
+{
+  auto textureA = Assets::Texture{"textureA", 16, 16};
+  auto textureB = Assets::Texture{"textureB", 16, 16};
+
+  // the groups are sorted by texture
+  const auto* first = std::min(&textureA, &textureB, std::less<const Assets::Texture*>{});
+  const auto* second = first == &textureA ? &textureB : &textureA;
+
+  auto size = TexturedIndexRangeMap::Size{};
+  size.inc(second, PrimType::Polygon);
+  size.inc(first, PrimType::Triangles);
+  size.inc(second, PrimType::Polygon);
+  size.inc(first, PrimType::Triangles);
+
+  auto map = TexturedIndexRangeMap{size};
+  map.add(second, PrimType::Polygon, 0, 4);
+  map.add(first, PrimType::Triangles, 4, 3);
+  map.add(second, PrimType::Polygon, 7, 5);
+  map.add(first, PrimType::Triangles, 12, 3);
+
+  // the primitives are grouped by texture, and consecutive triangles are merged
+  CHECK(
+    primitives(map)
+    == std::vector<Primitive>{
+      {first, PrimType::Triangles, 4, 3},
+      {first, PrimType::Triangles, 12, 3},
+      {second, PrimType::Polygon, 0, 4},
+      {second, PrimType::Polygon, 7, 5},
+    });
+}
+
+TEST_CASE("TexturedIndexRangeMapTest.addWithDynamicGrowth")
+{
+  auto textureA = Assets::Texture{"textureA", 16, 16};
+  auto textureB = Assets::Texture{"textureB", 16, 16};
+
+  auto map = TexturedIndexRangeMap{};
+  map.add(&textureA, PrimType::Triangles, 0, 3);
+  map.add(&textureB, PrimType::Polygon, 3, 4);
+  map.add(&textureA, PrimType::Triangles, 7, 3);
+
+  auto other = TexturedIndexRangeMap{&textureB, PrimType::Polygon, 10, 5};
+  map.add(other);
+
+  auto result = primitives(map);
+  CHECK_THAT(
+    result,
+    Catch::Matchers::UnorderedEquals(std::vector<Primitive>{
+      {&textureA, PrimType::Triangles, 0, 3},
+      {&textureA, PrimType::Triangles, 7, 3},
+      {&textureB, PrimType::Polygon, 3, 4},
+      {&textureB, PrimType::Polygon, 10, 5},
+    }));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -18,6 +18,7 @@
  */
 
 #include "Renderer/GLVertex.h"
+#include "Renderer/GLVertexAttributeType.h"
 #include "Renderer/GLVertexType.h"
 
 #include <vecmath/forward.h>
@@ -75,5 +76,37 @@ TEST_CASE("VertexTest.memoryLayoutVertexList")
   REQUIRE(actual.size() == expected.size());
   REQUIRE(std::memcmp(expected.data(), actual.data(), sizeof(TestVertex) * 3) == 0);
 }
+
+TEST_CASE("VertexTest.memoryLayoutByteNormal")
+{
+  using Vertex = GLVertexTypes::P3NBT2::Vertex;
+
+  const auto pos = vm::vec3f(1.0f, 2.0f, 3.0f);
+  const auto normal = ByteNormal{vm::vec3f(0.0f, -1.0f, 1.0f)};
+  const auto uv = vm::vec2f(4.0f, 5.0f);
+
+  const auto actual = Vertex(pos, normal, uv);
+
+  REQUIRE(sizeof(Vertex) == 24u);
+  REQUIRE(std::memcmp(&actual, &pos, sizeof(pos)) == 0);
+
+  const auto* normalBytes = reinterpret_cast<const GLbyte*>(&actual) + sizeof(pos);
+  CHECK(normalBytes[0] == 0);
+  CHECK(normalBytes[1] == -127);
+  CHECK(normalBytes[2] == 127);
+  CHECK(normalBytes[3] == 0);
+
+  const auto* uvBytes = reinterpret_cast<const char*>(&actual) + 16u;
+  REQUIRE(std::memcmp(uvBytes, &uv, sizeof(uv)) == 0);
+}
+
+TEST_CASE("VertexTest.byteNormalPrecision")
+{
+  const auto normal = vm::normalize(vm::vec3f(1.0f, 2.0f, 3.0f));
+  const auto byteNormal = ByteNormal{normal};
+
+  CHECK(byteNormal.components == vm::vec<GLbyte, 4>(34, 68, 102, 0));
+  CHECK(vm::dot(vm::normalize(byteNormal.normal()), normal) == Approx(1.0f));
+}
 } // namespace Renderer
 } // namespace TrenchBroom
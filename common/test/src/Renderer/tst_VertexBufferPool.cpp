@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/VertexBufferPool.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+using Range = AllocationTracker::Range;
+
+TEST_CASE("VertexBufferPoolTest.allocate")
+{
+  auto pool = VertexBufferPool{};
+  CHECK(pool.allocationTracker().capacity() == 0u);
+  CHECK(pool.prepared());
+
+  const auto vertices = std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f};
+
+  auto* block1 = pool.allocate(vertices);
+  CHECK(block1->pos == 0u);
+  CHECK(block1->size == 4u * sizeof(float));
+  CHECK_FALSE(pool.prepared());
+
+  auto* block2 = pool.allocate(vertices);
+  CHECK(block2->pos == 4u * sizeof(float));
+  CHECK(block2->size == 4u * sizeof(float));
+  CHECK(pool.allocationTracker().capacity() == 8u * sizeof(float));
+
+  auto* block3 = pool.allocate(std::vector<float>{1.0f});
+  CHECK(block3->pos == 8u * sizeof(float));
+  CHECK(pool.allocationTracker().capacity() == 16u * sizeof(float));
+
+  CHECK(
+    pool.allocationTracker().usedBlocks()
+    == std::vector<Range>{{0, 16}, {16, 16}, {32, 4}});
+}
+
+TEST_CASE("VertexBufferPoolTest.free")
+{
+  auto pool = VertexBufferPool{};
+
+  const auto vertices = std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f};
+  auto* block1 = pool.allocate(vertices);
+  pool.allocate(vertices);
+
+  pool.free(block1);
+  CHECK(pool.allocationTracker().usedBlocks() == std::vector<Range>{{16, 16}});
+
+  // the freed space is reused without growing the pool
+  auto* block3 = pool.allocate(vertices);
+  CHECK(block3->pos == 0u);
+  CHECK(pool.allocationTracker().capacity() == 8u * sizeof(float));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -32,6 +32,9 @@ int main(int argc, char** argv)
   TrenchBroom::PreferenceManager::createInstance<TrenchBroom::TestPreferenceManager>();
   TrenchBroom::View::TrenchBroomApp app(argc, argv);
 
+  // the game factory is initialized in the background, but tests must not race with it
+  app.initializeGameFactory();
+
   TrenchBroom::View::setCrashReportGUIEnbled(false);
 
   ensure(qApp == &app, "invalid app instance");
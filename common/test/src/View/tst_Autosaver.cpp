@@ -92,6 +92,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveUntilSaveInter
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -109,6 +110,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveOfUnchangedMap
 
   Autosaver autosaver(document, 0s);
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -134,6 +136,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAfterSaveInterv
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -159,6 +162,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -168,12 +172,14 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
   CHECK_FALSE(env.fileExists("autosave/test.2.map"));
 
   // modify the map
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
   CHECK(env.fileExists("autosave/test.2.map"));
 }
 
@@ -199,6 +205,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesWhenCrashFilesP
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.2.map"));
 }
@@ -0,0 +1,191 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/CellLayout.h"
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+CellLayout makeLayout()
+{
+  auto layout = CellLayout{};
+  layout.setWidth(200.0f);
+  layout.setOuterMargin(5.0f);
+  layout.setGroupMargin(5.0f);
+  layout.setRowMargin(10.0f);
+  layout.setCellMargin(10.0f);
+  layout.setCellWidth(32.0f, 64.0f);
+  layout.setCellHeight(32.0f, 64.0f);
+
+  for (size_t i = 0; i < 5; ++i)
+  {
+    layout.addGroup("group" + std::to_string(i), 12.0f);
+    for (size_t j = 0; j < 3 + 4 * i; ++j)
+    {
+      const auto size = 16.0f * float(1 + (i + j) % 4);
+      layout.addItem(int(10 * i + j), size, size, 32.0f, 12.0f);
+    }
+  }
+
+  return layout;
+}
+
+std::vector<const LayoutGroup*> collectGroups(
+  const std::vector<LayoutGroup>& groups, const float y, const float height)
+{
+  auto result = std::vector<const LayoutGroup*>{};
+  for (const auto& group : groups)
+  {
+    if (group.intersectsY(y, height))
+    {
+      result.push_back(&group);
+    }
+  }
+  return result;
+}
+
+std::vector<const LayoutGroup*> collectGroups(const LayoutRange<LayoutGroup>& groups)
+{
+  auto result = std::vector<const LayoutGroup*>{};
+  for (const auto& group : groups)
+  {
+    result.push_back(&group);
+  }
+  return result;
+}
+
+std::vector<const LayoutRow*> collectRows(
+  const LayoutGroup& group, const float y, const float height)
+{
+  auto result = std::vector<const LayoutRow*>{};
+  for (const auto& row : group.rows())
+  {
+    if (row.intersectsY(y, height))
+    {
+      result.push_back(&row);
+    }
+  }
+  return result;
+}
+
+std::vector<const LayoutRow*> collectRows(const LayoutRange<LayoutRow>& rows)
+{
+  auto result = std::vector<const LayoutRow*>{};
+  for (const auto& row : rows)
+  {
+    result.push_back(&row);
+  }
+  return result;
+}
+
+std::vector<int> collectItems(CellLayout& layout)
+{
+  auto result = std::vector<int>{};
+  for (const auto& group : layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      for (const auto& cell : row.cells())
+      {
+        result.push_back(cell.itemAs<int>());
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("CellLayoutTest.groupsAndRowsIntersectingY")
+{
+  auto layout = makeLayout();
+  const auto& groups = layout.groups();
+
+  REQUIRE(groups.size() == 5u);
+  REQUIRE(groups.back().rows().size() > 1u);
+
+  for (float y = -20.0f; y < layout.height() + 20.0f; y += 7.0f)
+  {
+    for (const auto height : {0.0f, 10.0f, 50.0f, 200.0f})
+    {
+      CAPTURE(y, height);
+
+      CHECK(
+        collectGroups(layout.groupsIntersectingY(y, height))
+        == collectGroups(groups, y, height));
+
+      for (const auto& group : groups)
+      {
+        CHECK(
+          collectRows(group.rowsIntersectingY(y, height))
+          == collectRows(group, y, height));
+      }
+    }
+  }
+}
+
+TEST_CASE("CellLayoutTest.cellAt")
+{
+  auto layout = makeLayout();
+
+  for (const auto& group : layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      for (const auto& cell : row.cells())
+      {
+        const auto& bounds = cell.cellBounds();
+        const auto x = bounds.left() + bounds.width / 2.0f;
+        const auto y = bounds.top() + bounds.height / 2.0f;
+        CHECK(layout.cellAt(x, y) == &cell);
+      }
+    }
+  }
+
+  CHECK(layout.cellAt(1.0f, 1.0f) == nullptr);
+  CHECK(layout.cellAt(1.0f, layout.height() + 10.0f) == nullptr);
+}
+
+TEST_CASE("CellLayoutTest.setWidth")
+{
+  auto layout = makeLayout();
+
+  const auto items = collectItems(layout);
+  const auto rowCount = layout.groups().back().rows().size();
+  const auto height = layout.height();
+
+  layout.setWidth(100.0f);
+  CHECK(collectItems(layout) == items);
+  CHECK(layout.groups().back().rows().size() > rowCount);
+  CHECK(layout.height() > height);
+
+  layout.setWidth(200.0f);
+  CHECK(collectItems(layout) == items);
+  CHECK(layout.groups().back().rows().size() == rowCount);
+  CHECK(layout.height() == height);
+}
+} // namespace View
+} // namespace TrenchBroom
@@ -818,5 +818,50 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
 
   commandProcessor.undo();
 }
+
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+  const auto commandSize = NullCommand{"command"}.memorySize();
+
+  SECTION("Oldest commands are discarded when the budget is exceeded")
+  {
+    commandProcessor.setMemoryBudget(2 * commandSize + commandSize / 2);
+
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    CHECK(commandProcessor.undoStackMemorySize() == 2 * commandSize);
+
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    CHECK(commandProcessor.undoStackMemorySize() == 2 * commandSize);
+
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoStackMemorySize() == commandSize);
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoStackMemorySize() == 0u);
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("Lowering the budget discards commands immediately")
+  {
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    CHECK(commandProcessor.undoStackMemorySize() == 3 * commandSize);
+
+    commandProcessor.setMemoryBudget(0);
+
+    // the most recent command is always kept
+    CHECK(commandProcessor.undoStackMemorySize() == commandSize);
+    CHECK(commandProcessor.canUndo());
+  }
+
+  SECTION("Clearing resets the memory size")
+  {
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command"));
+    commandProcessor.clear();
+    CHECK(commandProcessor.undoStackMemorySize() == 0u);
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -216,6 +216,32 @@ TEST_CASE_METHOD(MapDocumentTest, "CompilationRunToolTaskRunner.toolCrashes")
 }
 #endif
 
+TEST_CASE_METHOD(MapDocumentTest, "CompilationExportMapTaskRunner.exportMap")
+{
+  auto variables = EL::NullVariableStore{};
+  auto output = QTextEdit{};
+  auto outputAdapter = TextOutputAdapter{&output};
+
+  auto context = CompilationContext{document, variables, outputAdapter, false};
+
+  auto testEnvironment = IO::TestEnvironment{};
+
+  const auto targetPath = std::filesystem::path{"some/path/exported.map"};
+
+  auto task =
+    Model::CompilationExportMap{true, (testEnvironment.dir() / targetPath).string()};
+  auto runner = CompilationExportMapTaskRunner{context, task};
+
+  // the map is written on a worker thread and the runner ends once it is written
+  auto exec = ExecuteTask{runner};
+  REQUIRE(exec.executeAndWait(5000ms));
+
+  CHECK(exec.started);
+  CHECK_FALSE(exec.errored);
+  CHECK(exec.ended);
+  CHECK(testEnvironment.fileExists(targetPath));
+}
+
 TEST_CASE_METHOD(
   MapDocumentTest, "CompilationCopyFilesTaskRunner.createTargetDirectories")
 {
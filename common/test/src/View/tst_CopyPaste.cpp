@@ -30,6 +30,10 @@
 #include "View/PasteType.h"
 
 #include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <tuple>
 
 #include "Catch2.h"
 
@@ -410,6 +414,61 @@ TEST_CASE_METHOD(
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "CopyPasteTest.pasteCopiedNodes")
+{
+  auto* brushNode = createBrushNode();
+  auto* entityBrushNode = createBrushNode();
+  auto* entityNode =
+    new Model::EntityNode{Model::Entity{{}, {{"classname", "func_door"}}}};
+  entityNode->addChild(entityBrushNode);
+  document->addNodes({{document->parentForNodes(), {brushNode, entityNode}}});
+
+  document->selectNodes({brushNode, entityBrushNode});
+  const auto copied = document->serializeSelectedNodes();
+  document->deselectAll();
+
+  const auto pastedEntityNode = [&]() {
+    const auto brushes = document->selectedNodes().brushes();
+    const auto it = std::find_if(brushes.begin(), brushes.end(), [](const auto* node) {
+      return dynamic_cast<const Model::EntityNode*>(node->parent()) != nullptr;
+    });
+    REQUIRE(it != brushes.end());
+    return static_cast<const Model::EntityNode*>((*it)->parent());
+  };
+
+  // the copied text is pasted by cloning the copied nodes, while a modified text must
+  // be parsed
+  const auto pasteAndCollect = [&](const auto& str) {
+    REQUIRE(document->paste(str) == PasteType::Node);
+    REQUIRE(document->selectedNodes().brushCount() == 2u);
+
+    return std::make_tuple(
+      pastedEntityNode()->entity().properties(),
+      kdl::vec_transform(
+        document->selectedNodes().brushes(),
+        [](const auto* node) { return node->logicalBounds(); }),
+      document->selectedNodes().brushes().front()->brush().face(0).texture());
+  };
+
+  const auto clonedNodes = pasteAndCollect(copied);
+  const auto parsedNodes = pasteAndCollect(copied + "\n");
+
+  CHECK(std::get<0>(clonedNodes) == std::get<0>(parsedNodes));
+  CHECK(std::get<1>(clonedNodes) == std::get<1>(parsedNodes));
+  CHECK(std::get<2>(clonedNodes) == std::get<2>(parsedNodes));
+
+  SECTION("Modifying the copied nodes does not affect pasting them")
+  {
+    document->deselectAll();
+    document->selectNodes({entityBrushNode});
+    document->setProperty("classname", "func_wall");
+    document->deselectAll();
+
+    REQUIRE(document->paste(copied) == PasteType::Node);
+    CHECK(pastedEntityNode()->entity().classname() == "func_door");
+  }
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "CopyPasteTest.undoRedo")
 {
   // https://github.com/TrenchBroom/TrenchBroom/issues/4174
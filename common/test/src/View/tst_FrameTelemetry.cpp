@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/FrameTelemetry.h"
+
+#include <chrono>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+using namespace std::chrono_literals;
+
+TEST_CASE("FrameTelemetryTest.percentiles")
+{
+  auto telemetry = FrameTelemetry{};
+
+  const auto empty = telemetry.percentiles(FrameTelemetry::Metric::Picking);
+  CHECK(empty.p50 == 0.0);
+  CHECK(empty.p99 == 0.0);
+  CHECK(empty.sampleCount == 0u);
+
+  for (int i = 100; i > 0; --i)
+  {
+    telemetry.addSample(FrameTelemetry::Metric::Picking, std::chrono::milliseconds{i});
+  }
+
+  const auto picking = telemetry.percentiles(FrameTelemetry::Metric::Picking);
+  CHECK(picking.p50 == Approx(50.0));
+  CHECK(picking.p95 == Approx(95.0));
+  CHECK(picking.p99 == Approx(99.0));
+  CHECK(picking.sampleCount == 100u);
+
+  CHECK(telemetry.percentiles(FrameTelemetry::Metric::FrameTime).sampleCount == 0u);
+}
+
+TEST_CASE("FrameTelemetryTest.maxSampleCount")
+{
+  auto telemetry = FrameTelemetry{2};
+
+  telemetry.addSample(FrameTelemetry::Metric::ToolControllers, 10ms);
+  telemetry.addSample(FrameTelemetry::Metric::ToolControllers, 1ms);
+  telemetry.addSample(FrameTelemetry::Metric::ToolControllers, 2ms);
+
+  const auto percentiles = telemetry.percentiles(FrameTelemetry::Metric::ToolControllers);
+  CHECK(percentiles.p99 == Approx(2.0));
+  CHECK(percentiles.sampleCount == 2u);
+}
+
+TEST_CASE("FrameTelemetryTest.inputLatency")
+{
+  auto telemetry = FrameTelemetry{};
+  const auto t0 = FrameTelemetry::Clock::time_point{};
+
+  // a frame without input has no latency
+  telemetry.frameRendered(t0, t0 + 2ms);
+
+  // the latency is measured from the first event since the previous frame
+  telemetry.eventReceived(t0 + 10ms);
+  telemetry.eventReceived(t0 + 15ms);
+  telemetry.frameRendered(t0 + 16ms, t0 + 20ms);
+
+  const auto frameTime = telemetry.percentiles(FrameTelemetry::Metric::FrameTime);
+  CHECK(frameTime.p50 == Approx(2.0));
+  CHECK(frameTime.p99 == Approx(4.0));
+  CHECK(frameTime.sampleCount == 2u);
+
+  const auto latency = telemetry.percentiles(FrameTelemetry::Metric::InputLatency);
+  CHECK(latency.p50 == Approx(10.0));
+  CHECK(latency.sampleCount == 1u);
+}
+} // namespace TrenchBroom::View
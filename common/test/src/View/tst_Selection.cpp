@@ -599,6 +599,33 @@ TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.updateLastSelectionBounds")
   CHECK(document->lastSelectionBounds() == bounds);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.selectionBoundsAfterPartialDeselect")
+{
+  auto* brushNode1 = createBrushNode();
+  auto* brushNode2 = createBrushNode();
+  auto* brushNode3 = createBrushNode();
+  transformNode(
+    *brushNode1,
+    vm::translation_matrix(vm::vec3{-64.0, -64.0, -64.0}),
+    document->worldBounds());
+  transformNode(
+    *brushNode3,
+    vm::translation_matrix(vm::vec3{64.0, 64.0, 64.0}),
+    document->worldBounds());
+  document->addNodes(
+    {{document->parentForNodes(), {brushNode1, brushNode2, brushNode3}}});
+
+  document->selectNodes({brushNode1, brushNode2, brushNode3});
+  const auto bounds = document->selectionBounds();
+  REQUIRE(bounds == vm::merge(brushNode1->logicalBounds(), brushNode3->logicalBounds()));
+
+  document->deselectNodes({brushNode2});
+  CHECK(document->selectionBounds() == bounds);
+
+  document->deselectNodes({brushNode3});
+  CHECK(document->selectionBounds() == brushNode1->logicalBounds());
+}
+
 TEST_CASE_METHOD(
   MapDocumentTest, "SelectionCommandTest.faceSelectionUndoAfterTranslationUndo")
 {
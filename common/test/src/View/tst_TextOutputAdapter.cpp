@@ -17,10 +17,13 @@ You should have received a copy of the GNU General Public License
 along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QCoreApplication>
 #include <QTextEdit>
 
 #include "View/TextOutputAdapter.h"
 
+#include <chrono>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -75,5 +78,30 @@ TEST_CASE("TextOutputAdapterTest.test")
     CHECK(textEdit.toPlainText() == "ABC\nline 2");
   }
 }
+TEST_CASE("TextOutputAdapterTest.batchedOutput")
+{
+  using namespace std::chrono_literals;
+
+  QTextEdit textEdit;
+  TextOutputAdapter adapter(&textEdit);
+
+  auto expected = QString{};
+  for (int i = 0; i < 1000; ++i)
+  {
+    adapter << "line " << i << "\r\n";
+    expected += QString{"line %1\n"}.arg(i);
+  }
+
+  // the first output is appended immediately, the rest is collected and appended later
+  CHECK(textEdit.toPlainText().startsWith("line "));
+
+  const auto endTime = std::chrono::steady_clock::now() + 5s;
+  while (textEdit.toPlainText() != expected && std::chrono::steady_clock::now() < endTime)
+  {
+    QCoreApplication::processEvents();
+  }
+
+  CHECK(textEdit.toPlainText() == expected);
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -20,10 +20,13 @@
 #include "MapDocumentTest.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
+#include "NotifierConnection.h"
 #include "TestUtils.h"
 
 #include <vecmath/mat_ext.h>
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom::View
@@ -86,4 +89,49 @@ TEST_CASE_METHOD(MapDocumentTest, "Transaction")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "Transaction.changeSet")
+{
+  auto changeSets = std::vector<DocumentChangeSet>{};
+  auto connection = NotifierConnection{};
+  connection += document->changeSetDidCommitNotifier.connect(
+    [&](const DocumentChangeSet& changeSet) { changeSets.push_back(changeSet); });
+
+  auto* layerNode = document->parentForNodes();
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+
+  auto transaction = Transaction{document};
+  document->addNodes({{layerNode, {entityNode}}});
+  document->selectNodes({entityNode});
+  document->transformObjects("translate", vm::translation_matrix(vm::vec3{1, 0, 0}));
+
+  REQUIRE(changeSets.empty());
+
+  SECTION("commit")
+  {
+    transaction.commit();
+
+    REQUIRE(changeSets.size() == 1u);
+    CHECK(changeSets[0].addedNodes == std::vector<Model::Node*>{entityNode});
+    CHECK_THAT(
+      changeSets[0].changedNodes,
+      Catch::UnorderedEquals(std::vector<Model::Node*>{layerNode, entityNode}));
+    CHECK_FALSE(changeSets[0].nodesWereRemoved);
+    CHECK(changeSets[0].selectionDidChange);
+
+    document->undoCommand();
+
+    REQUIRE(changeSets.size() == 2u);
+    CHECK(changeSets[1].addedNodes.empty());
+    CHECK(changeSets[1].changedNodes == std::vector<Model::Node*>{layerNode});
+    CHECK(changeSets[1].nodesWereRemoved);
+  }
+
+  SECTION("cancel")
+  {
+    transaction.cancel();
+
+    CHECK(changeSets.empty());
+  }
+}
+
 } // namespace TrenchBroom::View
@@ -97,6 +97,9 @@ TEST_CASE_METHOD(UpdateLinkedGroupsHelperTest, "UpdateLinkedGroupsHelperTest.own
   auto* linkedNode =
     static_cast<Model::GroupNode*>(groupNode->cloneRecursively(document->worldBounds()));
 
+  // the structures of the linked groups differ, so the children of groupNode are replaced
+  linkedNode->addChild(new Model::EntityNode{Model::Entity{}});
+
   document->addNodes({{document->parentForNodes(), {groupNode, linkedNode}}});
 
   SECTION("Helper takes ownership of replaced child nodes")
@@ -198,15 +201,14 @@ TEST_CASE_METHOD(
     +-groupNode
       +-brushNode (translated 0 16 0)
     +-linkedGroupNode (translated 32 0 0)
-      +-newLinkedBrushNode (translated 32 16 0)
+      +-linkedBrushNode (translated 32 16 0)
   */
 
-  // changes were propagated
+  // changes were propagated by swapping the contents of the linked brush node
   REQUIRE(linkedGroupNode->childCount() == 1u);
-  CHECK(linkedBrushNode->parent() == nullptr);
-  auto* newLinkedBrushNode = linkedGroupNode->children().front();
+  CHECK(linkedBrushNode->parent() == linkedGroupNode);
   CHECK(
-    newLinkedBrushNode->physicalBounds()
+    linkedBrushNode->physicalBounds()
     == originalBrushBounds.translate(vm::vec3(32.0, 16.0, 0.0)));
 
   // undo change propagation
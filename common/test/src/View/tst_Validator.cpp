@@ -27,12 +27,15 @@
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/LayerNode.h"
+#include "Model/NonIntegerVerticesValidator.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/mat_ext.h>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -104,5 +107,41 @@ TEST_CASE_METHOD(MapDocumentTest, "ValidatorTest.emptyProperty")
 
   kdl::vec_clear_and_delete(validators);
 }
+
+TEST_CASE_METHOD(MapDocumentTest, "ValidatorTest.validateIssuesInBatches")
+{
+  auto validators =
+    std::vector<const Model::Validator*>{new Model::NonIntegerVerticesValidator()};
+
+  // enough brushes to be split into several batches
+  auto nodes = std::vector<Model::Node*>{};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    nodes.push_back(createBrushNode("texture", [&](auto& brush) {
+      if (i % 3 == 0)
+      {
+        REQUIRE(brush
+                  .transform(
+                    document->worldBounds(),
+                    vm::translation_matrix(vm::vec3{0.5, 0.0, 0.0}),
+                    false)
+                  .is_success());
+      }
+    }));
+  }
+  nodes.push_back(new Model::EntityNode{Model::Entity{}});
+
+  Model::Node::validateIssues(nodes, validators);
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const auto issues = nodes[i]->issues(validators);
+    CHECK(issues.size() == (i % 3 == 0 ? 1u : 0u));
+  }
+  CHECK(nodes.back()->issues(validators).empty());
+
+  kdl::vec_clear_and_delete(nodes);
+  kdl::vec_clear_and_delete(validators);
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Model/Hit.h"
+#include "Model/PickResult.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+TEST_CASE("VertexHandleManagerTest.findHandles")
+{
+  auto manager = VertexHandleManager{};
+  manager.add(vm::vec3{0, 0, 0});
+  manager.add(vm::vec3{8, 8, 8});
+  manager.add(vm::vec3{1024, 0, 0});
+
+  const auto bounds = vm::bbox3{vm::vec3{-16, -16, -16}, vm::vec3{16, 16, 16}};
+  const auto cellTest = [&](const vm::bbox3& cellBounds) {
+    return bounds.intersects(cellBounds);
+  };
+
+  auto handles = manager.findHandles(cellTest);
+  std::sort(std::begin(handles), std::end(handles));
+  CHECK(handles == std::vector<vm::vec3>{{0, 0, 0}, {8, 8, 8}});
+
+  manager.remove(vm::vec3{0, 0, 0});
+  CHECK(manager.findHandles(cellTest) == std::vector<vm::vec3>{{8, 8, 8}});
+}
+
+TEST_CASE("VertexHandleManagerTest.selectCloseHandlesInNeighbouringCells")
+{
+  auto manager = VertexHandleManager{};
+  manager.add(vm::vec3{256, 0, 0});
+
+  manager.select(vm::vec3{255.9999999, 0, 0});
+  CHECK(manager.selected(vm::vec3{256, 0, 0}));
+
+  manager.deselect(vm::vec3{256.0000001, 0, 0});
+  CHECK_FALSE(manager.selected(vm::vec3{256, 0, 0}));
+}
+
+TEST_CASE("VertexHandleManagerTest.pick")
+{
+  auto manager = VertexHandleManager{};
+  manager.add(vm::vec3{256, 0, 0});
+  manager.add(vm::vec3{256, 1024, 0});
+  manager.add(vm::vec3{-256, 0, 0});
+
+  const auto camera = Renderer::PerspectiveCamera{};
+  const auto pickRay = vm::ray3{vm::vec3::zero(), vm::vec3::pos_x()};
+
+  auto pickResult = Model::PickResult{};
+  manager.pick(pickRay, camera, pickResult);
+
+  REQUIRE(pickResult.size() == 1u);
+  CHECK(pickResult.all().front().target<vm::vec3>() == vm::vec3{256, 0, 0});
+}
+} // namespace View
+} // namespace TrenchBroom
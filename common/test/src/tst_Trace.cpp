@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "IO/TestEnvironment.h"
+#include "Trace.h"
+
+#include <kdl/parallel.h>
+#include <kdl/string_compare.h>
+
+#include <sstream>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+TEST_CASE("TraceTest.writeTraceJson")
+{
+  auto str = std::stringstream{};
+
+  SECTION("No events")
+  {
+    writeTraceJson(str, {});
+    CHECK(str.str() == "{\"traceEvents\":[\n]}\n");
+  }
+
+  SECTION("Events")
+  {
+    writeTraceJson(
+      str,
+      {
+        {"outer", 0, 10, 100},
+        {"inner \"quoted\"", 0, 20, 30},
+      });
+    CHECK(
+      str.str()
+      == R"({"traceEvents":[
+{"name":"outer","ph":"X","ts":10,"dur":100,"pid":1,"tid":0},
+{"name":"inner \"quoted\"","ph":"X","ts":20,"dur":30,"pid":1,"tid":0}
+]}
+)");
+  }
+}
+
+TEST_CASE("TraceTest.recordZones")
+{
+  auto env = IO::TestEnvironment{};
+  const auto path = env.dir() / "trace.json";
+
+  {
+    const auto zone = TraceZone{"not recorded"};
+  }
+
+  startTracing(path);
+  CHECK(isTracing());
+  {
+    const auto zone = TraceZone{"outer zone"};
+    kdl::parallel_for(4, [](const size_t) {}, 1);
+  }
+  CHECK(stopTracing().is_success());
+  CHECK_FALSE(isTracing());
+
+  const auto trace = env.loadFile("trace.json");
+  CHECK(kdl::cs::str_is_prefix(trace, "{\"traceEvents\":["));
+  CHECK(trace.find("\"outer zone\"") != std::string::npos);
+  CHECK(trace.find("\"parallel_for chunk\"") != std::string::npos);
+  CHECK(trace.find("\"not recorded\"") == std::string::npos);
+}
+} // namespace TrenchBroom
@@ -22,9 +22,20 @@
 #include <kdl/string_utils.h>
 
 #include <vecmath/bbox.h>
+#include <vecmath/bbox_io.h>
 #include <vecmath/forward.h>
+#include <vecmath/intersection.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
+#include <vecmath/ray_io.h>
 #include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -232,6 +243,24 @@ TEST_CASE("node_address")
     CHECK(
       get_container({{-42, -42, -42}, {2, 2, 2}}, 32.0) == node_address{-2, -2, -2, 2});
   }
+
+  SECTION("get_loose_container")
+  {
+    CHECK(get_loose_container({{2, 2, 2}, {6, 6, 6}}, 32.0) == node_address{0, 0, 0, 0});
+    CHECK(
+      get_loose_container({{-6, -6, -6}, {2, 2, 2}}, 32.0)
+      == node_address{-1, -1, -1, 0});
+    CHECK(
+      get_loose_container({{30, 30, 30}, {34, 34, 34}}, 32.0)
+      == node_address{1, 1, 1, 0});
+
+    CHECK(
+      get_loose_container({{-42, -42, -42}, {2, 2, 2}}, 32.0)
+      == node_address{-2, -2, -2, 1});
+    CHECK(
+      get_loose_container({{20, 20, 20}, {84, 84, 84}}, 32.0)
+      == node_address{0, 0, 0, 1});
+  }
 }
 } // namespace detail
 
@@ -546,6 +575,312 @@ TEST_CASE("octree.remove")
   }
 }
 
+TEST_CASE("octree.insert_bulk")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("inserting nothing")
+  {
+    tree.insert(std::vector<std::tuple<vm::bbox3d, int>>{});
+    CHECK(tree.empty());
+  }
+
+  SECTION("inserting into root node")
+  {
+    tree.insert(kdl::vec_from(
+      std::tuple{vm::bbox3d{{-2, 0, 0}, {5, 3, 6}}, 1},
+      std::tuple{vm::bbox3d{{-32, -32, -32}, {32, 32, 32}}, 2},
+      std::tuple{vm::bbox3d{{-33, -32, -32}, {32, 32, 32}}, 3}));
+    CHECK(tree == octree<double, int>{32.0, leaf_node{{-2, -2, -2, 2}, {1, 2, 3}}});
+  }
+
+  SECTION("inserting skips unnecessary inner nodes")
+  {
+    tree.insert(kdl::vec_from(
+      std::tuple{vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1},
+      std::tuple{vm::bbox3d{{3, 3, 3}, {4, 4, 4}}, 2}));
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{leaf_node{{0, 0, 0, 0}, {1, 2}}})}});
+  }
+
+  SECTION("inserting creates inner nodes for items in different quadrants")
+  {
+    tree.insert(kdl::vec_from(
+      std::tuple{vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1},
+      std::tuple{vm::bbox3d{{33, 33, 33}, {34, 34, 34}}, 2}));
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{inner_node{
+              {0, 0, 0, 1},
+              {},
+              kdl::vec_from(
+                node{leaf_node{{0, 0, 0, 0}, {1}}},
+                node{leaf_node{{1, 0, 0, 0}, {}}},
+                node{leaf_node{{0, 1, 0, 0}, {}}},
+                node{leaf_node{{1, 1, 0, 0}, {}}},
+                node{leaf_node{{0, 0, 1, 0}, {}}},
+                node{leaf_node{{1, 0, 1, 0}, {}}},
+                node{leaf_node{{0, 1, 1, 0}, {}}},
+                node{leaf_node{{1, 1, 1, 0}, {2}}})}})}});
+  }
+
+  SECTION("inserting invalid or duplicate data throws and leaves the tree unchanged")
+  {
+    tree.insert({{2, 2, 2}, {3, 3, 3}}, 1);
+    const auto expected = octree<double, int>{
+      32.0,
+      inner_node{
+        {-2, -2, -2, 2},
+        {},
+        kdl::vec_from(
+          node{leaf_node{{-2, -2, -2, 1}, {}}},
+          node{leaf_node{{0, -2, -2, 1}, {}}},
+          node{leaf_node{{-2, 0, -2, 1}, {}}},
+          node{leaf_node{{0, 0, -2, 1}, {}}},
+          node{leaf_node{{-2, -2, 0, 1}, {}}},
+          node{leaf_node{{0, -2, 0, 1}, {}}},
+          node{leaf_node{{-2, 0, 0, 1}, {}}},
+          node{leaf_node{{0, 0, 0, 0}, {1}}})}};
+    REQUIRE(tree == expected);
+
+    CHECK_THROWS_AS(
+      tree.insert(kdl::vec_from(
+        std::tuple{vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 2},
+        std::tuple{vm::bbox3d{{6, 6, 6}, {7, 7, 7}}, 1})),
+      NodeTreeException);
+    CHECK(tree == expected);
+
+    CHECK_THROWS_AS(
+      tree.insert(kdl::vec_from(
+        std::tuple{vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 2},
+        std::tuple{vm::bbox3d{{6, 6, 6}, {7, 7, 7}}, 2})),
+      NodeTreeException);
+    CHECK(tree == expected);
+
+    CHECK_THROWS_AS(
+      tree.insert(kdl::vec_from(
+        std::tuple{vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 2},
+        std::tuple{vm::bbox3d{vm::vec3d::nan(), vm::vec3d::nan()}, 3})),
+      NodeTreeException);
+    CHECK(tree == expected);
+  }
+
+  SECTION("bulk inserted trees behave like trees built incrementally")
+  {
+    auto items = std::vector<std::tuple<vm::bbox3d, int>>{};
+    for (int i = 0; i < 512; ++i)
+    {
+      const auto x = double((i * 37) % 61 - 30) * 16.0;
+      const auto y = double((i * 53) % 47 - 23) * 16.0;
+      const auto z = double((i * 11) % 29 - 14) * 16.0;
+      const auto size = double(1 + i % 9) * 8.0;
+      items.emplace_back(vm::bbox3d{{x, y, z}, {x + size, y + size, z + size}}, i);
+    }
+
+    auto incremental_tree = octree<double, int>{32.0};
+    for (const auto& [bounds, data] : items)
+    {
+      incremental_tree.insert(bounds, data);
+    }
+
+    SECTION("into an empty tree") { tree.insert(items); }
+
+    SECTION("into a non-empty tree")
+    {
+      const auto split = std::next(items.begin(), 128);
+      for (auto it = items.begin(); it != split; ++it)
+      {
+        tree.insert(std::get<0>(*it), std::get<1>(*it));
+      }
+      tree.insert(std::vector<std::tuple<vm::bbox3d, int>>{split, items.end()});
+    }
+
+    SECTION("into a larger tree")
+    {
+      const auto split = std::next(items.begin(), 384);
+      tree.insert(std::vector<std::tuple<vm::bbox3d, int>>{items.begin(), split});
+      tree.insert(std::vector<std::tuple<vm::bbox3d, int>>{split, items.end()});
+    }
+
+    const auto sorted = [](auto v) {
+      std::sort(v.begin(), v.end());
+      return v;
+    };
+
+    for (const auto& [bounds, data] : items)
+    {
+      CHECK(tree.contains(data));
+      CHECK(
+        sorted(tree.find_intersectors(bounds))
+        == sorted(incremental_tree.find_intersectors(bounds)));
+      CHECK(
+        sorted(tree.find_containers(bounds.center()))
+        == sorted(incremental_tree.find_containers(bounds.center())));
+
+      const auto ray = vm::ray3d{bounds.min, vm::normalize(vm::vec3d{1, 2, 3})};
+      CHECK(
+        sorted(tree.find_intersectors(ray))
+        == sorted(incremental_tree.find_intersectors(ray)));
+    }
+
+    for (const auto& [bounds, data] : items)
+    {
+      CHECK(tree.remove(data));
+      CHECK_FALSE(tree.contains(data));
+    }
+    CHECK(tree.empty());
+  }
+}
+
+TEST_CASE("octree.update_bulk")
+{
+  auto items = std::vector<std::tuple<vm::bbox3d, int>>{};
+  for (int i = 0; i < 512; ++i)
+  {
+    const auto x = double((i * 37) % 61 - 30) * 16.0;
+    const auto y = double((i * 53) % 47 - 23) * 16.0;
+    const auto z = double((i * 11) % 29 - 14) * 16.0;
+    const auto size = double(1 + i % 9) * 8.0;
+    items.emplace_back(vm::bbox3d{{x, y, z}, {x + size, y + size, z + size}}, i);
+  }
+
+  auto tree = octree<double, int>{32.0};
+  tree.insert(items);
+
+  SECTION("items that stay in their node are not moved")
+  {
+    auto small_tree = octree<double, int>{32.0};
+    small_tree.insert(vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1);
+    small_tree.insert(vm::bbox3d{{33, 33, 33}, {34, 34, 34}}, 2);
+
+    auto expected = octree<double, int>{32.0};
+    expected.insert(vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1);
+    expected.insert(vm::bbox3d{{33, 33, 33}, {34, 34, 34}}, 2);
+
+    CHECK(
+      small_tree.update(kdl::vec_from(
+        std::tuple{vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 1},
+        std::tuple{vm::bbox3d{{35, 35, 35}, {36, 36, 36}}, 2}))
+      == 0u);
+    CHECK(small_tree == expected);
+  }
+
+  SECTION("items in a loose tree stay in their node when they move slightly")
+  {
+    auto loose_tree = octree<double, int>{32.0, true};
+    loose_tree.insert(vm::bbox3d{{30, 30, 30}, {38, 38, 38}}, 1);
+
+    auto expected = octree<double, int>{32.0, true};
+    expected.insert(vm::bbox3d{{30, 30, 30}, {38, 38, 38}}, 1);
+
+    // the item straddles a boundary, so a tight tree would move it to the parent node
+    CHECK(
+      loose_tree.update(
+        kdl::vec_from(std::tuple{vm::bbox3d{{28, 28, 28}, {36, 36, 36}}, 1}))
+      == 0u);
+    CHECK(loose_tree == expected);
+    CHECK(
+      loose_tree.find_intersectors(vm::bbox3d{{28, 28, 28}, {29, 29, 29}})
+      == std::vector<int>{1});
+
+    CHECK(
+      loose_tree.update(
+        kdl::vec_from(std::tuple{vm::bbox3d{{22, 22, 22}, {30, 30, 30}}, 1}))
+      == 1u);
+    CHECK(loose_tree.find_containers({23, 23, 23}) == std::vector<int>{1});
+  }
+
+  SECTION("updating unknown or invalid data throws and leaves the tree unchanged")
+  {
+    auto small_tree = octree<double, int>{32.0};
+    small_tree.insert(vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1);
+
+    auto expected = octree<double, int>{32.0};
+    expected.insert(vm::bbox3d{{2, 2, 2}, {3, 3, 3}}, 1);
+
+    CHECK_THROWS_AS(
+      small_tree.update(kdl::vec_from(
+        std::tuple{vm::bbox3d{{64, 64, 64}, {65, 65, 65}}, 1},
+        std::tuple{vm::bbox3d{{4, 4, 4}, {5, 5, 5}}, 2})),
+      NodeTreeException);
+    CHECK(small_tree == expected);
+
+    CHECK_THROWS_AS(
+      small_tree.update(kdl::vec_from(
+        std::tuple{vm::bbox3d{{64, 64, 64}, {65, 65, 65}}, 1},
+        std::tuple{vm::bbox3d{vm::vec3d::nan(), vm::vec3d::nan()}, 1})),
+      NodeTreeException);
+    CHECK(small_tree == expected);
+  }
+
+  SECTION("bulk updated trees behave like trees built from the new bounds")
+  {
+    const auto moved_count = GENERATE(size_t(16), size_t(384));
+
+    auto moved_items = std::vector<std::tuple<vm::bbox3d, int>>{};
+    for (size_t i = 0; i < moved_count; ++i)
+    {
+      const auto& [bounds, data] = items[i];
+      const auto delta = vm::vec3d{double(data % 7) * 24.0, -40.0, double(data % 3) * 8.0};
+      moved_items.emplace_back(vm::bbox3d{bounds.min + delta, bounds.max + delta}, data);
+      items[i] = moved_items.back();
+    }
+
+    auto expected_tree = octree<double, int>{32.0};
+    expected_tree.insert(items);
+    CHECK(tree.update(moved_items) <= moved_count);
+
+    const auto sorted = [](auto v) {
+      std::sort(v.begin(), v.end());
+      return v;
+    };
+
+    for (const auto& [bounds, data] : items)
+    {
+      CHECK(tree.contains(data));
+      CHECK(
+        sorted(tree.find_intersectors(bounds))
+        == sorted(expected_tree.find_intersectors(bounds)));
+      CHECK(
+        sorted(tree.find_containers(bounds.center()))
+        == sorted(expected_tree.find_containers(bounds.center())));
+    }
+
+    for (const auto& [bounds, data] : items)
+    {
+      CHECK(tree.remove(data));
+    }
+    CHECK(tree.empty());
+  }
+}
+
 TEST_CASE("octree.insert_duplicate")
 {
   auto tree = octree<double, int>{32.0};
@@ -620,6 +955,64 @@ TEST_CASE("octree.find_intersectors-ray")
   }
 }
 
+TEST_CASE("octree.visit_intersectors_nearest_first")
+{
+  auto tree = octree<double, int>{32.0};
+
+  auto bounds = std::vector<vm::bbox3d>{};
+  for (int i = 0; i < 16; ++i)
+  {
+    const auto x = double(i) * 64.0;
+    bounds.push_back(vm::bbox3d{{x, 0, 0}, {x + 16, 16, 16}});
+    tree.insert(bounds.back(), i);
+  }
+
+  const auto ray = vm::ray3d{{-16, 8, 8}, {1, 0, 0}};
+  const auto distance_to = [&](const int i) {
+    return vm::intersect_ray_bbox(ray, bounds[size_t(i)]);
+  };
+
+  SECTION("visits all intersectors if the visitor does not limit the distance")
+  {
+    auto visited = std::vector<int>{};
+    tree.visit_intersectors_nearest_first(ray, [&](const int i) {
+      visited.push_back(i);
+      return std::numeric_limits<double>::infinity();
+    });
+
+    std::sort(visited.begin(), visited.end());
+    auto expected = tree.find_intersectors(ray);
+    std::sort(expected.begin(), expected.end());
+    CHECK(visited == expected);
+  }
+
+  SECTION("stops once the remaining nodes are out of range")
+  {
+    auto visited = std::vector<int>{};
+    auto nearest = std::numeric_limits<double>::infinity();
+    tree.visit_intersectors_nearest_first(ray, [&](const int i) {
+      visited.push_back(i);
+      nearest = std::min(nearest, distance_to(i));
+      return nearest;
+    });
+
+    CHECK(nearest == 16.0);
+    CHECK(std::find(visited.begin(), visited.end(), 0) != visited.end());
+    CHECK(visited.size() < bounds.size());
+  }
+
+  SECTION("does not visit anything if the ray misses the tree")
+  {
+    auto visited = std::vector<int>{};
+    tree.visit_intersectors_nearest_first(
+      vm::ray3d{{-16, 8, 8}, {-1, 0, 0}}, [&](const int i) {
+        visited.push_back(i);
+        return std::numeric_limits<double>::infinity();
+      });
+    CHECK(visited.empty());
+  }
+}
+
 TEST_CASE("octree.find_intersectors-bbox")
 {
   auto tree = octree<double, int>{32.0};
@@ -682,6 +1075,64 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.find_intersectors-planes")
+{
+  auto tree = octree<double, int>{32.0};
+
+  // a box from (0, 0, 0) to (128, 128, 128)
+  const auto box = std::vector<vm::plane3d>{
+    {{0, 0, 0}, {-1, 0, 0}},
+    {{0, 0, 0}, {0, -1, 0}},
+    {{0, 0, 0}, {0, 0, -1}},
+    {{128, 128, 128}, {1, 0, 0}},
+    {{128, 128, 128}, {0, 1, 0}},
+    {{128, 128, 128}, {0, 0, 1}},
+  };
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(box).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    // no planes
+    CHECK(tree.find_intersectors(std::vector<vm::plane3d>{}) == std::vector<int>{1});
+
+    // fully contains leaf
+    CHECK(tree.find_intersectors(box) == std::vector<int>{1});
+
+    // leaf is entirely above one plane
+    CHECK(tree
+            .find_intersectors(std::vector<vm::plane3d>{
+              {{16, 0, 0}, {1, 0, 0}},
+            })
+            .empty());
+    CHECK(tree
+            .find_intersectors(std::vector<vm::plane3d>{
+              {{0, 0, 0}, vm::normalize(vm::vec3d{1, 1, 1})},
+              {{96, 96, 96}, -vm::normalize(vm::vec3d{1, 1, 1})},
+            })
+            .empty());
+
+    // leaf is cut by a plane
+    CHECK(
+      tree.find_intersectors(std::vector<vm::plane3d>{
+        {{48, 48, 48}, vm::normalize(vm::vec3d{1, 1, 1})},
+      })
+      == std::vector<int>{1});
+
+    // leaf touches a plane
+    CHECK(
+      tree.find_intersectors(std::vector<vm::plane3d>{
+        {{32, 0, 0}, {1, 0, 0}},
+      })
+      == std::vector<int>{1});
+  }
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
@@ -721,4 +1172,90 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.queries_find_all_matching_items")
+{
+  auto items = std::vector<std::tuple<vm::bbox3d, int>>{};
+  for (int i = 0; i < 256; ++i)
+  {
+    const auto x = double((i * 37) % 61 - 30) * 12.0;
+    const auto y = double((i * 53) % 47 - 23) * 12.0;
+    const auto z = double((i * 11) % 29 - 14) * 12.0;
+    const auto size = double(1 + i % 13) * 6.0;
+    items.emplace_back(vm::bbox3d{{x, y, z}, {x + size, y + size, z + size}}, i);
+  }
+
+  const auto loose = GENERATE(false, true);
+  CAPTURE(loose);
+
+  auto tree = octree<double, int>{16.0, loose};
+  for (const auto& [bounds, data] : items)
+  {
+    tree.insert(bounds, data);
+  }
+
+  // remove some items so that inner nodes are collapsed and the bounds of their parents'
+  // children change
+  const auto removed = [](const int data) { return data % 3 == 0; };
+  for (const auto& [bounds, data] : items)
+  {
+    if (removed(data))
+    {
+      REQUIRE(tree.remove(data));
+    }
+  }
+
+  const auto contains = [](const auto& v, const int data) {
+    return std::find(v.begin(), v.end(), data) != v.end();
+  };
+
+  const auto rays = std::vector<vm::ray3d>{
+    {{-500, -400, -300}, vm::normalize(vm::vec3d{1, 0.8, 0.6})},
+    {{0, 0, 0}, vm::vec3d::pos_x()},
+    {{12, -500, 36}, vm::vec3d::pos_y()},
+    {{100, 100, 500}, vm::normalize(vm::vec3d{-0.2, -0.1, -1})},
+  };
+  for (const auto& ray : rays)
+  {
+    CAPTURE(ray);
+    const auto result = tree.find_intersectors(ray);
+    for (const auto& [bounds, data] : items)
+    {
+      if (!removed(data) && !vm::is_nan(vm::intersect_ray_bbox(ray, bounds)))
+      {
+        CHECK(contains(result, data));
+      }
+    }
+  }
+
+  for (const auto& [query, unused] : items)
+  {
+    CAPTURE(query);
+    const auto intersectors = tree.find_intersectors(query);
+    const auto containers = tree.find_containers(query.center());
+    const auto volumeIntersectors = tree.find_intersectors(std::vector<vm::plane3d>{
+      {query.max.x(), vm::vec3d::pos_x()},
+      {query.max.y(), vm::vec3d::pos_y()},
+      {query.max.z(), vm::vec3d::pos_z()},
+      {-query.min.x(), vm::vec3d::neg_x()},
+      {-query.min.y(), vm::vec3d::neg_y()},
+      {-query.min.z(), vm::vec3d::neg_z()},
+    });
+    for (const auto& [bounds, data] : items)
+    {
+      if (!removed(data))
+      {
+        if (bounds.intersects(query))
+        {
+          CHECK(contains(intersectors, data));
+          CHECK(contains(volumeIntersectors, data));
+        }
+        if (bounds.contains(query.center()))
+        {
+          CHECK(contains(containers, data));
+        }
+      }
+    }
+  }
+}
 } // namespace TrenchBroom
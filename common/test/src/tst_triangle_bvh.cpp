@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "triangle_bvh.h"
+
+#include <vecmath/intersection.h>
+#include <vecmath/ray.h>
+#include <vecmath/ray_io.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace
+{
+/**
+ * Creates a grid of n * n * n small triangles in [-n, n]^3 with varying orientations.
+ */
+std::vector<vm::vec3f> makeTriangles(const size_t n)
+{
+  auto points = std::vector<vm::vec3f>{};
+  for (size_t x = 0; x < n; ++x)
+  {
+    for (size_t y = 0; y < n; ++y)
+    {
+      for (size_t z = 0; z < n; ++z)
+      {
+        const auto origin = vm::vec3f{
+          2.0f * float(x) - float(n), 2.0f * float(y) - float(n), 2.0f * float(z) - float(n)};
+        const auto i = x + y + z;
+        const auto u = vm::vec3f{1.0f, float(i % 3) * 0.25f, 0.0f};
+        const auto v = vm::vec3f{0.0f, 1.0f, float(i % 5) * 0.25f};
+        points.push_back(origin);
+        points.push_back(origin + u);
+        points.push_back(origin + v);
+      }
+    }
+  }
+  return points;
+}
+
+float intersectBruteForce(const std::vector<vm::vec3f>& points, const vm::ray3f& ray)
+{
+  auto closest = vm::nan<float>();
+  for (size_t i = 0; i < points.size(); i += 3)
+  {
+    closest = vm::safe_min(
+      closest, vm::intersect_ray_triangle(ray, points[i], points[i + 1], points[i + 2]));
+  }
+  return closest;
+}
+} // namespace
+
+TEST_CASE("triangle_bvh.empty")
+{
+  const auto bvh = triangle_bvh<float>{};
+  CHECK(bvh.empty());
+  CHECK(bvh.triangle_count() == 0u);
+  CHECK(vm::is_nan(bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{0, 0, 1}})));
+
+  const auto bvhFromNothing = triangle_bvh<float>{std::vector<vm::vec3f>{}};
+  CHECK(bvhFromNothing.empty());
+  CHECK(vm::is_nan(
+    bvhFromNothing.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{0, 0, 1}})));
+}
+
+TEST_CASE("triangle_bvh.single_triangle")
+{
+  const auto bvh = triangle_bvh<float>{std::vector<vm::vec3f>{
+    vm::vec3f{-1, -1, 4},
+    vm::vec3f{1, -1, 4},
+    vm::vec3f{0, 1, 4},
+  }};
+
+  CHECK_FALSE(bvh.empty());
+  CHECK(bvh.triangle_count() == 1u);
+  CHECK(bvh.node_count() == 1u);
+  CHECK(
+    bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{0, 0, 1}})
+    == Approx(4.0f));
+  CHECK(
+    bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 8}, vm::vec3f{0, 0, -1}})
+    == Approx(4.0f));
+  CHECK(vm::is_nan(bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{0, 0, -1}})));
+  CHECK(vm::is_nan(bvh.intersect(vm::ray3f{vm::vec3f{4, 0, 0}, vm::vec3f{0, 0, 1}})));
+}
+
+TEST_CASE("triangle_bvh.intersect")
+{
+  const auto points = makeTriangles(12);
+  const auto bvh = triangle_bvh<float>{points};
+
+  CHECK(bvh.triangle_count() == points.size() / 3u);
+  CHECK(bvh.node_count() > 1u);
+
+  const auto directions = std::vector<vm::vec3f>{
+    vm::vec3f{0, 0, 1},
+    vm::vec3f{0, 0, -1},
+    vm::normalize(vm::vec3f{1, 2, 3}),
+    vm::normalize(vm::vec3f{-3, 1, -2}),
+    vm::normalize(vm::vec3f{2, -1, 1}),
+  };
+
+  auto hitCount = size_t(0);
+  for (int x = -14; x <= 14; x += 3)
+  {
+    for (int y = -14; y <= 14; y += 3)
+    {
+      for (const auto& direction : directions)
+      {
+        // rays starting both outside and inside of the triangles' bounds
+        for (const auto z : {-20.0f, 0.3f})
+        {
+          const auto origin = vm::vec3f{float(x) + 0.3f, float(y) + 0.2f, z};
+          const auto ray = vm::ray3f{origin, direction};
+          const auto expected = intersectBruteForce(points, ray);
+          const auto actual = bvh.intersect(ray);
+
+          CAPTURE(ray);
+          if (vm::is_nan(expected))
+          {
+            CHECK(vm::is_nan(actual));
+          }
+          else
+          {
+            CHECK(actual == Approx(expected));
+            ++hitCount;
+          }
+        }
+      }
+    }
+  }
+
+  CHECK(hitCount > 0u);
+}
+} // namespace TrenchBroom
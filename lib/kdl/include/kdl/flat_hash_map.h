@@ -0,0 +1,435 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace kdl
+{
+namespace detail
+{
+/**
+ * An open addressing hash table with linear probing. The values are stored inline in a
+ * single vector, so that looking up a value touches only a few adjacent slots instead of
+ * following a pointer to a separately allocated node. On removal, the following values
+ * of the probe sequence are shifted back, so no tombstones are left behind.
+ *
+ * Inserting or removing a value invalidates all iterators, pointers and references.
+ *
+ * @tparam Value the type of the stored values
+ * @tparam Key the type of the keys
+ * @tparam KeyOf a function object returning the key of a value
+ * @tparam Hash the hash function for keys
+ * @tparam KeyEqual the equality predicate for keys
+ */
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+class flat_hash_table
+{
+private:
+  using slot = std::optional<Value>;
+
+  static constexpr auto npos = static_cast<std::size_t>(-1);
+  static constexpr auto min_capacity = std::size_t(8);
+
+  std::vector<slot> m_slots;
+  std::size_t m_size = 0u;
+  Hash m_hash;
+  KeyEqual m_key_equal;
+
+public:
+  template <typename Table, typename V>
+  class iterator_base
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = V*;
+    using reference = V&;
+
+  private:
+    Table* m_table = nullptr;
+    std::size_t m_index = 0u;
+
+  public:
+    iterator_base() = default;
+
+    iterator_base(Table* table, const std::size_t index)
+      : m_table{table}
+      , m_index{index}
+    {
+      skip_empty();
+    }
+
+    // allows converting an iterator to a const iterator
+    template <typename T, typename W>
+    iterator_base(const iterator_base<T, W>& other)
+      : m_table{other.table()}
+      , m_index{other.index()}
+    {
+    }
+
+    reference operator*() const { return *m_table->m_slots[m_index]; }
+    pointer operator->() const { return &*m_table->m_slots[m_index]; }
+
+    iterator_base& operator++()
+    {
+      ++m_index;
+      skip_empty();
+      return *this;
+    }
+
+    iterator_base operator++(int)
+    {
+      auto result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const iterator_base& lhs, const iterator_base& rhs)
+    {
+      return lhs.m_index == rhs.m_index;
+    }
+
+    friend bool operator!=(const iterator_base& lhs, const iterator_base& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    Table* table() const { return m_table; }
+    std::size_t index() const { return m_index; }
+
+  private:
+    void skip_empty()
+    {
+      while (m_index < m_table->m_slots.size() && !m_table->m_slots[m_index])
+      {
+        ++m_index;
+      }
+    }
+  };
+
+  using iterator = iterator_base<flat_hash_table, Value>;
+  using const_iterator = iterator_base<const flat_hash_table, const Value>;
+
+  flat_hash_table() = default;
+
+  iterator begin() { return {this, 0u}; }
+  iterator end() { return {this, m_slots.size()}; }
+  const_iterator begin() const { return {this, 0u}; }
+  const_iterator end() const { return {this, m_slots.size()}; }
+
+  bool empty() const { return m_size == 0u; }
+  std::size_t size() const { return m_size; }
+  std::size_t capacity() const { return m_slots.size(); }
+
+  void clear()
+  {
+    for (auto& s : m_slots)
+    {
+      s.reset();
+    }
+    m_size = 0u;
+  }
+
+  /**
+   * Makes room for the given number of values without further reallocation.
+   */
+  void reserve(const std::size_t count)
+  {
+    auto new_capacity = std::max(capacity(), min_capacity);
+    while (exceeds_max_load(count, new_capacity))
+    {
+      new_capacity *= 2u;
+    }
+    if (new_capacity != capacity())
+    {
+      rehash(new_capacity);
+    }
+  }
+
+  iterator find(const Key& key)
+  {
+    const auto index = find_index(key);
+    return index != npos ? iterator{this, index} : end();
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    const auto index = find_index(key);
+    return index != npos ? const_iterator{this, index} : end();
+  }
+
+  std::size_t count(const Key& key) const { return find_index(key) != npos ? 1u : 0u; }
+
+  /**
+   * Inserts a value constructed from the given arguments unless a value with the given
+   * key exists.
+   *
+   * @return an iterator to the value with the given key and whether it was inserted
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    if (const auto index = find_index(key); index != npos)
+    {
+      return {iterator{this, index}, false};
+    }
+
+    reserve(m_size + 1u);
+    const auto index = find_insert_index(key);
+    m_slots[index].emplace(std::forward<Args>(args)...);
+    ++m_size;
+    return {iterator{this, index}, true};
+  }
+
+  std::size_t erase(const Key& key)
+  {
+    if (const auto index = find_index(key); index != npos)
+    {
+      erase_index(index);
+      return 1u;
+    }
+    return 0u;
+  }
+
+  void erase(const const_iterator& it) { erase_index(it.index()); }
+
+private:
+  static bool exceeds_max_load(const std::size_t count, const std::size_t capacity)
+  {
+    // keep the load factor at or below 7/8 so that probe sequences stay short
+    return count * 8u > capacity * 7u;
+  }
+
+  std::size_t home_index(const Key& key) const
+  {
+    // mix the hash so that identity hashes such as those of pointers are distributed
+    // across the whole table
+    auto h = static_cast<std::uint64_t>(m_hash(key));
+    h ^= h >> 33u;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33u;
+    return static_cast<std::size_t>(h) & (capacity() - 1u);
+  }
+
+  std::size_t next_index(const std::size_t index) const
+  {
+    return (index + 1u) & (capacity() - 1u);
+  }
+
+  std::size_t find_index(const Key& key) const
+  {
+    if (m_size == 0u)
+    {
+      return npos;
+    }
+
+    for (auto index = home_index(key); m_slots[index]; index = next_index(index))
+    {
+      if (m_key_equal(KeyOf{}(*m_slots[index]), key))
+      {
+        return index;
+      }
+    }
+    return npos;
+  }
+
+  std::size_t find_insert_index(const Key& key) const
+  {
+    auto index = home_index(key);
+    while (m_slots[index])
+    {
+      index = next_index(index);
+    }
+    return index;
+  }
+
+  void erase_index(std::size_t index)
+  {
+    assert(m_slots[index]);
+
+    // shift back the values following the removed one in its probe sequence
+    for (auto next = next_index(index); m_slots[next]; next = next_index(next))
+    {
+      const auto home = home_index(KeyOf{}(*m_slots[next]));
+      const auto mask = capacity() - 1u;
+      if (((next - home) & mask) >= ((next - index) & mask))
+      {
+        m_slots[index] = std::move(m_slots[next]);
+        index = next;
+      }
+    }
+
+    m_slots[index].reset();
+    --m_size;
+  }
+
+  void rehash(const std::size_t new_capacity)
+  {
+    auto old_slots = std::exchange(m_slots, std::vector<slot>(new_capacity));
+    for (auto& s : old_slots)
+    {
+      if (s)
+      {
+        m_slots[find_insert_index(KeyOf{}(*s))] = std::move(s);
+      }
+    }
+  }
+};
+
+template <typename K, typename V>
+struct flat_hash_map_key_of
+{
+  const K& operator()(const std::pair<K, V>& value) const { return value.first; }
+};
+
+template <typename K>
+struct flat_hash_set_key_of
+{
+  const K& operator()(const K& value) const { return value; }
+};
+} // namespace detail
+
+/**
+ * A hash map that stores its entries inline in a flat array. Use it instead of
+ * std::unordered_map for maps with small keys and values that are looked up frequently,
+ * e.g. maps keyed by pointers.
+ *
+ * Unlike std::unordered_map, inserting or erasing an entry invalidates all iterators,
+ * pointers and references to entries.
+ */
+template <
+  typename K,
+  typename V,
+  typename Hash = std::hash<K>,
+  typename KeyEqual = std::equal_to<K>>
+class flat_hash_map
+{
+private:
+  using key_of = detail::flat_hash_map_key_of<K, V>;
+  using table_type = detail::flat_hash_table<std::pair<K, V>, K, key_of, Hash, KeyEqual>;
+  table_type m_table;
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  iterator begin() { return m_table.begin(); }
+  iterator end() { return m_table.end(); }
+  const_iterator begin() const { return m_table.begin(); }
+  const_iterator end() const { return m_table.end(); }
+
+  bool empty() const { return m_table.empty(); }
+  std::size_t size() const { return m_table.size(); }
+  void clear() { m_table.clear(); }
+  void reserve(const std::size_t count) { m_table.reserve(count); }
+
+  iterator find(const K& key) { return m_table.find(key); }
+  const_iterator find(const K& key) const { return m_table.find(key); }
+  std::size_t count(const K& key) const { return m_table.count(key); }
+
+  V& at(const K& key) { return const_cast<V&>(std::as_const(*this).at(key)); }
+
+  const V& at(const K& key) const
+  {
+    if (const auto it = find(key); it != end())
+    {
+      return it->second;
+    }
+    throw std::out_of_range{"key not found"};
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+  std::pair<iterator, bool> insert(value_type value)
+  {
+    return m_table.try_emplace(value.first, std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+  {
+    return m_table.try_emplace(
+      key,
+      std::piecewise_construct,
+      std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  std::size_t erase(const K& key) { return m_table.erase(key); }
+  void erase(const const_iterator& it) { m_table.erase(it); }
+};
+
+/**
+ * A hash set that stores its values inline in a flat array. Use it instead of
+ * std::unordered_set for sets of small values such as pointers.
+ *
+ * Unlike std::unordered_set, inserting or erasing a value invalidates all iterators,
+ * pointers and references to values.
+ */
+template <typename K, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class flat_hash_set
+{
+private:
+  using table_type =
+    detail::flat_hash_table<K, K, detail::flat_hash_set_key_of<K>, Hash, KeyEqual>;
+  table_type m_table;
+
+public:
+  using key_type = K;
+  using value_type = K;
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  const_iterator begin() const { return m_table.begin(); }
+  const_iterator end() const { return m_table.end(); }
+
+  bool empty() const { return m_table.empty(); }
+  std::size_t size() const { return m_table.size(); }
+  void clear() { m_table.clear(); }
+  void reserve(const std::size_t count) { m_table.reserve(count); }
+
+  const_iterator find(const K& key) const { return m_table.find(key); }
+  std::size_t count(const K& key) const { return m_table.count(key); }
+
+  std::pair<const_iterator, bool> insert(const K& value)
+  {
+    return m_table.try_emplace(value, value);
+  }
+
+  std::size_t erase(const K& key) { return m_table.erase(key); }
+  void erase(const const_iterator& it) { m_table.erase(it); }
+};
+} // namespace kdl
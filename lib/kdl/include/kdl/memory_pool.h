@@ -0,0 +1,228 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace kdl
+{
+/**
+ * Allocates memory for objects of a fixed size from large blocks instead of allocating
+ * every object individually.
+ *
+ * Freed memory is kept in free lists and handed out again by subsequent allocations.
+ * Each thread allocates from and frees into its own free list without synchronization.
+ * Only when a thread's free list runs empty or grows too large, a batch of memory is
+ * exchanged with a list shared between all threads. Memory can be freed by a different
+ * thread than the one that allocated it.
+ *
+ * The blocks are only returned to the system when the program exits. Therefore, the
+ * pool should be used for objects that are allocated and freed frequently, e.g. by
+ * implementing a class specific operator new and operator delete:
+ *
+ * ```
+ * struct node
+ * {
+ *   static void* operator new(std::size_t) {
+ *     return memory_pool<sizeof(node), alignof(node)>::allocate();
+ *   }
+ *   static void operator delete(void* ptr) {
+ *     memory_pool<sizeof(node), alignof(node)>::deallocate(ptr);
+ *   }
+ * };
+ * ```
+ *
+ * @tparam Size the size of the allocated memory
+ * @tparam Alignment the alignment of the allocated memory
+ */
+template <std::size_t Size, std::size_t Alignment>
+class memory_pool
+{
+private:
+  union slot
+  {
+    slot* next;
+    alignas(Alignment) unsigned char storage[Size];
+  };
+
+  /**
+   * The number of slots that are allocated at once and exchanged between a thread's free
+   * list and the shared free list.
+   */
+  static constexpr std::size_t batch_size =
+    sizeof(slot) < 64 * 1024 ? 64 * 1024 / sizeof(slot) : 1;
+
+  /**
+   * A singly linked list of free slots.
+   */
+  struct free_list
+  {
+    slot* first = nullptr;
+    std::size_t size = 0;
+  };
+
+  /**
+   * Owns the allocated blocks and keeps the free lists that were given back by threads.
+   */
+  class shared_pool
+  {
+  private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<slot[]>> m_blocks;
+    std::vector<free_list> m_free_lists;
+
+  public:
+    /**
+     * Returns a list of free slots, allocating a new block if none is available.
+     */
+    free_list acquire()
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (!m_free_lists.empty())
+      {
+        const auto result = m_free_lists.back();
+        m_free_lists.pop_back();
+        return result;
+      }
+
+      auto block = std::make_unique<slot[]>(batch_size);
+      for (std::size_t i = 0; i < batch_size - 1; ++i)
+      {
+        block[i].next = &block[i + 1];
+      }
+      block[batch_size - 1].next = nullptr;
+
+      const auto result = free_list{block.get(), batch_size};
+      m_blocks.push_back(std::move(block));
+      return result;
+    }
+
+    /**
+     * Takes back the given list of free slots.
+     */
+    void release(const free_list list)
+    {
+      assert(list.first != nullptr);
+
+      const auto lock = std::lock_guard{m_mutex};
+      m_free_lists.push_back(list);
+    }
+  };
+
+  /**
+   * A thread's free list.
+   */
+  class local_pool
+  {
+  private:
+    shared_pool& m_shared;
+    free_list m_free;
+
+  public:
+    explicit local_pool(shared_pool& shared)
+      : m_shared{shared}
+    {
+    }
+
+    ~local_pool()
+    {
+      if (m_free.first)
+      {
+        m_shared.release(m_free);
+      }
+    }
+
+    local_pool(const local_pool&) = delete;
+    local_pool& operator=(const local_pool&) = delete;
+
+    void* allocate()
+    {
+      if (!m_free.first)
+      {
+        m_free = m_shared.acquire();
+      }
+
+      auto* result = m_free.first;
+      m_free.first = result->next;
+      --m_free.size;
+      return result;
+    }
+
+    void deallocate(void* ptr)
+    {
+      auto* freed = static_cast<slot*>(ptr);
+      freed->next = m_free.first;
+      m_free.first = freed;
+      ++m_free.size;
+
+      if (m_free.size >= 2 * batch_size)
+      {
+        // give a batch back so that it can be used by other threads
+        auto* last = m_free.first;
+        for (std::size_t i = 0; i < batch_size - 1; ++i)
+        {
+          last = last->next;
+        }
+
+        const auto batch = free_list{m_free.first, batch_size};
+        m_free = free_list{last->next, m_free.size - batch_size};
+        last->next = nullptr;
+        m_shared.release(batch);
+      }
+    }
+  };
+
+  static shared_pool& shared()
+  {
+    static auto pool = shared_pool{};
+    return pool;
+  }
+
+  static local_pool& local()
+  {
+    // the shared pool is created first, so it outlives the thread's pool
+    thread_local auto pool = local_pool{shared()};
+    return pool;
+  }
+
+public:
+  /**
+   * Returns memory of the given size and alignment.
+   */
+  static void* allocate() { return local().allocate(); }
+
+  /**
+   * Frees memory that was returned by allocate.
+   */
+  static void deallocate(void* ptr)
+  {
+    if (ptr)
+    {
+      local().deallocate(ptr);
+    }
+  }
+};
+
+} // namespace kdl
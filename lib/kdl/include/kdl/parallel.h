@@ -21,14 +21,20 @@
 #ifndef KDL_PARALLEL_H
 #define KDL_PARALLEL_H
 
+#include "kdl/thread_pool.h"
 #include "kdl/vector_utils.h"
 
 #ifdef _WIN32
 #include <ppl.h>
 #endif
 
+#include <algorithm>
 #include <atomic>
-#include <future> // for std::async
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <utility> // for std::declval
@@ -36,55 +42,234 @@
 
 namespace kdl
 {
+/**
+ * A function that is called with `true` when a thread starts working on a chunk of a call
+ * to parallel_for, and with `false` when the thread has finished the chunk. It is called
+ * on the thread that works on the chunk, and can be used to profile parallel work.
+ */
+using parallel_chunk_observer = void (*)(bool started);
+
+namespace detail
+{
+inline std::atomic<parallel_chunk_observer>& current_parallel_chunk_observer()
+{
+  static auto observer = std::atomic<parallel_chunk_observer>{nullptr};
+  return observer;
+}
+
+/**
+ * Notifies the current parallel chunk observer, if any, while it is alive.
+ */
+class observe_parallel_chunk
+{
+private:
+  parallel_chunk_observer m_observer;
+
+public:
+  observe_parallel_chunk()
+    : m_observer{current_parallel_chunk_observer().load(std::memory_order_relaxed)}
+  {
+    if (m_observer)
+    {
+      m_observer(true);
+    }
+  }
+
+  ~observe_parallel_chunk()
+  {
+    if (m_observer)
+    {
+      m_observer(false);
+    }
+  }
+
+  observe_parallel_chunk(const observe_parallel_chunk&) = delete;
+  observe_parallel_chunk& operator=(const observe_parallel_chunk&) = delete;
+};
+
+template <typename L>
+void run_parallel_chunk(L& lambda, const std::size_t first, const std::size_t last)
+{
+  const auto observer = observe_parallel_chunk{};
+  for (auto i = first; i < last; ++i)
+  {
+    lambda(i);
+  }
+}
+
+inline std::size_t hardware_thread_count()
+{
+  return std::max(
+    static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t(1));
+}
+
+/**
+ * Returns the pool used by parallel_for. The calling thread always takes part in the
+ * work, so the pool has one thread less than the hardware supports.
+ */
+inline thread_pool& parallel_thread_pool()
+{
+  static auto pool = thread_pool{hardware_thread_count() - 1};
+  return pool;
+}
+
+/**
+ * Returns the chunk size to use if none was given. Aims for a few chunks per thread so
+ * that uneven work is balanced between the threads.
+ */
+inline std::size_t default_chunk_size(const std::size_t count)
+{
+  return std::max(count / (hardware_thread_count() * 4), std::size_t(1));
+}
+
+/**
+ * The state shared between the threads that work on one call to parallel_for. Threads
+ * claim chunks of indices until none are left, the thread that completes the last chunk
+ * wakes the calling thread.
+ */
+template <typename L>
+struct parallel_for_state
+{
+  L& lambda;
+  std::size_t count;
+  std::size_t chunk_size;
+  std::size_t chunk_count;
+  std::atomic<std::size_t> next_chunk{0};
+  std::atomic<std::size_t> completed_chunks{0};
+  std::exception_ptr exception;
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  parallel_for_state(L& lambda_, const std::size_t count_, const std::size_t chunk_size_)
+    : lambda{lambda_}
+    , count{count_}
+    , chunk_size{chunk_size_}
+    , chunk_count{(count_ + chunk_size_ - 1) / chunk_size_}
+  {
+  }
+
+  /**
+   * Runs chunks until all chunks have been claimed. Returns only after a chunk has been
+   * completed, so the lambda is not accessed once the caller has been woken up.
+   */
+  void run_chunks()
+  {
+    while (true)
+    {
+      const auto chunk = next_chunk++;
+      if (chunk >= chunk_count)
+      {
+        return;
+      }
+
+      try
+      {
+        const auto first = chunk * chunk_size;
+        run_parallel_chunk(lambda, first, std::min(first + chunk_size, count));
+      }
+      catch (...)
+      {
+        const auto lock = std::lock_guard{mutex};
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+
+      if (++completed_chunks == chunk_count)
+      {
+        const auto lock = std::lock_guard{mutex};
+        condition.notify_all();
+      }
+    }
+  }
+
+  void wait()
+  {
+    auto lock = std::unique_lock{mutex};
+    condition.wait(lock, [&]() { return completed_chunks == chunk_count; });
+  }
+};
+} // namespace detail
+
+/**
+ * Sets the function that is notified whenever a thread starts or finishes working on a
+ * chunk of a call to parallel_for. Pass nullptr to remove the observer.
+ */
+inline void set_parallel_chunk_observer(const parallel_chunk_observer observer)
+{
+  detail::current_parallel_chunk_observer() = observer;
+}
+
 /**
  * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
  *
- * Lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
+ * The indices are split into consecutive chunks of `chunk_size` indices, and the chunks
+ * are processed in parallel by the calling thread and the threads of a persistent thread
+ * pool, using the number of threads returned by std::thread::hardware_concurrency(). Idle
+ * threads keep claiming the next unprocessed chunk, so uneven work is balanced between
+ * the threads. On Windows, the chunks are run using the parallel patterns library.
+ *
+ * Since the threads are reused, the overhead per call is small, but the lambda should
+ * still do enough work per chunk to make up for the synchronization. Pass a larger chunk
+ * size if the work per index is very small. Nested calls are allowed.
  *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * If the lambda throws, the first exception is rethrown in the calling thread once no
+ * other thread is working on the call anymore. Indices that have not been processed when
+ * the exception is thrown may be skipped.
  *
  * @tparam L type of lambda
  * @param count the maximum value (exclusive) to pass to lambda
  * @param lambda the lambda to run
+ * @param chunk_size the number of consecutive indices processed by a thread at once, if
+ * 0, a chunk size is chosen depending on count and the number of threads
  */
 template <class L>
-void parallel_for(const size_t count, L&& lambda)
+void parallel_for(const std::size_t count, L&& lambda, std::size_t chunk_size = 0)
 {
+  if (count == 0)
+  {
+    return;
+  }
+
+  if (chunk_size == 0)
+  {
+    chunk_size = detail::default_chunk_size(count);
+  }
+
 #ifdef _WIN32
-  concurrency::parallel_for<size_t>(0, count, lambda);
+  const auto chunk_count = (count + chunk_size - 1) / chunk_size;
+  concurrency::parallel_for<std::size_t>(0, chunk_count, [&](const std::size_t chunk) {
+    const auto first = chunk * chunk_size;
+    detail::run_parallel_chunk(lambda, first, std::min(first + chunk_size, count));
+  });
 #else
-  size_t numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
-  if (numThreads == 0)
+  auto& pool = detail::parallel_thread_pool();
+  if (chunk_size >= count || pool.size() == 0)
   {
-    numThreads = 1;
+    for (std::size_t first = 0; first < count; first += chunk_size)
+    {
+      detail::run_parallel_chunk(lambda, first, std::min(first + chunk_size, count));
+    }
+    return;
   }
 
-  std::atomic<size_t> nextIndex(0);
-
-  std::vector<std::future<void>> threads;
-  threads.resize(numThreads);
+  // workers may still pick up their task after the call has returned, so the state must
+  // be shared with them
+  auto state = std::make_shared<detail::parallel_for_state<L>>(lambda, count, chunk_size);
 
-  for (size_t i = 0; i < numThreads; ++i)
+  const auto helper_count = std::min(pool.size(), state->chunk_count - 1);
+  for (std::size_t i = 0; i < helper_count; ++i)
   {
-    threads[i] = std::async(std::launch::async, [&]() {
-      while (true)
-      {
-        const size_t ourIndex = std::atomic_fetch_add(&nextIndex, static_cast<size_t>(1));
-        if (ourIndex >= count)
-        {
-          break;
-        }
-        lambda(ourIndex);
-      }
-    });
+    pool.submit([state]() { state->run_chunks(); });
   }
 
-  for (size_t i = 0; i < numThreads; ++i)
+  state->run_chunks();
+  state->wait();
+
+  if (state->exception)
   {
-    threads[i].wait();
+    std::rethrow_exception(state->exception);
   }
 #endif
 }
@@ -93,30 +278,29 @@ void parallel_for(const size_t count, L&& lambda)
  * Applies the given lambda to each element of the input (passing elements as rvalue
  * references), and returns a vector of the resulting values, in their original order.
  *
- * The lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
- *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * The lambda is executed in parallel using parallel_for, see there for details.
  *
  * @tparam T the type of the vector elements
  * @tparam L the type of the lambda to apply
  * @param input the vector
  * @param transform the lambda to apply, must be of type `auto(T&&)`
+ * @param chunk_size the number of consecutive elements transformed by a thread at once,
+ * if 0, a chunk size is chosen depending on the number of elements
  * @return a vector containing the transformed values
  */
 template <class T, class L>
-auto vec_parallel_transform(std::vector<T> input, L&& transform)
+auto vec_parallel_transform(
+  std::vector<T> input, L&& transform, const std::size_t chunk_size = 0)
 {
   using ResultType = std::optional<decltype(transform(std::declval<T&&>()))>;
 
   std::vector<ResultType> result;
   result.resize(input.size());
 
-  parallel_for(input.size(), [&](const size_t index) {
-    result[index] = transform(std::move(input[index]));
-  });
+  parallel_for(
+    input.size(),
+    [&](const size_t index) { result[index] = transform(std::move(input[index])); },
+    chunk_size);
 
   return vec_transform(std::move(result), [](ResultType&& x) { return std::move(*x); });
 }
@@ -22,7 +22,7 @@
 
 #include "collection_utils.h"
 
-#include <algorithm> // for std::sort, std::unique, std::lower_bound, std::upper_bound
+#include <algorithm> // for std::sort, std::unique, std::inplace_merge, std::lower_bound
 #include <cassert>
 #include <functional> // for std::less
 #include <iterator>   // for std::distance
@@ -671,6 +671,12 @@ public:
    * increased by one if the by the number of unique values in the given range which were
    not present in this set
 
+   * The values are appended to the underlying vector, sorted and then merged with the
+   * values already present, so that inserting m values into a set of n values takes
+   * O(m log m + n) comparisons instead of O(m * n) moves. If a value is equivalent to a
+   * value that was already present or that precedes it in the given range, it is
+   * discarded, just like when inserting the values one by one.
+   *
    * @tparam I the iterator type
    * @param first the beginning of the range of values to insert
    * @param last the end of the range of values to insert (past-the-end iterator)
@@ -678,11 +684,23 @@ public:
   template <typename I>
   void insert(I first, I last)
   {
-    while (first != last)
+    const auto oldSize = static_cast<difference_type>(m_data.size());
+    m_data.insert(std::end(m_data), first, last);
+
+    const auto mid = std::next(std::begin(m_data), oldSize);
+    if (!std::is_sorted(mid, std::end(m_data), m_cmp))
     {
-      do_insert(*first);
-      ++first;
+      std::stable_sort(mid, std::end(m_data), m_cmp);
     }
+    std::inplace_merge(std::begin(m_data), mid, std::end(m_data), m_cmp);
+
+    // the merge is stable, so the first of several equivalent values is the one that
+    // would have been inserted first
+    const auto eq = [&](const auto& lhs, const auto& rhs) {
+      return !m_cmp(lhs, rhs) && !m_cmp(rhs, lhs);
+    };
+    m_data.erase(
+      std::unique(std::begin(m_data), std::end(m_data), eq), std::end(m_data));
     assert(check_invariant());
   }
 
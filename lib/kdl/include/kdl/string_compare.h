@@ -24,6 +24,8 @@
 
 #include <algorithm> // for std::mismatch, std::sort, std::search, std::equal
 #include <cctype>    // for std::tolower
+#include <cstdint>
+#include <cstring> // for std::memcpy
 #include <string_view>
 
 namespace kdl
@@ -156,6 +158,14 @@ inline bool str_matches_glob(const std::string_view s, const std::string_view p)
 {
   return kdl::str_matches_glob(s, p, char_equal());
 }
+
+/**
+ * A glob pattern that is parsed once so that it can be matched against many strings
+ * efficiently. Characters are compared with case sensitivity.
+ *
+ * @see kdl::glob_matcher
+ */
+using glob_matcher = kdl::glob_matcher<char_equal>;
 } // namespace cs
 
 /**
@@ -188,13 +198,106 @@ struct string_less
   }
 };
 
+namespace detail
+{
+// Strings are compared and hashed eight characters at a time. If all characters of such
+// a word are ASCII characters, their case is folded with a few integer operations,
+// otherwise every character is folded with std::tolower.
+
+constexpr auto word_size = sizeof(std::uint64_t);
+constexpr auto ones = std::uint64_t(0x0101010101010101);
+constexpr auto high_bits = ones * 0x80;
+
+inline std::uint64_t load_word(const char* str, const std::size_t length)
+{
+  auto word = std::uint64_t(0);
+  std::memcpy(&word, str, length);
+  return word;
+}
+
+constexpr std::uint64_t ascii_to_lower(const std::uint64_t word)
+{
+  // the high bit of every byte is set if the byte is >= 'A' or > 'Z', respectively
+  const auto ge_A = word + ones * (0x80 - 'A');
+  const auto gt_Z = word + ones * (0x7F - 'Z');
+  const auto is_upper = ge_A & ~gt_Z & high_bits;
+  return word | (is_upper >> 2);
+}
+
+/**
+ * Loads the given characters (at most word_size) into a word and folds their case.
+ */
+inline std::uint64_t load_folded_word(const char* str, const std::size_t length)
+{
+  const auto word = load_word(str, length);
+  if ((word & high_bits) == 0)
+  {
+    return ascii_to_lower(word);
+  }
+
+  char folded[word_size] = {};
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    const auto c = static_cast<unsigned char>(str[i]);
+    folded[i] = c < 0x80 ? static_cast<char>(ascii_to_lower(c))
+                         : static_cast<char>(std::tolower(c));
+  }
+  return load_word(folded, length);
+}
+
+inline bool is_equal(const char* s1, const char* s2, std::size_t length)
+{
+  for (; length >= word_size; length -= word_size, s1 += word_size, s2 += word_size)
+  {
+    if (
+      load_word(s1, word_size) != load_word(s2, word_size)
+      && load_folded_word(s1, word_size) != load_folded_word(s2, word_size))
+    {
+      return false;
+    }
+  }
+  return length == 0 || load_folded_word(s1, length) == load_folded_word(s2, length);
+}
+
+inline std::size_t hash(const char* str, std::size_t length)
+{
+  const auto mix = [](std::uint64_t h, const std::uint64_t word) {
+    h = (h ^ word) * 0x9E3779B97F4A7C15;
+    return h ^ (h >> 32);
+  };
+
+  auto h = std::uint64_t(0xCBF29CE484222325) ^ length;
+  for (; length >= word_size; length -= word_size, str += word_size)
+  {
+    h = mix(h, load_folded_word(str, word_size));
+  }
+  if (length > 0)
+  {
+    h = mix(h, load_folded_word(str, length));
+  }
+  return static_cast<std::size_t>(h);
+}
+} // namespace detail
+
 struct string_equal
 {
   bool operator()(const std::string_view lhs, const std::string_view rhs) const
   {
-    // std::equal can determine size mismatch when given random access iterators
-    return std::equal(
-      std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), char_equal());
+    return lhs.size() == rhs.size()
+           && detail::is_equal(lhs.data(), rhs.data(), lhs.size());
+  }
+};
+
+/**
+ * Hashes strings without case sensitivity, i.e., strings that are equal according to
+ * string_equal have the same hash. Together with string_equal, this can be used to key
+ * unordered containers by strings without converting them to lower case first.
+ */
+struct string_hash
+{
+  std::size_t operator()(const std::string_view str) const
+  {
+    return detail::hash(str.data(), str.size());
   }
 };
 
@@ -237,7 +340,8 @@ inline bool str_contains(const std::string_view haystack, const std::string_view
 inline bool str_is_prefix(
   const std::string_view& haystack, const std::string_view& needle)
 {
-  return kdl::str_is_prefix(haystack, needle, char_equal());
+  return haystack.size() >= needle.size()
+         && detail::is_equal(haystack.data(), needle.data(), needle.size());
 }
 
 /**
@@ -251,7 +355,11 @@ inline bool str_is_prefix(
 inline bool str_is_suffix(
   const std::string_view& haystack, const std::string_view& needle)
 {
-  return kdl::str_is_suffix(haystack, needle, char_equal());
+  return haystack.size() >= needle.size()
+         && detail::is_equal(
+           haystack.data() + haystack.size() - needle.size(),
+           needle.data(),
+           needle.size());
 }
 
 /**
@@ -278,7 +386,7 @@ inline int str_compare(const std::string_view& s1, const std::string_view& s2)
  */
 inline bool str_is_equal(const std::string_view& s1, const std::string_view& s2)
 {
-  return kdl::str_is_equal(s1, s2, char_equal());
+  return string_equal{}(s1, s2);
 }
 
 /**
@@ -295,5 +403,13 @@ inline bool str_matches_glob(const std::string_view& s, const std::string_view&
 {
   return kdl::str_matches_glob(s, p, char_equal());
 }
+
+/**
+ * A glob pattern that is parsed once so that it can be matched against many strings
+ * efficiently. Characters are compared without case sensitivity.
+ *
+ * @see kdl::glob_matcher
+ */
+using glob_matcher = kdl::glob_matcher<char_equal>;
 } // namespace ci
 } // namespace kdl
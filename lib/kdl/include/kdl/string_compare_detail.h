@@ -23,6 +23,7 @@
 #include "collection_utils.h"
 
 #include <algorithm> // for std::mismatch, std::sort, std::search, std::equal
+#include <string>
 #include <string_view>
 #include <vector> // used in str_matches_glob
 
@@ -304,4 +305,221 @@ bool str_matches_glob(
 
   return false;
 }
+
+/**
+ * A glob pattern that is parsed once and can then be matched against many strings. The
+ * pattern syntax is the same as for `kdl::str_matches_glob`, and so are the results.
+ *
+ * Before the wildcards are matched, the characters preceding the first '*' and following
+ * the last '*' are checked against the start and the end of the string, which rejects
+ * most strings in a filter without any backtracking. Patterns containing "%*" are matched
+ * with `kdl::str_matches_glob` because they cannot be matched greedily.
+ *
+ * @tparam CharEqual the type of the binary predicate used to test characters for equality
+ */
+template <typename CharEqual>
+class glob_matcher
+{
+private:
+  enum class token_type
+  {
+    char_literal,
+    any_char,
+    any_string,
+    digit,
+    digits
+  };
+
+  struct token
+  {
+    token_type type;
+    char c;
+  };
+
+  std::string m_pattern;
+  CharEqual m_char_equal;
+  std::vector<token> m_tokens;
+  bool m_valid = true;
+  bool m_has_digits = false;
+  // the tokens before the first and after the last '*'; if the pattern contains no '*',
+  // then the prefix covers all tokens and the suffix is empty
+  std::size_t m_prefix_length = 0u;
+  std::size_t m_suffix_length = 0u;
+
+public:
+  explicit glob_matcher(std::string pattern, CharEqual char_equal = CharEqual{})
+    : m_pattern{std::move(pattern)}
+    , m_char_equal{std::move(char_equal)}
+  {
+    compile();
+  }
+
+  const std::string& pattern() const { return m_pattern; }
+
+  /**
+   * Checks whether this pattern matches the given string.
+   */
+  bool matches(const std::string_view str) const
+  {
+    if (!m_valid)
+    {
+      return false;
+    }
+
+    if (m_has_digits)
+    {
+      return str_matches_glob(str, m_pattern, m_char_equal);
+    }
+
+    const auto has_wildcard = m_prefix_length < m_tokens.size();
+    if (
+      str.length() < m_prefix_length + m_suffix_length
+      || (!has_wildcard && str.length() != m_prefix_length))
+    {
+      return false;
+    }
+
+    for (std::size_t i = 0u; i < m_prefix_length; ++i)
+    {
+      if (!matches_char(m_tokens[i], str[i]))
+      {
+        return false;
+      }
+    }
+
+    const auto suffix_start = m_tokens.size() - m_suffix_length;
+    const auto str_suffix_start = str.length() - m_suffix_length;
+    for (std::size_t i = 0u; i < m_suffix_length; ++i)
+    {
+      if (!matches_char(m_tokens[suffix_start + i], str[str_suffix_start + i]))
+      {
+        return false;
+      }
+    }
+
+    return !has_wildcard
+           || matches_wildcards(
+             str.substr(m_prefix_length, str_suffix_start - m_prefix_length),
+             m_prefix_length,
+             suffix_start);
+  }
+
+private:
+  void compile()
+  {
+    const auto length = m_pattern.length();
+    for (std::size_t i = 0u; i < length; ++i)
+    {
+      const auto c = m_pattern[i];
+      if (c == '\\' && i < length - 1u)
+      {
+        const auto n = m_pattern[++i];
+        if (n != '*' && n != '?' && n != '%' && n != '\\')
+        {
+          // an invalid escape sequence never matches
+          m_valid = false;
+          return;
+        }
+        m_tokens.push_back({token_type::char_literal, n});
+      }
+      else if (c == '*')
+      {
+        if (m_tokens.empty() || m_tokens.back().type != token_type::any_string)
+        {
+          m_tokens.push_back({token_type::any_string, c});
+        }
+      }
+      else if (c == '?')
+      {
+        m_tokens.push_back({token_type::any_char, c});
+      }
+      else if (c == '%' && i < length - 1u && m_pattern[i + 1u] == '*')
+      {
+        m_tokens.push_back({token_type::digits, c});
+        m_has_digits = true;
+        ++i;
+      }
+      else if (c == '%')
+      {
+        m_tokens.push_back({token_type::digit, c});
+      }
+      else
+      {
+        m_tokens.push_back({token_type::char_literal, c});
+      }
+    }
+
+    const auto is_any_string = [](const auto& t) {
+      return t.type == token_type::any_string;
+    };
+    const auto first_star = std::find_if(m_tokens.begin(), m_tokens.end(), is_any_string);
+    const auto last_star = std::find_if(m_tokens.rbegin(), m_tokens.rend(), is_any_string);
+    m_prefix_length = static_cast<std::size_t>(std::distance(m_tokens.begin(), first_star));
+    m_suffix_length = static_cast<std::size_t>(std::distance(m_tokens.rbegin(), last_star));
+    if (first_star == m_tokens.end())
+    {
+      m_suffix_length = 0u;
+    }
+  }
+
+  bool matches_char(const token& t, const char c) const
+  {
+    switch (t.type)
+    {
+    case token_type::char_literal:
+      return m_char_equal(t.c, c);
+    case token_type::any_char:
+      return true;
+    case token_type::digit:
+      return c >= '0' && c <= '9';
+    case token_type::any_string:
+    case token_type::digits:
+      break;
+    }
+    return false;
+  }
+
+  /**
+   * Matches the tokens in [t_begin, t_end), which start and end with '*', against the
+   * given string. Backtracks to the most recent '*' on a mismatch, which is sufficient
+   * because every other token matches exactly one character.
+   */
+  bool matches_wildcards(
+    const std::string_view str, const std::size_t t_begin, const std::size_t t_end) const
+  {
+    auto s_i = std::size_t{0u};
+    auto t_i = t_begin;
+    auto star_t_i = t_end;
+    auto star_s_i = std::size_t{0u};
+
+    while (s_i < str.length())
+    {
+      if (t_i < t_end && m_tokens[t_i].type == token_type::any_string)
+      {
+        star_t_i = t_i++;
+        star_s_i = s_i;
+      }
+      else if (t_i < t_end && matches_char(m_tokens[t_i], str[s_i]))
+      {
+        ++t_i;
+        ++s_i;
+      }
+      else if (star_t_i != t_end)
+      {
+        t_i = star_t_i + 1u;
+        s_i = ++star_s_i;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    while (t_i < t_end && m_tokens[t_i].type == token_type::any_string)
+    {
+      ++t_i;
+    }
+    return t_i == t_end;
+  }
+};
 } // namespace kdl
@@ -0,0 +1,129 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kdl
+{
+/**
+ * A fixed set of worker threads that execute submitted tasks in the order in which they
+ * were submitted.
+ *
+ * The worker threads are started when the pool is created and are kept alive until the
+ * pool is destroyed, so submitting a task does not incur the cost of creating a thread.
+ * The destructor waits for all pending tasks to finish.
+ */
+class thread_pool
+{
+private:
+  std::vector<std::thread> m_threads;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stopping = false;
+
+public:
+  /**
+   * Creates a pool with the given number of worker threads. A pool without any worker
+   * threads runs every task in the submitting thread.
+   */
+  explicit thread_pool(const std::size_t num_threads)
+  {
+    m_threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+      m_threads.emplace_back([&]() { run_tasks(); });
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Returns the number of worker threads.
+   */
+  std::size_t size() const { return m_threads.size(); }
+
+  /**
+   * Submits the given task to be executed by one of the worker threads.
+   *
+   * The task must not throw.
+   */
+  void submit(std::function<void()> task)
+  {
+    if (m_threads.empty())
+    {
+      task();
+      return;
+    }
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+  }
+
+private:
+  void run_tasks()
+  {
+    while (true)
+    {
+      auto task = std::function<void()>{};
+      {
+        auto lock = std::unique_lock{m_mutex};
+        m_condition.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+        if (m_tasks.empty())
+        {
+          return;
+        }
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+};
+
+} // namespace kdl
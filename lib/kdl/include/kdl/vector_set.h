@@ -164,6 +164,22 @@ public:
   {
   }
 
+  /**
+   * Creates a vector set that takes ownership of the given vector and sorts it in place.
+   * Building a set this way is much cheaper than inserting its values one by one: collect
+   * the values in a vector, reserving capacity up front if the number of values is known,
+   * and move the vector into a set once it is complete.
+   *
+   * @param vec the vector
+   * @param cmp the comparator to use, defaults to a newly created instance of Compare
+   */
+  vector_set(std::vector<T, Allocator>&& vec, const Compare& cmp = Compare())
+    : base(std::move(vec), cmp)
+  {
+    detail::sort_unique(m_data, m_cmp);
+    assert(check_invariant());
+  }
+
   /**
    * Creates a vector set containing the values in the given initializer list.
    *
@@ -222,7 +238,7 @@ public:
    */
   vector_set& operator=(std::vector<typename base::value_type> values)
   {
-    m_data = values;
+    m_data = std::move(values);
     detail::sort_unique(m_data, m_cmp);
     return *this;
   }
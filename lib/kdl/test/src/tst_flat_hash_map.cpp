@@ -0,0 +1,197 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/flat_hash_map.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl
+{
+namespace
+{
+// all values collide so that probe sequences wrap around
+struct constant_hash
+{
+  std::size_t operator()(const int&) const { return 7u; }
+};
+
+template <typename M>
+std::map<typename M::key_type, typename M::mapped_type> to_map(const M& m)
+{
+  return {m.begin(), m.end()};
+}
+
+template <typename S>
+std::set<typename S::key_type> to_set(const S& s)
+{
+  return {s.begin(), s.end()};
+}
+} // namespace
+
+TEST_CASE("flat_hash_map")
+{
+  auto m = flat_hash_map<int, std::string>{};
+  CHECK(m.empty());
+  CHECK(m.find(1) == m.end());
+  CHECK(m.count(1) == 0u);
+  CHECK_THROWS_AS(m.at(1), std::out_of_range);
+
+  SECTION("insert")
+  {
+    CHECK(m.insert({1, "a"}).second);
+    CHECK(m.insert({2, "b"}).second);
+    CHECK_FALSE(m.insert({1, "c"}).second);
+
+    CHECK(m.size() == 2u);
+    CHECK(m.at(1) == "a");
+    CHECK(m.find(2)->second == "b");
+    CHECK(to_map(m) == std::map<int, std::string>{{1, "a"}, {2, "b"}});
+  }
+
+  SECTION("operator[]")
+  {
+    m[1] = "a";
+    m[1] += "b";
+    CHECK(m[2].empty());
+    CHECK(to_map(m) == std::map<int, std::string>{{1, "ab"}, {2, ""}});
+  }
+
+  SECTION("try_emplace")
+  {
+    CHECK(m.try_emplace(1, 3u, 'x').second);
+    CHECK_FALSE(m.try_emplace(1, "y").second);
+    CHECK(m.at(1) == "xxx");
+  }
+
+  SECTION("erase")
+  {
+    m[1] = "a";
+    m[2] = "b";
+    m[3] = "c";
+
+    CHECK(m.erase(2) == 1u);
+    CHECK(m.erase(2) == 0u);
+    m.erase(m.find(3));
+
+    CHECK(to_map(m) == std::map<int, std::string>{{1, "a"}});
+  }
+
+  SECTION("clear")
+  {
+    m[1] = "a";
+    m.clear();
+    CHECK(m.empty());
+    CHECK(m.begin() == m.end());
+    CHECK(m.find(1) == m.end());
+  }
+
+  SECTION("move only values")
+  {
+    auto p = flat_hash_map<int, std::unique_ptr<int>>{};
+    p[1] = std::make_unique<int>(1);
+    p.try_emplace(2, std::make_unique<int>(2));
+    p.reserve(100u);
+    CHECK(*p.at(1) == 1);
+    CHECK(*p.at(2) == 2);
+  }
+}
+
+TEST_CASE("flat_hash_map.colliding_keys")
+{
+  auto m = flat_hash_map<int, int, constant_hash>{};
+  for (int i = 0; i < 6; ++i)
+  {
+    m[i] = i * 10;
+  }
+
+  // removing from the middle of a probe sequence keeps the remaining keys reachable
+  CHECK(m.erase(2) == 1u);
+  CHECK(m.erase(0) == 1u);
+  CHECK(to_map(m) == std::map<int, int>{{1, 10}, {3, 30}, {4, 40}, {5, 50}});
+  for (const auto i : {1, 3, 4, 5})
+  {
+    CHECK(m.at(i) == i * 10);
+  }
+}
+
+TEST_CASE("flat_hash_map.random_operations")
+{
+  // compare against std::map with many insertions and removals
+  auto m = flat_hash_map<int, int>{};
+  auto expected = std::map<int, int>{};
+
+  auto rng = std::mt19937{0};
+  auto dist = std::uniform_int_distribution<int>{0, 999};
+  for (int i = 0; i < 20000; ++i)
+  {
+    const auto key = dist(rng);
+    if (i % 3 == 0)
+    {
+      CHECK(m.erase(key) == expected.erase(key));
+    }
+    else
+    {
+      m[key] = i;
+      expected[key] = i;
+    }
+  }
+
+  CHECK(m.size() == expected.size());
+  CHECK(to_map(m) == expected);
+}
+
+TEST_CASE("flat_hash_set")
+{
+  auto s = flat_hash_set<const int*>{};
+  const auto values = std::vector<int>(100);
+
+  for (const auto& v : values)
+  {
+    CHECK(s.insert(&v).second);
+  }
+  CHECK_FALSE(s.insert(&values[0]).second);
+  CHECK(s.size() == values.size());
+
+  for (size_t i = 0; i < values.size(); i += 2)
+  {
+    CHECK(s.erase(&values[i]) == 1u);
+  }
+
+  auto expected = std::set<const int*>{};
+  for (size_t i = 1; i < values.size(); i += 2)
+  {
+    expected.insert(&values[i]);
+  }
+  CHECK(to_set(s) == expected);
+
+  const auto copy = s;
+  CHECK(to_set(copy) == expected);
+  CHECK(copy.count(&values[1]) == 1u);
+  CHECK(copy.count(&values[0]) == 0u);
+}
+} // namespace kdl
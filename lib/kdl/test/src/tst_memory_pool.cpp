@@ -0,0 +1,92 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/memory_pool.h"
+#include "kdl/parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl
+{
+namespace
+{
+struct alignas(32) aligned_data
+{
+  char data[40];
+};
+
+using test_pool = memory_pool<sizeof(aligned_data), alignof(aligned_data)>;
+} // namespace
+
+TEST_CASE("memory_pool")
+{
+  SECTION("allocates distinct aligned memory")
+  {
+    auto ptrs = std::vector<void*>{};
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+      auto* ptr = test_pool::allocate();
+      CHECK(reinterpret_cast<std::uintptr_t>(ptr) % alignof(aligned_data) == 0u);
+      ptrs.push_back(ptr);
+    }
+
+    CHECK(std::set<void*>{ptrs.begin(), ptrs.end()}.size() == ptrs.size());
+
+    for (auto* ptr : ptrs)
+    {
+      test_pool::deallocate(ptr);
+    }
+  }
+
+  SECTION("reuses freed memory")
+  {
+    auto* ptr = test_pool::allocate();
+    test_pool::deallocate(ptr);
+    CHECK(test_pool::allocate() == ptr);
+    test_pool::deallocate(ptr);
+  }
+
+  SECTION("memory can be freed in other threads")
+  {
+    auto ptrs = std::vector<void*>(10'000);
+    std::generate(ptrs.begin(), ptrs.end(), []() { return test_pool::allocate(); });
+
+    parallel_for(ptrs.size(), [&](const size_t i) { test_pool::deallocate(ptrs[i]); });
+
+    std::generate(ptrs.begin(), ptrs.end(), []() { return test_pool::allocate(); });
+    CHECK(std::set<void*>{ptrs.begin(), ptrs.end()}.size() == ptrs.size());
+
+    for (auto* ptr : ptrs)
+    {
+      test_pool::deallocate(ptr);
+    }
+  }
+
+  SECTION("deallocating nullptr does nothing")
+  {
+    test_pool::deallocate(nullptr);
+  }
+}
+} // namespace kdl
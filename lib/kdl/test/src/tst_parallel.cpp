@@ -26,6 +26,7 @@
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -73,6 +74,97 @@ TEST_CASE("for 10000")
   }
 }
 
+TEST_CASE("for with chunk size")
+{
+  constexpr size_t TestSize = 1'000;
+
+  const auto chunkSizes = std::vector<size_t>{1, 7, 100, TestSize, 2'000};
+  for (const auto chunkSize : chunkSizes)
+  {
+    std::array<std::atomic<size_t>, TestSize> counts;
+    for (size_t i = 0; i < TestSize; ++i)
+    {
+      counts[i] = 0;
+    }
+
+    kdl::parallel_for(
+      TestSize,
+      [&](const size_t i) { std::atomic_fetch_add(&counts[i], static_cast<size_t>(1)); },
+      chunkSize);
+
+    for (size_t i = 0; i < TestSize; ++i)
+    {
+      CHECK(counts[i] == 1u);
+    }
+  }
+}
+
+TEST_CASE("nested for")
+{
+  constexpr size_t OuterSize = 100;
+  constexpr size_t InnerSize = 100;
+
+  auto counter = std::atomic<size_t>{0};
+  kdl::parallel_for(
+    OuterSize,
+    [&](const size_t) {
+      kdl::parallel_for(
+        InnerSize,
+        [&](const size_t) { std::atomic_fetch_add(&counter, static_cast<size_t>(1)); },
+        10);
+    },
+    1);
+
+  CHECK(counter == OuterSize * InnerSize);
+}
+
+TEST_CASE("for rethrows exceptions")
+{
+  constexpr size_t TestSize = 1'000;
+
+  CHECK_THROWS_AS(
+    kdl::parallel_for(
+      TestSize,
+      [&](const size_t i) {
+        if (i == 500)
+        {
+          throw std::runtime_error{"error"};
+        }
+      },
+      10),
+    std::runtime_error);
+}
+
+namespace
+{
+std::atomic<size_t> startedChunks{0};
+std::atomic<size_t> finishedChunks{0};
+
+void countChunks(const bool started)
+{
+  ++(started ? startedChunks : finishedChunks);
+}
+} // namespace
+
+TEST_CASE("for notifies chunk observer")
+{
+  constexpr size_t TestSize = 1'000;
+
+  startedChunks = 0;
+  finishedChunks = 0;
+
+  kdl::set_parallel_chunk_observer(countChunks);
+  kdl::parallel_for(TestSize, [](const size_t) {}, 10);
+  kdl::parallel_for(TestSize, [](const size_t) {}, TestSize);
+  kdl::set_parallel_chunk_observer(nullptr);
+
+  CHECK(startedChunks == 101u);
+  CHECK(finishedChunks == 101u);
+
+  kdl::parallel_for(TestSize, [](const size_t) {}, 10);
+  CHECK(startedChunks == 101u);
+}
+
 TEST_CASE("transform")
 {
   const auto L = [](const int& v) { return v * 10; };
@@ -99,6 +191,23 @@ TEST_CASE("transform_many")
         }));
 }
 
+TEST_CASE("transform with chunk size")
+{
+  std::vector<int> input;
+  std::vector<std::string> expected;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    input.push_back(i);
+    expected.push_back(std::to_string(i));
+  }
+
+  CHECK(
+    expected
+    == kdl::vec_parallel_transform(
+      input, [](int i) { return std::to_string(i); }, 64));
+}
+
 TEST_CASE("overhead for small work batches")
 {
   constexpr size_t OuterLoop = 1'000;
@@ -25,8 +25,11 @@
 #include "kdl/result_fold.h"
 #include "kdl/result_io.h"
 
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -1620,4 +1623,103 @@ TEST_CASE("void_result.fold_results")
       == result<void, std::string>{"error"});
   }
 }
+
+TEST_CASE("result_test.trivially_movable")
+{
+  enum class ErrorCode
+  {
+    Error
+  };
+
+  // a result of trivial types can be passed around like a plain value
+  static_assert(std::is_trivially_copy_constructible_v<result<int, ErrorCode>>);
+  static_assert(std::is_trivially_move_constructible_v<result<int, ErrorCode>>);
+  static_assert(std::is_trivially_move_assignable_v<result<int, ErrorCode>>);
+  static_assert(std::is_trivially_destructible_v<result<int, ErrorCode>>);
+  static_assert(std::is_trivially_move_constructible_v<result<void, ErrorCode>>);
+
+  static_assert(std::is_nothrow_move_constructible_v<result<std::string, std::string>>);
+}
+
+namespace
+{
+enum class ErrorCode
+{
+  Odd
+};
+
+std::string formatError(const ErrorCode)
+{
+  return "value is odd";
+}
+
+result<int, ErrorCode> makeResultWithErrorCode(const int i)
+{
+  if (i % 2 == 0)
+  {
+    return i;
+  }
+  return ErrorCode::Odd;
+}
+
+result<int, std::string> makeResultWithErrorMessage(const int i)
+{
+  if (i % 2 == 0)
+  {
+    return i;
+  }
+  return std::string{"value is odd: "} + std::to_string(i);
+}
+} // namespace
+
+TEST_CASE("result_test.performance")
+{
+  constexpr auto Count = size_t(1'000'000);
+
+  auto values = std::vector<int>{};
+  values.reserve(Count);
+
+  auto errors = size_t(0);
+  const auto startTime = std::chrono::high_resolution_clock::now();
+
+  SECTION("error codes")
+  {
+    for (size_t i = 0; i < Count; ++i)
+    {
+      makeResultWithErrorCode(int(i))
+        .transform([&](const int value) { values.push_back(value); })
+        .transform_error([&](const ErrorCode) { ++errors; });
+    }
+
+    // the message is only formatted when it is actually needed
+    CHECK(formatError(ErrorCode::Odd) == "value is odd");
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << "error codes took "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                   endTime - startTime)
+                   .count()
+              << "us\n";
+  }
+
+  SECTION("error messages")
+  {
+    for (size_t i = 0; i < Count; ++i)
+    {
+      makeResultWithErrorMessage(int(i))
+        .transform([&](const int value) { values.push_back(value); })
+        .transform_error([&](const std::string&) { ++errors; });
+    }
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << "error messages took "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                   endTime - startTime)
+                   .count()
+              << "us\n";
+  }
+
+  CHECK(values.size() == Count / 2);
+  CHECK(errors == Count / 2);
+}
 } // namespace kdl
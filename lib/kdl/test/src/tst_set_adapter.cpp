@@ -20,6 +20,7 @@
 
 #include "kdl/set_adapter.h"
 
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -350,6 +351,26 @@ TEST_CASE("set_adapter_test.insert_with_range")
   s.insert(std::begin(r), std::end(r));
 
   CHECK_THAT(v, Catch::Equals(std::vector<int>{1, 2, 3, 4}));
+
+  const auto r2 = std::vector<int>{6, 0, 3, 5};
+  s.insert(std::begin(r2), std::end(r2));
+
+  CHECK_THAT(v, Catch::Equals(std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+}
+
+TEST_CASE("set_adapter_test.insert_with_range_keeps_first_equivalent_value")
+{
+  using P = std::pair<int, char>;
+  const auto cmp = [](const P& lhs, const P& rhs) { return lhs.first < rhs.first; };
+
+  auto v = std::vector<P>{{1, 'a'}, {3, 'a'}};
+  auto s = wrap_set(v, cmp);
+
+  const auto r = std::vector<P>{{3, 'b'}, {2, 'b'}, {2, 'c'}, {4, 'b'}};
+  s.insert(std::begin(r), std::end(r));
+
+  CHECK_THAT(
+    v, Catch::Equals(std::vector<P>{{1, 'a'}, {2, 'b'}, {3, 'a'}, {4, 'b'}}));
 }
 
 TEST_CASE("set_adapter_test.insert_with_range_and_count")
@@ -21,6 +21,9 @@
 #include "kdl/collection_utils.h"
 #include "kdl/string_compare.h"
 
+#include <string>
+#include <tuple>
+
 #include <catch2/catch.hpp>
 
 namespace kdl
@@ -173,6 +176,67 @@ TEST_CASE("string_utils_cs_test.str_matches_glob")
   CHECK(str_matches_glob("34dkadj%773", "*\\%%*"));
 }
 
+TEST_CASE("string_utils_cs_test.glob_matcher")
+{
+  using T = std::tuple<std::string, std::string, bool>;
+
+  // clang-format off
+  const auto
+  [str,                pattern,                      expectedResult] = GENERATE(values<T>({
+  {"",                 "",                           true},
+  {"",                 "*",                          true},
+  {"",                 "**",                         true},
+  {"",                 "?",                          false},
+  {"asdf",             "",                           false},
+  {"asdf",             "asdf",                       true},
+  {"asdf",             "asd",                        false},
+  {"asdf",             "*",                          true},
+  {"asdf",             "a??f",                       true},
+  {"asdf",             "a?f",                        false},
+  {"asdf",             "*f",                         true},
+  {"asdf",             "a*f",                        true},
+  {"asdf",             "a*df",                       true},
+  {"asdf",             "as*sdf",                     false},
+  {"asdf",             "?s?f",                       true},
+  {"asdfjkl",          "a*f*l",                      true},
+  {"asdfjkl",          "*a*f*l*",                    true},
+  {"asdfjkl",          "a*d*d*l",                    false},
+  {"abcbcd",           "a*bcd",                      true},
+  {"asd*fjkl",         "*a*f*l*",                    true},
+  {"asd*fjkl",         "asd\\*fjkl",                 true},
+  {"asdxfjkl",         "asd\\*fjkl",                 false},
+  {"asd*?fj\\kl",      "asd\\*\\?fj\\\\kl",          true},
+  {"asdf",             "as\\df",                     false},
+  {"as\\",             "as\\",                       true},
+  {"asdf",             "*F",                         false},
+  {"asdF",             "a*f",                        false},
+  {"ASDF",             "?S?f",                       false},
+  {"classname",        "*_color",                    false},
+  {"",                 "%",                          false},
+  {"",                 "%*",                         true},
+  {"0",                "%",                          true},
+  {"9",                "%",                          true},
+  {"99",               "%",                          false},
+  {"a",                "%",                          false},
+  {"3Z",               "%*",                         false},
+  {"Zasdf",            "*%",                         false},
+  {"Zasdf3",           "*%",                         true},
+  {"Zasdf33",          "Z*%%",                       true},
+  {"Zasdf3376",        "Z*%*",                       true},
+  {"Zasdf3376bdc",     "Zasdf%*",                    false},
+  {"Zasdf3376bdc",     "Z*%*bdc",                    true},
+  {"78777Zasdf3376bdc","%*Z*%**",                    true},
+  {"34dkadj%773",      "*\\%%*",                     true},
+  }));
+  // clang-format on
+
+  CAPTURE(str, pattern);
+
+  const auto matcher = glob_matcher{pattern};
+  CHECK(matcher.matches(str) == expectedResult);
+  CHECK(str_matches_glob(str, pattern) == expectedResult);
+}
+
 template <typename C>
 C sorted(C c)
 {
@@ -268,6 +332,9 @@ TEST_CASE("string_utils_ci_test.str_is_prefix")
   CHECK(str_is_prefix("asdf", "asDF"));
   CHECK_FALSE(str_is_prefix("asdf", "aAsdf"));
   CHECK_FALSE(str_is_prefix("asdf", "DF"));
+
+  CHECK(str_is_prefix("textures/base_wall/metal", "TEXTURES/Base_Wall"));
+  CHECK_FALSE(str_is_prefix("textures/base_wall/metal", "textures/base_floor"));
 }
 
 TEST_CASE("string_utils_ci_test.str_is_suffix")
@@ -286,6 +353,9 @@ TEST_CASE("string_utils_ci_test.str_is_suffix")
   CHECK(str_is_suffix("asdf", "Df"));
   CHECK(str_is_suffix("asdf", "Sdf"));
   CHECK(str_is_suffix("asdf", "ASDf"));
+
+  CHECK(str_is_suffix("textures/base_wall/metal", "BASE_WALL/Metal"));
+  CHECK_FALSE(str_is_suffix("textures/base_wall/metal", "base_wall/metal2"));
 }
 
 TEST_CASE("string_utils_ci_test.str_compare")
@@ -309,6 +379,30 @@ TEST_CASE("string_utils_ci_test.str_is_equal")
   CHECK(str_is_equal("AsdF", "Asdf"));
   CHECK_FALSE(str_is_equal("asdff", "asdF"));
   CHECK_FALSE(str_is_equal("dfdd", "Asdf"));
+
+  CHECK(str_is_equal("textures/base_wall/metal", "Textures/BASE_WALL/metal"));
+  CHECK_FALSE(str_is_equal("textures/base_wall/metal", "textures/base_wall/metaL2"));
+  CHECK_FALSE(str_is_equal("textures/base_wall/metal", "textures/base_wall/metam"));
+
+  // characters adjacent to the ASCII letters are not folded
+  CHECK_FALSE(str_is_equal("@[`{", "`{@["));
+  CHECK(str_is_equal("AZaz@[`{", "azAZ@[`{"));
+
+  // non-ASCII characters are compared byte by byte
+  CHECK(str_is_equal("m\xC3\xA9tal_wall", "M\xC3\xA9TAL_WALL"));
+  CHECK_FALSE(str_is_equal("m\xC3\xA9tal_wall", "m\xC3\x89tal_wall"));
+}
+
+TEST_CASE("string_utils_ci_test.string_hash")
+{
+  const auto hash = string_hash{};
+  CHECK(hash("") == hash(""));
+  CHECK(hash("asdf") == hash("ASDF"));
+  CHECK(hash("textures/base_wall/metal") == hash("Textures/BASE_WALL/metal"));
+  CHECK(hash("m\xC3\xA9tal_wall") == hash("M\xC3\xA9TAL_WALL"));
+
+  CHECK(hash("asdf") != hash("asdg"));
+  CHECK(hash("textures/base_wall/metal") != hash("textures/base_wall/metal2"));
 }
 
 TEST_CASE("string_utils_ci_test.str_matches_glob")
@@ -327,6 +421,17 @@ TEST_CASE("string_utils_ci_test.str_matches_glob")
   CHECK(str_matches_glob("aSD*?fJ\\kL", "asd\\*\\?fj\\\\kl"));
 }
 
+TEST_CASE("string_utils_ci_test.glob_matcher")
+{
+  CHECK(glob_matcher{"asdf"}.matches("ASdf"));
+  CHECK(glob_matcher{"a??f"}.matches("ASdf"));
+  CHECK_FALSE(glob_matcher{"a?f"}.matches("AsDF"));
+  CHECK(glob_matcher{"a*f"}.matches("aSDF"));
+  CHECK(glob_matcher{"*a*f*l*"}.matches("AsDfjkl"));
+  CHECK(glob_matcher{"asd\\*\\?fj\\\\kl"}.matches("aSD*?fJ\\kL"));
+  CHECK_FALSE(glob_matcher{"asd\\*fjkl"}.matches("ASdxfjKl"));
+}
+
 template <typename C>
 C sorted(C c)
 {
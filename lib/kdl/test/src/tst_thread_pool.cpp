@@ -0,0 +1,82 @@
+/*
+ Copyright 2023 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/thread_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl
+{
+TEST_CASE("thread_pool")
+{
+  SECTION("runs all submitted tasks")
+  {
+    auto counter = std::atomic<size_t>{0};
+    {
+      auto pool = thread_pool{3};
+      CHECK(pool.size() == 3u);
+
+      for (size_t i = 0; i < 1000; ++i)
+      {
+        pool.submit([&]() { std::atomic_fetch_add(&counter, static_cast<size_t>(1)); });
+      }
+    }
+    // the destructor waits for pending tasks
+    CHECK(counter == 1000u);
+  }
+
+  SECTION("runs tasks in worker threads")
+  {
+    auto pool = thread_pool{1};
+
+    auto mutex = std::mutex{};
+    auto condition = std::condition_variable{};
+    auto taskThreadId = std::thread::id{};
+    auto done = false;
+
+    pool.submit([&]() {
+      const auto lock = std::lock_guard{mutex};
+      taskThreadId = std::this_thread::get_id();
+      done = true;
+      condition.notify_all();
+    });
+
+    auto lock = std::unique_lock{mutex};
+    condition.wait(lock, [&]() { return done; });
+    CHECK(taskThreadId != std::this_thread::get_id());
+  }
+
+  SECTION("runs tasks in the submitting thread without workers")
+  {
+    auto pool = thread_pool{0};
+    CHECK(pool.size() == 0u);
+
+    auto taskThreadId = std::thread::id{};
+    pool.submit([&]() { taskThreadId = std::this_thread::get_id(); });
+    CHECK(taskThreadId == std::this_thread::get_id());
+  }
+}
+} // namespace kdl
@@ -130,6 +130,16 @@ TEST_CASE("vector_set_test.constructor_with_vector")
   assertVset(create_vset_from_vector({2, 1, 3, 1, 2}), {1, 2, 3});
 }
 
+TEST_CASE("vector_set_test.constructor_with_moved_vector")
+{
+  auto v = std::vector<int>{2, 1, 3, 1, 2};
+  const auto* data = v.data();
+
+  const auto s = vset{std::move(v)};
+  assertVset(s, {1, 2, 3});
+  CHECK(s.get_data().data() == data);
+}
+
 TEST_CASE("vector_set_test.assignment_from_initializer_list")
 {
   assertVset(vset() = {}, {});
@@ -26,34 +26,60 @@
 
 namespace vm
 {
+/**
+ * Returns the values of the three quadratic Bernstein polynomials at the given parameter.
+ *
+ * When many curves or surfaces are evaluated at the same parameters, such as when a grid
+ * of points is computed, the basis can be computed once per parameter and passed to
+ * evaluate_quadratic_bezier_curve and quadratic_bezier_surface_curve.
+ */
+template <typename T>
+constexpr std::array<T, 3> quadratic_bernstein_basis(const T t)
+{
+  const auto s = static_cast<T>(1) - t;
+  return {s * s, static_cast<T>(2) * s * t, t * t};
+}
+
+/**
+ * Evaluates the quadratic Bezier curve with the given control points at the parameter for
+ * which the given basis was computed, see quadratic_bernstein_basis.
+ */
 template <typename T, size_t C>
-vec<T, C> evaluate_quadratic_bezier_surface(
-  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints, const T u, const T v)
+constexpr vec<T, C> evaluate_quadratic_bezier_curve(
+  const std::array<vec<T, C>, 3>& controlPoints, const std::array<T, 3>& basis)
 {
-  const auto bernsteinPolynomial_0 = [](const auto x) {
-    return static_cast<T>(1) - static_cast<T>(2) * x + (x * x);
-  };
+  return basis[0] * controlPoints[0] + basis[1] * controlPoints[1]
+         + basis[2] * controlPoints[2];
+}
 
-  const auto bernsteinPolynomial_1 = [](const auto x) {
-    return static_cast<T>(2) * (x - (x * x));
+/**
+ * Returns the control points of the curve that runs through the given quadratic Bezier
+ * surface at the parameter v for which the given basis was computed. Evaluating this
+ * curve at u yields the point of the surface at (u, v).
+ *
+ * To compute a grid of points, the curve only needs to be computed once per row.
+ */
+template <typename T, size_t C>
+constexpr std::array<vec<T, C>, 3> quadratic_bezier_surface_curve(
+  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints,
+  const std::array<T, 3>& vBasis)
+{
+  const auto column = [&](const size_t col) {
+    return evaluate_quadratic_bezier_curve(
+      std::array<vec<T, C>, 3>{
+        controlPoints[0][col], controlPoints[1][col], controlPoints[2][col]},
+      vBasis);
   };
 
-  const auto bernsteinPolynomial_2 = [](const auto x) { return x * x; };
-
-  const auto interpolate = [&](const auto x, const std::array<vec<T, C>, 3>& p) {
-    auto result = vec<T, C>{};
-    result = result + bernsteinPolynomial_0(x) * p[0];
-    result = result + bernsteinPolynomial_1(x) * p[1];
-    result = result + bernsteinPolynomial_2(x) * p[2];
-    return result;
-  };
+  return {column(0), column(1), column(2)};
+}
 
-  return interpolate(
-    v,
-    {
-      interpolate(u, controlPoints[0]),
-      interpolate(u, controlPoints[1]),
-      interpolate(u, controlPoints[2]),
-    });
+template <typename T, size_t C>
+vec<T, C> evaluate_quadratic_bezier_surface(
+  const std::array<std::array<vec<T, C>, 3>, 3>& controlPoints, const T u, const T v)
+{
+  return evaluate_quadratic_bezier_curve(
+    quadratic_bezier_surface_curve(controlPoints, quadratic_bernstein_basis(v)),
+    quadratic_bernstein_basis(u));
 }
 } // namespace vm
@@ -29,6 +29,10 @@
 #include "util.h"
 #include "vec.h"
 
+#include <array>
+#include <limits>
+#include <vector>
+
 namespace vm
 {
 
@@ -308,6 +312,58 @@ constexpr T intersect_ray_triangle(
   return u;
 }
 
+/**
+ * Computes the points of intersection of the given ray and each of the given triangles.
+ *
+ * The i-th triangle is given by the i-th elements of the given point arrays. Every
+ * triangle goes through the same sequence of operations without any branches that depend
+ * on the triangle, which allows the compiler to test several triangles at once using SIMD
+ * instructions.
+ *
+ * @tparam T the component type
+ * @tparam N the number of triangles
+ * @param r the ray
+ * @param p1 the first points of the triangles
+ * @param p2 the second points of the triangles
+ * @param p3 the third points of the triangles
+ * @return the distances to the points of intersection, or NaN for each triangle that the
+ * given ray does not intersect
+ */
+template <typename T, size_t N>
+std::array<T, N> intersect_ray_triangles(
+  const ray<T, 3>& r,
+  const std::array<vec<T, 3>, N>& p1,
+  const std::array<vec<T, 3>, N>& p2,
+  const std::array<vec<T, 3>, N>& p3)
+{
+  const auto& o = r.origin;
+  const auto& d = r.direction;
+  const auto epsilon = constants<T>::almost_zero();
+
+  auto result = std::array<T, N>{};
+  for (size_t i = 0; i < N; ++i)
+  {
+    const auto e1 = p2[i] - p1[i];
+    const auto e2 = p3[i] - p1[i];
+    const auto p = cross(d, e2);
+    const auto a = dot(p, e1);
+    const auto valid = !is_zero(a, epsilon);
+    const auto safeA = valid ? a : T(1);
+
+    const auto t = o - p1[i];
+    const auto q = cross(t, e1);
+
+    const auto u = dot(q, e2) / safeA;
+    const auto v = dot(p, t) / safeA;
+    const auto w = dot(q, d) / safeA;
+
+    const auto hit =
+      valid && u >= -epsilon && v >= -epsilon && w >= -epsilon && v + w - T(1) <= epsilon;
+    result[i] = hit ? u : nan<T>();
+  }
+  return result;
+}
+
 /**
  * Computes the point of intersection of the given ray and the polygon with the given
  * vertices.
@@ -460,6 +516,112 @@ constexpr T intersect_ray_bbox(const ray<T, S>& r, const bbox<T, S>& b)
   return distances[bestPlane];
 }
 
+/**
+ * Computes the points of intersection between the given ray and each of the given
+ * bounding boxes, and returns the distances on the given ray from the ray's origin to
+ * those points.
+ *
+ * The bounding boxes are given in structure-of-arrays form: mins[i][j] and maxs[i][j] are
+ * the i-th components of the minimum and maximum corners of the j-th box.
+ *
+ * The boxes are tested using the slab method. Every box goes through the same sequence of
+ * operations without any branches that depend on the box, which allows the compiler to
+ * test several boxes at once using SIMD instructions.
+ *
+ * If the ray's origin is inside a box, the distance to the point where the ray leaves the
+ * box is returned. Unlike intersect_ray_bbox, this is also the case if some components of
+ * the ray's direction are zero.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @tparam N the number of bounding boxes
+ * @param r the ray
+ * @param mins the minimum corners of the bounding boxes
+ * @param maxs the maximum corners of the bounding boxes
+ * @return the distances to the closest intersection points, or NaN for each bounding box
+ * that the ray does not intersect
+ */
+template <typename T, size_t S, size_t N>
+std::array<T, N> intersect_ray_bboxes(
+  const ray<T, S>& r,
+  const std::array<std::array<T, N>, S>& mins,
+  const std::array<std::array<T, N>, S>& maxs)
+{
+  constexpr auto inf = std::numeric_limits<T>::infinity();
+
+  auto nearDistances = std::array<T, N>{};
+  auto farDistances = std::array<T, N>{};
+  nearDistances.fill(-inf);
+  farDistances.fill(inf);
+
+  for (size_t i = 0; i < S; ++i)
+  {
+    const auto origin = r.origin[i];
+    if (r.direction[i] != T(0))
+    {
+      const auto invDirection = T(1) / r.direction[i];
+      for (size_t j = 0; j < N; ++j)
+      {
+        const auto d1 = (mins[i][j] - origin) * invDirection;
+        const auto d2 = (maxs[i][j] - origin) * invDirection;
+        nearDistances[j] = max(nearDistances[j], min(d1, d2));
+        farDistances[j] = min(farDistances[j], max(d1, d2));
+      }
+    }
+    else
+    {
+      // the ray is parallel to the slab and only hits it if its origin is inside of it
+      for (size_t j = 0; j < N; ++j)
+      {
+        const auto inside = origin >= mins[i][j] && origin <= maxs[i][j];
+        nearDistances[j] = inside ? nearDistances[j] : inf;
+        farDistances[j] = inside ? farDistances[j] : -inf;
+      }
+    }
+  }
+
+  auto result = std::array<T, N>{};
+  for (size_t j = 0; j < N; ++j)
+  {
+    const auto hit = nearDistances[j] <= farDistances[j] && farDistances[j] >= T(0);
+    const auto distance = nearDistances[j] >= T(0) ? nearDistances[j] : farDistances[j];
+    result[j] = hit ? distance : nan<T>();
+  }
+  return result;
+}
+
+/**
+ * Computes the points of intersection between the given ray and each of the given
+ * bounding boxes, and returns the distances on the given ray from the ray's origin to
+ * those points.
+ *
+ * See the structure-of-arrays overload above for details.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @tparam N the number of bounding boxes
+ * @param r the ray
+ * @param boxes the bounding boxes
+ * @return the distances to the closest intersection points, or NaN for each bounding box
+ * that the ray does not intersect
+ */
+template <typename T, size_t S, size_t N>
+std::array<T, N> intersect_ray_bboxes(
+  const ray<T, S>& r, const std::array<bbox<T, S>, N>& boxes)
+{
+  auto mins = std::array<std::array<T, N>, S>{};
+  auto maxs = std::array<std::array<T, N>, S>{};
+  for (size_t i = 0; i < S; ++i)
+  {
+    for (size_t j = 0; j < N; ++j)
+    {
+      mins[i][j] = boxes[j].min[i];
+      maxs[i][j] = boxes[j].max[i];
+    }
+  }
+  return intersect_ray_bboxes(r, mins, maxs);
+}
+
 /**
  * Computes the point of intersection between the given ray and a sphere centered at the
  * given position and with the given radius.
@@ -557,14 +557,18 @@ template <typename T, std::size_t R1, std::size_t C1R2, std::size_t C2>
 constexpr mat<T, R1, C2> operator*(
   const mat<T, R1, C1R2>& lhs, const mat<T, C1R2, C2>& rhs)
 {
+  // Each result column is accumulated as a linear combination of the columns of lhs so
+  // that the innermost loop walks contiguous memory and can be vectorized. The terms of
+  // every element are still summed in the same order.
   auto result = mat<T, R1, C2>::zero();
   for (size_t c = 0; c < C2; c++)
   {
-    for (size_t r = 0; r < R1; r++)
+    for (size_t i = 0; i < C1R2; ++i)
     {
-      for (size_t i = 0; i < C1R2; ++i)
+      const auto factor = rhs[c][i];
+      for (size_t r = 0; r < R1; r++)
       {
-        result[c][r] += lhs[i][r] * rhs[c][i];
+        result[c][r] += lhs[i][r] * factor;
       }
     }
   }
@@ -663,10 +667,11 @@ constexpr vec<T, R> operator*(const vec<T, R>& lhs, const mat<T, R, C>& rhs)
 template <typename T, std::size_t R, std::size_t C>
 constexpr vec<T, R> operator*(const mat<T, R, C>& lhs, const vec<T, C>& rhs)
 {
-  vec<T, C> result;
-  for (size_t r = 0; r < R; r++)
+  // Accumulate column by column so that the innermost loop walks contiguous memory.
+  vec<T, R> result;
+  for (size_t c = 0; c < C; ++c)
   {
-    for (size_t c = 0; c < C; ++c)
+    for (size_t r = 0; r < R; r++)
     {
       result[r] += lhs[c][r] * rhs[c];
     }
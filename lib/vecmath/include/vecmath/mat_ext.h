@@ -79,6 +79,61 @@ constexpr std::array<vec<T, C>, N> operator*(
   return result;
 }
 
+/**
+ * Transforms the points in the given range in place by multiplying them with the given
+ * matrix. Each point is treated as a homogeneous point with a w component of 1.
+ *
+ * The matrix is examined once for the entire range. If its last row is (0, ..., 0, 1),
+ * then the homogeneous coordinates and the final division by w are skipped for every
+ * point. The results are identical to multiplying each point with the matrix
+ * individually.
+ *
+ * @tparam T the component type
+ * @tparam S the number of rows and columns of the matrix
+ * @tparam I the iterator type, must dereference to vec<T, S - 1>
+ * @param transform the matrix
+ * @param first the beginning of the range of points
+ * @param last the end of the range of points
+ */
+template <typename T, std::size_t S, typename I>
+constexpr void transform_points(const mat<T, S, S>& transform, I first, I last)
+{
+  constexpr auto D = S - 1u;
+
+  auto isAffine = transform[D][D] == static_cast<T>(1);
+  for (std::size_t c = 0u; c < D && isAffine; ++c)
+  {
+    isAffine = transform[c][D] == static_cast<T>(0);
+  }
+
+  if (!isAffine)
+  {
+    for (; first != last; ++first)
+    {
+      *first = transform * *first;
+    }
+    return;
+  }
+
+  for (; first != last; ++first)
+  {
+    auto& point = *first;
+    vec<T, D> result;
+    for (std::size_t c = 0u; c < D; ++c)
+    {
+      for (std::size_t r = 0u; r < D; ++r)
+      {
+        result[r] += transform[c][r] * point[c];
+      }
+    }
+    for (std::size_t r = 0u; r < D; ++r)
+    {
+      result[r] += transform[D][r];
+    }
+    point = result;
+  }
+}
+
 /**
  * Multiplies the given list of vectors with the given matrix.
  *
@@ -93,13 +148,22 @@ template <typename T, std::size_t R, std::size_t C>
 std::vector<vec<T, C - 1>> operator*(
   const mat<T, R, C>& lhs, const std::vector<vec<T, C - 1>>& rhs)
 {
-  std::vector<vec<T, C - 1>> result;
-  result.reserve(rhs.size());
-  for (const auto& v : rhs)
+  if constexpr (R == C)
   {
-    result.push_back(lhs * v);
+    auto result = rhs;
+    transform_points(lhs, result.begin(), result.end());
+    return result;
+  }
+  else
+  {
+    std::vector<vec<T, C - 1>> result;
+    result.reserve(rhs.size());
+    for (const auto& v : rhs)
+    {
+      result.push_back(lhs * v);
+    }
+    return result;
   }
-  return result;
 }
 
 /**
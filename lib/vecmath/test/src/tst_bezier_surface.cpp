@@ -18,6 +18,7 @@
  DEALINGS IN THE SOFTWARE.
 */
 
+#include <vecmath/approx.h>
 #include <vecmath/bezier_surface.h>
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
@@ -30,6 +31,56 @@
 
 namespace vm
 {
+TEST_CASE("quadratic_bernstein_basis")
+{
+  CHECK(quadratic_bernstein_basis(0.0) == std::array<double, 3>{1.0, 0.0, 0.0});
+  CHECK(quadratic_bernstein_basis(0.5) == std::array<double, 3>{0.25, 0.5, 0.25});
+  CHECK(quadratic_bernstein_basis(1.0) == std::array<double, 3>{0.0, 0.0, 1.0});
+}
+
+TEST_CASE("evaluate_quadratic_bezier_curve")
+{
+  const auto controlPoints = std::array<vec3d, 3>{
+    vec3d{0, 0, 0},
+    vec3d{1, 2, 0},
+    vec3d{2, 0, 0},
+  };
+
+  CHECK(
+    evaluate_quadratic_bezier_curve(controlPoints, quadratic_bernstein_basis(0.0))
+    == vec3d{0, 0, 0});
+  CHECK(
+    evaluate_quadratic_bezier_curve(controlPoints, quadratic_bernstein_basis(0.5))
+    == vec3d{1, 1, 0});
+  CHECK(
+    evaluate_quadratic_bezier_curve(controlPoints, quadratic_bernstein_basis(1.0))
+    == vec3d{2, 0, 0});
+}
+
+TEST_CASE("quadratic_bezier_surface_curve")
+{
+  // clang-format off
+  const auto controlPoints = std::array<std::array<vm::vec3d, 3>, 3>{
+    std::array<vm::vec3d, 3>{ vec3d{0, 0, 0}, vec3d{1, 0, 1}, vec3d{2, 0, 0} },
+    std::array<vm::vec3d, 3>{ vec3d{0, 1, 1}, vec3d{1, 1, 2}, vec3d{2, 1, 1} },
+    std::array<vm::vec3d, 3>{ vec3d{0, 2, 0}, vec3d{1, 2, 1}, vec3d{2, 2, 0} },
+  };
+  // clang-format on
+
+  for (const auto v : {0.0, 0.25, 0.5, 1.0})
+  {
+    const auto curve =
+      quadratic_bezier_surface_curve(controlPoints, quadratic_bernstein_basis(v));
+    for (const auto u : {0.0, 0.25, 0.5, 1.0})
+    {
+      CAPTURE(u, v);
+      CHECK(
+        evaluate_quadratic_bezier_curve(curve, quadratic_bernstein_basis(u))
+        == approx{evaluate_quadratic_bezier_surface(controlPoints, u, v)});
+    }
+  }
+}
+
 TEST_CASE("evaluate_quadratic_bezier_surface")
 {
   using T = std::tuple<std::array<vec3d, 9>, double, double, vec3d>;
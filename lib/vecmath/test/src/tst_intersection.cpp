@@ -22,15 +22,18 @@
 #include "test_utils.h"
 
 #include <vecmath/approx.h>
+#include <vecmath/bbox_io.h>
 #include <vecmath/constexpr_util.h>
 #include <vecmath/forward.h>
 #include <vecmath/intersection.h>
 #include <vecmath/quat.h>
+#include <vecmath/ray_io.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
 #include <vecmath/vec_io.h>
 
 #include <array>
+#include <vector>
 
 #define CATCH_CONFIG_ENABLE_ALL_STRINGMAKERS 1
 #include <catch2/catch.hpp>
@@ -188,6 +191,44 @@ TEST_CASE("intersection.intersect_ray_triangle")
     == approx(2.0));
 }
 
+TEST_CASE("intersection.intersect_ray_triangles")
+{
+  const auto p1 = std::array<vec3d, 3>{
+    vec3d(2.0, 5.0, 2.0), vec3d(2.0, 5.0, 2.0), vec3d(0.0, 0.0, 0.0)};
+  const auto p2 = std::array<vec3d, 3>{
+    vec3d(4.0, 7.0, 2.0), vec3d(4.0, 7.0, 4.0), vec3d(0.0, 0.0, 0.0)};
+  const auto p3 = std::array<vec3d, 3>{
+    vec3d(3.0, 2.0, 2.0), vec3d(3.0, 2.0, 6.0), vec3d(0.0, 0.0, 0.0)};
+
+  const auto rays = std::vector<ray3d>{
+    ray3d(vec3d::zero(), vec3d::pos_x()),
+    ray3d(vec3d::zero(), vec3d::pos_z()),
+    ray3d(vec3d(3.0, 5.0, 0.0), vec3d::pos_z()),
+    ray3d(vec3d(2.0, 5.0, 0.0), vec3d::pos_z()),
+    ray3d(vec3d(3.0, 5.0, 10.0), vec3d::neg_z()),
+    ray3d(vec3d(0.0, 4.0, 3.0), vec3d::pos_x()),
+  };
+
+  for (const auto& ray : rays)
+  {
+    CAPTURE(ray);
+
+    const auto distances = intersect_ray_triangles(ray, p1, p2, p3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto expected = intersect_ray_triangle(ray, p1[i], p2[i], p3[i]);
+      if (is_nan(expected))
+      {
+        CHECK(is_nan(distances[i]));
+      }
+      else
+      {
+        CHECK(distances[i] == approx(expected));
+      }
+    }
+  }
+}
+
 TEST_CASE("intersection.intersect_ray_square")
 {
   constexpr auto poly = square() + vec3d(0, 0, 1);
@@ -299,6 +340,56 @@ TEST_CASE("intersection.intersect_ray_bbox")
   CHECK(intersect_ray_bbox(ray3f(origin, dir), bounds) == approx(length(diff)));
 }
 
+TEST_CASE("intersection.intersect_ray_bboxes")
+{
+  const auto boxes = std::array<bbox3f, 4>{
+    bbox3f(vec3f(-12.0f, -3.0f, 4.0f), vec3f(8.0f, 9.0f, 8.0f)),
+    bbox3f(vec3f(-1.0f, -1.0f, -1.0f), vec3f(1.0f, 1.0f, 1.0f)),
+    bbox3f(vec3f(2.0f, 2.0f, 2.0f), vec3f(3.0f, 3.0f, 3.0f)),
+    bbox3f(vec3f(-4.0f, -4.0f, -8.0f), vec3f(4.0f, 4.0f, -6.0f)),
+  };
+
+  const auto origin = vec3f(-10.0f, -7.0f, 14.0f);
+  const auto rays = std::vector<ray3f>{
+    ray3f(vec3f::zero(), vec3f::neg_z()),
+    ray3f(vec3f::zero(), vec3f::pos_z()),
+    ray3f(vec3f::zero(), normalize(vec3f(1.0f, 1.0f, 1.0f))),
+    ray3f(vec3f(0.0f, 0.0f, 10.0f), vec3f::neg_z()),
+    ray3f(vec3f(5.0f, 0.0f, 0.0f), vec3f::pos_y()),
+    ray3f(origin, normalize(vec3f(-2.0f, 3.0f, 8.0f) - origin)),
+  };
+
+  for (const auto& ray : rays)
+  {
+    CAPTURE(ray);
+
+    const auto distances = intersect_ray_bboxes(ray, boxes);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+      CAPTURE(boxes[i]);
+
+      // intersect_ray_bbox misses boxes which contain the ray origin if some direction
+      // component is zero
+      if (boxes[i].contains(ray.origin))
+      {
+        CHECK(distances[i] >= 0.0f);
+        CHECK(boxes[i].contains(point_at_distance(ray, distances[i])));
+        continue;
+      }
+
+      const auto expected = intersect_ray_bbox(ray, boxes[i]);
+      if (is_nan(expected))
+      {
+        CHECK(is_nan(distances[i]));
+      }
+      else
+      {
+        CHECK(distances[i] == approx(expected));
+      }
+    }
+  }
+}
+
 TEST_CASE("intersection.intersect_ray_sphere")
 {
   const ray3f ray(vec3f::zero(), vec3f::pos_z());
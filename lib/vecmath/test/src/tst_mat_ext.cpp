@@ -110,6 +110,40 @@ TEST_CASE("mat_ext.operator_multiply_array_right_lower_dimension")
   CER_CHECK(o[2] == approx(r[2]));
 }
 
+TEST_CASE("mat_ext.transform_points")
+{
+  const auto points = std::vector<vec3d>{
+    vec3d(1.0, 2.0, 3.0),
+    vec3d(-2.0, 3.5, 4.0),
+    vec3d(3.0 / 23.0, 2.0 / 23.0, 7.0 / 23.0)};
+
+  SECTION("affine transformation")
+  {
+    const auto m = translation_matrix(vec3d(1.0, -2.0, 3.0))
+                   * rotation_matrix(normalize(vec3d(1.0, 1.0, 0.0)), to_radians(30.0))
+                   * scaling_matrix(vec3d(2.0, 0.5, 3.0));
+
+    auto o = points;
+    transform_points(m, o.begin(), o.end());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      CHECK(o[i] == m * points[i]);
+    }
+  }
+
+  SECTION("projective transformation")
+  {
+    constexpr auto m = mat4x4d(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+
+    auto o = points;
+    transform_points(m, o.begin(), o.end());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      CHECK(o[i] == m * points[i]);
+    }
+  }
+}
+
 TEST_CASE("mat_ext.operator_multiply_vectors_left")
 {
   const auto v =
@@ -0,0 +1,534 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QString>
+
+#include "Error.h"
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/ExportOptions.h"
+#include "IO/File.h"
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Logger.h"
+#include "Model/EmptyBrushEntityValidator.h"
+#include "Model/EmptyGroupValidator.h"
+#include "Model/EmptyPropertyKeyValidator.h"
+#include "Model/EmptyPropertyValueValidator.h"
+#include "Model/EntityProperties.h"
+#include "Model/InvalidTextureScaleValidator.h"
+#include "Model/Issue.h"
+#include "Model/LinkSourceValidator.h"
+#include "Model/LinkTargetValidator.h"
+#include "Model/LongPropertyKeyValidator.h"
+#include "Model/LongPropertyValueValidator.h"
+#include "Model/MapFormat.h"
+#include "Model/MissingClassnameValidator.h"
+#include "Model/MixedBrushContentsValidator.h"
+#include "Model/ModelUtils.h"
+#include "Model/NonIntegerVerticesValidator.h"
+#include "Model/PointEntityWithBrushesValidator.h"
+#include "Model/PropertyKeyWithDoubleQuotationMarksValidator.h"
+#include "Model/PropertyValueWithDoubleQuotationMarksValidator.h"
+#include "Model/WorldBoundsValidator.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/path_utils.h>
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/*
+ * Processes map files without the editor's user interface, e.g. for nightly jobs. Every
+ * map is read, optionally validated, converted to another map format and exported as an
+ * OBJ file. The maps are processed in parallel, and the time taken by each step is
+ * reported for every map.
+ *
+ * Since no game configuration is loaded, only the validators that don't depend on a game
+ * or on entity definitions are run.
+ */
+
+namespace TrenchBroom
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// the same as the default world bounds of a document
+const auto WorldBounds = vm::bbox3{-32768.0, 32768.0};
+
+// the default of game configurations that don't specify it
+constexpr auto MaxPropertyLength = size_t(1023);
+
+const auto AllMapFormats = std::vector<Model::MapFormat>{
+  Model::MapFormat::Standard,
+  Model::MapFormat::Valve,
+  Model::MapFormat::Quake2,
+  Model::MapFormat::Quake2_Valve,
+  Model::MapFormat::Quake3_Legacy,
+  Model::MapFormat::Quake3_Valve,
+  Model::MapFormat::Quake3,
+  Model::MapFormat::Hexen2,
+  Model::MapFormat::Daikatana,
+};
+
+struct Options
+{
+  std::optional<Model::MapFormat> sourceFormat;
+  std::optional<Model::MapFormat> targetFormat;
+  bool validate = false;
+  bool exportObj = false;
+  std::filesystem::path outputDirectory;
+  size_t jobCount = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+  std::vector<std::filesystem::path> mapPaths;
+};
+
+void printUsage(std::ostream& out)
+{
+  out << "Usage: map-batch [options] <map file>...\n"
+      << "\n"
+      << "Options:\n"
+      << "  --format <name>   parse the maps in the given format instead of detecting\n"
+      << "                    it\n"
+      << "  --convert <name>  write the maps converted to the given format\n"
+      << "  --export-obj      export the maps as OBJ files\n"
+      << "  --validate        report the issues found in the maps\n"
+      << "  --output <dir>    the directory to write converted and exported maps to\n"
+      << "  --jobs <count>    the number of maps to process in parallel\n"
+      << "\n"
+      << "Map formats:\n";
+  for (const auto format : AllMapFormats)
+  {
+    out << "  " << Model::formatName(format) << "\n";
+  }
+}
+
+std::optional<Options> parseOptions(const int argc, const char* const* argv)
+{
+  auto options = Options{};
+
+  const auto parseFormat =
+    [](const std::string& name) -> std::optional<Model::MapFormat> {
+    const auto format = Model::formatFromName(name);
+    if (format == Model::MapFormat::Unknown)
+    {
+      std::cerr << "Unknown map format: " << name << "\n";
+      return std::nullopt;
+    }
+    return format;
+  };
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const auto arg = std::string{argv[i]};
+    const auto hasValue = i + 1 < argc;
+
+    if (arg == "--format" && hasValue)
+    {
+      options.sourceFormat = parseFormat(argv[++i]);
+      if (!options.sourceFormat)
+      {
+        return std::nullopt;
+      }
+    }
+    else if (arg == "--convert" && hasValue)
+    {
+      options.targetFormat = parseFormat(argv[++i]);
+      if (!options.targetFormat)
+      {
+        return std::nullopt;
+      }
+    }
+    else if (arg == "--export-obj")
+    {
+      options.exportObj = true;
+    }
+    else if (arg == "--validate")
+    {
+      options.validate = true;
+    }
+    else if (arg == "--output" && hasValue)
+    {
+      options.outputDirectory = argv[++i];
+    }
+    else if (arg == "--jobs" && hasValue)
+    {
+      const auto jobCount = std::atoi(argv[++i]);
+      if (jobCount < 1)
+      {
+        std::cerr << "Invalid job count: " << argv[i] << "\n";
+        return std::nullopt;
+      }
+      options.jobCount = size_t(jobCount);
+    }
+    else if (!arg.empty() && arg.front() == '-')
+    {
+      std::cerr << "Invalid option: " << arg << "\n";
+      return std::nullopt;
+    }
+    else
+    {
+      options.mapPaths.emplace_back(arg);
+    }
+  }
+
+  if (options.mapPaths.empty())
+  {
+    std::cerr << "No map files given\n";
+    return std::nullopt;
+  }
+
+  if ((options.targetFormat || options.exportObj) && options.outputDirectory.empty())
+  {
+    std::cerr << "Converting or exporting maps requires an output directory\n";
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+/**
+ * Writes the messages to the given stream so that the output of a map is not interleaved
+ * with the output of maps that are processed in parallel.
+ */
+class StreamLogger : public Logger
+{
+private:
+  std::ostream& m_out;
+
+public:
+  explicit StreamLogger(std::ostream& out)
+    : m_out{out}
+  {
+  }
+
+private:
+  void doLog(const LogLevel level, const std::string& message) override
+  {
+    switch (level)
+    {
+    case LogLevel::Debug:
+      return;
+    case LogLevel::Info:
+      m_out << "  info: ";
+      break;
+    case LogLevel::Warn:
+      m_out << "  warning: ";
+      break;
+    case LogLevel::Error:
+      m_out << "  error: ";
+      break;
+    }
+    m_out << message << "\n";
+  }
+
+  void doLog(const LogLevel level, const QString& message) override
+  {
+    doLog(level, message.toStdString());
+  }
+};
+
+long long millisecondsSince(const Clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start)
+    .count();
+}
+
+std::unique_ptr<Model::WorldNode> readWorld(
+  const std::string_view contents, const Options& options, Logger& logger)
+{
+  auto parserStatus = IO::SimpleParserStatus{logger};
+  const auto formatsToTry =
+    options.sourceFormat ? std::vector{*options.sourceFormat} : AllMapFormats;
+
+  auto parserExceptions = std::vector<std::tuple<Model::MapFormat, std::string>>{};
+  for (const auto format : formatsToTry)
+  {
+    try
+    {
+      auto reader = IO::WorldReader{
+        contents,
+        format,
+        options.targetFormat.value_or(format),
+        Model::EntityPropertyConfig{}};
+      return reader.read(WorldBounds, parserStatus);
+    }
+    catch (const ParserException& e)
+    {
+      parserExceptions.emplace_back(format, e.what());
+    }
+  }
+
+  throw IO::WorldReaderException{parserExceptions};
+}
+
+size_t validateWorld(Model::WorldNode& world, std::ostream& out)
+{
+  world.registerValidator(std::make_unique<Model::MissingClassnameValidator>());
+  world.registerValidator(std::make_unique<Model::EmptyGroupValidator>());
+  world.registerValidator(std::make_unique<Model::EmptyBrushEntityValidator>());
+  world.registerValidator(std::make_unique<Model::PointEntityWithBrushesValidator>());
+  world.registerValidator(std::make_unique<Model::LinkSourceValidator>());
+  world.registerValidator(std::make_unique<Model::LinkTargetValidator>());
+  world.registerValidator(std::make_unique<Model::NonIntegerVerticesValidator>());
+  world.registerValidator(std::make_unique<Model::MixedBrushContentsValidator>());
+  world.registerValidator(std::make_unique<Model::WorldBoundsValidator>(WorldBounds));
+  world.registerValidator(std::make_unique<Model::EmptyPropertyKeyValidator>());
+  world.registerValidator(std::make_unique<Model::EmptyPropertyValueValidator>());
+  world.registerValidator(
+    std::make_unique<Model::LongPropertyKeyValidator>(MaxPropertyLength));
+  world.registerValidator(
+    std::make_unique<Model::LongPropertyValueValidator>(MaxPropertyLength));
+  world.registerValidator(
+    std::make_unique<Model::PropertyKeyWithDoubleQuotationMarksValidator>());
+  world.registerValidator(
+    std::make_unique<Model::PropertyValueWithDoubleQuotationMarksValidator>());
+  world.registerValidator(std::make_unique<Model::InvalidTextureScaleValidator>());
+
+  const auto validators = world.registeredValidators();
+  const auto nodes = Model::collectNodes({&world});
+  Model::Node::validateIssues(nodes, validators);
+
+  auto issues = std::vector<const Model::Issue*>{};
+  for (auto* node : nodes)
+  {
+    for (const auto* issue : node->issues(validators))
+    {
+      if (!issue->hidden())
+      {
+        issues.push_back(issue);
+      }
+    }
+  }
+
+  std::sort(issues.begin(), issues.end(), [](const auto* lhs, const auto* rhs) {
+    return lhs->lineNumber() < rhs->lineNumber();
+  });
+  for (const auto* issue : issues)
+  {
+    out << "  issue: line " << issue->lineNumber() << ": " << issue->description()
+        << "\n";
+  }
+
+  return issues.size();
+}
+
+Result<void> convertWorld(
+  const Model::WorldNode& world, const std::filesystem::path& outputPath)
+{
+  return IO::Disk::withOutputStream(outputPath, [&](auto& stream) {
+    stream << "// Format: " << Model::formatName(world.mapFormat()) << "\n";
+    auto writer = IO::NodeWriter{world, stream};
+    writer.writeMap();
+  });
+}
+
+Result<void> exportWorld(
+  const Model::WorldNode& world, const std::filesystem::path& objPath)
+{
+  const auto options =
+    IO::ObjExportOptions{objPath, IO::ObjMtlPathMode::RelativeToGamePath};
+  return IO::Disk::withOutputStream(objPath, [&](auto& objStream) {
+    const auto mtlPath = kdl::path_replace_extension(objPath, ".mtl");
+    return IO::Disk::withOutputStream(mtlPath, [&](auto& mtlStream) {
+      auto writer = IO::NodeWriter{
+        world,
+        std::make_unique<IO::ObjSerializer>(
+          objStream, mtlStream, mtlPath.filename().string(), options)};
+      writer.setExporting(true);
+      writer.writeMap();
+    });
+  });
+}
+
+/**
+ * Processes the map at the given path and writes a report to the given stream.
+ *
+ * @return true if every step succeeded
+ */
+bool processMap(
+  const std::filesystem::path& mapPath, const Options& options, std::ostream& out)
+{
+  out << mapPath.string() << "\n";
+
+  auto logger = StreamLogger{out};
+  auto timings = std::stringstream{};
+  auto success = true;
+
+  try
+  {
+    const auto readStart = Clock::now();
+    auto world = std::unique_ptr<Model::WorldNode>{};
+    IO::Disk::openFileForReading(mapPath)
+      .transform([&](auto file) {
+        const auto reader = file->reader().buffer();
+        world = readWorld(reader.stringView(), options, logger);
+      })
+      .transform_error([&](const auto& e) { out << "  error: " << e.msg << "\n"; });
+    if (!world)
+    {
+      return false;
+    }
+    timings << "read " << millisecondsSince(readStart) << "ms ("
+            << Model::formatName(world->mapFormat()) << ")";
+
+    if (options.validate)
+    {
+      const auto validateStart = Clock::now();
+      const auto issueCount = validateWorld(*world, out);
+      timings << ", validate " << millisecondsSince(validateStart) << "ms ("
+              << issueCount << " issues)";
+    }
+
+    const auto outputPath = [&](const auto& extension) {
+      return kdl::path_replace_extension(
+        options.outputDirectory / mapPath.filename(), extension);
+    };
+
+    if (options.targetFormat)
+    {
+      const auto convertStart = Clock::now();
+      const auto convertPath = outputPath(".map");
+      if (
+        std::filesystem::exists(convertPath)
+        && std::filesystem::equivalent(convertPath, mapPath))
+      {
+        out << "  error: Refusing to overwrite " << mapPath.string() << "\n";
+        success = false;
+      }
+      else
+      {
+        convertWorld(*world, convertPath)
+          .transform([&]() {
+            timings << ", convert " << millisecondsSince(convertStart) << "ms";
+          })
+          .transform_error([&](const auto& e) {
+            out << "  error: " << e.msg << "\n";
+            success = false;
+          });
+      }
+    }
+
+    if (options.exportObj)
+    {
+      const auto exportStart = Clock::now();
+      exportWorld(*world, outputPath(".obj"))
+        .transform(
+          [&]() { timings << ", export " << millisecondsSince(exportStart) << "ms"; })
+        .transform_error([&](const auto& e) {
+          out << "  error: " << e.msg << "\n";
+          success = false;
+        });
+    }
+  }
+  catch (const Exception& e)
+  {
+    out << "  error: " << e.what() << "\n";
+    return false;
+  }
+
+  out << "  " << timings.str() << "\n";
+  return success;
+}
+
+int run(const Options& options)
+{
+  if (!options.outputDirectory.empty())
+  {
+    const auto created =
+      IO::Disk::createDirectory(options.outputDirectory).if_error([](const auto& e) {
+        std::cerr << "Could not create output directory: " << e.msg << "\n";
+      });
+    if (created.is_error())
+    {
+      return 1;
+    }
+  }
+
+  const auto start = Clock::now();
+
+  auto outputMutex = std::mutex{};
+  auto nextMapIndex = std::atomic<size_t>{0};
+  auto failedMapCount = std::atomic<size_t>{0};
+
+  // every worker reads and processes one map at a time, and each map has its own world
+  const auto work = [&]() {
+    for (auto i = nextMapIndex++; i < options.mapPaths.size(); i = nextMapIndex++)
+    {
+      auto out = std::stringstream{};
+      if (!processMap(options.mapPaths[i], options, out))
+      {
+        ++failedMapCount;
+      }
+
+      const auto lock = std::lock_guard{outputMutex};
+      std::cout << out.str() << std::flush;
+    }
+  };
+
+  auto workers = std::vector<std::thread>{};
+  const auto workerCount = std::min(options.jobCount, options.mapPaths.size());
+  for (size_t i = 1; i < workerCount; ++i)
+  {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  std::cout << "Processed " << options.mapPaths.size() << " maps (" << failedMapCount
+            << " failed) in " << millisecondsSince(start) << "ms\n";
+  return failedMapCount > 0 ? 1 : 0;
+}
+
+} // namespace
+} // namespace TrenchBroom
+
+int main(int argc, char* argv[])
+{
+  const auto options = TrenchBroom::parseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "\n";
+    TrenchBroom::printUsage(std::cerr);
+    return 2;
+  }
+
+  return TrenchBroom::run(*options);
+}